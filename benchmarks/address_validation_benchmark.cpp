@@ -0,0 +1,86 @@
+// OSC address validation benchmark
+//
+// Validates a rotating set of typical CV addresses through the old path
+// (std::find over the whitelist, then std::regex_match) and through
+// OSCSecurity, whose whitelist is a trie and whose pattern is a DFA compiled
+// at config time. Rate limiting is disabled so only validation is measured.
+//
+// Usage: address_validation_benchmark [iterations]
+
+#include "OSCSecurity.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+volatile int sink = 0;
+
+template <typename Fn>
+double messagesPerSecond(int iterations, Fn&& fn) {
+    for (int i = 0; i < iterations / 10; i++) fn(i); // Warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return iterations / std::chrono::duration<double>(elapsed).count();
+}
+
+void report(const std::string& label, double rate, double baseline) {
+    std::cout << std::left << std::setw(44) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << rate / 1e6 << " M msg/s" << std::setw(10) << std::setprecision(1)
+              << rate / baseline << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    std::vector<std::string> addresses;
+    for (int channel = 1; channel <= 8; channel++) {
+        addresses.push_back("/cv/" + std::to_string(channel));
+        addresses.push_back("/mixer/channel/" + std::to_string(channel) + "/level");
+    }
+    const size_t mask = addresses.size() - 1;
+
+    OSCSecurity::SecurityConfig config;
+    config.enableRateLimiting = false;
+    OSCSecurity patternOnly(config);
+    config.enableAddressWhitelist = true;
+    config.allowedAddresses = addresses;
+    OSCSecurity whitelisted(config);
+
+    const std::regex regex(config.allowedAddressPattern);
+    auto regexPath = [&](bool useWhitelist, const std::string& address) {
+        if (address.empty() || address[0] != '/') return false;
+        if (useWhitelist && std::find(addresses.begin(), addresses.end(), address) == addresses.end()) return false;
+        return std::regex_match(address, regex);
+    };
+
+    std::cout << "Validating " << addresses.size() << " addresses, " << iterations << " iterations" << std::endl;
+    std::cout << "Pattern " << config.allowedAddressPattern << std::endl << std::endl;
+
+    double regexRate = messagesPerSecond(iterations, [&](int i) { sink += regexPath(false, addresses[i & mask]); });
+    report("std::regex pattern", regexRate, regexRate);
+    report("DFA pattern", messagesPerSecond(iterations, [&](int i) {
+        sink += patternOnly.isAddressValid(addresses[i & mask]);
+    }), regexRate);
+
+    double regexWhitelistRate = messagesPerSecond(iterations, [&](int i) {
+        sink += regexPath(true, addresses[i & mask]);
+    });
+    report("std::find whitelist + std::regex", regexWhitelistRate, regexWhitelistRate);
+    report("trie whitelist + DFA", messagesPerSecond(iterations, [&](int i) {
+        sink += whitelisted.isAddressValid(addresses[i & mask]);
+    }), regexWhitelistRate);
+
+    report("validateMessage(float), DFA", messagesPerSecond(iterations, [&](int i) {
+        sink += patternOnly.validateMessage(addresses[i & mask], 2.5f);
+    }), regexRate);
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Plugin block-processing overhead benchmark
+//
+// Compares the legacy ISignalProcessor::processSignal (vectors by value) with
+// the v2 C ABI block interface on the same gain algorithm, and optionally
+// times a real plugin library passed on the command line.
+//
+// Usage: plugin_block_benchmark [plugin.so|plugin.dylib] [channels] [frames]
+
+#include "PluginManager.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// Minimal v2 C ABI gain plugin, linked in-process
+struct GainState {
+    float gain = 0.5f;
+};
+
+const cvosc_parameter_info kGainParameters[] = {
+    {0, "gain", 0.0f, 2.0f, 0.5f},
+};
+
+void* gainCreate(double, uint32_t, uint32_t) { return new GainState(); }
+void gainDestroy(void* instance) { delete static_cast<GainState*>(instance); }
+int32_t gainReset(void*) { return CVOSC_OK; }
+
+int32_t gainProcess(void* instance, const cvosc_process_block* block) {
+    float gain = static_cast<GainState*>(instance)->gain;
+    for (uint32_t channel = 0; channel < block->num_channels; channel++) {
+        const float* input = block->inputs[channel];
+        float* output = block->outputs[channel];
+        for (uint32_t frame = 0; frame < block->num_frames; frame++) {
+            output[frame] = input[frame] * gain;
+        }
+    }
+    return CVOSC_OK;
+}
+
+int32_t gainSetParameter(void* instance, uint32_t id, float value) {
+    if (id != 0) return CVOSC_ERROR_BAD_PARAM;
+    static_cast<GainState*>(instance)->gain = value;
+    return CVOSC_OK;
+}
+
+float gainGetParameter(void* instance, uint32_t) { return static_cast<GainState*>(instance)->gain; }
+
+const cvosc_plugin_descriptor kGainDescriptor = {
+    sizeof(cvosc_plugin_descriptor), PLUGIN_API_VERSION, CVOSC_PLUGIN_SIGNAL_PROCESSOR,
+    CVOSC_PLUGIN_FLAG_IN_PLACE | CVOSC_PLUGIN_FLAG_RT_SAFE,
+    "Benchmark Gain", "1.0", "benchmark", "Static gain",
+    1, kGainParameters,
+    gainCreate, gainDestroy, gainReset, gainProcess, gainSetParameter, gainGetParameter,
+};
+
+// Same algorithm behind the legacy C++ interface
+class LegacyGain : public ISignalProcessor {
+public:
+    bool initialize() override { return true; }
+    void shutdown() override {}
+    PluginInfo getInfo() const override { return PluginInfo(); }
+    bool configure(const std::map<std::string, std::string>&) override { return true; }
+    std::map<std::string, std::string> getConfiguration() const override { return {}; }
+    bool isEnabled() const override { return true; }
+    void setEnabled(bool) override {}
+    std::string getLastError() const override { return ""; }
+
+    std::vector<float> processSignal(const std::vector<float>& input) override {
+        std::vector<float> output(input.size());
+        for (size_t i = 0; i < input.size(); i++) output[i] = input[i] * gain_;
+        return output;
+    }
+    bool processSignalInPlace(std::vector<float>& signal) override {
+        for (float& sample : signal) sample *= gain_;
+        return true;
+    }
+    float processSample(float sample) override { return sample * gain_; }
+    void processSamples(float* samples, int count) override {
+        for (int i = 0; i < count; i++) samples[i] *= gain_;
+    }
+    void setParameter(const std::string& name, float value) override {
+        if (name == "gain") gain_ = value;
+    }
+    float getParameter(const std::string&) const override { return gain_; }
+    std::vector<std::string> getParameterNames() const override { return {"gain"}; }
+    bool loadPreset(const std::string&) override { return false; }
+    bool savePreset(const std::string&) override { return false; }
+    std::vector<std::string> getAvailablePresets() const override { return {}; }
+
+private:
+    float gain_ = 0.5f;
+};
+
+template <typename Fn>
+double nanosecondsPerBlock(int iterations, Fn&& fn) {
+    for (int i = 0; i < iterations / 10; i++) fn(); // Warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) fn();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+void report(const std::string& label, double ns, uint32_t channels, uint32_t frames) {
+    std::cout << std::left << std::setw(44) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << ns << " ns/block" << std::setw(10)
+              << ns / (channels * frames) << " ns/sample" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string pluginPath = argc > 1 ? argv[1] : "";
+    uint32_t channels = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 8;
+    uint32_t frames = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 64;
+    const int iterations = 200000;
+
+    // Planar, caller-owned buffers
+    std::vector<std::vector<float>> inputStorage(channels, std::vector<float>(frames, 0.25f));
+    std::vector<std::vector<float>> outputStorage(channels, std::vector<float>(frames, 0.0f));
+    std::vector<const float*> inputs(channels);
+    std::vector<float*> outputs(channels);
+    for (uint32_t c = 0; c < channels; c++) {
+        inputs[c] = inputStorage[c].data();
+        outputs[c] = outputStorage[c].data();
+    }
+    cvosc_process_block block{channels, frames, inputs.data(), outputs.data(), 0};
+
+    std::cout << "Plugin block benchmark: " << channels << " channels x " << frames
+              << " frames, " << iterations << " blocks" << std::endl;
+
+    // Legacy: one vector copy in and one out per channel per block
+    LegacyGain legacy;
+    report("legacy processSignal (by value)", nanosecondsPerBlock(iterations, [&]() {
+        for (uint32_t c = 0; c < channels; c++) {
+            outputStorage[c] = legacy.processSignal(inputStorage[c]);
+        }
+    }), channels, frames);
+
+    // Legacy plugin adapted to the block interface
+    BlockProcessor legacyBlock(&legacy, channels, frames);
+    report("legacy via BlockProcessor", nanosecondsPerBlock(iterations, [&]() {
+        legacyBlock.process(block);
+    }), channels, frames);
+
+    // v2 C ABI, called directly and through the host wrapper
+    void* instance = kGainDescriptor.create(48000.0, channels, frames);
+    report("v2 descriptor->process (raw ABI)", nanosecondsPerBlock(iterations, [&]() {
+        kGainDescriptor.process(instance, &block);
+    }), channels, frames);
+
+    BlockProcessor v2Block(&kGainDescriptor, instance, channels, frames);
+    int32_t gainId = v2Block.findParameter("gain");
+    report("v2 BlockProcessor + setParameter(id)", nanosecondsPerBlock(iterations, [&]() {
+        v2Block.setParameter(static_cast<uint32_t>(gainId), 0.5f);
+        v2Block.process(block);
+    }), channels, frames);
+    kGainDescriptor.destroy(instance);
+
+    // Optional: a real plugin library through PluginManager
+    if (!pluginPath.empty()) {
+        PluginManager manager;
+        manager.setBlockGeometry(48000.0, channels, frames);
+        if (!manager.loadPlugin(pluginPath)) {
+            std::cerr << "Failed to load " << pluginPath << ": " << manager.getLastError() << std::endl;
+            return 1;
+        }
+        std::string name = manager.getLoadedPlugins().front().name;
+        manager.enablePlugin(name);
+        BlockProcessor* processor = manager.getBlockProcessor(name);
+        if (!processor) {
+            std::cerr << "Plugin is not a block processor: " << name << std::endl;
+            return 1;
+        }
+        report(name + " (" + (processor->isLegacy() ? "legacy" : "v2") + ")",
+               nanosecondsPerBlock(iterations, [&]() { processor->process(block); }), channels, frames);
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Plugin sandbox latency benchmark
+//
+// Compares running a plugin in-process with running it in a PluginSandbox
+// host process. Reports the per-block cost on the calling thread, the full
+// round trip until the processed block is back, and behaviour when blocks
+// arrive at real-time pace.
+//
+// Usage: plugin_sandbox_benchmark [channels] [frames] [plugin.so host_executable]
+// Without a plugin path the built-in gain plugin runs in a forked host.
+
+#include "PluginManager.h"
+#include "PluginSandbox.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void* gainCreate(double, uint32_t, uint32_t) { return new float(0.5f); }
+void gainDestroy(void* instance) { delete static_cast<float*>(instance); }
+
+int32_t gainProcess(void* instance, const cvosc_process_block* block) {
+    float gain = *static_cast<float*>(instance);
+    for (uint32_t channel = 0; channel < block->num_channels; channel++) {
+        for (uint32_t frame = 0; frame < block->num_frames; frame++) {
+            block->outputs[channel][frame] = block->inputs[channel][frame] * gain;
+        }
+    }
+    return CVOSC_OK;
+}
+
+const cvosc_plugin_descriptor kGainDescriptor = {
+    sizeof(cvosc_plugin_descriptor), PLUGIN_API_VERSION, CVOSC_PLUGIN_SIGNAL_PROCESSOR,
+    CVOSC_PLUGIN_FLAG_IN_PLACE | CVOSC_PLUGIN_FLAG_RT_SAFE,
+    "Benchmark Gain", "1.0", "benchmark", "Static gain",
+    0, nullptr,
+    gainCreate, gainDestroy, nullptr, gainProcess, nullptr, nullptr,
+};
+
+struct Percentiles {
+    double p50;
+    double p99;
+    double max;
+};
+
+Percentiles percentiles(std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    return {samples[samples.size() / 2], samples[samples.size() * 99 / 100], samples.back()};
+}
+
+void report(const std::string& label, std::vector<double>& samples) {
+    Percentiles p = percentiles(samples);
+    std::cout << std::left << std::setw(40) << label << std::right << std::fixed << std::setprecision(0)
+              << "p50 " << std::setw(8) << p.p50 << " ns   p99 " << std::setw(8) << p.p99
+              << " ns   max " << std::setw(9) << p.max << " ns" << std::endl;
+}
+
+template <typename Fn>
+std::vector<double> timeBlocks(int iterations, Fn&& fn) {
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    for (int i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+    return samples;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t channels = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 8;
+    uint32_t frames = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 64;
+    std::string pluginPath = argc > 4 ? argv[3] : "";
+    std::string hostPath = argc > 4 ? argv[4] : "";
+    const double sampleRate = 48000.0;
+    const int iterations = 20000;
+
+    std::vector<std::vector<float>> storage(channels, std::vector<float>(frames, 0.25f));
+    std::vector<const float*> inputs(channels);
+    std::vector<float*> outputs(channels);
+    for (uint32_t c = 0; c < channels; c++) {
+        inputs[c] = storage[c].data();
+        outputs[c] = storage[c].data();
+    }
+    cvosc_process_block block{channels, frames, inputs.data(), outputs.data(), 0};
+
+    std::cout << "Plugin sandbox benchmark: " << channels << " channels x " << frames << " frames, "
+              << iterations << " blocks" << std::endl;
+
+    // In-process: the call is the round trip
+    void* instance = kGainDescriptor.create(sampleRate, channels, frames);
+    BlockProcessor inProcess(&kGainDescriptor, instance, channels, frames);
+    auto direct = timeBlocks(iterations, [&]() { inProcess.process(block); });
+    report("in-process process()", direct);
+    kGainDescriptor.destroy(instance);
+
+    PluginSandbox sandbox(channels, frames, sampleRate);
+    bool started = pluginPath.empty() ? sandbox.start(&kGainDescriptor) : sandbox.start(hostPath, pluginPath);
+    if (!started) {
+        std::cerr << "Failed to start sandbox" << std::endl;
+        return 1;
+    }
+
+    // Cost on the processing thread: the handoff only
+    auto handoff = timeBlocks(iterations, [&]() { sandbox.process(block); });
+    report("sandbox process() (handoff)", handoff);
+
+    // Round trip: hand a block over and wait for the host to return it
+    auto roundTrip = timeBlocks(iterations, [&]() {
+        sandbox.process(block);
+        sandbox.waitForResult(std::chrono::milliseconds(100));
+    });
+    report("sandbox round trip (futex wake)", roundTrip);
+
+    // Real-time pace: one block per block period, host mostly asleep between blocks
+    auto period = std::chrono::duration<double>(frames / sampleRate);
+    auto before = sandbox.getStatistics();
+    const int paced = static_cast<int>(2.0 / period.count()); // Two seconds of audio
+    auto next = std::chrono::steady_clock::now();
+    for (int i = 0; i < paced; i++) {
+        sandbox.process(block);
+        next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(period);
+        std::this_thread::sleep_until(next);
+    }
+    auto after = sandbox.getStatistics();
+    std::cout << "paced " << paced << " blocks at " << std::setprecision(2) << period.count() * 1000.0
+              << " ms: " << (after.processed - before.processed) << " returned in time, "
+              << (after.misses - before.misses) << " late, " << (after.skipped - before.skipped)
+              << " skipped" << std::endl;
+
+    sandbox.stop();
+    return 0;
+}
@@ -0,0 +1,176 @@
+// Network reactor scaling benchmark
+//
+// Sends single-float OSC messages over loopback UDP to 1/8/32/128 devices
+// (one receiving socket per device) and compares two models:
+//   threaded - a blocking receiver thread per device and one sendto() per
+//              message, which is what liblo server threads + lo_send() do
+//   reactor  - every socket on the shared OSCNetworkReactor, messages
+//              submitted to its queue and sent in batches
+// Reports delivered messages/s, loss, threads used and context switches.
+//
+// Usage: reactor_scaling_benchmark [messages per device]
+
+#include "OSCNetworkReactor.h"
+#include "OSCPacket.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct Result {
+    double messagesPerSecond;
+    double lossPercent;
+    size_t threads;
+    long contextSwitches;
+};
+
+long contextSwitches() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+size_t encode(uint8_t* packet, size_t capacity, int device, float value) {
+    std::string address = "/cv/device/" + std::to_string(device);
+    return OSCPacket::writeFloatMessage(packet, capacity, address, &value, 1);
+}
+
+// Waits for deliveries to settle, then returns the elapsed time
+double settle(std::chrono::steady_clock::time_point start, const std::atomic<uint64_t>& received, uint64_t expected) {
+    uint64_t last = 0;
+    auto lastChange = std::chrono::steady_clock::now();
+    auto finished = lastChange;
+    while (received.load() < expected &&
+           std::chrono::steady_clock::now() - lastChange < std::chrono::milliseconds(200)) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        if (received.load() != last) {
+            last = received.load();
+            lastChange = finished = std::chrono::steady_clock::now();
+        }
+    }
+    if (received.load() >= expected) {
+        finished = std::chrono::steady_clock::now();
+    }
+    return std::chrono::duration<double>(finished - start).count();
+}
+
+Result runThreaded(int devices, int messagesPerDevice) {
+    std::atomic<uint64_t> received{0};
+    std::atomic<bool> running{true};
+    std::vector<int> sockets;
+    std::vector<sockaddr_in> addresses;
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < devices; i++) {
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        socklen_t length = sizeof(address);
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+        int bufferBytes = 1 << 20;
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+        timeval timeout{0, 50000};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        sockets.push_back(fd);
+        addresses.push_back(address);
+        threads.emplace_back([fd, &received, &running] {
+            uint8_t buffer[2048];
+            while (running) {
+                if (recv(fd, buffer, sizeof(buffer), 0) > 0) received++;
+            }
+        });
+    }
+
+    int sendFd = socket(AF_INET, SOCK_DGRAM, 0);
+    const uint64_t expected = static_cast<uint64_t>(devices) * messagesPerDevice;
+    long switchesBefore = contextSwitches();
+    auto start = std::chrono::steady_clock::now();
+    uint8_t packet[128];
+    for (int m = 0; m < messagesPerDevice; m++) {
+        for (int d = 0; d < devices; d++) {
+            size_t size = encode(packet, sizeof(packet), d, static_cast<float>(m));
+            sendto(sendFd, packet, size, 0, reinterpret_cast<sockaddr*>(&addresses[d]), sizeof(addresses[d]));
+        }
+    }
+    double seconds = settle(start, received, expected);
+    long switches = contextSwitches() - switchesBefore;
+
+    running = false;
+    for (auto& thread : threads) thread.join();
+    for (int fd : sockets) close(fd);
+    close(sendFd);
+    return {received.load() / seconds, 100.0 * (expected - received.load()) / expected,
+            static_cast<size_t>(devices) + 1, switches};
+}
+
+Result runReactor(int devices, int messagesPerDevice) {
+    OSCNetworkReactor reactor(1);
+    std::atomic<uint64_t> received{0};
+    std::vector<OSCNetworkReactor::EndpointId> receivers;
+    std::vector<OSCNetworkReactor::EndpointId> targets;
+
+    for (int i = 0; i < devices; i++) {
+        auto receiver = reactor.openUdpReceiver("0", [&received](const uint8_t*, size_t, const sockaddr_storage&) {
+            received.fetch_add(1, std::memory_order_relaxed);
+        }, "127.0.0.1");
+        receivers.push_back(receiver);
+        targets.push_back(reactor.openUdpTarget("127.0.0.1", std::to_string(reactor.getLocalPort(receiver))));
+    }
+
+    const uint64_t expected = static_cast<uint64_t>(devices) * messagesPerDevice;
+    long switchesBefore = contextSwitches();
+    auto start = std::chrono::steady_clock::now();
+    uint8_t packet[128];
+    for (int m = 0; m < messagesPerDevice; m++) {
+        for (int d = 0; d < devices; d++) {
+            size_t size = encode(packet, sizeof(packet), d, static_cast<float>(m));
+            while (!reactor.submit(targets[d], packet, size)) {
+                std::this_thread::yield();   // Queue full: let the loop drain
+            }
+        }
+    }
+    double seconds = settle(start, received, expected);
+    long switches = contextSwitches() - switchesBefore;
+
+    auto stats = reactor.getStats();
+    std::cout << "    reactor batching: " << std::fixed << std::setprecision(1)
+              << (stats.sendCalls ? double(stats.packetsSent) / stats.sendCalls : 0.0) << " packets/send call, "
+              << (stats.receiveCalls ? double(stats.packetsReceived) / stats.receiveCalls : 0.0)
+              << " packets/receive call (" << reactor.getBackendName() << ")\n";
+    return {received.load() / seconds, 100.0 * (expected - received.load()) / expected,
+            reactor.getThreadCount(), switches};
+}
+
+void print(const char* model, int devices, const Result& result) {
+    std::cout << "  " << std::left << std::setw(9) << model << std::right << std::setw(4) << devices << " devices  "
+              << std::fixed << std::setprecision(0) << std::setw(10) << result.messagesPerSecond << " msg/s  "
+              << std::setprecision(2) << std::setw(6) << result.lossPercent << "% loss  "
+              << std::setw(4) << result.threads << " threads  "
+              << std::setw(8) << result.contextSwitches << " context switches\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int messagesPerDevice = argc > 1 ? std::atoi(argv[1]) : 2000;
+
+    std::cout << "OSC loopback fan-out, " << messagesPerDevice << " messages per device\n";
+    for (int devices : {1, 8, 32, 128}) {
+        print("threaded", devices, runThreaded(devices, messagesPerDevice));
+        print("reactor", devices, runReactor(devices, messagesPerDevice));
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+// Shared-memory vs loopback UDP benchmark
+//
+// One producer and one consumer thread in this process exchange single-float
+// OSC messages over:
+//   udp       - a 127.0.0.1 datagram socket with a blocking recv() thread
+//   shm-futex - OSCSharedMemoryTransport, the reader sleeping in wait()
+//   shm-spin  - the same ring, the reader polling read() and only yielding
+//               the CPU between polls (best on a dedicated core)
+// Latency: messages are paced apart so each is delivered alone; the float
+// argument is the sequence number, which indexes the send timestamp.
+// Throughput: messages are sent back to back; loss counts packets the
+// consumer never saw (UDP drops, ring overruns).
+//
+// Usage: shm_loopback_benchmark [latency samples] [throughput messages]
+
+#include "OSCSharedMemoryTransport.h"
+#include "OSCSharedMemoryReader.h"
+#include "OSCPacket.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Mode { Udp, ShmFutex, ShmSpin };
+
+const char* modeName(Mode mode) {
+    switch (mode) {
+        case Mode::Udp: return "udp";
+        case Mode::ShmFutex: return "shm-futex";
+        case Mode::ShmSpin: return "shm-spin";
+    }
+    return "";
+}
+
+// Both ends of one channel; send() and receive() hide the transport
+class Channel {
+public:
+    explicit Channel(Mode mode) : mode_(mode) {
+        if (mode_ == Mode::Udp) {
+            receiveSocket_ = socket(AF_INET, SOCK_DGRAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            bind(receiveSocket_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            int buffer = 8 << 20;
+            setsockopt(receiveSocket_, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+            timeval timeout{0, 200000};
+            setsockopt(receiveSocket_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            socklen_t length = sizeof(target_);
+            getsockname(receiveSocket_, reinterpret_cast<sockaddr*>(&target_), &length);
+            sendSocket_ = socket(AF_INET, SOCK_DGRAM, 0);
+        } else {
+            port_ = "bench-" + std::to_string(getpid());
+            transport_.connect("localhost", port_);
+            reader_.open(port_);
+        }
+    }
+
+    ~Channel() {
+        if (mode_ == Mode::Udp) {
+            close(receiveSocket_);
+            close(sendSocket_);
+        } else {
+            reader_.close();
+            transport_.disconnect();
+            OSCSharedMemoryTransport::removeSegment(port_);
+        }
+    }
+
+    void send(const uint8_t* packet, size_t size) {
+        if (mode_ == Mode::Udp) {
+            sendto(sendSocket_, packet, size, 0, reinterpret_cast<sockaddr*>(&target_), sizeof(target_));
+        } else {
+            transport_.sendPacket(packet, size);
+        }
+    }
+
+    // Returns false only when nothing arrived for a while
+    bool receive(std::vector<uint8_t>& packet) {
+        if (mode_ == Mode::Udp) {
+            packet.resize(1500);
+            ssize_t got = recv(receiveSocket_, packet.data(), packet.size(), 0);
+            if (got < 0) return false;
+            packet.resize(static_cast<size_t>(got));
+            return true;
+        }
+        auto idleSince = Clock::now();
+        while (!reader_.read(packet)) {
+            if (Clock::now() - idleSince > std::chrono::milliseconds(200)) return false;
+            if (mode_ == Mode::ShmFutex) {
+                reader_.wait(200);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        return true;
+    }
+
+    uint64_t overruns() const { return reader_.getStats().overruns; }
+
+private:
+    Mode mode_;
+    int receiveSocket_ = -1;
+    int sendSocket_ = -1;
+    sockaddr_in target_{};
+    std::string port_;
+    OSCSharedMemoryTransport transport_;
+    OSCSharedMemoryReader reader_;
+};
+
+uint32_t sequenceOf(const std::vector<uint8_t>& packet) {
+    uint32_t sequence = UINT32_MAX;
+    OSCPacket::forEachMessage(packet.data(), packet.size(), [&](const OSCPacket::Message& m) {
+        if (!m.arguments.empty()) sequence = static_cast<uint32_t>(m.arguments[0].number);
+    });
+    return sequence;
+}
+
+size_t encode(uint8_t* packet, size_t capacity, uint32_t sequence) {
+    float value = static_cast<float>(sequence);   // Exact below 2^24
+    return OSCPacket::writeFloatMessage(packet, capacity, "/cv/1", &value, 1);
+}
+
+void measureLatency(Mode mode, uint32_t samples) {
+    Channel channel(mode);
+    std::vector<Clock::time_point> sent(samples);
+    std::vector<double> latencies;
+    latencies.reserve(samples);
+
+    std::thread consumer([&] {
+        std::vector<uint8_t> packet;
+        while (latencies.size() < samples && channel.receive(packet)) {
+            auto now = Clock::now();
+            uint32_t sequence = sequenceOf(packet);
+            if (sequence < samples) {
+                latencies.push_back(std::chrono::duration<double, std::micro>(now - sent[sequence]).count());
+            }
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    uint8_t packet[64];
+    for (uint32_t i = 0; i < samples; i++) {
+        size_t size = encode(packet, sizeof(packet), i);
+        sent[i] = Clock::now();
+        channel.send(packet, size);
+        // Pace with a spin so the consumer is idle (and asleep, if it sleeps) before each send
+        auto next = sent[i] + std::chrono::microseconds(50);
+        while (Clock::now() < next) {
+        }
+    }
+    consumer.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies.empty() ? 0.0 : latencies[static_cast<size_t>(p * (latencies.size() - 1))];
+    };
+    std::cout << std::left << std::setw(12) << modeName(mode) << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << percentile(0.5) << std::setw(10) << percentile(0.99) << std::setw(10)
+              << percentile(0.999) << std::setw(10) << latencies.size() << "\n";
+}
+
+void measureThroughput(Mode mode, uint32_t messages) {
+    Channel channel(mode);
+    std::atomic<uint64_t> received{0};
+    std::thread consumer([&] {
+        std::vector<uint8_t> packet;
+        while (received.load(std::memory_order_relaxed) < messages && channel.receive(packet)) {
+            received.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    uint8_t packet[64];
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < messages; i++) {
+        channel.send(packet, encode(packet, sizeof(packet), i % (1u << 24)));
+    }
+    auto sendDone = Clock::now();
+    consumer.join();
+
+    double seconds = std::chrono::duration<double>(sendDone - start).count();
+    double loss = 100.0 * (messages - received.load()) / messages;
+    std::cout << std::left << std::setw(12) << modeName(mode) << std::right << std::fixed << std::setprecision(0)
+              << std::setw(14) << messages / seconds << std::setprecision(2) << std::setw(9) << loss << "%"
+              << std::setw(10) << (mode == Mode::Udp ? 0 : channel.overruns()) << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t samples = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 20000;
+    uint32_t messages = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 1000000;
+    const Mode modes[] = {Mode::Udp, Mode::ShmFutex, Mode::ShmSpin};
+
+    std::cout << "One-way latency, " << samples << " paced messages (us)\n";
+    std::cout << std::left << std::setw(12) << "transport" << std::right << std::setw(10) << "p50" << std::setw(10)
+              << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "received" << "\n";
+    for (Mode mode : modes) {
+        measureLatency(mode, samples);
+    }
+
+    std::cout << "\nThroughput, " << messages << " back-to-back messages\n";
+    std::cout << std::left << std::setw(12) << "transport" << std::right << std::setw(14) << "sent msg/s"
+              << std::setw(10) << "loss" << std::setw(10) << "overruns" << "\n";
+    for (Mode mode : modes) {
+        measureThroughput(mode, messages);
+    }
+    return 0;
+}
@@ -0,0 +1,102 @@
+// Hot-path diagnostics overhead benchmark
+//
+// Runs a stand-in for the per-sample routing step with the console output it
+// used to carry (printf per sample, std::cout with endl every 100th call) and
+// with TraceLog tracepoints, enabled and masked off. Console output goes to
+// /dev/null line-buffered, so the numbers are a lower bound: a real terminal
+// adds rendering on top of the write() per line.
+//
+// Usage: trace_overhead_benchmark [iterations]
+
+#include "TraceLog.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+volatile float sink = 0.0f;
+
+// Roughly what updatePerformanceStats does per channel: meter and level update
+inline float routeSample(int channel, float input) {
+    float processed = input * 0.999f + 0.001f * static_cast<float>(channel);
+    sink = processed;
+    return processed;
+}
+
+template <typename Fn>
+double nanosecondsPerCall(int iterations, Fn&& fn) {
+    for (int i = 0; i < iterations / 10; i++) fn(i); // Warm-up
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) fn(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+}
+
+void report(const std::string& label, double ns, double baseline) {
+    std::cout << std::left << std::setw(40) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << ns << " ns/call" << std::setw(10) << std::setprecision(2)
+              << 1000.0 / ns << " M calls/s" << std::setw(10) << std::setprecision(1)
+              << ns / baseline << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    const float input = 2.5f;
+
+    FILE* console = std::fopen("/dev/null", "w");
+    std::ofstream consoleStream("/dev/null");
+    if (!console || !consoleStream) {
+        std::cerr << "Cannot open /dev/null" << std::endl;
+        return 1;
+    }
+    setvbuf(console, nullptr, _IOLBF, BUFSIZ); // Like stdout on a terminal: one write() per line
+
+    std::cout << "Trace overhead benchmark: " << iterations << " calls (compile-time level "
+              << CVOSC_TRACE_LEVEL << ")" << std::endl;
+
+    double baseline = nanosecondsPerCall(iterations, [&](int i) { routeSample(i & 7, input); });
+    report("no diagnostics", baseline, baseline);
+
+    report("printf per sample ([GUI UPDATE])", nanosecondsPerCall(iterations, [&](int i) {
+        float value = routeSample(i & 7, input);
+        std::fprintf(console, "[GUI UPDATE] Channel %d: Setting levelVolts=%.6fV (inputSignal=%.6fV)\n",
+                     i & 7, value, input);
+    }), baseline);
+
+    report("std::cout + endl every 100th call", nanosecondsPerCall(iterations, [&](int i) {
+        float value = routeSample(i & 7, input);
+        if (i % 100 == 0) {
+            consoleStream << "[OSCSender::sendFloat] Sending #" << i << " to /channel/1/out = " << value
+                          << std::endl;
+        }
+    }), baseline);
+
+    TraceLog::setCategoryMask(static_cast<uint32_t>(TraceCategory::Gui));
+    report("TRACE_DEBUG, category enabled", nanosecondsPerCall(iterations, [&](int i) {
+        float value = routeSample(i & 7, input);
+        TRACE_DEBUG(TraceCategory::Gui, "channel %d levelVolts=%.6fV (input %.6fV)", i & 7, value, input);
+    }), baseline);
+
+    TraceLog::setCategoryMask(0);
+    report("TRACE_DEBUG, category masked off", nanosecondsPerCall(iterations, [&](int i) {
+        float value = routeSample(i & 7, input);
+        TRACE_DEBUG(TraceCategory::Gui, "channel %d levelVolts=%.6fV (input %.6fV)", i & 7, value, input);
+    }), baseline);
+
+    report("TRACE_VERBOSE (compiled out below 3)", nanosecondsPerCall(iterations, [&](int i) {
+        float value = routeSample(i & 7, input);
+        TRACE_VERBOSE(TraceCategory::Gui, "channel %d levelVolts=%.6fV", i & 7, value);
+        (void)value;
+    }), baseline);
+
+    std::fclose(console);
+    return 0;
+}
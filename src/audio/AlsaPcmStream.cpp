@@ -0,0 +1,352 @@
+#include "AlsaPcmStream.h"
+#include "ErrorHandler.h"
+#include "PerformanceMonitor.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+
+#if CVOSC_HAVE_ALSA
+#include <alsa/asoundlib.h>
+#endif
+
+namespace {
+
+#if CVOSC_HAVE_ALSA
+
+class AlsaIo : public AlsaPcmStream::Io {
+public:
+    ~AlsaIo() override { close(); }
+
+    bool open(AlsaPcmStream::Config& config, std::string& error) override {
+        capture_ = config.direction == AlsaPcmStream::Direction::CAPTURE;
+        std::string name = AlsaPcmStream::pcmName(config.device);
+        int result = snd_pcm_open(&pcm_, name.c_str(), capture_ ? SND_PCM_STREAM_CAPTURE : SND_PCM_STREAM_PLAYBACK, 0);
+        if (result < 0) {
+            error = "Cannot open " + name + ": " + snd_strerror(result);
+            pcm_ = nullptr;
+            return false;
+        }
+
+        snd_pcm_hw_params_t* hw;
+        snd_pcm_hw_params_alloca(&hw);
+        snd_pcm_hw_params_any(pcm_, hw);
+        if ((result = snd_pcm_hw_params_set_access(pcm_, hw, SND_PCM_ACCESS_MMAP_INTERLEAVED)) < 0) {
+            return fail(error, "mmap interleaved access", result);
+        }
+        // hw: devices take only their native formats; these are the common ones
+        const snd_pcm_format_t formats[] = {SND_PCM_FORMAT_FLOAT_LE, SND_PCM_FORMAT_S32_LE, SND_PCM_FORMAT_S16_LE};
+        result = -EINVAL;
+        for (snd_pcm_format_t format : formats) {
+            if (snd_pcm_hw_params_test_format(pcm_, hw, format) == 0) {
+                format_ = format;
+                result = snd_pcm_hw_params_set_format(pcm_, hw, format);
+                break;
+            }
+        }
+        if (result < 0) {
+            return fail(error, "sample format (float, S32 or S16)", result);
+        }
+        unsigned channels = config.channels;
+        if ((result = snd_pcm_hw_params_set_channels_near(pcm_, hw, &channels)) < 0) {
+            return fail(error, "channel count", result);
+        }
+        unsigned rate = config.sampleRate;
+        if ((result = snd_pcm_hw_params_set_rate_near(pcm_, hw, &rate, nullptr)) < 0) {
+            return fail(error, "sample rate", result);
+        }
+        snd_pcm_uframes_t period = config.periodFrames;
+        if ((result = snd_pcm_hw_params_set_period_size_near(pcm_, hw, &period, nullptr)) < 0) {
+            return fail(error, "period size", result);
+        }
+        unsigned periods = config.periods;
+        if ((result = snd_pcm_hw_params_set_periods_near(pcm_, hw, &periods, nullptr)) < 0) {
+            return fail(error, "period count", result);
+        }
+        if ((result = snd_pcm_hw_params(pcm_, hw)) < 0) {
+            return fail(error, "hardware parameters", result);
+        }
+
+        // Wake once a period is ready; playback starts itself once the buffer is full
+        snd_pcm_sw_params_t* sw;
+        snd_pcm_sw_params_alloca(&sw);
+        snd_pcm_sw_params_current(pcm_, sw);
+        snd_pcm_sw_params_set_avail_min(pcm_, sw, period);
+        snd_pcm_sw_params_set_start_threshold(pcm_, sw, capture_ ? 1 : period * periods);
+        if ((result = snd_pcm_sw_params(pcm_, sw)) < 0 || (result = snd_pcm_prepare(pcm_)) < 0) {
+            return fail(error, "software parameters", result);
+        }
+
+        channels_ = channels;
+        sampleBytes_ = static_cast<size_t>(snd_pcm_format_physical_width(format_)) / 8;
+        config.channels = channels;
+        config.sampleRate = rate;
+        config.periodFrames = static_cast<unsigned>(period);
+        config.periods = periods;
+        return true;
+    }
+
+    int start() override {
+        return capture_ ? snd_pcm_start(pcm_) : 0;
+    }
+
+    int wait(int timeoutMs) override {
+        return snd_pcm_wait(pcm_, timeoutMs);
+    }
+
+    long transfer(float* interleaved, size_t frames) override {
+        snd_pcm_sframes_t avail = snd_pcm_avail_update(pcm_);
+        if (avail < 0) {
+            return static_cast<long>(avail);
+        }
+        size_t remaining = std::min(frames, static_cast<size_t>(avail));
+        size_t done = 0;
+        while (remaining > 0) {
+            const snd_pcm_channel_area_t* areas;
+            snd_pcm_uframes_t offset;
+            snd_pcm_uframes_t count = remaining;
+            int result = snd_pcm_mmap_begin(pcm_, &areas, &offset, &count);
+            if (result < 0) {
+                return result;
+            }
+            // Interleaved: one area holds every channel, a frame every step bits
+            uint8_t* base = static_cast<uint8_t*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8;
+            size_t frameBytes = areas[0].step / 8;
+            convert(base, frameBytes, interleaved + done * channels_, count);
+            snd_pcm_sframes_t committed = snd_pcm_mmap_commit(pcm_, offset, count);
+            if (committed < 0) {
+                return static_cast<long>(committed);
+            }
+            if (static_cast<snd_pcm_uframes_t>(committed) != count) {
+                return -EPIPE;
+            }
+            done += count;
+            remaining -= count;
+        }
+        return static_cast<long>(done);
+    }
+
+    int recover(int error) override {
+        int result = snd_pcm_recover(pcm_, error, 1);
+        if (result < 0 || !capture_) {
+            return result;
+        }
+        result = snd_pcm_start(pcm_);
+        return result == -EBADFD ? 0 : result;   // Already running
+    }
+
+    void close() override {
+        if (pcm_) {
+            snd_pcm_drop(pcm_);
+            snd_pcm_close(pcm_);
+            pcm_ = nullptr;
+        }
+    }
+
+private:
+    snd_pcm_t* pcm_ = nullptr;
+    snd_pcm_format_t format_ = SND_PCM_FORMAT_FLOAT_LE;
+    bool capture_ = true;
+    unsigned channels_ = 0;
+    size_t sampleBytes_ = 4;
+
+    bool fail(std::string& error, const char* what, int result) {
+        error = std::string("Device refused ") + what + ": " + snd_strerror(result);
+        close();
+        return false;
+    }
+
+    // Between the device's frames and interleaved float, in the stream's direction
+    void convert(uint8_t* device, size_t frameBytes, float* samples, size_t frames) {
+        for (size_t frame = 0; frame < frames; frame++) {
+            uint8_t* in = device + frame * frameBytes;
+            float* values = samples + frame * channels_;
+            for (unsigned channel = 0; channel < channels_; channel++) {
+                uint8_t* slot = in + channel * sampleBytes_;
+                if (format_ == SND_PCM_FORMAT_FLOAT_LE) {
+                    capture_ ? std::memcpy(&values[channel], slot, 4) : std::memcpy(slot, &values[channel], 4);
+                } else if (format_ == SND_PCM_FORMAT_S32_LE) {
+                    int32_t sample;
+                    if (capture_) {
+                        std::memcpy(&sample, slot, 4);
+                        values[channel] = static_cast<float>(sample / 2147483648.0);
+                    } else {
+                        sample = static_cast<int32_t>(std::clamp(values[channel], -1.0f, 1.0f) * 2147483647.0);
+                        std::memcpy(slot, &sample, 4);
+                    }
+                } else {
+                    int16_t sample;
+                    if (capture_) {
+                        std::memcpy(&sample, slot, 2);
+                        values[channel] = sample / 32768.0f;
+                    } else {
+                        sample = static_cast<int16_t>(std::clamp(values[channel], -1.0f, 1.0f) * 32767.0f);
+                        std::memcpy(slot, &sample, 2);
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif // CVOSC_HAVE_ALSA
+
+} // namespace
+
+AlsaPcmStream::AlsaPcmStream() = default;
+
+AlsaPcmStream::~AlsaPcmStream() {
+    stop();
+}
+
+bool AlsaPcmStream::isAvailable() {
+#if CVOSC_HAVE_ALSA
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool AlsaPcmStream::isAlsaDeviceName(const std::string& name) {
+    return name.rfind("hw:", 0) == 0 || name.rfind("plughw:", 0) == 0 || name.rfind("alsa:", 0) == 0;
+}
+
+std::string AlsaPcmStream::pcmName(const std::string& name) {
+    return name.rfind("alsa:", 0) == 0 ? name.substr(5) : name;
+}
+
+std::unique_ptr<AlsaPcmStream::Io> AlsaPcmStream::createAlsaIo() {
+#if CVOSC_HAVE_ALSA
+    return std::make_unique<AlsaIo>();
+#else
+    return nullptr;
+#endif
+}
+
+bool AlsaPcmStream::start(const Config& config, Callback callback, std::unique_ptr<Io> io) {
+    stop();
+    if (!io) {
+        io = createAlsaIo();
+        if (!io) {
+            setError("This build has no ALSA support");
+            return false;
+        }
+    }
+
+    config_ = config;
+    std::string error;
+    if (!io->open(config_, error)) {
+        setError(error);
+        return false;
+    }
+    int result = io->start();
+    if (result < 0) {
+        setError("Cannot start " + config_.device + ": " + std::strerror(-result));
+        io->close();
+        return false;
+    }
+
+    io_ = std::move(io);
+    callback_ = std::move(callback);
+    buffer_.assign(static_cast<size_t>(config_.periodFrames) * config_.channels, 0.0f);
+    periods_ = 0;
+    frames_ = 0;
+    xruns_ = 0;
+    recoveries_ = 0;
+    running_ = true;
+    thread_ = std::thread(&AlsaPcmStream::run, this);
+    return true;
+}
+
+void AlsaPcmStream::stop() {
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    if (io_) {
+        io_->close();
+        io_.reset();
+    }
+}
+
+AlsaPcmStream::Stats AlsaPcmStream::getStats() const {
+    Stats stats;
+    stats.periods = periods_.load();
+    stats.frames = frames_.load();
+    stats.xruns = xruns_.load();
+    stats.recoveries = recoveries_.load();
+    stats.realtime = realtime_.load();
+    return stats;
+}
+
+std::string AlsaPcmStream::getLastError() const {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    return lastError_;
+}
+
+void AlsaPcmStream::setError(const std::string& error) {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    lastError_ = error;
+}
+
+void AlsaPcmStream::run() {
+    if (config_.realtimePriority > 0) {
+        sched_param param{};
+        param.sched_priority = std::min(config_.realtimePriority, sched_get_priority_max(SCHED_FIFO));
+        // Needs CAP_SYS_NICE or an rtprio limit; without it the stream still runs, just less reliably
+        realtime_ = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+
+    const bool capture = config_.direction == Direction::CAPTURE;
+    const size_t period = config_.periodFrames;
+    // Long enough for a healthy device to produce a period several times over
+    const int timeoutMs = std::max(10, static_cast<int>(4000.0 * period * config_.periods / config_.sampleRate));
+
+    while (running_) {
+        int ready = io_->wait(timeoutMs);
+        if (ready == 0) {
+            continue;
+        }
+        if (ready < 0) {
+            if (!handleError(ready)) {
+                break;
+            }
+            continue;
+        }
+        if (!capture) {
+            callback_(buffer_.data(), period);
+        }
+        long moved = io_->transfer(buffer_.data(), period);
+        if (moved < 0) {
+            if (!handleError(static_cast<int>(moved))) {
+                break;
+            }
+            continue;
+        }
+        if (capture && moved > 0) {
+            callback_(buffer_.data(), static_cast<size_t>(moved));
+        }
+        periods_.fetch_add(1, std::memory_order_relaxed);
+        frames_.fetch_add(static_cast<uint64_t>(moved), std::memory_order_relaxed);
+    }
+}
+
+bool AlsaPcmStream::handleError(int error) {
+    if (error == -EPIPE || error == -ESTRPIPE) {
+        xruns_.fetch_add(1, std::memory_order_relaxed);
+        if (PerformanceMonitor* monitor = monitor_.load()) {
+            monitor->recordBufferUnderrun();
+        }
+    }
+    int result = io_->recover(error);
+    if (result < 0) {
+        std::string details = config_.device + ": " + std::strerror(-error) + ", recovery: " + std::strerror(-result);
+        setError(details);
+        AUDIO_ERROR("ALSA stream stopped", details, true, "Check the device, then restart the stream");
+        running_ = false;
+        return false;
+    }
+    recoveries_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class PerformanceMonitor;
+
+/**
+ * @brief Direct ALSA PCM stream (mmap access) on its own thread, without PortAudio
+ *
+ * The hardware buffer is read and written in place through
+ * snd_pcm_mmap_begin()/commit(), with periods down to 16 frames and no
+ * intermediate buffering. The stream thread asks for SCHED_FIFO and runs
+ * without it if the process may not. An xrun is recovered in place
+ * (re-prepare, restart), counted, and reported to the attached
+ * PerformanceMonitor as a buffer underrun.
+ *
+ * Device access sits behind Io so the period loop also runs against a fake
+ * PCM. The ALSA Io is compiled only where ALSA was found (CVOSC_HAVE_ALSA).
+ */
+class AlsaPcmStream {
+public:
+    enum class Direction {
+        CAPTURE,
+        PLAYBACK
+    };
+
+    struct Config {
+        std::string device = "hw:0,0";
+        Direction direction = Direction::CAPTURE;
+        unsigned channels = 2;
+        unsigned sampleRate = 48000;
+        unsigned periodFrames = 16;
+        unsigned periods = 2;          // Hardware buffer is periods * periodFrames
+        int realtimePriority = 80;     // SCHED_FIFO priority; 0 leaves the thread's policy alone
+    };
+
+    struct Stats {
+        uint64_t periods = 0;
+        uint64_t frames = 0;
+        uint64_t xruns = 0;            // Overruns (capture) or underruns (playback)
+        uint64_t recoveries = 0;
+        bool realtime = false;         // SCHED_FIFO was granted
+    };
+
+    // Interleaved float, Config::channels per frame, on the stream thread.
+    // Capture: the frames just read. Playback: fill the frames to be written.
+    using Callback = std::function<void(float* interleaved, size_t frames)>;
+
+    // One device, one period at a time. Errors are negative errno values, as ALSA returns them.
+    class Io {
+    public:
+        virtual ~Io() = default;
+        // Opens and configures; updates config to what the device accepted
+        virtual bool open(Config& config, std::string& error) = 0;
+        virtual int start() = 0;
+        // 1 when a period can be transferred, 0 on timeout, < 0 on error
+        virtual int wait(int timeoutMs) = 0;
+        // Frames transferred, or < 0 (-EPIPE for an xrun, -ESTRPIPE when suspended)
+        virtual long transfer(float* interleaved, size_t frames) = 0;
+        // Brings the stream back after an error from wait() or transfer(); 0 on success
+        virtual int recover(int error) = 0;
+        virtual void close() = 0;
+    };
+
+    AlsaPcmStream();
+    ~AlsaPcmStream();
+    AlsaPcmStream(const AlsaPcmStream&) = delete;
+    AlsaPcmStream& operator=(const AlsaPcmStream&) = delete;
+
+    // Without io, ALSA is used (and start() fails where it is not compiled in)
+    bool start(const Config& config, Callback callback, std::unique_ptr<Io> io = nullptr);
+    void stop();
+    bool isRunning() const { return running_; }
+
+    // As negotiated with the device, once started
+    const Config& getConfig() const { return config_; }
+    Stats getStats() const;
+    std::string getLastError() const;
+    void setMonitor(PerformanceMonitor* monitor) { monitor_ = monitor; }
+
+    static bool isAvailable();
+    // "hw:1,0", "plughw:1,0", or "alsa:<any PCM name>"
+    static bool isAlsaDeviceName(const std::string& name);
+    static std::string pcmName(const std::string& name);
+    static std::unique_ptr<Io> createAlsaIo();   // nullptr without ALSA
+
+private:
+    Config config_;
+    Callback callback_;
+    std::unique_ptr<Io> io_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<PerformanceMonitor*> monitor_{nullptr};
+    std::vector<float> buffer_;
+
+    std::atomic<uint64_t> periods_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> xruns_{0};
+    std::atomic<uint64_t> recoveries_{0};
+    std::atomic<bool> realtime_{false};
+
+    mutable std::mutex errorMutex_;
+    std::string lastError_;
+
+    void run();
+    bool handleError(int error);
+    void setError(const std::string& error);
+};
@@ -1,5 +1,11 @@
 #include "CVReader.h"
+#include "DeviceInventory.h"
 #include "ErrorHandler.h"
+#include "LatencyTracer.h"
+#include "PerformanceMonitor.h"
+#include "ResourceSampler.h"
+#include "StartupProfiler.h"
+#include "TraceLog.h"
 #include <iostream>
 #include <algorithm>
 #include <stdexcept>
@@ -112,6 +118,15 @@ std::string CVReader::getFilterInfo(int channel) const {
     return "No filter";
 }
 
+void CVReader::setInsertChain(std::shared_ptr<PluginInsertChain> chain) {
+    if (chain) {
+        chain->setSampleRate(sampleRate);
+    }
+    // The audio callback holds valuesMutex while it uses the chain
+    std::lock_guard<std::mutex> lock(valuesMutex);
+    insertChain = std::move(chain);
+}
+
 std::vector<float> CVReader::readRawChannels() {
     std::lock_guard<std::mutex> lock(valuesMutex);
     return rawValues;
@@ -123,6 +138,12 @@ void CVReader::readRawChannels(std::vector<float>& output) {
 }
 
 bool CVReader::initialize() {
+    auto phase = StartupProfiler::getInstance().phase("cv_reader_initialize");
+    // PortAudio lists ALSA devices with their hw: names too, so it is the fallback
+    if (AlsaPcmStream::isAlsaDeviceName(deviceName) && initializeAlsa()) {
+        return true;
+    }
+    
     PaError err = Pa_Initialize();
     if (err != paNoError) {
         std::string errorMsg = "PortAudio initialization failed";
@@ -232,7 +253,73 @@ bool CVReader::initialize() {
     return true;
 }
 
+bool CVReader::initializeAlsa() {
+    AlsaPcmStream::Config config;
+    config.device = deviceName;
+    config.direction = AlsaPcmStream::Direction::CAPTURE;
+    config.channels = static_cast<unsigned>(numChannels);
+    config.sampleRate = static_cast<unsigned>(sampleRate);
+    config.periodFrames = ALSA_PERIOD_FRAMES;
+    
+    auto alsa = std::make_unique<AlsaPcmStream>();
+    alsa->setMonitor(monitor.load());
+    bool started = alsa->start(config, [this, device = alsa.get()](float* input, size_t frames) {
+        if (!initialized) return;
+        const size_t stride = device->getConfig().channels;
+        if (stride != static_cast<size_t>(numChannels)) {
+            for (size_t frame = 0; frame < frames; ++frame) {
+                for (int channel = 0; channel < numChannels; ++channel) {
+                    alsaScratch[frame * numChannels + channel] = input[frame * stride + channel];
+                }
+            }
+            input = alsaScratch.data();
+        }
+        processAudio(input, frames, nullptr);
+    });
+    if (!started) {
+        AUDIO_ERROR("Direct ALSA capture unavailable", deviceName + ": " + alsa->getLastError(), true,
+                   "Falling back to PortAudio");
+        return false;
+    }
+    
+    // Everything the callback reads is set before initialized lets it run
+    const auto& negotiated = alsa->getConfig();
+    sampleRate = negotiated.sampleRate;
+    maxChannels = std::min(static_cast<int>(negotiated.channels), 8);
+    numChannels = std::min(numChannels, maxChannels);
+    latestValues.resize(numChannels, 0.0f);
+    rawValues.resize(numChannels, 0.0f);
+    alsaScratch.assign(static_cast<size_t>(negotiated.periodFrames) * numChannels, 0.0f);
+    currentDeviceName = deviceName;
+    alsaStream = std::move(alsa);
+    initialized = true;
+    
+    ErrorHandler::getInstance().logInfo("CV Reader initialized with direct ALSA capture",
+                                        "Device: " + deviceName + ", Channels: " + std::to_string(numChannels) +
+                                        ", Sample Rate: " + std::to_string(negotiated.sampleRate) +
+                                        " Hz, Period: " + std::to_string(negotiated.periodFrames) + " frames x " +
+                                        std::to_string(negotiated.periods));
+    return true;
+}
+
+AlsaPcmStream::Stats CVReader::getAlsaStats() const {
+    return alsaStream ? alsaStream->getStats() : AlsaPcmStream::Stats();
+}
+
+void CVReader::attachMonitor(PerformanceMonitor& monitor) {
+    this->monitor.store(&monitor, std::memory_order_release);
+    if (alsaStream) {
+        alsaStream->setMonitor(&monitor);
+    }
+}
+
 void CVReader::close() {
+    if (alsaStream) {
+        alsaStream->stop();
+        alsaStream.reset();
+        initialized = false;
+        return;
+    }
     if (stream) {
         Pa_CloseStream(stream);
         stream = nullptr;
@@ -252,27 +339,37 @@ void CVReader::readChannels(std::vector<float>& output) {
 
 int CVReader::audioCallback(const void* inputBuffer, void* /* outputBuffer */,
                            unsigned long framesPerBuffer,
-                           const PaStreamCallbackTimeInfo* /* timeInfo */,
+                           const PaStreamCallbackTimeInfo* timeInfo,
                            PaStreamCallbackFlags /* statusFlags */,
                            void* userData) {
     CVReader* reader = static_cast<CVReader*>(userData);
     const float* input = static_cast<const float*>(inputBuffer);
     
-    return reader->processAudio(input, framesPerBuffer);
+    return reader->processAudio(input, framesPerBuffer, timeInfo);
 }
 
-int CVReader::processAudio(const float* input, unsigned long frameCount) {
+int CVReader::processAudio(const float* input, unsigned long frameCount, const PaStreamCallbackTimeInfo* timeInfo) {
     if (!input || !initialized) return paContinue;
     
-    // Debug: Log every 100th call to avoid spam
-    static int callCount = 0;
-    callCount++;
-    if (callCount % 100 == 0) {
-        std::cout << "[CVReader::processAudio] Call #" << callCount 
-                  << ", frameCount=" << frameCount 
-                  << ", numChannels=" << numChannels << std::endl;
+    // Per-thread CPU attribution (no-op after the first callback on this thread)
+    ResourceSampler::getInstance().registerCurrentThread("CVReader audio");
+    
+    // Sampled latency tracing: ADC time of the block, then each processing stage
+    auto& tracer = LatencyTracer::getInstance();
+    const uint64_t traceId = tracer.beginTrace();
+    PerformanceMonitor* const blockMonitor = monitor.load(std::memory_order_acquire);
+    auto stageStart = LatencyTracer::Clock::now();
+    auto captured = stageStart;
+    if (timeInfo && (traceId || blockMonitor)) {
+        captured = LatencyTracer::fromStreamTime(timeInfo->inputBufferAdcTime, timeInfo->currentTime, stageStart);
+    }
+    if (traceId) {
+        tracer.setThreadName("CVReader audio");
+        tracer.recordSpan(traceId, "adc_capture", captured, stageStart);
     }
     
+    TRACE_DEBUG(TraceCategory::Audio, "CVReader block: frames=%lu channels=%d", frameCount, numChannels);
+    
     std::lock_guard<std::mutex> lock(valuesMutex);
     
     // Process samples for each channel
@@ -291,6 +388,24 @@ int CVReader::processAudio(const float* input, unsigned long frameCount) {
             channelSamples[channel].push_back(sample);
         }
     }
+    if (traceId) {
+        auto now = LatencyTracer::Clock::now();
+        tracer.recordSpan(traceId, "filter", stageStart, now);
+        stageStart = now;
+    }
+    
+    // Plugin inserts (timed and bypassed on overrun by the chain itself)
+    if (insertChain) {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            insertChain->process(channel, channelSamples[channel].data(),
+                                 static_cast<uint32_t>(channelSamples[channel].size()));
+        }
+        if (traceId) {
+            auto now = LatencyTracer::Clock::now();
+            tracer.recordSpan(traceId, "plugin_inserts", stageStart, now);
+            stageStart = now;
+        }
+    }
     
     // Process each channel based on its signal type
     for (int channel = 0; channel < numChannels; ++channel) {
@@ -328,18 +443,27 @@ int CVReader::processAudio(const float* input, unsigned long frameCount) {
         
         latestValues[channel] = rawValues[channel];
         
-        // Debug: Log channel values every 100th call
-        if (callCount % 100 == 0) {
-            std::cout << "[CVReader] Channel " << channel 
-                      << ": raw=" << rawValues[channel] 
-                      << ", latest=" << latestValues[channel]
-                      << ", type=" << signalTypeToString(channelType) << std::endl;
-        }
+        TRACE_VERBOSE(TraceCategory::Audio, "CVReader channel %d: raw=%f type=%d", channel, rawValues[channel],
+                      static_cast<int>(channelType));
+    }
+    
+    if (traceId) {
+        auto now = LatencyTracer::Clock::now();
+        tracer.recordSpan(traceId, "signal_analysis", stageStart, now);
+        stageStart = now;
     }
     
     // Apply calibration if enabled
     if (calibrationEnabled) {
         latestValues = calibrator->applyCalibration(rawValues);
+        if (traceId) {
+            tracer.recordSpan(traceId, "calibration", stageStart, LatencyTracer::Clock::now());
+        }
+    }
+    latestTraceId.store(traceId);
+    if (blockMonitor) {
+        blockMonitor->recordStageLatency(PerformanceMonitor::LatencyStage::CaptureToProcess,
+                                         LatencyTracer::Clock::now() - captured);
     }
     
     return paContinue;
@@ -348,6 +472,17 @@ int CVReader::processAudio(const float* input, unsigned long frameCount) {
 PaDeviceIndex CVReader::findDevice(const std::string& deviceName) {
     int numDevices = Pa_GetDeviceCount();
     
+    // The cached inventory usually knows the index; one lookup confirms it
+    if (auto inventory = DeviceInventory::loadShared(DeviceInventory::getDefaultPath())) {
+        const auto* cached = inventory->findByName(deviceName);
+        if (cached && cached->index >= 0 && cached->index < numDevices) {
+            const PaDeviceInfo* deviceInfo = Pa_GetDeviceInfo(cached->index);
+            if (deviceInfo && deviceName == deviceInfo->name) {
+                return cached->index;
+            }
+        }
+    }
+    
     for (int i = 0; i < numDevices; ++i) {
         const PaDeviceInfo* deviceInfo = Pa_GetDeviceInfo(i);
         if (deviceInfo && std::string(deviceInfo->name).find(deviceName) != std::string::npos) {
@@ -7,10 +7,14 @@
 #include <mutex>
 #include <atomic>
 #include <portaudio.h>
+#include "AlsaPcmStream.h"
 #include "CVCalibrator.h"
 #include "SignalFilter.h"
+#include "../utils/PluginInsertChain.h"
 #include "../core/SignalTypes.h"
 
+class PerformanceMonitor;
+
 class CVReader {
 private:
     PaStream* stream;
@@ -26,12 +30,24 @@ private:
     static constexpr int FRAMES_PER_BUFFER = 64;
     static constexpr int DEFAULT_CHANNELS = 2;  // Start with stereo, auto-detect max
     
+    // Direct ALSA capture, instead of PortAudio, for "hw:", "plughw:" and "alsa:" device names
+    std::unique_ptr<AlsaPcmStream> alsaStream;
+    std::vector<float> alsaScratch;  // Device frames narrowed to numChannels
+    std::atomic<PerformanceMonitor*> monitor{nullptr};   // Read on the audio thread
+    static constexpr int ALSA_PERIOD_FRAMES = 16;
+    
     // Calibration and filtering
     std::unique_ptr<CVCalibrator> calibrator;
     std::vector<std::unique_ptr<IFilter>> channelFilters;
     bool calibrationEnabled = true;
     bool filteringEnabled = true;
     
+    // Plugin inserts, run on the filtered block of each channel
+    std::shared_ptr<PluginInsertChain> insertChain;
+    
+    // Trace id of the block behind latestValues (0 when that block was not sampled)
+    std::atomic<uint64_t> latestTraceId{0};
+    
     // Signal type detection
     std::vector<SignalAnalysis> channelAnalysis;
     std::vector<SignalType> channelSignalTypes;
@@ -56,6 +72,12 @@ public:
     std::string getCurrentDeviceName() const { return currentDeviceName; }
     bool isInitialized() const { return initialized; }
     
+    // Direct ALSA backend
+    bool isUsingAlsa() const { return alsaStream != nullptr; }
+    AlsaPcmStream::Stats getAlsaStats() const;
+    // ALSA xruns are recorded as buffer underruns
+    void attachMonitor(PerformanceMonitor& monitor);
+    
     // Calibration methods
     void enableCalibration(bool enable) { calibrationEnabled = enable; }
     bool isCalibrationEnabled() const { return calibrationEnabled; }
@@ -74,6 +96,13 @@ public:
     void clearChannelFilters();
     std::string getFilterInfo(int channel) const;
     
+    // Plugin insert stage
+    void setInsertChain(std::shared_ptr<PluginInsertChain> chain);
+    std::shared_ptr<PluginInsertChain> getInsertChain() const { return insertChain; }
+    
+    // Latency tracing: claims the trace of the current values so it is followed once
+    uint64_t takeLatestTraceId() { return latestTraceId.exchange(0); }
+    
     // Raw data access (uncalibrated/unfiltered)
     std::vector<float> readRawChannels();
     void readRawChannels(std::vector<float>& output);
@@ -97,8 +126,9 @@ public:
                            void* userData);
 
 private:
-    int processAudio(const float* input, unsigned long frameCount);
+    int processAudio(const float* input, unsigned long frameCount, const PaStreamCallbackTimeInfo* timeInfo);
     PaDeviceIndex findDevice(const std::string& deviceName);
+    bool initializeAlsa();
     
     // Signal analysis methods
     void analyzeSignal(int channel, const std::vector<float>& samples);
@@ -1,5 +1,6 @@
 #include "CVWriter.h"
 #include "../core/SignalTypes.h"
+#include "ErrorHandler.h"
 #include <iostream>
 #include <algorithm>
 #include <portaudio.h>
@@ -16,7 +17,6 @@ CVWriter::CVWriter()
     channelSignalTypes_.resize(channelCount_, SignalType::AUTO_DETECT);
     channelOutputModes_.resize(channelCount_, OutputMode::AUTO_DETECT);
     channelAnalysis_.resize(channelCount_);
-    outputBuffer_.resize(channelCount_, 0.0f);
     
     // Initialize analysis structures
     for (int i = 0; i < channelCount_; ++i) {
@@ -34,7 +34,6 @@ CVWriter::CVWriter(const std::string& deviceName)
     channelSignalTypes_.resize(channelCount_, SignalType::AUTO_DETECT);
     channelOutputModes_.resize(channelCount_, OutputMode::AUTO_DETECT);
     channelAnalysis_.resize(channelCount_);
-    outputBuffer_.resize(channelCount_, 0.0f);
     
     // Initialize analysis structures
     for (int i = 0; i < channelCount_; ++i) {
@@ -144,13 +143,8 @@ bool CVWriter::writeChannel(int channelId, float voltage) {
     // Process signal based on determined output mode
     float sample = processSignalForOutput(clampedVoltage, channelMode);
     
-    // Store in output buffer (thread-safe)
-    {
-        std::lock_guard<std::mutex> lock(outputMutex_);
-        if (channelId < static_cast<int>(outputBuffer_.size())) {
-            outputBuffer_[channelId] = sample;
-        }
-    }
+    // Picked up by the output callback at its next period
+    outputTargets_[channelId].store(sample, std::memory_order_relaxed);
     
     // In a real implementation, this would write to the audio output buffer
     // For now, we just log it in debug mode
@@ -200,6 +194,47 @@ void CVWriter::setChannelCount(int channelCount) {
 }
 
 bool CVWriter::initializeAudioOutput() {
+    if (AlsaPcmStream::isAlsaDeviceName(deviceName_)) {
+        AlsaPcmStream::Config config;
+        config.device = deviceName_;
+        config.direction = AlsaPcmStream::Direction::PLAYBACK;
+        config.channels = static_cast<unsigned>(channelCount_);
+        config.sampleRate = static_cast<unsigned>(sampleRate_);
+        config.periodFrames = ALSA_PERIOD_FRAMES;
+        
+        auto alsa = std::make_unique<AlsaPcmStream>();
+        alsa->setMonitor(monitor_);
+        // Each channel ramps linearly from its last value to the latest target across the
+        // period, so a new value never lands as a step; channels the device lacks are dropped
+        renderedOutput_.assign(MAX_OUTPUT_CHANNELS, 0.0f);
+        bool started = alsa->start(config, [this, device = alsa.get()](float* output, size_t frames) {
+            const size_t channels = device->getConfig().channels;
+            const size_t driven = std::min(channels, MAX_OUTPUT_CHANNELS);
+            const float inverseFrames = 1.0f / static_cast<float>(frames);
+            for (size_t channel = 0; channel < channels; ++channel) {
+                float start = 0.0f;
+                float step = 0.0f;
+                if (channel < driven) {
+                    start = renderedOutput_[channel];
+                    const float target = outputTargets_[channel].load(std::memory_order_relaxed);
+                    step = (target - start) * inverseFrames;
+                    renderedOutput_[channel] = target;
+                }
+                for (size_t frame = 0; frame < frames; ++frame) {
+                    output[frame * channels + channel] = start + step * static_cast<float>(frame + 1);
+                }
+            }
+        });
+        if (!started) {
+            AUDIO_ERROR("Failed to open ALSA output", deviceName_ + ": " + alsa->getLastError(), true,
+                       "Check the device name and that no other client holds it");
+            return false;
+        }
+        sampleRate_ = alsa->getConfig().sampleRate;
+        alsaStream_ = std::move(alsa);
+        return true;
+    }
+    
     // Stub implementation - in a real system this would:
     // 1. Initialize audio output device
     // 2. Set up output streams
@@ -211,12 +246,28 @@ bool CVWriter::initializeAudioOutput() {
 }
 
 void CVWriter::cleanupAudioOutput() {
+    if (alsaStream_) {
+        alsaStream_->stop();
+        alsaStream_.reset();
+        return;
+    }
     // Stub implementation - in a real system this would:
     // 1. Stop audio output thread
     // 2. Clean up output streams
     // 3. Release audio device
 }
 
+AlsaPcmStream::Stats CVWriter::getAlsaStats() const {
+    return alsaStream_ ? alsaStream_->getStats() : AlsaPcmStream::Stats();
+}
+
+void CVWriter::attachMonitor(PerformanceMonitor& monitor) {
+    monitor_ = &monitor;
+    if (alsaStream_) {
+        alsaStream_->setMonitor(&monitor);
+    }
+}
+
 float CVWriter::voltageToSample(float voltage) const {
     // Convert voltage (-10V to +10V) to audio sample (-1.0 to +1.0)
     float normalized = (voltage - minVoltage_) / (maxVoltage_ - minVoltage_);
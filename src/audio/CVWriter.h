@@ -4,10 +4,14 @@
 #include <vector>
 #include <portaudio.h>
 #include <memory>
+#include <array>
 #include <mutex>
 #include <atomic>
 #include <functional>
 #include "../core/SignalTypes.h"
+#include "AlsaPcmStream.h"
+
+class PerformanceMonitor;
 
 /**
  * @brief CV Writer class for outputting CV signals from OSC data
@@ -59,6 +63,12 @@ public:
     void setVoltageRange(float minVoltage, float maxVoltage);
     void setChannelCount(int channelCount);
     
+    // Direct ALSA output, used for "hw:", "plughw:" and "alsa:" device names
+    bool isUsingAlsa() const { return alsaStream_ != nullptr; }
+    AlsaPcmStream::Stats getAlsaStats() const;
+    // ALSA xruns are recorded as buffer underruns
+    void attachMonitor(PerformanceMonitor& monitor);
+    
     // Error handling
     std::string getLastError() const { return lastError_; }
     
@@ -83,8 +93,17 @@ private:
     
     // PortAudio output
     PaStream* outputStream_;
-    std::vector<float> outputBuffer_;
-    std::mutex outputMutex_;
+    
+    // Latest sample per channel, written by writeChannel() and read by the
+    // output callback without a lock; the callback ramps to it over each period
+    static constexpr size_t MAX_OUTPUT_CHANNELS = 32;
+    std::array<std::atomic<float>, MAX_OUTPUT_CHANNELS> outputTargets_{};
+    std::vector<float> renderedOutput_;   // Output callback only: where each ramp ended
+    
+    // Direct ALSA output
+    std::unique_ptr<AlsaPcmStream> alsaStream_;
+    PerformanceMonitor* monitor_ = nullptr;
+    static constexpr unsigned ALSA_PERIOD_FRAMES = 16;
     
     // Constants for analysis
     static constexpr float CV_STABILITY_THRESHOLD = 0.01f;
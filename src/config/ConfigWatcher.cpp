@@ -0,0 +1,326 @@
+#include "ConfigWatcher.h"
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#elif defined(__APPLE__)
+#include <sys/event.h>
+#endif
+
+namespace {
+
+enum class WaitResult { Error, Timeout, Changed, Woken };
+
+std::pair<std::string, std::string> splitPath(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    if (slash == std::string::npos) {
+        return {".", path};
+    }
+    return {slash == 0 ? "/" : path.substr(0, slash), path.substr(slash + 1)};
+}
+
+void drainPipe(int fd) {
+    char buffer[64];
+    while (read(fd, buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+#if defined(__linux__)
+
+// Watches the directory, so replacing the file by rename is seen as IN_MOVED_TO
+class FileEvents {
+public:
+    bool open(const std::string& path, int wakeFd) {
+        auto [directory, name] = splitPath(path);
+        fileName_ = name;
+        wakeFd_ = wakeFd;
+        fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd_ < 0) {
+            return false;
+        }
+        return inotify_add_watch(fd_, directory.c_str(),
+                                 IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_ATTRIB) >= 0;
+    }
+
+    ~FileEvents() {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    WaitResult wait(int timeoutMs) {
+        pollfd fds[2] = {{fd_, POLLIN, 0}, {wakeFd_, POLLIN, 0}};
+        int ready = poll(fds, 2, timeoutMs);
+        if (ready < 0) {
+            return errno == EINTR ? WaitResult::Timeout : WaitResult::Error;
+        }
+        if (ready == 0) {
+            return WaitResult::Timeout;
+        }
+        if (fds[1].revents) {
+            drainPipe(wakeFd_);
+            return WaitResult::Woken;
+        }
+
+        bool relevant = false;
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(fd_, buffer, sizeof(buffer))) > 0) {
+            for (char* p = buffer; p < buffer + length;) {
+                auto* event = reinterpret_cast<inotify_event*>(p);
+                if (event->len > 0 && fileName_ == event->name) {
+                    relevant = true;
+                }
+                p += sizeof(inotify_event) + event->len;
+            }
+        }
+        return relevant ? WaitResult::Changed : WaitResult::Timeout;
+    }
+
+private:
+    int fd_ = -1;
+    int wakeFd_ = -1;
+    std::string fileName_;
+};
+
+#elif defined(__APPLE__)
+
+// kqueue reports vnode events per descriptor: the directory catches renames
+// and re-creations, and the file descriptor is reopened whenever it changes.
+class FileEvents {
+public:
+    bool open(const std::string& path, int wakeFd) {
+        path_ = path;
+        wakeFd_ = wakeFd;
+        queue_ = kqueue();
+        if (queue_ < 0) {
+            return false;
+        }
+        directoryFd_ = ::open(splitPath(path).first.c_str(), O_EVTONLY);
+        if (directoryFd_ < 0) {
+            return false;
+        }
+
+        struct kevent changes[2];
+        EV_SET(&changes[0], directoryFd_, EVFILT_VNODE, EV_ADD | EV_CLEAR, NOTE_WRITE, 0, nullptr);
+        EV_SET(&changes[1], wakeFd_, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+        if (kevent(queue_, changes, 2, nullptr, 0, nullptr) < 0) {
+            return false;
+        }
+        reopenFile();
+        return true;
+    }
+
+    ~FileEvents() {
+        if (fileFd_ >= 0) close(fileFd_);
+        if (directoryFd_ >= 0) close(directoryFd_);
+        if (queue_ >= 0) close(queue_);
+    }
+
+    WaitResult wait(int timeoutMs) {
+        struct timespec timeout = {timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+        struct kevent events[8];
+        int count = kevent(queue_, nullptr, 0, events, 8, timeoutMs < 0 ? nullptr : &timeout);
+        if (count < 0) {
+            return errno == EINTR ? WaitResult::Timeout : WaitResult::Error;
+        }
+
+        bool changed = false;
+        for (int i = 0; i < count; i++) {
+            if (static_cast<int>(events[i].ident) == wakeFd_) {
+                drainPipe(wakeFd_);
+                return WaitResult::Woken;
+            }
+            changed = true;
+            if (static_cast<int>(events[i].ident) == directoryFd_ ||
+                (events[i].fflags & (NOTE_DELETE | NOTE_RENAME))) {
+                reopenFile();
+            }
+        }
+        return changed ? WaitResult::Changed : WaitResult::Timeout;
+    }
+
+private:
+    void reopenFile() {
+        if (fileFd_ >= 0) {
+            close(fileFd_);   // Closing removes its kevent
+        }
+        fileFd_ = ::open(path_.c_str(), O_EVTONLY);
+        if (fileFd_ >= 0) {
+            struct kevent change;
+            EV_SET(&change, fileFd_, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+                   NOTE_WRITE | NOTE_EXTEND | NOTE_ATTRIB | NOTE_DELETE | NOTE_RENAME, 0, nullptr);
+            kevent(queue_, &change, 1, nullptr, 0, nullptr);
+        }
+    }
+
+    std::string path_;
+    int queue_ = -1;
+    int directoryFd_ = -1;
+    int fileFd_ = -1;
+    int wakeFd_ = -1;
+};
+
+#endif
+
+} // namespace
+
+ConfigWatcher::ConfigWatcher(const std::string& file) : filename(file) {}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+void ConfigWatcher::start(ConfigCallback configCallback) {
+    startThread([this, configCallback]() {
+        Config newConfig;
+        if (newConfig.loadFromFile(filename)) {
+            lastConfig = newConfig;
+            configCallback(newConfig);
+        }
+    });
+}
+
+void ConfigWatcher::startIncremental(ChangeCallback changeCallback) {
+    if (std::ifstream(filename).good()) {
+        lastConfig.loadFromFile(filename);
+    }
+    startThread([this, changeCallback]() {
+        Config newConfig;
+        if (!newConfig.loadFromFile(filename)) {
+            return;
+        }
+        auto changes = diffProfiles(lastConfig.getActiveProfile(), newConfig.getActiveProfile());
+        lastConfig = newConfig;
+        if (!changes.empty()) {
+            changeCallback(newConfig, changes);
+        }
+    });
+}
+
+void ConfigWatcher::startFile(FileCallback fileCallback) {
+    startThread([this, fileCallback]() { fileCallback(filename); });
+}
+
+void ConfigWatcher::startThread(std::function<void()> callback) {
+    stop();
+    onChange = std::move(callback);
+    contentChanged();   // Baseline hash, so the first event only fires on a real change
+    if (pipe(wakePipe) == 0) {
+        fcntl(wakePipe[0], F_SETFL, O_NONBLOCK);
+    }
+    watching = true;
+    watchThread = std::thread(&ConfigWatcher::watch, this);
+}
+
+void ConfigWatcher::stop() {
+    watching = false;
+    if (wakePipe[1] >= 0) {
+        char byte = 1;
+        (void)!write(wakePipe[1], &byte, 1);
+    }
+    if (watchThread.joinable()) watchThread.join();
+    for (int& fd : wakePipe) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+bool ConfigWatcher::isEventDriven() const {
+#if defined(__linux__) || defined(__APPLE__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ConfigWatcher::watch() {
+#if defined(__linux__) || defined(__APPLE__)
+    FileEvents events;
+    if (!events.open(filename, wakePipe[0])) {
+        std::cerr << "ConfigWatcher: cannot watch " << filename << ", falling back to polling" << std::endl;
+        watchPolling();
+        return;
+    }
+
+    bool pending = false;
+    auto deadline = std::chrono::steady_clock::now();
+    while (watching) {
+        int timeoutMs = -1;
+        if (pending) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            timeoutMs = static_cast<int>(std::max<int64_t>(0, remaining.count()));
+        }
+
+        switch (events.wait(timeoutMs)) {
+            case WaitResult::Error:
+                watchPolling();
+                return;
+            case WaitResult::Woken:
+                break;
+            case WaitResult::Changed:
+                // Editors emit several events per save; wait for them to settle
+                pending = true;
+                deadline = std::chrono::steady_clock::now() + debounce;
+                break;
+            case WaitResult::Timeout:
+                if (pending && std::chrono::steady_clock::now() >= deadline) {
+                    pending = false;
+                    if (contentChanged()) {
+                        fire();
+                    }
+                }
+                break;
+        }
+    }
+#else
+    watchPolling();
+#endif
+}
+
+void ConfigWatcher::watchPolling() {
+    while (watching) {
+        pollfd wake = {wakePipe[0], POLLIN, 0};
+        int timeoutMs = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(interval).count());
+        if (poll(&wake, 1, timeoutMs) > 0) {
+            drainPipe(wakePipe[0]);
+            continue;
+        }
+        if (contentChanged()) {
+            fire();
+        }
+    }
+}
+
+bool ConfigWatcher::contentChanged() {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;   // Mid-rename or deleted; wait for the file to reappear
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    size_t hash = std::hash<std::string>{}(contents.str());
+    if (hash == lastContentHash) {
+        return false;
+    }
+    lastContentHash = hash;
+    return true;
+}
+
+void ConfigWatcher::fire() {
+    reloads++;
+    try {
+        onChange();
+    } catch (const std::exception& e) {
+        std::cerr << "ConfigWatcher: reload of " << filename << " failed: " << e.what() << std::endl;
+    }
+}
@@ -1,63 +1,65 @@
 #pragma once
 
-#include <iostream>
-#include <fstream>
 #include <string>
 #include <thread>
 #include <atomic>
 #include <functional>
 #include <chrono>
-#include <sys/stat.h>
-#include <ctime>
-#include <nlohmann/json.hpp>
+#include <vector>
 #include "Config.h"
+#include "ConfigDiff.h"
 
+/**
+ * @brief Watches a configuration file and reports changes as they happen
+ *
+ * Uses inotify on Linux and kqueue on macOS, watching the containing
+ * directory as well as the file so that editors which save by writing a
+ * temporary file and renaming it over the original are picked up. Bursts of
+ * events are debounced into one reload, and saves that leave the contents
+ * unchanged are ignored. Other platforms fall back to polling stat().
+ */
 class ConfigWatcher {
-private:
-    std::string filename;
-    std::function<void(const Config &)> callback;
-    std::atomic<bool> watching{false};
-    std::thread watchThread;
-    std::chrono::seconds interval{5}; // Check every 5 seconds
-    
 public:
-    ConfigWatcher(const std::string &file) : filename(file) {}
-    ~ConfigWatcher() { stop(); }
+    using ConfigCallback = std::function<void(const Config&)>;
+    using ChangeCallback = std::function<void(const Config&, const std::vector<ProfileChange>&)>;
+    using FileCallback = std::function<void(const std::string&)>;
 
-    void start(std::function<void(const Config &)> configCallback) {
-        callback = configCallback;
-        watching = true;
-        watchThread = std::thread(&ConfigWatcher::watch, this);
-    }
+    explicit ConfigWatcher(const std::string& file);
+    ~ConfigWatcher();
 
-    void stop() {
-        watching = false;
-        if (watchThread.joinable()) watchThread.join();
-    }
+    // Called with the newly parsed Config on every content change
+    void start(ConfigCallback configCallback);
+    // Called only when the active profile changed, with the fields that did
+    void startIncremental(ChangeCallback changeCallback);
+    // For files that are not a Config (e.g. the mixer engine's JSON); called with the path
+    void startFile(FileCallback fileCallback);
+    void stop();
+    bool isWatching() const { return watching; }
 
+    // Quiet period after the last event before reloading
+    void setDebounce(std::chrono::milliseconds delay) { debounce = delay; }
+    // Poll interval when no event API is available
     void setInterval(std::chrono::seconds sec) { interval = sec; }
+    bool isEventDriven() const;
+
+    uint64_t getReloadCount() const { return reloads.load(); }
 
 private:
-    void watch() {
-        std::time_t lastWriteTime = getLastWriteTime();
-        while (watching) {
-            std::this_thread::sleep_for(interval);
-            auto currentWriteTime = getLastWriteTime();
-            if (currentWriteTime != lastWriteTime) {
-                lastWriteTime = currentWriteTime;
-                Config newConfig;
-                if (newConfig.loadFromFile(filename)) {
-                    callback(newConfig);
-                }
-            }
-        }
-    }
-
-    std::time_t getLastWriteTime() {
-        struct stat fileStat;
-        if (stat(filename.c_str(), &fileStat) == 0) {
-            return fileStat.st_mtime;
-        }
-        return 0; // If the file doesn't exist or can't be accessed
-    }
+    std::string filename;
+    std::function<void()> onChange;
+    std::atomic<bool> watching{false};
+    std::thread watchThread;
+    int wakePipe[2] = {-1, -1};
+    std::chrono::milliseconds debounce{100};
+    std::chrono::seconds interval{5};
+    size_t lastContentHash = 0;
+    std::atomic<uint64_t> reloads{0};
+    Config lastConfig;
+
+    void startThread(std::function<void()> callback);
+    void watch();
+    void watchPolling();
+    // Re-reads the file; false when it is missing or its contents did not change
+    bool contentChanged();
+    void fire();
 };
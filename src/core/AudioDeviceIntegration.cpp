@@ -1,5 +1,6 @@
 #include "AudioDeviceIntegration.h"
 #include "AudioDeviceManager.h"
+#include "TraceLog.h"
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -29,10 +30,7 @@ float AudioDeviceIntegration::getInputSample(const std::string& deviceId) const
         // Get real audio input level from the stream
         float cvLevel = streamManager_->getInputLevel(deviceId);
         
-        // ДЕТАЛЬНАЯ ДИАГНОСТИКА: Логируем каждое значение > 0
-        if (cvLevel > 0.001f) {
-            printf("[AUDIO INPUT] Device %s: Raw level=%.6fV\n", deviceId.c_str(), cvLevel);
-        }
+        TRACE_DEBUG(TraceCategory::Device, "input %s level=%.6fV", deviceId, cvLevel);
         
         // Log occasionally for debugging
         static auto lastLog = std::chrono::steady_clock::now();
@@ -79,6 +77,13 @@ float AudioDeviceIntegration::getInputSample(const std::string& deviceId) const
     return 0.0f;
 }
 
+uint64_t AudioDeviceIntegration::takeInputTraceId(const std::string& deviceId) {
+    if (!initialized_ || !streamManager_) {
+        return 0;
+    }
+    return streamManager_->takeInputTraceId(deviceId);
+}
+
 bool AudioDeviceIntegration::sendOutputSample(const std::string& deviceId, float sample) {
     if (!initialized_ || !audioDeviceManager_ || !streamManager_) {
         return false;
@@ -107,6 +112,13 @@ bool AudioDeviceIntegration::sendOutputSample(const std::string& deviceId, float
     return false;
 }
 
+void AudioDeviceIntegration::flushOutputSamples() {
+    if (!initialized_ || !streamManager_) {
+        return;
+    }
+    streamManager_->flushOutputData();
+}
+
 bool AudioDeviceIntegration::initialize(AudioDeviceManager* deviceManager) {
     if (!deviceManager) {
         std::cerr << "AudioDeviceIntegration: Invalid device manager" << std::endl;
@@ -3,6 +3,7 @@
 #include "AudioDeviceManager.h"
 #include "OSCMixerTypes.h"
 #include "RealAudioStream.h"
+#include <atomic>
 #include <functional>
 #include <memory>
 #ifdef __APPLE__
@@ -38,8 +39,13 @@ public:
     // Get input sample from audio device
     float getInputSample(const std::string& deviceId) const;
     
+    // Latency trace of the last input sample (0 if not sampled); claimed on read
+    uint64_t takeInputTraceId(const std::string& deviceId);
+    
     // Send output sample to audio device
     bool sendOutputSample(const std::string& deviceId, float sample);
+    // Queue the samples sent this engine tick, one per output device
+    void flushOutputSamples();
     
     // Create audio stream for a device
     bool createAudioInputStream(const std::string& deviceId, int deviceIndex);
@@ -56,7 +62,7 @@ private:
     float processAndConvertAudioSignal(float rawSample, const std::string& deviceId) const;
     AudioDeviceManager* audioDeviceManager_;
     std::function<void(const std::vector<OSCDeviceConfig>&)> deviceChangeCallback_;
-    bool initialized_;
+    std::atomic<bool> initialized_;   // Set last: initialize() may run on a startup thread
     std::unique_ptr<RealAudioStreamManager> streamManager_;
     
     // Internal helpers
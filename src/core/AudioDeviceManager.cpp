@@ -1,4 +1,6 @@
 #include "AudioDeviceManager.h"
+#include "StartupProfiler.h"
+#include "TraceLog.h"
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
@@ -7,7 +9,8 @@
 #include <chrono>
 
 AudioDeviceManager::AudioDeviceManager() 
-    : initialized(false), lastDefaultInputDevice(paNoDevice) {
+    : initialized(false), lastDefaultInputDevice(paNoDevice)
+    , inventoryPath(DeviceInventory::getDefaultPath()) {
 }
 
 AudioDeviceManager::~AudioDeviceManager() {
@@ -26,14 +29,27 @@ bool AudioDeviceManager::initialize() {
         // Continue initialization to allow device listing
     }
     
-    PaError err = Pa_Initialize();
+    auto& profiler = StartupProfiler::getInstance();
+    {
+        auto phase = profiler.phase("device_inventory_load");
+        inventory.load(inventoryPath);
+    }
+    
+    PaError err;
+    {
+        auto phase = profiler.phase("portaudio_init");
+        err = Pa_Initialize();
+    }
     if (err != paNoError) {
         std::cerr << "Failed to initialize PortAudio: " << Pa_GetErrorText(err) << std::endl;
         return false;
     }
     
     initialized = true;
-    refreshDeviceList();
+    {
+        auto phase = profiler.phase("device_enumeration");
+        refreshDevices(true);
+    }
     lastDefaultInputDevice = Pa_GetDefaultInputDevice();
     
     return true;
@@ -48,6 +64,10 @@ void AudioDeviceManager::cleanup() {
 }
 
 void AudioDeviceManager::refreshDeviceList() {
+    refreshDevices(false);
+}
+
+void AudioDeviceManager::refreshDevices(bool useCachedProbes) {
     if (!initialized) {
         return;
     }
@@ -63,16 +83,42 @@ void AudioDeviceManager::refreshDeviceList() {
     PaDeviceIndex defaultInput = Pa_GetDefaultInputDevice();
     PaDeviceIndex defaultOutput = Pa_GetDefaultOutputDevice();
     
+    const DeviceInventory* cache = useCachedProbes && !inventory.empty() ? &inventory : nullptr;
     for (int i = 0; i < deviceCount; ++i) {
         AudioDeviceInfo info;
-        populateDeviceInfo(info, i);
+        populateDeviceInfo(info, i, cache);
         info.isDefaultInput = (i == defaultInput);
         info.isDefaultOutput = (i == defaultOutput);
         devices.push_back(info);
     }
+    
+    updateInventory();
 }
 
-void AudioDeviceManager::populateDeviceInfo(AudioDeviceInfo& info, PaDeviceIndex index) {
+void AudioDeviceManager::updateInventory() {
+    std::vector<DeviceInventory::Entry> entries;
+    entries.reserve(devices.size());
+    for (const auto& device : devices) {
+        DeviceInventory::Entry entry;
+        entry.index = device.index;
+        entry.name = device.name;
+        entry.hostApi = device.hostApi;
+        entry.maxInputChannels = device.maxInputChannels;
+        entry.maxOutputChannels = device.maxOutputChannels;
+        entry.defaultSampleRate = device.defaultSampleRate;
+        entry.available = device.isCurrentlyAvailable;
+        entries.push_back(std::move(entry));
+    }
+    
+    DeviceInventory current;
+    current.setEntries(std::move(entries));
+    if (current != inventory) {
+        inventory = std::move(current);
+        inventory.save(inventoryPath);
+    }
+}
+
+void AudioDeviceManager::populateDeviceInfo(AudioDeviceInfo& info, PaDeviceIndex index, const DeviceInventory* cache) {
     const PaDeviceInfo* deviceInfo = Pa_GetDeviceInfo(index);
     if (!deviceInfo) {
         return;
@@ -86,6 +132,23 @@ void AudioDeviceManager::populateDeviceInfo(AudioDeviceInfo& info, PaDeviceIndex
     info.defaultLowInputLatency = deviceInfo->defaultLowInputLatency;
     info.defaultHighInputLatency = deviceInfo->defaultHighInputLatency;
     info.hostApi = getHostApiName(deviceInfo->hostApi);
+    
+    // Unchanged since the last run and usable then: skip the format probe. A device
+    // that failed it is probed again, as it may have become available since.
+    if (cache && info.maxInputChannels > 0) {
+        DeviceInventory::Entry probe;
+        probe.name = info.name;
+        probe.hostApi = info.hostApi;
+        probe.maxInputChannels = info.maxInputChannels;
+        probe.maxOutputChannels = info.maxOutputChannels;
+        probe.defaultSampleRate = info.defaultSampleRate;
+        const auto* cached = cache->findSame(probe);
+        if (cached && cached->available) {
+            info.isCurrentlyAvailable = true;
+            return;
+        }
+    }
+    
     // Use more aggressive testing for input devices
     if (info.maxInputChannels > 0) {
         // First try format test (safer)
@@ -134,17 +197,21 @@ AudioDeviceInfo AudioDeviceManager::getDefaultOutputDevice() const {
 }
 
 AudioDeviceInfo AudioDeviceManager::findDeviceByName(const std::string& name) const {
-    std::cout << "🔍 Debug: findDeviceByName called with: '" << name << "'" << std::endl;
-    std::cout << "🔍 Debug: Total devices to search: " << devices.size() << std::endl;
+    // Exact names resolve through the inventory index without a scan
+    if (const auto* entry = inventory.findByName(name)) {
+        if (entry->index >= 0 && static_cast<size_t>(entry->index) < devices.size() &&
+            devices[entry->index].name == name) {
+            return devices[entry->index];
+        }
+    }
     
     for (const auto& device : devices) {
-        std::cout << "🔍 Debug: Comparing with device: '" << device.name << "' (index: " << device.index << ")" << std::endl;
         if (isDeviceNameMatch(device.name, name)) {
-            std::cout << "✅ Debug: Found matching device: '" << device.name << "' (index: " << device.index << ")" << std::endl;
+            TRACE_DEBUG(TraceCategory::Device, "findDeviceByName: '%s' -> index %d", name, device.index);
             return device;
         }
     }
-    std::cout << "❌ Debug: No matching device found for: '" << name << "'" << std::endl;
+    TRACE_DEBUG(TraceCategory::Device, "findDeviceByName: no device matches '%s'", name);
     return AudioDeviceInfo(); // Return invalid device if not found
 }
 
@@ -422,10 +489,7 @@ std::string AudioDeviceManager::formatLatency(double latency) {
 }
 
 bool AudioDeviceManager::isDeviceNameMatch(const std::string& deviceName, const std::string& searchName) {
-    std::cout << "  🔍 isDeviceNameMatch: comparing '" << deviceName << "' with '" << searchName << "'" << std::endl;
-    
     if (deviceName == searchName) {
-        std::cout << "  ✅ Exact match found" << std::endl;
         return true;
     }
     
@@ -436,16 +500,7 @@ bool AudioDeviceManager::isDeviceNameMatch(const std::string& deviceName, const
     std::transform(lowerDeviceName.begin(), lowerDeviceName.end(), lowerDeviceName.begin(), ::tolower);
     std::transform(lowerSearchName.begin(), lowerSearchName.end(), lowerSearchName.begin(), ::tolower);
     
-    std::cout << "  🔍 Case-insensitive: '" << lowerDeviceName << "' vs '" << lowerSearchName << "'" << std::endl;
-    
-    bool found = lowerDeviceName.find(lowerSearchName) != std::string::npos;
-    if (found) {
-        std::cout << "  ✅ Partial match found" << std::endl;
-    } else {
-        std::cout << "  ❌ No match" << std::endl;
-    }
-    
-    return found;
+    return lowerDeviceName.find(lowerSearchName) != std::string::npos;
 }
 
 // Permission management methods
@@ -6,6 +6,7 @@
 #include <functional>
 #include <portaudio.h>
 #include "CommonTypes.h"
+#include "DeviceInventory.h"
 
 #ifdef __APPLE__
 #include "MacOSPermissions.h"
@@ -36,16 +37,23 @@ private:
     std::vector<std::function<void(const std::vector<AudioDeviceInfo>&)>> deviceChangeCallbacks;
     bool initialized;
     PaDeviceIndex lastDefaultInputDevice;
+    DeviceInventory inventory;          // Last known devices, persisted between runs
+    std::string inventoryPath;
     
 public:
     AudioDeviceManager();
     ~AudioDeviceManager();
     
-    // Core functionality
+    // Core functionality. initialize() trusts the cached inventory for devices
+    // whose capabilities are unchanged; refreshDeviceList() always probes.
     bool initialize();
     void cleanup();
     void refreshDeviceList();
     
+    // Device inventory cache (DeviceInventory::getDefaultPath() unless set before initialize)
+    void setInventoryCachePath(const std::string& path) { inventoryPath = path; }
+    const DeviceInventory& getInventory() const { return inventory; }
+    
     // Permission management
     bool checkPermissions();
     void requestPermissions(std::function<void(bool)> callback = nullptr);
@@ -88,7 +96,9 @@ public:
     static bool isDeviceNameMatch(const std::string& deviceName, const std::string& searchName);
     
 private:
-    void populateDeviceInfo(AudioDeviceInfo& info, PaDeviceIndex index);
+    void refreshDevices(bool useCachedProbes);
+    void populateDeviceInfo(AudioDeviceInfo& info, PaDeviceIndex index, const DeviceInventory* cache = nullptr);
+    void updateInventory();
     void notifyDeviceChange();
     bool compareDeviceLists(const std::vector<AudioDeviceInfo>& oldList, 
                            const std::vector<AudioDeviceInfo>& newList) const;
@@ -0,0 +1,148 @@
+#include "ConfigDiff.h"
+#include <algorithm>
+
+namespace {
+
+bool sameDestination(const OSCDeviceConfig& a, const OSCDeviceConfig& b) {
+    return a.networkAddress == b.networkAddress && a.port == b.port;
+}
+
+bool sameBinding(const OSCDeviceConfig& a, const OSCDeviceConfig& b) {
+    return a.protocolType == b.protocolType && a.localAddress == b.localAddress &&
+           a.localPort == b.localPort && a.enabled == b.enabled;
+}
+
+bool samePerMessageFields(const OSCDeviceConfig& a, const OSCDeviceConfig& b) {
+    return a.deviceName == b.deviceName && a.oscAddress == b.oscAddress && a.oscMessage == b.oscMessage &&
+           a.signalLevel == b.signalLevel && a.supportedTypes == b.supportedTypes;
+}
+
+void diffDevices(int channelId, bool isInput, const std::vector<OSCDeviceConfig>& before,
+                 const std::vector<OSCDeviceConfig>& after, std::vector<DeviceChange>& changes) {
+    auto find = [](const std::vector<OSCDeviceConfig>& devices, const std::string& deviceId) {
+        return std::find_if(devices.begin(), devices.end(),
+                            [&deviceId](const OSCDeviceConfig& device) { return device.deviceId == deviceId; });
+    };
+
+    for (const auto& old : before) {
+        if (find(after, old.deviceId) == after.end()) {
+            changes.push_back({DeviceChangeKind::Removed, channelId, isInput, old});
+        }
+    }
+
+    for (const auto& updated : after) {
+        auto old = find(before, updated.deviceId);
+        if (old == before.end()) {
+            changes.push_back({DeviceChangeKind::Added, channelId, isInput, updated});
+            continue;
+        }
+
+        // Receivers only care about their local binding; the remote address is informational
+        bool destinationChanged = !sameDestination(*old, updated);
+        if (!sameBinding(*old, updated)) {
+            changes.push_back({DeviceChangeKind::Recreate, channelId, isInput, updated});
+        } else if (destinationChanged && !isInput) {
+            changes.push_back({DeviceChangeKind::Retarget, channelId, isInput, updated});
+        } else if (destinationChanged || !samePerMessageFields(*old, updated)) {
+            changes.push_back({DeviceChangeKind::UpdateInPlace, channelId, isInput, updated});
+        }
+    }
+}
+
+} // namespace
+
+std::vector<ProfileChange> diffProfiles(const ConfigProfile& before, const ConfigProfile& after) {
+    std::vector<ProfileChange> changes;
+    if (before.oscHost != after.oscHost) changes.push_back({ProfileField::OscHost});
+    if (before.oscPort != after.oscPort) changes.push_back({ProfileField::OscPort});
+    if (before.audioDevice != after.audioDevice) changes.push_back({ProfileField::AudioDevice});
+    if (before.audioOutputDevice != after.audioOutputDevice) changes.push_back({ProfileField::AudioOutputDevice});
+    if (before.autoStartAudio != after.autoStartAudio) changes.push_back({ProfileField::AutoStartAudio});
+    if (before.rememberDevices != after.rememberDevices) changes.push_back({ProfileField::RememberDevices});
+    if (before.updateIntervalMs != after.updateIntervalMs) changes.push_back({ProfileField::UpdateInterval});
+    if (before.language != after.language) changes.push_back({ProfileField::Language});
+
+    size_t channels = std::max(before.cvRanges.size(), after.cvRanges.size());
+    for (size_t i = 0; i < channels; i++) {
+        bool inBefore = i < before.cvRanges.size();
+        bool inAfter = i < after.cvRanges.size();
+        if (inBefore != inAfter || before.cvRanges[i].min != after.cvRanges[i].min ||
+            before.cvRanges[i].max != after.cvRanges[i].max) {
+            changes.push_back({ProfileField::CVRange, static_cast<int>(i)});
+        }
+    }
+    return changes;
+}
+
+const char* getProfileFieldName(ProfileField field) {
+    switch (field) {
+        case ProfileField::OscHost: return "osc_host";
+        case ProfileField::OscPort: return "osc_port";
+        case ProfileField::AudioDevice: return "audio_device";
+        case ProfileField::AudioOutputDevice: return "audio_output_device";
+        case ProfileField::AutoStartAudio: return "auto_start_audio";
+        case ProfileField::RememberDevices: return "remember_devices";
+        case ProfileField::UpdateInterval: return "update_interval_ms";
+        case ProfileField::CVRange: return "cv_ranges";
+        case ProfileField::Language: return "language";
+    }
+    return "unknown";
+}
+
+MixerConfigDiff diffMixerConfiguration(const MixerConfigSnapshot& before, const MixerConfigSnapshot& after) {
+    MixerConfigDiff diff;
+    if (before.masterLevel != after.masterLevel) diff.masterLevel = after.masterLevel;
+    if (before.masterMute != after.masterMute) diff.masterMute = after.masterMute;
+    if (before.outputFanout != after.outputFanout) diff.outputFanout = after.outputFanout;
+    if (before.outputCoalesce != after.outputCoalesce) diff.outputCoalesce = after.outputCoalesce;
+
+    size_t channels = std::min(before.channels.size(), after.channels.size());
+    for (size_t i = 0; i < channels; i++) {
+        const auto& old = before.channels[i];
+        const auto& updated = after.channels[i];
+        int channelId = static_cast<int>(i);
+
+        ChannelSettingsChange settings;
+        settings.channelId = channelId;
+        if (old.name != updated.name) settings.name = updated.name;
+        if (old.levelVolts != updated.levelVolts) settings.levelVolts = updated.levelVolts;
+        if (old.minRange != updated.minRange || old.maxRange != updated.maxRange) {
+            settings.range = std::make_pair(updated.minRange, updated.maxRange);
+        }
+        if (!std::equal(std::begin(old.color), std::end(old.color), std::begin(updated.color))) {
+            settings.color = std::array<float, 3>{updated.color[0], updated.color[1], updated.color[2]};
+        }
+        if (settings.name || settings.levelVolts || settings.range || settings.color) {
+            diff.channels.push_back(settings);
+        }
+
+        diffDevices(channelId, true, old.inputDevices, updated.inputDevices, diff.devices);
+        diffDevices(channelId, false, old.outputDevices, updated.outputDevices, diff.devices);
+    }
+    return diff;
+}
+
+const char* getDeviceChangeKindName(DeviceChangeKind kind) {
+    switch (kind) {
+        case DeviceChangeKind::Added: return "added";
+        case DeviceChangeKind::Removed: return "removed";
+        case DeviceChangeKind::UpdateInPlace: return "updated";
+        case DeviceChangeKind::Retarget: return "retargeted";
+        case DeviceChangeKind::Recreate: return "recreated";
+    }
+    return "unknown";
+}
+
+void copyPersistedDeviceFields(OSCDeviceConfig& target, const OSCDeviceConfig& source) {
+    target.deviceName = source.deviceName;
+    target.protocolType = source.protocolType;
+    target.networkAddress = source.networkAddress;
+    target.port = source.port;
+    target.localAddress = source.localAddress;
+    target.localPort = source.localPort;
+    target.oscAddress = source.oscAddress;
+    target.oscMessage = source.oscMessage;
+    target.signalLevel = source.signalLevel;
+    target.enabled = source.enabled;
+    target.supportedTypes = source.supportedTypes;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Config.h"
+#include "OSCMixerTypes.h"
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Structural diffs between two configurations, so a reload can be applied as
+// the smallest set of live changes instead of stopping and rebuilding streams.
+
+enum class ProfileField {
+    OscHost,
+    OscPort,
+    AudioDevice,
+    AudioOutputDevice,
+    AutoStartAudio,
+    RememberDevices,
+    UpdateInterval,
+    CVRange,
+    Language
+};
+
+struct ProfileChange {
+    ProfileField field;
+    int channel = -1;   // CVRange only
+};
+
+std::vector<ProfileChange> diffProfiles(const ConfigProfile& before, const ConfigProfile& after);
+const char* getProfileFieldName(ProfileField field);
+
+// The persisted part of the mixer state (what OSCMixerEngine::saveConfiguration writes)
+struct ChannelConfigSnapshot {
+    std::string name;
+    float levelVolts = 0.0f;
+    float minRange = -10.0f;
+    float maxRange = 10.0f;
+    float color[3] = {0.2f, 0.8f, 0.2f};
+    std::vector<OSCDeviceConfig> inputDevices;
+    std::vector<OSCDeviceConfig> outputDevices;
+};
+
+struct MixerConfigSnapshot {
+    float masterLevel = 1.0f;
+    bool masterMute = false;
+    bool outputFanout = false;
+    bool outputCoalesce = false;
+    std::vector<ChannelConfigSnapshot> channels;
+};
+
+struct ChannelSettingsChange {
+    int channelId = 0;
+    std::optional<std::string> name;
+    std::optional<float> levelVolts;
+    std::optional<std::pair<float, float>> range;
+    std::optional<std::array<float, 3>> color;
+};
+
+enum class DeviceChangeKind {
+    Added,
+    Removed,
+    UpdateInPlace,   // Only fields read per message (name, OSC address, level, types)
+    Retarget,        // Output destination host/port; the sender keeps running
+    Recreate         // Protocol, local binding or enable state; the device is rebuilt
+};
+
+struct DeviceChange {
+    DeviceChangeKind kind;
+    int channelId = 0;
+    bool isInput = false;
+    OSCDeviceConfig device;   // The new configuration (the old one for Removed)
+};
+
+struct MixerConfigDiff {
+    std::optional<float> masterLevel;
+    std::optional<bool> masterMute;
+    std::optional<bool> outputFanout;
+    std::optional<bool> outputCoalesce;
+    std::vector<ChannelSettingsChange> channels;
+    std::vector<DeviceChange> devices;
+
+    bool empty() const {
+        return !masterLevel && !masterMute && !outputFanout && !outputCoalesce && channels.empty() && devices.empty();
+    }
+};
+
+MixerConfigDiff diffMixerConfiguration(const MixerConfigSnapshot& before, const MixerConfigSnapshot& after);
+const char* getDeviceChangeKindName(DeviceChangeKind kind);
+
+// Copies the fields the configuration file persists, keeping runtime-only ones
+// (device type, audio device index, connection state) from target
+void copyPersistedDeviceFields(OSCDeviceConfig& target, const OSCDeviceConfig& source);
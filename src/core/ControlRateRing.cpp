@@ -0,0 +1,182 @@
+#include "ControlRateRing.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Fill control: speed-up per unit of relative fill error, and the integral
+// gain (per second) that trims out a steady rate mismatch. The fill is
+// averaged first, since it moves by whole values from one block to the next.
+// With a 3-value target at 100 Hz this settles in about a second.
+constexpr double kProportional = 0.25;
+constexpr double kIntegral = 0.5;
+constexpr double kFillSmoothingSeconds = 0.05;
+constexpr double kMaxIntegral = 0.5;
+constexpr double kMinRatio = 0.5;
+constexpr double kMaxRatio = 2.0;
+// Queued values beyond this multiple of the target are skipped
+constexpr double kLatencyCap = 4.0;
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 4;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+ControlRateRing::ControlRateRing() : ControlRateRing(Config()) {}
+
+ControlRateRing::ControlRateRing(const Config& config)
+    : config_(config)
+    , values_(roundUpToPowerOfTwo(config.capacity))
+    , mask_(values_.size() - 1)
+    , interpolation_(config.interpolation) {
+    config_.capacity = values_.size();
+    // Two values are taken when playback starts; anything less cannot be steered
+    targetFill_ = std::max(2.0, config_.targetLatencyMs * config_.controlRateHz / 1000.0);
+    nominalStep_ = config_.controlRateHz / config_.sampleRate;
+}
+
+bool ControlRateRing::push(float value) {
+    return push(&value, 1) == 1;
+}
+
+size_t ControlRateRing::push(const float* values, size_t count) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    const size_t accepted = std::min(count, values_.size() - (head - tail));
+    for (size_t i = 0; i < accepted; ++i) {
+        values_[(head + i) & mask_] = values[i];
+    }
+    head_.store(head + accepted, std::memory_order_release);
+
+    pushed_.fetch_add(accepted, std::memory_order_relaxed);
+    if (accepted < count) {
+        overflows_.fetch_add(count - accepted, std::memory_order_relaxed);
+    }
+    return accepted;
+}
+
+bool ControlRateRing::pop(float& value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail == head_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    value = values_[tail & mask_];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+size_t ControlRateRing::getFill() const {
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return head_.load(std::memory_order_acquire) - tail;
+}
+
+float ControlRateRing::interpolate(OutputInterpolation mode) const {
+    const float t = static_cast<float>(phase_);
+    const float p0 = window_[1];
+    const float p1 = window_[2];
+    switch (mode) {
+        case OutputInterpolation::STEP:
+            return p0;
+        case OutputInterpolation::LINEAR:
+            return p0 + (p1 - p0) * t;
+        case OutputInterpolation::CUBIC: {
+            const float pm = window_[0];
+            const float p2 = window_[3];
+            return p0 + 0.5f * t * ((p1 - pm) +
+                                    t * ((2.0f * pm - 5.0f * p0 + 4.0f * p1 - p2) +
+                                         t * (3.0f * (p0 - p1) + p2 - pm)));
+        }
+    }
+    return p0;
+}
+
+bool ControlRateRing::render(float* output, size_t frames, size_t channels) {
+    const OutputInterpolation mode = interpolation_.load(std::memory_order_relaxed);
+    size_t fill = getFill();
+
+    // (Re)start once the target is queued, ramping in from the held value.
+    // The integral is kept: it holds the rate the producer has been running at.
+    if (!playing_ && fill >= static_cast<size_t>(std::ceil(targetFill_))) {
+        window_[0] = window_[1];
+        pop(window_[2]);
+        pop(window_[3]);
+        phase_ = 0.0;
+        playing_ = true;
+        draining_ = false;
+        fill -= 2;
+        averageFill_ = static_cast<double>(fill);
+    }
+
+    if (playing_ && fill > kLatencyCap * targetFill_) {
+        const size_t skip = fill - static_cast<size_t>(std::lround(targetFill_));
+        tail_.store(tail_.load(std::memory_order_relaxed) + skip, std::memory_order_release);
+        skipped_.fetch_add(skip, std::memory_order_relaxed);
+        fill -= skip;
+    }
+
+    double ratio = 1.0;
+    if (playing_) {
+        const double seconds = static_cast<double>(frames) / config_.sampleRate;
+        // Less the part of the current period already played, so only the producer moves it in steps
+        const double occupancy = static_cast<double>(fill) - phase_;
+        averageFill_ += std::min(1.0, seconds / kFillSmoothingSeconds) * (occupancy - averageFill_);
+        const double error = (averageFill_ - targetFill_) / targetFill_;
+        integral_ = std::clamp(integral_ + kIntegral * error * seconds, -kMaxIntegral, kMaxIntegral);
+        ratio = std::clamp(1.0 + kProportional * error + integral_, kMinRatio, kMaxRatio);
+    }
+    const double step = nominalStep_ * ratio;
+
+    bool ranDry = false;
+    for (size_t frame = 0; frame < frames; ++frame) {
+        float value = window_[1];
+        if (playing_) {
+            value = interpolate(mode);
+            phase_ += step;
+            while (phase_ >= 1.0) {
+                float next;
+                if (!pop(next)) {
+                    if (!draining_) {
+                        // p2 was already popped: play on towards it before giving up
+                        draining_ = true;
+                        next = window_[3];
+                    } else {
+                        // Hold the last value pushed until the ring refills
+                        window_.fill(window_[3]);
+                        phase_ = 0.0;
+                        playing_ = false;
+                        ranDry = true;
+                        break;
+                    }
+                } else {
+                    draining_ = false;
+                }
+                phase_ -= 1.0;
+                window_ = {window_[1], window_[2], window_[3], next};
+            }
+        }
+        std::fill(output + frame * channels, output + (frame + 1) * channels, value);
+    }
+
+    if (ranDry) {
+        underruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+    lastFill_.store(fill, std::memory_order_relaxed);
+    rateRatio_.store(ratio, std::memory_order_relaxed);
+    return ranDry;
+}
+
+ControlRateRing::Stats ControlRateRing::getStats() const {
+    Stats stats;
+    stats.pushed = pushed_.load(std::memory_order_relaxed);
+    stats.overflows = overflows_.load(std::memory_order_relaxed);
+    stats.underruns = underruns_.load(std::memory_order_relaxed);
+    stats.skipped = skipped_.load(std::memory_order_relaxed);
+    stats.fill = lastFill_.load(std::memory_order_relaxed);
+    stats.rateRatio = rateRatio_.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class OutputInterpolation {
+    STEP,       // Hold each value for its whole control period
+    LINEAR,
+    CUBIC       // Catmull-Rom: smooth slopes, overshoots slightly on steps
+};
+
+/**
+ * @brief SPSC ring that turns control-rate values into audio-rate output
+ *
+ * The engine thread pushes one value per tick (or a block of them); the
+ * audio callback reads them through a fractional playhead and interpolates
+ * between neighbours, so a CV stepping at ~100 Hz leaves the DAC as a
+ * continuous signal instead of a staircase.
+ *
+ * The playhead speed is steered by the fill level: a PI controller keeps
+ * about targetLatencyMs of values queued, absorbing the drift between the
+ * engine tick and the audio clock. When the ring runs dry the playhead
+ * finishes its way to the last value pushed, holds it (no drop to zero)
+ * and counts an underrun; playback resumes, ramping from the held value,
+ * once the target fill is back.
+ * Values piling up far past the target are skipped to cap the latency.
+ *
+ * Both sides are wait-free and never allocate.
+ */
+class ControlRateRing {
+public:
+    struct Config {
+        double sampleRate = 44100.0;
+        double controlRateHz = 100.0;      // Nominal push rate; the fill control absorbs drift
+        double targetLatencyMs = 30.0;     // Queued values the playhead steers towards
+        OutputInterpolation interpolation = OutputInterpolation::LINEAR;
+        size_t capacity = 256;             // Values, rounded up to a power of two
+    };
+
+    struct Stats {
+        uint64_t pushed = 0;
+        uint64_t overflows = 0;      // Values rejected because the ring was full
+        uint64_t underruns = 0;      // Times playback ran out of values
+        uint64_t skipped = 0;        // Values dropped to bring the latency back to target
+        size_t fill = 0;             // Values queued at the last render
+        double rateRatio = 1.0;      // Playhead speed relative to the nominal control rate
+    };
+
+    ControlRateRing();
+    explicit ControlRateRing(const Config& config);
+
+    ControlRateRing(const ControlRateRing&) = delete;
+    ControlRateRing& operator=(const ControlRateRing&) = delete;
+
+    // Producer side (one thread). False, and counted, if the ring is full.
+    bool push(float value);
+    // Publishes the values as one block; returns how many fitted
+    size_t push(const float* values, size_t count);
+
+    // Consumer side (the audio callback). Writes frames of interleaved output
+    // with the same value in each of channels. True if the ring ran dry in this block.
+    bool render(float* output, size_t frames, size_t channels);
+
+    // Any thread
+    void setInterpolation(OutputInterpolation mode) { interpolation_.store(mode, std::memory_order_relaxed); }
+    OutputInterpolation getInterpolation() const { return interpolation_.load(std::memory_order_relaxed); }
+    const Config& getConfig() const { return config_; }
+    size_t getFill() const;
+    Stats getStats() const;
+
+private:
+    Config config_;
+    std::vector<float> values_;
+    size_t mask_;
+    double targetFill_;          // targetLatencyMs in values
+    double nominalStep_;         // Control periods per audio frame at ratio 1
+
+    alignas(64) std::atomic<size_t> head_{0};    // Written by the producer
+    alignas(64) std::atomic<size_t> tail_{0};    // Written by the consumer
+
+    std::atomic<OutputInterpolation> interpolation_;
+
+    // Consumer state
+    std::array<float, 4> window_{};   // p[-1], p0, p1, p2; the playhead is between p0 and p1
+    double phase_ = 0.0;
+    double averageFill_ = 0.0;
+    double integral_ = 0.0;
+    bool playing_ = false;
+    bool draining_ = false;          // Ring empty; the playhead is on its way to p2
+
+    std::atomic<uint64_t> pushed_{0};
+    std::atomic<uint64_t> overflows_{0};
+    std::atomic<uint64_t> underruns_{0};
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<size_t> lastFill_{0};
+    std::atomic<double> rateRatio_{1.0};
+
+    bool pop(float& value);
+    float interpolate(OutputInterpolation mode) const;
+};
@@ -0,0 +1,168 @@
+#include "DeviceInventory.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <sys/stat.h>
+
+namespace {
+
+void makeDirectories(const std::string& path) {
+    for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+        mkdir(path.substr(0, slash).c_str(), 0755);
+    }
+}
+
+} // namespace
+
+std::string DeviceInventory::getDefaultPath() {
+    const char* configured = std::getenv("CVOSC_DEVICE_CACHE");
+    if (configured) {
+        return std::string(configured) == "off" ? std::string() : std::string(configured);
+    }
+
+    const char* home = std::getenv("HOME");
+    if (!home || !*home) {
+        return {};
+    }
+#ifdef __APPLE__
+    return std::string(home) + "/Library/Caches/cv_to_osc_converter/device_inventory.json";
+#else
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    std::string base = cacheHome && *cacheHome ? cacheHome : std::string(home) + "/.cache";
+    return base + "/cv_to_osc_converter/device_inventory.json";
+#endif
+}
+
+bool DeviceInventory::load(const std::string& path) {
+    if (path.empty()) {
+        return false;
+    }
+    try {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return false;
+        }
+        nlohmann::json j;
+        file >> j;
+
+        std::vector<Entry> entries;
+        for (const auto& device : j.value("devices", nlohmann::json::array())) {
+            Entry entry;
+            entry.index = device.value("index", -1);
+            entry.name = device.value("name", "");
+            entry.hostApi = device.value("host_api", "");
+            entry.maxInputChannels = device.value("max_input_channels", 0);
+            entry.maxOutputChannels = device.value("max_output_channels", 0);
+            entry.defaultSampleRate = device.value("default_sample_rate", 0.0);
+            entry.available = device.value("available", false);
+            entries.push_back(std::move(entry));
+        }
+        setEntries(std::move(entries));
+        return true;
+
+    } catch (const std::exception& e) {
+        // A corrupt cache only costs a full probe
+        std::cerr << "Ignoring device inventory cache " << path << ": " << e.what() << std::endl;
+        setEntries({});
+        return false;
+    }
+}
+
+std::shared_ptr<const DeviceInventory> DeviceInventory::loadShared(const std::string& path) {
+    static std::mutex mutex;
+    static std::string loadedPath;
+    static struct stat loadedStat {};
+    static std::shared_ptr<const DeviceInventory> loaded;
+
+    struct stat current {};
+    if (path.empty() || stat(path.c_str(), &current) != 0) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (loaded && path == loadedPath && current.st_ino == loadedStat.st_ino &&
+        current.st_mtime == loadedStat.st_mtime && current.st_size == loadedStat.st_size) {
+        return loaded;
+    }
+    auto inventory = std::make_shared<DeviceInventory>();
+    if (!inventory->load(path)) {
+        return nullptr;
+    }
+    loadedPath = path;
+    loadedStat = current;
+    loaded = std::move(inventory);
+    return loaded;
+}
+
+bool DeviceInventory::save(const std::string& path) const {
+    if (path.empty()) {
+        return false;
+    }
+    nlohmann::json j;
+    j["version"] = 1;
+    j["devices"] = nlohmann::json::array();
+    for (const auto& entry : entries_) {
+        j["devices"].push_back({
+            {"index", entry.index},
+            {"name", entry.name},
+            {"host_api", entry.hostApi},
+            {"max_input_channels", entry.maxInputChannels},
+            {"max_output_channels", entry.maxOutputChannels},
+            {"default_sample_rate", entry.defaultSampleRate},
+            {"available", entry.available},
+        });
+    }
+
+    // Write and rename so a crash mid-write never leaves a truncated cache
+    makeDirectories(path);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << j.dump(2);
+        if (!file.good()) {
+            return false;
+        }
+    }
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+void DeviceInventory::setEntries(std::vector<Entry> entries) {
+    entries_ = std::move(entries);
+    rebuildIndex();
+}
+
+const DeviceInventory::Entry* DeviceInventory::findByName(const std::string& name) const {
+    auto it = byName_.find(name);
+    return it == byName_.end() ? nullptr : &entries_[it->second];
+}
+
+const DeviceInventory::Entry* DeviceInventory::findSame(const Entry& probe) const {
+    const Entry* cached = findByName(probe.name);
+    return cached && cached->sameDevice(probe) ? cached : nullptr;
+}
+
+bool DeviceInventory::operator==(const DeviceInventory& other) const {
+    if (entries_.size() != other.entries_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < entries_.size(); i++) {
+        const auto& a = entries_[i];
+        const auto& b = other.entries_[i];
+        if (!a.sameDevice(b) || a.index != b.index || a.available != b.available) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DeviceInventory::rebuildIndex() {
+    byName_.clear();
+    for (size_t i = 0; i < entries_.size(); i++) {
+        byName_.emplace(entries_[i].name, i);   // First device wins on duplicate names
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Last known audio device inventory, cached on disk between runs
+ *
+ * Probing every input with Pa_IsFormatSupported dominates device
+ * enumeration; a device whose name, host API, channel counts and sample
+ * rate match the cached entry reuses the cached availability instead. The
+ * cache also lets a device be found by name in O(1), with its PortAudio
+ * index validated by a single lookup instead of a scan.
+ */
+class DeviceInventory {
+public:
+    struct Entry {
+        int index = -1;
+        std::string name;
+        std::string hostApi;
+        int maxInputChannels = 0;
+        int maxOutputChannels = 0;
+        double defaultSampleRate = 0.0;
+        bool available = false;
+
+        // Same physical device with the same capabilities (index and availability aside)
+        bool sameDevice(const Entry& other) const {
+            return name == other.name && hostApi == other.hostApi && maxInputChannels == other.maxInputChannels &&
+                   maxOutputChannels == other.maxOutputChannels && defaultSampleRate == other.defaultSampleRate;
+        }
+    };
+
+    // CVOSC_DEVICE_CACHE overrides; "off" disables caching (empty path)
+    static std::string getDefaultPath();
+
+    bool load(const std::string& path);
+    // Process-wide copy of the file at path, parsed again only after the file
+    // changes (save() replaces it by rename); null if it cannot be loaded
+    static std::shared_ptr<const DeviceInventory> loadShared(const std::string& path);
+    bool save(const std::string& path) const;
+
+    void setEntries(std::vector<Entry> entries);
+    const std::vector<Entry>& getEntries() const { return entries_; }
+    bool empty() const { return entries_.empty(); }
+
+    // Exact name match; nullptr if unknown
+    const Entry* findByName(const std::string& name) const;
+    // The cached entry for the same device, if its capabilities are unchanged
+    const Entry* findSame(const Entry& probe) const;
+
+    bool operator==(const DeviceInventory& other) const;
+    bool operator!=(const DeviceInventory& other) const { return !(*this == other); }
+
+private:
+    void rebuildIndex();
+
+    std::vector<Entry> entries_;
+    std::unordered_map<std::string, size_t> byName_;
+};
@@ -3,54 +3,248 @@
 #include <iomanip>
 #include <sstream>
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 #include <thread>
 
-// Static member initialization
-std::unique_ptr<ErrorHandler> ErrorHandler::instance = nullptr;
-std::mutex ErrorHandler::instanceMutex;
+namespace {
+
+constexpr auto LOG_THREAD_INTERVAL = std::chrono::milliseconds(20);
+
+void copyTruncated(char* destination, size_t capacity, std::string_view source) {
+    size_t length = std::min(source.size(), capacity - 1);
+    std::memcpy(destination, source.data(), length);
+    destination[length] = '\0';
+}
+
+// Identity of a report for the rate limiter: details usually carry values and are left out
+uint64_t reportKey(ErrorSeverity severity, ErrorCategory category, std::string_view message, int line) {
+    uint64_t hash = 1469598103934665603ull;
+    for (char c : message) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    hash ^= (static_cast<uint64_t>(severity) << 56) ^ (static_cast<uint64_t>(category) << 48) ^
+            static_cast<uint64_t>(static_cast<uint32_t>(line));
+    return hash * 1099511628211ull;
+}
+
+} // namespace
+
+// Holds the calling thread's ring; hands it back for reuse when the thread exits.
+// The ring is shared, so a thread that exits after the handler still releases live memory.
+struct LogRingHandle {
+    std::shared_ptr<ErrorHandler::LogRing> ring;
+    
+    ~LogRingHandle() {
+        if (ring) {
+            ring->owned.store(false, std::memory_order_release);
+        }
+    }
+};
 
 ErrorHandler::ErrorHandler() 
     : logLevel(ErrorSeverity::INFO), maxHistorySize(1000), errorCounter(0),
       consoleOutput(true), fileOutput(false), logFileName("cv_osc_converter.log"),
+      logFileBytes(0), maxLogFileBytes(10 * 1024 * 1024), maxLogFiles(3),
       audioRecoveryAttempts(0), networkRecoveryAttempts(0), recoveryInProgress(false),
       lastRecoveryAttempt(std::chrono::system_clock::now()) {
+    for (auto& ring : rings) {
+        ring.store(nullptr, std::memory_order_relaxed);
+    }
+    logThreadRunning = true;
+    logThread = std::thread(&ErrorHandler::logThreadLoop, this);
 }
 
 ErrorHandler::~ErrorHandler() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        logThreadRunning = false;
+    }
+    wakeCondition.notify_all();
+    if (logThread.joinable()) {
+        logThread.join();
+    }
     closeLogFile();
+    // Rings still held by a thread's handle are freed when that thread exits
+    for (size_t i = 0; i < MAX_RINGS; i++) {
+        rings[i].store(nullptr, std::memory_order_release);
+        ringOwners[i].reset();
+    }
 }
 
 ErrorHandler& ErrorHandler::getInstance() {
-    std::lock_guard<std::mutex> lock(instanceMutex);
-    if (!instance) {
-        instance = std::unique_ptr<ErrorHandler>(new ErrorHandler());
-    }
-    return *instance;
+    static ErrorHandler instance;
+    return instance;
 }
 
 void ErrorHandler::reportError(ErrorSeverity severity, ErrorCategory category, 
-                              const std::string& message, const std::string& details,
-                              const std::string& function, const std::string& file, 
-                              int line, bool recoverable, const std::string& suggestedAction) {
+                              std::string_view message, std::string_view details,
+                              std::string_view function, std::string_view file, 
+                              int line, bool recoverable, std::string_view suggestedAction) {
     
     // Check if we should log this severity level
     if (severity < logLevel) {
         return;
     }
     
-    ErrorInfo error;
-    error.severity = severity;
-    error.category = category;
-    error.message = message;
-    error.details = details;
-    error.function = function;
-    error.file = file;
-    error.line = line;
-    error.timestamp = std::chrono::system_clock::now();
-    error.errorCode = errorCounter.fetch_add(1);
-    error.recoverable = recoverable;
-    error.suggestedAction = suggestedAction;
+    size_t errorCode = errorCounter.fetch_add(1, std::memory_order_relaxed);
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    uint32_t suppressed = 0;
+    if (!admitReport(reportKey(severity, category, message, line), nowNs, suppressed)) {
+        return;
+    }
+    
+    thread_local LogRingHandle handle;
+    if (!handle.ring) {
+        handle.ring = acquireRing();
+    }
+    LogRing* ring = handle.ring.get();
+    if (!ring) {
+        droppedCounter.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= LogRing::CAPACITY) {
+        droppedCounter.fetch_add(1 + suppressed, std::memory_order_relaxed);
+        return;
+    }
+    
+    LogRecord& record = ring->records[head % LogRing::CAPACITY];
+    record.timestampNs = nowNs;
+    record.errorCode = errorCode;
+    record.line = line;
+    record.suppressed = suppressed;
+    record.severity = severity;
+    record.category = category;
+    record.recoverable = recoverable;
+    size_t slash = file.find_last_of('/');
+    copyTruncated(record.function, sizeof(record.function), function);
+    copyTruncated(record.file, sizeof(record.file), slash == std::string_view::npos ? file : file.substr(slash + 1));
+    copyTruncated(record.message, sizeof(record.message), message);
+    copyTruncated(record.details, sizeof(record.details), details);
+    copyTruncated(record.suggestedAction, sizeof(record.suggestedAction), suggestedAction);
+    
+    ring->head.store(head + 1, std::memory_order_release);
+    queuedCounter.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<ErrorHandler::LogRing> ErrorHandler::acquireRing() {
+    // Reuse a ring left behind by a finished thread. Its owner entry was written
+    // before that thread released the ring, so it is safe to read once owned.
+    for (size_t i = 0; i < MAX_RINGS; i++) {
+        LogRing* ring = rings[i].load(std::memory_order_acquire);
+        bool expected = false;
+        if (ring && ring->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return ringOwners[i];
+        }
+    }
+    
+    // First report from this thread: the only allocation on the reporting side
+    auto ring = std::make_shared<LogRing>();
+    ring->owned.store(true, std::memory_order_relaxed);
+    for (size_t i = 0; i < MAX_RINGS; i++) {
+        LogRing* expected = nullptr;
+        if (rings[i].compare_exchange_strong(expected, ring.get(), std::memory_order_acq_rel)) {
+            ringOwners[i] = ring;
+            return ring;
+        }
+    }
+    return nullptr;
+}
+
+bool ErrorHandler::admitReport(uint64_t key, int64_t nowNs, uint32_t& suppressed) {
+    int64_t interval = rateLimitNs.load(std::memory_order_relaxed);
+    if (interval <= 0) {
+        return true;
+    }
+    
+    RateSlot& slot = rateSlots[key % RATE_SLOTS];
+    if (slot.key.load(std::memory_order_acquire) == key) {
+        int64_t windowStart = slot.windowStartNs.load(std::memory_order_relaxed);
+        if (nowNs - windowStart < interval ||
+            !slot.windowStartNs.compare_exchange_strong(windowStart, nowNs, std::memory_order_relaxed)) {
+            slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+            suppressedCounter.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    
+    // New report, possibly evicting another one that hashed to this slot
+    slot.windowStartNs.store(nowNs, std::memory_order_relaxed);
+    slot.suppressed.store(0, std::memory_order_relaxed);
+    slot.key.store(key, std::memory_order_release);
+    return true;
+}
+
+void ErrorHandler::logThreadLoop() {
+    while (logThreadRunning) {
+        drainRings();
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait_for(lock, LOG_THREAD_INTERVAL, [this]() { return !logThreadRunning; });
+    }
+    drainRings();
+}
+
+void ErrorHandler::flush() {
+    drainRings();
+}
+
+void ErrorHandler::drainRings() {
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+    
+    std::vector<ErrorInfo> errors;
+    for (auto& slot : rings) {
+        LogRing* ring = slot.load(std::memory_order_acquire);
+        if (!ring) {
+            continue;
+        }
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (; tail < head; tail++) {
+            const LogRecord& record = ring->records[tail % LogRing::CAPACITY];
+            ErrorInfo error;
+            error.severity = record.severity;
+            error.category = record.category;
+            error.message = record.message;
+            error.details = record.details;
+            error.function = record.function;
+            error.file = record.file;
+            error.line = record.line;
+            error.timestamp = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(record.timestampNs)));
+            error.errorCode = record.errorCode;
+            error.recoverable = record.recoverable;
+            error.suggestedAction = record.suggestedAction;
+            error.suppressedRepeats = record.suppressed;
+            errors.push_back(std::move(error));
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+    if (errors.empty()) {
+        return;
+    }
+    
+    // Rings are per thread; interleave them back into reporting order
+    std::stable_sort(errors.begin(), errors.end(), [](const ErrorInfo& a, const ErrorInfo& b) {
+        return a.timestamp < b.timestamp;
+    });
+    for (const auto& error : errors) {
+        processError(error);
+    }
     
+    std::lock_guard<std::mutex> lock(errorMutex);
+    if (logFile.is_open()) {
+        logFile.flush();
+    }
+}
+
+void ErrorHandler::processError(const ErrorInfo& error) {
     std::lock_guard<std::mutex> lock(errorMutex);
     
     // Add to history
@@ -71,7 +265,8 @@ void ErrorHandler::reportError(ErrorSeverity severity, ErrorCategory category,
     notifyCallbacks(error);
     
     // Attempt recovery if appropriate
-    if (recoverable && shouldAttemptRecovery(category)) {
+    ErrorCategory category = error.category;
+    if (error.recoverable && shouldAttemptRecovery(category)) {
         std::thread recoveryThread([this, category]() {
             switch (category) {
                 case ErrorCategory::AUDIO:
@@ -91,6 +286,39 @@ void ErrorHandler::reportError(ErrorSeverity severity, ErrorCategory category,
     }
 }
 
+void ErrorHandler::setLogRotation(size_t maxBytes, int maxFiles) {
+    std::lock_guard<std::mutex> lock(errorMutex);
+    maxLogFileBytes = maxBytes;
+    maxLogFiles = maxFiles;
+}
+
+void ErrorHandler::setRateLimit(std::chrono::milliseconds interval) {
+    rateLimitNs = std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count();
+}
+
+ErrorHandler::LoggingStats ErrorHandler::getLoggingStats() const {
+    LoggingStats stats;
+    stats.queued = queuedCounter.load(std::memory_order_relaxed);
+    stats.suppressed = suppressedCounter.load(std::memory_order_relaxed);
+    stats.dropped = droppedCounter.load(std::memory_order_relaxed);
+    stats.rotations = rotationCounter.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ErrorHandler::rotateLogFile() {
+    logFile.close();
+    for (int i = maxLogFiles - 1; i >= 1; --i) {
+        std::rename((logFileName + "." + std::to_string(i)).c_str(),
+                    (logFileName + "." + std::to_string(i + 1)).c_str());
+    }
+    if (maxLogFiles > 0) {
+        std::rename(logFileName.c_str(), (logFileName + ".1").c_str());
+    }
+    logFile.open(logFileName, std::ios::trunc);
+    logFileBytes = 0;
+    rotationCounter.fetch_add(1, std::memory_order_relaxed);
+}
+
 void ErrorHandler::logDebug(const std::string& message, const std::string& details) {
     reportError(ErrorSeverity::DEBUG, ErrorCategory::SYSTEM, message, details);
 }
@@ -154,6 +382,8 @@ void ErrorHandler::setFileOutput(bool enabled, const std::string& filename) {
     }
     
     if (fileOutput) {
+        std::ifstream existing(logFileName, std::ios::binary | std::ios::ate);
+        logFileBytes = existing.is_open() ? static_cast<size_t>(existing.tellg()) : 0;
         logFile.open(logFileName, std::ios::app);
         if (!logFile.is_open()) {
             consoleOutput = true; // Fallback to console if file fails
@@ -476,27 +706,39 @@ void ErrorHandler::closeLogFile() {
 }
 
 void ErrorHandler::writeToLog(const ErrorInfo& error) {
-    if (logFile.is_open()) {
-        logFile << "[" << formatTimestamp(error.timestamp) << "] "
-                << severityToString(error.severity) << " "
-                << categoryToString(error.category) << " "
-                << error.message;
-        
-        if (!error.details.empty()) {
-            logFile << " | " << error.details;
-        }
-        
-        if (!error.function.empty() && !error.file.empty()) {
-            logFile << " | " << error.function << "() at " << error.file << ":" << error.line;
-        }
-        
-        if (!error.suggestedAction.empty()) {
-            logFile << " | Suggested: " << error.suggestedAction;
-        }
-        
-        logFile << std::endl;
-        logFile.flush();
+    if (!logFile.is_open()) {
+        return;
+    }
+    
+    std::ostringstream line;
+    line << "[" << formatTimestamp(error.timestamp) << "] "
+         << severityToString(error.severity) << " "
+         << categoryToString(error.category) << " "
+         << error.message;
+    
+    if (!error.details.empty()) {
+        line << " | " << error.details;
     }
+    
+    if (!error.function.empty() && !error.file.empty()) {
+        line << " | " << error.function << "() at " << error.file << ":" << error.line;
+    }
+    
+    if (!error.suggestedAction.empty()) {
+        line << " | Suggested: " << error.suggestedAction;
+    }
+    
+    if (error.suppressedRepeats > 0) {
+        line << " | " << error.suppressedRepeats << " identical reports suppressed";
+    }
+    
+    line << "\n";
+    std::string text = line.str();
+    if (maxLogFileBytes > 0 && logFileBytes + text.size() > maxLogFileBytes && logFileBytes > 0) {
+        rotateLogFile();
+    }
+    logFile << text;
+    logFileBytes += text.size();
 }
 
 void ErrorHandler::writeToConsole(const ErrorInfo& error) {
@@ -515,6 +757,10 @@ void ErrorHandler::writeToConsole(const ErrorInfo& error) {
         std::cerr << "\n  " << color << "Suggested Action: " << reset << error.suggestedAction;
     }
     
+    if (error.suppressedRepeats > 0) {
+        std::cerr << "\n  (" << error.suppressedRepeats << " identical reports suppressed)";
+    }
+    
     std::cerr << std::endl;
 }
 
@@ -8,6 +8,11 @@
 #include <fstream>
 #include <mutex>
 #include <atomic>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <string_view>
+#include <thread>
 
 enum class ErrorSeverity {
     DEBUG = 0,
@@ -39,16 +44,85 @@ struct ErrorInfo {
     size_t errorCode;
     bool recoverable;
     std::string suggestedAction;
+    uint32_t suppressedRepeats;     // Identical reports collapsed into this one by the rate limiter
     
     ErrorInfo() : severity(ErrorSeverity::INFO), category(ErrorCategory::SYSTEM), 
                  line(0), timestamp(std::chrono::system_clock::now()), 
-                 errorCode(0), recoverable(true) {}
+                 errorCode(0), recoverable(true), suppressedRepeats(0) {}
 };
 
+/**
+ * @brief Central error reporting with an asynchronous, lock-free back end
+ *
+ * reportError() never blocks: it copies the report into a fixed-size binary
+ * record in a ring owned by the calling thread and returns. A background
+ * thread drains every ring, then formats, rotates and flushes the log file,
+ * keeps the history and runs callbacks and recovery. Identical reports (same
+ * severity, category, message and line) are rate limited at the producer,
+ * and the number collapsed is attached to the next one that gets through.
+ * When a ring is full the record is dropped and counted, never waited for.
+ */
 class ErrorHandler {
+public:
+    struct LoggingStats {
+        uint64_t queued = 0;        // Records handed to the background thread
+        uint64_t suppressed = 0;    // Collapsed by the rate limiter
+        uint64_t dropped = 0;       // Lost to a full ring or too many threads
+        uint64_t rotations = 0;
+    };
+    
 private:
-    static std::unique_ptr<ErrorHandler> instance;
-    static std::mutex instanceMutex;
+    // Fixed-size record; strings are truncated to fit
+    struct LogRecord {
+        int64_t timestampNs;
+        uint64_t errorCode;
+        int32_t line;
+        uint32_t suppressed;
+        ErrorSeverity severity;
+        ErrorCategory category;
+        bool recoverable;
+        char function[48];
+        char file[64];
+        char message[128];
+        char details[192];
+        char suggestedAction[96];
+    };
+    
+    // Single producer (the owning thread), single consumer (the log thread)
+    struct LogRing {
+        static constexpr size_t CAPACITY = 128;
+        std::array<LogRecord, CAPACITY> records;
+        alignas(64) std::atomic<uint64_t> head{0};
+        alignas(64) std::atomic<uint64_t> tail{0};
+        std::atomic<bool> owned{false};
+    };
+    
+    // Last emitted occurrence of a report, for the rate limiter
+    struct RateSlot {
+        std::atomic<uint64_t> key{0};
+        std::atomic<int64_t> windowStartNs{0};
+        std::atomic<uint32_t> suppressed{0};
+    };
+    
+    static constexpr size_t MAX_RINGS = 64;
+    static constexpr size_t RATE_SLOTS = 256;
+    
+    std::array<std::atomic<LogRing*>, MAX_RINGS> rings;
+    // Shared with the owning thread's handle, which can outlive the handler at exit
+    std::array<std::shared_ptr<LogRing>, MAX_RINGS> ringOwners;
+    std::array<RateSlot, RATE_SLOTS> rateSlots;
+    std::atomic<int64_t> rateLimitNs{1000000000};
+    std::atomic<uint64_t> queuedCounter{0};
+    std::atomic<uint64_t> suppressedCounter{0};
+    std::atomic<uint64_t> droppedCounter{0};
+    std::atomic<uint64_t> rotationCounter{0};
+    
+    // Background formatting thread
+    std::thread logThread;
+    std::atomic<bool> logThreadRunning{false};
+    std::mutex drainMutex;                  // One consumer at a time (log thread or flush())
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
     
     std::vector<ErrorInfo> errorHistory;
     std::vector<std::function<void(const ErrorInfo&)>> errorCallbacks;
@@ -60,6 +134,9 @@ private:
     bool consoleOutput;
     bool fileOutput;
     std::string logFileName;
+    size_t logFileBytes;
+    size_t maxLogFileBytes;
+    int maxLogFiles;
     
     // Recovery mechanisms
     std::atomic<int> audioRecoveryAttempts;
@@ -70,12 +147,12 @@ private:
 public:
     static ErrorHandler& getInstance();
     
-    // Core error reporting
+    // Core error reporting. Any thread; never blocks or allocates once the thread has a ring.
     void reportError(ErrorSeverity severity, ErrorCategory category, 
-                    const std::string& message, const std::string& details = "",
-                    const std::string& function = "", const std::string& file = "", 
+                    std::string_view message, std::string_view details = "",
+                    std::string_view function = "", std::string_view file = "", 
                     int line = 0, bool recoverable = true, 
-                    const std::string& suggestedAction = "");
+                    std::string_view suggestedAction = "");
     
     // Convenience methods for different severities
     void logDebug(const std::string& message, const std::string& details = "");
@@ -102,7 +179,14 @@ public:
     void setConsoleOutput(bool enabled) { consoleOutput = enabled; }
     void setFileOutput(bool enabled, const std::string& filename = "");
     void setMaxHistorySize(size_t size) { maxHistorySize = size; }
+    // The file is renamed to <name>.1 ... <name>.<maxFiles> once it exceeds maxBytes
+    void setLogRotation(size_t maxBytes, int maxFiles);
+    // Identical reports within the interval are collapsed; zero disables it
+    void setRateLimit(std::chrono::milliseconds interval);
     
+    // Asynchronous pipeline
+    void flush();   // Formats everything reported so far before returning
+    LoggingStats getLoggingStats() const;    
     // Error history and analysis
     std::vector<ErrorInfo> getErrorHistory() const;
     std::vector<ErrorInfo> getErrorsByCategory(ErrorCategory category) const;
@@ -149,6 +233,16 @@ public:
     void notifyCallbacks(const ErrorInfo& error);
     bool shouldAttemptRecovery(ErrorCategory category) const;
     std::string getColorForSeverity(ErrorSeverity severity) const;
+    
+private:
+    std::shared_ptr<LogRing> acquireRing();
+    bool admitReport(uint64_t key, int64_t nowNs, uint32_t& suppressed);
+    void logThreadLoop();
+    void drainRings();
+    void processError(const ErrorInfo& error);
+    void rotateLogFile();
+    
+    friend struct LogRingHandle;
 };
 
 // Convenience macros for error reporting with automatic file/line/function info
@@ -0,0 +1,107 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+size_t LatencyHistogram::shardIndex() {
+    // Each thread sticks to one shard; threads only share a shard beyond SHARD_COUNT
+    static std::atomic<size_t> nextShard{0};
+    thread_local size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return shard;
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t nanoseconds) {
+    if (nanoseconds < 2 * SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(nanoseconds);
+    }
+    int exponent = 63;
+    while ((nanoseconds >> exponent) == 0) {
+        exponent--;
+    }
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    int shift = exponent - SUB_BUCKET_BITS;
+    uint64_t mantissa = nanoseconds >> shift;  // [SUB_BUCKET_COUNT, 2 * SUB_BUCKET_COUNT)
+    return 2 * SUB_BUCKET_COUNT + (exponent - SUB_BUCKET_BITS - 1) * SUB_BUCKET_COUNT +
+           (mantissa - SUB_BUCKET_COUNT);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return index;
+    }
+    size_t offset = index - 2 * SUB_BUCKET_COUNT;
+    int shift = static_cast<int>(offset / SUB_BUCKET_COUNT) + 1;
+    uint64_t mantissa = SUB_BUCKET_COUNT + offset % SUB_BUCKET_COUNT;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    Shard& shard = shards_[shardIndex()];
+    shard.counts[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    uint64_t current = shard.max.load(std::memory_order_relaxed);
+    while (nanoseconds > current &&
+           !shard.max.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+    current = shard.min.load(std::memory_order_relaxed);
+    while (nanoseconds < current &&
+           !shard.min.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot result;
+    result.counts.assign(BUCKET_COUNT, 0);
+    uint64_t min = UINT64_MAX;
+
+    for (const auto& shard : shards_) {
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            result.counts[i] += shard.counts[i].load(std::memory_order_relaxed);
+        }
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+        min = std::min(min, shard.min.load(std::memory_order_relaxed));
+        result.max = std::max(result.max, shard.max.load(std::memory_order_relaxed));
+    }
+
+    // Count from the buckets so percentiles stay consistent with a racing record()
+    for (uint64_t bucket : result.counts) {
+        result.count += bucket;
+    }
+    result.min = result.count > 0 ? min : 0;
+    return result;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& shard : shards_) {
+        for (auto& bucket : shard.counts) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        shard.sum.store(0, std::memory_order_relaxed);
+        shard.min.store(UINT64_MAX, std::memory_order_relaxed);
+        shard.max.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencyHistogram::Snapshot::percentile(double percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * count));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= rank) {
+            // The top bucket's bound can exceed anything actually recorded
+            return std::min(bucketUpperBound(i), max);
+        }
+    }
+    return max;
+}
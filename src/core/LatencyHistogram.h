@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Lock-free log-linear latency histogram
+ *
+ * Values are bucketed HDR-style: exact below 64 ns, then 32 linear
+ * sub-buckets per power of two, which bounds the relative error of any
+ * reported percentile to about 3% up to ~18 minutes. Recording is a couple
+ * of relaxed atomic increments into a per-thread shard, so it is safe on
+ * the audio and network threads. Shards are merged only when read.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 40;        // 2^40 ns, ~18 minutes
+    static constexpr size_t BUCKET_COUNT = 2 * SUB_BUCKET_COUNT +
+                                           (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+    static constexpr size_t SHARD_COUNT = 8;
+
+    // Merged view, safe to keep and query after the histogram changes
+    struct Snapshot {
+        std::vector<uint64_t> counts;
+        uint64_t count = 0;
+        uint64_t sum = 0;    // ns
+        uint64_t min = 0;    // ns
+        uint64_t max = 0;    // ns
+
+        uint64_t percentile(double percent) const;  // ns, upper edge of the bucket
+        double mean() const { return count > 0 ? static_cast<double>(sum) / count : 0.0; }
+    };
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Any thread, real-time safe
+    void record(uint64_t nanoseconds);
+    void record(std::chrono::nanoseconds duration) {
+        record(duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0);
+    }
+
+    // Reader side: sums every shard; concurrent records land in this or the next snapshot
+    Snapshot snapshot() const;
+    void reset();
+
+    static size_t bucketIndex(uint64_t nanoseconds);
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts;
+        std::atomic<uint64_t> sum{0};
+        std::atomic<uint64_t> min{UINT64_MAX};
+        std::atomic<uint64_t> max{0};
+    };
+
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    static size_t shardIndex();
+};
@@ -0,0 +1,179 @@
+#include "LatencyTracer.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+LatencyTracer& LatencyTracer::getInstance() {
+    static LatencyTracer instance;
+    return instance;
+}
+
+LatencyTracer::LatencyTracer() : ring_(new Slot[RING_SIZE]), epoch_(Clock::now()) {
+    for (auto& name : threadNames_) {
+        name.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+bool LatencyTracer::configureFromEnvironment() {
+    const char* file = std::getenv("CVOSC_TRACE");
+    if (!file || !*file) {
+        return false;
+    }
+    outputFile_ = file;
+
+    if (const char* interval = std::getenv("CVOSC_TRACE_INTERVAL")) {
+        long blocks = std::strtol(interval, nullptr, 10);
+        if (blocks > 0) {
+            setSampleInterval(static_cast<uint32_t>(blocks));
+        }
+    }
+    setEnabled(true);
+    std::cout << "Latency tracing enabled: 1 of " << getSampleInterval() << " blocks -> "
+              << outputFile_ << std::endl;
+    return true;
+}
+
+uint64_t LatencyTracer::beginTrace() {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    uint64_t block = blockCounter_.fetch_add(1, std::memory_order_relaxed);
+    if (block % sampleInterval_.load(std::memory_order_relaxed) != 0) {
+        return 0;
+    }
+    return nextTraceId_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t LatencyTracer::currentThreadId() {
+    thread_local uint32_t threadId = nextThreadId_.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+
+void LatencyTracer::setThreadName(const char* name) {
+    uint32_t threadId = currentThreadId();
+    if (threadId < MAX_THREADS) {
+        threadNames_[threadId].store(name, std::memory_order_release);
+    }
+}
+
+void LatencyTracer::recordSpan(uint64_t traceId, const char* name, Clock::time_point start,
+                               Clock::time_point end, int channel) {
+    if (traceId == 0) {
+        return;
+    }
+    uint64_t index = writeIndex_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = ring_[index % RING_SIZE];
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.traceId.store(traceId, std::memory_order_relaxed);
+    slot.name.store(reinterpret_cast<uintptr_t>(name), std::memory_order_relaxed);
+    slot.startNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count(),
+                       std::memory_order_relaxed);
+    slot.durationNs.store(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+                          std::memory_order_relaxed);
+    slot.location.store((static_cast<uint64_t>(currentThreadId()) << 32) | static_cast<uint32_t>(channel),
+                        std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+LatencyTracer::Clock::time_point LatencyTracer::fromStreamTime(double adcTime, double currentTime,
+                                                               Clock::time_point callbackTime) {
+    // Hosts that do not report stream times leave them at 0
+    if (adcTime <= 0.0 || currentTime <= 0.0 || adcTime > currentTime) {
+        return callbackTime;
+    }
+    double age = std::min(currentTime - adcTime, 1.0);
+    return callbackTime - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(age));
+}
+
+std::vector<LatencyTracer::Span> LatencyTracer::collectSpans() const {
+    std::vector<Span> spans;
+    uint64_t end = writeIndex_.load(std::memory_order_acquire);
+    uint64_t begin = std::max(clearedIndex_.load(), end > RING_SIZE ? end - RING_SIZE : 0);
+    spans.reserve(static_cast<size_t>(end - begin));
+
+    for (uint64_t index = begin; index < end; index++) {
+        const Slot& slot = ring_[index % RING_SIZE];
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+            continue; // Still being written, or already overwritten
+        }
+        Span span;
+        span.traceId = slot.traceId.load(std::memory_order_relaxed);
+        span.name = reinterpret_cast<const char*>(slot.name.load(std::memory_order_relaxed));
+        span.startNs = slot.startNs.load(std::memory_order_relaxed);
+        span.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        uint64_t location = slot.location.load(std::memory_order_relaxed);
+        span.threadId = static_cast<uint32_t>(location >> 32);
+        span.channel = static_cast<int32_t>(static_cast<uint32_t>(location));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == index + 1) {
+            spans.push_back(span);
+        }
+    }
+    return spans;
+}
+
+nlohmann::json LatencyTracer::exportChromeTrace() const {
+    auto spans = collectSpans();
+    std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) {
+        return a.traceId != b.traceId ? a.traceId < b.traceId : a.startNs < b.startNs;
+    });
+
+    nlohmann::json events = nlohmann::json::array();
+    std::map<uint32_t, bool> threads;
+
+    for (size_t i = 0; i < spans.size(); i++) {
+        const Span& span = spans[i];
+        threads[span.threadId] = true;
+        double ts = span.startNs / 1000.0;
+        nlohmann::json args = {{"trace_id", span.traceId}};
+        if (span.channel >= 0) {
+            args["channel"] = span.channel;
+        }
+        events.push_back({{"name", span.name ? span.name : "span"}, {"cat", "cvosc"}, {"ph", "X"},
+                          {"ts", ts}, {"dur", span.durationNs / 1000.0}, {"pid", 1},
+                          {"tid", span.threadId}, {"args", args}});
+
+        // Flow arrows join consecutive spans of one trace, across threads
+        bool first = i == 0 || spans[i - 1].traceId != span.traceId;
+        bool last = i + 1 == spans.size() || spans[i + 1].traceId != span.traceId;
+        if (first && last) {
+            continue;
+        }
+        nlohmann::json flow = {{"name", "trace"}, {"cat", "cvosc"}, {"id", span.traceId}, {"pid", 1},
+                               {"tid", span.threadId}, {"ts", ts}};
+        flow["ph"] = first ? "s" : (last ? "f" : "t");
+        if (!first) {
+            flow["bp"] = "e";
+        }
+        events.push_back(flow);
+    }
+
+    for (const auto& entry : threads) {
+        const char* name = entry.first < MAX_THREADS ? threadNames_[entry.first].load(std::memory_order_acquire)
+                                                     : nullptr;
+        events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", entry.first},
+                          {"args", {{"name", name ? name : "thread " + std::to_string(entry.first)}}}});
+    }
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", 1}, {"args", {{"name", "cvosc"}}}});
+
+    return {{"traceEvents", events}, {"displayTimeUnit", "ns"}};
+}
+
+bool LatencyTracer::writeChromeTrace(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write latency trace: " << filename << std::endl;
+        return false;
+    }
+    file << exportChromeTrace().dump();
+    std::cout << "Latency trace written to " << filename << std::endl;
+    return true;
+}
+
+void LatencyTracer::clear() {
+    clearedIndex_.store(writeIndex_.load());
+}
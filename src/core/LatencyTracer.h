@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Sampled end-to-end latency tracing from ADC to sendto()
+ *
+ * One audio block in every N is given a trace id when it is captured; the
+ * id travels with the value derived from that block (CVReader /
+ * RealAudioStream -> mixer routing -> OSCMessage -> OSC send) and every
+ * stage records a span against it. Unsampled blocks carry id 0 and cost a
+ * single branch per stage.
+ *
+ * Spans go into a fixed-size lock-free ring, so recording is safe on the
+ * audio thread. The ring is exported as Chrome trace / Perfetto JSON with
+ * flow arrows joining the spans of each trace across threads.
+ */
+class LatencyTracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Span {
+        uint64_t traceId = 0;
+        const char* name = nullptr;
+        int64_t startNs = 0;        // Relative to the tracer epoch
+        int64_t durationNs = 0;
+        uint32_t threadId = 0;
+        int32_t channel = -1;
+    };
+
+    static LatencyTracer& getInstance();
+
+    // Control thread
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+    void setSampleInterval(uint32_t blocks) { sampleInterval_.store(blocks > 0 ? blocks : 1); }
+    uint32_t getSampleInterval() const { return sampleInterval_.load(); }
+    // CVOSC_TRACE=<file> enables tracing; CVOSC_TRACE_INTERVAL=<blocks> sets the sampling
+    bool configureFromEnvironment();
+    const std::string& getOutputFile() const { return outputFile_; }
+
+    // Any thread, real-time safe. beginTrace() returns 0 for unsampled blocks.
+    uint64_t beginTrace();
+    // name must be a string literal (stored by pointer)
+    void recordSpan(uint64_t traceId, const char* name, Clock::time_point start, Clock::time_point end,
+                    int channel = -1);
+    // Label the calling thread in the exported trace (literal, stored by pointer)
+    void setThreadName(const char* name);
+
+    // PortAudio stream times (seconds) -> steady clock, anchored at the callback entry time
+    static Clock::time_point fromStreamTime(double adcTime, double currentTime, Clock::time_point callbackTime);
+
+    // Reader side, off the real-time path
+    std::vector<Span> collectSpans() const;
+    nlohmann::json exportChromeTrace() const;
+    bool writeChromeTrace(const std::string& filename) const;
+    void clear();
+
+private:
+    static constexpr size_t RING_SIZE = 1 << 16;
+    static constexpr size_t MAX_THREADS = 64;
+
+    // Seqlock slot: sequence is 0 while a writer is inside, index + 1 once complete
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> traceId{0};
+        std::atomic<uintptr_t> name{0};
+        std::atomic<int64_t> startNs{0};
+        std::atomic<int64_t> durationNs{0};
+        std::atomic<uint64_t> location{0};      // threadId << 32 | channel
+    };
+
+    LatencyTracer();
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint32_t> sampleInterval_{64};
+    std::atomic<uint64_t> blockCounter_{0};
+    std::atomic<uint64_t> nextTraceId_{1};
+    std::atomic<uint64_t> writeIndex_{0};
+    std::atomic<uint64_t> clearedIndex_{0};
+    std::atomic<uint32_t> nextThreadId_{1};
+    std::array<std::atomic<const char*>, MAX_THREADS> threadNames_{};
+    std::unique_ptr<Slot[]> ring_;
+    const Clock::time_point epoch_;
+    std::string outputFile_;
+
+    uint32_t currentThreadId();
+};
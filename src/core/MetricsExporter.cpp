@@ -0,0 +1,333 @@
+#include "MetricsExporter.h"
+#include "PerformanceMonitor.h"
+#include "ResourceSampler.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <pthread/qos.h>
+#else
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+constexpr int POLL_TIMEOUT_MS = 200;
+constexpr size_t MAX_REQUEST_BYTES = 8192;
+constexpr const char* CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+std::string httpResponse(const char* status, const char* contentType, const std::string& body) {
+    std::string response = "HTTP/1.1 ";
+    response += status;
+    response += "\r\nContent-Type: ";
+    response += contentType;
+    response += "\r\nContent-Length: " + std::to_string(body.size());
+    response += "\r\nConnection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+} // namespace
+
+// MetricsWriter
+
+const std::vector<double>& MetricsWriter::histogramBounds() {
+    static const std::vector<double> bounds = {
+        0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005,
+        0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0};
+    return bounds;
+}
+
+void MetricsWriter::family(const std::string& name, const char* type, const char* help) {
+    text_ += "# TYPE " + name + " " + type + "\n";
+    text_ += "# HELP " + name + " " + help + "\n";
+}
+
+void MetricsWriter::counter(const std::string& name, const Labels& labels, uint64_t value) {
+    sample(name + "_total", labels, std::to_string(value));
+}
+
+void MetricsWriter::gauge(const std::string& name, const Labels& labels, double value) {
+    sample(name, labels, formatDouble(value));
+}
+
+void MetricsWriter::histogram(const std::string& name, const Labels& labels,
+                              const LatencyHistogram::Snapshot& snapshot) {
+    // A bucket only counts towards a bound when its whole range lies below it
+    size_t index = 0;
+    uint64_t cumulative = 0;
+    for (double bound : histogramBounds()) {
+        uint64_t boundNs = static_cast<uint64_t>(bound * 1e9);
+        while (index < snapshot.counts.size() && LatencyHistogram::bucketUpperBound(index) <= boundNs) {
+            cumulative += snapshot.counts[index++];
+        }
+        sample(name + "_bucket", labels, std::to_string(cumulative), "le", formatDouble(bound));
+    }
+    sample(name + "_bucket", labels, std::to_string(snapshot.count), "le", "+Inf");
+    sample(name + "_count", labels, std::to_string(snapshot.count));
+    sample(name + "_sum", labels, formatDouble(snapshot.sum / 1e9));
+}
+
+std::string MetricsWriter::finish() {
+    text_ += "# EOF\n";
+    return std::move(text_);
+}
+
+void MetricsWriter::sample(const std::string& name, const Labels& labels, const std::string& value,
+                           const char* extraLabel, const std::string& extraValue) {
+    text_ += name;
+    if (!labels.empty() || extraLabel) {
+        text_ += '{';
+        bool first = true;
+        for (const auto& label : labels) {
+            if (!first) {
+                text_ += ',';
+            }
+            first = false;
+            text_ += label.first + "=\"";
+            appendEscaped(text_, label.second);
+            text_ += '"';
+        }
+        if (extraLabel) {
+            if (!first) {
+                text_ += ',';
+            }
+            text_ += std::string(extraLabel) + "=\"" + extraValue + "\"";
+        }
+        text_ += '}';
+    }
+    text_ += ' ';
+    text_ += value;
+    text_ += '\n';
+}
+
+std::string MetricsWriter::formatDouble(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    return buffer;
+}
+
+void MetricsWriter::appendEscaped(std::string& out, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"':  out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default:   out += c; break;
+        }
+    }
+}
+
+// MetricsExporter
+
+MetricsExporter::MetricsExporter() = default;
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::configureFromEnvironment() {
+    const char* value = std::getenv("CVOSC_METRICS_PORT");
+    if (!value || !*value) {
+        return false;
+    }
+    long port = std::strtol(value, nullptr, 10);
+    if (port < 0 || port > 65535) {
+        std::cerr << "Invalid CVOSC_METRICS_PORT: " << value << std::endl;
+        return false;
+    }
+    return start(static_cast<int>(port));
+}
+
+bool MetricsExporter::start(int port, const std::string& bindAddress) {
+    if (running_) {
+        return true;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Metrics exporter: socket() failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, bindAddress.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "Metrics exporter: invalid bind address " << bindAddress << std::endl;
+        close(fd);
+        return false;
+    }
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, 8) < 0) {
+        std::cerr << "Metrics exporter: cannot listen on " << bindAddress << ":" << port << ": "
+                  << std::strerror(errno) << std::endl;
+        close(fd);
+        return false;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+
+    socklen_t length = sizeof(address);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+    listenFd_ = fd;
+
+    running_ = true;
+    serverThread_ = std::make_unique<std::thread>(&MetricsExporter::serverLoop, this);
+
+    std::cout << "Metrics exporter listening on http://" << bindAddress << ":" << port_ << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsExporter::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (serverThread_ && serverThread_->joinable()) {
+        serverThread_->join();
+    }
+    serverThread_.reset();
+    if (listenFd_ >= 0) {
+        close(listenFd_);
+        listenFd_ = -1;
+    }
+}
+
+void MetricsExporter::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(collectorsMutex_);
+    collectors_.push_back(std::move(collector));
+}
+
+void MetricsExporter::addPerformanceMonitor(const PerformanceMonitor& monitor) {
+    addCollector([&monitor](MetricsWriter& out) {
+        auto counters = monitor.getCounters();
+        out.family("cvosc_monitor_cycles", "counter", "Processing cycles recorded by the performance monitor.");
+        out.counter("cvosc_monitor_cycles", {}, counters.cycles);
+        out.family("cvosc_monitor_osc_messages_sent", "counter", "OSC messages reported as sent.");
+        out.counter("cvosc_monitor_osc_messages_sent", {}, counters.oscSent);
+        out.family("cvosc_monitor_osc_messages_failed", "counter", "OSC messages reported as failed.");
+        out.counter("cvosc_monitor_osc_messages_failed", {}, counters.oscFailed);
+        out.family("cvosc_monitor_dropped_samples", "counter", "Audio samples reported as dropped.");
+        out.counter("cvosc_monitor_dropped_samples", {}, counters.droppedSamples);
+        out.family("cvosc_monitor_buffer_underruns", "counter", "Audio buffer underruns reported.");
+        out.counter("cvosc_monitor_buffer_underruns", {}, counters.bufferUnderruns);
+
+        out.family("cvosc_stage_latency_seconds", "histogram", "Pipeline latency per stage.");
+        for (size_t i = 0; i < static_cast<size_t>(PerformanceMonitor::LatencyStage::Count); i++) {
+            auto stage = static_cast<PerformanceMonitor::LatencyStage>(i);
+            out.histogram("cvosc_stage_latency_seconds", {{"stage", PerformanceMonitor::getStageName(stage)}},
+                          monitor.getStageHistogram(stage));
+        }
+    });
+}
+
+std::string MetricsExporter::render() const {
+    MetricsWriter writer;
+    {
+        std::lock_guard<std::mutex> lock(collectorsMutex_);
+        for (const auto& collector : collectors_) {
+            collector(writer);
+        }
+    }
+    writer.family("cvosc_metrics_scrapes", "counter", "Scrapes served by this endpoint.");
+    writer.counter("cvosc_metrics_scrapes", {}, scrapes_.load(std::memory_order_relaxed));
+    return writer.finish();
+}
+
+void MetricsExporter::lowerThreadPriority() {
+#ifdef __APPLE__
+    pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+#else
+    // Per-thread nice value on Linux
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 10);
+#endif
+}
+
+void MetricsExporter::serverLoop() {
+    lowerThreadPriority();
+    ScopedThreadRegistration registration("MetricsExporter");
+
+    while (running_) {
+        pollfd listener{listenFd_, POLLIN, 0};
+        int ready = poll(&listener, 1, POLL_TIMEOUT_MS);
+        if (ready <= 0) {
+            continue;
+        }
+        int clientFd = accept(listenFd_, nullptr, nullptr);
+        if (clientFd < 0) {
+            continue;
+        }
+        handleClient(clientFd);
+        close(clientFd);
+    }
+}
+
+void MetricsExporter::handleClient(int clientFd) {
+#ifdef SO_NOSIGPIPE
+    int noSigpipe = 1;
+    setsockopt(clientFd, SOL_SOCKET, SO_NOSIGPIPE, &noSigpipe, sizeof(noSigpipe));
+#endif
+    // On macOS and the BSDs accept() inherits O_NONBLOCK from the listener,
+    // which would make recv() fail with EAGAIN and bypass the timeouts below
+    fcntl(clientFd, F_SETFL, fcntl(clientFd, F_GETFL, 0) & ~O_NONBLOCK);
+    // A stalled client must not hold up stop() for long
+    timeval timeout{1, 0};
+    setsockopt(clientFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(clientFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        ssize_t received = recv(clientFd, buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    size_t methodEnd = request.find(' ');
+    size_t pathEnd = methodEnd == std::string::npos ? std::string::npos : request.find(' ', methodEnd + 1);
+    if (pathEnd == std::string::npos) {
+        sendAll(clientFd, httpResponse("400 Bad Request", "text/plain", "Bad request\n"));
+        return;
+    }
+    std::string method = request.substr(0, methodEnd);
+    std::string path = request.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+    path = path.substr(0, path.find('?'));
+
+    if (method != "GET") {
+        sendAll(clientFd, httpResponse("405 Method Not Allowed", "text/plain", "Only GET is supported\n"));
+    } else if (path != "/metrics") {
+        sendAll(clientFd, httpResponse("404 Not Found", "text/plain", "Metrics are served at /metrics\n"));
+    } else {
+        scrapes_.fetch_add(1, std::memory_order_relaxed);
+        sendAll(clientFd, httpResponse("200 OK", CONTENT_TYPE, render()));
+    }
+}
+
+bool MetricsExporter::sendAll(int fd, const std::string& data) {
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;
+#else
+    const int flags = 0;
+#endif
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t sent = send(fd, data.data() + offset, data.size() - offset, flags);
+        if (sent <= 0) {
+            return false;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+    return true;
+}
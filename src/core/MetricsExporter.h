@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "LatencyHistogram.h"
+
+class PerformanceMonitor;
+
+/**
+ * @brief Builds an OpenMetrics text exposition
+ *
+ * Each family is declared once with its type and help text, followed by its
+ * samples. Counter samples get the mandatory _total suffix; histograms are
+ * converted from LatencyHistogram snapshots into cumulative buckets with
+ * bounds in seconds.
+ */
+class MetricsWriter {
+public:
+    using Labels = std::vector<std::pair<std::string, std::string>>;
+
+    void family(const std::string& name, const char* type, const char* help);
+    void counter(const std::string& name, const Labels& labels, uint64_t value);
+    void gauge(const std::string& name, const Labels& labels, double value);
+    void histogram(const std::string& name, const Labels& labels, const LatencyHistogram::Snapshot& snapshot);
+
+    // Appends the terminating "# EOF" line and hands over the text
+    std::string finish();
+
+    // Bucket bounds used for every histogram (seconds)
+    static const std::vector<double>& histogramBounds();
+
+private:
+    std::string text_;
+
+    void sample(const std::string& name, const Labels& labels, const std::string& value,
+                const char* extraLabel = nullptr, const std::string& extraValue = "");
+    static std::string formatDouble(double value);
+    static void appendEscaped(std::string& out, const std::string& value);
+};
+
+/**
+ * @brief Embedded HTTP endpoint serving metrics in OpenMetrics text format
+ *
+ * A single low-priority thread accepts connections on a local port and
+ * answers GET /metrics. Sources register collector callbacks that read
+ * atomics and published snapshots only, so a scrape never takes a lock the
+ * audio or engine threads wait on. The listening socket is polled with a
+ * timeout so stop() returns promptly; clients are served one at a time.
+ *
+ *   curl http://127.0.0.1:9464/metrics
+ */
+class MetricsExporter {
+public:
+    using Collector = std::function<void(MetricsWriter&)>;
+
+    static constexpr int DEFAULT_PORT = 9464;
+
+    MetricsExporter();
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Port 0 picks a free port; see getPort()
+    bool start(int port = DEFAULT_PORT, const std::string& bindAddress = "127.0.0.1");
+    void stop();
+    bool isRunning() const { return running_.load(); }
+    int getPort() const { return port_.load(); }
+
+    // Starts on CVOSC_METRICS_PORT when it is set
+    bool configureFromEnvironment();
+
+    void addCollector(Collector collector);
+    // Counters and stage latency histograms of a monitor that outlives the exporter
+    void addPerformanceMonitor(const PerformanceMonitor& monitor);
+
+    // Runs every collector (also used by the HTTP thread)
+    std::string render() const;
+
+private:
+    std::atomic<bool> running_{false};
+    std::atomic<int> port_{0};
+    int listenFd_ = -1;
+    std::unique_ptr<std::thread> serverThread_;
+
+    mutable std::mutex collectorsMutex_;    // Only contended by registration, never by the audio path
+    std::vector<Collector> collectors_;
+
+    std::atomic<uint64_t> scrapes_{0};
+
+    void serverLoop();
+    void handleClient(int clientFd);
+    static void lowerThreadPriority();
+    static bool sendAll(int fd, const std::string& data);
+};
@@ -1,20 +1,37 @@
 #include "OSCMixerEngine.h"
 #include "Config.h"
+#include "ConfigWatcher.h"
+#include "LatencyTracer.h"
+#include "OSCNetworkReactor.h"
+#include "OSCPacket.h"
+#include "PluginInsertChain.h"
+#include "ResourceSampler.h"
+#include "StartupProfiler.h"
+#include "TraceLog.h"
 #include <iostream>
 #include <fstream>
 #include <chrono>
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <thread>
+#include <map>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
+namespace {
+// Insert chain geometry: every input channel a CVReader can open, and its largest block
+constexpr int kMaxInsertChannels = 32;
+constexpr uint32_t kMaxInsertFrames = 512;
+}
+
 OSCMixerEngine::OSCMixerEngine() 
     : engineRunning_(false)
     , learningMode_(false)
     , learningChannelId_(-1)
-    , messagesThisSecond_(0) {
+    , messagesThisSecond_(0)
+    , insertChain_(std::make_shared<PluginInsertChain>(kMaxInsertChannels, kMaxInsertFrames)) {
     // Initialize with default 8 channels
     mixerState_.channels.clear();
     mixerState_.channels.reserve(8);
@@ -26,13 +43,15 @@ OSCMixerEngine::OSCMixerEngine()
         mixerState_.channels.push_back(std::move(channel));
     }
     std::cout << "Initialized " << mixerState_.channels.size() << " channels in constructor" << std::endl;
+    insertChain_->attachMonitor(performanceMonitor_);
 }
 
 OSCMixerEngine::OSCMixerEngine(int numChannels) 
     : engineRunning_(false)
     , learningMode_(false)
     , learningChannelId_(-1)
-    , messagesThisSecond_(0) {
+    , messagesThisSecond_(0)
+    , insertChain_(std::make_shared<PluginInsertChain>(kMaxInsertChannels, kMaxInsertFrames)) {
     // Initialize with specified number of channels
     int channels = std::max(1, std::min(numChannels, 32)); // Limit to 1-32 channels
     mixerState_.channels.clear();
@@ -45,6 +64,7 @@ OSCMixerEngine::OSCMixerEngine(int numChannels)
         mixerState_.channels.push_back(std::move(channel));
     }
     std::cout << "Initialized " << mixerState_.channels.size() << " channels in parameterized constructor" << std::endl;
+    insertChain_->attachMonitor(performanceMonitor_);
 }
 
 OSCMixerEngine::~OSCMixerEngine() {
@@ -52,18 +72,26 @@ OSCMixerEngine::~OSCMixerEngine() {
 }
 
 bool OSCMixerEngine::initialize() {
-    // Initialize AudioDeviceIntegration if not already done
+    auto initializePhase = StartupProfiler::getInstance().phase("engine_initialize");
+    
+    // Initialize AudioDeviceIntegration if not already done. Pa_Initialize and
+    // device probing take most of startup, so they overlap OSC setup; anything
+    // that touches audio devices calls waitForAudioInit() first.
     if (!audioDeviceIntegration_) {
         audioDeviceIntegration_ = std::make_shared<AudioDeviceIntegration>();
-        
-        // Create and initialize AudioDeviceManager for integration
-        auto audioDeviceManager = std::make_shared<AudioDeviceManager>();
-        if (audioDeviceManager->initialize()) {
-            audioDeviceIntegration_->initialize(audioDeviceManager.get());
-            std::cout << "✅ AudioDeviceIntegration initialized successfully" << std::endl;
-        } else {
-            std::cerr << "⚠️ Failed to initialize AudioDeviceManager, continuing without real audio" << std::endl;
-        }
+        audioDeviceManager_ = std::make_shared<AudioDeviceManager>();
+        
+        auto manager = audioDeviceManager_;
+        auto integration = audioDeviceIntegration_;
+        audioInitDone_ = std::async(std::launch::async, [manager, integration]() {
+            auto phase = StartupProfiler::getInstance().phase("audio_init");
+            if (manager->initialize()) {
+                integration->initialize(manager.get());
+                std::cout << "✅ AudioDeviceIntegration initialized successfully" << std::endl;
+            } else {
+                std::cerr << "⚠️ Failed to initialize AudioDeviceManager, continuing without real audio" << std::endl;
+            }
+        }).share();
     }
     
     try {
@@ -87,6 +115,14 @@ bool OSCMixerEngine::initialize() {
         
         // Initialize performance tracking
         lastStatsUpdate_ = std::chrono::steady_clock::now();
+        LatencyTracer::getInstance().configureFromEnvironment();
+        TraceLog::getInstance().configureFromEnvironment();
+        metricsExporter_ = std::make_unique<MetricsExporter>();
+        metricsExporter_->addCollector([this](MetricsWriter& out) { collectMetrics(out); });
+        metricsExporter_->addPerformanceMonitor(performanceMonitor_);
+        if (!metricsExporter_->configureFromEnvironment()) {
+            metricsExporter_.reset();
+        }
         
         // Start engine thread
         engineRunning_ = true;
@@ -104,6 +140,13 @@ bool OSCMixerEngine::initialize() {
 }
 
 void OSCMixerEngine::shutdown() {
+    stopWatchingConfiguration();
+    // The exporter's collector reads engine state, so it goes first
+    if (metricsExporter_) {
+        metricsExporter_->stop();
+        metricsExporter_.reset();
+    }
+    waitForAudioInit();
     if (audioDeviceIntegration_) {
         audioDeviceIntegration_->shutdown();
     }
@@ -139,6 +182,15 @@ void OSCMixerEngine::shutdown() {
             deviceStatuses_.clear();
         }
         
+        auto& tracer = LatencyTracer::getInstance();
+        if (tracer.isEnabled() && !tracer.getOutputFile().empty()) {
+            tracer.writeChromeTrace(tracer.getOutputFile());
+        }
+        auto& traceLog = TraceLog::getInstance();
+        if (!traceLog.getDumpFile().empty()) {
+            traceLog.dump(traceLog.getDumpFile());
+        }
+        
         std::cout << "OSC Mixer Engine shutdown complete" << std::endl;
     }
 }
@@ -157,6 +209,11 @@ bool OSCMixerEngine::startChannel(int channelId) {
         return false;
     }
     
+    // OSC-only channels start while audio is still initializing
+    if (channelUsesAudio(channelId)) {
+        waitForAudioInit();
+    }
+    
     try {
         std::lock_guard<std::mutex> lock(stateMutex_);
         
@@ -393,14 +450,48 @@ bool OSCMixerEngine::setChannelRange(int channelId, float minRange, float maxRan
 
 // Device Management Methods
 void OSCMixerEngine::setAudioDeviceIntegration(std::shared_ptr<AudioDeviceIntegration> integration) {
+    waitForAudioInit();
     audioDeviceIntegration_ = integration;
 }
 
+std::shared_ptr<AudioDeviceManager> OSCMixerEngine::getAudioDeviceManager() {
+    waitForAudioInit();
+    return audioDeviceManager_;
+}
+
+void OSCMixerEngine::waitForAudioInit() const {
+    if (audioInitDone_.valid()) {
+        audioInitDone_.wait();
+    }
+}
+
+bool OSCMixerEngine::isAudioDeviceId(const std::string& deviceId) {
+    return deviceId.find("audio_") == 0 || deviceId.find("real_audio_") == 0;
+}
+
+bool OSCMixerEngine::channelUsesAudio(int channelId) {
+    auto* channel = mixerState_.getChannel(channelId);
+    if (!channel) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    for (const auto* devices : {&channel->inputDevices, &channel->outputDevices}) {
+        for (const auto& device : *devices) {
+            if (device.enabled && isAudioDeviceId(device.deviceId)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 std::vector<OSCDeviceConfig> OSCMixerEngine::getAvailableInputDevices() const {
+    waitForAudioInit();
     return audioDeviceIntegration_ ? audioDeviceIntegration_->getAvailableInputDevices() : std::vector<OSCDeviceConfig>{};
 }
 
 std::vector<OSCDeviceConfig> OSCMixerEngine::getAvailableOutputDevices() const {
+    waitForAudioInit();
     return audioDeviceIntegration_ ? audioDeviceIntegration_->getAvailableOutputDevices() : std::vector<OSCDeviceConfig>{};
 }
 
@@ -408,6 +499,9 @@ bool OSCMixerEngine::addInputDevice(int channelId, const OSCDeviceConfig& device
     if (!isChannelIdValid(channelId)) {
         return false;
     }
+    if (isAudioDeviceId(device.deviceId)) {
+        waitForAudioInit();
+    }
     
     if (!validateDeviceConfig(device)) {
         std::cerr << "Invalid device configuration for device: " << device.deviceId << std::endl;
@@ -498,6 +592,9 @@ bool OSCMixerEngine::addOutputDevice(int channelId, const OSCDeviceConfig& devic
     if (!isChannelIdValid(channelId)) {
         return false;
     }
+    if (isAudioDeviceId(device.deviceId)) {
+        waitForAudioInit();
+    }
     
     if (!validateDeviceConfig(device)) {
         std::cerr << "Invalid device configuration for device: " << device.deviceId << std::endl;
@@ -759,6 +856,7 @@ void OSCMixerEngine::stopDeviceDiscovery() {
 }
 
 std::vector<std::string> OSCMixerEngine::getAvailableDevices() const {
+    waitForAudioInit();
     std::vector<std::string> audioDevices;
     if (audioDeviceIntegration_) {
         auto inputDevices = audioDeviceIntegration_->getAvailableInputDevices();
@@ -829,7 +927,7 @@ std::vector<DeviceStatus> OSCMixerEngine::getAllDeviceStatuses() const {
 }
 
 // Message Processing Methods
-void OSCMixerEngine::sendOSCMessage(int channelId, const std::string& deviceId, float value) {
+void OSCMixerEngine::sendOSCMessage(int channelId, const std::string& deviceId, float value, uint64_t traceId) {
     // Find the output device to get the correct OSC address
     std::string oscAddress = "/channel/" + std::to_string(channelId + 1) + "/out";
     
@@ -850,6 +948,7 @@ void OSCMixerEngine::sendOSCMessage(int channelId, const std::string& deviceId,
     message.sourceChannelId = channelId;
     message.deviceId = deviceId;
     message.timestamp = std::chrono::steady_clock::now();
+    message.traceId = traceId;
     
     sendOSCMessage(channelId, deviceId, message);
 }
@@ -857,6 +956,11 @@ void OSCMixerEngine::sendOSCMessage(int channelId, const std::string& deviceId,
 void OSCMixerEngine::sendOSCMessage(int channelId, const std::string& deviceId, const OSCMessage& message) {
     std::lock_guard<std::mutex> lock(messageMutex_);
     messageQueue_.push(message);
+    size_t depth = messageQueue_.size();
+    queueDepth_.store(depth, std::memory_order_relaxed);
+    if (depth > queueHighWater_.load(std::memory_order_relaxed)) {
+        queueHighWater_.store(depth, std::memory_order_relaxed);
+    }
     messageCondition_.notify_one();
     
     // Update statistics
@@ -907,7 +1011,9 @@ void OSCMixerEngine::resetStatistics() {
     for (auto& [deviceId, status] : deviceStatuses_) {
         status.messageCount = 0;
         status.latencyMs = 0.0f;
+        status.sendFailures = 0;
     }
+    queueHighWater_ = queueDepth_.load();
     
     std::cout << "Statistics reset" << std::endl;
 }
@@ -924,6 +1030,102 @@ int OSCMixerEngine::getTotalErrors() const {
     return mixerState_.totalErrors;
 }
 
+void OSCMixerEngine::publishDeviceMetrics() {
+    auto devices = std::make_shared<std::vector<DeviceMetrics>>();
+    {
+        std::lock_guard<std::mutex> lock(deviceMutex_);
+        devices->reserve(deviceStatuses_.size());
+        for (const auto& [deviceId, status] : deviceStatuses_) {
+            DeviceMetrics metrics;
+            metrics.deviceId = deviceId;
+            metrics.connected = status.isConnected();
+            metrics.messagesSent = static_cast<uint64_t>(std::max(status.messageCount, 0));
+            metrics.sendFailures = static_cast<uint64_t>(std::max(status.sendFailures, 0));
+            devices->push_back(std::move(metrics));
+        }
+    }
+    std::atomic_store(&deviceMetrics_, std::shared_ptr<const std::vector<DeviceMetrics>>(std::move(devices)));
+}
+
+std::shared_ptr<const std::vector<OSCMixerEngine::DeviceMetrics>> OSCMixerEngine::getDeviceMetrics() const {
+    return std::atomic_load(&deviceMetrics_);
+}
+
+void OSCMixerEngine::collectMetrics(MetricsWriter& out) const {
+    // Channels are created once with the engine, so walking them needs no lock
+    out.family("cvosc_channel_messages_received", "counter", "OSC messages received per mixer channel.");
+    for (const auto& channel : mixerState_.channels) {
+        out.counter("cvosc_channel_messages_received", {{"channel", std::to_string(channel->channelId + 1)}},
+                    static_cast<uint64_t>(std::max(channel->messagesReceived.load(), 0)));
+    }
+    out.family("cvosc_channel_messages_sent", "counter", "Messages delivered to outputs per mixer channel.");
+    for (const auto& channel : mixerState_.channels) {
+        out.counter("cvosc_channel_messages_sent", {{"channel", std::to_string(channel->channelId + 1)}},
+                    static_cast<uint64_t>(std::max(channel->messagesSent.load(), 0)));
+    }
+    out.family("cvosc_channel_send_errors", "counter", "Failed output sends per mixer channel.");
+    for (const auto& channel : mixerState_.channels) {
+        out.counter("cvosc_channel_send_errors", {{"channel", std::to_string(channel->channelId + 1)}},
+                    static_cast<uint64_t>(std::max(channel->errors.load(), 0)));
+    }
+    out.family("cvosc_messages_per_second", "gauge", "Messages queued by the engine during the last second.");
+    out.gauge("cvosc_messages_per_second", {}, mixerState_.totalMessagesPerSecond.load());
+    out.family("cvosc_errors", "counter", "Engine and device errors.");
+    out.counter("cvosc_errors", {}, static_cast<uint64_t>(std::max(mixerState_.totalErrors.load(), 0)));
+
+    if (auto devices = getDeviceMetrics()) {
+        out.family("cvosc_device_messages_sent", "counter", "Messages sent per output device.");
+        for (const auto& device : *devices) {
+            out.counter("cvosc_device_messages_sent", {{"device", device.deviceId}}, device.messagesSent);
+        }
+        out.family("cvosc_device_send_failures", "counter", "Failed sends per output device.");
+        for (const auto& device : *devices) {
+            out.counter("cvosc_device_send_failures", {{"device", device.deviceId}}, device.sendFailures);
+        }
+        out.family("cvosc_device_connected", "gauge", "1 when the device is connected.");
+        for (const auto& device : *devices) {
+            out.gauge("cvosc_device_connected", {{"device", device.deviceId}}, device.connected ? 1 : 0);
+        }
+    }
+
+    out.family("cvosc_queue_depth", "gauge", "Messages waiting in the engine queue.");
+    out.gauge("cvosc_queue_depth", {}, static_cast<double>(queueDepth_.load(std::memory_order_relaxed)));
+    out.family("cvosc_queue_depth_max", "gauge", "Highest engine queue depth since the last statistics reset.");
+    out.gauge("cvosc_queue_depth_max", {}, static_cast<double>(queueHighWater_.load(std::memory_order_relaxed)));
+
+    out.family("cvosc_queue_wait_seconds", "histogram", "Time messages spend in the engine queue.");
+    out.histogram("cvosc_queue_wait_seconds", {}, queueWaitHistogram_.snapshot());
+    out.family("cvosc_osc_send_seconds", "histogram", "Time to encode one OSC message and queue it for the network reactor (sendto runs on the reactor thread).");
+    out.histogram("cvosc_osc_send_seconds", {}, sendHistogram_.snapshot());
+
+    auto& startup = StartupProfiler::getInstance();
+    out.family("cvosc_startup_phase_seconds", "gauge", "Duration of each startup phase.");
+    for (const auto& phase : startup.getPhases()) {
+        out.gauge("cvosc_startup_phase_seconds", {{"phase", phase.name}}, phase.durationNs / 1e9);
+    }
+    if (startup.getTimeToFirstPacketNs() >= 0) {
+        out.family("cvosc_time_to_first_packet_seconds", "gauge", "Time from process start to the first OSC packet sent.");
+        out.gauge("cvosc_time_to_first_packet_seconds", {}, startup.getTimeToFirstPacketNs() / 1e9);
+    }
+
+    auto reactor = OSCNetworkReactor::shared().getStats();
+    out.family("cvosc_reactor_packets_sent", "counter", "UDP packets sent by the network reactor.");
+    out.counter("cvosc_reactor_packets_sent", {}, reactor.packetsSent);
+    out.family("cvosc_reactor_packets_received", "counter", "UDP packets received by the network reactor.");
+    out.counter("cvosc_reactor_packets_received", {}, reactor.packetsReceived);
+    out.family("cvosc_reactor_send_calls", "counter", "Send syscalls made by the network reactor.");
+    out.counter("cvosc_reactor_send_calls", {}, reactor.sendCalls);
+    out.family("cvosc_reactor_send_errors", "counter", "Packets the kernel refused to send.");
+    out.counter("cvosc_reactor_send_errors", {}, reactor.sendErrors);
+    out.family("cvosc_reactor_submissions_dropped", "counter", "Packets dropped because the reactor queue was full.");
+    out.counter("cvosc_reactor_submissions_dropped", {}, reactor.submissionsDropped);
+
+    out.family("cvosc_audio_dropped_samples", "counter", "Input frames lost to audio input overflow.");
+    out.counter("cvosc_audio_dropped_samples", {}, RealAudioStream::getDroppedSamples());
+    out.family("cvosc_audio_buffer_underruns", "counter", "Times audio output ran out of data.");
+    out.counter("cvosc_audio_buffer_underruns", {}, RealAudioStream::getBufferUnderruns());
+}
+
 // Configuration Methods
 bool OSCMixerEngine::loadConfiguration(const std::string& filePath) {
     try {
@@ -952,6 +1154,12 @@ bool OSCMixerEngine::loadConfiguration(const std::string& filePath) {
             if (mixer.contains("masterMute")) {
                 mixerState_.masterMute = mixer["masterMute"];
             }
+            if (mixer.contains("outputFanout")) {
+                mixerState_.outputFanout = mixer["outputFanout"].get<bool>();
+            }
+            if (mixer.contains("outputCoalesce")) {
+                mixerState_.outputCoalesce = mixer["outputCoalesce"].get<bool>();
+            }
         }
         
         // Load channel configurations
@@ -1023,6 +1231,8 @@ bool OSCMixerEngine::saveConfiguration(const std::string& filePath) {
         config["mixer"]["channels"] = 8;
         config["mixer"]["masterLevel"] = mixerState_.masterLevel;
         config["mixer"]["masterMute"] = mixerState_.masterMute;
+        config["mixer"]["outputFanout"] = mixerState_.outputFanout.load();
+        config["mixer"]["outputCoalesce"] = mixerState_.outputCoalesce.load();
         
         // Save channel configurations
         config["channels"] = json::array();
@@ -1068,32 +1278,279 @@ bool OSCMixerEngine::saveConfiguration(const std::string& filePath) {
     }
 }
 
+bool OSCMixerEngine::reloadConfiguration(const std::string& filePath) {
+    try {
+        std::ifstream file(filePath);
+        if (!file.is_open()) {
+            std::cerr << "Cannot open configuration file: " << filePath << std::endl;
+            return false;
+        }
+        
+        json config;
+        file >> config;
+        
+        auto diff = applyConfiguration(config);
+        if (diff.empty()) {
+            std::cout << "Configuration reloaded from " << filePath << ": no changes" << std::endl;
+            return true;
+        }
+        
+        int counts[5] = {};
+        for (const auto& change : diff.devices) {
+            counts[static_cast<int>(change.kind)]++;
+        }
+        std::cout << "Configuration reloaded from " << filePath << ": "
+                  << diff.channels.size() << " channel(s) updated";
+        for (int kind = 0; kind < 5; ++kind) {
+            if (counts[kind]) {
+                std::cout << ", " << counts[kind] << " device(s) "
+                          << getDeviceChangeKindName(static_cast<DeviceChangeKind>(kind));
+            }
+        }
+        std::cout << std::endl;
+        return true;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error reloading configuration: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+MixerConfigDiff OSCMixerEngine::applyConfiguration(const json& config) {
+    MixerConfigDiff diff;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        auto current = snapshotConfiguration();
+        diff = diffMixerConfiguration(current, parseConfiguration(config, current));
+    }
+    if (!diff.empty()) {
+        applyConfigurationDiff(diff);
+    }
+    return diff;
+}
+
+bool OSCMixerEngine::watchConfiguration(const std::string& filePath) {
+    stopWatchingConfiguration();
+    configWatcher_ = std::make_unique<ConfigWatcher>(filePath);
+    configWatcher_->startFile([this](const std::string& path) { reloadConfiguration(path); });
+    std::cout << "Watching configuration file: " << filePath << std::endl;
+    return true;
+}
+
+void OSCMixerEngine::stopWatchingConfiguration() {
+    if (configWatcher_) {
+        configWatcher_->stop();
+        configWatcher_.reset();
+    }
+}
+
+MixerConfigSnapshot OSCMixerEngine::snapshotConfiguration() const {
+    MixerConfigSnapshot snapshot;
+    snapshot.masterLevel = mixerState_.masterLevel;
+    snapshot.masterMute = mixerState_.masterMute;
+    snapshot.outputFanout = mixerState_.outputFanout;
+    snapshot.outputCoalesce = mixerState_.outputCoalesce;
+    for (const auto& channel : mixerState_.channels) {
+        ChannelConfigSnapshot channelSnapshot;
+        channelSnapshot.name = channel->channelName;
+        channelSnapshot.levelVolts = channel->levelVolts;
+        channelSnapshot.minRange = channel->minRange;
+        channelSnapshot.maxRange = channel->maxRange;
+        std::copy(std::begin(channel->channelColor), std::end(channel->channelColor), channelSnapshot.color);
+        channelSnapshot.inputDevices = channel->inputDevices;
+        channelSnapshot.outputDevices = channel->outputDevices;
+        snapshot.channels.push_back(std::move(channelSnapshot));
+    }
+    return snapshot;
+}
+
+// Same fields and precedence as loadConfiguration: anything absent keeps its current value
+MixerConfigSnapshot OSCMixerEngine::parseConfiguration(const json& config, MixerConfigSnapshot base) const {
+    if (config.contains("mixer")) {
+        const auto& mixer = config["mixer"];
+        if (mixer.contains("masterLevel")) base.masterLevel = mixer["masterLevel"];
+        if (mixer.contains("masterMute")) base.masterMute = mixer["masterMute"];
+        if (mixer.contains("outputFanout")) base.outputFanout = mixer["outputFanout"];
+        if (mixer.contains("outputCoalesce")) base.outputCoalesce = mixer["outputCoalesce"];
+    }
+    
+    if (config.contains("channels")) {
+        const auto& channels = config["channels"];
+        for (size_t i = 0; i < channels.size() && i < base.channels.size(); ++i) {
+            const auto& channelConfig = channels[i];
+            auto& channel = base.channels[i];
+            
+            if (channelConfig.contains("name")) channel.name = channelConfig["name"];
+            if (channelConfig.contains("levelVolts")) channel.levelVolts = channelConfig["levelVolts"];
+            if (channelConfig.contains("minRange")) channel.minRange = channelConfig["minRange"];
+            if (channelConfig.contains("maxRange")) channel.maxRange = channelConfig["maxRange"];
+            if (channelConfig.contains("color") && channelConfig["color"].size() >= 3) {
+                for (int c = 0; c < 3; ++c) {
+                    channel.color[c] = channelConfig["color"][c];
+                }
+            }
+            
+            auto parseDevices = [this](const json& devices, std::vector<OSCDeviceConfig>& current) {
+                std::vector<OSCDeviceConfig> parsed;
+                for (const auto& deviceJson : devices) {
+                    auto device = deserializeDeviceConfig(deviceJson);
+                    // Start from the live device so fields the file does not store survive
+                    auto existing = std::find_if(current.begin(), current.end(),
+                        [&device](const OSCDeviceConfig& d) { return d.deviceId == device.deviceId; });
+                    if (existing != current.end()) {
+                        OSCDeviceConfig merged = *existing;
+                        copyPersistedDeviceFields(merged, device);
+                        device = merged;
+                    }
+                    parsed.push_back(device);
+                }
+                current = std::move(parsed);
+            };
+            if (channelConfig.contains("inputDevices")) {
+                parseDevices(channelConfig["inputDevices"], channel.inputDevices);
+            }
+            if (channelConfig.contains("outputDevices")) {
+                parseDevices(channelConfig["outputDevices"], channel.outputDevices);
+            }
+        }
+    }
+    return base;
+}
+
+void OSCMixerEngine::applyConfigurationDiff(const MixerConfigDiff& diff) {
+    std::vector<DeviceChange> deferred;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        
+        if (diff.masterLevel) mixerState_.masterLevel = *diff.masterLevel;
+        if (diff.masterMute) mixerState_.masterMute = *diff.masterMute;
+        if (diff.outputFanout) mixerState_.outputFanout = *diff.outputFanout;
+        if (diff.outputCoalesce) mixerState_.outputCoalesce = *diff.outputCoalesce;
+        
+        for (const auto& settings : diff.channels) {
+            auto* channel = mixerState_.getChannel(settings.channelId);
+            if (!channel) {
+                continue;
+            }
+            if (settings.name) channel->channelName = *settings.name;
+            if (settings.color) std::copy(settings.color->begin(), settings.color->end(), channel->channelColor);
+            if (settings.levelVolts) channel->levelVolts = *settings.levelVolts;
+            if (settings.range) {
+                auto [minRange, maxRange] = *settings.range;
+                if (minRange < maxRange) {
+                    channel->minRange = minRange;
+                    channel->maxRange = maxRange;
+                    channel->levelVolts = std::clamp(channel->levelVolts, minRange, maxRange);
+                } else {
+                    std::cerr << "Ignoring invalid range for channel " << (settings.channelId + 1) << ": min ("
+                              << minRange << ") must be less than max (" << maxRange << ")" << std::endl;
+                }
+            }
+        }
+        
+        for (const auto& change : diff.devices) {
+            auto* channel = mixerState_.getChannel(change.channelId);
+            if (!channel) {
+                continue;
+            }
+            auto& devices = change.isInput ? channel->inputDevices : channel->outputDevices;
+            auto device = std::find_if(devices.begin(), devices.end(),
+                [&change](const OSCDeviceConfig& d) { return d.deviceId == change.device.deviceId; });
+            
+            switch (change.kind) {
+                case DeviceChangeKind::UpdateInPlace:
+                    if (device != devices.end()) {
+                        copyPersistedDeviceFields(*device, change.device);
+                    }
+                    break;
+                    
+                case DeviceChangeKind::Retarget:
+                    if (device != devices.end()) {
+                        copyPersistedDeviceFields(*device, change.device);
+                        std::lock_guard<std::mutex> deviceLock(deviceMutex_);
+                        auto senderIt = oscSenders_.find(change.device.deviceId);
+                        if (senderIt != oscSenders_.end() && senderIt->second) {
+                            senderIt->second->setTarget(change.device.networkAddress,
+                                                        std::to_string(change.device.port));
+                        }
+                    }
+                    break;
+                    
+                case DeviceChangeKind::Added:
+                    // A stopped channel only records the device, as loadConfiguration does
+                    if (channel->state != ChannelState::RUNNING) {
+                        if (change.isInput) {
+                            channel->addInputDevice(change.device);
+                        } else {
+                            channel->addOutputDevice(change.device);
+                        }
+                    } else {
+                        deferred.push_back(change);
+                    }
+                    break;
+                    
+                case DeviceChangeKind::Removed:
+                case DeviceChangeKind::Recreate:
+                    deferred.push_back(change);
+                    break;
+            }
+        }
+    }
+    
+    // These take stateMutex_ themselves and may open or close sockets and streams
+    for (const auto& change : deferred) {
+        switch (change.kind) {
+            case DeviceChangeKind::Added:
+                if (change.isInput) {
+                    addInputDevice(change.channelId, change.device);
+                } else {
+                    addOutputDevice(change.channelId, change.device);
+                }
+                break;
+            case DeviceChangeKind::Removed:
+                if (change.isInput) {
+                    removeInputDevice(change.channelId, change.device.deviceId);
+                } else {
+                    removeOutputDevice(change.channelId, change.device.deviceId);
+                }
+                break;
+            case DeviceChangeKind::Recreate:
+                updateDeviceConfig(change.device.deviceId, change.device);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 // Private Methods Implementation
 
 void OSCMixerEngine::engineLoop() {
     std::cout << "OSC Mixer Engine loop started" << std::endl;
+    LatencyTracer::getInstance().setThreadName("OSCMixerEngine");
+    ScopedThreadRegistration registration("OSCMixerEngine");
     
     int loopCount = 0;
     while (engineRunning_) {
         try {
             loopCount++;
             
-            // Debug log every 100 iterations
-            if (loopCount % 100 == 0) {
-                std::cout << "[OSCMixerEngine::engineLoop] Iteration #" << loopCount << std::endl;
-                
-                // Log channel states
-                for (size_t i = 0; i < mixerState_.channels.size(); ++i) {
-                    auto* channel = mixerState_.channels[i].get();
-                    if (channel && channel->state == ChannelState::RUNNING) {
-                        std::cout << "  Channel " << i << ": RUNNING, level=" 
-                                  << channel->levelVolts << "V" << std::endl;
+            // Channel states once a second (the loop runs every 10 ms)
+            if (loopCount % 100 == 0 && TraceLog::isEnabled(TraceCategory::Engine)) {
+                TRACE_DEBUG(TraceCategory::Engine, "engine iteration %d, queue depth %zu", loopCount,
+                            queueDepth_.load(std::memory_order_relaxed));
+                for (const auto& channel : mixerState_.channels) {
+                    if (channel->state == ChannelState::RUNNING) {
+                        TRACE_DEBUG(TraceCategory::Engine, "channel %d running, level=%fV", channel->channelId,
+                                    channel->levelVolts);
                     }
                 }
             }
+            TraceLog::getInstance().serviceDumpRequest();
             
             // Process message queue
             processMessageQueue();
+            applySendResults();
             
             // Update device statuses
             updateDeviceStatuses();
@@ -1101,6 +1558,11 @@ void OSCMixerEngine::engineLoop() {
             // Update performance stats
             updatePerformanceStats();
             
+            // Both the channel loop and queued messages feed audio outputs; each gets one value per tick
+            if (audioDeviceIntegration_) {
+                audioDeviceIntegration_->flushOutputSamples();
+            }
+            
             // Check for solo/mute changes
             updateSoloMixLogic();
             
@@ -1152,9 +1614,29 @@ void OSCMixerEngine::discoveryLoop() {
 void OSCMixerEngine::processMessageQueue() {
     std::unique_lock<std::mutex> lock(messageMutex_);
     
+    if (mixerState_.outputFanout.load(std::memory_order_relaxed) && !messageQueue_.empty()) {
+        // Take the whole backlog so payloads shared by several outputs are encoded once
+        std::vector<OSCMessage> batch;
+        batch.reserve(messageQueue_.size());
+        while (!messageQueue_.empty()) {
+            batch.push_back(std::move(messageQueue_.front()));
+            messageQueue_.pop();
+        }
+        queueDepth_.store(0, std::memory_order_relaxed);
+        lock.unlock();
+        
+        try {
+            routeOutputBatch(batch);
+        } catch (const std::exception& e) {
+            logError(std::string("Error processing OSC message batch: ") + e.what());
+        }
+        return;
+    }
+    
     while (!messageQueue_.empty()) {
         OSCMessage message = messageQueue_.front();
         messageQueue_.pop();
+        queueDepth_.store(messageQueue_.size(), std::memory_order_relaxed);
         
         // Unlock while processing to avoid blocking
         lock.unlock();
@@ -1211,6 +1693,8 @@ void OSCMixerEngine::updatePerformanceStats() {
         // Update messages per second
         mixerState_.totalMessagesPerSecond = messagesThisSecond_.exchange(0);
         lastStatsUpdate_ = now;
+        publishDeviceMetrics();
+        StartupProfiler::getInstance().reportOnceAfterFirstPacket(std::cout);
         
         // Update channel statistics with continuous monitoring
         for (auto& channel : mixerState_.channels) {
@@ -1226,6 +1710,8 @@ void OSCMixerEngine::updatePerformanceStats() {
                 // Process audio from connected input devices (real audio hardware)
                 bool hasActiveInput = false;
                 float inputSignal = 0.0f;
+                uint64_t traceId = 0;
+                auto routeStart = std::chrono::steady_clock::now();
                 
                 // Get audio input from connected devices
                 if (!channel->inputDevices.empty()) {
@@ -1238,6 +1724,7 @@ hasActiveInput = true;
 if (audioDeviceIntegration_) {
     float realInput = audioDeviceIntegration_->getInputSample(inputDevice.deviceId);
     inputSignal = realInput;
+    traceId = audioDeviceIntegration_->takeInputTraceId(inputDevice.deviceId);
 } else {
     inputSignal = 0.0f; // fallback
 }
@@ -1281,18 +1768,11 @@ break; // Use first enabled device
                     // ВАЖНО: Обновляем levelVolts для отображения в GUI
                     channel->levelVolts = processedSignal;
                     
-                    // ДЕТАЛЬНАЯ ДИАГНОСТИКА: Логируем каждое обновление
-                    if (processedSignal > 0.001) {
-                        printf("[GUI UPDATE] Channel %d: Setting levelVolts=%.6fV (inputSignal=%.6fV)\n", 
-                               channel->channelId, processedSignal, inputSignal);
-                        
-                        // Проверяем, действительно ли значение записалось
-                        double verifyValue = channel->levelVolts;
-                        printf("[GUI VERIFY] Channel %d: Read back levelVolts=%.6fV\n", 
-                               channel->channelId, verifyValue);
-                    }
+                    TRACE_DEBUG(TraceCategory::Gui, "channel %d levelVolts=%.6fV (input %.6fV)", channel->channelId,
+                                processedSignal, inputSignal);
                     
                     // Send to output devices if configured
+                    bool queuedOsc = false;
                     if (!channel->outputDevices.empty()) {
                         for (const auto& outputDevice : channel->outputDevices) {
                             if (outputDevice.enabled) {
@@ -1303,11 +1783,21 @@ break; // Use first enabled device
                                     audioDeviceIntegration_->sendOutputSample(outputDevice.deviceId, processedSignal);
                                 } else {
                                     // Send OSC message
-                                    sendOSCMessage(channel->channelId, outputDevice.deviceId, processedSignal);
+                                    sendOSCMessage(channel->channelId, outputDevice.deviceId, processedSignal, traceId);
+                                    queuedOsc = true;
                                 }
                             }
                         }
                     }
+                    auto routeEnd = std::chrono::steady_clock::now();
+                    if (queuedOsc) {
+                        performanceMonitor_.recordStageLatency(PerformanceMonitor::LatencyStage::ProcessToEnqueue,
+                                                               routeEnd - routeStart);
+                    }
+                    if (traceId) {
+                        LatencyTracer::getInstance().recordSpan(traceId, "mixer_route", routeStart, routeEnd,
+                                                                channel->channelId);
+                    }
                     
                     // Log signal processing periodically
                     static auto lastDebugLog = std::chrono::steady_clock::now();
@@ -1339,6 +1829,17 @@ bool OSCMixerEngine::createOSCSender(const OSCDeviceConfig& config) {
         
         // Create new OSC sender
         auto sender = std::make_unique<OSCSender>(config.networkAddress, std::to_string(config.port));
+        if (config.useSequencedStream) {
+            OSCStream::Config streamConfig;
+            streamConfig.streamId = static_cast<uint32_t>(std::hash<std::string>{}(config.deviceId));
+            streamConfig.redundancy = static_cast<OSCStream::Redundancy>(std::clamp(config.streamRedundancy, 0, 2));
+            streamConfig.parityGroup = static_cast<size_t>(std::max(config.parityGroup, 2));
+            sender->setStreamMode(true, streamConfig);
+        }
+        sender->setSendObserver([this](const OSCNetworkReactor::SendResult& result) { onSendResult(result); });
+        if (outputPacing_) {
+            sender->setPacing(true, outputPacingRate_);
+        }
         
         oscSenders_[config.deviceId] = std::move(sender);
         
@@ -1398,7 +1899,16 @@ bool OSCMixerEngine::createOSCReceiver(const OSCDeviceConfig& config) {
             }
         });
         
-        if (!receiver->start()) {
+        bool started;
+        if (config.protocolType == OSCProtocolType::UDP_MULTICAST) {
+            // networkAddress is the group; a specific localAddress picks the interface to join on
+            receiver->setMulticastGroup(config.networkAddress,
+                                        config.localAddress == "0.0.0.0" ? "" : config.localAddress);
+            started = receiver->start(std::to_string(config.localPort), OSCReceiver::Protocol::MULTICAST);
+        } else {
+            started = receiver->start();
+        }
+        if (!started) {
             std::cerr << "Failed to start OSC receiver for " << config.deviceId << std::endl;
             return false;
         }
@@ -1530,6 +2040,13 @@ void OSCMixerEngine::routeOutputMessage(const OSCMessage& message) {
         return;
     }
     
+    auto& tracer = LatencyTracer::getInstance();
+    auto dequeued = std::chrono::steady_clock::now();
+    queueWaitHistogram_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(dequeued - message.timestamp));
+    if (message.traceId) {
+        tracer.recordSpan(message.traceId, "queue_wait", message.timestamp, dequeued, message.sourceChannelId);
+    }
+    
     std::lock_guard<std::mutex> lock(deviceMutex_);
     
     // Check if this is a real audio output device
@@ -1558,11 +2075,12 @@ void OSCMixerEngine::routeOutputMessage(const OSCMessage& message) {
                 status.messageCount++;
                 status.lastActivity = std::chrono::steady_clock::now();
             } else {
-                handleDeviceError(message.deviceId, "Failed to send audio output");
+                channel->errors++;
+                handleDeviceErrorLocked(message.deviceId, "Failed to send audio output");
             }
             
         } catch (const std::exception& e) {
-            handleDeviceError(message.deviceId, e.what());
+            handleDeviceErrorLocked(message.deviceId, e.what());
         }
         
     } else {
@@ -1585,10 +2103,37 @@ void OSCMixerEngine::routeOutputMessage(const OSCMessage& message) {
             // 
             // processedValue = original signal (100% passthrough)
             
-            // Send the message
-            bool success = sender->sendFloat(message.address, processedValue);
+            // Encodes and queues the message. The reactor thread does the sendto and
+            // reports it to onSendResult, so this times the enqueue only; the record
+            // goes in first because the report can arrive before sendFloat returns.
+            OSCNetworkReactor::EndpointId target = sender->getEndpoint();
+            uint64_t tag = 0;
+            if (target) {
+                tag = nextSendTag_++;
+                std::lock_guard<std::mutex> resultsLock(sendResultsMutex_);
+                inFlightSends_[tag].push_back({message.deviceId, message.sourceChannelId, message.traceId, target,
+                                               message.timestamp});
+            }
+            auto sendStart = std::chrono::steady_clock::now();
+            bool success = sender->sendFloat(message.address, processedValue, tag);
+            auto sendEnd = std::chrono::steady_clock::now();
+            sendHistogram_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(sendEnd - sendStart));
+            if (message.traceId) {
+                tracer.recordSpan(message.traceId, "osc_encode_enqueue", sendStart, sendEnd, message.sourceChannelId);
+            }
+            if (tag && !success) {
+                std::lock_guard<std::mutex> resultsLock(sendResultsMutex_);
+                inFlightSends_.erase(tag);
+            }
             
-            if (success) {
+            if (success && tag) {
+                // Counted as sent, or failed, once the reactor has reported it
+                channel->outputMeter.addSample(processedValue);
+            } else if (success) {
+                // liblo sent it synchronously
+                performanceMonitor_.recordStageLatency(PerformanceMonitor::LatencyStage::EnqueueToSend,
+                                                       sendEnd - message.timestamp);
+                StartupProfiler::getInstance().markFirstPacket();
                 channel->messagesSent++;
                 channel->outputMeter.addSample(processedValue);
                 
@@ -1596,11 +2141,279 @@ void OSCMixerEngine::routeOutputMessage(const OSCMessage& message) {
                 status.messageCount++;
                 status.lastActivity = std::chrono::steady_clock::now();
             } else {
-                handleDeviceError(message.deviceId, "Failed to send OSC message");
+                channel->errors++;
+                handleDeviceErrorLocked(message.deviceId, "Failed to send OSC message");
             }
             
         } catch (const std::exception& e) {
-            handleDeviceError(message.deviceId, e.what());
+            handleDeviceErrorLocked(message.deviceId, e.what());
+        }
+    }
+}
+
+void OSCMixerEngine::routeOutputBatch(const std::vector<OSCMessage>& messages) {
+    // The batch is cut into segments in which each (target, address) appears once,
+    // and segments go out in order, so every value reaches its target in the order
+    // it was queued. With outputCoalesce the whole batch is one segment that keeps
+    // only the latest value per (target, address) instead; a backpressured target
+    // gets that treatment either way, as queueing superseded values only adds to its backlog.
+    // Within a segment the same payload (address and value) for the same set of
+    // reactor targets is one packet: bundled with the other payloads for that set,
+    // encoded once and handed to the reactor for all of them in one submission.
+    // Groups go out in the order they were first seen.
+    struct Latest {
+        const OSCMessage* message;
+        float value;
+        OSCNetworkReactor::EndpointId target;
+        std::vector<const OSCMessage*> messages;   // Coalesced ones included, for the counters
+    };
+    struct Payload {
+        const OSCMessage* first;
+        float value;
+        std::vector<OSCNetworkReactor::EndpointId> targets;
+        std::vector<const OSCMessage*> messages;
+    };
+    constexpr size_t kMaxFanoutPacketBytes = 1200;   // Stays under a typical path MTU
+    
+    std::vector<const OSCMessage*> individual;
+    auto& tracer = LatencyTracer::getInstance();
+    auto dequeued = std::chrono::steady_clock::now();
+    const bool coalesce = mixerState_.outputCoalesce.load(std::memory_order_relaxed);
+    std::unordered_map<OSCNetworkReactor::EndpointId, bool> backpressured;   // Sampled once per batch
+    {
+        std::lock_guard<std::mutex> lock(deviceMutex_);
+        std::vector<Latest> latest;
+        std::unordered_map<std::string, size_t> latestIndex;
+        
+        auto sendSegment = [&]() {
+            // One entry per (target, address), so no target appears twice in a payload
+            std::vector<Payload> payloads;
+            std::unordered_map<std::string, size_t> payloadIndex;
+            for (Latest& entry : latest) {
+                std::string key = entry.message->address;
+                key.append(reinterpret_cast<const char*>(&entry.value), sizeof(entry.value));
+                auto [it, inserted] = payloadIndex.emplace(std::move(key), payloads.size());
+                if (inserted) {
+                    payloads.push_back({entry.message, entry.value, {}, {}});
+                }
+                Payload& payload = payloads[it->second];
+                payload.targets.push_back(entry.target);
+                payload.messages.insert(payload.messages.end(), entry.messages.begin(), entry.messages.end());
+            }
+        
+            std::vector<std::pair<std::vector<OSCNetworkReactor::EndpointId>, std::vector<size_t>>> groups;
+            std::map<std::vector<OSCNetworkReactor::EndpointId>, size_t> groupIndex;
+            for (size_t i = 0; i < payloads.size(); ++i) {
+                std::vector<OSCNetworkReactor::EndpointId> targets = payloads[i].targets;
+                std::sort(targets.begin(), targets.end());
+                auto [it, inserted] = groupIndex.emplace(targets, groups.size());
+                if (inserted) {
+                    groups.push_back({std::move(targets), {}});
+                }
+                groups[it->second].second.push_back(i);
+            }
+        
+            std::vector<uint8_t> packet;
+            for (const auto& [targets, members] : groups) {
+                for (size_t next = 0; next < members.size();) {
+                    auto sendStart = std::chrono::steady_clock::now();
+                    packet.clear();
+                    size_t end = next;
+                    if (members.size() == 1) {
+                        const Payload& payload = payloads[members[0]];
+                        OSCPacket::appendFloatMessage(packet, payload.first->address, &payload.value, 1);
+                        end = 1;
+                    } else {
+                        OSCPacket::appendBundleHeader(packet);
+                        do {
+                            const Payload& payload = payloads[members[end]];
+                            OSCPacket::appendBundleFloatMessage(packet, payload.first->address, &payload.value, 1);
+                            ++end;
+                        } while (end < members.size() && packet.size() < kMaxFanoutPacketBytes);
+                    }
+                    // One tag for the packet; each target reports its own copy to onSendResult
+                    const uint64_t tag = nextSendTag_++;
+                    {
+                        std::lock_guard<std::mutex> resultsLock(sendResultsMutex_);
+                        auto& records = inFlightSends_[tag];
+                        for (size_t m = next; m < end; ++m) {
+                            for (const OSCMessage* message : payloads[members[m]].messages) {
+                                records.push_back({message->deviceId, message->sourceChannelId, message->traceId,
+                                                   oscSenders_[message->deviceId]->getEndpoint(), message->timestamp});
+                            }
+                        }
+                    }
+                    size_t accepted = OSCNetworkReactor::shared().submitFanout(targets.data(), targets.size(),
+                                                                              packet.data(), packet.size(), tag);
+                    auto sendEnd = std::chrono::steady_clock::now();
+                    sendHistogram_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(sendEnd - sendStart));
+                
+                    std::vector<InFlightSend> refused;
+                    if (accepted < targets.size()) {
+                        // Whatever has not been reported yet counts as failed
+                        std::lock_guard<std::mutex> resultsLock(sendResultsMutex_);
+                        auto it = inFlightSends_.find(tag);
+                        if (it != inFlightSends_.end()) {
+                            refused = std::move(it->second);
+                            inFlightSends_.erase(it);
+                        }
+                    }
+                    for (size_t m = next; m < end; ++m) {
+                        const Payload& payload = payloads[members[m]];
+                        for (const OSCMessage* message : payload.messages) {
+                            mixerState_.getChannel(message->sourceChannelId)->outputMeter.addSample(payload.value);
+                            if (message->traceId) {
+                                tracer.recordSpan(message->traceId, "osc_encode_enqueue", sendStart, sendEnd,
+                                                  message->sourceChannelId);
+                            }
+                        }
+                    }
+                    for (const InFlightSend& send : refused) {
+                        mixerState_.getChannel(send.channelId)->errors++;
+                        handleDeviceErrorLocked(send.deviceId, "Failed to send OSC message");
+                    }
+                    next = end;
+                }
+            }
+            latest.clear();
+            latestIndex.clear();
+        };
+        
+        for (const auto& message : messages) {
+            if (message.sourceChannelId < 0 || isAudioDeviceId(message.deviceId)) {
+                individual.push_back(&message);
+                continue;
+            }
+            auto* channel = mixerState_.getChannel(message.sourceChannelId);
+            if (!channel || channel->state != ChannelState::RUNNING || !shouldChannelBeAudible(message.sourceChannelId)) {
+                continue;
+            }
+            auto senderIt = oscSenders_.find(message.deviceId);
+            if (senderIt == oscSenders_.end()) {
+                continue;
+            }
+            OSCNetworkReactor::EndpointId target = senderIt->second->getEndpoint();
+            // A stream sender numbers its own bundles, so it cannot share a fanned-out packet
+            if (!target || senderIt->second->isStreamMode()) {
+                individual.push_back(&message);
+                continue;
+            }
+            
+            queueWaitHistogram_.record(std::chrono::duration_cast<std::chrono::nanoseconds>(dequeued - message.timestamp));
+            if (message.traceId) {
+                tracer.recordSpan(message.traceId, "queue_wait", message.timestamp, dequeued, message.sourceChannelId);
+            }
+            float value = message.floatValues.empty() ? 0.0f : message.floatValues[0];
+            std::string key(reinterpret_cast<const char*>(&target), sizeof(target));
+            key += message.address;
+            auto found = latestIndex.find(key);
+            auto pressure = backpressured.find(target);
+            if (pressure == backpressured.end()) {
+                pressure = backpressured.emplace(target, OSCNetworkReactor::shared().isBackpressured(target)).first;
+            }
+            if (found != latestIndex.end() && !coalesce && !pressure->second) {
+                sendSegment();
+                found = latestIndex.end();
+            }
+            if (found == latestIndex.end()) {
+                found = latestIndex.emplace(std::move(key), latest.size()).first;
+                latest.push_back({&message, value, target, {}});
+            }
+            Latest& entry = latest[found->second];
+            entry.message = &message;
+            entry.value = value;
+            entry.messages.push_back(&message);
+        }
+        
+        sendSegment();
+    }
+    
+    for (const OSCMessage* message : individual) {
+        try {
+            if (message->sourceChannelId >= 0) {
+                routeOutputMessage(*message);
+            } else {
+                routeInputMessage(*message);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error processing OSC message: " << e.what() << std::endl;
+            handleDeviceError(message->deviceId, e.what());
+        }
+    }
+}
+
+void OSCMixerEngine::onSendResult(const OSCNetworkReactor::SendResult& result) {
+    // Reactor thread: never takes deviceMutex_, which is held while senders close
+    std::lock_guard<std::mutex> lock(sendResultsMutex_);
+    auto it = inFlightSends_.find(result.tag);
+    if (it == inFlightSends_.end()) {
+        return;
+    }
+    auto& records = it->second;
+    auto& tracer = LatencyTracer::getInstance();
+    for (size_t i = 0; i < records.size();) {
+        InFlightSend& send = records[i];
+        if (send.target != result.target) {
+            ++i;
+            continue;
+        }
+        if (result.error == 0) {
+            performanceMonitor_.recordStageLatency(PerformanceMonitor::LatencyStage::EnqueueToSend,
+                                                   result.completed - send.queued);
+            if (send.traceId) {
+                tracer.recordSpan(send.traceId, "reactor_send", result.submitted, result.completed, send.channelId);
+            }
+        }
+        sendOutcomes_.push_back({std::move(send.deviceId), send.channelId, result.error, result.completed});
+        if (i + 1 < records.size()) {
+            send = std::move(records.back());
+        }
+        records.pop_back();
+    }
+    if (records.empty()) {
+        inFlightSends_.erase(it);
+    }
+}
+
+void OSCMixerEngine::applySendResults() {
+    // Sends the reactor never reports (its target was closed or retargeted) are dropped after this
+    constexpr auto kInFlightTimeout = std::chrono::seconds(2);
+    
+    std::vector<SendOutcome> outcomes;
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(sendResultsMutex_);
+        outcomes.swap(sendOutcomes_);
+        if (now - lastInFlightSweep_ > kInFlightTimeout) {
+            lastInFlightSweep_ = now;
+            for (auto it = inFlightSends_.begin(); it != inFlightSends_.end();) {
+                if (!it->second.empty() && now - it->second.front().queued > kInFlightTimeout) {
+                    it = inFlightSends_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+    if (outcomes.empty()) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(deviceMutex_);
+    for (const auto& outcome : outcomes) {
+        auto* channel = mixerState_.getChannel(outcome.channelId);
+        if (outcome.error == 0) {
+            StartupProfiler::getInstance().markFirstPacket();
+            if (channel) channel->messagesSent++;
+            auto status = deviceStatuses_.find(outcome.deviceId);
+            if (status != deviceStatuses_.end()) {
+                status->second.messageCount++;
+                status->second.lastActivity = outcome.completed;
+            }
+        } else {
+            if (channel) channel->errors++;
+            handleDeviceErrorLocked(outcome.deviceId, std::string("Failed to send OSC message: ") +
+                                                          std::strerror(outcome.error));
         }
     }
 }
@@ -1635,12 +2448,16 @@ bool OSCMixerEngine::shouldChannelBeAudible(int channelId) const {
 
 void OSCMixerEngine::handleDeviceError(const std::string& deviceId, const std::string& error) {
     std::lock_guard<std::mutex> lock(deviceMutex_);
-    
+    handleDeviceErrorLocked(deviceId, error);
+}
+
+void OSCMixerEngine::handleDeviceErrorLocked(const std::string& deviceId, const std::string& error) {
     auto it = deviceStatuses_.find(deviceId);
     if (it != deviceStatuses_.end()) {
         it->second.status = DeviceConnectionStatus::ERROR;
         it->second.lastError = error;
         it->second.lastActivity = std::chrono::steady_clock::now();
+        it->second.sendFailures++;
     }
     
     mixerState_.totalErrors++;
@@ -1666,6 +2483,9 @@ nlohmann::json OSCMixerEngine::serializeDeviceConfig(const OSCDeviceConfig& conf
     deviceJson["oscMessage"] = config.oscMessage;
     deviceJson["signalLevel"] = config.signalLevel;
     deviceJson["enabled"] = config.enabled;
+    deviceJson["useSequencedStream"] = config.useSequencedStream;
+    deviceJson["streamRedundancy"] = config.streamRedundancy;
+    deviceJson["parityGroup"] = config.parityGroup;
     
     deviceJson["supportedTypes"] = nlohmann::json::array();
     for (auto type : config.supportedTypes) {
@@ -1686,7 +2506,12 @@ OSCDeviceConfig OSCMixerEngine::deserializeDeviceConfig(const nlohmann::json& de
     if (deviceJson.contains("localAddress")) config.localAddress = deviceJson["localAddress"];
     if (deviceJson.contains("localPort")) config.localPort = deviceJson["localPort"];
     if (deviceJson.contains("oscAddress")) config.oscAddress = deviceJson["oscAddress"];
+    if (deviceJson.contains("oscMessage")) config.oscMessage = deviceJson["oscMessage"];
+    if (deviceJson.contains("signalLevel")) config.signalLevel = deviceJson["signalLevel"];
     if (deviceJson.contains("enabled")) config.enabled = deviceJson["enabled"];
+    if (deviceJson.contains("useSequencedStream")) config.useSequencedStream = deviceJson["useSequencedStream"];
+    if (deviceJson.contains("streamRedundancy")) config.streamRedundancy = deviceJson["streamRedundancy"];
+    if (deviceJson.contains("parityGroup")) config.parityGroup = deviceJson["parityGroup"];
     
     if (deviceJson.contains("supportedTypes")) {
         config.supportedTypes.clear();
@@ -1832,6 +2657,23 @@ void OSCMixerEngine::setMasterMute(bool mute) {
     mixerState_.masterMute = mute;
 }
 
+void OSCMixerEngine::setOutputFanout(bool enabled) {
+    mixerState_.outputFanout = enabled;
+}
+
+void OSCMixerEngine::setOutputCoalesce(bool enabled) {
+    mixerState_.outputCoalesce = enabled;
+}
+
+void OSCMixerEngine::setOutputPacing(bool enabled, double maxPacketsPerSecond) {
+    std::lock_guard<std::mutex> lock(deviceMutex_);
+    outputPacing_ = enabled;
+    outputPacingRate_ = maxPacketsPerSecond;
+    for (auto& [deviceId, sender] : oscSenders_) {
+        sender->setPacing(enabled, maxPacketsPerSecond);
+    }
+}
+
 void OSCMixerEngine::setChannelSolo(int channelId, bool solo) {
     if (!isChannelIdValid(channelId)) return;
     
@@ -4,12 +4,21 @@
 #include "OSCSender.h"
 #include "OSCReceiver.h"
 #include "AudioDeviceIntegration.h"
+#include "LatencyHistogram.h"
+#include "MetricsExporter.h"
+#include "PerformanceMonitor.h"
+#include "ConfigDiff.h"
 #include <thread>
 #include <mutex>
 #include <queue>
 #include <condition_variable>
+#include <future>
 #include <unordered_map>
 
+class PluginInsertChain;
+
+class ConfigWatcher;
+
 class OSCMixerEngine {
 public:
     OSCMixerEngine();
@@ -44,8 +53,10 @@ public:
     void stopDeviceDiscovery();
     std::vector<std::string> getAvailableDevices() const;
     
-    // Audio Device Integration
+    // Audio Device Integration. PortAudio starts on a background thread in
+    // initialize(); these wait for it, OSC-only channels never do.
     void setAudioDeviceIntegration(std::shared_ptr<AudioDeviceIntegration> integration);
+    std::shared_ptr<AudioDeviceManager> getAudioDeviceManager();
     std::vector<OSCDeviceConfig> getAvailableInputDevices() const;
     std::vector<OSCDeviceConfig> getAvailableOutputDevices() const;
     
@@ -56,7 +67,7 @@ public:
     std::vector<DeviceStatus> getAllDeviceStatuses() const;
     
     // Message Processing
-    void sendOSCMessage(int channelId, const std::string& deviceId, float value);
+    void sendOSCMessage(int channelId, const std::string& deviceId, float value, uint64_t traceId = 0);
     void sendOSCMessage(int channelId, const std::string& deviceId, const OSCMessage& message);
     
     // Learning Mode for MIDI/OSC mapping
@@ -70,9 +81,35 @@ public:
     int getTotalActiveConnections() const;
     int getTotalErrors() const;
     
+    // Metrics export. Reads atomics and the per-device snapshot the engine
+    // thread publishes each second; never takes the device or queue locks.
+    struct DeviceMetrics {
+        std::string deviceId;
+        bool connected = false;
+        uint64_t messagesSent = 0;
+        uint64_t sendFailures = 0;
+    };
+    std::shared_ptr<const std::vector<DeviceMetrics>> getDeviceMetrics() const;
+    size_t getQueueDepth() const { return queueDepth_.load(std::memory_order_relaxed); }
+    void collectMetrics(MetricsWriter& out) const;
+    // Started from CVOSC_METRICS_PORT in initialize(); null when not serving
+    MetricsExporter* getMetricsExporter() { return metricsExporter_.get(); }
+    // Counters and stage latencies for the pipeline; CV readers and writers attach to it
+    PerformanceMonitor& getPerformanceMonitor() { return performanceMonitor_; }
+    // Plugin inserts for CV input channels; install on the CVReader, overruns report to the monitor above
+    std::shared_ptr<PluginInsertChain> getInsertChain() const { return insertChain_; }
+    
     // Configuration
     bool loadConfiguration(const std::string& filePath);
     bool saveConfiguration(const std::string& filePath);
+    // Re-reads filePath and applies only what differs from the running state:
+    // a changed destination retargets its sender, a changed range updates the
+    // channel, and channels and streams keep running throughout
+    bool reloadConfiguration(const std::string& filePath);
+    MixerConfigDiff applyConfiguration(const nlohmann::json& config);
+    // Hot-reloads filePath whenever it changes on disk
+    bool watchConfiguration(const std::string& filePath);
+    void stopWatchingConfiguration();
     
     // Additional mixer controls
     bool start();
@@ -81,6 +118,14 @@ public:
     void setSoloMode(bool solo);
     void setMasterVolume(float volume);
     void setMasterMute(bool mute);
+    void setOutputFanout(bool enabled);
+    bool isOutputFanoutEnabled() const { return mixerState_.outputFanout; }
+    // Only applies with fan-out: keep the latest value per output and address in a batch
+    void setOutputCoalesce(bool enabled);
+    bool isOutputCoalesceEnabled() const { return mixerState_.outputCoalesce; }
+    // Paces every OSC output target on the network reactor (fan-out included)
+    void setOutputPacing(bool enabled, double maxPacketsPerSecond = 2000.0);
+    bool isOutputPacingEnabled() const { return outputPacing_; }
     void setChannelSolo(int channelId, bool solo);
     void setChannelMute(int channelId, bool mute);
     float getChannelLevel(int channelId) const;
@@ -98,14 +143,43 @@ private:
     std::mutex stateMutex_;
     std::condition_variable stateCondition_;
     
+    // Sends queued on the network reactor. Its thread finishes the latency
+    // trace when sendto() returns and leaves the outcome for the engine thread
+    // (applySendResults), which owns the device counters. Declared before the
+    // senders, whose observers use it until they close.
+    struct InFlightSend {
+        std::string deviceId;
+        int channelId = -1;
+        uint64_t traceId = 0;
+        OSCNetworkReactor::EndpointId target = 0;
+        std::chrono::steady_clock::time_point queued;   // OSCMessage::timestamp
+    };
+    struct SendOutcome {
+        std::string deviceId;
+        int channelId = -1;
+        int error = 0;
+        std::chrono::steady_clock::time_point completed;
+    };
+    std::mutex sendResultsMutex_;
+    std::unordered_map<uint64_t, std::vector<InFlightSend>> inFlightSends_;   // By reactor tag
+    std::vector<SendOutcome> sendOutcomes_;
+    uint64_t nextSendTag_ = 1;                  // Engine thread
+    std::chrono::steady_clock::time_point lastInFlightSweep_;
+    void onSendResult(const OSCNetworkReactor::SendResult& result);   // Reactor thread
+    void applySendResults();
+    
     // OSC Communication
     std::unordered_map<std::string, std::unique_ptr<OSCSender>> oscSenders_;
+    std::atomic<bool> outputPacing_{false};     // Applied to senders as they are created
+    double outputPacingRate_ = 2000.0;          // deviceMutex_
     std::unordered_map<std::string, std::unique_ptr<OSCReceiver>> oscReceivers_;
     
     // Message Queue
     std::queue<OSCMessage> messageQueue_;
     std::mutex messageMutex_;
     std::condition_variable messageCondition_;
+    std::atomic<size_t> queueDepth_{0};
+    std::atomic<size_t> queueHighWater_{0};
     
     // Device Status Tracking
     std::unordered_map<std::string, DeviceStatus> deviceStatuses_;
@@ -113,6 +187,11 @@ private:
     
     // Audio Device Integration
     std::shared_ptr<AudioDeviceIntegration> audioDeviceIntegration_;
+    std::shared_ptr<AudioDeviceManager> audioDeviceManager_;
+    std::shared_future<void> audioInitDone_;
+    void waitForAudioInit() const;
+    bool channelUsesAudio(int channelId);
+    static bool isAudioDeviceId(const std::string& deviceId);
     
     // Learning Mode
     std::atomic<bool> learningMode_{false};
@@ -124,6 +203,15 @@ private:
     std::chrono::steady_clock::time_point lastStatsUpdate_;
     std::atomic<int> messagesThisSecond_{0};
     
+    // Metrics
+    LatencyHistogram queueWaitHistogram_;
+    LatencyHistogram sendHistogram_;
+    PerformanceMonitor performanceMonitor_;
+    std::shared_ptr<PluginInsertChain> insertChain_;
+    std::shared_ptr<const std::vector<DeviceMetrics>> deviceMetrics_;   // std::atomic_load / atomic_store
+    std::unique_ptr<MetricsExporter> metricsExporter_;
+    void publishDeviceMetrics();
+    
     // Core Engine Methods
     void engineLoop();
     void discoveryLoop();
@@ -139,6 +227,7 @@ private:
     // Message Routing
     void routeInputMessage(const OSCMessage& message);
     void routeOutputMessage(const OSCMessage& message);
+    void routeOutputBatch(const std::vector<OSCMessage>& messages);
     
     // Solo/Mix Logic
     void updateSoloMixLogic();
@@ -146,11 +235,16 @@ private:
     
     // Error Handling
     void handleDeviceError(const std::string& deviceId, const std::string& error);
+    void handleDeviceErrorLocked(const std::string& deviceId, const std::string& error);  // deviceMutex_ held
     void logError(const std::string& error);
     
     // Configuration Helpers
     nlohmann::json serializeDeviceConfig(const OSCDeviceConfig& config) const;
     OSCDeviceConfig deserializeDeviceConfig(const nlohmann::json& json) const;
+    MixerConfigSnapshot snapshotConfiguration() const;   // stateMutex_ held
+    MixerConfigSnapshot parseConfiguration(const nlohmann::json& config, MixerConfigSnapshot base) const;
+    void applyConfigurationDiff(const MixerConfigDiff& diff);
+    std::unique_ptr<ConfigWatcher> configWatcher_;
     
     // Validation
     bool validateDeviceConfig(const OSCDeviceConfig& config) const;
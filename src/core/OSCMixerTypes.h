@@ -7,6 +7,7 @@
 #include <atomic>
 #include <deque>
 #include <chrono>
+#include <cstdint>
 
 // OSC Protocol Types
 enum class OSCProtocolType {
@@ -68,6 +69,11 @@ struct OSCDeviceConfig {
     bool useTimeTag = false; // alternative naming
     bool useBundles = false;
     
+    // Sequence-numbered output stream, for outputs where a lost edge matters
+    bool useSequencedStream = false;
+    int streamRedundancy = 0; // 0 = none, 1 = send twice, 2 = XOR parity
+    int parityGroup = 4; // Bundles per parity packet
+    
     // Audio device integration
     int audioDeviceIndex = -1; // PortAudio device index for real audio devices
     
@@ -263,6 +269,11 @@ struct MasterMixerState {
     // Global settings
     float masterLevel = 1.0f;
     bool masterMute = false;
+    // Encode each OSC payload once and send it to every unicast output that shares it
+    std::atomic<bool> outputFanout{false};
+    // Opt-in: a fan-out batch sends only the latest value per output and address,
+    // dropping the values (and edges) it superseded. Off sends every value in order.
+    std::atomic<bool> outputCoalesce{false};
     
     // Performance monitoring
     std::atomic<int> totalMessagesPerSecond{0};
@@ -350,6 +361,7 @@ struct OSCMessage {
     int sourceChannelId;
     int targetChannelId;
     std::string deviceId;
+    uint64_t traceId = 0;   // LatencyTracer id of the source block, 0 if unsampled
 };
 
 // Device Connection Status
@@ -368,6 +380,7 @@ struct DeviceStatus {
     std::chrono::steady_clock::time_point lastActivity;
     int messageCount = 0;
     float latencyMs = 0.0f;
+    int sendFailures = 0;
     
     // Status query methods
     bool isConnected() const {
@@ -4,19 +4,7 @@
 #include <iomanip>
 #include <algorithm>
 
-#ifdef __APPLE__
-#include <mach/mach.h>
-#include <sys/sysctl.h>
-#include <mach/host_info.h>
-#include <mach/mach_host.h>
-#include <mach/task_info.h>
-#include <mach/task.h>
-#elif __linux__
-#include <unistd.h>
-#include <sys/resource.h>
-#include <fstream>
-#include <sstream>
-#elif _WIN32
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #include <pdh.h>
@@ -29,6 +17,9 @@
 PerformanceMonitor::PerformanceMonitor() {
     startTime = std::chrono::steady_clock::now();
     lastCycleTime = startTime;
+    for (auto& histogram : stageHistograms) {
+        histogram = std::make_unique<LatencyHistogram>();
+    }
 }
 
 PerformanceMonitor::~PerformanceMonitor() {
@@ -38,6 +29,7 @@ PerformanceMonitor::~PerformanceMonitor() {
 void PerformanceMonitor::setConfig(const MonitorConfig& cfg) {
     std::lock_guard<std::mutex> lock(metricsMutex);
     config = cfg;
+    ResourceSampler::getInstance().enableHardwareCounters(config.enableHardwareCounters);
     
     if (config.logToFile && !logFile) {
         openLogFile();
@@ -118,22 +110,21 @@ void PerformanceMonitor::recordCycleStart() {
 
 void PerformanceMonitor::recordCycleEnd() {
     auto now = std::chrono::steady_clock::now();
-    auto cycleDuration = now - lastCycleTime;
-    (void)cycleDuration; // Suppress unused variable warning
+    auto cycleDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastCycleTime);
+    lastCycleTimeNs.store(cycleDuration.count(), std::memory_order_relaxed);
     
     cycleCounter++;
     lastCycleTime = now;
 }
 
 void PerformanceMonitor::recordProcessingTime(std::chrono::nanoseconds duration) {
-    (void)duration; // Suppress unused parameter warning
-    // This will be used by the monitoring loop to calculate averages
-    // For now, we'll store the latest value
+    lastProcessingTimeNs.store(duration.count(), std::memory_order_relaxed);
 }
 
 void PerformanceMonitor::recordNetworkLatency(std::chrono::nanoseconds latency) {
-    (void)latency; // Suppress unused parameter warning
-    // Similar to processing time
+    // Network latency is measured send -> acknowledgement
+    lastNetworkLatencyNs.store(latency.count(), std::memory_order_relaxed);
+    recordStageLatency(LatencyStage::SendToAck, latency);
 }
 
 void PerformanceMonitor::recordOSCMessageSent() {
@@ -191,6 +182,65 @@ void PerformanceMonitor::recordBufferUnderrun() {
     bufferUnderrunsCounter++;
 }
 
+void PerformanceMonitor::recordStageLatency(LatencyStage stage, std::chrono::nanoseconds latency) {
+    size_t index = static_cast<size_t>(stage);
+    if (index < stageHistograms.size()) {
+        stageHistograms[index]->record(latency);
+    }
+}
+
+PerformanceMonitor::LatencySummary PerformanceMonitor::getStageLatency(LatencyStage stage) const {
+    LatencySummary summary;
+    auto histogram = getStageHistogram(stage);
+    summary.count = histogram.count;
+    summary.mean = histogram.mean();
+    summary.p50 = histogram.percentile(50.0);
+    summary.p90 = histogram.percentile(90.0);
+    summary.p99 = histogram.percentile(99.0);
+    summary.p999 = histogram.percentile(99.9);
+    summary.max = histogram.max;
+    return summary;
+}
+
+LatencyHistogram::Snapshot PerformanceMonitor::getStageHistogram(LatencyStage stage) const {
+    size_t index = static_cast<size_t>(stage);
+    if (index >= stageHistograms.size()) {
+        return LatencyHistogram::Snapshot();
+    }
+    return stageHistograms[index]->snapshot();
+}
+
+PerformanceMonitor::CounterSnapshot PerformanceMonitor::getCounters() const {
+    CounterSnapshot counters;
+    counters.cycles = cycleCounter.load(std::memory_order_relaxed);
+    counters.oscSent = oscSentCounter.load(std::memory_order_relaxed);
+    counters.oscFailed = oscFailedCounter.load(std::memory_order_relaxed);
+    counters.droppedSamples = droppedSamplesCounter.load(std::memory_order_relaxed);
+    counters.bufferUnderruns = bufferUnderrunsCounter.load(std::memory_order_relaxed);
+    return counters;
+}
+
+void PerformanceMonitor::resetStageLatencies() {
+    for (auto& histogram : stageHistograms) {
+        histogram->reset();
+    }
+}
+
+std::vector<ResourceSampler::ThreadSample> PerformanceMonitor::getThreadUsage() const {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    return threadUsage;
+}
+
+const char* PerformanceMonitor::getStageName(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::CaptureToProcess: return "capture_to_process";
+        case LatencyStage::ProcessToEnqueue: return "process_to_enqueue";
+        case LatencyStage::EnqueueToSend: return "enqueue_to_send";
+        case LatencyStage::SendToAck: return "send_to_ack";
+        default: return "unknown";
+    }
+}
+
 PerformanceMetrics PerformanceMonitor::getCurrentMetrics() const {
     return calculateCurrentMetrics();
 }
@@ -302,6 +352,14 @@ void PerformanceMonitor::clearAlerts() {
     activeAlerts.clear();
 }
 
+void PerformanceMonitor::reportAlert(PerformanceAlert::Severity severity, PerformanceAlert::Category category,
+                                     const std::string& message, double value, double threshold) {
+    // Entry point for subsystems that detect their own problems (e.g. plugin CPU overruns)
+    if (config.enableAlerts) {
+        triggerAlert(severity, category, message, value, threshold);
+    }
+}
+
 void PerformanceMonitor::addMetricsCallback(std::function<void(const PerformanceMetrics&)> callback) {
     metricsCallbacks.push_back(callback);
 }
@@ -341,6 +399,43 @@ std::string PerformanceMonitor::generateReport() const {
     report << "  Average Efficiency: " << std::fixed << std::setprecision(1) << (stats.avgEfficiency * 100) << "%\n";
     report << "  Minimum Efficiency: " << std::fixed << std::setprecision(1) << (stats.minEfficiency * 100) << "%\n\n";
     
+    // CPU attribution per registered thread
+    auto threads = getThreadUsage();
+    if (!threads.empty()) {
+        report << "Thread CPU:\n";
+        for (const auto& thread : threads) {
+            report << "  " << std::left << std::setw(24) << thread.name << std::right
+                   << std::fixed << std::setprecision(1) << std::setw(7) << thread.cpuPercent << "%";
+            if (thread.cycles >= 0) {
+                report << "  cycles " << thread.cycles;
+            }
+            if (thread.cacheMisses >= 0) {
+                report << "  cache misses " << thread.cacheMisses;
+            }
+            if (thread.contextSwitches >= 0) {
+                report << "  context switches " << thread.contextSwitches;
+            }
+            report << (thread.alive ? "" : "  (exited)") << "\n";
+        }
+        report << "\n";
+    }
+    
+    // Tail latency per pipeline stage
+    report << "Latency Percentiles (us):\n";
+    report << "  " << std::left << std::setw(20) << "Stage" << std::right
+           << std::setw(10) << "Count" << std::setw(10) << "p50" << std::setw(10) << "p90"
+           << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "Max" << "\n";
+    for (size_t i = 0; i < static_cast<size_t>(LatencyStage::Count); i++) {
+        auto stage = static_cast<LatencyStage>(i);
+        auto latency = getStageLatency(stage);
+        report << "  " << std::left << std::setw(20) << getStageName(stage) << std::right
+               << std::setw(10) << latency.count << std::fixed << std::setprecision(1)
+               << std::setw(10) << latency.p50 / 1000.0 << std::setw(10) << latency.p90 / 1000.0
+               << std::setw(10) << latency.p99 / 1000.0 << std::setw(10) << latency.p999 / 1000.0
+               << std::setw(10) << latency.max / 1000.0 << "\n";
+    }
+    report << "\n";
+    
     // Active alerts
     auto alerts = getActiveAlerts();
     if (!alerts.empty()) {
@@ -355,13 +450,97 @@ std::string PerformanceMonitor::generateReport() const {
     return report.str();
 }
 
+nlohmann::json PerformanceMonitor::exportMetricsAsJson() const {
+    auto metrics = getCurrentMetrics();
+    auto stats = getStatistics();
+    nlohmann::json result;
+    
+    result["timestamp"] = formatTimestamp(metrics.timestamp);
+    result["current"] = {
+        {"cpu_usage", metrics.cpuUsage},
+        {"process_cpu_usage", metrics.processCpuUsage},
+        {"memory_mb", metrics.memoryUsage},
+        {"system_load", metrics.systemLoad},
+        {"processing_time_ns", metrics.processingTime.count()},
+        {"network_latency_ns", metrics.networkLatency.count()},
+        {"cycle_time_ns", metrics.totalCycleTime.count()},
+        {"efficiency", metrics.efficiency},
+        {"osc_sent", metrics.oscMessagesSent},
+        {"osc_failed", metrics.oscMessagesFailed},
+        {"packet_loss_rate", metrics.packetLossRate},
+        {"dropped_samples", metrics.droppedSamples},
+        {"buffer_underruns", metrics.bufferUnderruns}
+    };
+    result["statistics"] = {
+        {"avg_cpu_usage", stats.avgCpuUsage},
+        {"max_cpu_usage", stats.maxCpuUsage},
+        {"avg_memory_mb", stats.avgMemoryUsage},
+        {"max_memory_mb", stats.maxMemoryUsage},
+        {"total_cycles", stats.totalCycles},
+        {"uptime_minutes", stats.uptime.count()}
+    };
+    
+    nlohmann::json latency = nlohmann::json::object();
+    for (size_t i = 0; i < static_cast<size_t>(LatencyStage::Count); i++) {
+        auto stage = static_cast<LatencyStage>(i);
+        auto summary = getStageLatency(stage);
+        latency[getStageName(stage)] = {
+            {"count", summary.count},
+            {"mean_ns", summary.mean},
+            {"p50_ns", summary.p50},
+            {"p90_ns", summary.p90},
+            {"p99_ns", summary.p99},
+            {"p999_ns", summary.p999},
+            {"max_ns", summary.max}
+        };
+    }
+    result["latency"] = latency;
+    
+    nlohmann::json threads = nlohmann::json::array();
+    for (const auto& thread : getThreadUsage()) {
+        nlohmann::json entry = {
+            {"name", thread.name},
+            {"thread_id", thread.threadId},
+            {"cpu_percent", thread.cpuPercent},
+            {"cpu_time_ns", thread.cpuTimeNs},
+            {"alive", thread.alive}
+        };
+        if (thread.cycles >= 0) entry["cycles"] = thread.cycles;
+        if (thread.cacheMisses >= 0) entry["cache_misses"] = thread.cacheMisses;
+        if (thread.contextSwitches >= 0) entry["context_switches"] = thread.contextSwitches;
+        threads.push_back(entry);
+    }
+    result["threads"] = threads;
+    
+    nlohmann::json alerts = nlohmann::json::array();
+    for (const auto& alert : getActiveAlerts()) {
+        alerts.push_back({
+            {"severity", alert.severity == PerformanceAlert::Severity::Critical ? "critical" :
+                         alert.severity == PerformanceAlert::Severity::Warning ? "warning" : "info"},
+            {"message", alert.message},
+            {"value", alert.value},
+            {"threshold", alert.threshold}
+        });
+    }
+    result["alerts"] = alerts;
+    
+    return result;
+}
+
 void PerformanceMonitor::monitoringLoop() {
+    ScopedThreadRegistration registration("PerformanceMonitor");
+    
     while (monitoring.load()) {
+        // Per-thread and process CPU since the previous pass
+        auto usage = ResourceSampler::getInstance().sample();
+        lastProcessCpuUsage.store(usage.processCpuPercent);
+        
         auto metrics = calculateCurrentMetrics();
         
         // Store metrics
         {
             std::lock_guard<std::mutex> lock(metricsMutex);
+            threadUsage = std::move(usage.threads);
             metricsHistory.push_back(metrics);
             
             // Trim history if needed
@@ -400,6 +579,12 @@ PerformanceMetrics PerformanceMonitor::calculateCurrentMetrics() const {
     metrics.cpuUsage = getCPUUsageImpl();
     metrics.memoryUsage = getMemoryUsageImpl();
     metrics.systemLoad = getSystemLoadImpl();
+    metrics.processCpuUsage = lastProcessCpuUsage.load();
+    
+    // Latest timing samples
+    metrics.processingTime = std::chrono::nanoseconds(lastProcessingTimeNs.load(std::memory_order_relaxed));
+    metrics.networkLatency = std::chrono::nanoseconds(lastNetworkLatencyNs.load(std::memory_order_relaxed));
+    metrics.totalCycleTime = std::chrono::nanoseconds(lastCycleTimeNs.load(std::memory_order_relaxed));
     
     // Calculate rates
     auto now = std::chrono::steady_clock::now();
@@ -562,114 +747,18 @@ std::string PerformanceMonitor::formatTimestamp(std::chrono::system_clock::time_
 }
 
 // Platform-specific implementations
-#ifdef __APPLE__
+#if defined(__APPLE__) || defined(__linux__)
+// Counters and persistent descriptors live in ResourceSampler; nothing is parsed per call
 double PerformanceMonitor::getCPUUsageImpl() const {
-    host_cpu_load_info_data_t cpuinfo;
-    mach_msg_type_number_t count = HOST_CPU_LOAD_INFO_COUNT;
-    
-    if (host_statistics(mach_host_self(), HOST_CPU_LOAD_INFO, 
-                       (host_info_t)&cpuinfo, &count) == KERN_SUCCESS) {
-        
-        static unsigned int lastTotalTicks = 0;
-        static unsigned int lastIdleTicks = 0;
-        
-        unsigned int totalTicks = cpuinfo.cpu_ticks[CPU_STATE_USER] + 
-                                 cpuinfo.cpu_ticks[CPU_STATE_SYSTEM] + 
-                                 cpuinfo.cpu_ticks[CPU_STATE_IDLE] + 
-                                 cpuinfo.cpu_ticks[CPU_STATE_NICE];
-        
-        unsigned int idleTicks = cpuinfo.cpu_ticks[CPU_STATE_IDLE];
-        
-        unsigned int totalTicksSinceLastTime = totalTicks - lastTotalTicks;
-        unsigned int idleTicksSinceLastTime = idleTicks - lastIdleTicks;
-        
-        lastTotalTicks = totalTicks;
-        lastIdleTicks = idleTicks;
-        
-        if (totalTicksSinceLastTime > 0) {
-            double usage = 100.0 * (1.0 - (double)idleTicksSinceLastTime / totalTicksSinceLastTime);
-            return std::max(0.0, std::min(100.0, usage));
-        }
-    }
-    
-    return 0.0;
+    return ResourceSampler::getInstance().getSystemCpuUsage();
 }
 
 size_t PerformanceMonitor::getMemoryUsageImpl() const {
-    struct task_basic_info info;
-    mach_msg_type_number_t size = sizeof(info);
-    
-    if (task_info(mach_task_self(), TASK_BASIC_INFO, (task_info_t)&info, &size) == KERN_SUCCESS) {
-        return info.resident_size / (1024 * 1024); // Convert to MB
-    }
-    
-    return 0;
+    return ResourceSampler::getInstance().getResidentMemoryMB();
 }
 
 double PerformanceMonitor::getSystemLoadImpl() const {
-    double loadavg[3];
-    if (getloadavg(loadavg, 3) != -1) {
-        return loadavg[0]; // 1-minute load average
-    }
-    return 0.0;
-}
-
-#elif __linux__
-double PerformanceMonitor::getCPUUsageImpl() const {
-    std::ifstream file("/proc/stat");
-    if (!file.is_open()) return 0.0;
-    
-    std::string line;
-    std::getline(file, line);
-    
-    std::istringstream ss(line);
-    std::string cpu;
-    long user, nice, system, idle, iowait, irq, softirq, steal;
-    
-    ss >> cpu >> user >> nice >> system >> idle >> iowait >> irq >> softirq >> steal;
-    
-    static long lastIdle = 0, lastTotal = 0;
-    
-    long totalIdle = idle + iowait;
-    long total = user + nice + system + idle + iowait + irq + softirq + steal;
-    
-    long totald = total - lastTotal;
-    long idled = totalIdle - lastIdle;
-    
-    lastTotal = total;
-    lastIdle = totalIdle;
-    
-    if (totald > 0) {
-        return 100.0 * (1.0 - (double)idled / totald);
-    }
-    
-    return 0.0;
-}
-
-size_t PerformanceMonitor::getMemoryUsageImpl() const {
-    std::ifstream file("/proc/self/status");
-    if (!file.is_open()) return 0;
-    
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.substr(0, 6) == "VmRSS:") {
-            std::istringstream ss(line.substr(6));
-            size_t memory_kb;
-            ss >> memory_kb;
-            return memory_kb / 1024; // Convert to MB
-        }
-    }
-    
-    return 0;
-}
-
-double PerformanceMonitor::getSystemLoadImpl() const {
-    std::ifstream file("/proc/loadavg");
-    if (!file.is_open()) return 0.0;
-    
-    double load;
-    file >> load;
-    return load;
+    return ResourceSampler::getInstance().getLoadAverage();
 }
 
 #elif _WIN32
@@ -766,6 +855,19 @@ double PerformanceMonitor::getSystemLoadImpl() const { return 0.0; }
 #endif
 
 // Static methods
+#if defined(__APPLE__) || defined(__linux__)
+double PerformanceMonitor::getCurrentCPUUsage() {
+    return ResourceSampler::getInstance().getSystemCpuUsage();
+}
+
+size_t PerformanceMonitor::getCurrentMemoryUsage() {
+    return ResourceSampler::getInstance().getResidentMemoryMB();
+}
+
+double PerformanceMonitor::getSystemLoad() {
+    return ResourceSampler::getInstance().getLoadAverage();
+}
+#else
 double PerformanceMonitor::getCurrentCPUUsage() {
     PerformanceMonitor monitor;
     return monitor.getCPUUsageImpl();
@@ -780,6 +882,7 @@ double PerformanceMonitor::getSystemLoad() {
     PerformanceMonitor monitor;
     return monitor.getSystemLoadImpl();
 }
+#endif
 
 double PerformanceMonitor::getCPUTemperature() {
     // Platform-specific temperature reading would go here
@@ -11,8 +11,12 @@
 #include <thread>
 #include <functional>
 #include <deque>
+#include <array>
 #include <nlohmann/json.hpp>
 
+#include "LatencyHistogram.h"
+#include "ResourceSampler.h"
+
 struct PerformanceMetrics {
     // Timing metrics
     std::chrono::nanoseconds processingTime{0};
@@ -25,7 +29,8 @@ struct PerformanceMetrics {
     double efficiency = 0.0; // actualUpdateRate / expectedUpdateRate
     
     // Resource usage
-    double cpuUsage = 0.0;
+    double cpuUsage = 0.0;          // Whole machine
+    double processCpuUsage = 0.0;   // This process, percent of one core
     size_t memoryUsage = 0;
     size_t peakMemoryUsage = 0;
     
@@ -78,6 +83,7 @@ public:
         bool enableAlerts = true;
         bool logToFile = false;
         std::string logFileName = "performance.log";
+        bool enableHardwareCounters = false; // perf_event cycles / cache misses / context switches (Linux)
         
         // Thresholds for alerts
         double cpuThresholdWarning = 70.0;
@@ -94,6 +100,35 @@ public:
         std::chrono::seconds oscWarningSuppressDuration{30}; // Suppress for 30 seconds
     };
 
+    // Pipeline stages with their own latency histogram
+    enum class LatencyStage {
+        CaptureToProcess,   // ADC time of the block -> filtered value available
+        ProcessToEnqueue,   // value available -> OSC message queued
+        EnqueueToSend,      // queued -> sendto() returned on the network reactor thread
+        SendToAck,          // sent -> acknowledged (round trips the receiver reports back)
+        Count
+    };
+
+    // Percentiles in nanoseconds
+    struct LatencySummary {
+        uint64_t count = 0;
+        double mean = 0.0;
+        uint64_t p50 = 0;
+        uint64_t p90 = 0;
+        uint64_t p99 = 0;
+        uint64_t p999 = 0;
+        uint64_t max = 0;
+    };
+
+    // Raw running totals
+    struct CounterSnapshot {
+        uint64_t cycles = 0;
+        uint64_t oscSent = 0;
+        uint64_t oscFailed = 0;
+        uint64_t droppedSamples = 0;
+        uint64_t bufferUnderruns = 0;
+    };
+
 private:
     MonitorConfig config;
     
@@ -113,6 +148,16 @@ private:
     std::atomic<uint64_t> droppedSamplesCounter{0};
     std::atomic<uint64_t> bufferUnderrunsCounter{0};
     
+    // Latest single samples, and the full distributions per stage
+    std::atomic<int64_t> lastProcessingTimeNs{0};
+    std::atomic<int64_t> lastNetworkLatencyNs{0};
+    std::atomic<int64_t> lastCycleTimeNs{0};
+    std::array<std::unique_ptr<LatencyHistogram>, static_cast<size_t>(LatencyStage::Count)> stageHistograms;
+    
+    // Per-thread CPU from the last monitoring pass
+    std::vector<ResourceSampler::ThreadSample> threadUsage;
+    std::atomic<double> lastProcessCpuUsage{0.0};
+    
     // OSC warning suppression
     std::chrono::steady_clock::time_point lastOSCWarningTime;
     std::atomic<bool> oscWarningsCurrentlySuppressed{false};
@@ -154,6 +199,20 @@ public:
     void recordOSCMessageFailed();
     void recordDroppedSamples(int count);
     void recordBufferUnderrun();
+    // Any thread, real-time safe
+    void recordStageLatency(LatencyStage stage, std::chrono::nanoseconds latency);
+    
+    // Latency distributions, merged across threads on read
+    LatencySummary getStageLatency(LatencyStage stage) const;
+    LatencyHistogram::Snapshot getStageHistogram(LatencyStage stage) const;
+    void resetStageLatencies();
+    static const char* getStageName(LatencyStage stage);
+    
+    // Lock-free; safe to call from a metrics scrape
+    CounterSnapshot getCounters() const;
+    
+    // CPU attribution for threads registered with ResourceSampler, as of the last update
+    std::vector<ResourceSampler::ThreadSample> getThreadUsage() const;
     
     // Metrics retrieval
     PerformanceMetrics getCurrentMetrics() const;
@@ -182,6 +241,8 @@ public:
     // Alerts
     std::vector<PerformanceAlert> getActiveAlerts() const;
     void clearAlerts();
+    void reportAlert(PerformanceAlert::Severity severity, PerformanceAlert::Category category,
+                     const std::string& message, double value = 0.0, double threshold = 0.0);
     void setAlertThresholds(double cpuWarning, double cpuCritical, 
                            double memoryWarning, double memoryCritical,
                            double latencyWarning, double latencyCritical);
@@ -1,8 +1,14 @@
 #include "RealAudioStream.h"
+#include "LatencyTracer.h"
+#include "ResourceSampler.h"
+#include "TraceLog.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
 
+std::atomic<uint64_t> RealAudioStream::droppedSamples_{0};
+std::atomic<uint64_t> RealAudioStream::bufferUnderruns_{0};
+
 // RealAudioStream implementation
 RealAudioStream::RealAudioStream() 
     : stream_(nullptr)
@@ -10,10 +16,7 @@ RealAudioStream::RealAudioStream()
     , currentInputLevel_(0.0f)
     , deviceIndex_(-1)
     , numChannels_(1)
-    , sampleRate_(44100.0)
-    , audioBuffer_(BUFFER_SIZE)
-    , writePosition_(0)
-    , readPosition_(0) {
+    , sampleRate_(44100.0) {
 }
 
 RealAudioStream::~RealAudioStream() {
@@ -75,6 +78,10 @@ bool RealAudioStream::startOutputStream(int deviceIndex, int channels, double sa
     numChannels_ = channels;
     sampleRate_ = sampleRate;
     
+    ControlRateRing::Config ringConfig = outputConfig_;
+    ringConfig.sampleRate = sampleRate;
+    outputRing_ = std::make_unique<ControlRateRing>(ringConfig);
+    
     PaStreamParameters outputParameters;
     outputParameters.device = deviceIndex;
     outputParameters.channelCount = channels;
@@ -181,13 +188,29 @@ float RealAudioStream::getCurrentInputLevel() const {
 }
 
 void RealAudioStream::setLevelCallback(std::function<void(float)> callback) {
-    std::lock_guard<std::mutex> lock(callbackMutex_);
-    levelCallback_ = callback;
+    // The audio thread reads it without a lock
+    if (isRunning_) {
+        std::cerr << "RealAudioStream: level callback must be set before the stream starts" << std::endl;
+        return;
+    }
+    levelCallback_ = std::move(callback);
 }
 
 void RealAudioStream::sendAudioData(float level) {
-    // Store level for output processing
-    currentInputLevel_ = level;
+    pendingLevel_ = level;
+    hasPendingLevel_ = true;
+}
+
+void RealAudioStream::flushAudioData() {
+    // Overflows are counted by the ring
+    if (hasPendingLevel_ && outputRing_) {
+        outputRing_->push(pendingLevel_);
+    }
+    hasPendingLevel_ = false;
+}
+
+ControlRateRing::Stats RealAudioStream::getOutputStats() const {
+    return outputRing_ ? outputRing_->getStats() : ControlRateRing::Stats();
 }
 
 int RealAudioStream::audioCallback(const void* inputBuffer, void* outputBuffer,
@@ -196,9 +219,10 @@ int RealAudioStream::audioCallback(const void* inputBuffer, void* outputBuffer,
                                  PaStreamCallbackFlags statusFlags,
                                  void* userData) {
     RealAudioStream* stream = static_cast<RealAudioStream*>(userData);
+    recordStatusFlags(statusFlags, framesPerBuffer);
     
     if (inputBuffer) {
-        return stream->processInputAudio(static_cast<const float*>(inputBuffer), framesPerBuffer);
+        return stream->processInputAudio(static_cast<const float*>(inputBuffer), framesPerBuffer, timeInfo);
     } else if (outputBuffer) {
         return stream->processOutputAudio(static_cast<float*>(outputBuffer), framesPerBuffer);
     }
@@ -206,14 +230,37 @@ int RealAudioStream::audioCallback(const void* inputBuffer, void* outputBuffer,
     return paContinue;
 }
 
-int RealAudioStream::processInputAudio(const float* input, unsigned long frameCount) {
+void RealAudioStream::recordStatusFlags(PaStreamCallbackFlags statusFlags, unsigned long frameCount) {
+    // PortAudio does not say how much input it discarded; count the block as lost
+    if (statusFlags & paInputOverflow) {
+        droppedSamples_.fetch_add(frameCount, std::memory_order_relaxed);
+    }
+    if (statusFlags & paOutputUnderflow) {
+        bufferUnderruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+int RealAudioStream::processInputAudio(const float* input, unsigned long frameCount,
+                                       const PaStreamCallbackTimeInfo* timeInfo) {
+    // Per-thread CPU attribution (no-op after the first callback on this thread)
+    ResourceSampler::getInstance().registerCurrentThread("RealAudioStream audio");
+    
+    // Sampled latency tracing: ADC time of the block, then level detection
+    auto& tracer = LatencyTracer::getInstance();
+    const uint64_t traceId = tracer.beginTrace();
+    auto callbackStart = LatencyTracer::Clock::now();
+    if (traceId) {
+        tracer.setThreadName("RealAudioStream audio");
+        auto captured = timeInfo ? LatencyTracer::fromStreamTime(timeInfo->inputBufferAdcTime,
+                                                                 timeInfo->currentTime, callbackStart)
+                                 : callbackStart;
+        tracer.recordSpan(traceId, "adc_capture", captured, callbackStart);
+    }
+    
     // Calculate RMS and peak levels
     float sum = 0.0f;
     float peak = 0.0f;
     
-    // Store audio in circular buffer for passthrough
-    size_t writePos = writePosition_.load();
-    
     for (unsigned long i = 0; i < frameCount * numChannels_; i += numChannels_) {
         // Mix down to mono if multichannel
         float sample = 0.0f;
@@ -222,28 +269,12 @@ int RealAudioStream::processInputAudio(const float* input, unsigned long frameCo
         }
         sample /= numChannels_;
         
-        // Store in circular buffer
-        audioBuffer_[writePos] = sample;
-        writePos = (writePos + 1) % BUFFER_SIZE;
-        
         sum += sample * sample;
         peak = std::max(peak, std::abs(sample));
     }
     
-    // Update write position
-    writePosition_.store(writePos);
-    
     float rms = std::sqrt(sum / frameCount);
     
-    // Debug logging
-    static int callCount = 0;
-    callCount++;
-    if (callCount % 100 == 0) {
-        std::cout << "[RealAudioStream] Input #" << callCount 
-                  << ": RMS=" << rms 
-                  << ", Peak=" << peak << std::endl;
-    }
-    
     // Convert RMS to voltage (0-10V range)
     // RMS is typically 0-1 for normalized audio
     // For microphone input, scale it up significantly
@@ -258,56 +289,32 @@ int RealAudioStream::processInputAudio(const float* input, unsigned long frameCo
     
     // Update current level
     currentInputLevel_ = cvLevel;
-    
-    // Debug log the CV level
-    if (callCount % 100 == 0 && cvLevel > 0.01f) {
-        std::cout << "  -> CV Level: " << cvLevel << "V" << std::endl;
+    if (traceId) {
+        tracer.recordSpan(traceId, "level_detection", callbackStart, LatencyTracer::Clock::now());
     }
+    currentTraceId_.store(traceId);
+    
+    TRACE_DEBUG(TraceCategory::Audio, "RealAudioStream block: rms=%f peak=%f cv=%fV", rms, peak, cvLevel);
     
     // Call callback if set
-    {
-        std::lock_guard<std::mutex> lock(callbackMutex_);
-        if (levelCallback_) {
-            levelCallback_(cvLevel);
-        }
+    if (levelCallback_) {
+        levelCallback_(cvLevel);
     }
     
     return paContinue;
 }
 
 int RealAudioStream::processOutputAudio(float* output, unsigned long frameCount) {
-    // Read audio from circular buffer
-    size_t readPos = readPosition_.load();
-    size_t writePos = writePosition_.load();
-    
-    // Check if we have enough data in the buffer
-    size_t availableSamples = (writePos >= readPos) ? 
-                              (writePos - readPos) : 
-                              (BUFFER_SIZE - readPos + writePos);
-    
-    if (availableSamples < frameCount) {
-        // Not enough data, output silence
-        for (unsigned long i = 0; i < frameCount * numChannels_; i++) {
-            output[i] = 0.0f;
-        }
+    if (!outputRing_) {
+        std::fill(output, output + frameCount * numChannels_, 0.0f);
         return paContinue;
     }
     
-    // Copy audio from buffer to output
-    for (unsigned long i = 0; i < frameCount; i++) {
-        float sample = audioBuffer_[readPos];
-        
-        // Write to all channels
-        for (int ch = 0; ch < numChannels_; ch++) {
-            output[i * numChannels_ + ch] = sample;
-        }
-        
-        readPos = (readPos + 1) % BUFFER_SIZE;
+    // Interpolated engine values; the last one is held if the engine falls behind
+    if (outputRing_->render(output, frameCount, static_cast<size_t>(numChannels_))) {
+        bufferUnderruns_.fetch_add(1, std::memory_order_relaxed);
     }
     
-    // Update read position
-    readPosition_.store(readPos);
-    
     return paContinue;
 }
 
@@ -317,6 +324,7 @@ int RealAudioStream::duplexAudioCallback(const void* inputBuffer, void* outputBu
                                        PaStreamCallbackFlags statusFlags,
                                        void* userData) {
     RealAudioStream* stream = static_cast<RealAudioStream*>(userData);
+    recordStatusFlags(statusFlags, framesPerBuffer);
     const float* input = static_cast<const float*>(inputBuffer);
     float* output = static_cast<float*>(outputBuffer);
     
@@ -325,7 +333,7 @@ int RealAudioStream::duplexAudioCallback(const void* inputBuffer, void* outputBu
     }
     
     // Process input for level detection and store in buffer
-    stream->processInputAudio(input, framesPerBuffer);
+    stream->processInputAudio(input, framesPerBuffer, timeInfo);
     
     // Copy input directly to output (real-time passthrough)
     for (unsigned long i = 0; i < framesPerBuffer * stream->numChannels_; i++) {
@@ -419,6 +427,17 @@ float RealAudioStreamManager::getInputLevel(const std::string& deviceId) const {
     return 0.0f;
 }
 
+uint64_t RealAudioStreamManager::takeInputTraceId(const std::string& deviceId) {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    
+    auto it = streams_.find(deviceId);
+    if (it != streams_.end() && it->second) {
+        return it->second->takeTraceId();
+    }
+    
+    return 0;
+}
+
 void RealAudioStreamManager::sendOutputData(const std::string& deviceId, float level) {
     std::lock_guard<std::mutex> lock(streamsMutex_);
     
@@ -428,6 +447,15 @@ void RealAudioStreamManager::sendOutputData(const std::string& deviceId, float l
     }
 }
 
+void RealAudioStreamManager::flushOutputData() {
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+    for (auto& entry : streams_) {
+        if (entry.second) {
+            entry.second->flushAudioData();
+        }
+    }
+}
+
 bool RealAudioStreamManager::hasStream(const std::string& deviceId) const {
     std::lock_guard<std::mutex> lock(streamsMutex_);
     return streams_.find(deviceId) != streams_.end();
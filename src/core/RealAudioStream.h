@@ -8,27 +8,33 @@
 #include <functional>
 #include <vector>
 #include "AudioDeviceManager.h"
+#include "ControlRateRing.h"
 
 class RealAudioStream {
 private:
     PaStream* stream_;
     std::atomic<bool> isRunning_;
     std::atomic<float> currentInputLevel_;
-    std::mutex callbackMutex_;
+    std::atomic<uint64_t> currentTraceId_{0};   // Latency trace of currentInputLevel_, 0 if unsampled
     
     // Device info
     int deviceIndex_;
     int numChannels_;
     double sampleRate_;
     
-    // Callback for processed audio data
+    // Callback for processed audio data; set while stopped, called from the audio thread
     std::function<void(float)> levelCallback_;
     
-    // Audio buffer for passthrough (circular buffer)
-    std::vector<float> audioBuffer_;
-    std::atomic<size_t> writePosition_;
-    std::atomic<size_t> readPosition_;
-    static constexpr size_t BUFFER_SIZE = 44100 * 2; // 2 seconds at 44.1kHz
+    // Control-rate values from the engine, interpolated to audio rate in the output callback
+    std::unique_ptr<ControlRateRing> outputRing_;
+    ControlRateRing::Config outputConfig_;
+    // The tick's latest value, staged until flushAudioData() (engine thread)
+    float pendingLevel_ = 0.0f;
+    bool hasPendingLevel_ = false;
+    
+    // Audio health summed over every stream in the process
+    static std::atomic<uint64_t> droppedSamples_;
+    static std::atomic<uint64_t> bufferUnderruns_;
     
 public:
     RealAudioStream();
@@ -43,15 +49,28 @@ public:
     
     // Get current audio level (for input streams)
     float getCurrentInputLevel() const;
+    // Claims the latency trace of the current level so it is followed once
+    uint64_t takeTraceId() { return currentTraceId_.exchange(0); }
     
-    // Set callback for processed audio data
+    // Set callback for processed audio data (ignored while the stream runs)
     void setLevelCallback(std::function<void(float)> callback);
     
-    // Send audio data (for output streams)
+    // Stages the control-rate value of an output stream; the last call before
+    // flushAudioData() wins, so every channel routed here adds one value per tick
     void sendAudioData(float level);
+    // Queues the staged value, if any, once per engine tick (one producer thread)
+    void flushAudioData();
+    
+    // Interpolation and latency target for the next output stream; the sample rate is the stream's
+    void setOutputConfig(const ControlRateRing::Config& config) { outputConfig_ = config; }
+    ControlRateRing::Stats getOutputStats() const;
     
     bool isRunning() const { return isRunning_; }
     
+    // Lock-free totals for metrics: frames lost to input overflow, times output ran out of data
+    static uint64_t getDroppedSamples() { return droppedSamples_.load(std::memory_order_relaxed); }
+    static uint64_t getBufferUnderruns() { return bufferUnderruns_.load(std::memory_order_relaxed); }
+    
 private:
     // PortAudio callbacks
     static int audioCallback(const void* inputBuffer, void* outputBuffer,
@@ -66,7 +85,8 @@ private:
                                  PaStreamCallbackFlags statusFlags,
                                  void* userData);
     
-    int processInputAudio(const float* input, unsigned long frameCount);
+    static void recordStatusFlags(PaStreamCallbackFlags statusFlags, unsigned long frameCount);
+    int processInputAudio(const float* input, unsigned long frameCount, const PaStreamCallbackTimeInfo* timeInfo);
     int processOutputAudio(float* output, unsigned long frameCount);
 };
 
@@ -93,9 +113,12 @@ public:
     
     // Get current level from input stream
     float getInputLevel(const std::string& deviceId) const;
+    uint64_t takeInputTraceId(const std::string& deviceId);
     
     // Send audio data to output stream
     void sendOutputData(const std::string& deviceId, float level);
+    // Queues this tick's output value of every stream
+    void flushOutputData();
     
     // Check if stream exists and is running
     bool hasStream(const std::string& deviceId) const;
@@ -0,0 +1,372 @@
+#include "ResourceSampler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#include <mach/thread_info.h>
+#elif defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+thread_local int registeredSlot = -1;
+
+int64_t currentThreadId() {
+#ifdef __APPLE__
+    uint64_t id = 0;
+    pthread_threadid_np(nullptr, &id);
+    return static_cast<int64_t>(id);
+#elif defined(__linux__)
+    return static_cast<int64_t>(syscall(SYS_gettid));
+#else
+    return 0;
+#endif
+}
+
+#ifdef __linux__
+// Parse the next unsigned integer in [cursor, end), advancing cursor past it
+uint64_t nextNumber(const char*& cursor, const char* end) {
+    while (cursor < end && (*cursor < '0' || *cursor > '9')) {
+        cursor++;
+    }
+    uint64_t value = 0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*cursor - '0');
+        cursor++;
+    }
+    return value;
+}
+
+// Re-read a /proc file from the start through a descriptor kept open
+ssize_t readProcFile(int fd, char* buffer, size_t size) {
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t length = pread(fd, buffer, size - 1, 0);
+    if (length >= 0) {
+        buffer[length] = '\0';
+    }
+    return length;
+}
+
+int openCounter(int64_t threadId, uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    // Context switches happen in the kernel; hardware counters stay user-only so they
+    // remain available at perf_event_paranoid 2
+    attr.exclude_kernel = type == PERF_TYPE_HARDWARE ? 1 : 0;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, static_cast<pid_t>(threadId), -1, -1,
+                                    PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+} // namespace
+
+ResourceSampler& ResourceSampler::getInstance() {
+    static ResourceSampler instance;
+    return instance;
+}
+
+ResourceSampler::ResourceSampler() : lastSampleTime_(std::chrono::steady_clock::now()) {
+    lastProcessCpuNs_ = processCpuNs();
+#ifdef __linux__
+    statFd_ = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+    statmFd_ = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+ResourceSampler::~ResourceSampler() {
+    for (auto& slot : threads_) {
+        closeCounters(slot);
+    }
+    if (statFd_ >= 0) {
+        close(statFd_);
+    }
+    if (statmFd_ >= 0) {
+        close(statmFd_);
+    }
+}
+
+bool ResourceSampler::registerCurrentThread(const char* name) {
+    if (registeredSlot >= 0) {
+        return true;
+    }
+    for (size_t i = 0; i < threads_.size(); i++) {
+        ThreadSlot& slot = threads_[i];
+        int expected = 0;
+        if (!slot.state.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
+            continue;
+        }
+        slot.name = name;
+        slot.threadId = currentThreadId();
+#ifdef __APPLE__
+        slot.machThread = pthread_mach_thread_np(pthread_self());
+#else
+        if (pthread_getcpuclockid(pthread_self(), &slot.clock) != 0) {
+            slot.state.store(0, std::memory_order_release);
+            return false;
+        }
+#endif
+        slot.sampled = false;
+        slot.state.store(2, std::memory_order_release);
+        registeredSlot = static_cast<int>(i);
+        return true;
+    }
+    return false; // Table full: the thread is simply not attributed
+}
+
+void ResourceSampler::unregisterCurrentThread() {
+    if (registeredSlot < 0) {
+        return;
+    }
+    // The sampler frees the slot (and its counters) on its next pass
+    threads_[registeredSlot].state.store(3, std::memory_order_release);
+    registeredSlot = -1;
+}
+
+void ResourceSampler::enableHardwareCounters(bool enable) {
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    hardwareCounters_.store(enable);
+    if (!enable) {
+        for (auto& slot : threads_) {
+            closeCounters(slot);
+            slot.perfFailed = false;
+        }
+    }
+}
+
+bool ResourceSampler::readThreadCpu(ThreadSlot& slot, uint64_t& cpuNs) const {
+#ifdef __APPLE__
+    thread_basic_info_data_t info;
+    mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+    if (thread_info(slot.machThread, THREAD_BASIC_INFO, reinterpret_cast<thread_info_t>(&info), &count) !=
+        KERN_SUCCESS) {
+        return false;
+    }
+    cpuNs = (static_cast<uint64_t>(info.user_time.seconds) + info.system_time.seconds) * 1000000000ull +
+            (static_cast<uint64_t>(info.user_time.microseconds) + info.system_time.microseconds) * 1000ull;
+    return true;
+#else
+    timespec ts;
+    if (clock_gettime(slot.clock, &ts) != 0) {
+        return false; // Thread has exited
+    }
+    cpuNs = static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    return true;
+#endif
+}
+
+void ResourceSampler::readCounters(ThreadSlot& slot, ThreadSample& sample) {
+#ifdef __linux__
+    if (!slot.countersOpen && !slot.perfFailed) {
+        // Opened independently: a VM without hardware counters still gets context switches
+        int cycles = openCounter(slot.threadId, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        int misses = openCounter(slot.threadId, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        int switches = openCounter(slot.threadId, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+        if (cycles < 0 && misses < 0 && switches < 0) {
+            slot.perfFailed = true;
+            return;
+        }
+        slot.counterFds = {{cycles, misses, switches}};
+        slot.countersOpen = true;
+        slot.lastCounters = {{-1, -1, -1}};
+    }
+    if (!slot.countersOpen) {
+        return;
+    }
+
+    int64_t* outputs[3] = {&sample.cycles, &sample.cacheMisses, &sample.contextSwitches};
+    for (size_t i = 0; i < 3; i++) {
+        uint64_t value = 0;
+        if (slot.counterFds[i] < 0 || read(slot.counterFds[i], &value, sizeof(value)) != sizeof(value)) {
+            continue;
+        }
+        int64_t current = static_cast<int64_t>(value);
+        if (slot.lastCounters[i] >= 0) {
+            *outputs[i] = current - slot.lastCounters[i];
+        }
+        slot.lastCounters[i] = current;
+    }
+#else
+    (void)slot;
+    (void)sample;
+#endif
+}
+
+void ResourceSampler::closeCounters(ThreadSlot& slot) {
+    for (int& fd : slot.counterFds) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    slot.countersOpen = false;
+}
+
+uint64_t ResourceSampler::processCpuNs() {
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return (static_cast<uint64_t>(usage.ru_utime.tv_sec) + usage.ru_stime.tv_sec) * 1000000000ull +
+           (static_cast<uint64_t>(usage.ru_utime.tv_usec) + usage.ru_stime.tv_usec) * 1000ull;
+}
+
+ResourceSampler::Sample ResourceSampler::sample() {
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    Sample result;
+
+    auto now = std::chrono::steady_clock::now();
+    double wallNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastSampleTime_).count());
+    lastSampleTime_ = now;
+
+    uint64_t processNs = processCpuNs();
+    if (wallNs > 0) {
+        result.processCpuPercent = 100.0 * static_cast<double>(processNs - lastProcessCpuNs_) / wallNs;
+    }
+    lastProcessCpuNs_ = processNs;
+
+    result.residentMemoryMB = getResidentMemoryMB();
+    result.loadAverage = getLoadAverage();
+
+    const bool counters = hardwareCounters_.load();
+    for (auto& slot : threads_) {
+        int state = slot.state.load(std::memory_order_acquire);
+        if (state == 3) {
+            closeCounters(slot);
+            slot.perfFailed = false;
+            slot.state.store(0, std::memory_order_release);
+            continue;
+        }
+        if (state != 2) {
+            continue;
+        }
+
+        ThreadSample thread;
+        thread.name = slot.name ? slot.name : "thread";
+        thread.threadId = slot.threadId;
+        uint64_t cpuNs = 0;
+        if (!readThreadCpu(slot, cpuNs)) {
+            // Exited without unregistering: report once, then free the slot
+            thread.alive = false;
+            result.threads.push_back(thread);
+            closeCounters(slot);
+            slot.perfFailed = false;
+            slot.state.store(0, std::memory_order_release);
+            continue;
+        }
+        if (!slot.sampled) {
+            slot.firstCpuNs = cpuNs;
+            slot.lastCpuNs = cpuNs;
+            slot.sampled = true;
+        }
+        if (wallNs > 0) {
+            thread.cpuPercent = 100.0 * static_cast<double>(cpuNs - slot.lastCpuNs) / wallNs;
+        }
+        thread.cpuTimeNs = cpuNs - slot.firstCpuNs;
+        slot.lastCpuNs = cpuNs;
+
+        if (counters) {
+            readCounters(slot, thread);
+        }
+        result.threads.push_back(thread);
+    }
+
+    return result;
+}
+
+double ResourceSampler::getSystemCpuUsage() {
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    return systemCpuLocked();
+}
+
+double ResourceSampler::systemCpuLocked() {
+    uint64_t total = 0;
+    uint64_t idle = 0;
+
+#ifdef __APPLE__
+    host_cpu_load_info_data_t cpuinfo;
+    mach_msg_type_number_t count = HOST_CPU_LOAD_INFO_COUNT;
+    if (host_statistics(mach_host_self(), HOST_CPU_LOAD_INFO, reinterpret_cast<host_info_t>(&cpuinfo), &count) !=
+        KERN_SUCCESS) {
+        return 0.0;
+    }
+    for (int state = 0; state < CPU_STATE_MAX; state++) {
+        total += cpuinfo.cpu_ticks[state];
+    }
+    idle = cpuinfo.cpu_ticks[CPU_STATE_IDLE];
+#elif defined(__linux__)
+    char buffer[512];
+    ssize_t length = readProcFile(statFd_, buffer, sizeof(buffer));
+    if (length <= 0) {
+        return 0.0;
+    }
+    // "cpu  user nice system idle iowait irq softirq steal ..."
+    const char* cursor = buffer;
+    const char* end = std::find(buffer, buffer + length, '\n');
+    uint64_t fields[8] = {0};
+    for (uint64_t& field : fields) {
+        field = nextNumber(cursor, end);
+        total += field;
+    }
+    idle = fields[3] + fields[4];
+#else
+    return 0.0;
+#endif
+
+    uint64_t totalDelta = total - lastSystemTotal_;
+    uint64_t idleDelta = idle - lastSystemIdle_;
+    bool first = lastSystemTotal_ == 0;
+    lastSystemTotal_ = total;
+    lastSystemIdle_ = idle;
+
+    if (first || totalDelta == 0) {
+        return 0.0;
+    }
+    double usage = 100.0 * (1.0 - static_cast<double>(idleDelta) / static_cast<double>(totalDelta));
+    return std::max(0.0, std::min(100.0, usage));
+}
+
+size_t ResourceSampler::getResidentMemoryMB() {
+#ifdef __APPLE__
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) ==
+        KERN_SUCCESS) {
+        return info.resident_size / (1024 * 1024);
+    }
+    return 0;
+#elif defined(__linux__)
+    char buffer[128];
+    ssize_t length = readProcFile(statmFd_, buffer, sizeof(buffer));
+    if (length <= 0) {
+        return 0;
+    }
+    // "size resident shared ..." in pages
+    const char* cursor = buffer;
+    nextNumber(cursor, buffer + length);
+    uint64_t residentPages = nextNumber(cursor, buffer + length);
+    return static_cast<size_t>(residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) / (1024 * 1024));
+#else
+    return 0;
+#endif
+}
+
+double ResourceSampler::getLoadAverage() {
+    double loadavg[1];
+    if (getloadavg(loadavg, 1) == 1) {
+        return loadavg[0];
+    }
+    return 0.0;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <time.h>
+
+/**
+ * @brief Cheap CPU and memory sampling with per-thread attribution
+ *
+ * Threads that matter (audio callbacks, mixer engine, network) register
+ * themselves by name; each sample reads their CPU clocks directly
+ * (CLOCK_THREAD_CPUTIME_ID-style clocks on Linux, thread_info on macOS)
+ * instead of parsing /proc text. Process CPU comes from getrusage(). On
+ * Linux the few /proc files still needed are opened once and re-read with
+ * pread(), and hardware counters (cycles, cache misses, context switches)
+ * can be read per thread through perf_event_open when the kernel allows it.
+ *
+ * Registration is lock-free and allocation-free, so an audio callback may
+ * register itself on its first invocation. Sampling is for one monitoring
+ * thread at a time.
+ */
+class ResourceSampler {
+public:
+    struct ThreadSample {
+        std::string name;
+        int64_t threadId = 0;
+        double cpuPercent = 0.0;        // Of one core, over the last interval
+        uint64_t cpuTimeNs = 0;         // Total since registration
+        bool alive = true;
+        // Hardware counters over the last interval (-1 when unavailable)
+        int64_t cycles = -1;
+        int64_t cacheMisses = -1;
+        int64_t contextSwitches = -1;
+    };
+
+    struct Sample {
+        double processCpuPercent = 0.0;     // Of one core; can exceed 100 with several threads
+        size_t residentMemoryMB = 0;
+        double loadAverage = 0.0;
+        std::vector<ThreadSample> threads;
+    };
+
+    static ResourceSampler& getInstance();
+
+    // Any thread, real-time safe. name must be a string literal (stored by pointer).
+    bool registerCurrentThread(const char* name);
+    void unregisterCurrentThread();
+
+    // perf_event_open counters for registered threads (Linux only, needs perf_event_paranoid <= 1)
+    void enableHardwareCounters(bool enable);
+    bool hardwareCountersEnabled() const { return hardwareCounters_.load(); }
+
+    // Monitoring thread. Thread and process CPU are measured since the previous sample().
+    Sample sample();
+    // Whole machine, since the previous call
+    double getSystemCpuUsage();
+    size_t getResidentMemoryMB();
+    double getLoadAverage();
+
+private:
+    static constexpr size_t MAX_THREADS = 32;
+
+    struct ThreadSlot {
+        std::atomic<int> state{0};      // 0 free, 1 being written, 2 registered, 3 retired
+        const char* name = nullptr;
+        int64_t threadId = 0;
+#ifdef __APPLE__
+        uint32_t machThread = 0;
+#else
+        clockid_t clock = 0;
+#endif
+        // Sampler-owned
+        uint64_t lastCpuNs = 0;
+        uint64_t firstCpuNs = 0;
+        bool sampled = false;
+        bool countersOpen = false;
+        std::array<int, 3> counterFds{{-1, -1, -1}};      // cycles, cache misses, context switches
+        std::array<int64_t, 3> lastCounters{{-1, -1, -1}};
+        bool perfFailed = false;
+    };
+
+    ResourceSampler();
+    ~ResourceSampler();
+
+    std::array<ThreadSlot, MAX_THREADS> threads_;
+    std::atomic<bool> hardwareCounters_{false};
+
+    std::mutex sampleMutex_;
+    std::chrono::steady_clock::time_point lastSampleTime_;
+    uint64_t lastProcessCpuNs_ = 0;
+    uint64_t lastSystemTotal_ = 0;
+    uint64_t lastSystemIdle_ = 0;
+
+    // Kept open and re-read with pread (Linux)
+    int statFd_ = -1;
+    int statmFd_ = -1;
+
+    bool readThreadCpu(ThreadSlot& slot, uint64_t& cpuNs) const;
+    void readCounters(ThreadSlot& slot, ThreadSample& sample);
+    void closeCounters(ThreadSlot& slot);
+    double systemCpuLocked();
+    static uint64_t processCpuNs();
+};
+
+// Registers the calling thread for the lifetime of the scope (worker threads)
+class ScopedThreadRegistration {
+public:
+    explicit ScopedThreadRegistration(const char* name) {
+        ResourceSampler::getInstance().registerCurrentThread(name);
+    }
+    ~ScopedThreadRegistration() { ResourceSampler::getInstance().unregisterCurrentThread(); }
+};
@@ -0,0 +1,88 @@
+#include "StartupProfiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+namespace {
+
+// Dynamic initialization runs before main(), which is as close to exec as portable code gets
+const StartupProfiler::Clock::time_point processStart = StartupProfiler::Clock::now();
+const std::thread::id mainThread = std::this_thread::get_id();
+
+int64_t sinceProcessStart(StartupProfiler::Clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - processStart).count();
+}
+
+} // namespace
+
+StartupProfiler& StartupProfiler::getInstance() {
+    static StartupProfiler instance;
+    return instance;
+}
+
+void StartupProfiler::recordPhase(const std::string& name, Clock::time_point start, Clock::time_point end) {
+    Phase phase;
+    phase.name = name;
+    phase.startNs = sinceProcessStart(start);
+    phase.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    phase.background = std::this_thread::get_id() != mainThread;
+
+    std::lock_guard<std::mutex> lock(phasesMutex_);
+    phases_.push_back(std::move(phase));
+}
+
+void StartupProfiler::recordFirstPacket() {
+    if (!firstPacketSent_.exchange(true)) {
+        firstPacketNs_.store(sinceProcessStart(Clock::now()), std::memory_order_release);
+    }
+}
+
+int64_t StartupProfiler::getUptimeNs() const {
+    return sinceProcessStart(Clock::now());
+}
+
+std::vector<StartupProfiler::Phase> StartupProfiler::getPhases() const {
+    std::vector<Phase> phases;
+    {
+        std::lock_guard<std::mutex> lock(phasesMutex_);
+        phases = phases_;
+    }
+    std::stable_sort(phases.begin(), phases.end(),
+                     [](const Phase& a, const Phase& b) { return a.startNs < b.startNs; });
+    return phases;
+}
+
+void StartupProfiler::report(std::ostream& out) const {
+    char line[128];
+    out << "Startup timing (ms since process start):" << '\n';
+    std::snprintf(line, sizeof(line), "  %-28s %10s %10s\n", "phase", "start", "duration");
+    out << line;
+    for (const auto& phase : getPhases()) {
+        std::string name = phase.background ? phase.name + " [bg]" : phase.name;
+        std::snprintf(line, sizeof(line), "  %-28s %10.1f %10.1f\n", name.c_str(), phase.startNs / 1e6,
+                      phase.durationNs / 1e6);
+        out << line;
+    }
+    int64_t firstPacket = getTimeToFirstPacketNs();
+    if (firstPacket >= 0) {
+        std::snprintf(line, sizeof(line), "  %-28s %10.1f\n", "first OSC packet", firstPacket / 1e6);
+        out << line;
+    }
+    out.flush();
+}
+
+bool StartupProfiler::reportOnceAfterFirstPacket(std::ostream& out) {
+    if (getTimeToFirstPacketNs() < 0 || reported_.load(std::memory_order_relaxed) || reported_.exchange(true)) {
+        return false;
+    }
+    report(out);
+    return true;
+}
+
+void StartupProfiler::reset() {
+    std::lock_guard<std::mutex> lock(phasesMutex_);
+    phases_.clear();
+    firstPacketSent_ = false;
+    firstPacketNs_ = -1;
+    reported_ = false;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Startup phase timing and time-to-first-OSC-packet
+ *
+ * Phases are recorded with ScopedPhase from whichever thread runs them;
+ * those off the main thread (audio init) are marked as background so the
+ * overlap with the critical path is visible. Times are relative to process
+ * start (static initialization). markFirstPacket() is called on every
+ * successful send and costs one relaxed load after the first.
+ */
+class StartupProfiler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase {
+        std::string name;
+        int64_t startNs = 0;        // Since process start
+        int64_t durationNs = 0;
+        bool background = false;    // Ran off the main thread
+    };
+
+    class ScopedPhase {
+    public:
+        ScopedPhase(StartupProfiler& profiler, const char* name)
+            : profiler_(profiler), name_(name), start_(Clock::now()) {}
+        ~ScopedPhase() { profiler_.recordPhase(name_, start_, Clock::now()); }
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    private:
+        StartupProfiler& profiler_;
+        const char* name_;
+        Clock::time_point start_;
+    };
+
+    static StartupProfiler& getInstance();
+
+    ScopedPhase phase(const char* name) { return ScopedPhase(*this, name); }
+    void recordPhase(const std::string& name, Clock::time_point start, Clock::time_point end);
+
+    void markFirstPacket() {
+        if (!firstPacketSent_.load(std::memory_order_relaxed)) {
+            recordFirstPacket();
+        }
+    }
+    // -1 until the first packet has been sent
+    int64_t getTimeToFirstPacketNs() const { return firstPacketNs_.load(std::memory_order_acquire); }
+    int64_t getUptimeNs() const;
+
+    std::vector<Phase> getPhases() const;
+    void report(std::ostream& out) const;
+    // Reports once, after the first packet; true if it did
+    bool reportOnceAfterFirstPacket(std::ostream& out);
+    void reset();
+
+private:
+    StartupProfiler() = default;
+    void recordFirstPacket();
+
+    mutable std::mutex phasesMutex_;
+    std::vector<Phase> phases_;
+    std::atomic<bool> firstPacketSent_{false};
+    std::atomic<int64_t> firstPacketNs_{-1};
+    std::atomic<bool> reported_{false};
+};
@@ -0,0 +1,250 @@
+#include "TraceLog.h"
+#include <algorithm>
+#include <cctype>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+void handleDumpSignal(int) {
+    TraceLog::requestDump();
+}
+
+const char* levelName(TraceLevel level) {
+    switch (level) {
+        case TraceLevel::Info: return "INFO";
+        case TraceLevel::Debug: return "DEBUG";
+        case TraceLevel::Verbose: return "VERBOSE";
+    }
+    return "?";
+}
+
+} // namespace
+
+TraceLog& TraceLog::getInstance() {
+    static TraceLog instance;
+    return instance;
+}
+
+TraceLog::TraceLog() : ring_(new Slot[RING_SIZE]), epoch_(std::chrono::steady_clock::now()) {
+}
+
+uint32_t TraceLog::parseCategories(const std::string& list) {
+    static const std::pair<const char*, TraceCategory> names[] = {
+        {"audio", TraceCategory::Audio}, {"engine", TraceCategory::Engine}, {"osc", TraceCategory::Osc},
+        {"gui", TraceCategory::Gui}, {"device", TraceCategory::Device}, {"all", TraceCategory::All},
+    };
+
+    uint32_t mask = 0;
+    std::stringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        name.erase(std::remove_if(name.begin(), name.end(), [](unsigned char c) { return std::isspace(c); }),
+                   name.end());
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        for (const auto& entry : names) {
+            if (name == entry.first) {
+                mask |= static_cast<uint32_t>(entry.second);
+            }
+        }
+    }
+    return mask;
+}
+
+const char* TraceLog::getCategoryName(TraceCategory category) {
+    switch (category) {
+        case TraceCategory::Audio: return "audio";
+        case TraceCategory::Engine: return "engine";
+        case TraceCategory::Osc: return "osc";
+        case TraceCategory::Gui: return "gui";
+        case TraceCategory::Device: return "device";
+        case TraceCategory::All: return "all";
+    }
+    return "?";
+}
+
+bool TraceLog::configureFromEnvironment() {
+    const char* categories = std::getenv("CVOSC_TRACE_CATEGORIES");
+    if (!categories || !*categories) {
+        return false;
+    }
+    setCategoryMask(parseCategories(categories));
+
+    const char* file = std::getenv("CVOSC_TRACE_DUMP");
+    dumpFile_ = file && *file ? file : "cvosc_trace.log";
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, handleDumpSignal);
+#endif
+    std::cout << "Trace categories enabled: " << categories << " (dump -> " << dumpFile_ << ")" << std::endl;
+    return true;
+}
+
+uint32_t TraceLog::currentThreadId() {
+    thread_local uint32_t threadId = nextThreadId_.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+
+void TraceLog::write(TraceCategory category, TraceLevel level, const char* format, const Encoded& encoded) {
+    uint64_t index = writeIndex_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = ring_[index % RING_SIZE];
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch_).count();
+
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.format.store(reinterpret_cast<uintptr_t>(format), std::memory_order_relaxed);
+    slot.timestampNs.store(now, std::memory_order_relaxed);
+    slot.header.store(static_cast<uint64_t>(category) | (static_cast<uint64_t>(level) << 32) |
+                      (static_cast<uint64_t>(currentThreadId()) << 40), std::memory_order_relaxed);
+    slot.tags.store(encoded.tags, std::memory_order_relaxed);
+    for (size_t i = 0; i < encoded.used; i++) {
+        slot.args[i].store(encoded.words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+std::vector<TraceLog::Entry> TraceLog::collect() const {
+    std::vector<Entry> entries;
+    uint64_t end = writeIndex_.load(std::memory_order_acquire);
+    uint64_t begin = std::max(clearedIndex_.load(), end > RING_SIZE ? end - RING_SIZE : 0);
+    entries.reserve(static_cast<size_t>(end - begin));
+
+    for (uint64_t index = begin; index < end; index++) {
+        const Slot& slot = ring_[index % RING_SIZE];
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+            continue; // Still being written, or already overwritten
+        }
+        auto format = reinterpret_cast<const char*>(slot.format.load(std::memory_order_relaxed));
+        int64_t timestamp = slot.timestampNs.load(std::memory_order_relaxed);
+        uint64_t header = slot.header.load(std::memory_order_relaxed);
+        uint64_t tags = slot.tags.load(std::memory_order_relaxed);
+        std::array<uint64_t, ARG_WORDS> words;
+        for (size_t i = 0; i < ARG_WORDS; i++) {
+            words[i] = slot.args[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != index + 1) {
+            continue;
+        }
+
+        Entry entry;
+        entry.timestampNs = timestamp;
+        entry.category = static_cast<TraceCategory>(static_cast<uint32_t>(header));
+        entry.level = static_cast<TraceLevel>((header >> 32) & 0xff);
+        entry.threadId = static_cast<uint32_t>(header >> 40);
+        entry.text = formatEntry(format ? format : "", tags, words.data());
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+void TraceLog::dump(std::ostream& out) const {
+    char prefix[64];
+    for (const auto& entry : collect()) {
+        std::snprintf(prefix, sizeof(prefix), "[%12.6f] [t%u] %-6s %-7s ", entry.timestampNs / 1e9,
+                      entry.threadId, getCategoryName(entry.category), levelName(entry.level));
+        out << prefix << entry.text << '\n';
+    }
+    out.flush();
+}
+
+bool TraceLog::dump(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write trace dump: " << filename << std::endl;
+        return false;
+    }
+    dump(file);
+    std::cout << "Trace dump written to " << filename << std::endl;
+    return true;
+}
+
+bool TraceLog::serviceDumpRequest() {
+    if (!dumpRequested_.load(std::memory_order_relaxed) || !dumpRequested_.exchange(false)) {
+        return false;
+    }
+    return dump(dumpFile_.empty() ? std::string("cvosc_trace.log") : dumpFile_);
+}
+
+void TraceLog::clear() {
+    clearedIndex_.store(writeIndex_.load());
+}
+
+std::string TraceLog::formatEntry(const char* format, uint64_t tags, const uint64_t* words) {
+    std::string text;
+    char buffer[64];
+    size_t argument = 0;
+    size_t word = 0;
+
+    for (const char* p = format; *p; p++) {
+        if (*p != '%') {
+            text += *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            text += '%';
+            p++;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion; the length is replaced to match the stored type
+        std::string spec = "%";
+        const char* q = p + 1;
+        while (*q && std::strchr("-+ #0123456789.", *q)) {
+            spec += *q++;
+        }
+        while (*q && std::strchr("hlLqjzt", *q)) {
+            q++;
+        }
+        char conversion = *q;
+        if (!conversion) {
+            break;
+        }
+        p = q;
+
+        auto tag = static_cast<ArgTag>((tags >> (4 * argument)) & 0xf);
+        argument++;
+        if (tag == TagNone) {
+            text += '?';
+            continue;
+        }
+        uint64_t raw = words[word];
+        word += tag == TagString ? 2 : 1;
+
+        double number;
+        std::memcpy(&number, &raw, sizeof(number));
+        int64_t integer = tag == TagDouble ? static_cast<int64_t>(number) : static_cast<int64_t>(raw);
+        if (tag != TagDouble) {
+            number = tag == TagUnsigned ? static_cast<double>(raw) : static_cast<double>(integer);
+        }
+
+        if (tag == TagString || conversion == 's') {
+            if (tag == TagString) {
+                char string[17] = {};
+                std::memcpy(string, &words[word - 2], 16);
+                std::snprintf(buffer, sizeof(buffer), (spec + "s").c_str(), string);
+            } else if (tag == TagDouble) {
+                std::snprintf(buffer, sizeof(buffer), "%g", number);
+            } else {
+                std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(integer));
+            }
+        } else if (std::strchr("di", conversion)) {
+            std::snprintf(buffer, sizeof(buffer), (spec + "lld").c_str(), static_cast<long long>(integer));
+        } else if (conversion == 'c') {
+            std::snprintf(buffer, sizeof(buffer), (spec + "c").c_str(), static_cast<int>(integer));
+        } else if (std::strchr("uoxX", conversion)) {
+            std::snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(),
+                          static_cast<unsigned long long>(tag == TagDouble ? integer : raw));
+        } else if (std::strchr("fFeEgGaA", conversion)) {
+            std::snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), number);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(raw));
+        }
+        text += buffer;
+    }
+    return text;
+}
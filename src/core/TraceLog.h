@@ -0,0 +1,198 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Compile-time ceiling for tracepoints: 0 off, 1 info, 2 debug, 3 verbose.
+// Tracepoints above it expand to nothing, arguments included.
+#ifndef CVOSC_TRACE_LEVEL
+#define CVOSC_TRACE_LEVEL 2
+#endif
+
+enum class TraceLevel : uint8_t {
+    Info = 1,
+    Debug = 2,
+    Verbose = 3
+};
+
+enum class TraceCategory : uint32_t {
+    Audio = 1u << 0,     // Audio callbacks and streams
+    Engine = 1u << 1,    // Mixer engine loop and routing
+    Osc = 1u << 2,       // OSC encode and send
+    Gui = 1u << 3,       // Values handed to the GUI
+    Device = 1u << 4,    // Audio/OSC device integration
+    All = 0xffffffffu
+};
+
+/**
+ * @brief Binary trace ring for hot-path diagnostics
+ *
+ * Tracepoints store a format string literal and up to four raw arguments in
+ * a fixed-size slot of a lock-free ring; nothing is formatted or written
+ * until the ring is dumped, so an enabled tracepoint costs a few atomic
+ * stores and a disabled one a relaxed load of the category mask. Strings
+ * are copied, truncated to 16 bytes. The ring keeps the most recent
+ * RING_SIZE records.
+ *
+ * Categories are enabled at runtime (CVOSC_TRACE_CATEGORIES=audio,osc or
+ * "all"); CVOSC_TRACE_DUMP names the file written on shutdown and on SIGUSR1.
+ */
+class TraceLog {
+public:
+    static constexpr size_t RING_SIZE = 16384;
+    static constexpr size_t MAX_ARGS = 4;
+
+    struct Entry {
+        int64_t timestampNs = 0;     // Since the trace log was created
+        TraceCategory category = TraceCategory::All;
+        TraceLevel level = TraceLevel::Info;
+        uint32_t threadId = 0;
+        std::string text;
+    };
+
+    static TraceLog& getInstance();
+
+    // Hot path: one relaxed load
+    static bool isEnabled(TraceCategory category) {
+        return (categoryMask_.load(std::memory_order_relaxed) & static_cast<uint32_t>(category)) != 0;
+    }
+    static void setCategoryMask(uint32_t mask) { categoryMask_.store(mask, std::memory_order_relaxed); }
+    static uint32_t getCategoryMask() { return categoryMask_.load(std::memory_order_relaxed); }
+    // "audio,engine", "all" or "none"; unknown names are ignored
+    static uint32_t parseCategories(const std::string& list);
+    static const char* getCategoryName(TraceCategory category);
+
+    // Reads CVOSC_TRACE_CATEGORIES and CVOSC_TRACE_DUMP, and installs the SIGUSR1 dump request
+    bool configureFromEnvironment();
+
+    // Any thread, real-time safe. format must be a string literal (stored by pointer).
+    template <typename... Args>
+    void record(TraceCategory category, TraceLevel level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "at most four trace arguments");
+        Encoded encoded;
+        (encoded.add(args), ...);
+        write(category, level, format, encoded);
+    }
+
+    // Oldest first
+    std::vector<Entry> collect() const;
+    void dump(std::ostream& out) const;
+    bool dump(const std::string& filename) const;
+    void clear();
+
+    // Dump requests from a signal handler are served by a normal thread
+    static void requestDump() { dumpRequested_.store(true, std::memory_order_relaxed); }
+    bool serviceDumpRequest();
+    const std::string& getDumpFile() const { return dumpFile_; }
+
+private:
+    enum ArgTag : uint64_t { TagNone = 0, TagInt = 1, TagUnsigned = 2, TagDouble = 3, TagString = 4 };
+    static constexpr size_t ARG_WORDS = 4;
+
+    // Arguments packed into raw words; a string takes two
+    struct Encoded {
+        std::array<uint64_t, ARG_WORDS> words{};
+        uint64_t tags = 0;
+        size_t count = 0;
+        size_t used = 0;
+
+        template <typename T>
+        void add(const T& value) {
+            using U = std::decay_t<T>;
+            if constexpr (std::is_same_v<U, bool> || (std::is_integral_v<U> && std::is_signed_v<U>)) {
+                push(TagInt, static_cast<uint64_t>(static_cast<int64_t>(value)));
+            } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+                push(TagUnsigned, static_cast<uint64_t>(value));
+            } else if constexpr (std::is_floating_point_v<U>) {
+                double number = static_cast<double>(value);
+                uint64_t bits;
+                std::memcpy(&bits, &number, sizeof(bits));
+                push(TagDouble, bits);
+            } else if constexpr (std::is_same_v<U, std::string>) {
+                pushString(value.data(), value.size());
+            } else {
+                const char* text = value;
+                pushString(text, text ? std::strlen(text) : 0);
+            }
+        }
+
+        void push(ArgTag tag, uint64_t word) {
+            if (used < ARG_WORDS) {
+                words[used++] = word;
+                tags |= static_cast<uint64_t>(tag) << (4 * count);
+            }
+            count++;
+        }
+
+        void pushString(const char* text, size_t length) {
+            if (used + 2 > ARG_WORDS) {
+                count++;
+                return;
+            }
+            char buffer[16] = {};
+            std::memcpy(buffer, text, length < sizeof(buffer) ? length : sizeof(buffer));
+            std::memcpy(&words[used], buffer, sizeof(buffer));
+            used += 2;
+            tags |= static_cast<uint64_t>(TagString) << (4 * count);
+            count++;
+        }
+    };
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};      // index + 1 once complete, 0 while written
+        std::atomic<uint64_t> format{0};
+        std::atomic<int64_t> timestampNs{0};
+        std::atomic<uint64_t> header{0};        // category | level << 32 | thread << 40
+        std::atomic<uint64_t> tags{0};
+        std::array<std::atomic<uint64_t>, ARG_WORDS> args;
+    };
+
+    TraceLog();
+
+    void write(TraceCategory category, TraceLevel level, const char* format, const Encoded& encoded);
+    static uint32_t currentThreadId();
+    static std::string formatEntry(const char* format, uint64_t tags, const uint64_t* words);
+
+    static inline std::atomic<uint32_t> categoryMask_{0};
+    static inline std::atomic<bool> dumpRequested_{false};
+    static inline std::atomic<uint32_t> nextThreadId_{1};
+
+    std::unique_ptr<Slot[]> ring_;
+    std::atomic<uint64_t> writeIndex_{0};
+    std::atomic<uint64_t> clearedIndex_{0};
+    std::chrono::steady_clock::time_point epoch_;
+    std::string dumpFile_;
+};
+
+#define CVOSC_TRACE_AT(level, category, ...)                                         \
+    do {                                                                             \
+        if (TraceLog::isEnabled(category)) {                                         \
+            TraceLog::getInstance().record(category, level, __VA_ARGS__);            \
+        }                                                                            \
+    } while (0)
+
+#if CVOSC_TRACE_LEVEL >= 1
+#define TRACE_INFO(category, ...) CVOSC_TRACE_AT(TraceLevel::Info, category, __VA_ARGS__)
+#else
+#define TRACE_INFO(category, ...) ((void)0)
+#endif
+
+#if CVOSC_TRACE_LEVEL >= 2
+#define TRACE_DEBUG(category, ...) CVOSC_TRACE_AT(TraceLevel::Debug, category, __VA_ARGS__)
+#else
+#define TRACE_DEBUG(category, ...) ((void)0)
+#endif
+
+#if CVOSC_TRACE_LEVEL >= 3
+#define TRACE_VERBOSE(category, ...) CVOSC_TRACE_AT(TraceLevel::Verbose, category, __VA_ARGS__)
+#else
+#define TRACE_VERBOSE(category, ...) ((void)0)
+#endif
@@ -389,6 +389,8 @@ self.progressIndicator = [[NSProgressIndicator alloc] initWithFrame:NSMakeRect(1
     try {
         // Initialize components
         self.cvReader = new CVReader();
+        self.cvReader->attachMonitor(self.mixerEngine->getPerformanceMonitor());
+        self.cvReader->setInsertChain(self.mixerEngine->getInsertChain());
         self.oscSender = new OSCSender(host, port);
         
         // Update UI
@@ -543,6 +545,7 @@ self.progressIndicator = [[NSProgressIndicator alloc] initWithFrame:NSMakeRect(1
         // Initialize CV Writer
         if (!self.cvWriter) {
             self.cvWriter = new CVWriter();
+            self.cvWriter->attachMonitor(self.mixerEngine->getPerformanceMonitor());
         }
         NSLog(@"CV Sender started");
     } else {
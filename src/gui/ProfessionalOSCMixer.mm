@@ -1054,14 +1054,8 @@
         _mixerEngine = engine;
         _channelStrips = [[NSMutableArray alloc] init];
         
-        // Initialize AudioDeviceManager
-        _audioDeviceManager = std::make_shared<AudioDeviceManager>();
-        if (!_audioDeviceManager->initialize()) {
-            NSLog(@"⚠️ Failed to initialize AudioDeviceManager");
-        } else {
-            NSLog(@"✅ AudioDeviceManager initialized successfully");
-            _audioDeviceManager->refreshDeviceList();
-        }
+        // The engine owns the AudioDeviceManager; it is fetched on first use
+        // so the window appears while audio is still initializing
         
         [self setupMainWindow];
         [self setupUI];
@@ -1211,6 +1205,9 @@
 // Master meter removed - simplified OSC routing only
 
 - (std::shared_ptr<AudioDeviceManager>)getAudioDeviceManager {
+    if (!_audioDeviceManager && _mixerEngine) {
+        _audioDeviceManager = _mixerEngine->getAudioDeviceManager();
+    }
     return _audioDeviceManager;
 }
 
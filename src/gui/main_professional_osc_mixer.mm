@@ -2,6 +2,7 @@
 #import <Foundation/Foundation.h>
 #include "ProfessionalOSCMixer.h"
 #include "OSCMixerEngine.h"
+#include "StartupProfiler.h"
 #include "Version.h"
 #include <memory>
 #include <iostream>
@@ -32,8 +33,11 @@
     }
     
     // Create main mixer window
-    _mainMixer = [[ProfessionalOSCMixer alloc] initWithMixerEngine:_mixerEngine];
-    [_mainMixer showWindow:nil];
+    {
+        auto phase = StartupProfiler::getInstance().phase("gui_setup");
+        _mainMixer = [[ProfessionalOSCMixer alloc] initWithMixerEngine:_mixerEngine];
+        [_mainMixer showWindow:nil];
+    }
     
     std::cout << "✅ Professional OSC Mixer initialized successfully" << std::endl;
     std::cout << "📊 Features:" << std::endl;
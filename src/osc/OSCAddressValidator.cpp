@@ -0,0 +1,520 @@
+#include "OSCAddressValidator.h"
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <map>
+#include <unordered_map>
+
+namespace {
+
+using ByteSet = std::bitset<256>;
+
+// Thrown for syntax the DFA compiler does not handle; the caller falls back to std::regex
+struct Unsupported {};
+
+struct Node {
+    enum class Type { Set, Concat, Alt, Repeat, Empty } type = Type::Empty;
+    int set = -1;
+    int min = 0;
+    int max = -1;   // -1 = unbounded
+    std::vector<std::unique_ptr<Node>> children;
+};
+
+class Parser {
+public:
+    Parser(const std::string& pattern, std::vector<ByteSet>& sets) : pattern_(pattern), sets_(sets) {}
+
+    std::unique_ptr<Node> parse() {
+        auto root = parseAlternation();
+        if (pos_ != pattern_.size()) {
+            throw Unsupported{};    // Unbalanced ')'
+        }
+        return root;
+    }
+
+private:
+    bool atEnd() const { return pos_ >= pattern_.size(); }
+    char peek() const { return pattern_[pos_]; }
+
+    std::unique_ptr<Node> parseAlternation() {
+        auto first = parseConcatenation();
+        if (atEnd() || peek() != '|') {
+            return first;
+        }
+        auto alt = std::make_unique<Node>();
+        alt->type = Node::Type::Alt;
+        alt->children.push_back(std::move(first));
+        while (!atEnd() && peek() == '|') {
+            pos_++;
+            alt->children.push_back(parseConcatenation());
+        }
+        return alt;
+    }
+
+    std::unique_ptr<Node> parseConcatenation() {
+        auto concat = std::make_unique<Node>();
+        concat->type = Node::Type::Concat;
+        while (!atEnd() && peek() != '|' && peek() != ')') {
+            concat->children.push_back(parseRepeat());
+        }
+        return concat;
+    }
+
+    std::unique_ptr<Node> parseRepeat() {
+        auto atom = parseAtom();
+        while (!atEnd()) {
+            int min = 0, max = -1;
+            char c = peek();
+            if (c == '*') {
+                pos_++;
+            } else if (c == '+') {
+                min = 1;
+                pos_++;
+            } else if (c == '?') {
+                max = 1;
+                pos_++;
+            } else if (c == '{') {
+                parseBounds(min, max);
+            } else {
+                break;
+            }
+            if (!atEnd() && peek() == '?') {
+                pos_++;     // Laziness cannot change what a full match accepts
+            }
+            auto repeat = std::make_unique<Node>();
+            repeat->type = Node::Type::Repeat;
+            repeat->min = min;
+            repeat->max = max;
+            repeat->children.push_back(std::move(atom));
+            atom = std::move(repeat);
+        }
+        return atom;
+    }
+
+    void parseBounds(int& min, int& max) {
+        pos_++;     // '{'
+        min = parseNumber();
+        max = min;
+        if (!atEnd() && peek() == ',') {
+            pos_++;
+            max = !atEnd() && peek() == '}' ? -1 : parseNumber();
+        }
+        if (atEnd() || peek() != '}' || (max >= 0 && max < min) || min > 64 || max > 64) {
+            throw Unsupported{};
+        }
+        pos_++;
+    }
+
+    int parseNumber() {
+        if (atEnd() || !std::isdigit(static_cast<unsigned char>(peek()))) {
+            throw Unsupported{};
+        }
+        int value = 0;
+        while (!atEnd() && std::isdigit(static_cast<unsigned char>(peek())) && value < 1000) {
+            value = value * 10 + (pattern_[pos_++] - '0');
+        }
+        return value;
+    }
+
+    std::unique_ptr<Node> parseAtom() {
+        char c = pattern_[pos_++];
+        switch (c) {
+            case '(': {
+                if (!atEnd() && peek() == '?') {
+                    if (pattern_.compare(pos_, 2, "?:") != 0) {
+                        throw Unsupported{};    // Lookaround
+                    }
+                    pos_ += 2;
+                }
+                auto group = parseAlternation();
+                if (atEnd() || peek() != ')') {
+                    throw Unsupported{};
+                }
+                pos_++;
+                return group;
+            }
+            case '[':
+                return makeSet(parseClass());
+            case '.': {
+                ByteSet any;
+                any.set();
+                any.reset('\n');
+                any.reset('\r');
+                return makeSet(any);
+            }
+            case '\\':
+                return makeSet(parseEscape(false));
+            case '*': case '+': case '?': case '{': case '^': case '$':
+                throw Unsupported{};
+            default: {
+                ByteSet single;
+                single.set(static_cast<unsigned char>(c));
+                return makeSet(single);
+            }
+        }
+    }
+
+    ByteSet parseEscape(bool inClass) {
+        if (atEnd()) {
+            throw Unsupported{};
+        }
+        char c = pattern_[pos_++];
+        ByteSet set;
+        switch (c) {
+            case 'd': case 'D':
+                for (int b = '0'; b <= '9'; b++) set.set(b);
+                return c == 'D' ? ~set : set;
+            case 'w': case 'W':
+                for (int b = 0; b < 256; b++) {
+                    if (std::isalnum(b) && b < 128) set.set(b);
+                }
+                set.set('_');
+                return c == 'W' ? ~set : set;
+            case 's': case 'S':
+                for (char b : {' ', '\t', '\n', '\r', '\f', '\v'}) set.set(static_cast<unsigned char>(b));
+                return c == 'S' ? ~set : set;
+            case 'n': set.set('\n'); return set;
+            case 'r': set.set('\r'); return set;
+            case 't': set.set('\t'); return set;
+            case 'f': set.set('\f'); return set;
+            case 'v': set.set('\v'); return set;
+            case '0': set.set(0); return set;
+            case 'b':
+                if (!inClass) throw Unsupported{};  // Word boundary
+                set.set('\b');
+                return set;
+            case 'x': {
+                if (pos_ + 2 > pattern_.size() || !std::isxdigit(static_cast<unsigned char>(pattern_[pos_])) ||
+                    !std::isxdigit(static_cast<unsigned char>(pattern_[pos_ + 1]))) {
+                    throw Unsupported{};
+                }
+                set.set(std::stoi(pattern_.substr(pos_, 2), nullptr, 16));
+                pos_ += 2;
+                return set;
+            }
+            default:
+                if (std::isalnum(static_cast<unsigned char>(c))) {
+                    throw Unsupported{};    // Back-reference, \B, \c, \u ...
+                }
+                set.set(static_cast<unsigned char>(c));
+                return set;
+        }
+    }
+
+    ByteSet parseClass() {
+        ByteSet set;
+        bool negate = !atEnd() && peek() == '^';
+        if (negate) pos_++;
+
+        while (true) {
+            if (atEnd()) {
+                throw Unsupported{};
+            }
+            char c = pattern_[pos_++];
+            if (c == ']') {
+                break;     // "[]" is the empty class, as in ECMAScript
+            }
+            if (c == '[' && !atEnd() && (peek() == ':' || peek() == '=' || peek() == '.')) {
+                throw Unsupported{};    // POSIX classes
+            }
+
+            ByteSet item;
+            int low = -1;
+            if (c == '\\') {
+                item = parseEscape(true);
+                if (item.count() == 1) {
+                    for (int b = 0; b < 256; b++) if (item.test(b)) low = b;
+                }
+            } else {
+                low = static_cast<unsigned char>(c);
+                item.set(low);
+            }
+
+            // Range a-b, unless '-' is the last character of the class
+            if (low >= 0 && pos_ + 1 < pattern_.size() && peek() == '-' && pattern_[pos_ + 1] != ']') {
+                pos_++;
+                char hiChar = pattern_[pos_++];
+                int high = static_cast<unsigned char>(hiChar);
+                if (hiChar == '\\') {
+                    ByteSet hiSet = parseEscape(true);
+                    if (hiSet.count() != 1) throw Unsupported{};
+                    for (int b = 0; b < 256; b++) if (hiSet.test(b)) high = b;
+                }
+                if (high < low) throw Unsupported{};
+                for (int b = low; b <= high; b++) item.set(b);
+            }
+            set |= item;
+        }
+        return negate ? ~set : set;
+    }
+
+    std::unique_ptr<Node> makeSet(const ByteSet& set) {
+        auto node = std::make_unique<Node>();
+        node->type = Node::Type::Set;
+        node->set = static_cast<int>(sets_.size());
+        sets_.push_back(set);
+        return node;
+    }
+
+    const std::string& pattern_;
+    std::vector<ByteSet>& sets_;
+    size_t pos_ = 0;
+};
+
+// Thompson NFA built back to front: emit(node, next) returns the entry state
+struct Nfa {
+    enum class Kind { Set, Split, Match };
+    struct State {
+        Kind kind;
+        int set = -1;
+        int out = -1;
+        int out1 = -1;
+    };
+    static constexpr size_t kMaxStates = 65536;
+
+    std::vector<State> states;
+
+    int add(State state) {
+        if (states.size() >= kMaxStates) {
+            throw Unsupported{};
+        }
+        states.push_back(state);
+        return static_cast<int>(states.size()) - 1;
+    }
+
+    int emit(const Node& node, int next) {
+        switch (node.type) {
+            case Node::Type::Empty:
+                return next;
+            case Node::Type::Set:
+                return add({Kind::Set, node.set, next, -1});
+            case Node::Type::Concat:
+                for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) {
+                    next = emit(**it, next);
+                }
+                return next;
+            case Node::Type::Alt: {
+                int entry = emit(*node.children.back(), next);
+                for (auto it = node.children.rbegin() + 1; it != node.children.rend(); ++it) {
+                    int branch = emit(**it, next);
+                    entry = add({Kind::Split, -1, branch, entry});
+                }
+                return entry;
+            }
+            case Node::Type::Repeat: {
+                const Node& body = *node.children.front();
+                int entry = next;
+                if (node.max < 0) {
+                    int loop = add({Kind::Split, -1, -1, next});
+                    int start = emit(body, loop);
+                    states[loop].out = start;
+                    entry = loop;
+                } else {
+                    for (int i = node.min; i < node.max; i++) {
+                        int start = emit(body, entry);
+                        entry = add({Kind::Split, -1, start, next});
+                    }
+                }
+                for (int i = 0; i < node.min; i++) {
+                    entry = emit(body, entry);
+                }
+                return entry;
+            }
+        }
+        return next;
+    }
+
+    // Set and Match states reachable through splits, sorted
+    std::vector<int> closure(const std::vector<int>& seeds) const {
+        std::vector<int> result;
+        std::vector<uint8_t> visited(states.size(), 0);
+        std::vector<int> stack(seeds);
+        while (!stack.empty()) {
+            int s = stack.back();
+            stack.pop_back();
+            if (s < 0 || visited[s]) continue;
+            visited[s] = 1;
+            if (states[s].kind == Kind::Split) {
+                stack.push_back(states[s].out);
+                stack.push_back(states[s].out1);
+            } else {
+                result.push_back(s);
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+} // namespace
+
+void OSCAddressValidator::compile(const std::string& pattern, const std::vector<std::string>& allowedAddresses) {
+    fallback_.reset();
+    if (!compileDfa(pattern)) {
+        fallback_ = std::make_unique<std::regex>(pattern);
+    }
+
+    // Build the trie with child maps, then flatten breadth-first so each node's edges are contiguous
+    struct BuildNode {
+        std::map<uint8_t, size_t> children;
+        bool terminal = false;
+    };
+    std::vector<BuildNode> build(1);
+    for (const auto& address : allowedAddresses) {
+        size_t node = 0;
+        for (unsigned char byte : address) {
+            auto it = build[node].children.find(byte);
+            if (it == build[node].children.end()) {
+                build.emplace_back();
+                it = build[node].children.emplace(byte, build.size() - 1).first;
+            }
+            node = it->second;
+        }
+        build[node].terminal = true;
+    }
+
+    trieNodes_.assign(build.size(), TrieNode{});
+    trieEdges_.clear();
+    std::vector<size_t> order{0};
+    std::vector<uint32_t> flatIndex(build.size(), 0);
+    for (size_t i = 0; i < order.size(); i++) {
+        const auto& source = build[order[i]];
+        TrieNode& node = trieNodes_[i];
+        node.terminal = source.terminal;
+        node.firstEdge = static_cast<uint32_t>(trieEdges_.size());
+        node.edgeCount = static_cast<uint32_t>(source.children.size());
+        for (const auto& child : source.children) {
+            flatIndex[child.second] = static_cast<uint32_t>(order.size());
+            order.push_back(child.second);
+            trieEdges_.push_back({child.first, flatIndex[child.second]});
+        }
+    }
+    if (allowedAddresses.empty()) {
+        trieNodes_.clear();
+    }
+}
+
+bool OSCAddressValidator::compileDfa(const std::string& pattern) {
+    transitions_.clear();
+    accepting_.clear();
+    classCount_ = 0;
+
+    // The whole address must match, so anchors at the ends are redundant
+    std::string body = pattern;
+    if (!body.empty() && body.front() == '^') {
+        body.erase(0, 1);
+    }
+    if (!body.empty() && body.back() == '$') {
+        size_t backslashes = 0;
+        for (size_t i = body.size() - 1; i > 0 && body[i - 1] == '\\'; i--) backslashes++;
+        if (backslashes % 2 == 0) {
+            body.pop_back();
+        }
+    }
+
+    std::vector<ByteSet> sets;
+    Nfa nfa;
+    int start;
+    try {
+        auto root = Parser(body, sets).parse();
+        int match = nfa.add({Nfa::Kind::Match});
+        start = nfa.emit(*root, match);
+    } catch (const Unsupported&) {
+        return false;
+    }
+
+    // Bytes that every set treats alike share a column
+    std::unordered_map<std::string, uint8_t> classes;
+    std::vector<uint8_t> representative;
+    for (int b = 0; b < 256; b++) {
+        std::string signature(sets.size(), '0');
+        for (size_t s = 0; s < sets.size(); s++) {
+            if (sets[s].test(b)) signature[s] = '1';
+        }
+        auto it = classes.find(signature);
+        if (it == classes.end()) {
+            it = classes.emplace(signature, static_cast<uint8_t>(representative.size())).first;
+            representative.push_back(static_cast<uint8_t>(b));
+        }
+        byteClass_[b] = it->second;
+    }
+    classCount_ = representative.size();
+
+    // Subset construction
+    std::map<std::vector<int>, int32_t> ids;
+    std::vector<std::vector<int>> pending{nfa.closure({start})};
+    ids.emplace(pending.front(), 0);
+    for (size_t d = 0; d < pending.size(); d++) {
+        std::vector<int> current = pending[d];
+        bool accepts = false;
+        for (int s : current) {
+            accepts |= nfa.states[s].kind == Nfa::Kind::Match;
+        }
+        accepting_.push_back(accepts);
+        transitions_.resize((d + 1) * classCount_, -1);
+
+        for (size_t c = 0; c < classCount_; c++) {
+            std::vector<int> moved;
+            for (int s : current) {
+                const auto& state = nfa.states[s];
+                if (state.kind == Nfa::Kind::Set && sets[state.set].test(representative[c])) {
+                    moved.push_back(state.out);
+                }
+            }
+            if (moved.empty()) {
+                continue;
+            }
+            auto target = nfa.closure(moved);
+            auto it = ids.find(target);
+            if (it == ids.end()) {
+                if (pending.size() >= kMaxStates) {
+                    transitions_.clear();
+                    accepting_.clear();
+                    classCount_ = 0;
+                    return false;
+                }
+                it = ids.emplace(target, static_cast<int32_t>(pending.size())).first;
+                pending.push_back(std::move(target));
+            }
+            transitions_[d * classCount_ + c] = it->second;
+        }
+    }
+    return true;
+}
+
+bool OSCAddressValidator::matchesPattern(const char* address, size_t length) const {
+    if (fallback_) {
+        return std::regex_match(address, address + length, *fallback_);
+    }
+    if (accepting_.empty()) {
+        return true;
+    }
+    int32_t state = 0;
+    for (size_t i = 0; i < length; i++) {
+        state = transitions_[state * classCount_ + byteClass_[static_cast<unsigned char>(address[i])]];
+        if (state < 0) {
+            return false;
+        }
+    }
+    return accepting_[state] != 0;
+}
+
+bool OSCAddressValidator::isWhitelisted(const char* address, size_t length) const {
+    if (trieNodes_.empty()) {
+        return false;
+    }
+    uint32_t node = 0;
+    for (size_t i = 0; i < length; i++) {
+        const TrieNode& current = trieNodes_[node];
+        auto first = trieEdges_.begin() + current.firstEdge;
+        auto last = first + current.edgeCount;
+        uint8_t byte = static_cast<uint8_t>(address[i]);
+        auto edge = std::lower_bound(first, last, byte,
+                                     [](const TrieEdge& e, uint8_t value) { return e.byte < value; });
+        if (edge == last || edge->byte != byte) {
+            return false;
+        }
+        node = edge->child;
+    }
+    return trieNodes_[node].terminal;
+}
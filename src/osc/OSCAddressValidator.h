@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief OSC address whitelist compiled once, checked in linear time
+ *
+ * The address pattern is compiled to a DFA over byte classes: each address
+ * byte costs one table lookup and validation never allocates. The exact
+ * whitelist becomes a flat trie. Supported syntax is the common ECMAScript
+ * subset: literals, '.', bracket classes with ranges and negation, \d \w \s
+ * and their negations, escapes, groups (including "(?:"), '|', '*', '+',
+ * '?', {m}, {m,} and {m,n}. Anchors are accepted only at the pattern ends,
+ * since the whole address must match. Anything else (back-references,
+ * lookaround, word boundaries) or a DFA over kMaxStates falls back to
+ * std::regex, compiled once.
+ */
+class OSCAddressValidator {
+public:
+    static constexpr size_t kMaxStates = 4096;
+
+    OSCAddressValidator() = default;
+
+    // Throws std::regex_error if the pattern is invalid for std::regex as well
+    void compile(const std::string& pattern, const std::vector<std::string>& allowedAddresses);
+
+    // Full match against the pattern; true if no pattern was compiled
+    bool matchesPattern(const char* address, size_t length) const;
+    bool matchesPattern(const std::string& address) const { return matchesPattern(address.data(), address.size()); }
+
+    // Exact match against the whitelist
+    bool isWhitelisted(const char* address, size_t length) const;
+    bool isWhitelisted(const std::string& address) const { return isWhitelisted(address.data(), address.size()); }
+
+    bool usesDfa() const { return !fallback_; }
+    size_t getStateCount() const { return accepting_.size(); }
+    size_t getByteClassCount() const { return classCount_; }
+
+private:
+    bool compileDfa(const std::string& pattern);
+
+    // DFA: transitions_[state * classCount_ + byteClass_[byte]], -1 = reject
+    uint8_t byteClass_[256] = {};
+    size_t classCount_ = 0;
+    std::vector<int32_t> transitions_;
+    std::vector<uint8_t> accepting_;
+    std::unique_ptr<std::regex> fallback_;
+
+    // Trie: node children are edges_[firstEdge, firstEdge + edgeCount), sorted by byte
+    struct TrieNode {
+        uint32_t firstEdge = 0;
+        uint32_t edgeCount = 0;
+        bool terminal = false;
+    };
+    struct TrieEdge {
+        uint8_t byte;
+        uint32_t child;
+    };
+    std::vector<TrieNode> trieNodes_;
+    std::vector<TrieEdge> trieEdges_;
+};
@@ -0,0 +1,213 @@
+#include "OSCCrypto.h"
+#include <cstring>
+
+#ifdef CVOSC_HAVE_OPENSSL
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <openssl/rand.h>
+#endif
+
+bool OSCReplayWindow::accept(uint64_t sequence) {
+    if (!started_ || sequence > highest_) {
+        uint64_t shift = started_ ? sequence - highest_ : kWindowSize;
+        if (shift >= kWindowSize) {
+            bits_.fill(0);
+        } else {
+            // Slide the bitmap: bit i means "highest - i was seen"
+            const size_t wordShift = shift / 64;
+            const unsigned bitShift = shift % 64;
+            for (size_t i = bits_.size(); i-- > 0;) {
+                uint64_t word = 0;
+                if (i >= wordShift) {
+                    size_t source = i - wordShift;
+                    word = bits_[source] << bitShift;
+                    if (bitShift && source > 0) {
+                        word |= bits_[source - 1] >> (64 - bitShift);
+                    }
+                }
+                bits_[i] = word;
+            }
+        }
+        highest_ = sequence;
+        started_ = true;
+        bits_[0] |= 1;
+        return true;
+    }
+
+    uint64_t offset = highest_ - sequence;
+    if (offset >= kWindowSize) {
+        return false;   // Too old to tell
+    }
+    uint64_t& word = bits_[offset / 64];
+    uint64_t bit = uint64_t(1) << (offset % 64);
+    if (word & bit) {
+        return false;
+    }
+    word |= bit;
+    return true;
+}
+
+void OSCReplayWindow::reset() {
+    highest_ = 0;
+    started_ = false;
+    bits_.fill(0);
+}
+
+#ifdef CVOSC_HAVE_OPENSSL
+
+bool OSCCrypto::isAvailable() {
+    return true;
+}
+
+bool OSCCrypto::randomBytes(uint8_t* out, size_t length) {
+    return RAND_bytes(out, static_cast<int>(length)) == 1;
+}
+
+bool OSCCrypto::deriveKey(const uint8_t* secret, size_t secretLength, const char* salt, const char* info,
+                          uint8_t* out, size_t outLength) {
+    return deriveKey(secret, secretLength, reinterpret_cast<const uint8_t*>(salt), std::strlen(salt), info, out,
+                     outLength);
+}
+
+bool OSCCrypto::deriveKey(const uint8_t* secret, size_t secretLength, const uint8_t* salt, size_t saltLength,
+                          const char* info, uint8_t* out, size_t outLength) {
+    EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+    if (!ctx) {
+        return false;
+    }
+    size_t length = outLength;
+    bool ok = EVP_PKEY_derive_init(ctx) > 0 && EVP_PKEY_CTX_set_hkdf_md(ctx, EVP_sha256()) > 0 &&
+              EVP_PKEY_CTX_set1_hkdf_salt(ctx, salt, static_cast<int>(saltLength)) > 0 &&
+              EVP_PKEY_CTX_set1_hkdf_key(ctx, secret, static_cast<int>(secretLength)) > 0 &&
+              EVP_PKEY_CTX_add1_hkdf_info(ctx, reinterpret_cast<const unsigned char*>(info),
+                                          static_cast<int>(std::strlen(info))) > 0 &&
+              EVP_PKEY_derive(ctx, out, &length) > 0 && length == outLength;
+    EVP_PKEY_CTX_free(ctx);
+    return ok;
+}
+
+bool OSCCrypto::constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length) {
+    return CRYPTO_memcmp(a, b, length) == 0;
+}
+
+struct OSCAeadCipher::Contexts {
+    EVP_CIPHER_CTX* seal = EVP_CIPHER_CTX_new();
+    EVP_CIPHER_CTX* open = EVP_CIPHER_CTX_new();
+    ~Contexts() {
+        EVP_CIPHER_CTX_free(seal);
+        EVP_CIPHER_CTX_free(open);
+    }
+};
+
+OSCAeadCipher::OSCAeadCipher() : contexts_(std::make_unique<Contexts>()) {}
+OSCAeadCipher::~OSCAeadCipher() = default;
+
+bool OSCAeadCipher::setKey(Algorithm algorithm, const uint8_t* key) {
+    const EVP_CIPHER* cipher = algorithm == Algorithm::AES_256_GCM ? EVP_aes_256_gcm() : EVP_chacha20_poly1305();
+    int nonceLength = static_cast<int>(kNonceSize);
+    keyed_ = contexts_->seal && contexts_->open &&
+             EVP_EncryptInit_ex(contexts_->seal, cipher, nullptr, nullptr, nullptr) == 1 &&
+             EVP_CIPHER_CTX_ctrl(contexts_->seal, EVP_CTRL_AEAD_SET_IVLEN, nonceLength, nullptr) == 1 &&
+             EVP_EncryptInit_ex(contexts_->seal, nullptr, nullptr, key, nullptr) == 1 &&
+             EVP_DecryptInit_ex(contexts_->open, cipher, nullptr, nullptr, nullptr) == 1 &&
+             EVP_CIPHER_CTX_ctrl(contexts_->open, EVP_CTRL_AEAD_SET_IVLEN, nonceLength, nullptr) == 1 &&
+             EVP_DecryptInit_ex(contexts_->open, nullptr, nullptr, key, nullptr) == 1;
+    return keyed_;
+}
+
+bool OSCAeadCipher::seal(const uint8_t* nonce, const uint8_t* aad, size_t aadLength, const uint8_t* in,
+                         size_t length, uint8_t* out, uint8_t* tag) {
+    if (!keyed_) return false;
+    EVP_CIPHER_CTX* ctx = contexts_->seal;
+    int written = 0;
+    int finalWritten = 0;
+    // A null key keeps the existing key schedule; only the nonce changes
+    return EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, nonce) == 1 &&
+           (aadLength == 0 || EVP_EncryptUpdate(ctx, nullptr, &written, aad, static_cast<int>(aadLength)) == 1) &&
+           EVP_EncryptUpdate(ctx, out, &written, in, static_cast<int>(length)) == 1 &&
+           EVP_EncryptFinal_ex(ctx, out + written, &finalWritten) == 1 &&
+           EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, static_cast<int>(kTagSize), tag) == 1;
+}
+
+bool OSCAeadCipher::open(const uint8_t* nonce, const uint8_t* aad, size_t aadLength, const uint8_t* in,
+                         size_t length, const uint8_t* tag, uint8_t* out) {
+    if (!keyed_) return false;
+    EVP_CIPHER_CTX* ctx = contexts_->open;
+    int written = 0;
+    int finalWritten = 0;
+    return EVP_DecryptInit_ex(ctx, nullptr, nullptr, nullptr, nonce) == 1 &&
+           (aadLength == 0 || EVP_DecryptUpdate(ctx, nullptr, &written, aad, static_cast<int>(aadLength)) == 1) &&
+           EVP_DecryptUpdate(ctx, out, &written, in, static_cast<int>(length)) == 1 &&
+           EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, static_cast<int>(kTagSize),
+                               const_cast<uint8_t*>(tag)) == 1 &&
+           EVP_DecryptFinal_ex(ctx, out + written, &finalWritten) == 1;
+}
+
+struct OSCHmacSha256::Context {
+    EVP_MAC* mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+    EVP_MAC_CTX* ctx = mac ? EVP_MAC_CTX_new(mac) : nullptr;
+    ~Context() {
+        EVP_MAC_CTX_free(ctx);
+        EVP_MAC_free(mac);
+    }
+};
+
+OSCHmacSha256::OSCHmacSha256() : context_(std::make_unique<Context>()) {}
+OSCHmacSha256::~OSCHmacSha256() = default;
+
+bool OSCHmacSha256::setKey(const uint8_t* key, size_t length) {
+    char digest[] = "SHA256";
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+        OSSL_PARAM_construct_end(),
+    };
+    keyed_ = context_->ctx && EVP_MAC_init(context_->ctx, key, length, params) == 1;
+    return keyed_;
+}
+
+bool OSCHmacSha256::compute(const uint8_t* first, size_t firstLength, const uint8_t* second, size_t secondLength,
+                            uint8_t* mac) {
+    if (!keyed_) return false;
+    size_t length = 0;
+    // Re-initialising without a key restarts the MAC with the key already set
+    return EVP_MAC_init(context_->ctx, nullptr, 0, nullptr) == 1 &&
+           EVP_MAC_update(context_->ctx, first, firstLength) == 1 &&
+           (secondLength == 0 || EVP_MAC_update(context_->ctx, second, secondLength) == 1) &&
+           EVP_MAC_final(context_->ctx, mac, &length, OSCCrypto::kMacSize) == 1 && length == OSCCrypto::kMacSize;
+}
+
+#else // No OpenSSL: fail closed
+
+bool OSCCrypto::isAvailable() { return false; }
+bool OSCCrypto::randomBytes(uint8_t*, size_t) { return false; }
+bool OSCCrypto::deriveKey(const uint8_t*, size_t, const char*, const char*, uint8_t*, size_t) { return false; }
+bool OSCCrypto::deriveKey(const uint8_t*, size_t, const uint8_t*, size_t, const char*, uint8_t*, size_t) {
+    return false;
+}
+
+bool OSCCrypto::constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length) {
+    uint8_t difference = 0;
+    for (size_t i = 0; i < length; i++) difference |= a[i] ^ b[i];
+    return difference == 0;
+}
+
+struct OSCAeadCipher::Contexts {};
+OSCAeadCipher::OSCAeadCipher() : contexts_(std::make_unique<Contexts>()) {}
+OSCAeadCipher::~OSCAeadCipher() = default;
+bool OSCAeadCipher::setKey(Algorithm, const uint8_t*) { return false; }
+bool OSCAeadCipher::seal(const uint8_t*, const uint8_t*, size_t, const uint8_t*, size_t, uint8_t*, uint8_t*) {
+    return false;
+}
+bool OSCAeadCipher::open(const uint8_t*, const uint8_t*, size_t, const uint8_t*, size_t, const uint8_t*, uint8_t*) {
+    return false;
+}
+
+struct OSCHmacSha256::Context {};
+OSCHmacSha256::OSCHmacSha256() : context_(std::make_unique<Context>()) {}
+OSCHmacSha256::~OSCHmacSha256() = default;
+bool OSCHmacSha256::setKey(const uint8_t*, size_t) { return false; }
+bool OSCHmacSha256::compute(const uint8_t*, size_t, const uint8_t*, size_t, uint8_t*) { return false; }
+
+#endif
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Crypto primitives for secured OSC, backed by OpenSSL libcrypto
+ *
+ * Thin wrappers over the EVP AEAD and HMAC implementations, which are
+ * constant-time and widely reviewed. The cipher and MAC contexts keep their
+ * key schedule between packets, so sealing or opening a packet allocates
+ * nothing. Contexts are not thread-safe; callers serialize per instance.
+ * Built without OpenSSL (CVOSC_HAVE_OPENSSL unset), every operation fails
+ * and isAvailable() is false, so secured traffic fails closed.
+ */
+class OSCCrypto {
+public:
+    static constexpr size_t kKeySize = 32;
+    static constexpr size_t kMacSize = 32;
+
+    static bool isAvailable();
+    static bool randomBytes(uint8_t* out, size_t length);
+    // HKDF-SHA256
+    static bool deriveKey(const uint8_t* secret, size_t secretLength, const char* salt, const char* info,
+                          uint8_t* out, size_t outLength);
+    static bool deriveKey(const uint8_t* secret, size_t secretLength, const uint8_t* salt, size_t saltLength,
+                          const char* info, uint8_t* out, size_t outLength);
+    static bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length);
+};
+
+class OSCAeadCipher {
+public:
+    enum class Algorithm { AES_256_GCM, CHACHA20_POLY1305 };
+    static constexpr size_t kNonceSize = 12;
+    static constexpr size_t kTagSize = 16;
+
+    OSCAeadCipher();
+    ~OSCAeadCipher();
+    OSCAeadCipher(const OSCAeadCipher&) = delete;
+    OSCAeadCipher& operator=(const OSCAeadCipher&) = delete;
+
+    bool setKey(Algorithm algorithm, const uint8_t* key);
+    bool hasKey() const { return keyed_; }
+
+    // out may alias in
+    bool seal(const uint8_t* nonce, const uint8_t* aad, size_t aadLength, const uint8_t* in, size_t length,
+              uint8_t* out, uint8_t* tag);
+    // Fails, leaving out unspecified, unless the tag verifies
+    bool open(const uint8_t* nonce, const uint8_t* aad, size_t aadLength, const uint8_t* in, size_t length,
+              const uint8_t* tag, uint8_t* out);
+
+private:
+    struct Contexts;
+    std::unique_ptr<Contexts> contexts_;
+    bool keyed_ = false;
+};
+
+class OSCHmacSha256 {
+public:
+    OSCHmacSha256();
+    ~OSCHmacSha256();
+    OSCHmacSha256(const OSCHmacSha256&) = delete;
+    OSCHmacSha256& operator=(const OSCHmacSha256&) = delete;
+
+    bool setKey(const uint8_t* key, size_t length);
+    // MAC over the concatenation of two buffers (header and payload)
+    bool compute(const uint8_t* first, size_t firstLength, const uint8_t* second, size_t secondLength,
+                 uint8_t* mac);
+
+private:
+    struct Context;
+    std::unique_ptr<Context> context_;
+    bool keyed_ = false;
+};
+
+/**
+ * @brief Anti-replay sliding window over 64-bit sequence numbers (RFC 4303 style)
+ *
+ * A fixed bitmap of the last kWindowSize sequence numbers below the highest
+ * seen: constant memory and constant-time checks, unlike a set of nonces.
+ */
+class OSCReplayWindow {
+public:
+    static constexpr size_t kWindowSize = 1024;
+
+    // True the first time a sequence number inside the window is seen
+    bool accept(uint64_t sequence);
+    void reset();
+    uint64_t getHighest() const { return highest_; }
+
+private:
+    uint64_t highest_ = 0;
+    bool started_ = false;
+    std::array<uint64_t, kWindowSize / 64> bits_{};
+};
@@ -0,0 +1,403 @@
+#include "OSCEventLoop.h"
+#include <cerrno>
+#include <future>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#elif defined(__APPLE__)
+#include <sys/event.h>
+#endif
+
+namespace {
+
+constexpr int kMaxEvents = 64;
+
+void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+} // namespace
+
+OSCEventLoop::OSCEventLoop() {
+    if (pipe(wakePipe_) == 0) {
+        setNonBlocking(wakePipe_[0]);
+        setNonBlocking(wakePipe_[1]);
+    }
+#if defined(__linux__)
+    pollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (pollFd_ >= 0) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = wakePipe_[0];
+        epoll_ctl(pollFd_, EPOLL_CTL_ADD, wakePipe_[0], &event);
+    }
+#elif defined(__APPLE__)
+    pollFd_ = kqueue();
+    if (pollFd_ >= 0) {
+        fcntl(pollFd_, F_SETFD, FD_CLOEXEC);
+        struct kevent change;
+        EV_SET(&change, wakePipe_[0], EVFILT_READ, EV_ADD, 0, 0, nullptr);
+        kevent(pollFd_, &change, 1, nullptr, 0, nullptr);
+    }
+#endif
+}
+
+OSCEventLoop::~OSCEventLoop() {
+    stop();
+    if (pollFd_ >= 0) close(pollFd_);
+    if (wakePipe_[0] >= 0) close(wakePipe_[0]);
+    if (wakePipe_[1] >= 0) close(wakePipe_[1]);
+}
+
+OSCEventLoop& OSCEventLoop::shared() {
+    static OSCEventLoop loop;
+    loop.start();
+    return loop;
+}
+
+bool OSCEventLoop::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_) {
+        return true;
+    }
+    if (wakePipe_[0] < 0) {
+        return false;
+    }
+    running_ = true;
+    thread_ = std::thread(&OSCEventLoop::run, this);
+    return true;
+}
+
+void OSCEventLoop::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    wake();
+    if (thread_.joinable()) {
+        if (isLoopThread()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+}
+
+bool OSCEventLoop::isLoopThread() const {
+    return std::this_thread::get_id() == loopThreadId_.load();
+}
+
+const char* OSCEventLoop::getBackendName() const {
+#if defined(__linux__)
+    if (pollFd_ >= 0) return "epoll";
+#elif defined(__APPLE__)
+    if (pollFd_ >= 0) return "kqueue";
+#endif
+    return "poll";
+}
+
+bool OSCEventLoop::add(int fd, uint32_t events, IoCallback callback) {
+    auto handler = std::make_shared<Handler>();
+    handler->callback = std::move(callback);
+    handler->events = events;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!handlers_.emplace(fd, handler).second) {
+            return false;
+        }
+    }
+    if (!registerFd(fd, events, true)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        handlers_.erase(fd);
+        return false;
+    }
+    return true;
+}
+
+bool OSCEventLoop::modify(int fd, uint32_t events) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = handlers_.find(fd);
+        if (it == handlers_.end()) {
+            return false;
+        }
+        if (it->second->events == events) {
+            return true;
+        }
+        it->second->events = events;
+    }
+    return registerFd(fd, events, false);
+}
+
+void OSCEventLoop::remove(int fd) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (handlers_.erase(fd) == 0) {
+            return;
+        }
+    }
+    unregisterFd(fd);
+}
+
+size_t OSCEventLoop::getHandlerCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return handlers_.size();
+}
+
+void OSCEventLoop::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    wake();
+}
+
+void OSCEventLoop::runSync(Task task) {
+    if (isLoopThread()) {
+        task();
+        return;
+    }
+    std::promise<void> done;
+    auto finished = done.get_future();
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            tasks_.push_back([&] {
+                task();
+                done.set_value();
+            });
+            queued = true;
+        }
+    }
+    if (!queued) {
+        task();
+        return;
+    }
+    wake();
+    finished.wait();
+}
+
+OSCEventLoop::TimerId OSCEventLoop::runAfter(std::chrono::milliseconds delay, Task task) {
+    TimerId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = nextTimerId_++;
+        auto deadline = Clock::now() + delay;
+        timers_.emplace(std::make_pair(deadline, id), std::move(task));
+        timerDeadlines_.emplace(id, deadline);
+    }
+    wake();
+    return id;
+}
+
+void OSCEventLoop::cancelTimer(TimerId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = timerDeadlines_.find(id);
+    if (it != timerDeadlines_.end()) {
+        timers_.erase(std::make_pair(it->second, id));
+        timerDeadlines_.erase(it);
+    }
+}
+
+void OSCEventLoop::wake() {
+    if (!wakePending_.exchange(true)) {
+        char byte = 1;
+        (void)!write(wakePipe_[1], &byte, 1);
+    }
+}
+
+int OSCEventLoop::nextTimeoutMs() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!tasks_.empty()) {
+        return 0;
+    }
+    if (timers_.empty()) {
+        return -1;
+    }
+    auto remaining = timers_.begin()->first.first - Clock::now();
+    if (remaining <= Clock::duration::zero()) {
+        return 0;
+    }
+    // Round up so a timer is never woken for just before its deadline
+    return static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(remaining).count());
+}
+
+void OSCEventLoop::run() {
+    loopThreadId_ = std::this_thread::get_id();
+    while (running_) {
+        waitForEvents(nextTimeoutMs());
+        runTasksAndTimers();
+    }
+    // Tasks queued before stop() still run, so runSync() callers are released
+    runTasksAndTimers();
+    loopThreadId_ = std::thread::id();
+}
+
+void OSCEventLoop::runTasksAndTimers() {
+    std::vector<Task> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready.swap(tasks_);
+        auto now = Clock::now();
+        while (!timers_.empty() && timers_.begin()->first.first <= now) {
+            auto it = timers_.begin();
+            timerDeadlines_.erase(it->first.second);
+            ready.push_back(std::move(it->second));
+            timers_.erase(it);
+        }
+    }
+    for (auto& task : ready) {
+        task();
+    }
+}
+
+void OSCEventLoop::dispatch(int fd, uint32_t events) {
+    std::shared_ptr<Handler> handler;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = handlers_.find(fd);
+        if (it == handlers_.end()) {
+            return;   // Removed by an earlier callback in this batch
+        }
+        handler = it->second;
+        events &= handler->events;
+    }
+    if (events) {
+        handler->callback(events);
+    }
+}
+
+#if defined(__linux__)
+
+bool OSCEventLoop::registerFd(int fd, uint32_t events, bool added) {
+    if (pollFd_ < 0) {
+        wake();
+        return true;
+    }
+    epoll_event event{};
+    event.events = ((events & Readable) ? EPOLLIN : 0u) | ((events & Writable) ? EPOLLOUT : 0u);
+    event.data.fd = fd;
+    return epoll_ctl(pollFd_, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event) == 0;
+}
+
+void OSCEventLoop::unregisterFd(int fd) {
+    if (pollFd_ < 0) {
+        wake();
+        return;
+    }
+    epoll_ctl(pollFd_, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+#elif defined(__APPLE__)
+
+bool OSCEventLoop::registerFd(int fd, uint32_t events, bool) {
+    if (pollFd_ < 0) {
+        wake();
+        return true;
+    }
+    // Both filters stay registered; interest changes only enable or disable them
+    struct kevent changes[2];
+    EV_SET(&changes[0], fd, EVFILT_READ, EV_ADD | ((events & Readable) ? EV_ENABLE : EV_DISABLE), 0, 0, nullptr);
+    EV_SET(&changes[1], fd, EVFILT_WRITE, EV_ADD | ((events & Writable) ? EV_ENABLE : EV_DISABLE), 0, 0, nullptr);
+    return kevent(pollFd_, changes, 2, nullptr, 0, nullptr) == 0;
+}
+
+void OSCEventLoop::unregisterFd(int fd) {
+    if (pollFd_ < 0) {
+        wake();
+        return;
+    }
+    struct kevent changes[2];
+    EV_SET(&changes[0], fd, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+    EV_SET(&changes[1], fd, EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+    kevent(pollFd_, changes, 2, nullptr, 0, nullptr);
+}
+
+#else
+
+bool OSCEventLoop::registerFd(int, uint32_t, bool) {
+    wake();   // The poll set is rebuilt from handlers_ on every wait
+    return true;
+}
+
+void OSCEventLoop::unregisterFd(int) {
+    wake();
+}
+
+#endif
+
+void OSCEventLoop::waitForEvents(int timeoutMs) {
+    auto drainWake = [this] {
+        wakePending_ = false;
+        char buffer[64];
+        while (read(wakePipe_[0], buffer, sizeof(buffer)) > 0) {
+        }
+    };
+
+#if defined(__linux__)
+    if (pollFd_ >= 0) {
+        epoll_event events[kMaxEvents];
+        int count = epoll_wait(pollFd_, events, kMaxEvents, timeoutMs);
+        for (int i = 0; i < count; i++) {
+            int fd = events[i].data.fd;
+            if (fd == wakePipe_[0]) {
+                drainWake();
+                continue;
+            }
+            uint32_t flags = events[i].events;
+            uint32_t ready = 0;
+            if (flags & (EPOLLIN | EPOLLHUP | EPOLLERR)) ready |= Readable;
+            if (flags & (EPOLLOUT | EPOLLHUP | EPOLLERR)) ready |= Writable;
+            dispatch(fd, ready);
+        }
+        return;
+    }
+#elif defined(__APPLE__)
+    if (pollFd_ >= 0) {
+        struct kevent events[kMaxEvents];
+        timespec timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+        int count = kevent(pollFd_, nullptr, 0, events, kMaxEvents, timeoutMs < 0 ? nullptr : &timeout);
+        for (int i = 0; i < count; i++) {
+            int fd = static_cast<int>(events[i].ident);
+            if (fd == wakePipe_[0]) {
+                drainWake();
+                continue;
+            }
+            uint32_t ready = events[i].filter == EVFILT_WRITE ? Writable : Readable;
+            if (events[i].flags & EV_ERROR) ready = Readable | Writable;
+            dispatch(fd, ready);
+        }
+        return;
+    }
+#endif
+
+    std::vector<pollfd> fds = {{wakePipe_[0], POLLIN, 0}};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [fd, handler] : handlers_) {
+            short interest = ((handler->events & Readable) ? POLLIN : 0) | ((handler->events & Writable) ? POLLOUT : 0);
+            fds.push_back({fd, interest, 0});
+        }
+    }
+    if (poll(fds.data(), fds.size(), timeoutMs) <= 0) {
+        return;
+    }
+    if (fds[0].revents) {
+        drainWake();
+    }
+    for (size_t i = 1; i < fds.size(); i++) {
+        short flags = fds[i].revents;
+        uint32_t ready = 0;
+        if (flags & (POLLIN | POLLHUP | POLLERR)) ready |= Readable;
+        if (flags & (POLLOUT | POLLHUP | POLLERR)) ready |= Writable;
+        if (ready) dispatch(fds[i].fd, ready);
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Single-threaded readiness loop for OSC sockets
+ *
+ * Uses epoll on Linux and kqueue on macOS (poll() elsewhere). Sockets are
+ * registered with a callback that runs on the loop thread when they become
+ * readable or writable; tasks and timers run on the same thread, so state
+ * touched only from callbacks needs no locking. Registration, posting and
+ * timers may be used from any thread. To tear down state a callback uses,
+ * do it inside runSync(), which waits until the loop has executed it.
+ */
+class OSCEventLoop {
+public:
+    enum : uint32_t {
+        Readable = 1,
+        Writable = 2
+    };
+    using IoCallback = std::function<void(uint32_t events)>;
+    using Task = std::function<void()>;
+    using TimerId = uint64_t;
+
+    OSCEventLoop();
+    ~OSCEventLoop();
+    OSCEventLoop(const OSCEventLoop&) = delete;
+    OSCEventLoop& operator=(const OSCEventLoop&) = delete;
+
+    // Process-wide loop shared by network transports, started on first use
+    static OSCEventLoop& shared();
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(); }
+    bool isLoopThread() const;
+    const char* getBackendName() const;
+
+    // fd must be nonblocking; the callback runs on the loop thread
+    bool add(int fd, uint32_t events, IoCallback callback);
+    bool modify(int fd, uint32_t events);
+    void remove(int fd);
+    size_t getHandlerCount() const;
+
+    void post(Task task);
+    // Runs task on the loop thread and waits for it; inline when already there or stopped
+    void runSync(Task task);
+    TimerId runAfter(std::chrono::milliseconds delay, Task task);
+    void cancelTimer(TimerId id);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Handler {
+        IoCallback callback;
+        uint32_t events = 0;
+    };
+
+    int pollFd_ = -1;                       // epoll or kqueue descriptor
+    int wakePipe_[2] = {-1, -1};
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> wakePending_{false};
+    std::atomic<std::thread::id> loopThreadId_{};
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, std::shared_ptr<Handler>> handlers_;
+    std::vector<Task> tasks_;
+    std::map<std::pair<Clock::time_point, TimerId>, Task> timers_;
+    std::unordered_map<TimerId, Clock::time_point> timerDeadlines_;
+    TimerId nextTimerId_ = 1;
+
+    void run();
+    void wake();
+    int nextTimeoutMs();
+    void runTasksAndTimers();
+    void dispatch(int fd, uint32_t events);
+    bool registerFd(int fd, uint32_t events, bool added);
+    void unregisterFd(int fd);
+    void waitForEvents(int timeoutMs);
+};
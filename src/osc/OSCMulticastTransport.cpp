@@ -0,0 +1,295 @@
+#include "OSCMulticastTransport.h"
+#include "OSCPacket.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <unistd.h>
+
+namespace {
+
+// Resolves an interface name or local address to an IPv4 address
+bool interfaceAddress4(const std::string& interfaceName, in_addr& address) {
+    if (interfaceName.empty()) {
+        address.s_addr = htonl(INADDR_ANY);
+        return true;
+    }
+    if (inet_pton(AF_INET, interfaceName.c_str(), &address) == 1) {
+        return true;
+    }
+    ifaddrs* interfaces = nullptr;
+    if (getifaddrs(&interfaces) != 0) {
+        return false;
+    }
+    bool found = false;
+    for (ifaddrs* entry = interfaces; entry && !found; entry = entry->ifa_next) {
+        if (entry->ifa_addr && entry->ifa_addr->sa_family == AF_INET && interfaceName == entry->ifa_name) {
+            address = reinterpret_cast<sockaddr_in*>(entry->ifa_addr)->sin_addr;
+            found = true;
+        }
+    }
+    freeifaddrs(interfaces);
+    return found;
+}
+
+// Resolves an interface name or local address to an IPv6 interface index
+bool interfaceIndex6(const std::string& interfaceName, unsigned& index) {
+    index = 0;
+    if (interfaceName.empty()) {
+        return true;
+    }
+    index = if_nametoindex(interfaceName.c_str());
+    if (index != 0) {
+        return true;
+    }
+    in6_addr wanted{};
+    if (inet_pton(AF_INET6, interfaceName.c_str(), &wanted) != 1) {
+        return false;
+    }
+    ifaddrs* interfaces = nullptr;
+    if (getifaddrs(&interfaces) != 0) {
+        return false;
+    }
+    for (ifaddrs* entry = interfaces; entry && index == 0; entry = entry->ifa_next) {
+        if (entry->ifa_addr && entry->ifa_addr->sa_family == AF_INET6 &&
+            std::memcmp(&reinterpret_cast<sockaddr_in6*>(entry->ifa_addr)->sin6_addr, &wanted, sizeof(wanted)) == 0) {
+            index = if_nametoindex(entry->ifa_name);
+        }
+    }
+    freeifaddrs(interfaces);
+    return index != 0;
+}
+
+} // namespace
+
+OSCMulticastTransport::OSCMulticastTransport(Protocol protocol) : protocol_(protocol) {
+}
+
+OSCMulticastTransport::~OSCMulticastTransport() {
+    disconnect();
+}
+
+bool OSCMulticastTransport::isMulticastAddress(const sockaddr_storage& address) {
+    if (address.ss_family == AF_INET) {
+        return IN_MULTICAST(ntohl(reinterpret_cast<const sockaddr_in*>(&address)->sin_addr.s_addr));
+    }
+    if (address.ss_family == AF_INET6) {
+        return IN6_IS_ADDR_MULTICAST(&reinterpret_cast<const sockaddr_in6*>(&address)->sin6_addr);
+    }
+    return false;
+}
+
+bool OSCMulticastTransport::joinGroup(int fd, const sockaddr_storage& group, const std::string& interfaceName) {
+    if (group.ss_family == AF_INET) {
+        ip_mreq request{};
+        request.imr_multiaddr = reinterpret_cast<const sockaddr_in*>(&group)->sin_addr;
+        return interfaceAddress4(interfaceName, request.imr_interface) &&
+               setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &request, sizeof(request)) == 0;
+    }
+    if (group.ss_family == AF_INET6) {
+        ipv6_mreq request{};
+        request.ipv6mr_multiaddr = reinterpret_cast<const sockaddr_in6*>(&group)->sin6_addr;
+        return interfaceIndex6(interfaceName, request.ipv6mr_interface) &&
+               setsockopt(fd, IPPROTO_IPV6, IPV6_JOIN_GROUP, &request, sizeof(request)) == 0;
+    }
+    return false;
+}
+
+bool OSCMulticastTransport::connect(const std::string& host, const std::string& port) {
+    disconnect();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* results = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &results) != 0 || !results) {
+        reportError("Cannot resolve " + getProtocolName() + " address " + host + ":" + port);
+        return false;
+    }
+    std::memcpy(&target_, results->ai_addr, results->ai_addrlen);
+    targetLength_ = static_cast<socklen_t>(results->ai_addrlen);
+    freeaddrinfo(results);
+
+    if (protocol_ == Protocol::MULTICAST && !isMulticastAddress(target_)) {
+        reportError(host + " is not a multicast group address");
+        return false;
+    }
+    if (protocol_ == Protocol::BROADCAST && target_.ss_family != AF_INET) {
+        reportError("Broadcast needs an IPv4 address, got " + host);
+        return false;
+    }
+
+    fd_ = socket(target_.ss_family, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        reportError(std::string("Cannot create UDP socket: ") + std::strerror(errno));
+        return false;
+    }
+    fcntl(fd_, F_SETFD, FD_CLOEXEC);
+    host_ = host;
+    port_ = port;
+    if (!applyOptions()) {
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    return true;
+}
+
+bool OSCMulticastTransport::disconnect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    host_.clear();
+    port_.clear();
+    return true;
+}
+
+bool OSCMulticastTransport::isConnected() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fd_ >= 0;
+}
+
+void OSCMulticastTransport::setTTL(int ttl) {
+    ttl_ = ttl;
+    std::lock_guard<std::mutex> lock(mutex_);
+    applyOptions();
+}
+
+void OSCMulticastTransport::setLoopback(bool enable) {
+    loopback_ = enable;
+    std::lock_guard<std::mutex> lock(mutex_);
+    applyOptions();
+}
+
+void OSCMulticastTransport::setInterface(const std::string& interfaceName) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    interface_ = interfaceName;
+    applyOptions();
+}
+
+// Called with mutex_ held; a no-op until connected
+bool OSCMulticastTransport::applyOptions() {
+    if (fd_ < 0) {
+        return true;
+    }
+    if (protocol_ == Protocol::BROADCAST) {
+        int enable = 1;
+        if (setsockopt(fd_, SOL_SOCKET, SO_BROADCAST, &enable, sizeof(enable)) != 0) {
+            reportError(std::string("Cannot enable broadcast: ") + std::strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+    bool ok;
+    if (target_.ss_family == AF_INET) {
+        // IPv4 takes these as a byte on some platforms and an int on others; a byte is accepted everywhere
+        unsigned char ttl = static_cast<unsigned char>(ttl_.load());
+        unsigned char loop = loopback_ ? 1 : 0;
+        in_addr interfaceAddr{};
+        ok = setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) == 0 &&
+             setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) == 0;
+        if (ok && !interface_.empty()) {
+            ok = interfaceAddress4(interface_, interfaceAddr) &&
+                 setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &interfaceAddr, sizeof(interfaceAddr)) == 0;
+        }
+    } else {
+        int hops = ttl_;
+        unsigned loop = loopback_ ? 1 : 0;
+        unsigned index = 0;
+        ok = setsockopt(fd_, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &hops, sizeof(hops)) == 0 &&
+             setsockopt(fd_, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &loop, sizeof(loop)) == 0;
+        if (ok && !interface_.empty()) {
+            ok = interfaceIndex6(interface_, index) &&
+                 setsockopt(fd_, IPPROTO_IPV6, IPV6_MULTICAST_IF, &index, sizeof(index)) == 0;
+        }
+    }
+    if (!ok) {
+        reportError("Cannot apply multicast options for " + host_ + (interface_.empty() ? "" : " on " + interface_));
+    }
+    return ok;
+}
+
+bool OSCMulticastTransport::sendPacket(const void* data, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0) {
+        reportError(getProtocolName() + " transport not connected");
+        return false;
+    }
+    if (sendto(fd_, data, size, 0, reinterpret_cast<const sockaddr*>(&target_), targetLength_) < 0) {
+        int error = errno;
+        lastSendErrno_ = error;
+        reportError("Failed to send to " + host_ + ":" + port_ + ": " + std::strerror(error));
+        return false;
+    }
+    lastSendErrno_ = 0;
+    return true;
+}
+
+size_t OSCMulticastTransport::getQueuedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return socketQueuedBytes(fd_);
+}
+
+bool OSCMulticastTransport::sendLoMessage(const std::string& address, lo_message message) {
+    thread_local std::vector<uint8_t> buffer;
+    size_t size = lo_message_length(message, address.c_str());
+    buffer.resize(size);
+    lo_message_serialise(message, address.c_str(), buffer.data(), &size);
+    return sendPacket(buffer.data(), size);
+}
+
+bool OSCMulticastTransport::sendMessage(const std::string& address, void* msg) {
+    return sendLoMessage(address, static_cast<lo_message>(msg));
+}
+
+bool OSCMulticastTransport::sendBundle(void* bundle) {
+    thread_local std::vector<uint8_t> buffer;
+    lo_bundle bndl = static_cast<lo_bundle>(bundle);
+    size_t size = lo_bundle_length(bndl);
+    buffer.resize(size);
+    lo_bundle_serialise(bndl, buffer.data(), &size);
+    return sendPacket(buffer.data(), size);
+}
+
+bool OSCMulticastTransport::sendMessage(const std::string& address, const std::vector<float>& values) {
+    thread_local std::vector<uint8_t> buffer;
+    buffer.clear();
+    OSCPacket::appendFloatMessage(buffer, address, values.data(), values.size());
+    return sendPacket(buffer.data(), buffer.size());
+}
+
+bool OSCMulticastTransport::sendMessage(const std::string& address, const std::vector<int>& values) {
+    lo_message msg = lo_message_new();
+    for (int value : values) {
+        lo_message_add_int32(msg, value);
+    }
+    bool result = sendLoMessage(address, msg);
+    lo_message_free(msg);
+    return result;
+}
+
+bool OSCMulticastTransport::sendMessage(const std::string& address, const std::string& value) {
+    lo_message msg = lo_message_new();
+    lo_message_add_string(msg, value.c_str());
+    bool result = sendLoMessage(address, msg);
+    lo_message_free(msg);
+    return result;
+}
+
+bool OSCMulticastTransport::sendBundle(const std::vector<std::pair<std::string, std::vector<float>>>& messages) {
+    thread_local std::vector<uint8_t> buffer;
+    buffer.clear();
+    OSCPacket::appendBundleHeader(buffer);
+    for (const auto& [address, values] : messages) {
+        OSCPacket::appendBundleFloatMessage(buffer, address, values.data(), values.size());
+    }
+    return sendPacket(buffer.data(), buffer.size());
+}
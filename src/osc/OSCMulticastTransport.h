@@ -0,0 +1,80 @@
+#pragma once
+
+#include "OSCTransport.h"
+#include <lo/lo.h>
+#include <atomic>
+#include <mutex>
+#include <sys/socket.h>
+
+/**
+ * @brief UDP multicast and broadcast transport for OSC
+ *
+ * One send reaches every listener that joined the group (or every host on
+ * the subnet for broadcast), so the packet is encoded and sent once however
+ * many receivers there are. connect() takes the group or broadcast address.
+ * TTL, loopback and the outgoing interface can be changed at any time.
+ */
+class OSCMulticastTransport : public OSCTransport {
+public:
+    explicit OSCMulticastTransport(Protocol protocol = Protocol::MULTICAST);
+    ~OSCMulticastTransport() override;
+
+    // Connection management
+    bool connect(const std::string& host, const std::string& port) override;
+    bool disconnect() override;
+    bool isConnected() const override;
+
+    // Sending methods for liblo integration
+    bool sendMessage(const std::string& address, void* msg) override;
+    bool sendBundle(void* bundle) override;
+
+    // High-level sending methods
+    bool sendMessage(const std::string& address, const std::vector<float>& values) override;
+    bool sendMessage(const std::string& address, const std::vector<int>& values) override;
+    bool sendMessage(const std::string& address, const std::string& value) override;
+    bool sendBundle(const std::vector<std::pair<std::string, std::vector<float>>>& messages) override;
+    // Send an already encoded OSC packet
+    bool sendPacket(const void* data, size_t size);
+    size_t getQueuedBytes() const override;
+
+    // Protocol information
+    Protocol getProtocol() const override { return protocol_; }
+    std::string getProtocolName() const override { return protocol_ == Protocol::BROADCAST ? "Broadcast" : "Multicast"; }
+
+    // Error handling
+    std::string getLastError() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastError_;
+    }
+    void setErrorCallback(std::function<void(const std::string&)> callback) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        errorCallback_ = callback;
+    }
+
+    // Multicast options (TTL 1 keeps traffic on the local subnet)
+    void setTTL(int ttl);
+    void setLoopback(bool enable);
+    // Interface name ("en0") or local address; empty lets the routing table decide
+    void setInterface(const std::string& interfaceName);
+    int getTTL() const { return ttl_; }
+    bool getLoopback() const { return loopback_; }
+
+    static bool isMulticastAddress(const sockaddr_storage& address);
+    // Joins fd to the group on the given interface (as accepted by setInterface)
+    static bool joinGroup(int fd, const sockaddr_storage& group, const std::string& interfaceName);
+
+private:
+    const Protocol protocol_;
+    int fd_ = -1;
+    sockaddr_storage target_{};
+    socklen_t targetLength_ = 0;
+    std::string host_;
+    std::string port_;
+    std::atomic<int> ttl_{1};
+    std::atomic<bool> loopback_{true};
+    std::string interface_;
+    mutable std::mutex mutex_;
+
+    bool applyOptions();
+    bool sendLoMessage(const std::string& address, lo_message message);
+};
@@ -0,0 +1,723 @@
+#include "OSCNetworkReactor.h"
+#include "OSCMulticastTransport.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+// Packets handled per readiness event, so one busy receiver cannot starve the rest
+constexpr size_t kReceiveBudget = 64;
+constexpr size_t kBatchSize = 64;
+// Packets sent per flush pass; receivers get a turn between passes
+constexpr size_t kFlushBudget = 4 * kBatchSize;
+#if defined(__linux__)
+constexpr size_t kReceiveBatch = 8;
+#else
+constexpr size_t kReceiveBatch = 1;
+#endif
+constexpr int kSocketBufferBytes = 1 << 20;
+// ENOBUFS has no readiness event to wait for, so the batch is retried after this
+constexpr std::chrono::milliseconds kNoBufferRetry{1};
+
+bool isTransient(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS;
+}
+
+int64_t toNs(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+void prepareSocket(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+addrinfo* resolve(const char* host, const std::string& port, int family, bool passive) {
+    addrinfo hints{};
+    hints.ai_family = family;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = passive ? AI_PASSIVE : 0;
+    addrinfo* results = nullptr;
+    return getaddrinfo(host, port.c_str(), &hints, &results) == 0 ? results : nullptr;
+}
+
+} // namespace
+
+OSCNetworkReactor::OSCNetworkReactor(size_t threads) {
+    if (threads == 0) {
+        auto shard = std::make_unique<Shard>();
+        shard->loop = &OSCEventLoop::shared();
+        shards_.push_back(std::move(shard));
+    } else {
+        for (size_t i = 0; i < threads; i++) {
+            auto shard = std::make_unique<Shard>();
+            shard->ownedLoop = std::make_unique<OSCEventLoop>();
+            shard->ownedLoop->start();
+            shard->loop = shard->ownedLoop.get();
+            shards_.push_back(std::move(shard));
+        }
+    }
+    for (auto& shard : shards_) {
+        shard->receiveBuffer.resize(kReceiveBatch * kMaxDatagramSize);
+    }
+}
+
+OSCNetworkReactor::~OSCNetworkReactor() {
+    std::vector<EndpointId> ids;
+    {
+        std::shared_lock<std::shared_mutex> lock(endpointsMutex_);
+        for (const auto& [id, endpoint] : endpoints_) {
+            ids.push_back(id);
+        }
+    }
+    for (EndpointId id : ids) {
+        close(id);
+    }
+    for (auto& shard : shards_) {
+        Shard* raw = shard.get();
+        // A flush reposts itself until the queue is empty; let it finish before the shard goes
+        for (bool flushing = true; flushing;) {
+            raw->loop->runSync([raw, &flushing] {
+                std::lock_guard<std::mutex> lock(raw->queueMutex);
+                flushing = raw->flushPosted;
+            });
+        }
+        raw->loop->runSync([raw] {
+            for (int fd : {raw->sendFd4, raw->sendFd6}) {
+                if (fd >= 0) {
+                    raw->loop->remove(fd);
+                    ::close(fd);
+                }
+            }
+            raw->sendFd4 = raw->sendFd6 = -1;
+        });
+    }
+}
+
+OSCNetworkReactor& OSCNetworkReactor::shared() {
+    static OSCNetworkReactor reactor;
+    return reactor;
+}
+
+OSCNetworkReactor::EndpointId OSCNetworkReactor::openUdpReceiver(const std::string& port, PacketHandler handler,
+                                                                 const std::string& bindAddress) {
+    // Like liblo, an unspecified address listens on IPv4 wildcard
+    addrinfo* results = resolve(bindAddress.empty() ? nullptr : bindAddress.c_str(), port,
+                                bindAddress.empty() ? AF_INET : AF_UNSPEC, true);
+    if (!results) {
+        return 0;
+    }
+    int fd = socket(results->ai_family, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        freeaddrinfo(results);
+        return 0;
+    }
+    prepareSocket(fd);
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &kSocketBufferBytes, sizeof(kSocketBufferBytes));
+    bool bound = bind(fd, results->ai_addr, results->ai_addrlen) == 0;
+    freeaddrinfo(results);
+    if (!bound) {
+        ::close(fd);
+        return 0;
+    }
+
+    return addReceiver(fd, std::move(handler));
+}
+
+OSCNetworkReactor::EndpointId OSCNetworkReactor::openMulticastReceiver(const std::string& group, const std::string& port,
+                                                                       PacketHandler handler,
+                                                                       const std::string& interfaceName) {
+    addrinfo* results = resolve(group.c_str(), port, AF_UNSPEC, false);
+    if (!results) {
+        return 0;
+    }
+    sockaddr_storage groupAddress{};
+    std::memcpy(&groupAddress, results->ai_addr, results->ai_addrlen);
+    freeaddrinfo(results);
+    if (!OSCMulticastTransport::isMulticastAddress(groupAddress)) {
+        return 0;
+    }
+
+    int fd = socket(groupAddress.ss_family, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return 0;
+    }
+    prepareSocket(fd);
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+#ifdef SO_REUSEPORT
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable));
+#endif
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &kSocketBufferBytes, sizeof(kSocketBufferBytes));
+
+    // Bound to the wildcard address so only the group membership filters traffic
+    sockaddr_storage bindAddress{};
+    socklen_t bindLength;
+    bindAddress.ss_family = groupAddress.ss_family;
+    if (groupAddress.ss_family == AF_INET6) {
+        reinterpret_cast<sockaddr_in6*>(&bindAddress)->sin6_port = reinterpret_cast<sockaddr_in6*>(&groupAddress)->sin6_port;
+        bindLength = sizeof(sockaddr_in6);
+    } else {
+        reinterpret_cast<sockaddr_in*>(&bindAddress)->sin_port = reinterpret_cast<sockaddr_in*>(&groupAddress)->sin_port;
+        bindLength = sizeof(sockaddr_in);
+    }
+    if (bind(fd, reinterpret_cast<sockaddr*>(&bindAddress), bindLength) != 0 ||
+        !OSCMulticastTransport::joinGroup(fd, groupAddress, interfaceName)) {
+        ::close(fd);
+        return 0;
+    }
+    return addReceiver(fd, std::move(handler));
+}
+
+OSCNetworkReactor::EndpointId OSCNetworkReactor::addReceiver(int fd, PacketHandler handler) {
+    auto endpoint = std::make_shared<Endpoint>();
+    endpoint->kind = EndpointKind::UDP_RECEIVER;
+    endpoint->fd = fd;
+    endpoint->handler = std::move(handler);
+    endpoint->shard = nextShard_++ % shards_.size();
+    Shard& shard = *shards_[endpoint->shard];
+    std::weak_ptr<Endpoint> weak = endpoint;
+    EndpointId id = addEndpoint(endpoint);
+    shard.loop->add(fd, OSCEventLoop::Readable, [this, &shard, weak](uint32_t) {
+        if (auto self = weak.lock()) {
+            receive(shard, *self);
+        }
+    });
+    return id;
+}
+
+OSCNetworkReactor::EndpointId OSCNetworkReactor::openUdpTarget(const std::string& host, const std::string& port) {
+    addrinfo* results = resolve(host.c_str(), port, AF_UNSPEC, false);
+    if (!results) {
+        return 0;
+    }
+    auto endpoint = std::make_shared<Endpoint>();
+    endpoint->kind = EndpointKind::UDP_TARGET;
+    std::memcpy(&endpoint->address, results->ai_addr, results->ai_addrlen);
+    endpoint->addressLength = static_cast<socklen_t>(results->ai_addrlen);
+    endpoint->shard = nextShard_++ % shards_.size();
+    freeaddrinfo(results);
+    return addEndpoint(endpoint);
+}
+
+OSCNetworkReactor::EndpointId OSCNetworkReactor::openTcpTarget(const std::string& host, const std::string& port,
+                                                               OSCTCPTransport::Framing framing) {
+    auto endpoint = std::make_shared<Endpoint>();
+    endpoint->kind = EndpointKind::TCP_TARGET;
+    endpoint->shard = nextShard_++ % shards_.size();
+    endpoint->tcp = std::make_unique<OSCTCPTransport>(*shards_[endpoint->shard]->loop);
+    endpoint->tcp->setFraming(framing);
+    endpoint->tcp->setAutoReconnect(true);
+    endpoint->tcp->connect(host, port);   // Keeps retrying in the background if the peer is not up yet
+    return addEndpoint(endpoint);
+}
+
+void OSCNetworkReactor::close(EndpointId id) {
+    std::shared_ptr<Endpoint> endpoint;
+    {
+        std::unique_lock<std::shared_mutex> lock(endpointsMutex_);
+        auto it = endpoints_.find(id);
+        if (it == endpoints_.end()) {
+            return;
+        }
+        endpoint = std::move(it->second);
+        endpoints_.erase(it);
+    }
+    // Queued packets may still go out, but nothing is reported once this returns;
+    // packets waiting for the pacer are dropped
+    Shard& shard = *shards_[endpoint->shard];
+    OSCEventLoop* loop = shard.loop;
+    loop->runSync([&] {
+        if (endpoint->fd >= 0) {
+            loop->remove(endpoint->fd);
+            ::close(endpoint->fd);
+            endpoint->fd = -1;
+        }
+        endpoint->sendObserver = nullptr;
+        if (endpoint->pacingTimer) {
+            loop->cancelTimer(endpoint->pacingTimer);
+            endpoint->pacingTimer = 0;
+        }
+        if (endpoint->pacer) {
+            endpoint->pacer.reset();
+            shard.pacedTargets--;
+        }
+        endpoint->paced.clear();
+        endpoint->backpressured = false;
+    });
+    if (endpoint->tcp) {
+        endpoint->tcp->disconnect();
+    }
+}
+
+void OSCNetworkReactor::setSendObserver(EndpointId target, SendObserver observer) {
+    auto endpoint = findEndpoint(target);
+    if (!endpoint || endpoint->kind == EndpointKind::UDP_RECEIVER) {
+        return;
+    }
+    shards_[endpoint->shard]->loop->runSync([&] { endpoint->sendObserver = std::move(observer); });
+}
+
+OSCNetworkReactor::EndpointStats OSCNetworkReactor::getEndpointStats(EndpointId target) const {
+    EndpointStats stats;
+    if (auto endpoint = findEndpoint(target)) {
+        stats.packetsSent = endpoint->packetsSent;
+        stats.sendErrors = endpoint->sendErrors;
+        stats.lastError = endpoint->lastError;
+        stats.pacingRate = endpoint->pacingRate;
+        stats.backpressured = endpoint->tcp ? endpoint->tcp->isBackpressured() : endpoint->backpressured.load();
+    }
+    return stats;
+}
+
+bool OSCNetworkReactor::isBackpressured(EndpointId target) const {
+    auto endpoint = findEndpoint(target);
+    if (!endpoint) {
+        return false;
+    }
+    return endpoint->tcp ? endpoint->tcp->isBackpressured() : endpoint->backpressured.load();
+}
+
+void OSCNetworkReactor::setPacing(EndpointId target, bool enable, const OSCSendPacer::Config& config) {
+    auto endpoint = findEndpoint(target);
+    if (!endpoint || endpoint->kind != EndpointKind::UDP_TARGET) {
+        return;
+    }
+    Shard& shard = *shards_[endpoint->shard];
+    shard.loop->runSync([&] {
+        if (enable) {
+            if (endpoint->pacer) {
+                endpoint->pacer->setConfig(config);
+            } else {
+                endpoint->pacer = std::make_unique<OSCSendPacer>(config);
+                shard.pacedTargets++;
+            }
+            endpoint->pacingRate = endpoint->pacer->rate();
+        } else if (endpoint->pacer) {
+            endpoint->pacer.reset();
+            endpoint->pacingRate = 0.0;
+            shard.pacedTargets--;
+            releasePaced(shard, endpoint);
+        }
+    });
+}
+
+bool OSCNetworkReactor::submit(EndpointId target, const void* data, size_t size, uint64_t tag) {
+    auto endpoint = findEndpoint(target);
+    if (!endpoint || endpoint->kind == EndpointKind::UDP_RECEIVER) {
+        return false;
+    }
+    Shard& shard = *shards_[endpoint->shard];
+    if (endpoint->tcp) {
+        bool queued = endpoint->tcp->sendPacket(data, size);
+        (queued ? shard.packetsSubmitted : shard.submissionsDropped)++;
+        return queued;
+    }
+    if (size > kMaxDatagramSize) {
+        shard.submissionsDropped++;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(shard.queueMutex);
+    if (shard.pendingBytes.size() + size > kMaxPendingBytes) {
+        shard.submissionsDropped++;
+        return false;
+    }
+    size_t offset = shard.pendingBytes.size();
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    shard.pendingBytes.insert(shard.pendingBytes.end(), bytes, bytes + size);
+    shard.pending.push_back({std::move(endpoint), offset, size, tag, std::chrono::steady_clock::now()});
+    shard.packetsSubmitted++;
+    // One wakeup per batch; later submissions ride along until the loop drains
+    if (!shard.flushPosted) {
+        shard.flushPosted = true;
+        shard.loop->post([this, &shard] { flush(shard); });
+    }
+    return true;
+}
+
+size_t OSCNetworkReactor::submitFanout(const EndpointId* targets, size_t count, const void* data, size_t size,
+                                       uint64_t tag) {
+    thread_local std::vector<std::shared_ptr<Endpoint>> udpTargets;
+    size_t accepted = 0;
+    for (size_t i = 0; i < count; i++) {
+        auto endpoint = findEndpoint(targets[i]);
+        if (!endpoint || endpoint->kind == EndpointKind::UDP_RECEIVER) {
+            continue;
+        }
+        if (endpoint->tcp) {
+            bool queued = endpoint->tcp->sendPacket(data, size);
+            (queued ? shards_[endpoint->shard]->packetsSubmitted : shards_[endpoint->shard]->submissionsDropped)++;
+            accepted += queued ? 1 : 0;
+        } else {
+            udpTargets.push_back(std::move(endpoint));
+        }
+    }
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t index = 0; index < shards_.size() && !udpTargets.empty(); index++) {
+        Shard& shard = *shards_[index];
+        size_t targetsOnShard = std::count_if(udpTargets.begin(), udpTargets.end(),
+                                              [index](const auto& endpoint) { return endpoint->shard == index; });
+        if (targetsOnShard == 0) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(shard.queueMutex);
+        if (size > kMaxDatagramSize || shard.pendingBytes.size() + size > kMaxPendingBytes) {
+            shard.submissionsDropped += targetsOnShard;
+            continue;
+        }
+        // The bytes are queued once; every target's entry points at the same offset
+        size_t offset = shard.pendingBytes.size();
+        shard.pendingBytes.insert(shard.pendingBytes.end(), bytes, bytes + size);
+        const auto submitted = std::chrono::steady_clock::now();
+        for (const auto& endpoint : udpTargets) {
+            if (endpoint->shard == index) {
+                shard.pending.push_back({endpoint, offset, size, tag, submitted});
+            }
+        }
+        shard.packetsSubmitted += targetsOnShard;
+        accepted += targetsOnShard;
+        if (!shard.flushPosted) {
+            shard.flushPosted = true;
+            shard.loop->post([this, &shard] { flush(shard); });
+        }
+    }
+    udpTargets.clear();
+    return accepted;
+}
+
+void OSCNetworkReactor::flush(Shard& shard) {
+    if (shard.drainPosition == shard.draining.size()) {
+        shard.draining.clear();
+        shard.drainingBytes.clear();
+        shard.drainPosition = 0;
+        std::lock_guard<std::mutex> lock(shard.queueMutex);
+        shard.pending.swap(shard.draining);
+        shard.pendingBytes.swap(shard.drainingBytes);
+        if (shard.pacedTargets > 0) {
+            holdOverRate(shard);
+        }
+    }
+
+    const size_t count = std::min(shard.draining.size(), shard.drainPosition + kFlushBudget);
+    for (size_t start = shard.drainPosition; start < count;) {
+        // Batch consecutive packets that leave through the same socket
+        const int family = shard.draining[start].target->address.ss_family;
+        const int fd = sendSocket(shard, family);
+        size_t end = start;
+        while (end < count && end - start < kBatchSize &&
+               shard.draining[end].target->address.ss_family == family) {
+            end++;
+        }
+        if (fd < 0) {
+            const int error = errno;
+            const auto now = std::chrono::steady_clock::now();
+            for (size_t i = start; i < end; i++) {
+                complete(shard, shard.draining[i], error, now);
+            }
+            start = end;
+            continue;
+        }
+
+        size_t sent = 0;
+        int blockedBy = 0;
+#if defined(__linux__)
+        mmsghdr messages[kBatchSize];
+        iovec iov[kBatchSize];
+        for (size_t i = start; i < end; i++) {
+            const Pending& packet = shard.draining[i];
+            iov[i - start] = {shard.drainingBytes.data() + packet.offset, packet.size};
+            messages[i - start] = {};
+            messages[i - start].msg_hdr.msg_name = &packet.target->address;
+            messages[i - start].msg_hdr.msg_namelen = packet.target->addressLength;
+            messages[i - start].msg_hdr.msg_iov = &iov[i - start];
+            messages[i - start].msg_hdr.msg_iovlen = 1;
+        }
+        while (sent < end - start) {
+            int result = sendmmsg(fd, messages + sent, static_cast<unsigned>(end - start - sent), MSG_DONTWAIT);
+            shard.sendCalls++;
+            const int error = result < 0 ? errno : 0;
+            const auto now = std::chrono::steady_clock::now();
+            if (result > 0) {
+                for (size_t i = start + sent; i < start + sent + static_cast<size_t>(result); i++) {
+                    complete(shard, shard.draining[i], 0, now);
+                }
+                sent += static_cast<size_t>(result);
+            } else if (isTransient(error)) {
+                blockedBy = error;
+                break;
+            } else if (error != EINTR) {
+                complete(shard, shard.draining[start + sent], error, now);   // Skip the packet that failed
+                sent++;
+            }
+        }
+#else
+        while (sent < end - start) {
+            const Pending& packet = shard.draining[start + sent];
+            ssize_t result = sendto(fd, shard.drainingBytes.data() + packet.offset, packet.size, 0,
+                                    reinterpret_cast<const sockaddr*>(&packet.target->address),
+                                    packet.target->addressLength);
+            shard.sendCalls++;
+            const int error = result < 0 ? errno : 0;
+            if (isTransient(error)) {
+                blockedBy = error;
+                break;
+            }
+            if (error != EINTR) {
+                complete(shard, packet, error, std::chrono::steady_clock::now());
+                sent++;
+            }
+        }
+#endif
+        if (blockedBy) {
+            // The socket buffer is full: keep the rest of the batch and try again once it drains
+            shard.drainPosition = start + sent;
+            shard.blocked = true;
+            if (auto& pacer = shard.draining[shard.drainPosition].target->pacer) {
+                pacer->onSendFailed(toNs(std::chrono::steady_clock::now()), blockedBy);
+            }
+            if (blockedBy == ENOBUFS || !shard.loop->add(fd, OSCEventLoop::Writable, [this, &shard, fd](uint32_t) {
+                    shard.loop->remove(fd);
+                    resumeFlush(shard);
+                })) {
+                shard.loop->runAfter(kNoBufferRetry, [this, &shard] { resumeFlush(shard); });
+            }
+            return;   // flushPosted stays set, so submissions do not post another pass meanwhile
+        }
+        start = end;
+    }
+    shard.drainPosition = count;
+
+    // Requeue behind the I/O events that arrived meanwhile instead of sending everything now
+    std::lock_guard<std::mutex> lock(shard.queueMutex);
+    if (shard.drainPosition < shard.draining.size() || !shard.pending.empty()) {
+        shard.loop->post([this, &shard] { flush(shard); });
+    } else {
+        shard.flushPosted = false;
+    }
+}
+
+void OSCNetworkReactor::resumeFlush(Shard& shard) {
+    if (shard.blocked) {
+        shard.blocked = false;
+        flush(shard);
+    }
+}
+
+// Moves packets for paced targets that are over their rate out of the batch into
+// the target's queue. Once a target has packets waiting, later ones queue behind them.
+void OSCNetworkReactor::holdOverRate(Shard& shard) {
+    const auto now = std::chrono::steady_clock::now();
+    size_t kept = 0;
+    for (size_t i = 0; i < shard.draining.size(); i++) {
+        Pending& packet = shard.draining[i];
+        Endpoint& endpoint = *packet.target;
+        if (!endpoint.pacer || (endpoint.paced.empty() && endpoint.pacer->tryAcquire(toNs(now)))) {
+            if (kept != i) {
+                shard.draining[kept] = std::move(packet);
+            }
+            kept++;
+            continue;
+        }
+        if (endpoint.paced.size() >= kMaxPacedPackets) {
+            // The queue is bounded: the oldest packet fails as it would on a full socket buffer
+            const auto& oldest = endpoint.paced.front();
+            complete(shard, {packet.target, 0, oldest.bytes.size(), oldest.tag, oldest.submitted}, ENOBUFS, now);
+            endpoint.paced.pop_front();
+        }
+        const uint8_t* bytes = shard.drainingBytes.data() + packet.offset;
+        endpoint.paced.push_back({std::vector<uint8_t>(bytes, bytes + packet.size), packet.tag, packet.submitted});
+        schedulePaced(shard, packet.target);
+    }
+    shard.draining.resize(kept);
+}
+
+// Sends what the pacer allows now (everything once pacing is off), one packet per call
+void OSCNetworkReactor::releasePaced(Shard& shard, const std::shared_ptr<Endpoint>& endpoint) {
+    const int fd = sendSocket(shard, endpoint->address.ss_family);
+    while (!endpoint->paced.empty()) {
+        const auto now = std::chrono::steady_clock::now();
+        if (endpoint->pacer && !endpoint->pacer->tryAcquire(toNs(now))) {
+            break;
+        }
+        const auto& packet = endpoint->paced.front();
+        int error = fd < 0 ? EBADF : 0;
+        if (fd >= 0) {
+            ssize_t result = sendto(fd, packet.bytes.data(), packet.bytes.size(), MSG_DONTWAIT,
+                                    reinterpret_cast<const sockaddr*>(&endpoint->address), endpoint->addressLength);
+            shard.sendCalls++;
+            error = result < 0 ? errno : 0;
+        }
+        if (isTransient(error) || error == EINTR) {
+            if (endpoint->pacer) {
+                endpoint->pacer->onSendFailed(toNs(now), error);
+            }
+            break;   // Stays at the front; the timer tries again
+        }
+        complete(shard, {endpoint, 0, packet.bytes.size(), packet.tag, packet.submitted}, error, now);
+        endpoint->paced.pop_front();
+    }
+    schedulePaced(shard, endpoint);
+}
+
+void OSCNetworkReactor::schedulePaced(Shard& shard, const std::shared_ptr<Endpoint>& endpoint) {
+    // Same thresholds as OSCTCPTransport: on at half the bound, off at a quarter
+    if (endpoint->paced.size() >= kMaxPacedPackets / 2) {
+        endpoint->backpressured = true;
+    } else if (endpoint->paced.size() <= kMaxPacedPackets / 4) {
+        endpoint->backpressured = false;
+    }
+    if (endpoint->pacingTimer || endpoint->paced.empty()) {
+        return;
+    }
+    // Timers tick in milliseconds; the bucket's burst covers the rounding
+    std::chrono::milliseconds delay = kNoBufferRetry;
+    if (endpoint->pacer) {
+        int64_t waitNs = endpoint->pacer->nanosUntilNext(toNs(std::chrono::steady_clock::now()));
+        delay = std::max(delay, std::chrono::milliseconds((waitNs + 999999) / 1000000));
+    }
+    std::weak_ptr<Endpoint> weak = endpoint;
+    endpoint->pacingTimer = shard.loop->runAfter(delay, [this, &shard, weak] {
+        if (auto self = weak.lock()) {
+            self->pacingTimer = 0;
+            releasePaced(shard, self);
+        }
+    });
+}
+
+void OSCNetworkReactor::complete(Shard& shard, const Pending& packet, int error,
+                                 std::chrono::steady_clock::time_point now) {
+    Endpoint& endpoint = *packet.target;
+    if (error == 0) {
+        shard.packetsSent++;
+        endpoint.packetsSent++;
+    } else {
+        shard.sendErrors++;
+        endpoint.sendErrors++;
+        endpoint.lastError = error;
+    }
+    if (endpoint.pacer) {
+        if (error == 0) {
+            endpoint.pacer->onSent(toNs(now), 0);   // The send socket is shared, so its queue says nothing per target
+        } else {
+            endpoint.pacer->onSendFailed(toNs(now), error);
+        }
+        endpoint.pacingRate = endpoint.pacer->rate();
+    }
+    if (endpoint.sendObserver) {
+        endpoint.sendObserver({endpoint.id, packet.tag, error, packet.submitted, now});
+    }
+}
+
+void OSCNetworkReactor::receive(Shard& shard, Endpoint& endpoint) {
+    sockaddr_storage sources[kReceiveBatch];
+    for (size_t handled = 0; handled < kReceiveBudget && endpoint.fd >= 0;) {
+#if defined(__linux__)
+        mmsghdr messages[kReceiveBatch];
+        iovec iov[kReceiveBatch];
+        for (size_t i = 0; i < kReceiveBatch; i++) {
+            iov[i] = {shard.receiveBuffer.data() + i * kMaxDatagramSize, kMaxDatagramSize};
+            messages[i] = {};
+            messages[i].msg_hdr.msg_name = &sources[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sources[i]);
+            messages[i].msg_hdr.msg_iov = &iov[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        int count = recvmmsg(endpoint.fd, messages, kReceiveBatch, MSG_DONTWAIT, nullptr);
+        if (count <= 0) {
+            return;
+        }
+        shard.receiveCalls++;
+        for (int i = 0; i < count && endpoint.fd >= 0; i++) {
+            endpoint.handler(shard.receiveBuffer.data() + i * kMaxDatagramSize, messages[i].msg_len, sources[i]);
+        }
+        shard.packetsReceived += static_cast<uint64_t>(count);
+        handled += static_cast<size_t>(count);
+        if (static_cast<size_t>(count) < kReceiveBatch) {
+            return;   // Socket drained
+        }
+#else
+        socklen_t sourceLength = sizeof(sources[0]);
+        ssize_t length = recvfrom(endpoint.fd, shard.receiveBuffer.data(), kMaxDatagramSize, 0,
+                                  reinterpret_cast<sockaddr*>(&sources[0]), &sourceLength);
+        if (length < 0) {
+            return;
+        }
+        shard.receiveCalls++;
+        endpoint.handler(shard.receiveBuffer.data(), static_cast<size_t>(length), sources[0]);
+        shard.packetsReceived++;
+        handled++;
+#endif
+    }
+}
+
+int OSCNetworkReactor::sendSocket(Shard& shard, int family) {
+    int& fd = family == AF_INET6 ? shard.sendFd6 : shard.sendFd4;
+    if (fd < 0) {
+        fd = socket(family, SOCK_DGRAM, 0);
+        if (fd >= 0) {
+            prepareSocket(fd);
+            setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &kSocketBufferBytes, sizeof(kSocketBufferBytes));
+        }
+    }
+    return fd;
+}
+
+OSCNetworkReactor::EndpointId OSCNetworkReactor::addEndpoint(std::shared_ptr<Endpoint> endpoint) {
+    std::unique_lock<std::shared_mutex> lock(endpointsMutex_);
+    EndpointId id = nextId_++;
+    endpoint->id = id;
+    endpoints_.emplace(id, std::move(endpoint));
+    return id;
+}
+
+std::shared_ptr<OSCNetworkReactor::Endpoint> OSCNetworkReactor::findEndpoint(EndpointId id) const {
+    std::shared_lock<std::shared_mutex> lock(endpointsMutex_);
+    auto it = endpoints_.find(id);
+    return it == endpoints_.end() ? nullptr : it->second;
+}
+
+uint16_t OSCNetworkReactor::getLocalPort(EndpointId receiver) const {
+    auto endpoint = findEndpoint(receiver);
+    if (!endpoint || endpoint->fd < 0) {
+        return 0;
+    }
+    sockaddr_storage address{};
+    socklen_t length = sizeof(address);
+    if (getsockname(endpoint->fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        return 0;
+    }
+    if (address.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<sockaddr_in6*>(&address)->sin6_port);
+    }
+    return ntohs(reinterpret_cast<sockaddr_in*>(&address)->sin_port);
+}
+
+const char* OSCNetworkReactor::getBackendName() const {
+    return shards_.front()->loop->getBackendName();
+}
+
+OSCNetworkReactor::Stats OSCNetworkReactor::getStats() const {
+    Stats stats;
+    for (const auto& shard : shards_) {
+        stats.packetsSubmitted += shard->packetsSubmitted;
+        stats.packetsSent += shard->packetsSent;
+        stats.packetsReceived += shard->packetsReceived;
+        stats.sendErrors += shard->sendErrors;
+        stats.submissionsDropped += shard->submissionsDropped;
+        stats.sendCalls += shard->sendCalls;
+        stats.receiveCalls += shard->receiveCalls;
+    }
+    std::shared_lock<std::shared_mutex> lock(endpointsMutex_);
+    for (const auto& [id, endpoint] : endpoints_) {
+        (endpoint->kind == EndpointKind::UDP_RECEIVER ? stats.receivers : stats.targets)++;
+    }
+    return stats;
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "OSCEventLoop.h"
+#include "OSCSendPacer.h"
+#include "OSCTCPTransport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/socket.h>
+
+/**
+ * @brief One network reactor for every OSC socket in the process
+ *
+ * Receivers and send targets are endpoints multiplexed over one (or a few)
+ * OSCEventLoop threads instead of a liblo server thread per receiver and a
+ * blocking sendto() on the engine thread per message. UDP targets share one
+ * socket per loop and address family.
+ *
+ * Sending is a submission queue: submit() copies the packet and returns
+ * without a syscall; the loop drains everything submitted since it last ran
+ * in one batch (sendmmsg() on Linux). A full socket buffer parks the batch
+ * until the socket is writable again rather than dropping it; other send
+ * errors are counted against the target and reported to its send observer.
+ * A UDP target may be paced: packets over its rate wait in the target's own
+ * queue, in order, and leave from a loop timer (see OSCSendPacer).
+ * Receivers drain their socket on the loop thread (recvmmsg() on Linux) and
+ * call the packet handler there.
+ */
+class OSCNetworkReactor {
+public:
+    using EndpointId = uint32_t;   // 0 is never a valid endpoint
+    using PacketHandler = std::function<void(const uint8_t* data, size_t size, const sockaddr_storage& from)>;
+
+    // Outcome of one packet queued for a UDP target
+    struct SendResult {
+        EndpointId target = 0;
+        uint64_t tag = 0;                               // As given to submit()
+        int error = 0;                                  // errno, 0 once the send call returned success
+        std::chrono::steady_clock::time_point submitted;
+        std::chrono::steady_clock::time_point completed;
+    };
+    using SendObserver = std::function<void(const SendResult& result)>;
+
+    struct EndpointStats {
+        uint64_t packetsSent = 0;
+        uint64_t sendErrors = 0;
+        int lastError = 0;
+        double pacingRate = 0.0;    // Packets per second, 0 when not paced
+        bool backpressured = false; // See isBackpressured()
+    };
+
+    struct Stats {
+        uint64_t packetsSubmitted = 0;
+        uint64_t packetsSent = 0;
+        uint64_t packetsReceived = 0;          // Counted once the handler has returned
+        uint64_t sendErrors = 0;
+        uint64_t submissionsDropped = 0;   // Queue full or packet too large
+        uint64_t sendCalls = 0;            // packetsSent / sendCalls is the batching factor
+        uint64_t receiveCalls = 0;
+        size_t receivers = 0;
+        size_t targets = 0;
+    };
+
+    static constexpr size_t kMaxDatagramSize = 65507;
+    static constexpr size_t kMaxPendingBytes = 4 << 20;   // Per loop
+    static constexpr size_t kMaxPacedPackets = 256;       // Per paced target; past this the oldest fails with ENOBUFS
+
+    // threads == 0 shares OSCEventLoop::shared() (and its thread) with the TCP transports
+    explicit OSCNetworkReactor(size_t threads = 0);
+    ~OSCNetworkReactor();
+    OSCNetworkReactor(const OSCNetworkReactor&) = delete;
+    OSCNetworkReactor& operator=(const OSCNetworkReactor&) = delete;
+
+    static OSCNetworkReactor& shared();
+
+    // port "0" picks a free port; see getLocalPort()
+    EndpointId openUdpReceiver(const std::string& port, PacketHandler handler, const std::string& bindAddress = "");
+    // Listens on port and joins group; several receivers may share the port
+    EndpointId openMulticastReceiver(const std::string& group, const std::string& port, PacketHandler handler,
+                                     const std::string& interfaceName = "");
+    EndpointId openUdpTarget(const std::string& host, const std::string& port);
+    EndpointId openTcpTarget(const std::string& host, const std::string& port,
+                             OSCTCPTransport::Framing framing = OSCTCPTransport::Framing::LENGTH_PREFIX);
+    // Once close() returns the endpoint's handler is not running and will not run again
+    void close(EndpointId id);
+
+    // tag is handed back in the SendResult, e.g. to finish a latency trace
+    bool submit(EndpointId target, const void* data, size_t size, uint64_t tag = 0);
+    // Queues one copy of the packet for all targets; UDP targets on the same loop
+    // leave in the same sendmmsg() batch. Returns how many targets accepted it.
+    size_t submitFanout(const EndpointId* targets, size_t count, const void* data, size_t size, uint64_t tag = 0);
+
+    // Called on the loop thread once per packet queued for a UDP target, sent
+    // or failed. It must not block or wait on a thread that may call close().
+    // Cleared by close(); a null observer turns reporting off.
+    void setSendObserver(EndpointId target, SendObserver observer);
+    EndpointStats getEndpointStats(EndpointId target) const;
+    // Set while a TCP target's send queue, or a paced UDP target's backlog, is past
+    // half its bound; submissions still queue, but superseded values are better skipped
+    bool isBackpressured(EndpointId target) const;
+    // UDP targets only. Send results and full socket buffers drive the pacer's
+    // rate; turning pacing off sends whatever is waiting at once.
+    void setPacing(EndpointId target, bool enable, const OSCSendPacer::Config& config = OSCSendPacer::Config());
+
+    uint16_t getLocalPort(EndpointId receiver) const;
+    size_t getThreadCount() const { return shards_.size(); }
+    const char* getBackendName() const;
+    Stats getStats() const;
+
+private:
+    enum class EndpointKind {
+        UDP_RECEIVER,
+        UDP_TARGET,
+        TCP_TARGET
+    };
+
+    struct Endpoint {
+        EndpointKind kind;
+        size_t shard = 0;
+        int fd = -1;                                // Receivers only
+        sockaddr_storage address{};
+        socklen_t addressLength = 0;
+        PacketHandler handler;
+        std::unique_ptr<OSCTCPTransport> tcp;
+        EndpointId id = 0;
+        SendObserver sendObserver;                  // Loop thread only
+        std::atomic<uint64_t> packetsSent{0};
+        std::atomic<uint64_t> sendErrors{0};
+        std::atomic<int> lastError{0};
+        // Pacing, loop thread only (pacingRate is read by getEndpointStats)
+        struct PacedPacket {
+            std::vector<uint8_t> bytes;
+            uint64_t tag;
+            std::chrono::steady_clock::time_point submitted;
+        };
+        std::unique_ptr<OSCSendPacer> pacer;
+        std::deque<PacedPacket> paced;              // Over the rate, in submission order
+        OSCEventLoop::TimerId pacingTimer = 0;
+        std::atomic<double> pacingRate{0.0};
+        std::atomic<bool> backpressured{false};     // Paced backlog past half of kMaxPacedPackets
+    };
+
+    struct Pending {
+        std::shared_ptr<Endpoint> target;
+        size_t offset;
+        size_t size;
+        uint64_t tag;
+        std::chrono::steady_clock::time_point submitted;
+    };
+
+    struct Shard {
+        OSCEventLoop* loop = nullptr;
+        std::unique_ptr<OSCEventLoop> ownedLoop;
+        int sendFd4 = -1;
+        int sendFd6 = -1;
+
+        std::mutex queueMutex;
+        std::vector<Pending> pending;
+        std::vector<uint8_t> pendingBytes;
+        bool flushPosted = false;
+        // Loop-thread scratch, swapped with the pending buffers
+        std::vector<Pending> draining;
+        std::vector<uint8_t> drainingBytes;
+        size_t drainPosition = 0;
+        bool blocked = false;                   // Waiting for a send socket to drain
+        size_t pacedTargets = 0;                // Targets with a pacer, loop thread only
+        std::vector<uint8_t> receiveBuffer;
+
+        std::atomic<uint64_t> packetsSubmitted{0};
+        std::atomic<uint64_t> packetsSent{0};
+        std::atomic<uint64_t> packetsReceived{0};
+        std::atomic<uint64_t> sendErrors{0};
+        std::atomic<uint64_t> submissionsDropped{0};
+        std::atomic<uint64_t> sendCalls{0};
+        std::atomic<uint64_t> receiveCalls{0};
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    mutable std::shared_mutex endpointsMutex_;
+    std::unordered_map<EndpointId, std::shared_ptr<Endpoint>> endpoints_;
+    EndpointId nextId_ = 1;
+    std::atomic<size_t> nextShard_{0};
+
+    EndpointId addReceiver(int fd, PacketHandler handler);
+    EndpointId addEndpoint(std::shared_ptr<Endpoint> endpoint);
+    std::shared_ptr<Endpoint> findEndpoint(EndpointId id) const;
+    void flush(Shard& shard);
+    void complete(Shard& shard, const Pending& packet, int error, std::chrono::steady_clock::time_point now);
+    void resumeFlush(Shard& shard);
+    void holdOverRate(Shard& shard);
+    void releasePaced(Shard& shard, const std::shared_ptr<Endpoint>& endpoint);
+    void schedulePaced(Shard& shard, const std::shared_ptr<Endpoint>& endpoint);
+    void receive(Shard& shard, Endpoint& endpoint);
+    int sendSocket(Shard& shard, int family);
+};
@@ -0,0 +1,214 @@
+#include "OSCPacket.h"
+#include <chrono>
+#include <cstring>
+
+namespace OSCPacket {
+
+namespace {
+
+constexpr int kMaxBundleDepth = 8;
+
+size_t paddedSize(size_t length) {
+    return (length + 4) & ~size_t(3);   // Includes at least one terminating null
+}
+
+void writeBigEndian32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value >> 24);
+    out[1] = static_cast<uint8_t>(value >> 16);
+    out[2] = static_cast<uint8_t>(value >> 8);
+    out[3] = static_cast<uint8_t>(value);
+}
+
+uint32_t readBigEndian32(const uint8_t* in) {
+    return (uint32_t(in[0]) << 24) | (uint32_t(in[1]) << 16) | (uint32_t(in[2]) << 8) | in[3];
+}
+
+uint64_t readBigEndian64(const uint8_t* in) {
+    return (uint64_t(readBigEndian32(in)) << 32) | readBigEndian32(in + 4);
+}
+
+// Reads a null-terminated, 4-byte padded string starting at pos
+bool readString(const uint8_t* data, size_t size, size_t& pos, std::string_view& text) {
+    const void* end = std::memchr(data + pos, 0, size - pos);
+    if (!end) {
+        return false;
+    }
+    size_t length = static_cast<const uint8_t*>(end) - (data + pos);
+    text = std::string_view(reinterpret_cast<const char*>(data + pos), length);
+    pos += paddedSize(length);
+    return pos <= size;
+}
+
+bool decodeMessage(const uint8_t* data, size_t size, Message& message) {
+    size_t pos = 0;
+    std::string_view typeTags;
+    if (!readString(data, size, pos, message.address)) {
+        return false;
+    }
+    message.arguments.clear();
+    if (pos == size) {
+        message.types = {};   // OSC 1.0 allows a missing type tag string
+        return true;
+    }
+    if (!readString(data, size, pos, typeTags) || typeTags.empty() || typeTags[0] != ',') {
+        return false;
+    }
+    message.types = typeTags.substr(1);
+
+    for (char type : message.types) {
+        Argument argument;
+        argument.type = type;
+        switch (type) {
+            case 'f':
+            case 'i': {
+                if (pos + 4 > size) return false;
+                uint32_t bits = readBigEndian32(data + pos);
+                if (type == 'f') {
+                    float value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    argument.number = value;
+                } else {
+                    argument.number = static_cast<int32_t>(bits);
+                }
+                pos += 4;
+                break;
+            }
+            case 'd':
+            case 'h':
+            case 't': {
+                if (pos + 8 > size) return false;
+                uint64_t bits = readBigEndian64(data + pos);
+                if (type == 'd') {
+                    double value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    argument.number = value;
+                } else {
+                    argument.number = static_cast<double>(static_cast<int64_t>(bits));
+                }
+                pos += 8;
+                break;
+            }
+            case 's':
+            case 'S':
+                if (!readString(data, size, pos, argument.text)) return false;
+                break;
+            case 'b': {
+                if (pos + 4 > size) return false;
+                uint32_t length = readBigEndian32(data + pos);
+                pos += 4;
+                if (length > size - pos) return false;
+                argument.text = std::string_view(reinterpret_cast<const char*>(data + pos), length);
+                pos += (length + 3) & ~size_t(3);
+                break;
+            }
+            case 'T':
+                argument.number = 1.0;
+                break;
+            case 'F':
+            case 'N':
+            case 'I':
+                break;
+            default:
+                return false;   // Unknown tags have unknown sizes
+        }
+        message.arguments.push_back(argument);
+    }
+    return pos <= size;
+}
+
+bool walk(const uint8_t* data, size_t size, int depth, Message& message,
+          const std::function<void(const Message&)>& handler) {
+    if (size >= 16 && std::memcmp(data, "#bundle", 8) == 0) {
+        if (depth >= kMaxBundleDepth) {
+            return false;
+        }
+        size_t pos = 16;   // "#bundle\0" + timetag
+        while (pos + 4 <= size) {
+            uint32_t length = readBigEndian32(data + pos);
+            pos += 4;
+            if (length > size - pos || !walk(data + pos, length, depth + 1, message, handler)) {
+                return false;
+            }
+            pos += length;
+        }
+        return pos == size;
+    }
+    if (size == 0 || data[0] != '/' || !decodeMessage(data, size, message)) {
+        return false;
+    }
+    handler(message);
+    return true;
+}
+
+} // namespace
+
+uint64_t timetagNow() {
+    constexpr uint64_t kNtpUnixOffset = 2208988800ULL;   // 1900-01-01 to 1970-01-01
+    auto sinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count();
+    uint64_t seconds = static_cast<uint64_t>(nanos / 1000000000) + kNtpUnixOffset;
+    uint64_t fraction = (static_cast<uint64_t>(nanos % 1000000000) << 32) / 1000000000;
+    return (seconds << 32) | fraction;
+}
+
+size_t floatMessageSize(std::string_view address, size_t count) {
+    return paddedSize(address.size()) + paddedSize(count + 1) + 4 * count;
+}
+
+size_t writeFloatMessage(uint8_t* out, size_t capacity, std::string_view address, const float* values, size_t count) {
+    const size_t total = floatMessageSize(address, count);
+    if (total > capacity) {
+        return 0;
+    }
+    std::memset(out, 0, total);
+    std::memcpy(out, address.data(), address.size());
+    uint8_t* tags = out + paddedSize(address.size());
+    tags[0] = ',';
+    std::memset(tags + 1, 'f', count);
+    uint8_t* arguments = tags + paddedSize(count + 1);
+    for (size_t i = 0; i < count; i++) {
+        uint32_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        writeBigEndian32(arguments + 4 * i, bits);
+    }
+    return total;
+}
+
+void appendFloatMessage(std::vector<uint8_t>& out, std::string_view address, const float* values, size_t count) {
+    size_t offset = out.size();
+    out.resize(offset + floatMessageSize(address, count));
+    writeFloatMessage(out.data() + offset, out.size() - offset, address, values, count);
+}
+
+void appendBundleHeader(std::vector<uint8_t>& out, uint64_t timetag) {
+    static const char kTag[8] = {'#', 'b', 'u', 'n', 'd', 'l', 'e', 0};
+    out.insert(out.end(), kTag, kTag + sizeof(kTag));
+    size_t offset = out.size();
+    out.resize(offset + 8);
+    writeBigEndian32(out.data() + offset, static_cast<uint32_t>(timetag >> 32));
+    writeBigEndian32(out.data() + offset + 4, static_cast<uint32_t>(timetag));
+}
+
+void appendBundleFloatMessage(std::vector<uint8_t>& out, std::string_view address, const float* values, size_t count) {
+    size_t offset = out.size();
+    size_t size = floatMessageSize(address, count);
+    out.resize(offset + 4 + size);
+    writeBigEndian32(out.data() + offset, static_cast<uint32_t>(size));
+    writeFloatMessage(out.data() + offset + 4, size, address, values, count);
+}
+
+void appendBundleElement(std::vector<uint8_t>& out, const void* data, size_t size) {
+    size_t offset = out.size();
+    size_t padded = (size + 3) & ~size_t(3);
+    out.resize(offset + 4 + padded);
+    writeBigEndian32(out.data() + offset, static_cast<uint32_t>(padded));
+    std::memcpy(out.data() + offset + 4, data, size);
+    std::memset(out.data() + offset + 4 + size, 0, padded - size);
+}
+
+bool forEachMessage(const uint8_t* data, size_t size, const std::function<void(const Message&)>& handler) {
+    thread_local Message message;   // Keeps its argument capacity between packets
+    return walk(data, size, 0, message, handler);
+}
+
+} // namespace OSCPacket
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Minimal OSC 1.0 packet encoding and decoding
+ *
+ * Used where packets are handled as raw bytes (the network reactor) rather
+ * than through liblo. Encoding writes into caller-provided memory; decoding
+ * walks bundles recursively and hands out views into the packet, so neither
+ * allocates on the hot path.
+ */
+namespace OSCPacket {
+
+struct Argument {
+    char type = 0;            // OSC type tag
+    double number = 0.0;      // f, i, d, h, T (1), F (0)
+    std::string_view text;    // s, S, and the bytes of b
+};
+
+struct Message {
+    std::string_view address;
+    std::string_view types;   // Without the leading ','
+    std::vector<Argument> arguments;
+};
+
+constexpr uint64_t kImmediate = 1;   // OSC timetag meaning "now"
+
+// The system clock as an NTP timetag (seconds since 1900, 32.32 fixed point)
+uint64_t timetagNow();
+
+// Size of a float message once encoded
+size_t floatMessageSize(std::string_view address, size_t count);
+// Returns the encoded size, or 0 when it does not fit in capacity
+size_t writeFloatMessage(uint8_t* out, size_t capacity, std::string_view address, const float* values, size_t count);
+void appendFloatMessage(std::vector<uint8_t>& out, std::string_view address, const float* values, size_t count);
+// A bundle is its header followed by any number of size-prefixed elements
+void appendBundleHeader(std::vector<uint8_t>& out, uint64_t timetag = kImmediate);
+void appendBundleFloatMessage(std::vector<uint8_t>& out, std::string_view address, const float* values, size_t count);
+// An already encoded message (or nested bundle) as the next element
+void appendBundleElement(std::vector<uint8_t>& out, const void* data, size_t size);
+
+// Calls handler for each message, descending into bundles. False if malformed.
+bool forEachMessage(const uint8_t* data, size_t size, const std::function<void(const Message&)>& handler);
+
+} // namespace OSCPacket
@@ -0,0 +1,184 @@
+#include "OSCRateLimiter.h"
+#include <algorithm>
+#include <limits>
+
+OSCRateLimiter::OSCRateLimiter()
+    : idleTimeoutNs_(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds(10)).count()) {}
+
+int64_t OSCRateLimiter::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t OSCRateLimiter::hashKey(const std::string& key) {
+    // FNV-1a; 0 marks an empty slot
+    uint64_t hash = 1469598103934665603ull;
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    return hash ? hash : 1;
+}
+
+bool OSCRateLimiter::tryAcquire(const std::string& key, const Limits& limits) {
+    return tryAcquire(key, limits, nowNs());
+}
+
+bool OSCRateLimiter::tryAcquire(const std::string& key, const Limits& limits, int64_t now) {
+    uint64_t hash = hashKey(key);
+    Slot& slot = findSlot(hash, key, now);
+    slot.lastSeenNs.store(now, std::memory_order_relaxed);
+
+    if (acquire(slot, limits, now)) {
+        slot.allowed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    slot.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool OSCRateLimiter::acquire(Slot& slot, const Limits& limits, int64_t now) {
+    if (limits.ratePerSecond <= 0.0) {
+        return true;
+    }
+    const int64_t intervalNs = std::max<int64_t>(1, static_cast<int64_t>(1e9 / limits.ratePerSecond));
+    const int64_t toleranceNs = static_cast<int64_t>(intervalNs * std::max(1.0, limits.burst));
+
+    int64_t arrival = slot.arrivalNs.load(std::memory_order_relaxed);
+    while (true) {
+        int64_t next = std::max(arrival, now) + intervalNs;
+        if (next - now > toleranceNs) {
+            return false;   // Bucket empty; a drop leaves the state untouched
+        }
+        if (slot.arrivalNs.compare_exchange_weak(arrival, next, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
+
+OSCRateLimiter::Slot& OSCRateLimiter::findSlot(uint64_t hash, const std::string& key, int64_t now) {
+    auto& shard = shards_[hash % kShards];
+    const size_t start = (hash / kShards) % kSlotsPerShard;
+
+    while (true) {
+        Slot* oldest = nullptr;
+        int64_t oldestSeen = std::numeric_limits<int64_t>::max();
+        for (size_t i = 0; i < kProbeWindow; i++) {
+            Slot& slot = shard[(start + i) % kSlotsPerShard];
+            uint64_t current = slot.key.load(std::memory_order_acquire);
+            if (current == hash) {
+                return slot;
+            }
+            if (current == 0) {
+                // Slots are never emptied, so the key is absent; claim this one
+                uint64_t expected = 0;
+                if (slot.key.compare_exchange_strong(expected, hash, std::memory_order_acq_rel)) {
+                    claimSlot(slot, hash, key, now, 0);
+                    return slot;
+                }
+                if (expected == hash) {
+                    return slot;    // Another thread claimed it for the same key
+                }
+                continue;
+            }
+            int64_t seen = slot.lastSeenNs.load(std::memory_order_relaxed);
+            if (seen < oldestSeen) {
+                oldestSeen = seen;
+                oldest = &slot;
+            }
+        }
+
+        if (!oldest || now - oldestSeen < idleTimeoutNs_.load(std::memory_order_relaxed)) {
+            return overflow_;
+        }
+        uint64_t victim = oldest->key.load(std::memory_order_acquire);
+        if (oldest->key.compare_exchange_strong(victim, hash, std::memory_order_acq_rel)) {
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+            claimSlot(*oldest, hash, key, now, victim);
+            return *oldest;
+        }
+        // Lost the race for the victim; probe again
+    }
+}
+
+void OSCRateLimiter::claimSlot(Slot& slot, uint64_t hash, const std::string& key, int64_t now, uint64_t previous) {
+    slot.arrivalNs.store(0, std::memory_order_relaxed);
+    slot.lastSeenNs.store(now, std::memory_order_relaxed);
+    slot.allowed.store(0, std::memory_order_relaxed);
+    slot.dropped.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(namesMutex_);
+    if (previous) {
+        names_.erase(previous);
+    }
+    names_[hash] = key;
+}
+
+std::vector<OSCRateLimiter::KeyStats> OSCRateLimiter::getStats() const {
+    const int64_t now = nowNs();
+    std::vector<KeyStats> stats;
+
+    std::lock_guard<std::mutex> lock(namesMutex_);
+    auto collect = [&](const Slot& slot, const std::string& name) {
+        KeyStats entry;
+        entry.key = name;
+        entry.allowed = slot.allowed.load(std::memory_order_relaxed);
+        entry.dropped = slot.dropped.load(std::memory_order_relaxed);
+        entry.idleNs = now - slot.lastSeenNs.load(std::memory_order_relaxed);
+        stats.push_back(std::move(entry));
+    };
+    for (const auto& shard : shards_) {
+        for (const auto& slot : shard) {
+            uint64_t hash = slot.key.load(std::memory_order_acquire);
+            if (hash) {
+                auto it = names_.find(hash);
+                collect(slot, it != names_.end() ? it->second : std::string());
+            }
+        }
+    }
+    if (overflow_.allowed.load(std::memory_order_relaxed) || overflow_.dropped.load(std::memory_order_relaxed)) {
+        collect(overflow_, "*");
+    }
+
+    std::sort(stats.begin(), stats.end(), [](const KeyStats& a, const KeyStats& b) {
+        return a.dropped > b.dropped;
+    });
+    return stats;
+}
+
+uint64_t OSCRateLimiter::getTotalDropped() const {
+    uint64_t total = overflow_.dropped.load(std::memory_order_relaxed);
+    for (const auto& shard : shards_) {
+        for (const auto& slot : shard) {
+            total += slot.dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+size_t OSCRateLimiter::size() const {
+    size_t count = 0;
+    for (const auto& shard : shards_) {
+        for (const auto& slot : shard) {
+            count += slot.key.load(std::memory_order_relaxed) != 0;
+        }
+    }
+    return count;
+}
+
+void OSCRateLimiter::reset() {
+    for (auto& shard : shards_) {
+        for (auto& slot : shard) {
+            slot.key.store(0, std::memory_order_relaxed);
+            slot.arrivalNs.store(0, std::memory_order_relaxed);
+            slot.allowed.store(0, std::memory_order_relaxed);
+            slot.dropped.store(0, std::memory_order_relaxed);
+        }
+    }
+    overflow_.arrivalNs.store(0, std::memory_order_relaxed);
+    overflow_.allowed.store(0, std::memory_order_relaxed);
+    overflow_.dropped.store(0, std::memory_order_relaxed);
+    evictions_.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(namesMutex_);
+    names_.clear();
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Keyed token buckets in a fixed, sharded table with no lock on the hot path
+ *
+ * Each bucket is a single atomic "theoretical arrival time" (GCRA, the
+ * token bucket expressed as one timestamp), updated with a CAS loop, so
+ * sources never contend with each other and a refill never needs a timer.
+ * Keys hash to a shard and probe a short window of slots; a new key claims
+ * an empty slot with a CAS. When the window is full the least recently
+ * seen key is evicted if it has been idle for the idle timeout; otherwise
+ * the new key shares an overflow bucket, so a flood of new sources cannot
+ * push out active ones. Eviction racing an update may charge one message
+ * to the slot's new owner, which is harmless.
+ */
+class OSCRateLimiter {
+public:
+    struct Limits {
+        double ratePerSecond = 1000.0;  // Refill rate
+        double burst = 100.0;           // Messages allowed back-to-back
+    };
+
+    struct KeyStats {
+        std::string key;
+        uint64_t allowed = 0;
+        uint64_t dropped = 0;
+        int64_t idleNs = 0;
+    };
+
+    static constexpr size_t kShards = 16;
+    static constexpr size_t kSlotsPerShard = 64;
+    static constexpr size_t kProbeWindow = 8;
+
+    OSCRateLimiter();
+
+    // Limits are passed per call so they can differ per key and change at runtime
+    bool tryAcquire(const std::string& key, const Limits& limits);
+    bool tryAcquire(const std::string& key, const Limits& limits, int64_t nowNs);
+
+    void setIdleTimeout(std::chrono::nanoseconds timeout) { idleTimeoutNs_.store(timeout.count()); }
+    std::chrono::nanoseconds getIdleTimeout() const { return std::chrono::nanoseconds(idleTimeoutNs_.load()); }
+
+    // Keys currently tracked, most dropped first; the overflow bucket is reported as "*"
+    std::vector<KeyStats> getStats() const;
+    uint64_t getTotalDropped() const;
+    uint64_t getEvictions() const { return evictions_.load(std::memory_order_relaxed); }
+    size_t size() const;
+    void reset();
+
+    static int64_t nowNs();
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> key{0};           // 0 = empty
+        std::atomic<int64_t> arrivalNs{0};      // Theoretical arrival time of the next message
+        std::atomic<int64_t> lastSeenNs{0};
+        std::atomic<uint64_t> allowed{0};
+        std::atomic<uint64_t> dropped{0};
+    };
+
+    static uint64_t hashKey(const std::string& key);
+    Slot& findSlot(uint64_t hash, const std::string& key, int64_t nowNs);
+    void claimSlot(Slot& slot, uint64_t hash, const std::string& key, int64_t nowNs, uint64_t previous);
+    static bool acquire(Slot& slot, const Limits& limits, int64_t nowNs);
+
+    std::array<std::array<Slot, kSlotsPerShard>, kShards> shards_;
+    Slot overflow_;
+    std::atomic<int64_t> idleTimeoutNs_;
+    std::atomic<uint64_t> evictions_{0};
+
+    // Names for reporting only; touched when a key is claimed, never per message
+    mutable std::mutex namesMutex_;
+    std::unordered_map<uint64_t, std::string> names_;
+};
@@ -1,13 +1,14 @@
 #include "OSCReceiver.h"
 #include "ErrorHandler.h"
+#include <cstring>
 #include <iostream>
 
 OSCReceiver::OSCReceiver(const std::string& port, std::shared_ptr<OSCFormatManager> formatManager)
-    : server(nullptr), port(port), protocol(Protocol::UDP), formatManager(formatManager), running(false) {
+    : server(nullptr), endpoint(0), port(port), protocol(Protocol::UDP), formatManager(formatManager), running(false) {
 }
 
 OSCReceiver::OSCReceiver()
-    : server(nullptr), port(""), protocol(Protocol::UDP), formatManager(nullptr), running(false) {
+    : server(nullptr), endpoint(0), port(""), protocol(Protocol::UDP), formatManager(nullptr), running(false) {
 }
 
 OSCReceiver::~OSCReceiver() {
@@ -32,12 +33,28 @@ bool OSCReceiver::start(const std::string& port, Protocol protocol) {
     this->protocol = protocol;
     
     try {
-        if (protocol == Protocol::TCP) {
-            server = lo_server_thread_new_with_proto(port.c_str(), LO_TCP, errorHandler);
-        } else {
-            server = lo_server_thread_new(port.c_str(), errorHandler);
+        if (protocol != Protocol::TCP) {
+            auto handler = [this](const uint8_t* data, size_t size, const sockaddr_storage&) { handlePacket(data, size); };
+            if (protocol == Protocol::MULTICAST) {
+                endpoint = OSCNetworkReactor::shared().openMulticastReceiver(multicastGroup, port, handler,
+                                                                             multicastInterface);
+            } else {
+                endpoint = OSCNetworkReactor::shared().openUdpReceiver(port, handler);
+            }
+            if (!endpoint) {
+                ERROR_ERROR("Failed to create OSC server",
+                           "Port: " + port + (multicastGroup.empty() ? "" : ", group: " + multicastGroup),
+                           protocol == Protocol::MULTICAST ? "Check the group address and interface"
+                                                           : "Check if port is available", false);
+                return false;
+            }
+            running = true;
+            ERROR_INFO("OSC receiver started", "Listening on port " + port);
+            return true;
         }
         
+        server = lo_server_thread_new_with_proto(port.c_str(), LO_TCP, errorHandler);
+        
         if (!server) {
             ERROR_ERROR("Failed to create OSC server", "Port: " + port, 
                        "Check if port is available", false);
@@ -66,18 +83,30 @@ bool OSCReceiver::start(const std::string& port, Protocol protocol) {
 }
 
 void OSCReceiver::stop() {
-    if (!running || !server) {
+    if (!running) {
         return;
     }
     
-    lo_server_thread_stop(server);
-    lo_server_thread_free(server);
-    server = nullptr;
+    if (endpoint) {
+        // Waits for an in-flight packet, so no callback runs after this
+        OSCNetworkReactor::shared().close(endpoint);
+        endpoint = 0;
+    }
+    if (server) {
+        lo_server_thread_stop(server);
+        lo_server_thread_free(server);
+        server = nullptr;
+    }
     running = false;
     
     ERROR_INFO("OSC receiver stopped", "Port " + port + " released");
 }
 
+void OSCReceiver::setMulticastGroup(const std::string& group, const std::string& interfaceName) {
+    multicastGroup = group;
+    multicastInterface = interfaceName;
+}
+
 void OSCReceiver::setMessageCallback(std::function<void(const std::string&, const std::vector<float>&)> callback) {
     messageCallback = callback;
 }
@@ -111,6 +140,9 @@ std::string OSCReceiver::getURL() const {
         free(url);
         return result;
     }
+    if (endpoint) {
+        return "osc.udp://localhost:" + std::to_string(OSCNetworkReactor::shared().getLocalPort(endpoint)) + "/";
+    }
     return "osc://localhost:" + port + "/";
 }
 
@@ -124,43 +156,118 @@ void OSCReceiver::setupHandlers() {
     lo_server_thread_add_method(server, nullptr, nullptr, genericHandler, this);
 }
 
-int OSCReceiver::floatHandler(const char* path, const char* types, lo_arg** argv, 
-                             int argc, lo_message msg, void* user_data) {
-    (void)msg; // Suppress unused parameter warning
-    OSCReceiver* receiver = static_cast<OSCReceiver*>(user_data);
-    
-    std::vector<float> values;
-    for (int i = 0; i < argc; ++i) {
-        if (types[i] == 'f') {
-            values.push_back(argv[i]->f);
-        } else if (types[i] == 'i') {
-            values.push_back(static_cast<float>(argv[i]->i));
+void OSCReceiver::handlePacket(const uint8_t* data, size_t size) {
+    if (OSCStream::Decoder::isStreamPacket(data, size)) {
+        auto deliver = [this](const OSCPacket::Message& message) { handleMessage(message); };
+        if (!streamDecoder.process(data, size, OSCPacket::timetagNow(), deliver)) {
+            NETWORK_ERROR("Malformed OSC stream packet", "Port " + port + ", " + std::to_string(size) + " bytes", true,
+                         "Check the sender's stream mode settings");
         }
+        return;
     }
-    
+    if (!OSCPacket::forEachMessage(data, size, [this](const OSCPacket::Message& message) { handleMessage(message); })) {
+        NETWORK_ERROR("Malformed OSC packet", "Port " + port + ", " + std::to_string(size) + " bytes", true,
+                     "Check OSC messages format");
+    }
+}
+
+void OSCReceiver::handleMessage(const OSCPacket::Message& message) {
+    // Same method selection as the liblo server: exact "f", "i" or "s", else generic
+    std::string path(message.address);
+    if (message.types == "f") {
+        dispatchFloats(path, {static_cast<float>(message.arguments[0].number)}, true);
+    } else if (message.types == "i") {
+        dispatchInt(path, static_cast<int>(message.arguments[0].number));
+    } else if (message.types == "s") {
+        dispatchString(path, std::string(message.arguments[0].text));
+    } else {
+        std::vector<float> floatValues;
+        for (const auto& argument : message.arguments) {
+            if (argument.type == 'f' || argument.type == 'i' || argument.type == 'd') {
+                floatValues.push_back(static_cast<float>(argument.number));
+            }
+        }
+        dispatchGeneric(path, floatValues);
+    }
+}
+
+void OSCReceiver::dispatchFloats(const std::string& path, const std::vector<float>& values, bool single) {
     // Forward to learning system if enabled
-    if (receiver->formatManager && receiver->formatManager->isLearningMode()) {
-        receiver->formatManager->learnOSCMessage(path, values);
+    if (formatManager && formatManager->isLearningMode()) {
+        formatManager->learnOSCMessage(path, values);
     }
     
     // Handle single float
-    if (argc == 1 && receiver->floatCallback) {
-        receiver->floatCallback(path, values[0]);
+    if (single && floatCallback) {
+        floatCallback(path, values[0]);
     }
     
     // Handle float array
-    if (receiver->floatArrayCallback && !values.empty()) {
-        receiver->floatArrayCallback(path, values);
+    if (floatArrayCallback && !values.empty()) {
+        floatArrayCallback(path, values);
     }
     
     // Legacy callback
-    if (receiver->messageCallback && !values.empty()) {
-        receiver->messageCallback(path, values);
+    if (messageCallback && !values.empty()) {
+        messageCallback(path, values);
     }
     
-    if (receiver->formatManager) {
-        receiver->formatManager->recordMessageReceived(path);
+    if (formatManager) {
+        formatManager->recordMessageReceived(path);
+    }
+}
+
+void OSCReceiver::dispatchString(const std::string& path, const std::string& value) {
+    if (stringCallback) {
+        stringCallback(path, value);
     }
+    
+    if (formatManager) {
+        formatManager->recordMessageReceived(path);
+    }
+}
+
+void OSCReceiver::dispatchInt(const std::string& path, int value) {
+    if (intCallback) {
+        intCallback(path, value);
+    }
+    
+    if (formatManager) {
+        formatManager->recordMessageReceived(path);
+    }
+}
+
+void OSCReceiver::dispatchGeneric(const std::string& path, const std::vector<float>& values) {
+    // Forward to learning system if enabled  
+    if (formatManager && formatManager->isLearningMode() && !values.empty()) {
+        formatManager->learnOSCMessage(path, values);
+    }
+    
+    // Forward to callback
+    if (messageCallback && !values.empty()) {
+        messageCallback(path, values);
+    }
+    
+    if (formatManager) {
+        formatManager->recordMessageReceived(path);
+    }
+}
+
+int OSCReceiver::floatHandler(const char* path, const char* types, lo_arg** argv, 
+                             int argc, lo_message msg, void* user_data) {
+    (void)msg; // Suppress unused parameter warning
+    OSCReceiver* receiver = static_cast<OSCReceiver*>(user_data);
+    
+    std::vector<float> values;
+    for (int i = 0; i < argc; ++i) {
+        if (types[i] == 'f') {
+            values.push_back(argv[i]->f);
+        } else if (types[i] == 'i') {
+            values.push_back(static_cast<float>(argv[i]->i));
+        }
+    }
+    
+    receiver->dispatchFloats(path, values, argc == 1);
     return 0;
 }
 
@@ -170,13 +277,8 @@ int OSCReceiver::stringHandler(const char* path, const char* types, lo_arg** arg
     OSCReceiver* receiver = static_cast<OSCReceiver*>(user_data);
     
     if (argc > 0 && types[0] == 's') {
-        std::string value(&argv[0]->s);
-        if (receiver->stringCallback) {
-            receiver->stringCallback(path, value);
-        }
-    }
-    
-    if (receiver->formatManager) {
+        receiver->dispatchString(path, std::string(&argv[0]->s));
+    } else if (receiver->formatManager) {
         receiver->formatManager->recordMessageReceived(path);
     }
     return 0;
@@ -188,13 +290,8 @@ int OSCReceiver::intHandler(const char* path, const char* types, lo_arg** argv,
     OSCReceiver* receiver = static_cast<OSCReceiver*>(user_data);
     
     if (argc > 0 && types[0] == 'i') {
-        int value = argv[0]->i;
-        if (receiver->intCallback) {
-            receiver->intCallback(path, value);
-        }
-    }
-    
-    if (receiver->formatManager) {
+        receiver->dispatchInt(path, argv[0]->i);
+    } else if (receiver->formatManager) {
         receiver->formatManager->recordMessageReceived(path);
     }
     return 0;
@@ -205,6 +302,11 @@ int OSCReceiver::genericHandler(const char* path, const char* types, lo_arg** ar
     (void)msg; // Suppress unused parameter warning
     OSCReceiver* receiver = static_cast<OSCReceiver*>(user_data);
     
+    // Stream framing (sequence and parity) is not a value; sequence handling is UDP only
+    if (std::strncmp(path, "/cvosc/", 7) == 0) {
+        return 0;
+    }
+    
     // Handle mixed-type messages
     std::vector<float> floatValues;
     for (int i = 0; i < argc; ++i) {
@@ -221,19 +323,7 @@ int OSCReceiver::genericHandler(const char* path, const char* types, lo_arg** ar
         }
     }
     
-    // Forward to learning system if enabled  
-    if (receiver->formatManager && receiver->formatManager->isLearningMode() && !floatValues.empty()) {
-        receiver->formatManager->learnOSCMessage(path, floatValues);
-    }
-    
-    // Forward to callback
-    if (receiver->messageCallback && !floatValues.empty()) {
-        receiver->messageCallback(path, floatValues);
-    }
-    
-    if (receiver->formatManager) {
-        receiver->formatManager->recordMessageReceived(path);
-    }
+    receiver->dispatchGeneric(path, floatValues);
     return 0;
 }
 
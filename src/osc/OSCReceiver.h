@@ -5,15 +5,26 @@
 #include <functional>
 #include <lo/lo.h>
 #include "OSCFormatManager.h"
+#include "OSCNetworkReactor.h"
+#include "OSCPacket.h"
+#include "OSCStream.h"
 
 /**
  * @brief OSC Receiver class for handling incoming OSC messages
+ *
+ * UDP receivers are endpoints on the shared OSCNetworkReactor, so callbacks
+ * run on the reactor thread. TCP receivers still use a liblo server thread.
+ *
+ * Sequence-numbered stream bundles (OSCSender stream mode) are recognised
+ * as they arrive: duplicates and superseded late values are dropped, single
+ * losses are rebuilt from parity, and loss and jitter are counted.
  */
 class OSCReceiver {
 public:
     enum class Protocol {
         UDP,
-        TCP
+        TCP,
+        MULTICAST   // UDP on the port, joined to the group set with setMulticastGroup()
     };
 
     OSCReceiver(const std::string& port, std::shared_ptr<OSCFormatManager> formatManager = nullptr);
@@ -25,6 +36,7 @@ public:
     bool start();  // Legacy method using constructor port
     void stop();
     bool isRunning() const { return running; }
+    void setMulticastGroup(const std::string& group, const std::string& interfaceName = "");
     
     // Callbacks
     void setMessageCallback(std::function<void(const std::string&, const std::vector<float>&)> callback);
@@ -40,13 +52,20 @@ public:
     std::string getURL() const;
     std::string getPort() const { return port; }
     Protocol getProtocol() const { return protocol; }
+    // Sequence statistics over the stream senders seen on this port
+    OSCStream::Stats getStreamStats() const { return streamDecoder.getStats(); }
+    void resetStreamStats() { streamDecoder.resetStats(); }
     
 private:
     lo_server_thread server;
+    OSCNetworkReactor::EndpointId endpoint;
     std::string port;
     Protocol protocol;
+    std::string multicastGroup;
+    std::string multicastInterface;
     std::shared_ptr<OSCFormatManager> formatManager;
     bool running;
+    OSCStream::Decoder streamDecoder;
     
     // Callbacks
     std::function<void(const std::string&, const std::vector<float>&)> messageCallback;
@@ -56,6 +75,14 @@ private:
     std::function<void(const std::string&, const std::vector<float>&)> floatArrayCallback;
     
     void setupHandlers();
+    void handlePacket(const uint8_t* data, size_t size);
+    void handleMessage(const OSCPacket::Message& message);
+    
+    // Shared by the reactor and liblo paths
+    void dispatchFloats(const std::string& path, const std::vector<float>& values, bool single);
+    void dispatchString(const std::string& path, const std::string& value);
+    void dispatchInt(const std::string& path, int value);
+    void dispatchGeneric(const std::string& path, const std::vector<float>& values);
     
     // Static callback functions for liblo
     static int floatHandler(const char* path, const char* types, lo_arg** argv, 
@@ -0,0 +1,396 @@
+#include "OSCRouteAutomaton.h"
+#include <algorithm>
+
+namespace {
+
+// Per-thread frontier buffers; generation stamps make clearing the marks free
+struct Scratch {
+    std::vector<uint32_t> marks;
+    uint32_t generation = 0;
+    std::vector<uint32_t> current;
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> stack;
+
+    void beginStep(size_t nodeCount) {
+        if (marks.size() < nodeCount) {
+            marks.resize(nodeCount, 0);
+        }
+        if (++generation == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            generation = 1;
+        }
+    }
+};
+
+Scratch& scratch() {
+    thread_local Scratch instance;
+    return instance;
+}
+
+} // namespace
+
+bool OSCRouteAutomaton::tokenize(const std::string& pattern, Syntax syntax, std::vector<Token>& tokens) {
+    ByteSet any;
+    any.set();
+    ByteSet segment = any;
+    segment.reset('/');
+
+    auto literal = [&tokens](char c) {
+        Token token{Token::Kind::Literal};
+        token.byte = static_cast<uint8_t>(c);
+        tokens.push_back(std::move(token));
+    };
+    auto star = [&tokens](const ByteSet& set) {
+        Token token{Token::Kind::Star};
+        token.set = set;
+        tokens.push_back(std::move(token));
+    };
+
+    tokens.clear();
+    switch (syntax) {
+        case Syntax::Literal:
+            for (char c : pattern) literal(c);
+            return true;
+        case Syntax::Prefix:
+            for (char c : pattern) literal(c);
+            star(any);
+            return true;
+        case Syntax::Suffix:
+            star(any);
+            for (char c : pattern) literal(c);
+            return true;
+        case Syntax::Contains:
+            star(any);
+            for (char c : pattern) literal(c);
+            star(any);
+            return true;
+        case Syntax::Wildcard:
+            for (char c : pattern) {
+                if (c == '*') {
+                    star(any);
+                } else if (c == '?') {
+                    Token token{Token::Kind::Set};
+                    token.set = any;
+                    tokens.push_back(std::move(token));
+                } else {
+                    literal(c);
+                }
+            }
+            return true;
+        case Syntax::OSCPattern:
+            break;
+    }
+
+    for (size_t i = 0; i < pattern.size(); i++) {
+        char c = pattern[i];
+        if (c == '*') {
+            star(segment);
+        } else if (c == '?') {
+            Token token{Token::Kind::Set};
+            token.set = segment;
+            tokens.push_back(std::move(token));
+        } else if (c == '[') {
+            size_t close = pattern.find(']', i + 1);
+            if (close == std::string::npos) {
+                return false;
+            }
+            size_t pos = i + 1;
+            bool negate = pos < close && pattern[pos] == '!';
+            if (negate) pos++;
+            ByteSet set;
+            for (; pos < close; pos++) {
+                // '-' between two characters is a range; at either end it is literal
+                if (pos + 2 < close && pattern[pos + 1] == '-') {
+                    uint8_t low = static_cast<uint8_t>(pattern[pos]);
+                    uint8_t high = static_cast<uint8_t>(pattern[pos + 2]);
+                    for (int b = std::min(low, high); b <= std::max(low, high); b++) set.set(b);
+                    pos += 2;
+                } else {
+                    set.set(static_cast<uint8_t>(pattern[pos]));
+                }
+            }
+            Token token{Token::Kind::Set};
+            token.set = (negate ? ~set : set) & segment;
+            tokens.push_back(std::move(token));
+            i = close;
+        } else if (c == '{') {
+            size_t close = pattern.find('}', i + 1);
+            if (close == std::string::npos) {
+                return false;
+            }
+            Token token{Token::Kind::Alternatives};
+            size_t start = i + 1;
+            while (true) {
+                size_t comma = pattern.find(',', start);
+                if (comma == std::string::npos || comma > close) {
+                    token.options.push_back(pattern.substr(start, close - start));
+                    break;
+                }
+                token.options.push_back(pattern.substr(start, comma - start));
+                start = comma + 1;
+            }
+            tokens.push_back(std::move(token));
+            i = close;
+        } else {
+            literal(c);
+        }
+    }
+    return true;
+}
+
+uint32_t OSCRouteAutomaton::newNode() {
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+uint32_t OSCRouteAutomaton::internSet(const ByteSet& set) {
+    for (size_t i = 0; i < sets_.size(); i++) {
+        if (sets_[i] == set) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    sets_.push_back(set);
+    return static_cast<uint32_t>(sets_.size() - 1);
+}
+
+uint32_t OSCRouteAutomaton::literalChild(uint32_t node, uint8_t byte) {
+    auto& literals = nodes_[node].literals;
+    auto it = std::lower_bound(literals.begin(), literals.end(), std::make_pair(byte, uint32_t(0)));
+    if (it != literals.end() && it->first == byte) {
+        return it->second;
+    }
+    uint32_t child = newNode();
+    auto& edges = nodes_[node].literals;    // newNode() may have reallocated
+    edges.insert(std::lower_bound(edges.begin(), edges.end(), std::make_pair(byte, uint32_t(0))),
+                 std::make_pair(byte, child));
+    return child;
+}
+
+bool OSCRouteAutomaton::add(uint32_t ruleId, const std::string& pattern, Syntax syntax, int priority) {
+    std::vector<Token> tokens;
+    if (!tokenize(pattern, syntax, tokens)) {
+        return false;
+    }
+    if (nodes_.empty()) {
+        newNode();
+    }
+
+    // A node's language is the same for every rule passing through it, so
+    // literal edges, set edges and star states can all be shared
+    uint32_t node = 0;
+    for (const auto& token : tokens) {
+        switch (token.kind) {
+            case Token::Kind::Literal:
+                node = literalChild(node, token.byte);
+                break;
+            case Token::Kind::Set: {
+                uint32_t set = internSet(token.set);
+                uint32_t child = UINT32_MAX;
+                for (const auto& edge : nodes_[node].sets) {
+                    if (edge.first == set) child = edge.second;
+                }
+                if (child == UINT32_MAX) {
+                    child = newNode();
+                    nodes_[node].sets.emplace_back(set, child);
+                }
+                node = child;
+                break;
+            }
+            case Token::Kind::Star: {
+                int32_t set = static_cast<int32_t>(internSet(token.set));
+                uint32_t child = UINT32_MAX;
+                for (uint32_t target : nodes_[node].epsilons) {
+                    if (nodes_[target].loopSet == set) child = target;
+                }
+                if (child == UINT32_MAX) {
+                    child = newNode();
+                    nodes_[child].loopSet = set;
+                    nodes_[node].epsilons.push_back(child);
+                }
+                node = child;
+                break;
+            }
+            case Token::Kind::Alternatives: {
+                // Each option is a literal path; a fresh join node collects them
+                uint32_t join = newNode();
+                for (const auto& option : token.options) {
+                    uint32_t end = node;
+                    for (char c : option) {
+                        end = literalChild(end, static_cast<uint8_t>(c));
+                    }
+                    nodes_[end].epsilons.push_back(join);
+                }
+                node = join;
+                break;
+            }
+        }
+    }
+
+    if (priorities_.size() <= ruleId) {
+        priorities_.resize(ruleId + 1, 0);
+    }
+    priorities_[ruleId] = priority;
+    nodes_[node].accepts.push_back(ruleId);
+    if (better(static_cast<int32_t>(ruleId), nodes_[node].best)) {
+        nodes_[node].best = static_cast<int32_t>(ruleId);
+    }
+    return true;
+}
+
+void OSCRouteAutomaton::clear() {
+    nodes_.clear();
+    sets_.clear();
+    priorities_.clear();
+}
+
+bool OSCRouteAutomaton::better(int32_t a, int32_t b) const {
+    if (a < 0) return false;
+    if (b < 0) return true;
+    if (priorities_[a] != priorities_[b]) return priorities_[a] > priorities_[b];
+    return a < b;
+}
+
+const std::vector<uint32_t>* OSCRouteAutomaton::run(const char* address, size_t length) const {
+    if (nodes_.empty()) {
+        return nullptr;
+    }
+    Scratch& s = scratch();
+
+    auto enter = [this, &s](uint32_t node, std::vector<uint32_t>& into) {
+        s.stack.push_back(node);
+        while (!s.stack.empty()) {
+            uint32_t n = s.stack.back();
+            s.stack.pop_back();
+            if (s.marks[n] == s.generation) continue;
+            s.marks[n] = s.generation;
+            into.push_back(n);
+            for (uint32_t target : nodes_[n].epsilons) s.stack.push_back(target);
+        }
+    };
+
+    s.beginStep(nodes_.size());
+    s.current.clear();
+    enter(0, s.current);
+
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = static_cast<uint8_t>(address[i]);
+        s.beginStep(nodes_.size());
+        s.next.clear();
+        for (uint32_t n : s.current) {
+            const Node& node = nodes_[n];
+            auto it = std::lower_bound(node.literals.begin(), node.literals.end(), std::make_pair(byte, uint32_t(0)));
+            if (it != node.literals.end() && it->first == byte) {
+                enter(it->second, s.next);
+            }
+            for (const auto& edge : node.sets) {
+                if (sets_[edge.first].test(byte)) enter(edge.second, s.next);
+            }
+            if (node.loopSet >= 0 && sets_[node.loopSet].test(byte)) {
+                enter(n, s.next);
+            }
+        }
+        if (s.next.empty()) {
+            return nullptr;
+        }
+        s.current.swap(s.next);
+    }
+    return &s.current;
+}
+
+int32_t OSCRouteAutomaton::findBest(const char* address, size_t length) const {
+    const auto* frontier = run(address, length);
+    if (!frontier) {
+        return -1;
+    }
+    int32_t best = -1;
+    for (uint32_t n : *frontier) {
+        if (better(nodes_[n].best, best)) best = nodes_[n].best;
+    }
+    return best;
+}
+
+void OSCRouteAutomaton::findAll(const char* address, size_t length, std::vector<uint32_t>& rules) const {
+    rules.clear();
+    const auto* frontier = run(address, length);
+    if (!frontier) {
+        return;
+    }
+    for (uint32_t n : *frontier) {
+        rules.insert(rules.end(), nodes_[n].accepts.begin(), nodes_[n].accepts.end());
+    }
+    std::sort(rules.begin(), rules.end(), [this](uint32_t a, uint32_t b) {
+        return better(static_cast<int32_t>(a), static_cast<int32_t>(b));
+    });
+    rules.erase(std::unique(rules.begin(), rules.end()), rules.end());
+}
+
+bool OSCRouteAutomaton::matchSingle(const std::string& pattern, Syntax syntax, const std::string& address,
+                                    std::vector<std::string>* captures) {
+    std::vector<Token> tokens;
+    if (!tokenize(pattern, syntax, tokens)) {
+        return false;
+    }
+    std::vector<uint8_t> failed((tokens.size() + 1) * (address.size() + 1), 0);
+    if (captures) {
+        captures->clear();
+    }
+    bool matched = matchTokens(tokens, 0, address, 0, failed, captures);
+    if (captures) {
+        std::reverse(captures->begin(), captures->end());   // Appended innermost first
+    }
+    return matched;
+}
+
+bool OSCRouteAutomaton::matchTokens(const std::vector<Token>& tokens, size_t token, const std::string& address,
+                                    size_t pos, std::vector<uint8_t>& failed, std::vector<std::string>* captures) {
+    if (token == tokens.size()) {
+        return pos == address.size();
+    }
+    uint8_t& memo = failed[token * (address.size() + 1) + pos];
+    if (memo) {
+        return false;   // Already explored; keeps star backtracking polynomial
+    }
+
+    const Token& t = tokens[token];
+    bool matched = false;
+    switch (t.kind) {
+        case Token::Kind::Literal:
+            matched = pos < address.size() && static_cast<uint8_t>(address[pos]) == t.byte &&
+                      matchTokens(tokens, token + 1, address, pos + 1, failed, captures);
+            break;
+        case Token::Kind::Set:
+            if (pos < address.size() && t.set.test(static_cast<uint8_t>(address[pos])) &&
+                matchTokens(tokens, token + 1, address, pos + 1, failed, captures)) {
+                if (captures) captures->push_back(address.substr(pos, 1));
+                matched = true;
+            }
+            break;
+        case Token::Kind::Star: {
+            // Greedy: longest run first, as a regex would capture
+            size_t end = pos;
+            while (end < address.size() && t.set.test(static_cast<uint8_t>(address[end]))) end++;
+            for (size_t stop = end + 1; stop-- > pos;) {
+                if (matchTokens(tokens, token + 1, address, stop, failed, captures)) {
+                    if (captures) captures->push_back(address.substr(pos, stop - pos));
+                    matched = true;
+                    break;
+                }
+            }
+            break;
+        }
+        case Token::Kind::Alternatives:
+            for (const auto& option : t.options) {
+                if (address.compare(pos, option.size(), option) == 0 &&
+                    matchTokens(tokens, token + 1, address, pos + option.size(), failed, captures)) {
+                    if (captures) captures->push_back(option);
+                    matched = true;
+                    break;
+                }
+            }
+            break;
+    }
+    if (!matched) {
+        memo = 1;
+    }
+    return matched;
+}
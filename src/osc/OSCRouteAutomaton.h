@@ -0,0 +1,86 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Every route pattern compiled into one shared automaton
+ *
+ * Patterns are inserted into a trie whose literal edges are shared between
+ * routes, extended with OSC glob states: byte-set edges for '?' and '[]',
+ * self-looping star states for '*', and epsilon joins after '{a,b}'
+ * alternatives. Matching walks the address once, advancing the set of
+ * active states, so the cost depends on how many states are live at once
+ * rather than on how many routes exist. Accepting states carry their rule
+ * ids; the best rule is the highest priority, then the lowest id.
+ *
+ * Captures are not tracked during the pass; matchSingle() recovers them
+ * for the rules that matched, one rule at a time.
+ */
+class OSCRouteAutomaton {
+public:
+    enum class Syntax {
+        Literal,    // Exact address
+        Prefix,
+        Suffix,
+        Contains,
+        Wildcard,   // '*' and '?' match any byte, including '/'
+        OSCPattern  // OSC 1.0: '*' '?' '[a-z]' '[!a]' '{a,b}', none crossing '/'
+    };
+
+    // False if the pattern is malformed (unterminated '[' or '{'); nothing is added
+    bool add(uint32_t ruleId, const std::string& pattern, Syntax syntax, int priority);
+    void clear();
+
+    // Best rule id, or -1
+    int32_t findBest(const char* address, size_t length) const;
+    // All matching rule ids, best first
+    void findAll(const char* address, size_t length, std::vector<uint32_t>& rules) const;
+
+    size_t getNodeCount() const { return nodes_.size(); }
+    size_t getRuleCount() const { return priorities_.size(); }
+
+    // Matches one pattern on its own; each wildcard's text is appended to captures
+    static bool matchSingle(const std::string& pattern, Syntax syntax, const std::string& address,
+                            std::vector<std::string>* captures = nullptr);
+
+private:
+    using ByteSet = std::bitset<256>;
+
+    struct Token {
+        enum class Kind { Literal, Set, Star, Alternatives };
+
+        explicit Token(Kind tokenKind) : kind(tokenKind) {}
+
+        Kind kind;
+        uint8_t byte = 0;
+        ByteSet set;                        // Set, and the bytes a Star consumes
+        std::vector<std::string> options;   // Alternatives
+    };
+
+    struct Node {
+        std::vector<std::pair<uint8_t, uint32_t>> literals;     // Sorted by byte
+        std::vector<std::pair<uint32_t, uint32_t>> sets;        // (set index, child)
+        std::vector<uint32_t> epsilons;
+        int32_t loopSet = -1;               // Star state: consumes these bytes and stays
+        std::vector<uint32_t> accepts;
+        int32_t best = -1;
+    };
+
+    static bool tokenize(const std::string& pattern, Syntax syntax, std::vector<Token>& tokens);
+    static bool matchTokens(const std::vector<Token>& tokens, size_t token, const std::string& address,
+                            size_t pos, std::vector<uint8_t>& failed, std::vector<std::string>* captures);
+
+    uint32_t newNode();
+    uint32_t internSet(const ByteSet& set);
+    uint32_t literalChild(uint32_t node, uint8_t byte);
+    bool better(int32_t a, int32_t b) const;
+    // Runs the address through the automaton; the accepting frontier is left in the thread's scratch
+    const std::vector<uint32_t>* run(const char* address, size_t length) const;
+
+    std::vector<Node> nodes_;
+    std::vector<ByteSet> sets_;
+    std::vector<int> priorities_;           // By rule id
+};
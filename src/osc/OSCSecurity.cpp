@@ -6,6 +6,9 @@
 #include <regex>
 #include <cmath>
 #include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
 
 bool OSCSecurity::isAddressValid(const std::string& address) const {
     if (!config.enableValidation) return true;
@@ -17,7 +20,7 @@ bool OSCSecurity::isAddressValid(const std::string& address) const {
     
     // Check against whitelist if enabled
     if (config.enableAddressWhitelist && !config.allowedAddresses.empty()) {
-        if (std::find(config.allowedAddresses.begin(), config.allowedAddresses.end(), address) == config.allowedAddresses.end()) {
+        if (!addressValidator.isWhitelisted(address)) {
             return false;
         }
     }
@@ -26,7 +29,7 @@ bool OSCSecurity::isAddressValid(const std::string& address) const {
     // No blocked addresses check for now - could be added to config
     
     // Pattern matching
-    return matchesPattern(address, config.allowedAddressPattern);
+    return addressValidator.matchesPattern(address);
 }
 
 std::string OSCSecurity::sanitizeAddress(const std::string& address) const {
@@ -155,26 +158,28 @@ bool OSCSecurity::isHostAllowed(const std::string& host) const {
 }
 
 bool OSCSecurity::checkRateLimit() const {
+    return checkRateLimit(std::string(), std::string());
+}
+
+bool OSCSecurity::checkRateLimit(const std::string& source, const std::string& address) const {
     if (!config.enableRateLimiting) return true;
     
-    std::lock_guard<std::mutex> lock(rateLimitMutex);
-    
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - lastReset);
+    const int64_t now = OSCRateLimiter::nowNs();
     
-    // Reset counter every second
-    if (elapsed.count() >= 1) {
-        messageCount = 0;
-        lastReset = now;
-    }
-    
-    // Check if under limit
-    if (messageCount >= config.maxMessagesPerSecond) {
-        return false;
+    // Address buckets first: a message they drop is not charged to its source
+    for (const auto& rule : config.addressRateLimits) {
+        if (address.compare(0, rule.prefix.size(), rule.prefix) == 0) {
+            OSCRateLimiter::Limits limits{rule.messagesPerSecond, rule.burst};
+            if (!addressLimiter.tryAcquire(rule.prefix, limits, now)) {
+                return false;
+            }
+            break;
+        }
     }
     
-    messageCount++;
-    return true;
+    OSCRateLimiter::Limits limits{static_cast<double>(config.maxMessagesPerSecond),
+                                  static_cast<double>(config.rateLimitBurst)};
+    return sourceLimiter.tryAcquire(source, limits, now);
 }
 
 bool OSCSecurity::checkBundleSize(size_t bundleSize) const {
@@ -184,19 +189,19 @@ bool OSCSecurity::checkBundleSize(size_t bundleSize) const {
 }
 
 bool OSCSecurity::validateMessage(const std::string& address, float value) const {
-    return isAddressValid(address) && isFloatValid(value) && checkRateLimit();
+    return isAddressValid(address) && isFloatValid(value) && checkRateLimit(std::string(), address);
 }
 
 bool OSCSecurity::validateMessage(const std::string& address, int value) const {
-    return isAddressValid(address) && isIntValid(value) && checkRateLimit();
+    return isAddressValid(address) && isIntValid(value) && checkRateLimit(std::string(), address);
 }
 
 bool OSCSecurity::validateMessage(const std::string& address, const std::string& value) const {
-    return isAddressValid(address) && isStringValid(value) && checkRateLimit();
+    return isAddressValid(address) && isStringValid(value) && checkRateLimit(std::string(), address);
 }
 
 bool OSCSecurity::validateMessage(const std::string& address, const void* data, size_t size) const {
-    return isAddressValid(address) && isBlobValid(data, size) && checkRateLimit();
+    return isAddressValid(address) && isBlobValid(data, size) && checkRateLimit(std::string(), address);
 }
 
 std::string OSCSecurity::generateSecurityReport() const {
@@ -209,12 +214,30 @@ std::string OSCSecurity::generateSecurityReport() const {
     report << "Sanitization: " << (config.enableSanitization ? "ENABLED" : "DISABLED") << "\n";
     report << "Rate Limiting: " << (config.enableRateLimiting ? "ENABLED" : "DISABLED") << "\n";
     report << "Address Whitelist: " << (config.enableAddressWhitelist ? "ENABLED" : "DISABLED") << "\n";
+    report << "Address Pattern: " << config.allowedAddressPattern
+           << (addressValidator.usesDfa() ? " (DFA, " + std::to_string(addressValidator.getStateCount()) + " states)"
+                                          : " (std::regex)") << "\n";
     report << "Host Whitelist: " << (config.enableHostWhitelist ? "ENABLED" : "DISABLED") << "\n\n";
     
     if (config.enableRateLimiting) {
         report << "Rate Limits:\n";
-        report << "  Max Messages/Second: " << config.maxMessagesPerSecond << "\n";
-        report << "  Max Bundle Size: " << config.maxBundleSize << "\n\n";
+        report << "  Max Messages/Second (per source): " << config.maxMessagesPerSecond << "\n";
+        report << "  Burst: " << config.rateLimitBurst << "\n";
+        report << "  Max Bundle Size: " << config.maxBundleSize << "\n";
+        for (const auto& rule : config.addressRateLimits) {
+            report << "  " << rule.prefix << "*: " << rule.messagesPerSecond << "/s, burst " << rule.burst << "\n";
+        }
+        report << "\n";
+        
+        auto sources = sourceLimiter.getStats();
+        if (!sources.empty()) {
+            report << "Sources (" << sources.size() << ", " << sourceLimiter.getEvictions() << " evicted):\n";
+            for (const auto& source : sources) {
+                report << "  " << (source.key.empty() ? "local" : source.key) << ": " << source.allowed
+                       << " allowed, " << source.dropped << " dropped\n";
+            }
+            report << "\n";
+        }
     }
     
     report << "Value Constraints:\n";
@@ -246,76 +269,335 @@ std::string OSCSecurity::generateSecurityReport() const {
     return report.str();
 }
 
-bool OSCSecurity::matchesPattern(const std::string& address, const std::regex& pattern) const {
+void OSCSecurity::applyConfig() {
     try {
-        return std::regex_match(address, pattern);
+        addressValidator.compile(config.allowedAddressPattern, config.allowedAddresses);
     } catch (const std::regex_error& e) {
-        ErrorHandler::getInstance().logError("Regex pattern matching failed", e.what());
-        return false;
+        // An unusable pattern rejects every address rather than none
+        ErrorHandler::getInstance().logError("Invalid OSC address pattern: " + config.allowedAddressPattern, e.what());
+        addressValidator.compile("[]", config.allowedAddresses);
     }
+    sourceLimiter.setIdleTimeout(config.rateLimitIdleTimeout);
 }
 
 void OSCSecurity::resetRateLimit() const {
-    std::lock_guard<std::mutex> lock(rateLimitMutex);
-    messageCount = 0;
-    lastReset = std::chrono::steady_clock::now();
+    sourceLimiter.reset();
+    addressLimiter.reset();
 }
 
 // OSCSecurityAdvanced Implementation
-OSCSecurityAdvanced::OSCSecurityAdvanced() : rng(std::random_device{}()) {
-    initializeCrypto();
+namespace {
+
+const uint8_t kPacketMagic[4] = {'#', 'c', 'v', 's'};
+constexpr uint8_t kPacketVersion = 2;
+// Header offsets: the AEAD nonce is the salt's last 4 bytes and the sequence
+constexpr size_t kSaltOffset = 8;
+constexpr size_t kSequenceOffset = kSaltOffset + OSCSecurityAdvanced::kSaltSize;
+constexpr size_t kTimestampOffset = kSequenceOffset + 8;
+constexpr size_t kNonceOffset = kSequenceOffset - 4;
+static_assert(kTimestampOffset + 8 == OSCSecurityAdvanced::kHeaderSize, "header layout");
+
+void writeBigEndian(uint8_t* out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8 * (bytes - 1 - i)));
+    }
 }
 
-OSCSecurityAdvanced::OSCSecurityAdvanced(const SecurityProfile& profile) 
-    : profile(profile), rng(std::random_device{}()) {
-    initializeCrypto();
+uint64_t readBigEndian(const uint8_t* in, size_t bytes) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        value = (value << 8) | in[i];
+    }
+    return value;
 }
 
-bool OSCSecurityAdvanced::initializeCrypto() {
-    // Initialize OpenSSL (simplified for demo)
-    return true;
+void appendPadded(std::vector<uint8_t>& out, const std::string& text) {
+    out.insert(out.end(), text.begin(), text.end());
+    out.resize(out.size() + 4 - text.size() % 4, 0);   // At least one null, 4-byte aligned
+}
+
+const char* getEncryptionName(OSCSecurityAdvanced::EncryptionMode mode) {
+    switch (mode) {
+        case OSCSecurityAdvanced::EncryptionMode::AES_256_GCM: return "AES-256-GCM";
+        case OSCSecurityAdvanced::EncryptionMode::CHACHA20_POLY1305: return "ChaCha20-Poly1305";
+        default: return "None";
+    }
+}
+
+} // namespace
+
+OSCSecurityAdvanced::OSCSecurityAdvanced() : OSCSecurityAdvanced(SecurityProfile{}) {}
+
+OSCSecurityAdvanced::OSCSecurityAdvanced(const SecurityProfile& profile) : profile(profile) {
+    for (auto& session : sessions) {
+        session = std::make_unique<Session>();
+    }
+    pendingSession = std::make_unique<Session>();
+    deriveKeys();
+}
+
+void OSCSecurityAdvanced::setSecurityProfile(const SecurityProfile& newProfile) {
+    profile = newProfile;
+    deriveKeys();
+}
+
+bool OSCSecurityAdvanced::deriveKeys() {
+    keysReady = false;
+    if (profile.sharedSecret.empty()) {
+        return false;
+    }
+    
+    // A new salt, and with it a new AEAD key, every time: a restarted or
+    // rekeyed sender never repeats a (key, nonce) pair
+    std::lock_guard<std::mutex> sealLock(sealMutex);
+    std::lock_guard<std::mutex> openLock(openMutex);
+    for (auto& session : sessions) {
+        session->used = false;
+    }
+    pendingSession = std::make_unique<Session>();
+    
+    const auto* secret = reinterpret_cast<const uint8_t*>(profile.sharedSecret.data());
+    uint8_t encryptionKey[OSCCrypto::kKeySize];
+    uint8_t macKey[OSCCrypto::kKeySize];
+    bool derived = OSCCrypto::randomBytes(sessionSalt.data(), sessionSalt.size()) &&
+                   OSCCrypto::deriveKey(secret, profile.sharedSecret.size(), sessionSalt.data(), sessionSalt.size(),
+                                        "osc-aead-v2", encryptionKey, sizeof(encryptionKey)) &&
+                   OSCCrypto::deriveKey(secret, profile.sharedSecret.size(), "cv_to_osc_converter", "osc-hmac-v1",
+                                        macKey, sizeof(macKey));
+    if (derived) {
+        auto algorithm = profile.encryption == EncryptionMode::CHACHA20_POLY1305
+                             ? OSCAeadCipher::Algorithm::CHACHA20_POLY1305
+                             : OSCAeadCipher::Algorithm::AES_256_GCM;
+        keysReady = sealCipher.setKey(algorithm, encryptionKey) && sealMac.setKey(macKey, sizeof(macKey)) &&
+                    openMac.setKey(macKey, sizeof(macKey));
+    } else {
+        ErrorHandler::getInstance().logError("OSC security key derivation failed",
+                                             OSCCrypto::isAvailable() ? "" : "built without OpenSSL");
+    }
+    std::fill(std::begin(encryptionKey), std::end(encryptionKey), 0);
+    std::fill(std::begin(macKey), std::end(macKey), 0);
+    return keysReady;
 }
 
 bool OSCSecurityAdvanced::generateKeyPair() {
-    // Simplified key generation
-    profile.sharedSecret = "generated_secret_key_32_bytes_long";
-    return true;
+    uint8_t secret[32];
+    if (!OSCCrypto::randomBytes(secret, sizeof(secret))) {
+        return false;
+    }
+    static const char hex[] = "0123456789abcdef";
+    std::string encoded;
+    for (uint8_t byte : secret) {
+        encoded += hex[byte >> 4];
+        encoded += hex[byte & 0x0f];
+    }
+    std::fill(std::begin(secret), std::end(secret), 0);
+    profile.sharedSecret = encoded;
+    return deriveKeys();
 }
 
 bool OSCSecurityAdvanced::setSharedSecret(const std::string& secret) {
     if (secret.length() >= 32) {
         profile.sharedSecret = secret;
-        return true;
+        return deriveKeys();
     }
     return false;
 }
 
-std::vector<uint8_t> OSCSecurityAdvanced::generateNonce() const {
-    std::vector<uint8_t> nonce(12);
-    for (size_t i = 0; i < nonce.size(); ++i) {
-        nonce[i] = static_cast<uint8_t>(rng() % 256);
+bool OSCSecurityAdvanced::loadKeysFromFile(const std::string& keyFile) {
+    std::ifstream file(keyFile);
+    std::string secret;
+    if (!file || !std::getline(file, secret)) {
+        return false;
     }
-    return nonce;
+    return setSharedSecret(secret);
 }
 
-bool OSCSecurityAdvanced::validateNonce(const std::vector<uint8_t>& nonce) {
-    std::lock_guard<std::mutex> lock(nonceMutex);
-    if (usedNonces.find(nonce) != usedNonces.end()) {
-        return false; // Replay attack
+bool OSCSecurityAdvanced::saveKeysToFile(const std::string& keyFile) const {
+    if (profile.sharedSecret.empty()) {
+        return false;
+    }
+    std::ofstream file(keyFile, std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    chmod(keyFile.c_str(), S_IRUSR | S_IWUSR);   // Owner-only before the secret is written
+    file << profile.sharedSecret << "\n";
+    return static_cast<bool>(file.flush());
+}
+
+size_t OSCSecurityAdvanced::getOverhead() const {
+    if (profile.encryption != EncryptionMode::NONE) {
+        return kHeaderSize + OSCAeadCipher::kTagSize;   // The AEAD tag authenticates as well
+    }
+    return kHeaderSize + (profile.authentication == AuthMode::HMAC_SHA256 ? OSCCrypto::kMacSize : 0);
+}
+
+void OSCSecurityAdvanced::writeHeader(uint8_t* header, uint64_t sequenceNumber, uint64_t timestamp) const {
+    std::copy(std::begin(kPacketMagic), std::end(kPacketMagic), header);
+    header[4] = kPacketVersion;
+    header[5] = static_cast<uint8_t>(profile.encryption);
+    header[6] = static_cast<uint8_t>(profile.authentication);
+    header[7] = 0;
+    std::copy(sessionSalt.begin(), sessionSalt.end(), header + kSaltOffset);
+    writeBigEndian(header + kSequenceOffset, sequenceNumber, 8);
+    writeBigEndian(header + kTimestampOffset, timestamp, 8);
+}
+
+bool OSCSecurityAdvanced::sealPacket(const uint8_t* payload, size_t length, uint8_t* out, size_t capacity,
+                                     size_t& packetLength) const {
+    const bool encrypt = profile.encryption != EncryptionMode::NONE;
+    const bool mac = !encrypt && profile.authentication == AuthMode::HMAC_SHA256;
+    if ((encrypt || mac || profile.authentication == AuthMode::RSA_SIGNATURE) && !keysReady) {
+        return false;
+    }
+    if (profile.authentication == AuthMode::RSA_SIGNATURE && !encrypt) {
+        return false;
+    }
+    const size_t overhead = getOverhead();
+    if (capacity < length + overhead) {
+        return false;
+    }
+    
+    uint8_t* body = out + kHeaderSize;
+    bool sealed = true;
+    // The header is written under the lock, so its salt always matches the key
+    std::lock_guard<std::mutex> lock(sealMutex);
+    writeHeader(out, sequence.fetch_add(1, std::memory_order_relaxed) + 1, getCurrentTimestamp());
+    if (encrypt) {
+        sealed = sealCipher.seal(out + kNonceOffset, out, kHeaderSize, payload, length, body, body + length);
+    } else {
+        std::memmove(body, payload, length);
+        if (mac) {
+            sealed = sealMac.compute(out, kHeaderSize, body, length, body + length);
+        }
+    }
+    packetLength = sealed ? length + overhead : 0;
+    return sealed;
+}
+
+bool OSCSecurityAdvanced::openPacket(const uint8_t* packet, size_t length, uint8_t* out, size_t capacity,
+                                     size_t& payloadLength) const {
+    payloadLength = 0;
+    const size_t overhead = getOverhead();
+    if (length < overhead || !std::equal(std::begin(kPacketMagic), std::end(kPacketMagic), packet) ||
+        packet[4] != kPacketVersion) {
+        return false;
+    }
+    // The modes must match ours exactly: no downgrade to a weaker mode
+    if (packet[5] != static_cast<uint8_t>(profile.encryption) ||
+        packet[6] != static_cast<uint8_t>(profile.authentication)) {
+        return false;
+    }
+    const size_t bodyLength = length - overhead;
+    if (capacity < bodyLength) {
+        return false;
+    }
+    if (!validateTimestamp(readBigEndian(packet + kTimestampOffset, 8))) {
+        return false;
+    }
+    
+    const bool encrypt = profile.encryption != EncryptionMode::NONE;
+    const bool mac = !encrypt && profile.authentication == AuthMode::HMAC_SHA256;
+    if ((encrypt || mac) && !keysReady) {
+        return false;
+    }
+    const uint8_t* body = packet + kHeaderSize;
+    std::lock_guard<std::mutex> lock(openMutex);
+    Session* session = (encrypt || mac) ? findSession(packet + kSaltOffset) : nullptr;
+    if ((encrypt || mac) && !session) {
+        return false;
+    }
+    if (encrypt) {
+        if (!session->cipher.open(packet + kNonceOffset, packet, kHeaderSize, body, bodyLength, body + bodyLength,
+                                  out)) {
+            return false;
+        }
+    } else {
+        if (mac) {
+            uint8_t expected[OSCCrypto::kMacSize];
+            if (!openMac.compute(packet, kHeaderSize, body, bodyLength, expected) ||
+                !OSCCrypto::constantTimeEquals(expected, body + bodyLength, sizeof(expected))) {
+                return false;
+            }
+        }
+        std::memmove(out, body, bodyLength);
     }
-    usedNonces.insert(nonce);
-    if (usedNonces.size() > profile.nonceWindowSize) {
-        cleanupOldNonces();
+    
+    // Replay state only advances, and new sessions only take a slot, for authenticated packets
+    if ((encrypt || mac) && profile.enableNonceValidation &&
+        !acceptSequence(session, readBigEndian(packet + kSequenceOffset, 8))) {
+        return false;
     }
+    payloadLength = bodyLength;
     return true;
 }
 
-void OSCSecurityAdvanced::cleanupOldNonces() {
-    if (usedNonces.size() > profile.nonceWindowSize / 2) {
-        auto it = usedNonces.begin();
-        std::advance(it, usedNonces.size() / 2);
-        usedNonces.erase(usedNonces.begin(), it);
+OSCSecurityAdvanced::Session* OSCSecurityAdvanced::findSession(const uint8_t* salt) const {
+    for (auto& session : sessions) {
+        if (session->used && std::equal(session->salt.begin(), session->salt.end(), salt)) {
+            return session.get();
+        }
+    }
+    // New sender session: key it aside until a packet under it authenticates
+    Session* pending = pendingSession.get();
+    if (std::equal(pending->salt.begin(), pending->salt.end(), salt) && pending->cipher.hasKey()) {
+        return pending;
+    }
+    std::copy(salt, salt + kSaltSize, pending->salt.begin());
+    pending->window.reset();
+    if (profile.encryption == EncryptionMode::NONE) {
+        return pending;   // HMAC only: the session just needs its replay window
+    }
+    uint8_t key[OSCCrypto::kKeySize];
+    const auto* secret = reinterpret_cast<const uint8_t*>(profile.sharedSecret.data());
+    auto algorithm = profile.encryption == EncryptionMode::CHACHA20_POLY1305
+                         ? OSCAeadCipher::Algorithm::CHACHA20_POLY1305
+                         : OSCAeadCipher::Algorithm::AES_256_GCM;
+    bool keyed = OSCCrypto::deriveKey(secret, profile.sharedSecret.size(), salt, kSaltSize, "osc-aead-v2", key,
+                                      sizeof(key)) &&
+                 pending->cipher.setKey(algorithm, key);
+    std::fill(std::begin(key), std::end(key), 0);
+    if (!keyed) {
+        pending->salt.fill(0);
+        return nullptr;
     }
+    return pending;
+}
+
+bool OSCSecurityAdvanced::acceptSequence(Session* session, uint64_t sequenceNumber) const {
+    if (session == pendingSession.get()) {
+        // Take a free slot, else the least recently used
+        auto* slot = &sessions[0];
+        for (auto& candidate : sessions) {
+            if (!candidate->used || candidate->lastUsed < (*slot)->lastUsed) {
+                slot = &candidate;
+                if (!candidate->used) break;
+            }
+        }
+        std::swap(*slot, pendingSession);
+        session->used = true;
+        pendingSession->used = false;
+        pendingSession->salt.fill(0);
+    }
+    session->lastUsed = ++sessionClock;
+    return session->window.accept(sequenceNumber);
+}
+
+std::vector<uint8_t> OSCSecurityAdvanced::generateNonce() const {
+    std::vector<uint8_t> nonce(kSaltSize + 8);
+    std::lock_guard<std::mutex> lock(sealMutex);
+    std::copy(sessionSalt.begin(), sessionSalt.end(), nonce.begin());
+    writeBigEndian(nonce.data() + kSaltSize, sequence.fetch_add(1, std::memory_order_relaxed) + 1, 8);
+    return nonce;
+}
+
+bool OSCSecurityAdvanced::validateNonce(const std::vector<uint8_t>& nonce) {
+    if (nonce.size() != kSaltSize + 8) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(openMutex);
+    Session* session = findSession(nonce.data());
+    return session && acceptSequence(session, readBigEndian(nonce.data() + kSaltSize, 8));
 }
 
 uint64_t OSCSecurityAdvanced::getCurrentTimestamp() const {
@@ -330,123 +612,297 @@ bool OSCSecurityAdvanced::validateTimestamp(uint64_t timestamp) const {
 }
 
 bool OSCSecurityAdvanced::encryptMessage(const std::vector<uint8_t>& plaintext, EncryptedMessage& encrypted) const {
+    encrypted.timestamp = getCurrentTimestamp();
     if (profile.encryption == EncryptionMode::NONE) {
         encrypted.ciphertext = plaintext;
-        return true;
+        return profile.authentication != AuthMode::HMAC_SHA256 || signMessage(plaintext, encrypted.signature);
     }
-    // Simplified encryption for demo
-    encrypted.nonce = generateNonce();
-    encrypted.timestamp = getCurrentTimestamp();
-    encrypted.ciphertext = plaintext; // In real implementation would encrypt
-    return true;
+    if (!keysReady) return false;
+    
+    uint8_t timestamp[8];
+    writeBigEndian(timestamp, encrypted.timestamp, sizeof(timestamp));
+    encrypted.ciphertext.resize(plaintext.size());
+    encrypted.tag.resize(OSCAeadCipher::kTagSize);
+    std::lock_guard<std::mutex> lock(sealMutex);
+    // Session salt | sequence; the AEAD nonce is its last 12 bytes, as in a packet header
+    encrypted.nonce.resize(kSaltSize + 8);
+    std::copy(sessionSalt.begin(), sessionSalt.end(), encrypted.nonce.begin());
+    writeBigEndian(encrypted.nonce.data() + kSaltSize, sequence.fetch_add(1, std::memory_order_relaxed) + 1, 8);
+    return sealCipher.seal(encrypted.nonce.data() + kSaltSize + 8 - OSCAeadCipher::kNonceSize, timestamp, sizeof(timestamp), plaintext.data(), plaintext.size(),
+                           encrypted.ciphertext.data(), encrypted.tag.data());
 }
 
 bool OSCSecurityAdvanced::decryptMessage(const EncryptedMessage& encrypted, std::vector<uint8_t>& plaintext) const {
     if (profile.encryption == EncryptionMode::NONE) {
+        if (profile.authentication == AuthMode::HMAC_SHA256 &&
+            !verifySignature(encrypted.ciphertext, encrypted.signature)) {
+            return false;
+        }
         plaintext = encrypted.ciphertext;
         return true;
     }
-    if (!validateTimestamp(encrypted.timestamp)) return false;
-    plaintext = encrypted.ciphertext; // In real implementation would decrypt
+    if (!keysReady || !validateTimestamp(encrypted.timestamp) ||
+        encrypted.nonce.size() != kSaltSize + 8 || encrypted.tag.size() != OSCAeadCipher::kTagSize) {
+        return false;
+    }
+    
+    uint8_t timestamp[8];
+    writeBigEndian(timestamp, encrypted.timestamp, sizeof(timestamp));
+    plaintext.resize(encrypted.ciphertext.size());
+    std::lock_guard<std::mutex> lock(openMutex);
+    Session* session = findSession(encrypted.nonce.data());
+    if (!session ||
+        !session->cipher.open(encrypted.nonce.data() + kSaltSize + 8 - OSCAeadCipher::kNonceSize, timestamp, sizeof(timestamp), encrypted.ciphertext.data(),
+                         encrypted.ciphertext.size(), encrypted.tag.data(), plaintext.data())) {
+        plaintext.clear();
+        return false;
+    }
+    return true;
+}
+
+bool OSCSecurityAdvanced::signMessage(const std::vector<uint8_t>& message, std::vector<uint8_t>& signature) const {
+    if (profile.authentication != AuthMode::HMAC_SHA256 || !keysReady) {
+        return false;
+    }
+    signature.resize(OSCCrypto::kMacSize);
+    std::lock_guard<std::mutex> lock(sealMutex);
+    return sealMac.compute(message.data(), message.size(), nullptr, 0, signature.data());
+}
+
+bool OSCSecurityAdvanced::verifySignature(const std::vector<uint8_t>& message,
+                                          const std::vector<uint8_t>& signature) const {
+    if (profile.authentication != AuthMode::HMAC_SHA256 || !keysReady || signature.size() != OSCCrypto::kMacSize) {
+        return false;
+    }
+    uint8_t expected[OSCCrypto::kMacSize];
+    std::lock_guard<std::mutex> lock(openMutex);
+    return openMac.compute(message.data(), message.size(), nullptr, 0, expected) &&
+           OSCCrypto::constantTimeEquals(expected, signature.data(), sizeof(expected));
+}
+
+bool OSCSecurityAdvanced::secureOSCMessage(const std::string& address, const std::vector<float>& args,
+                                           std::vector<uint8_t>& secureData) const {
+    std::vector<uint8_t> message;
+    appendPadded(message, address);
+    appendPadded(message, "," + std::string(args.size(), 'f'));
+    for (float arg : args) {
+        uint32_t bits;
+        std::memcpy(&bits, &arg, sizeof(bits));
+        message.resize(message.size() + 4);
+        writeBigEndian(message.data() + message.size() - 4, bits, 4);
+    }
+    
+    secureData.resize(message.size() + getOverhead());
+    size_t packetLength = 0;
+    if (!sealPacket(message.data(), message.size(), secureData.data(), secureData.size(), packetLength)) {
+        secureData.clear();
+        return false;
+    }
+    secureData.resize(packetLength);
+    return true;
+}
+
+bool OSCSecurityAdvanced::verifyOSCMessage(const std::vector<uint8_t>& secureData,
+                                           std::string& address, std::vector<float>& args) const {
+    std::vector<uint8_t> message(secureData.size());
+    size_t length = 0;
+    if (!openPacket(secureData.data(), secureData.size(), message.data(), message.size(), length)) {
+        return false;
+    }
+    
+    auto readString = [&](size_t& pos, std::string& text) {
+        size_t end = pos;
+        while (end < length && message[end] != 0) end++;
+        if (end >= length) return false;
+        text.assign(reinterpret_cast<const char*>(message.data() + pos), end - pos);
+        pos = (end + 4) & ~size_t(3);
+        return pos <= length;
+    };
+    size_t pos = 0;
+    std::string typeTags;
+    if (!readString(pos, address) || !readString(pos, typeTags) || typeTags.empty() || typeTags[0] != ',') {
+        return false;
+    }
+    args.clear();
+    for (size_t i = 1; i < typeTags.size(); i++) {
+        if (typeTags[i] != 'f' || pos + 4 > length) return false;
+        uint32_t bits = static_cast<uint32_t>(readBigEndian(message.data() + pos, 4));
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        args.push_back(value);
+        pos += 4;
+    }
     return true;
 }
 
 std::string OSCSecurityAdvanced::generateSecurityAudit() const {
     std::stringstream audit;
     audit << "Advanced OSC Security Audit:\n";
-    audit << "- Encryption: " << (profile.encryption == EncryptionMode::AES_256_GCM ? "AES-256-GCM" : "None") << "\n";
-    audit << "- Authentication: " << (profile.authentication == AuthMode::HMAC_SHA256 ? "HMAC-SHA256" : "None") << "\n";
+    audit << "- Crypto backend: " << (OSCCrypto::isAvailable() ? "OpenSSL libcrypto" : "unavailable (fails closed)") << "\n";
+    audit << "- Encryption: " << getEncryptionName(profile.encryption) << "\n";
+    audit << "- Authentication: " << (profile.encryption != EncryptionMode::NONE ? "AEAD tag" :
+                                      profile.authentication == AuthMode::HMAC_SHA256 ? "HMAC-SHA256" : "None") << "\n";
+    audit << "- Keys: " << (keysReady ? "derived (HKDF-SHA256, per-session salt)" : "not set") << "\n";
     audit << "- Timestamp validation: " << (profile.requireTimestamp ? "Enabled" : "Disabled") << "\n";
-    audit << "- Nonce validation: " << (profile.enableNonceValidation ? "Enabled" : "Disabled") << "\n";
-    audit << "- Active nonces: " << usedNonces.size() << "\n";
+    audit << "- Replay window: " << (profile.enableNonceValidation ? std::to_string(OSCReplayWindow::kWindowSize) + " packets per session" : "Disabled") << "\n";
+    
+    std::lock_guard<std::mutex> lock(openMutex);
+    size_t active = std::count_if(sessions.begin(), sessions.end(),
+                                  [](const std::unique_ptr<Session>& session) { return session->used; });
+    audit << "- Active sender sessions: " << active << "/" << kMaxSessions << "\n";
     return audit.str();
 }
 
 // OSCPatternMatcher Implementation
 void OSCPatternMatcher::addRoute(const RouteRule& rule) {
     if (validateRule(rule)) {
-        routes.push_back(rule);
-        std::sort(routes.begin(), routes.end(), [](const RouteRule& a, const RouteRule& b) {
-            return a.priority > b.priority;
-        });
+        // Ordered insert: after every rule of the same or higher priority
+        routes.insert(std::upper_bound(routes.begin(), routes.end(), rule,
+                                       [](const RouteRule& a, const RouteRule& b) { return a.priority > b.priority; }),
+                      rule);
+        // Appending keeps ids in insertion order, which breaks priority ties the same way
+        compileRule(rule);
     }
 }
 
 void OSCPatternMatcher::removeRoute(const std::string& pattern) {
     routes.erase(std::remove_if(routes.begin(), routes.end(),
         [&](const RouteRule& rule) { return rule.pattern == pattern; }), routes.end());
+    rebuild();
 }
 
-std::vector<OSCPatternMatcher::MatchResult> OSCPatternMatcher::matchPattern(const std::string& address) const {
-    std::vector<MatchResult> results;
-    for (const auto& rule : routes) {
-        if (!rule.enabled) continue;
-        if (isMatch(address, rule)) {
-            MatchResult result;
-            result.matched = true;
-            result.targetAddress = rule.targetAddress;
-            result.targetHost = rule.targetHost;
-            result.targetPort = rule.targetPort;
-            results.push_back(result);
-        }
+void OSCPatternMatcher::updateRoute(const std::string& pattern, const RouteRule& rule) {
+    if (!validateRule(rule)) return;
+    for (auto& route : routes) {
+        if (route.pattern == pattern) route = rule;
     }
-    return results;
+    std::stable_sort(routes.begin(), routes.end(), [](const RouteRule& a, const RouteRule& b) {
+        return a.priority > b.priority;
+    });
+    rebuild();
 }
 
-bool OSCPatternMatcher::isMatch(const std::string& address, const RouteRule& rule) const {
-    switch (rule.matchType) {
-        case MatchType::EXACT: return matchExact(rule.pattern, address);
-        case MatchType::PREFIX: return matchPrefix(rule.pattern, address);
-        case MatchType::SUFFIX: return matchSuffix(rule.pattern, address);
-        case MatchType::CONTAINS: return matchContains(rule.pattern, address);
-        case MatchType::OSC_PATTERN: return matchOSCPattern(rule.pattern, address);
-        default: return false;
+void OSCPatternMatcher::rebuild() {
+    compiledRules.clear();
+    automaton.clear();
+    regexRuleIds.clear();
+    for (const auto& rule : routes) {
+        compileRule(rule);
     }
 }
 
-bool OSCPatternMatcher::matchOSCPattern(const std::string& pattern, const std::string& address) const {
-    // Simplified OSC pattern matching
-    if (pattern.find('*') == std::string::npos && pattern.find('?') == std::string::npos) {
-        return pattern == address;
+void OSCPatternMatcher::compileRule(const RouteRule& rule) {
+    uint32_t id = static_cast<uint32_t>(compiledRules.size());
+    compiledRules.push_back({rule, nullptr, nullptr});
+    if (!rule.enabled) return;
+    
+    if (rule.matchType == MatchType::REGEX) {
+        try {
+            auto validator = std::make_shared<OSCAddressValidator>();
+            validator->compile(rule.pattern, {});
+            compiledRules[id].validator = validator;
+            compiledRules[id].regex = std::make_shared<std::regex>(rule.pattern);
+        } catch (const std::regex_error& e) {
+            ErrorHandler::getInstance().logError("Invalid route regex: " + rule.pattern, e.what());
+            return;
+        }
+        regexRuleIds.insert(std::upper_bound(regexRuleIds.begin(), regexRuleIds.end(), id,
+                                             [this](uint32_t a, uint32_t b) { return ranksBefore(a, b); }),
+                            id);
+    } else if (!automaton.add(id, rule.pattern, getSyntax(rule.matchType), rule.priority)) {
+        ErrorHandler::getInstance().logError("Malformed route pattern: " + rule.pattern, "unterminated [ or {");
     }
-    // For demo - basic wildcard support
-    return matchWildcard(pattern, address);
 }
 
-bool OSCPatternMatcher::matchExact(const std::string& pattern, const std::string& address) const {
-    return pattern == address;
+bool OSCPatternMatcher::ranksBefore(uint32_t a, uint32_t b) const {
+    int priorityA = compiledRules[a].rule.priority;
+    int priorityB = compiledRules[b].rule.priority;
+    return priorityA != priorityB ? priorityA > priorityB : a < b;
+}
+
+OSCRouteAutomaton::Syntax OSCPatternMatcher::getSyntax(MatchType type) {
+    switch (type) {
+        case MatchType::EXACT: return OSCRouteAutomaton::Syntax::Literal;
+        case MatchType::PREFIX: return OSCRouteAutomaton::Syntax::Prefix;
+        case MatchType::SUFFIX: return OSCRouteAutomaton::Syntax::Suffix;
+        case MatchType::CONTAINS: return OSCRouteAutomaton::Syntax::Contains;
+        case MatchType::WILDCARD: return OSCRouteAutomaton::Syntax::Wildcard;
+        default: return OSCRouteAutomaton::Syntax::OSCPattern;
+    }
 }
 
-bool OSCPatternMatcher::matchPrefix(const std::string& pattern, const std::string& address) const {
-    return address.find(pattern) == 0;
+OSCPatternMatcher::MatchResult OSCPatternMatcher::makeResult(uint32_t ruleId, const std::string& address) const {
+    const auto& compiled = compiledRules[ruleId];
+    MatchResult result;
+    result.matched = true;
+    result.targetAddress = compiled.rule.targetAddress;
+    result.targetHost = compiled.rule.targetHost;
+    result.targetPort = compiled.rule.targetPort;
+    
+    // Captures come from re-matching the one winning rule, never during the shared pass
+    if (compiled.regex) {
+        std::smatch groups;
+        if (std::regex_match(address, groups, *compiled.regex)) {
+            for (size_t i = 1; i < groups.size(); i++) {
+                result.capturedGroups[std::to_string(i)] = groups[i].str();
+            }
+        }
+    } else {
+        std::vector<std::string> captures;
+        OSCRouteAutomaton::matchSingle(compiled.rule.pattern, getSyntax(compiled.rule.matchType), address, &captures);
+        for (size_t i = 0; i < captures.size(); i++) {
+            result.capturedGroups[std::to_string(i + 1)] = captures[i];
+        }
+    }
+    return result;
 }
 
-bool OSCPatternMatcher::matchSuffix(const std::string& pattern, const std::string& address) const {
-    if (pattern.length() > address.length()) return false;
-    return address.substr(address.length() - pattern.length()) == pattern;
+std::vector<OSCPatternMatcher::MatchResult> OSCPatternMatcher::matchPattern(const std::string& address) const {
+    std::vector<uint32_t> ids;
+    automaton.findAll(address.data(), address.size(), ids);
+    for (uint32_t id : regexRuleIds) {
+        if (compiledRules[id].validator->matchesPattern(address)) {
+            ids.push_back(id);
+        }
+    }
+    std::sort(ids.begin(), ids.end(), [this](uint32_t a, uint32_t b) { return ranksBefore(a, b); });
+    
+    std::vector<MatchResult> results;
+    results.reserve(ids.size());
+    for (uint32_t id : ids) {
+        results.push_back(makeResult(id, address));
+    }
+    return results;
 }
 
-bool OSCPatternMatcher::matchContains(const std::string& pattern, const std::string& address) const {
-    return address.find(pattern) != std::string::npos;
+OSCPatternMatcher::MatchResult OSCPatternMatcher::findBestMatch(const std::string& address) const {
+    int32_t best = automaton.findBest(address.data(), address.size());
+    
+    // Regex rules are best first, so stop at the first one that cannot outrank the automaton
+    for (uint32_t id : regexRuleIds) {
+        if (best >= 0 && !ranksBefore(id, static_cast<uint32_t>(best))) break;
+        if (compiledRules[id].validator->matchesPattern(address)) {
+            best = static_cast<int32_t>(id);
+            break;
+        }
+    }
+    return best >= 0 ? makeResult(static_cast<uint32_t>(best), address) : MatchResult{};
 }
 
-bool OSCPatternMatcher::matchWildcard(const std::string& pattern, const std::string& address) const {
-    // Simple wildcard matching (* and ?)
-    size_t pPos = 0, aPos = 0;
-    while (pPos < pattern.length() && aPos < address.length()) {
-        if (pattern[pPos] == '*') {
-            pPos++;
-            if (pPos >= pattern.length()) return true;
-            while (aPos < address.length() && address[aPos] != pattern[pPos]) aPos++;
-        } else if (pattern[pPos] == '?') {
-            pPos++; aPos++;
-        } else {
-            if (pattern[pPos] != address[aPos]) return false;
-            pPos++; aPos++;
+bool OSCPatternMatcher::isMatch(const std::string& address, const RouteRule& rule) const {
+    if (rule.matchType == MatchType::REGEX) {
+        try {
+            return std::regex_match(address, std::regex(rule.pattern));
+        } catch (const std::regex_error& e) {
+            ErrorHandler::getInstance().logError("Invalid route regex: " + rule.pattern, e.what());
+            return false;
         }
     }
-    while (pPos < pattern.length() && pattern[pPos] == '*') pPos++;
-    return pPos >= pattern.length() && aPos >= address.length();
+    return OSCRouteAutomaton::matchSingle(rule.pattern, getSyntax(rule.matchType), address);
+}
+
+bool OSCPatternMatcher::matchOSCPattern(const std::string& pattern, const std::string& address) const {
+    return OSCRouteAutomaton::matchSingle(pattern, OSCRouteAutomaton::Syntax::OSCPattern, address);
 }
 
 bool OSCPatternMatcher::validateRule(const RouteRule& rule) const {
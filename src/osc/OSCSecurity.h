@@ -8,8 +8,14 @@
 #include <mutex>
 #include <map>
 #include <random>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <nlohmann/json.hpp>
-// Simplified crypto implementation without OpenSSL dependencies
+#include "OSCAddressValidator.h"
+#include "OSCCrypto.h"
+#include "OSCRateLimiter.h"
+#include "OSCRouteAutomaton.h"
 
 class OSCSecurity {
 public:
@@ -20,9 +26,19 @@ public:
         bool enableAddressWhitelist = false;
         bool enableHostWhitelist = false;
         
-        // Rate limiting
+        // Rate limiting: a token bucket per source, refilled continuously
         size_t maxMessagesPerSecond = 1000;
+        size_t rateLimitBurst = 100;
         size_t maxBundleSize = 100;
+        std::chrono::seconds rateLimitIdleTimeout{10};  // Idle sources may be evicted after this
+        
+        // Shared buckets for every address under a prefix, across all sources
+        struct AddressRateLimit {
+            std::string prefix;
+            double messagesPerSecond = 100.0;
+            double burst = 10.0;
+        };
+        std::vector<AddressRateLimit> addressRateLimits;
         
         // Value limits
         float maxFloatValue = 1000000.0f;
@@ -34,29 +50,32 @@ public:
         
         // Whitelists
         std::vector<std::string> allowedAddresses;
-        std::regex allowedAddressPattern{std::regex(R"(^/[a-zA-Z0-9/_-]*$)")};
+        std::string allowedAddressPattern = R"(^/[a-zA-Z0-9/_-]*$)";  // ECMAScript, compiled to a DFA
         std::vector<std::string> allowedHosts;
     };
 
 private:
     SecurityConfig config;
+    OSCAddressValidator addressValidator;   // Compiled from config whenever it changes
     
     // Rate limiting state
-    mutable std::chrono::steady_clock::time_point lastReset;
-    mutable size_t messageCount = 0;
-    mutable std::mutex rateLimitMutex;
+    mutable OSCRateLimiter sourceLimiter;
+    mutable OSCRateLimiter addressLimiter;
 
 public:
     OSCSecurity() : config{} {
-        lastReset = std::chrono::steady_clock::now();
+        applyConfig();
     }
     
     OSCSecurity(const SecurityConfig& cfg) : config(cfg) {
-        lastReset = std::chrono::steady_clock::now();
+        applyConfig();
     }
     
     // Configuration
-    void setConfig(const SecurityConfig& cfg) { config = cfg; }
+    void setConfig(const SecurityConfig& cfg) {
+        config = cfg;
+        applyConfig();
+    }
     const SecurityConfig& getConfig() const { return config; }
     
     // Address validation
@@ -76,9 +95,13 @@ public:
     // Host validation
     bool isHostAllowed(const std::string& host) const;
     
-    // Rate limiting
+    // Rate limiting. The source is typically "host:port"; without one,
+    // messages share the local bucket.
     bool checkRateLimit() const;
+    bool checkRateLimit(const std::string& source, const std::string& address) const;
     bool checkBundleSize(size_t bundleSize) const;
+    std::vector<OSCRateLimiter::KeyStats> getSourceRateStats() const { return sourceLimiter.getStats(); }
+    std::vector<OSCRateLimiter::KeyStats> getAddressRateStats() const { return addressLimiter.getStats(); }
     
     // Comprehensive validation
     bool validateMessage(const std::string& address, float value) const;
@@ -90,11 +113,23 @@ public:
     std::string generateSecurityReport() const;
     
 private:
-    bool matchesPattern(const std::string& address, const std::regex& pattern) const;
+    void applyConfig();
     void resetRateLimit() const;
 };
 
 // Enhanced OSC Security with Encryption and Authentication
+//
+// A secured packet wraps a whole OSC packet, usually a bundle, so the
+// AEAD or HMAC runs once per bundle rather than once per message:
+//
+//   "#cvs" | version | encryption | auth | 0 | session salt (16) | sequence (8) | timestamp (8)
+//   | payload (ciphertext, or plaintext under HMAC) | tag (16) or HMAC-SHA256 (32)
+//
+// The header is authenticated as associated data. Each sender session draws
+// a random 16-byte salt, and its AEAD key is HKDF-SHA256(secret, salt), so
+// no two sessions share a key; the nonce is the salt's last 4 bytes and the
+// sequence, unique under that key. The sequence also feeds a per-session
+// replay window. The HMAC key is derived once from the shared secret.
 class OSCSecurityAdvanced {
 public:
     enum class EncryptionMode {
@@ -106,7 +141,7 @@ public:
     enum class AuthMode {
         NONE,
         HMAC_SHA256,
-        RSA_SIGNATURE
+        RSA_SIGNATURE   // Not supported; signing fails
     };
     
     struct SecurityProfile {
@@ -118,7 +153,6 @@ public:
         bool requireTimestamp = true;
         uint32_t timestampTolerance = 30; // seconds
         bool enableNonceValidation = true;
-        size_t nonceWindowSize = 1000;
     };
     
     struct EncryptedMessage {
@@ -130,18 +164,45 @@ public:
         std::string sender;
     };
     
+    static constexpr size_t kSaltSize = 16;
+    static constexpr size_t kHeaderSize = 40;
+    static constexpr size_t kMaxSessions = 16;
+    
 private:
+    using Salt = std::array<uint8_t, kSaltSize>;
+    
     SecurityProfile profile;
-    std::set<std::vector<uint8_t>> usedNonces;
-    std::mutex nonceMutex;
-    mutable std::mt19937 rng;
+    Salt sessionSalt{};                         // Fresh on every (re)key: the AEAD key is never reused
+    mutable std::atomic<uint64_t> sequence{0};
+    bool keysReady = false;
+    
+    // Sealing keeps its own keyed contexts
+    mutable std::mutex sealMutex;
+    mutable OSCAeadCipher sealCipher;
+    mutable OSCHmacSha256 sealMac;
+    
+    // Keys and replay windows for the most recently seen sender sessions.
+    // A new salt is keyed into pendingSession and only takes a slot once a
+    // packet under it authenticates.
+    struct Session {
+        Salt salt{};
+        bool used = false;
+        uint64_t lastUsed = 0;
+        OSCAeadCipher cipher;
+        OSCReplayWindow window;
+    };
+    mutable std::mutex openMutex;
+    mutable OSCHmacSha256 openMac;
+    mutable std::array<std::unique_ptr<Session>, kMaxSessions> sessions;
+    mutable std::unique_ptr<Session> pendingSession;
+    mutable uint64_t sessionClock = 0;
     
 public:
     OSCSecurityAdvanced();
     explicit OSCSecurityAdvanced(const SecurityProfile& profile);
     
     // Configuration
-    void setSecurityProfile(const SecurityProfile& profile) { this->profile = profile; }
+    void setSecurityProfile(const SecurityProfile& profile);
     const SecurityProfile& getSecurityProfile() const { return profile; }
     
     // Key management
@@ -150,6 +211,11 @@ public:
     bool loadKeysFromFile(const std::string& keyFile);
     bool saveKeysToFile(const std::string& keyFile) const;
     
+    // Bundle sealing without allocation. out needs getOverhead() bytes beyond the payload.
+    size_t getOverhead() const;
+    bool sealPacket(const uint8_t* payload, size_t length, uint8_t* out, size_t capacity, size_t& packetLength) const;
+    bool openPacket(const uint8_t* packet, size_t length, uint8_t* out, size_t capacity, size_t& payloadLength) const;
+    
     // Encryption/Decryption
     bool encryptMessage(const std::vector<uint8_t>& plaintext, EncryptedMessage& encrypted) const;
     bool decryptMessage(const EncryptedMessage& encrypted, std::vector<uint8_t>& plaintext) const;
@@ -164,10 +230,9 @@ public:
     bool verifyOSCMessage(const std::vector<uint8_t>& secureData, 
                          std::string& address, std::vector<float>& args) const;
     
-    // Nonce management
+    // Nonce management: a nonce is session salt (16) | sequence (8)
     std::vector<uint8_t> generateNonce() const;
     bool validateNonce(const std::vector<uint8_t>& nonce);
-    void cleanupOldNonces();
     
     // Timestamp validation
     uint64_t getCurrentTimestamp() const;
@@ -177,20 +242,12 @@ public:
     std::string generateSecurityAudit() const;
     
 private:
-    bool initializeCrypto();
-    bool encryptAES256GCM(const std::vector<uint8_t>& plaintext, 
-                         const std::vector<uint8_t>& key,
-                         const std::vector<uint8_t>& nonce,
-                         std::vector<uint8_t>& ciphertext,
-                         std::vector<uint8_t>& tag) const;
-    bool decryptAES256GCM(const std::vector<uint8_t>& ciphertext,
-                         const std::vector<uint8_t>& key,
-                         const std::vector<uint8_t>& nonce,
-                         const std::vector<uint8_t>& tag,
-                         std::vector<uint8_t>& plaintext) const;
-    
-    std::vector<uint8_t> deriveKey(const std::string& secret, const std::vector<uint8_t>& salt) const;
-    std::vector<uint8_t> hmacSHA256(const std::vector<uint8_t>& data, const std::vector<uint8_t>& key) const;
+    bool deriveKeys();
+    // openMutex held. The session for salt, keyed; nullptr if keying fails.
+    Session* findSession(const uint8_t* salt) const;
+    // openMutex held. Advances the session's replay window, giving a pending session a slot.
+    bool acceptSequence(Session* session, uint64_t sequenceNumber) const;
+    void writeHeader(uint8_t* header, uint64_t sequenceNumber, uint64_t timestamp) const;
 };
 
 // Pattern Matching Engine for OSC routing
@@ -228,7 +285,18 @@ public:
     
 private:
     std::vector<RouteRule> routes;
-    std::map<std::string, std::regex> compiledRegexes;
+    
+    // Compiled form: every non-regex rule lives in one automaton, indexed by
+    // its position in compiledRules; regex rules are DFAs checked only when
+    // they could outrank the automaton's match
+    struct CompiledRule {
+        RouteRule rule;
+        std::shared_ptr<OSCAddressValidator> validator;   // REGEX only
+        std::shared_ptr<std::regex> regex;                // REGEX captures
+    };
+    std::vector<CompiledRule> compiledRules;
+    OSCRouteAutomaton automaton;
+    std::vector<uint32_t> regexRuleIds;     // Best first
     
 public:
     OSCPatternMatcher() = default;
@@ -239,12 +307,13 @@ public:
     void updateRoute(const std::string& pattern, const RouteRule& rule);
     const std::vector<RouteRule>& getRoutes() const { return routes; }
     
-    // Pattern matching
+    // Pattern matching: one pass over the address for all non-regex rules.
+    // Captured groups are numbered "1", "2"... one per wildcard (or regex group).
     std::vector<MatchResult> matchPattern(const std::string& address) const;
     MatchResult findBestMatch(const std::string& address) const;
     bool isMatch(const std::string& address, const RouteRule& rule) const;
     
-    // OSC standard pattern matching
+    // OSC standard pattern matching: * ? [a-z] [!a] {a,b}, none crossing '/'
     bool matchOSCPattern(const std::string& pattern, const std::string& address) const;
     
     // Transformation
@@ -266,18 +335,9 @@ public:
     void importRoutes(const nlohmann::json& config);
     
 private:
-    bool matchExact(const std::string& pattern, const std::string& address) const;
-    bool matchPrefix(const std::string& pattern, const std::string& address) const;
-    bool matchSuffix(const std::string& pattern, const std::string& address) const;
-    bool matchContains(const std::string& pattern, const std::string& address) const;
-    bool matchRegex(const std::string& pattern, const std::string& address) const;
-    bool matchWildcard(const std::string& pattern, const std::string& address) const;
-    
-    std::regex compileRegex(const std::string& pattern) const;
-    std::string wildcardToRegex(const std::string& pattern) const;
-    
-    // OSC pattern matching helpers
-    bool matchOSCChar(char pattern, char address) const;
-    bool matchOSCBrackets(const std::string& pattern, size_t& pos, char address) const;
-    bool matchOSCBraces(const std::string& pattern, size_t& pos, const std::string& address, size_t& addrPos) const;
+    void rebuild();
+    void compileRule(const RouteRule& rule);
+    bool ranksBefore(uint32_t a, uint32_t b) const;
+    MatchResult makeResult(uint32_t ruleId, const std::string& address) const;
+    static OSCRouteAutomaton::Syntax getSyntax(MatchType type);
 };
@@ -0,0 +1,123 @@
+#include "OSCSendPacer.h"
+#include <algorithm>
+#include <cerrno>
+
+namespace {
+
+constexpr double kLossWeight = 1.0 / 64.0;   // EWMA weight of one send outcome
+constexpr double kRttWeight = 1.0 / 8.0;     // As TCP's SRTT
+
+} // namespace
+
+OSCSendPacer::OSCSendPacer() : OSCSendPacer(Config()) {
+}
+
+OSCSendPacer::OSCSendPacer(const Config& config)
+    : config_(config), rate_(config.maxRate), tokens_(0.0) {
+    tokens_ = burst();
+}
+
+void OSCSendPacer::setConfig(const Config& config) {
+    config_ = config;
+    rate_ = std::clamp(rate_, config_.minRate, config_.maxRate);
+    tokens_ = std::min(tokens_, burst());
+}
+
+bool OSCSendPacer::isCongestionError(int error) {
+    return error == ENOBUFS || error == EAGAIN || error == EWOULDBLOCK;
+}
+
+double OSCSendPacer::burst() const {
+    return std::max(1.0, config_.maxRate * config_.burstMs / 1000.0);
+}
+
+void OSCSendPacer::refill(int64_t nowNs) {
+    if (lastRefillNs_ == 0) {
+        lastRefillNs_ = lastIncreaseNs_ = nowNs;
+        return;
+    }
+    if (nowNs > lastRefillNs_) {
+        tokens_ = std::min(burst(), tokens_ + (nowNs - lastRefillNs_) * 1e-9 * rate_);
+        lastRefillNs_ = nowNs;
+    }
+}
+
+bool OSCSendPacer::tryAcquire(int64_t nowNs) {
+    refill(nowNs);
+    if (tokens_ < 1.0) {
+        return false;
+    }
+    tokens_ -= 1.0;
+    return true;
+}
+
+int64_t OSCSendPacer::nanosUntilNext(int64_t nowNs) {
+    refill(nowNs);
+    if (tokens_ >= 1.0) {
+        return 0;
+    }
+    return static_cast<int64_t>((1.0 - tokens_) / rate_ * 1e9) + 1;
+}
+
+void OSCSendPacer::recordOutcome(bool lost) {
+    localLoss_ += kLossWeight * ((lost ? 1.0 : 0.0) - localLoss_);
+}
+
+void OSCSendPacer::onSent(int64_t nowNs, size_t queuedBytes) {
+    recordOutcome(false);
+    bool growing = queuedBytes > config_.queueHighWater && queuedBytes > lastQueuedBytes_;
+    lastQueuedBytes_ = queuedBytes;
+    if (growing) {
+        congestion(nowNs);
+    } else {
+        maybeIncrease(nowNs);
+    }
+}
+
+void OSCSendPacer::onSendFailed(int64_t nowNs, int error) {
+    recordOutcome(true);
+    if (isCongestionError(error)) {
+        congestion(nowNs);
+    }
+}
+
+void OSCSendPacer::onShed(int64_t nowNs) {
+    recordOutcome(true);
+    congestion(nowNs);
+}
+
+void OSCSendPacer::onFeedback(int64_t nowNs, double lossFraction, double roundTripMs) {
+    reportedLoss_ = std::clamp(lossFraction, 0.0, 1.0);
+    onRoundTrip(roundTripMs);
+    if (reportedLoss_ > config_.lossThreshold) {
+        congestion(nowNs);
+    }
+}
+
+void OSCSendPacer::onRoundTrip(double roundTripMs) {
+    if (roundTripMs <= 0.0) {
+        return;
+    }
+    roundTripMs_ = roundTripMs_ < 0.0 ? roundTripMs : roundTripMs_ + kRttWeight * (roundTripMs - roundTripMs_);
+}
+
+void OSCSendPacer::congestion(int64_t nowNs) {
+    // One cut per round trip: the signals that follow are mostly the same episode
+    int64_t holdoffNs = std::max(config_.minHoldoffNs, static_cast<int64_t>(roundTripMs_ * 1e6));
+    if (lastDecreaseNs_ != 0 && nowNs - lastDecreaseNs_ < holdoffNs) {
+        return;
+    }
+    refill(nowNs);
+    rate_ = std::max(config_.minRate, rate_ * config_.decrease);
+    lastDecreaseNs_ = lastIncreaseNs_ = nowNs;
+    congestionEvents_++;
+}
+
+void OSCSendPacer::maybeIncrease(int64_t nowNs) {
+    if (rate_ >= config_.maxRate || nowNs - lastIncreaseNs_ < config_.increaseIntervalNs) {
+        return;
+    }
+    refill(nowNs);
+    rate_ = std::min(config_.maxRate, rate_ + config_.increaseStep * config_.maxRate);
+    lastIncreaseNs_ = nowNs;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Leaky-bucket pacing with AIMD rate control for one destination
+ *
+ * The bucket releases packets at rate() per second, with a burst of a few
+ * milliseconds' worth, so a tick's bundles leave spread over the tick
+ * instead of in one burst that a Wi-Fi link drops. Congestion signals -
+ * a send failing with ENOBUFS/EAGAIN, the socket send queue growing past
+ * the high-water mark, or the receiver reporting loss - cut the rate
+ * multiplicatively (at most once per round trip); every quiet interval
+ * adds a fixed step back until the configured maximum is reached again.
+ *
+ * Pure bookkeeping: times are passed in, nothing blocks, and the caller
+ * serialises access (OSCSenderEnhanced holds its mutex; OSCNetworkReactor
+ * uses it on the loop thread only).
+ */
+class OSCSendPacer {
+public:
+    struct Config {
+        double maxRate = 2000.0;            // Packets per second when the path is clean
+        double minRate = 50.0;              // Floor the decrease stops at
+        double burstMs = 2.0;               // Bucket depth, in milliseconds of maxRate
+        double decrease = 0.5;              // Multiplicative decrease on congestion
+        double increaseStep = 0.05;         // Additive increase per interval, as a fraction of maxRate
+        int64_t increaseIntervalNs = 100000000;
+        int64_t minHoldoffNs = 50000000;    // Shortest gap between two decreases (or the RTT, if longer)
+        size_t queueHighWater = 64 * 1024;  // Send-queue bytes that count as congestion once growing
+        double lossThreshold = 0.02;        // Reported loss above this counts as congestion
+    };
+
+    OSCSendPacer();
+    explicit OSCSendPacer(const Config& config);
+
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return config_; }
+
+    // Leaky bucket: take one packet's worth if available, else how long until one is
+    bool tryAcquire(int64_t nowNs);
+    int64_t nanosUntilNext(int64_t nowNs);
+
+    // Feedback from each send and from the receiver
+    void onSent(int64_t nowNs, size_t queuedBytes);
+    void onSendFailed(int64_t nowNs, int error);
+    void onShed(int64_t nowNs);
+    void onFeedback(int64_t nowNs, double lossFraction, double roundTripMs);
+    void onRoundTrip(double roundTripMs);
+
+    double rate() const { return rate_; }
+    double lossRate() const { return localLoss_ > reportedLoss_ ? localLoss_ : reportedLoss_; }
+    double roundTripMs() const { return roundTripMs_; }
+    uint64_t congestionEvents() const { return congestionEvents_; }
+
+    // ENOBUFS, EAGAIN/EWOULDBLOCK: the path is full, not broken
+    static bool isCongestionError(int error);
+
+private:
+    Config config_;
+    double rate_;
+    double tokens_;
+    int64_t lastRefillNs_ = 0;
+    int64_t lastDecreaseNs_ = 0;
+    int64_t lastIncreaseNs_ = 0;
+    size_t lastQueuedBytes_ = 0;
+    double localLoss_ = 0.0;        // EWMA of failed or shed sends
+    double reportedLoss_ = 0.0;
+    double roundTripMs_ = -1.0;
+    uint64_t congestionEvents_ = 0;
+
+    void refill(int64_t nowNs);
+    void recordOutcome(bool lost);
+    void congestion(int64_t nowNs);
+    void maybeIncrease(int64_t nowNs);
+    double burst() const;
+};
@@ -1,12 +1,18 @@
 #include "OSCSender.h"
 #include "ErrorHandler.h"
+#include "TraceLog.h"
+#include "OSCPacket.h"
+#include <algorithm>
 #include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <iomanip>
 #include <regex>
 
 OSCSender::OSCSender(const std::string& host, const std::string& port) 
-    : host(host), port(port) {
+    : endpoint(0), host(host), port(port) {
     
     // Create liblo address
     target = lo_address_new(host.c_str(), port.c_str());
@@ -21,39 +27,59 @@ OSCSender::OSCSender(const std::string& host, const std::string& port)
     // Set error handler - commented out as function may not be available
     // lo_address_set_error_handler(target, staticErrorHandler);
     
+    endpoint = OSCNetworkReactor::shared().openUdpTarget(host, port);
+    installSendObserver();
+    
     ErrorHandler::getInstance().logInfo("OSC sender initialized", "Target: " + host + ":" + port);
     std::cout << "OSC sender initialized - target: " << host << ":" << port << std::endl;
 }
 
 OSCSender::~OSCSender() {
+    if (endpoint) {
+        OSCNetworkReactor::shared().close(endpoint);
+    }
     if (target) {
         lo_address_free(target);
     }
 }
 
-bool OSCSender::sendFloat(const std::string& address, float value) {
+bool OSCSender::sendFloat(const std::string& address, float value, uint64_t tag) {
     if (!target) {
         NETWORK_ERROR("OSC target not available", "Cannot send float message", true, "Reinitialize OSC sender");
         return false;
     }
     
-    // Debug logging
-    static int sendCount = 0;
-    sendCount++;
-    if (sendCount % 100 == 0) {
-        std::cout << "[OSCSender::sendFloat] Sending #" << sendCount 
-                  << " to " << address << " = " << value 
-                  << " (target: " << host << ":" << port << ")" << std::endl;
+    TRACE_DEBUG(TraceCategory::Osc, "sendFloat %s = %f", address, value);
+    
+    if (streamMode) {
+        return sendStream([&](std::vector<uint8_t>& bundle) {
+            OSCPacket::appendBundleFloatMessage(bundle, address, &value, 1);
+        }, tag);
+    }
+    
+    // Encoded on the stack and queued; the reactor sends it with the rest of the batch
+    // and reports a failed sendto to the observer
+    uint8_t packet[512];
+    size_t size = OSCPacket::writeFloatMessage(packet, sizeof(packet), address, &value, 1);
+    if (endpoint && size > 0) {
+        if (!OSCNetworkReactor::shared().submit(endpoint, packet, size, tag)) {
+            NETWORK_ERROR("OSC message transmission failed", "Network reactor send queue full", false,
+                          "Reduce the send rate or check the OSC target");
+            return false;
+        }
+        return true;
     }
     
     int result = lo_send(target, address.c_str(), "f", value);
     if (result < 0) {
         // Only log error if it's not a connection refused error (normal when no receiver)
         if (result != -9999) {  // ECONNREFUSED equivalent
-            std::string errorMsg = "OSC message transmission failed";
-            std::string details = "Address: " + address + ", Value: " + std::to_string(value) + 
-                                 ", Result: " + std::to_string(result);
-            NETWORK_ERROR(errorMsg, details, false, "Check network connectivity and OSC target availability");
+            // Formatted on the stack: the report is queued, never written from the send path
+            char details[192];
+            std::snprintf(details, sizeof(details), "Address: %s, Value: %f, Result: %d",
+                          address.c_str(), value, result);
+            NETWORK_ERROR("OSC message transmission failed", details, false,
+                          "Check network connectivity and OSC target availability");
         }
         return false;
     }
@@ -64,6 +90,12 @@ bool OSCSender::sendFloat(const std::string& address, float value) {
 bool OSCSender::sendInt(const std::string& address, int value) {
     if (!target) return false;
     
+    if (streamMode) {
+        lo_message message = lo_message_new();
+        lo_message_add_int32(message, value);
+        return sendStreamMessage(address, message);
+    }
+    
     int result = lo_send(target, address.c_str(), "i", value);
     return result >= 0;
 }
@@ -71,6 +103,12 @@ bool OSCSender::sendInt(const std::string& address, int value) {
 bool OSCSender::sendString(const std::string& address, const std::string& value) {
     if (!target) return false;
     
+    if (streamMode) {
+        lo_message message = lo_message_new();
+        lo_message_add_string(message, value.c_str());
+        return sendStreamMessage(address, message);
+    }
+    
     int result = lo_send(target, address.c_str(), "s", value.c_str());
     return result >= 0;
 }
@@ -78,6 +116,20 @@ bool OSCSender::sendString(const std::string& address, const std::string& value)
 bool OSCSender::sendFloatArray(const std::string& address, const std::vector<float>& values) {
     if (!target || values.empty()) return false;
     
+    if (streamMode) {
+        return sendStream([&](std::vector<uint8_t>& bundle) {
+            OSCPacket::appendBundleFloatMessage(bundle, address, values.data(), values.size());
+        });
+    }
+    
+    if (endpoint) {
+        std::vector<uint8_t> packet;
+        OSCPacket::appendFloatMessage(packet, address, values.data(), values.size());
+        if (packet.size() <= OSCNetworkReactor::kMaxDatagramSize) {
+            return OSCNetworkReactor::shared().submit(endpoint, packet.data(), packet.size());
+        }
+    }
+    
     // Create message
     lo_message message = lo_message_new();
     
@@ -95,10 +147,18 @@ void OSCSender::setTarget(const std::string& newHost, const std::string& newPort
     if (target) {
         lo_address_free(target);
     }
+    if (endpoint) {
+        OSCNetworkReactor::shared().close(endpoint);
+    }
     
     host = newHost;
     port = newPort;
     target = lo_address_new(host.c_str(), port.c_str());
+    endpoint = OSCNetworkReactor::shared().openUdpTarget(host, port);
+    installSendObserver();
+    if (pacing && endpoint) {
+        OSCNetworkReactor::shared().setPacing(endpoint, true, pacingConfig);
+    }
     
     if (target) {
         // lo_address_set_error_handler(target, staticErrorHandler);
@@ -106,6 +166,83 @@ void OSCSender::setTarget(const std::string& newHost, const std::string& newPort
     }
 }
 
+void OSCSender::setStreamMode(bool enable, const OSCStream::Config& config) {
+    std::lock_guard<std::mutex> lock(streamMutex);
+    streamMode = enable;
+    streamEncoder.setConfig(config);
+}
+
+void OSCSender::setSendObserver(OSCNetworkReactor::SendObserver observer) {
+    sendObserver = std::move(observer);
+    installSendObserver();
+}
+
+void OSCSender::setPacing(bool enable, double maxPacketsPerSecond) {
+    pacing = enable;
+    pacingConfig.maxRate = maxPacketsPerSecond;
+    pacingConfig.minRate = std::min(pacingConfig.minRate, maxPacketsPerSecond);
+    if (endpoint) {
+        OSCNetworkReactor::shared().setPacing(endpoint, enable, pacingConfig);
+    }
+}
+
+void OSCSender::installSendObserver() {
+    if (!endpoint) {
+        return;
+    }
+    std::string destination = host + ":" + port;
+    OSCNetworkReactor::shared().setSendObserver(endpoint, [destination, observer = sendObserver](
+                                                              const OSCNetworkReactor::SendResult& result) {
+        if (result.error) {
+            NETWORK_ERROR("OSC message transmission failed", destination + ": " + std::strerror(result.error), false,
+                          "Check network connectivity and OSC target availability");
+        }
+        if (observer) {
+            observer(result);
+        }
+    });
+}
+
+bool OSCSender::sendStream(const std::function<void(std::vector<uint8_t>&)>& appendPayload, uint64_t tag) {
+    if (!endpoint) {
+        NETWORK_ERROR("OSC stream send failed", "No network reactor target for " + host + ":" + port, true,
+                      "Check the OSC target, or turn stream mode off");
+        return false;
+    }
+    
+    // Encoded once under the lock so sequence numbers leave in order
+    std::lock_guard<std::mutex> lock(streamMutex);
+    streamEncoder.begin(streamPacket, OSCPacket::timetagNow());
+    appendPayload(streamPacket);
+    // Leaves room for the parity packet, which is a little larger than the bundle
+    if (streamPacket.size() + 64 > OSCNetworkReactor::kMaxDatagramSize) {
+        NETWORK_ERROR("OSC stream send failed", "Bundle of " + std::to_string(streamPacket.size()) + " bytes", false,
+                      "Send fewer values per call");
+        return false;
+    }
+    // The tag goes with the data packet only, so each send is reported once
+    return streamEncoder.finish(streamPacket, [this, &tag](const uint8_t* data, size_t size) {
+        bool queued = OSCNetworkReactor::shared().submit(endpoint, data, size, tag);
+        tag = 0;
+        return queued;
+    });
+}
+
+bool OSCSender::sendStreamMessage(const std::string& address, lo_message message) {
+    bool sent = sendStream([&](std::vector<uint8_t>& bundle) { appendMessage(bundle, address, message); });
+    lo_message_free(message);
+    return sent;
+}
+
+void OSCSender::appendMessage(std::vector<uint8_t>& bundle, const std::string& address, lo_message message) {
+    size_t size = 0;
+    void* data = lo_message_serialise(message, address.c_str(), nullptr, &size);
+    if (data) {
+        OSCPacket::appendBundleElement(bundle, data, size);
+        free(data);
+    }
+}
+
 void OSCSender::errorHandler(int num, const char* msg, const char* path) {
     std::cerr << "OSC Error " << num << " in path " << (path ? path : "unknown") 
               << ": " << (msg ? msg : "unknown error") << std::endl;
@@ -116,6 +253,14 @@ bool OSCSender::sendFloatBatch(const std::vector<std::string>& addresses, const
         return false;
     }
     
+    if (streamMode) {
+        return sendStream([&](std::vector<uint8_t>& bundle) {
+            for (size_t i = 0; i < addresses.size(); ++i) {
+                OSCPacket::appendBundleFloatMessage(bundle, addresses[i], &values[i], 1);
+            }
+        });
+    }
+    
     // Try bundle approach first for better performance
     lo_bundle bundle = lo_bundle_new(LO_TT_IMMEDIATE);
     if (!bundle) {
@@ -166,6 +311,13 @@ bool OSCSender::sendBlob(const std::string& address, const void* data, size_t si
     if (!target) return false;
     
     lo_blob blob = lo_blob_new(static_cast<int32_t>(size), data);
+    if (streamMode) {
+        lo_message message = lo_message_new();
+        lo_message_add_blob(message, blob);
+        bool sent = sendStreamMessage(address, message);
+        lo_blob_free(blob);
+        return sent;
+    }
     int result = lo_send(target, address.c_str(), "b", blob);
     lo_blob_free(blob);
     
@@ -227,6 +379,10 @@ bool OSCSender::sendMixedArray(const std::string& address, const std::vector<flo
         lo_message_add_string(message, value.c_str());
     }
     
+    if (streamMode) {
+        return sendStreamMessage(address, message);
+    }
+    
     int result = lo_send_message(target, address.c_str(), message);
     lo_message_free(message);
     
@@ -236,6 +392,25 @@ bool OSCSender::sendMixedArray(const std::string& address, const std::vector<flo
 bool OSCSender::sendFormattedBatch(const std::vector<float>& values) {
     if (!target || values.empty()) return false;
     
+    if (streamMode) {
+        // One stream bundle, whether or not bundleMessages is set
+        return sendStream([&](std::vector<uint8_t>& bundle) {
+            for (size_t i = 0; i < values.size(); ++i) {
+                float scaledValue = values[i] * messageFormat.scale + messageFormat.offset;
+                lo_message message = lo_message_new();
+                if (messageFormat.dataType == "int") {
+                    lo_message_add_int32(message, static_cast<int>(scaledValue));
+                } else if (messageFormat.dataType == "string") {
+                    lo_message_add_string(message, formatValue(scaledValue, messageFormat.stringFormat).c_str());
+                } else {
+                    lo_message_add_float(message, scaledValue);
+                }
+                appendMessage(bundle, formatAddress(static_cast<int>(i)), message);
+                lo_message_free(message);
+            }
+        });
+    }
+    
     if (messageFormat.bundleMessages) {
         lo_bundle bundle = lo_bundle_new(LO_TT_IMMEDIATE);
         
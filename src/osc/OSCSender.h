@@ -5,8 +5,11 @@
 #include <vector>
 #include <iostream>
 #include <functional>
+#include <mutex>
 #include <lo/lo.h>
 #include "OSCFormatManager.h"
+#include "OSCNetworkReactor.h"
+#include "OSCStream.h"
 
 // OSC Message formatting options
 struct OSCMessageFormat {
@@ -22,16 +25,27 @@ struct OSCMessageFormat {
 class OSCSender {
 private:
     lo_address target;
+    OSCNetworkReactor::EndpointId endpoint;   // Float messages go through the shared reactor
+    OSCNetworkReactor::SendObserver sendObserver;
+    bool pacing = false;
+    OSCSendPacer::Config pacingConfig;
     std::string host;
     std::string port;
     OSCMessageFormat messageFormat;
     
+    // Stream mode: every send is one sequence-numbered bundle (see OSCStream)
+    bool streamMode = false;
+    OSCStream::Encoder streamEncoder;
+    std::vector<uint8_t> streamPacket;
+    std::mutex streamMutex;
+    
 public:
     OSCSender(const std::string& host, const std::string& port);
     ~OSCSender();
     
-    // Basic sending methods
-    bool sendFloat(const std::string& address, float value);
+    // Basic sending methods. A reactor send returns once the packet is queued;
+    // tag comes back with its outcome in the send observer.
+    bool sendFloat(const std::string& address, float value, uint64_t tag = 0);
     bool sendInt(const std::string& address, int value);
     bool sendString(const std::string& address, const std::string& value);
     bool sendBlob(const std::string& address, const void* data, size_t size);
@@ -53,12 +67,34 @@ public:
     void setTarget(const std::string& host, const std::string& port);
     void setMessageFormat(const OSCMessageFormat& format) { messageFormat = format; }
     const OSCMessageFormat& getMessageFormat() const { return messageFormat; }
+    // Reactor target for callers that encode once and fan out (0 if unavailable)
+    OSCNetworkReactor::EndpointId getEndpoint() const { return endpoint; }
+    // Runs on the reactor thread for each packet queued to this target, after
+    // failures have been logged; kept across setTarget()
+    void setSendObserver(OSCNetworkReactor::SendObserver observer);
+    // Off by default: the reactor spreads this target's packets at up to
+    // maxPacketsPerSecond, backing off on congestion; kept across setTarget()
+    void setPacing(bool enable, double maxPacketsPerSecond = 2000.0);
+    bool isPacingEnabled() const { return pacing; }
+    
+    // Stream mode (off by default): each send leaves as a bundle carrying a sequence
+    // number and timetag, so the receiver can detect loss, plus the configured
+    // redundancy. Sends in stream mode need the reactor endpoint.
+    void setStreamMode(bool enable, const OSCStream::Config& config = OSCStream::Config());
+    bool isStreamMode() const { return streamMode; }
     
     // Utility methods
     std::string formatAddress(int channel) const;
     std::string formatValue(float value, const std::string& format) const;
     
 private:
+    // Frames the payload appendPayload adds as the next stream bundle and submits it
+    bool sendStream(const std::function<void(std::vector<uint8_t>&)>& appendPayload, uint64_t tag = 0);
+    bool sendStreamMessage(const std::string& address, lo_message message);
+    static void appendMessage(std::vector<uint8_t>& bundle, const std::string& address, lo_message message);
+    
+    void installSendObserver();
+    
     void errorHandler(int num, const char* msg, const char* path);
     static void staticErrorHandler(int num, const char* msg, const char* path);
 };
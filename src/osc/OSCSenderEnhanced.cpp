@@ -1,18 +1,39 @@
 #include "OSCSenderEnhanced.h"
 #include "OSCTCPTransport.h"
+#include "../core/PerformanceMonitor.h"
+#include <algorithm>
 #include <chrono>
 #include <sstream>
 #include <lo/lo.h>
 
+namespace {
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 OSCSenderEnhanced::OSCSenderEnhanced() 
     : currentProtocol_(OSCTransport::Protocol::UDP)
     , stats_{}
+    , loop_(OSCEventLoop::shared())
 {
     stats_.lastActivity = std::chrono::steady_clock::now();
 }
 
 OSCSenderEnhanced::~OSCSenderEnhanced() {
     disconnect();
+    
+    // On the loop thread no drain can be running; cancel the next one
+    loop_.runSync([this] {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (drainTimer_) {
+            loop_.cancelTimer(drainTimer_);
+            drainTimer_ = 0;
+        }
+    });
 }
 
 bool OSCSenderEnhanced::connect(const std::string& host, const std::string& port, OSCTransport::Protocol protocol) {
@@ -26,6 +47,7 @@ bool OSCSenderEnhanced::connect(const std::string& host, const std::string& port
     host_ = host;
     port_ = port;
     currentProtocol_ = protocol;
+    resetPath();
     
     // Create new transport
     if (!createTransport(protocol)) {
@@ -37,7 +59,7 @@ bool OSCSenderEnhanced::connect(const std::string& host, const std::string& port
     if (!result) {
         updateStats(false);
         if (errorCallback_) {
-            errorCallback_("Failed to connect to " + host + ":" + port + " using " + getProtocolName());
+            errorCallback_("Failed to connect to " + host + ":" + port + " using " + protocolName(protocol));
         }
     }
     
@@ -46,6 +68,7 @@ bool OSCSenderEnhanced::connect(const std::string& host, const std::string& port
 
 bool OSCSenderEnhanced::disconnect() {
     std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
     
     if (transport_) {
         return transport_->disconnect();
@@ -66,6 +89,7 @@ void OSCSenderEnhanced::setProtocol(OSCTransport::Protocol protocol) {
     }
     
     currentProtocol_ = protocol;
+    resetPath();
     
     // If connected, reconnect with new protocol
     if (transport_ && transport_->isConnected()) {
@@ -82,134 +106,87 @@ OSCTransport::Protocol OSCSenderEnhanced::getProtocol() const {
 
 std::string OSCSenderEnhanced::getProtocolName() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    switch (currentProtocol_) {
+    return protocolName(currentProtocol_);
+}
+
+std::string OSCSenderEnhanced::protocolName(OSCTransport::Protocol protocol) {
+    switch (protocol) {
         case OSCTransport::Protocol::UDP:
             return "UDP";
         case OSCTransport::Protocol::TCP:
             return "TCP";
+        case OSCTransport::Protocol::MULTICAST:
+            return "Multicast";
+        case OSCTransport::Protocol::BROADCAST:
+            return "Broadcast";
+        case OSCTransport::Protocol::SHARED_MEMORY:
+            return "Shared memory";
         default:
             return "Unknown";
     }
 }
 
+bool OSCSenderEnhanced::isBackpressured() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return transport_ && transport_->isBackpressured();
+}
+
 bool OSCSenderEnhanced::sendFloat(const std::string& address, float value) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    if (!transport_ || !transport_->isConnected()) {
-        updateStats(false);
-        if (errorCallback_) {
-            errorCallback_("Not connected");
-        }
-        return false;
-    }
-    
-    // Create OSC message
-    lo_message msg = lo_message_new();
-    lo_message_add_float(msg, value);
-    
-    bool result = transport_->sendMessage(address, static_cast<void*>(msg));
-    
-    lo_message_free(msg);
-    
     // Estimate size: address + type tag + float (4 bytes)
     size_t estimatedSize = address.length() + 1 + 4;
-    updateStats(result, estimatedSize);
-    
-    if (!result && errorCallback_) {
-        errorCallback_("Failed to send float to " + address);
-    }
-    
-    return result;
+    return submit([address, value](OSCTransport& transport) {
+        lo_message msg = lo_message_new();
+        lo_message_add_float(msg, value);
+        bool result = transport.sendMessage(address, static_cast<void*>(msg));
+        lo_message_free(msg);
+        return result;
+    }, estimatedSize, "Failed to send float to ", address);
 }
 
 bool OSCSenderEnhanced::sendInt(const std::string& address, int value) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    if (!transport_ || !transport_->isConnected()) {
-        updateStats(false);
-        if (errorCallback_) {
-            errorCallback_("Not connected");
-        }
-        return false;
-    }
-    
-    lo_message msg = lo_message_new();
-    lo_message_add_int32(msg, value);
-    
-    bool result = transport_->sendMessage(address, static_cast<void*>(msg));
-    
-    lo_message_free(msg);
-    
     // Estimate size: address + type tag + int32 (4 bytes)
     size_t estimatedSize = address.length() + 1 + 4;
-    updateStats(result, estimatedSize);
-    
-    if (!result && errorCallback_) {
-        errorCallback_("Failed to send int to " + address);
-    }
-    
-    return result;
+    return submit([address, value](OSCTransport& transport) {
+        lo_message msg = lo_message_new();
+        lo_message_add_int32(msg, value);
+        bool result = transport.sendMessage(address, static_cast<void*>(msg));
+        lo_message_free(msg);
+        return result;
+    }, estimatedSize, "Failed to send int to ", address);
 }
 
 bool OSCSenderEnhanced::sendString(const std::string& address, const std::string& value) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    if (!transport_ || !transport_->isConnected()) {
-        updateStats(false);
-        if (errorCallback_) {
-            errorCallback_("Not connected");
-        }
-        return false;
-    }
-    
-    lo_message msg = lo_message_new();
-    lo_message_add_string(msg, value.c_str());
-    
-    bool result = transport_->sendMessage(address, static_cast<void*>(msg));
-    
-    lo_message_free(msg);
-    
     // Estimate size: address + type tag + string length + padding
     size_t estimatedSize = address.length() + 1 + value.length() + 4;
-    updateStats(result, estimatedSize);
-    
-    if (!result && errorCallback_) {
-        errorCallback_("Failed to send string to " + address);
-    }
-    
-    return result;
+    return submit([address, value](OSCTransport& transport) {
+        lo_message msg = lo_message_new();
+        lo_message_add_string(msg, value.c_str());
+        bool result = transport.sendMessage(address, static_cast<void*>(msg));
+        lo_message_free(msg);
+        return result;
+    }, estimatedSize, "Failed to send string to ", address);
 }
 
 bool OSCSenderEnhanced::sendFloatArray(const std::string& address, const std::vector<float>& values) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    if (!transport_ || !transport_->isConnected()) {
-        updateStats(false);
-        if (errorCallback_) {
-            errorCallback_("Not connected");
-        }
-        return false;
-    }
-    
-    lo_message msg = lo_message_new();
-    
-    for (float value : values) {
-        lo_message_add_float(msg, value);
-    }
-    
-    bool result = transport_->sendMessage(address, static_cast<void*>(msg));
-    
-    lo_message_free(msg);
-    
     // Estimate size: address + type tags + floats
     size_t estimatedSize = address.length() + values.size() + (values.size() * 4);
-    updateStats(result, estimatedSize);
-    
-    if (!result && errorCallback_) {
-        errorCallback_("Failed to send float array to " + address);
-    }
-    
-    return result;
+    return submit([address, values](OSCTransport& transport) {
+        lo_message msg = lo_message_new();
+        for (float value : values) {
+            lo_message_add_float(msg, value);
+        }
+        bool result = transport.sendMessage(address, static_cast<void*>(msg));
+        lo_message_free(msg);
+        return result;
+    }, estimatedSize, "Failed to send float array to ", address);
 }
 
 bool OSCSenderEnhanced::sendFloatBatch(const std::vector<std::string>& addresses, const std::vector<float>& values) {
@@ -222,6 +199,26 @@ bool OSCSenderEnhanced::sendFloatBatch(const std::vector<std::string>& addresses
     
     std::lock_guard<std::mutex> lock(mutex_);
     
+    size_t totalSize = 0;
+    for (const auto& address : addresses) {
+        totalSize += address.length() + 1 + 4;
+    }
+    
+    // One bundle for atomic batch sending; it is paced as a single packet
+    return submit([addresses, values](OSCTransport& transport) {
+        lo_bundle bundle = lo_bundle_new(LO_TT_IMMEDIATE);
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            lo_message msg = lo_message_new();
+            lo_message_add_float(msg, values[i]);
+            lo_bundle_add_message(bundle, addresses[i].c_str(), msg);
+        }
+        bool result = transport.sendBundle(static_cast<void*>(bundle));
+        lo_bundle_free_recursive(bundle);
+        return result;
+    }, totalSize, "Failed to send float batch", "");
+}
+
+bool OSCSenderEnhanced::submit(Send send, size_t bytes, const char* failure, const std::string& address) {
     if (!transport_ || !transport_->isConnected()) {
         updateStats(false);
         if (errorCallback_) {
@@ -230,28 +227,136 @@ bool OSCSenderEnhanced::sendFloatBatch(const std::vector<std::string>& addresses
         return false;
     }
     
-    // Create bundle for atomic batch sending
-    lo_bundle bundle = lo_bundle_new(LO_TT_IMMEDIATE);
-    
-    size_t totalSize = 0;
-    for (size_t i = 0; i < addresses.size(); ++i) {
-        lo_message msg = lo_message_new();
-        lo_message_add_float(msg, values[i]);
-        lo_bundle_add_message(bundle, addresses[i].c_str(), msg);
-        totalSize += addresses[i].length() + 1 + 4;
+    int64_t now = nowNs();
+    if (pacing_ && (!pending_.empty() || !pacer_.tryAcquire(now))) {
+        // Over the rate: wait for the bucket, keeping order behind earlier sends
+        if (pending_.size() >= maxPending_) {
+            pending_.pop_front();
+            stats_.packetsShed++;
+            pacer_.onShed(now);
+        }
+        pending_.push_back({std::move(send), bytes, failure, address});
+        scheduleDrain(now);
+        return true;
     }
+    return transmit(send, bytes, failure, address, now);
+}
+
+bool OSCSenderEnhanced::transmit(const Send& send, size_t bytes, const char* failure, const std::string& address, int64_t nowNs) {
+    bool result = send(*transport_);
+    
+    if (result) {
+        // The send queue is a syscall away; once a millisecond is enough to see it grow
+        if (nowNs - queueSampleNs_ >= 1000000) {
+            queuedBytes_ = transport_->getQueuedBytes();
+            queueSampleNs_ = nowNs;
+        }
+        pacer_.onSent(nowNs, queuedBytes_);
+    } else {
+        pacer_.onSendFailed(nowNs, transport_->getLastSendErrno());
+    }
+    pacer_.onRoundTrip(transport_->getRoundTripMs());
+    updateStats(result, bytes);
     
-    bool result = transport_->sendBundle(static_cast<void*>(bundle));
+    if (!result && errorCallback_) {
+        errorCallback_(failure + address);
+    }
     
-    lo_bundle_free_recursive(bundle);
+    return result;
+}
+
+void OSCSenderEnhanced::scheduleDrain(int64_t nowNs) {
+    if (drainTimer_) {
+        return;
+    }
+    // Timers tick in milliseconds; the bucket's burst covers the rounding
+    int64_t waitNs = pacer_.nanosUntilNext(nowNs);
+    auto delay = std::chrono::milliseconds((waitNs + 999999) / 1000000);
+    drainTimer_ = loop_.runAfter(delay, [this] { drain(); });
+}
+
+void OSCSenderEnhanced::drain() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drainTimer_ = 0;
     
-    updateStats(result, totalSize);
+    if (!transport_ || !transport_->isConnected()) {
+        pending_.clear();
+        return;
+    }
     
-    if (!result && errorCallback_) {
-        errorCallback_("Failed to send float batch");
+    int64_t now = nowNs();
+    while (!pending_.empty() && pacer_.tryAcquire(now)) {
+        PendingSend next = std::move(pending_.front());
+        pending_.pop_front();
+        transmit(next.send, next.bytes, next.failure, next.address, now);
+    }
+    if (!pending_.empty()) {
+        scheduleDrain(now);
     }
+}
+
+void OSCSenderEnhanced::setPacing(bool enable, double maxPacketsPerSecond) {
+    std::lock_guard<std::mutex> lock(mutex_);
     
-    return result;
+    OSCSendPacer::Config config = pacer_.getConfig();
+    config.maxRate = maxPacketsPerSecond;
+    config.minRate = std::min(config.minRate, maxPacketsPerSecond);
+    pacer_.setConfig(config);
+    pacing_ = enable;
+    
+    // Whatever was waiting goes out now rather than being stranded
+    if (!enable) {
+        int64_t now = nowNs();
+        while (!pending_.empty() && transport_ && transport_->isConnected()) {
+            PendingSend next = std::move(pending_.front());
+            pending_.pop_front();
+            transmit(next.send, next.bytes, next.failure, next.address, now);
+        }
+        pending_.clear();
+    }
+}
+
+void OSCSenderEnhanced::setPacingConfig(const OSCSendPacer::Config& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pacer_.setConfig(config);
+}
+
+bool OSCSenderEnhanced::isPacingEnabled() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pacing_;
+}
+
+void OSCSenderEnhanced::setMaxPendingSends(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxPending_ = std::max<size_t>(1, count);
+}
+
+void OSCSenderEnhanced::reportPathFeedback(double lossFraction, double roundTripMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pacer_.onFeedback(nowNs(), lossFraction, roundTripMs);
+    recordRoundTrip(roundTripMs);
+}
+
+void OSCSenderEnhanced::attachMonitor(PerformanceMonitor& monitor) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    monitor_ = &monitor;
+}
+
+// Called with mutex_ held, once per measured exchange. The transport's RTT is the
+// kernel's smoothed estimate, not a sample, so it only feeds the pacer.
+void OSCSenderEnhanced::recordRoundTrip(double roundTripMs) {
+    if (!monitor_ || roundTripMs <= 0.0) {
+        return;
+    }
+    monitor_->recordNetworkLatency(std::chrono::nanoseconds(static_cast<int64_t>(roundTripMs * 1e6)));
+}
+
+// Called with mutex_ held when the destination changes
+void OSCSenderEnhanced::resetPath() {
+    pending_.clear();
+    pacer_ = OSCSendPacer(pacer_.getConfig());
+    queuedBytes_ = 0;
+    queueSampleNs_ = 0;
 }
 
 void OSCSenderEnhanced::setAutoReconnect(bool enable) {
@@ -305,6 +410,23 @@ void OSCSenderEnhanced::setErrorCallback(std::function<void(const std::string&)>
     }
 }
 
+OSCSenderEnhanced::Statistics OSCSenderEnhanced::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    Statistics stats = stats_;
+    stats.destination = host_.empty() ? "" : host_ + ":" + port_;
+    stats.congestionEvents = pacer_.congestionEvents();
+    stats.pacingRate = pacing_ ? pacer_.rate() : 0.0;
+    stats.lossRate = pacer_.lossRate();
+    stats.roundTripMs = pacer_.roundTripMs();
+    if (stats.roundTripMs > 0.0) {
+        stats.averageLatency = static_cast<float>(stats.roundTripMs / 2.0);
+    }
+    stats.queuedBytes = queuedBytes_;
+    stats.pendingSends = pending_.size();
+    return stats;
+}
+
 void OSCSenderEnhanced::resetStatistics() {
     std::lock_guard<std::mutex> lock(mutex_);
     stats_ = Statistics{};
@@ -316,7 +438,7 @@ bool OSCSenderEnhanced::createTransport(OSCTransport::Protocol protocol) {
     
     if (!transport_) {
         if (errorCallback_) {
-            errorCallback_("Failed to create transport for protocol: " + getProtocolName());
+            errorCallback_("Failed to create transport for protocol: " + protocolName(protocol));
         }
         return false;
     }
@@ -338,7 +460,4 @@ void OSCSenderEnhanced::updateStats(bool success, size_t bytesEstimate) {
     }
     
     stats_.lastActivity = std::chrono::steady_clock::now();
-    
-    // Simple moving average for latency (placeholder - actual implementation would measure round-trip)
-    // This is a simplified version - real latency measurement would require timestamps
 }
@@ -3,12 +3,22 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <deque>
 #include <mutex>
 #include "OSCTransport.h"
 #include "OSCFormatManager.h"
+#include "OSCSendPacer.h"
+#include "OSCEventLoop.h"
+
+class PerformanceMonitor;
 
 /**
  * @brief Enhanced OSC sender with multi-protocol support
+ *
+ * With pacing on, sends pass through an OSCSendPacer: those over the
+ * current rate wait in a short queue that the shared OSCEventLoop drains
+ * as the bucket refills, and the rate adapts to congestion on the path.
+ * Loss, RTT and the pacing rate are tracked either way.
  */
 class OSCSenderEnhanced {
 public:
@@ -24,6 +34,8 @@ public:
     void setProtocol(OSCTransport::Protocol protocol);
     OSCTransport::Protocol getProtocol() const;
     std::string getProtocolName() const;
+    // Set while a stream transport's send queue is backing up; skip non-essential sends
+    bool isBackpressured() const;
     
     // Basic sending methods
     bool sendFloat(const std::string& address, float value);
@@ -34,6 +46,17 @@ public:
     // Batch sending
     bool sendFloatBatch(const std::vector<std::string>& addresses, const std::vector<float>& values);
     
+    // Pacing (off by default): at most maxPacketsPerSecond, less while the path is congested
+    void setPacing(bool enable, double maxPacketsPerSecond = 2000.0);
+    void setPacingConfig(const OSCSendPacer::Config& config);
+    bool isPacingEnabled() const;
+    // Sends waiting for the pacer; past this the oldest is dropped, as a newer value supersedes it
+    void setMaxPendingSends(size_t count);
+    // Loss and RTT measured by the receiver, when it reports them back
+    void reportPathFeedback(double lossFraction, double roundTripMs);
+    // Each round trip reported through reportPathFeedback() is recorded as send-to-ack latency
+    void attachMonitor(PerformanceMonitor& monitor);
+    
     // TCP-specific options
     void setAutoReconnect(bool enable);
     void setReconnectDelay(int seconds);
@@ -48,14 +71,33 @@ public:
         uint64_t messagesSent = 0;
         uint64_t bytesSent = 0;
         uint64_t errors = 0;
-        float averageLatency = 0.0f;
+        float averageLatency = 0.0f;        // One-way estimate (RTT / 2) in ms, once an RTT is known
         std::chrono::steady_clock::time_point lastActivity;
+        
+        // Path to the destination
+        std::string destination;            // host:port
+        uint64_t packetsShed = 0;           // Dropped from a full pacing queue
+        uint64_t congestionEvents = 0;      // Rate cuts: ENOBUFS/EAGAIN, send-queue growth or reported loss
+        double pacingRate = 0.0;            // Packets/s currently allowed; 0 with pacing off
+        double lossRate = 0.0;              // Smoothed fraction of sends lost locally or reported lost
+        double roundTripMs = -1.0;          // From the transport (TCP) or reportPathFeedback(); -1 if unknown
+        size_t queuedBytes = 0;             // Last sampled socket or transport send queue
+        size_t pendingSends = 0;            // Waiting in the pacing queue
     };
     
-    Statistics getStatistics() const { return stats_; }
+    Statistics getStatistics() const;
     void resetStatistics();
 
 private:
+    // Replays one send against the transport; owns its arguments so it can wait in the pacing queue
+    using Send = std::function<bool(OSCTransport&)>;
+    struct PendingSend {
+        Send send;
+        size_t bytes;
+        const char* failure;
+        std::string address;
+    };
+    
     std::unique_ptr<OSCTransport> transport_;
     OSCTransport::Protocol currentProtocol_;
     std::string host_;
@@ -70,8 +112,29 @@ private:
     // Error callback
     std::function<void(const std::string&)> errorCallback_;
     
+    // Pacing
+    OSCEventLoop& loop_;
+    OSCSendPacer pacer_;
+    bool pacing_ = false;
+    std::deque<PendingSend> pending_;
+    size_t maxPending_ = 256;
+    OSCEventLoop::TimerId drainTimer_ = 0;
+    size_t queuedBytes_ = 0;
+    int64_t queueSampleNs_ = 0;
+    
+    PerformanceMonitor* monitor_ = nullptr;
+    
     // Transport creation
     bool createTransport(OSCTransport::Protocol protocol);
+    static std::string protocolName(OSCTransport::Protocol protocol);
+    
+    // Sending, with mutex_ held: submit() paces, transmit() sends now
+    bool submit(Send send, size_t bytes, const char* failure, const std::string& address);
+    bool transmit(const Send& send, size_t bytes, const char* failure, const std::string& address, int64_t nowNs);
+    void scheduleDrain(int64_t nowNs);
+    void drain();
+    void resetPath();
+    void recordRoundTrip(double roundTripMs);
     
     // Update statistics
     void updateStats(bool success, size_t bytesEstimate = 0);
@@ -0,0 +1,118 @@
+#include "OSCSharedMemoryReader.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+OSCSharedMemoryReader::~OSCSharedMemoryReader() {
+    close();
+}
+
+bool OSCSharedMemoryReader::open(const std::string& port) {
+    close();
+    std::string name = OSCSharedMemory::segmentName(port);
+    // Read-write because waiting registers in the header; the data is never written
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        lastError_ = "Cannot open shared memory " + name + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) <= OSCSharedMemory::dataOffset()) {
+        lastError_ = "Shared memory " + name + " is not an OSC ring";
+        ::close(fd);
+        return false;
+    }
+    size_t bytes = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        lastError_ = "Cannot map shared memory " + name + ": " + std::strerror(errno);
+        return false;
+    }
+
+    auto* header = static_cast<OSCSharedMemory::RingHeader*>(mapping);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->magic != OSCSharedMemory::kMagic || header->version != OSCSharedMemory::kVersion ||
+        OSCSharedMemory::dataOffset() + header->capacity != bytes) {
+        lastError_ = "Shared memory " + name + " has an incompatible layout";
+        munmap(mapping, bytes);
+        return false;
+    }
+    header_ = header;
+    data_ = static_cast<const uint8_t*>(mapping) + OSCSharedMemory::dataOffset();
+    mappedBytes_ = bytes;
+    capacity_ = header->capacity;
+    cursor_ = header->published.load(std::memory_order_acquire);
+    return true;
+}
+
+void OSCSharedMemoryReader::close() {
+    if (header_) {
+        munmap(header_, mappedBytes_);
+        header_ = nullptr;
+        data_ = nullptr;
+        mappedBytes_ = 0;
+    }
+}
+
+void OSCSharedMemoryReader::resync() {
+    stats_.overruns++;
+    cursor_ = header_->published.load(std::memory_order_acquire);
+}
+
+bool OSCSharedMemoryReader::read(std::vector<uint8_t>& packet) {
+    using namespace OSCSharedMemory;
+    if (!header_) {
+        return false;
+    }
+    while (true) {
+        uint64_t published = header_->published.load(std::memory_order_acquire);
+        if (cursor_ == published) {
+            return false;
+        }
+        if (published - cursor_ > capacity_) {
+            resync();
+            continue;
+        }
+
+        RecordHeader record;
+        const uint8_t* in = data_ + (cursor_ & (capacity_ - 1));
+        std::memcpy(&record, in, sizeof(record));
+        size_t length = record.flags & kPaddingRecord ? sizeof(record) + record.size : recordSize(record.size);
+        if (record.position != cursor_ || length > capacity_ - (cursor_ & (capacity_ - 1))) {
+            resync();
+            continue;
+        }
+        if (!(record.flags & kPaddingRecord)) {
+            packet.assign(in + sizeof(record), in + sizeof(record) + record.size);
+        }
+
+        // The copy is only good if the producer had not started reusing these bytes meanwhile
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header_->reserved.load(std::memory_order_relaxed) - cursor_ > capacity_) {
+            resync();
+            continue;
+        }
+        cursor_ += length;
+        if (record.flags & kPaddingRecord) {
+            continue;
+        }
+        stats_.packetsRead++;
+        return true;
+    }
+}
+
+void OSCSharedMemoryReader::wait(int timeoutMs) {
+    if (!header_) {
+        return;
+    }
+    uint32_t sequence = header_->wakeSequence.load(std::memory_order_seq_cst);
+    // A publish between the caller's last read() and the load above would otherwise be slept through
+    if (header_->published.load(std::memory_order_acquire) != cursor_) {
+        return;
+    }
+    OSCSharedMemory::waitForData(*header_, sequence, timeoutMs);
+}
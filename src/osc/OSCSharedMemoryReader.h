@@ -0,0 +1,57 @@
+#pragma once
+
+#include "OSCSharedMemoryRing.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Consumer side of the shared-memory OSC transport
+ *
+ * Maps the ring an OSCSharedMemoryTransport writes and yields each packet
+ * in order, exactly as it would have arrived in a UDP datagram. Readers are
+ * independent: each keeps its own cursor and may be in another process.
+ * Not thread safe; use one reader per consuming thread.
+ *
+ * Typical loop:
+ *     while (running) {
+ *         while (reader.read(packet)) handle(packet);
+ *         reader.wait(100);
+ *     }
+ */
+class OSCSharedMemoryReader {
+public:
+    struct Stats {
+        uint64_t packetsRead = 0;
+        uint64_t overruns = 0;   // Times the producer lapped this reader and packets were lost
+    };
+
+    OSCSharedMemoryReader() = default;
+    ~OSCSharedMemoryReader();
+    OSCSharedMemoryReader(const OSCSharedMemoryReader&) = delete;
+    OSCSharedMemoryReader& operator=(const OSCSharedMemoryReader&) = delete;
+
+    // Attach to the ring for this port; reading starts at the newest packet
+    bool open(const std::string& port);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+
+    // Copy the next packet into the buffer; false when the reader has caught up
+    bool read(std::vector<uint8_t>& packet);
+    // Block until the producer publishes or the timeout passes (-1 waits forever)
+    void wait(int timeoutMs);
+
+    Stats getStats() const { return stats_; }
+    std::string getLastError() const { return lastError_; }
+
+private:
+    OSCSharedMemory::RingHeader* header_ = nullptr;
+    const uint8_t* data_ = nullptr;
+    size_t mappedBytes_ = 0;
+    uint64_t capacity_ = 0;
+    uint64_t cursor_ = 0;
+    Stats stats_;
+    std::string lastError_;
+
+    void resync();
+};
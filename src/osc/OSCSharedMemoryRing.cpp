@@ -0,0 +1,46 @@
+#include "OSCSharedMemoryRing.h"
+#include <chrono>
+#include <thread>
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace OSCSharedMemory {
+
+std::string segmentName(const std::string& port) {
+    return "/cvosc-" + port;
+}
+
+void waitForData(RingHeader& header, uint32_t seenSequence, int timeoutMs) {
+    header.sleepers.fetch_add(1, std::memory_order_seq_cst);
+#if defined(__linux__)
+    // Shared (not private) futex: the producer is usually another process
+    timespec timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header.wakeSequence), FUTEX_WAIT, seenSequence,
+            timeoutMs < 0 ? nullptr : &timeout, nullptr, 0);
+#else
+    // No public futex on macOS: nap in short steps until the sequence moves
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs < 0 ? INT32_MAX : timeoutMs);
+    while (header.wakeSequence.load(std::memory_order_acquire) == seenSequence &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+#endif
+    header.sleepers.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void wakeReaders(RingHeader& header) {
+    header.wakeSequence.fetch_add(1, std::memory_order_seq_cst);
+#if defined(__linux__)
+    // Skip the syscall when every reader is spinning or busy
+    if (header.sleepers.load(std::memory_order_seq_cst) > 0) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&header.wakeSequence), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+#endif
+}
+
+} // namespace OSCSharedMemory
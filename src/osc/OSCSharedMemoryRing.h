@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Layout of the shared-memory OSC ring
+ *
+ * One producer appends packets to a byte ring in a POSIX shared memory
+ * segment; any number of readers follow it with their own cursor. The
+ * producer never waits for readers: a reader that falls more than one ring
+ * behind detects it (every record carries its absolute position) and skips
+ * ahead, counting an overrun. Both ends share only this header file, so a
+ * consumer can build the reader without the rest of the mixer.
+ *
+ * Records are 16-byte aligned: a RecordHeader, then the packet. A record
+ * that would straddle the end of the ring is preceded by a padding record.
+ */
+namespace OSCSharedMemory {
+
+constexpr uint32_t kMagic = 0x4356534d;   // "CVSM"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kDefaultCapacity = 4 << 20;
+constexpr size_t kRecordAlignment = 16;
+constexpr uint32_t kPaddingRecord = 1;
+
+struct alignas(64) RingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;                        // Bytes of ring data, a power of two
+    alignas(64) std::atomic<uint64_t> reserved;   // End of the record being written
+    std::atomic<uint64_t> published;              // End of the last complete record
+    alignas(64) std::atomic<uint32_t> wakeSequence;   // Futex word, bumped per publish
+    std::atomic<uint32_t> sleepers;                   // Readers blocked in waitForData()
+};
+
+struct RecordHeader {
+    uint64_t position;   // Absolute ring position of this record; a mismatch means it was overwritten
+    uint32_t size;       // Packet bytes that follow
+    uint32_t flags;
+};
+
+static_assert(sizeof(RecordHeader) == kRecordAlignment, "records must stay aligned");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring counters must be lock free across processes");
+
+inline size_t dataOffset() { return sizeof(RingHeader); }
+inline size_t recordSize(size_t packetSize) {
+    return (sizeof(RecordHeader) + packetSize + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+// "/cvosc-9000": the OSC port a consumer would otherwise listen on names the ring
+std::string segmentName(const std::string& port);
+
+// Futex wait/wake on Linux; elsewhere waiters nap briefly and re-check
+void waitForData(RingHeader& header, uint32_t seenSequence, int timeoutMs);
+void wakeReaders(RingHeader& header);
+
+} // namespace OSCSharedMemory
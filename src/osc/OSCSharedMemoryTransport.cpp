@@ -0,0 +1,184 @@
+#include "OSCSharedMemoryTransport.h"
+#include "OSCPacket.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+OSCSharedMemoryTransport::OSCSharedMemoryTransport() {
+}
+
+OSCSharedMemoryTransport::~OSCSharedMemoryTransport() {
+    disconnect();
+}
+
+void OSCSharedMemoryTransport::setCapacity(size_t bytes) {
+    size_t capacity = 4096;
+    while (capacity < bytes) {
+        capacity <<= 1;
+    }
+    capacity_ = capacity;
+}
+
+bool OSCSharedMemoryTransport::connect(const std::string& host, const std::string& port) {
+    disconnect();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!host.empty() && host != "localhost" && host != "127.0.0.1" && host != "::1") {
+        reportError("Shared memory only reaches this host, not " + host);
+        return false;
+    }
+    segmentName_ = OSCSharedMemory::segmentName(port);
+    int fd = shm_open(segmentName_.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        reportError("Cannot open shared memory " + segmentName_ + ": " + std::strerror(errno));
+        return false;
+    }
+
+    // An existing ring of the same size is reused, so readers survive a producer restart
+    const size_t bytes = OSCSharedMemory::dataOffset() + capacity_;
+    struct stat info {};
+    bool reuse = fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) == bytes;
+    if (!reuse && ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+        reportError("Cannot size shared memory " + segmentName_ + ": " + std::strerror(errno));
+        close(fd);
+        return false;
+    }
+    void* mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        reportError("Cannot map shared memory " + segmentName_ + ": " + std::strerror(errno));
+        return false;
+    }
+
+    header_ = static_cast<OSCSharedMemory::RingHeader*>(mapping);
+    data_ = static_cast<uint8_t*>(mapping) + OSCSharedMemory::dataOffset();
+    mappedBytes_ = bytes;
+    if (!reuse || header_->magic != OSCSharedMemory::kMagic || header_->version != OSCSharedMemory::kVersion ||
+        header_->capacity != capacity_) {
+        new (header_) OSCSharedMemory::RingHeader{};
+        header_->version = OSCSharedMemory::kVersion;
+        header_->capacity = capacity_;
+        // Readers check the magic last, so it goes in once the rest is valid
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->magic = OSCSharedMemory::kMagic;
+    }
+    return true;
+}
+
+bool OSCSharedMemoryTransport::disconnect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_) {
+        munmap(header_, mappedBytes_);
+        header_ = nullptr;
+        data_ = nullptr;
+        mappedBytes_ = 0;
+    }
+    return true;
+}
+
+bool OSCSharedMemoryTransport::isConnected() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return header_ != nullptr;
+}
+
+bool OSCSharedMemoryTransport::removeSegment(const std::string& port) {
+    return shm_unlink(OSCSharedMemory::segmentName(port).c_str()) == 0;
+}
+
+bool OSCSharedMemoryTransport::sendPacket(const void* packet, size_t size) {
+    using namespace OSCSharedMemory;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!header_) {
+        reportError("Shared memory transport not connected");
+        return false;
+    }
+    const uint64_t capacity = header_->capacity;
+    const size_t length = recordSize(size);
+    if (length > capacity / 4) {
+        reportError("Packet of " + std::to_string(size) + " bytes is too large for the shared memory ring");
+        return false;
+    }
+
+    uint64_t position = header_->published.load(std::memory_order_relaxed);
+    const size_t offset = position & (capacity - 1);
+    const size_t padding = offset + length > capacity ? capacity - offset : 0;
+
+    // Claim the bytes before touching them so a reader can tell its record was overwritten
+    header_->reserved.store(position + padding + length, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (padding) {
+        RecordHeader pad{position, static_cast<uint32_t>(padding - sizeof(RecordHeader)), kPaddingRecord};
+        std::memcpy(data_ + offset, &pad, sizeof(pad));
+        position += padding;
+    }
+    RecordHeader record{position, static_cast<uint32_t>(size), 0};
+    uint8_t* out = data_ + (position & (capacity - 1));
+    std::memcpy(out, &record, sizeof(record));
+    std::memcpy(out + sizeof(record), packet, size);
+
+    header_->published.store(position + length, std::memory_order_release);
+    wakeReaders(*header_);
+    packetsWritten_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool OSCSharedMemoryTransport::sendLoMessage(const std::string& address, lo_message message) {
+    thread_local std::vector<uint8_t> buffer;
+    size_t size = lo_message_length(message, address.c_str());
+    buffer.resize(size);
+    lo_message_serialise(message, address.c_str(), buffer.data(), &size);
+    return sendPacket(buffer.data(), size);
+}
+
+bool OSCSharedMemoryTransport::sendMessage(const std::string& address, void* msg) {
+    return sendLoMessage(address, static_cast<lo_message>(msg));
+}
+
+bool OSCSharedMemoryTransport::sendBundle(void* bundle) {
+    thread_local std::vector<uint8_t> buffer;
+    lo_bundle bndl = static_cast<lo_bundle>(bundle);
+    size_t size = lo_bundle_length(bndl);
+    buffer.resize(size);
+    lo_bundle_serialise(bndl, buffer.data(), &size);
+    return sendPacket(buffer.data(), size);
+}
+
+bool OSCSharedMemoryTransport::sendMessage(const std::string& address, const std::vector<float>& values) {
+    thread_local std::vector<uint8_t> buffer;
+    buffer.clear();
+    OSCPacket::appendFloatMessage(buffer, address, values.data(), values.size());
+    return sendPacket(buffer.data(), buffer.size());
+}
+
+bool OSCSharedMemoryTransport::sendMessage(const std::string& address, const std::vector<int>& values) {
+    lo_message msg = lo_message_new();
+    for (int value : values) {
+        lo_message_add_int32(msg, value);
+    }
+    bool result = sendLoMessage(address, msg);
+    lo_message_free(msg);
+    return result;
+}
+
+bool OSCSharedMemoryTransport::sendMessage(const std::string& address, const std::string& value) {
+    lo_message msg = lo_message_new();
+    lo_message_add_string(msg, value.c_str());
+    bool result = sendLoMessage(address, msg);
+    lo_message_free(msg);
+    return result;
+}
+
+bool OSCSharedMemoryTransport::sendBundle(const std::vector<std::pair<std::string, std::vector<float>>>& messages) {
+    thread_local std::vector<uint8_t> buffer;
+    buffer.clear();
+    OSCPacket::appendBundleHeader(buffer);
+    for (const auto& [address, values] : messages) {
+        OSCPacket::appendBundleFloatMessage(buffer, address, values.data(), values.size());
+    }
+    return sendPacket(buffer.data(), buffer.size());
+}
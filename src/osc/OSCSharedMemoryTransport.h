@@ -0,0 +1,73 @@
+#pragma once
+
+#include "OSCTransport.h"
+#include "OSCSharedMemoryRing.h"
+#include <lo/lo.h>
+#include <atomic>
+#include <mutex>
+
+/**
+ * @brief Shared-memory OSC transport for consumers on the same host
+ *
+ * Packets are appended to an OSCSharedMemory ring instead of crossing the
+ * network stack; OSCSharedMemoryReader follows it from the consumer's side.
+ * connect() takes "localhost" (or an empty host) and the port the consumer
+ * would listen on, which names the segment. A send is a copy into the ring
+ * and, only when a reader is asleep, one futex wake.
+ */
+class OSCSharedMemoryTransport : public OSCTransport {
+public:
+    OSCSharedMemoryTransport();
+    ~OSCSharedMemoryTransport() override;
+
+    // Connection management
+    bool connect(const std::string& host, const std::string& port) override;
+    bool disconnect() override;
+    bool isConnected() const override;
+
+    // Sending methods for liblo integration
+    bool sendMessage(const std::string& address, void* msg) override;
+    bool sendBundle(void* bundle) override;
+
+    // High-level sending methods
+    bool sendMessage(const std::string& address, const std::vector<float>& values) override;
+    bool sendMessage(const std::string& address, const std::vector<int>& values) override;
+    bool sendMessage(const std::string& address, const std::string& value) override;
+    bool sendBundle(const std::vector<std::pair<std::string, std::vector<float>>>& messages) override;
+    // Append an already encoded OSC packet
+    bool sendPacket(const void* data, size_t size);
+
+    // Protocol information
+    Protocol getProtocol() const override { return Protocol::SHARED_MEMORY; }
+    std::string getProtocolName() const override { return "Shared memory"; }
+
+    // Error handling
+    std::string getLastError() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastError_;
+    }
+    void setErrorCallback(std::function<void(const std::string&)> callback) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        errorCallback_ = callback;
+    }
+
+    // Ring size for the next connect(); rounded up to a power of two
+    void setCapacity(size_t bytes);
+    size_t getCapacity() const { return capacity_; }
+    const std::string& getSegmentName() const { return segmentName_; }
+    uint64_t getPacketsWritten() const { return packetsWritten_.load(std::memory_order_relaxed); }
+
+    // Removes the segment; readers that have it mapped keep their copy
+    static bool removeSegment(const std::string& port);
+
+private:
+    size_t capacity_ = OSCSharedMemory::kDefaultCapacity;
+    std::string segmentName_;
+    OSCSharedMemory::RingHeader* header_ = nullptr;
+    uint8_t* data_ = nullptr;
+    size_t mappedBytes_ = 0;
+    std::atomic<uint64_t> packetsWritten_{0};
+    mutable std::mutex mutex_;   // One producer: serialises senders and guards the mapping
+
+    bool sendLoMessage(const std::string& address, lo_message message);
+};
@@ -0,0 +1,340 @@
+#include "OSCStream.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace OSCStream {
+
+namespace {
+
+// "/cvosc/seq ,ii": the first element of every stream bundle, at a fixed offset
+constexpr uint8_t kSequencePrefix[16] = {'/', 'c', 'v', 'o', 's', 'c', '/', 's', 'e', 'q', 0, 0, ',', 'i', 'i', 0};
+constexpr uint8_t kParityPrefix[20] = {'/', 'c', 'v', 'o', 's', 'c', '/', 'f', 'e', 'c', 0, 0,
+                                       ',', 'i', 'i', 'i', 'b', 0, 0, 0};
+constexpr size_t kSequenceElementSize = 24;
+constexpr size_t kStreamOffset = 36;      // Bundle header (16), element size (4), prefix (16), then stream, sequence
+constexpr size_t kSequenceOffset = 40;
+constexpr size_t kMinStreamBundle = 44;
+constexpr size_t kParityHeader = 36;      // Prefix, stream, first, count, blob size
+
+constexpr int32_t kResyncDistance = 1 << 14;   // A jump this far either way is a new sender, not loss
+constexpr uint32_t kResyncRun = 4;            // Consecutive too-old packets that mean the same
+
+void appendInt32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t readInt32(const uint8_t* in) {
+    return (uint32_t(in[0]) << 24) | (uint32_t(in[1]) << 16) | (uint32_t(in[2]) << 8) | in[3];
+}
+
+// Parity covers the length too, so a rebuilt packet knows its own size
+void xorPacket(std::vector<uint8_t>& parity, const uint8_t* data, size_t size) {
+    if (parity.size() < size + 4) {
+        parity.resize(size + 4, 0);
+    }
+    parity[0] ^= static_cast<uint8_t>(size >> 24);
+    parity[1] ^= static_cast<uint8_t>(size >> 16);
+    parity[2] ^= static_cast<uint8_t>(size >> 8);
+    parity[3] ^= static_cast<uint8_t>(size);
+    for (size_t i = 0; i < size; i++) {
+        parity[4 + i] ^= data[i];
+    }
+}
+
+bool isMarked(const std::array<uint64_t, Decoder::kWindow / 64>& window, uint32_t sequence) {
+    uint32_t slot = sequence % Decoder::kWindow;
+    return (window[slot / 64] >> (slot % 64)) & 1;
+}
+
+void setMarked(std::array<uint64_t, Decoder::kWindow / 64>& window, uint32_t sequence, bool marked) {
+    uint32_t slot = sequence % Decoder::kWindow;
+    if (marked) {
+        window[slot / 64] |= uint64_t(1) << (slot % 64);
+    } else {
+        window[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    }
+}
+
+double timetagDifferenceMs(uint64_t later, uint64_t earlier) {
+    return static_cast<double>(static_cast<int64_t>(later - earlier)) * 1000.0 / 4294967296.0;
+}
+
+} // namespace
+
+Encoder::Encoder() : Encoder(Config()) {
+}
+
+Encoder::Encoder(const Config& config) {
+    // A random start, as RTP does: a restarted sender is a jump, not a run of duplicates
+    std::random_device random;
+    sequence_ = random();
+    setConfig(config);
+}
+
+void Encoder::setConfig(const Config& config) {
+    config_ = config;
+    config_.parityGroup = std::clamp<size_t>(config_.parityGroup, 2, kMaxParityGroup);
+    groupCount_ = 0;
+}
+
+void Encoder::begin(std::vector<uint8_t>& out, uint64_t timetag) {
+    out.clear();
+    OSCPacket::appendBundleHeader(out, timetag);
+    appendInt32(out, kSequenceElementSize);
+    out.insert(out.end(), kSequencePrefix, kSequencePrefix + sizeof(kSequencePrefix));
+    appendInt32(out, config_.streamId);
+    appendInt32(out, sequence_);
+}
+
+bool Encoder::finish(const std::vector<uint8_t>& bundle, const std::function<bool(const uint8_t*, size_t)>& emit) {
+    uint32_t sequence = sequence_++;
+    bool sent = emit(bundle.data(), bundle.size());
+    if (config_.redundancy == Redundancy::DUPLICATE) {
+        sent = emit(bundle.data(), bundle.size()) && sent;
+    } else if (config_.redundancy == Redundancy::XOR_PARITY) {
+        if (groupCount_ == 0) {
+            groupFirst_ = sequence;
+            parity_.clear();
+        }
+        xorPacket(parity_, bundle.data(), bundle.size());
+        if (++groupCount_ == config_.parityGroup) {
+            parityPacket_.assign(kParityPrefix, kParityPrefix + sizeof(kParityPrefix));
+            appendInt32(parityPacket_, config_.streamId);
+            appendInt32(parityPacket_, groupFirst_);
+            appendInt32(parityPacket_, static_cast<uint32_t>(groupCount_));
+            appendInt32(parityPacket_, static_cast<uint32_t>(parity_.size()));
+            parityPacket_.insert(parityPacket_.end(), parity_.begin(), parity_.end());
+            parityPacket_.resize((parityPacket_.size() + 3) & ~size_t(3), 0);
+            sent = emit(parityPacket_.data(), parityPacket_.size()) && sent;
+            groupCount_ = 0;
+        }
+    }
+    return sent;
+}
+
+bool Decoder::isStreamPacket(const uint8_t* data, size_t size) {
+    if (size >= kMinStreamBundle && std::memcmp(data, "#bundle", 8) == 0) {
+        return readInt32(data + 16) == kSequenceElementSize &&
+               std::memcmp(data + 20, kSequencePrefix, sizeof(kSequencePrefix)) == 0;
+    }
+    return size >= kParityHeader && std::memcmp(data, kParityPrefix, sizeof(kParityPrefix)) == 0;
+}
+
+bool Decoder::process(const uint8_t* data, size_t size, uint64_t arrivalTimetag, const MessageHandler& deliver) {
+    if (!isStreamPacket(data, size)) {
+        return false;
+    }
+    bool valid = true;
+    if (data[0] == '#') {
+        uint32_t streamId = readInt32(data + kStreamOffset);
+        valid = processData(streams_[streamId], data, size, arrivalTimetag, false, deliver);
+    } else {
+        uint32_t streamId = readInt32(data + 20);
+        uint32_t length = readInt32(data + 32);
+        if (length > size - kParityHeader) {
+            valid = false;
+        } else {
+            std::string_view parity(reinterpret_cast<const char*>(data + kParityHeader), length);
+            processParity(streams_[streamId], streamId, readInt32(data + 24), readInt32(data + 28), parity,
+                          arrivalTimetag, deliver);
+        }
+    }
+    publish();
+    return valid;
+}
+
+bool Decoder::processData(Stream& stream, const uint8_t* data, size_t size, uint64_t arrivalTimetag,
+                          bool recovered, const MessageHandler& deliver) {
+    Stats& stats = stream.stats;
+    const uint32_t sequence = readInt32(data + kSequenceOffset);
+
+    auto restart = [&stream](uint32_t at) {
+        stream.started = true;
+        stream.history.resize(kHistory);
+        stream.highest = at;
+        stream.received.fill(0);
+        for (auto& stored : stream.history) {
+            stored.valid = false;
+        }
+        stream.lastSequence.clear();
+        stream.oldRun = 0;
+        stream.haveTransit = false;
+    };
+
+    bool late = false;
+    int32_t ahead = static_cast<int32_t>(sequence - stream.highest);
+    if (!stream.started) {
+        restart(sequence);
+    } else if (ahead > kResyncDistance || ahead < -kResyncDistance) {
+        restart(sequence);
+        stats.resyncs++;
+    } else if (ahead > 0) {
+        stats.packetsLost += static_cast<uint64_t>(ahead - 1);
+        for (int32_t i = 1; i <= std::min<int32_t>(ahead, kWindow); i++) {
+            setMarked(stream.received, stream.highest + i, false);
+        }
+        stream.highest = sequence;
+        stream.oldRun = 0;
+    } else if (-ahead >= static_cast<int32_t>(kWindow)) {
+        // Too old to place; a run of them in sequence is a sender that went back
+        stream.oldRun = (stream.oldRun && sequence == stream.oldNext) ? stream.oldRun + 1 : 1;
+        stream.oldNext = sequence + 1;
+        if (stream.oldRun < kResyncRun) {
+            stats.latePacketsDropped++;
+            return true;
+        }
+        restart(sequence);
+        stats.resyncs++;
+    } else if (isMarked(stream.received, sequence)) {
+        stats.duplicatesDropped++;
+        return true;
+    } else {
+        late = true;
+        if (stats.packetsLost > 0) {
+            stats.packetsLost--;
+        }
+        if (!recovered) {
+            stats.packetsReordered++;
+        }
+    }
+
+    setMarked(stream.received, sequence, true);
+    stats.packetsReceived++;
+    if (recovered) {
+        stats.packetsRecovered++;
+    }
+
+    // Jitter is about arrival times, which a rebuilt packet does not have
+    uint64_t sent = (uint64_t(readInt32(data + 8)) << 32) | readInt32(data + 12);
+    if (!recovered && sent != OSCPacket::kImmediate && arrivalTimetag != 0) {
+        double transit = timetagDifferenceMs(arrivalTimetag, sent);
+        if (stream.haveTransit) {
+            stats.jitterMs += (std::fabs(transit - stream.lastTransitMs) - stats.jitterMs) / 16.0;
+        }
+        stream.lastTransitMs = transit;
+        stream.haveTransit = true;
+    }
+
+    // Kept whether or not the sender sends parity, so the first group can be rebuilt
+    // too; after the first lap assign() only copies into the existing buffers
+    Stored& stored = stream.history[sequence % kHistory];
+    stored.sequence = sequence;
+    stored.valid = true;
+    stored.bytes.assign(data, data + size);
+
+    deliverMessages(stream, sequence, late, data, size, deliver);
+    return true;
+}
+
+void Decoder::processParity(Stream& stream, uint32_t streamId, uint32_t first, uint32_t count,
+                            std::string_view parity, uint64_t arrivalTimetag, const MessageHandler& deliver) {
+    if (!stream.started || count < 2 || count > kMaxParityGroup) {
+        return;
+    }
+    // The group's last bundle may be ahead of the newest received (it is the one lost)
+    int32_t behind = static_cast<int32_t>(stream.highest - (first + count - 1));
+    if (behind < -static_cast<int32_t>(count) || behind > static_cast<int32_t>(kHistory - count)) {
+        return;
+    }
+
+    uint32_t missing = 0;
+    size_t missingCount = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t sequence = first + i;
+        bool received = static_cast<int32_t>(sequence - stream.highest) <= 0 && isMarked(stream.received, sequence);
+        if (!received) {
+            missing = sequence;
+            missingCount++;
+        }
+    }
+    if (missingCount != 1) {
+        return;   // Nothing to do, or more lost than one parity packet can rebuild
+    }
+
+    std::vector<uint8_t> rebuilt(parity.begin(), parity.end());
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t sequence = first + i;
+        if (sequence == missing) {
+            continue;
+        }
+        const Stored& stored = stream.history[sequence % kHistory];
+        if (!stored.valid || stored.sequence != sequence || stored.bytes.size() + 4 > rebuilt.size()) {
+            return;   // Already overwritten
+        }
+        xorPacket(rebuilt, stored.bytes.data(), stored.bytes.size());
+    }
+    size_t size = readInt32(rebuilt.data());
+    const uint8_t* packet = rebuilt.data() + 4;
+    if (size + 4 > rebuilt.size() || !isStreamPacket(packet, size) || packet[0] != '#' ||
+        readInt32(packet + kStreamOffset) != streamId || readInt32(packet + kSequenceOffset) != missing) {
+        return;
+    }
+    processData(stream, packet, size, arrivalTimetag, true, deliver);
+}
+
+void Decoder::deliverMessages(Stream& stream, uint32_t sequence, bool late, const uint8_t* data, size_t size,
+                              const MessageHandler& deliver) {
+    thread_local std::string key;   // Keeps its capacity; the map lookup needs a std::string
+    OSCPacket::forEachMessage(data, size, [&](const OSCPacket::Message& message) {
+        if (message.address == kSequenceAddress) {
+            return;
+        }
+        key.assign(message.address.data(), message.address.size());
+        auto it = stream.lastSequence.find(key);
+        if (it == stream.lastSequence.end()) {
+            stream.lastSequence.emplace(key, sequence);
+        } else if (late && static_cast<int32_t>(it->second - sequence) > 0) {
+            stream.stats.staleMessagesDropped++;
+            return;
+        } else {
+            it->second = sequence;
+        }
+        deliver(message);
+    });
+}
+
+void Decoder::publish() {
+    Stats totals;
+    for (const auto& [id, stream] : streams_) {
+        (void)id;
+        const Stats& stats = stream.stats;
+        totals.packetsReceived += stats.packetsReceived;
+        totals.packetsLost += stats.packetsLost;
+        totals.packetsReordered += stats.packetsReordered;
+        totals.packetsRecovered += stats.packetsRecovered;
+        totals.duplicatesDropped += stats.duplicatesDropped;
+        totals.latePacketsDropped += stats.latePacketsDropped;
+        totals.staleMessagesDropped += stats.staleMessagesDropped;
+        totals.resyncs += stats.resyncs;
+        totals.jitterMs = std::max(totals.jitterMs, stats.jitterMs);
+    }
+    totals.streams = streams_.size();
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    published_ = totals;
+}
+
+Stats Decoder::getStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    Stats stats = published_;
+    stats.packetsReceived -= baseline_.packetsReceived;
+    stats.packetsLost -= std::min(stats.packetsLost, baseline_.packetsLost);
+    stats.packetsReordered -= baseline_.packetsReordered;
+    stats.packetsRecovered -= baseline_.packetsRecovered;
+    stats.duplicatesDropped -= baseline_.duplicatesDropped;
+    stats.latePacketsDropped -= baseline_.latePacketsDropped;
+    stats.staleMessagesDropped -= baseline_.staleMessagesDropped;
+    stats.resyncs -= baseline_.resyncs;
+    return stats;
+}
+
+void Decoder::resetStats() {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    baseline_ = published_;
+}
+
+} // namespace OSCStream
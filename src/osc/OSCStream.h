@@ -0,0 +1,156 @@
+#pragma once
+
+#include "OSCPacket.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Sequence-numbered OSC bundles for loss-sensitive UDP streams
+ *
+ * A stream packet is an ordinary OSC bundle whose timetag is the send time
+ * and whose first element is "/cvosc/seq ,ii <stream> <sequence>", so any
+ * OSC receiver still sees the payload messages. A stream-aware receiver
+ * uses the sequence to count gaps, reordering and duplicates, and the
+ * timetag for interarrival jitter.
+ *
+ * Redundancy is per stream: DUPLICATE sends every bundle twice (the copy is
+ * dropped by sequence); XOR_PARITY follows every K bundles with a
+ * "/cvosc/fec ,iiib <stream> <first> <K> <parity>" message from which any
+ * single lost bundle of the group is rebuilt.
+ */
+namespace OSCStream {
+
+constexpr const char* kSequenceAddress = "/cvosc/seq";
+constexpr const char* kParityAddress = "/cvosc/fec";
+constexpr size_t kMaxParityGroup = 16;
+
+enum class Redundancy {
+    NONE,
+    DUPLICATE,     // Every bundle twice: survives any single loss, doubles the traffic
+    XOR_PARITY     // One parity packet per group: survives one loss per group
+};
+
+struct Config {
+    uint32_t streamId = 1;          // Tells apart several senders to one receiver
+    Redundancy redundancy = Redundancy::NONE;
+    size_t parityGroup = 4;         // K bundles per parity packet, up to kMaxParityGroup
+};
+
+struct Stats {
+    uint64_t packetsReceived = 0;       // Distinct stream packets, recovered ones included
+    uint64_t packetsLost = 0;           // Sequence gaps not filled by a late or rebuilt packet
+    uint64_t packetsReordered = 0;      // Arrived after a later sequence
+    uint64_t packetsRecovered = 0;      // Rebuilt from parity
+    uint64_t duplicatesDropped = 0;
+    uint64_t latePacketsDropped = 0;    // Too far behind to place in the window
+    uint64_t staleMessagesDropped = 0;  // In a late packet, but already superseded
+    uint64_t resyncs = 0;               // Sender restarts or sequence jumps
+    double jitterMs = 0.0;              // RFC 3550 interarrival jitter, from the timetags
+    size_t streams = 0;
+
+    double lossRate() const {
+        uint64_t expected = packetsReceived + packetsLost;
+        return expected ? double(packetsLost) / double(expected) : 0.0;
+    }
+};
+
+/**
+ * @brief Sender side: frames bundles and applies the redundancy
+ *
+ * Not thread-safe; the owner serialises calls.
+ */
+class Encoder {
+public:
+    Encoder();
+    explicit Encoder(const Config& config);
+
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return config_; }
+    uint32_t nextSequence() const { return sequence_; }
+
+    // Starts the next bundle in out: header, timetag and the sequence element.
+    // Append the payload with the OSCPacket bundle functions, then finish().
+    void begin(std::vector<uint8_t>& out, uint64_t timetag);
+    // Hands emit the packets to send for the bundle: once, twice, or once plus
+    // a parity packet at the end of a group. True if every emit succeeded.
+    bool finish(const std::vector<uint8_t>& bundle, const std::function<bool(const uint8_t*, size_t)>& emit);
+
+private:
+    Config config_;
+    uint32_t sequence_ = 0;
+    uint32_t groupFirst_ = 0;
+    size_t groupCount_ = 0;
+    std::vector<uint8_t> parity_;
+    std::vector<uint8_t> parityPacket_;
+};
+
+/**
+ * @brief Receiver side: places packets in sequence and delivers their messages
+ *
+ * process() is called from the one thread that receives the packets;
+ * getStats() may be called from any thread.
+ *
+ * A reordered or rebuilt packet arrives after newer values may have been
+ * delivered. Its messages are delivered only for addresses that no newer
+ * packet has carried, so a late CV value never overwrites a current one
+ * while a trigger that was only in the lost packet still gets through.
+ */
+class Decoder {
+public:
+    using MessageHandler = std::function<void(const OSCPacket::Message&)>;
+
+    static constexpr size_t kWindow = 256;     // Sequences tracked behind the newest
+    static constexpr size_t kHistory = 64;     // Packets kept for parity recovery
+
+    // True if this is a stream bundle or parity packet (quick header check only)
+    static bool isStreamPacket(const uint8_t* data, size_t size);
+
+    // Handles a stream packet, calling deliver for each payload message to pass
+    // on. arrivalTimetag is the receive time as an NTP timetag, for jitter.
+    // False if the packet is not a well-formed stream packet.
+    bool process(const uint8_t* data, size_t size, uint64_t arrivalTimetag, const MessageHandler& deliver);
+
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    struct Stored {
+        uint32_t sequence = 0;
+        bool valid = false;
+        std::vector<uint8_t> bytes;
+    };
+
+    struct Stream {
+        bool started = false;
+        uint32_t highest = 0;
+        std::array<uint64_t, kWindow / 64> received{};   // Bit per sequence, by sequence % kWindow
+        std::vector<Stored> history;                     // By sequence % kHistory
+        std::unordered_map<std::string, uint32_t> lastSequence;   // Per address
+        uint32_t oldRun = 0;                             // Consecutive packets too old to place
+        uint32_t oldNext = 0;
+        double lastTransitMs = 0.0;
+        bool haveTransit = false;
+        Stats stats;
+    };
+
+    std::unordered_map<uint32_t, Stream> streams_;
+    mutable std::mutex statsMutex_;
+    Stats published_;   // Totals as of the last process(), for getStats()
+    Stats baseline_;    // Subtracted after resetStats()
+
+    bool processData(Stream& stream, const uint8_t* data, size_t size, uint64_t arrivalTimetag,
+                     bool recovered, const MessageHandler& deliver);
+    void processParity(Stream& stream, uint32_t streamId, uint32_t first, uint32_t count, std::string_view parity,
+                       uint64_t arrivalTimetag, const MessageHandler& deliver);
+    void deliverMessages(Stream& stream, uint32_t sequence, bool late, const uint8_t* data, size_t size,
+                         const MessageHandler& deliver);
+    void publish();
+};
+
+} // namespace OSCStream
@@ -1,15 +1,69 @@
 #include "OSCTCPTransport.h"
-#include <iostream>
-#include <sstream>
-#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
-OSCTCPTransport::OSCTCPTransport() 
-    : target_(nullptr)
+namespace {
+
+// SLIP special bytes (RFC 1055)
+constexpr uint8_t kSlipEnd = 0xC0;
+constexpr uint8_t kSlipEsc = 0xDB;
+constexpr uint8_t kSlipEscEnd = 0xDC;
+constexpr uint8_t kSlipEscEsc = 0xDD;
+
+// Frames written per sendmsg()
+constexpr size_t kMaxIov = 64;
+constexpr size_t kMaxSpareFrames = 64;
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;   // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+void appendFrame(std::vector<uint8_t>& frame, OSCTCPTransport::Framing framing, const uint8_t* data, size_t size) {
+    if (framing == OSCTCPTransport::Framing::LENGTH_PREFIX) {
+        frame.resize(4 + size);
+        frame[0] = static_cast<uint8_t>(size >> 24);
+        frame[1] = static_cast<uint8_t>(size >> 16);
+        frame[2] = static_cast<uint8_t>(size >> 8);
+        frame[3] = static_cast<uint8_t>(size);
+        std::memcpy(frame.data() + 4, data, size);
+        return;
+    }
+    // Double-END: a leading END flushes any line noise before the packet
+    frame.reserve(size + size / 8 + 2);
+    frame.push_back(kSlipEnd);
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] == kSlipEnd) {
+            frame.push_back(kSlipEsc);
+            frame.push_back(kSlipEscEnd);
+        } else if (data[i] == kSlipEsc) {
+            frame.push_back(kSlipEsc);
+            frame.push_back(kSlipEscEsc);
+        } else {
+            frame.push_back(data[i]);
+        }
+    }
+    frame.push_back(kSlipEnd);
+}
+
+} // namespace
+
+OSCTCPTransport::OSCTCPTransport() : OSCTCPTransport(OSCEventLoop::shared()) {}
+
+OSCTCPTransport::OSCTCPTransport(OSCEventLoop& loop)
+    : loop_(loop)
     , connected_(false)
     , autoReconnect_(false)
     , connectionTimeout_(5)
-    , reconnectDelay_(5)
-    , stopReconnect_(false) {
+    , reconnectDelay_(5) {
 }
 
 OSCTCPTransport::~OSCTCPTransport() {
@@ -17,50 +71,72 @@ OSCTCPTransport::~OSCTCPTransport() {
 }
 
 bool OSCTCPTransport::connect(const std::string& host, const std::string& port) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (target_) {
-        lo_address_free(target_);
-        target_ = nullptr;
+    disconnect();
+
+    // Resolve on the caller's thread; the loop thread never blocks on DNS
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* results = nullptr;
+    int rc = getaddrinfo(host.c_str(), port.c_str(), &hints, &results);
+    if (rc != 0) {
+        reportTransportError("Failed to resolve TCP OSC target " + host + ":" + port + ": " + gai_strerror(rc));
+        return false;
     }
-    
+    addresses_.clear();
+    for (addrinfo* info = results; info; info = info->ai_next) {
+        sockaddr_storage address{};
+        std::memcpy(&address, info->ai_addr, info->ai_addrlen);
+        addresses_.emplace_back(address, static_cast<socklen_t>(info->ai_addrlen));
+    }
+    freeaddrinfo(results);
+
     host_ = host;
     port_ = port;
-    
-    // Stop any existing reconnect thread
-    stopReconnectThread();
-    
-    // Attempt connection
-    if (establishConnection()) {
-        connected_ = true;
-        
-        // Start reconnect thread if auto-reconnect is enabled
-        if (autoReconnect_) {
-            stopReconnect_ = false;
-            reconnectThread_ = std::thread(&OSCTCPTransport::reconnectLoop, this);
-        }
-        
-        return true;
+    addressIndex_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(connectMutex_);
+        connectFailed_ = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        active_ = true;
     }
-    
-    return false;
+    loop_.post([this] { startConnect(); });
+
+    // Every address gets its own timeout before connect() gives up
+    auto timeout = std::chrono::seconds(connectionTimeout_.load()) * addresses_.size() + std::chrono::seconds(1);
+    std::unique_lock<std::mutex> lock(connectMutex_);
+    connectCv_.wait_for(lock, timeout, [this] { return connected_.load() || connectFailed_; });
+    return connected_;
 }
 
 bool OSCTCPTransport::disconnect() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Stop reconnect thread
-    stopReconnectThread();
-    
-    if (target_) {
-        lo_address_free(target_);
-        target_ = nullptr;
-    }
-    
+    {
+        // Senders check active_ under this lock, so none can queue work after teardown
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        active_ = false;
+    }
+    loop_.runSync([this] {
+        if (reconnectTimer_) {
+            loop_.cancelTimer(reconnectTimer_);
+            reconnectTimer_ = 0;
+        }
+        closeSocket();
+        sending_.clear();
+    });
+    connected_ = false;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queue_.clear();
+        queuedBytes_ = 0;
+        queuedFrames_ = 0;
+        flushScheduled_ = false;
+    }
+    setBackpressure(false);
     host_.clear();
     port_.clear();
-    connected_ = false;
-    
     return true;
 }
 
@@ -68,209 +144,383 @@ bool OSCTCPTransport::isConnected() const {
     return connected_.load();
 }
 
-bool OSCTCPTransport::sendMessage(const std::string& address, void* msg) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_ || !connected_) {
-        reportError("Not connected");
-        return false;
+void OSCTCPTransport::startConnect() {
+    if (!active_ || state_ != State::DISCONNECTED) {
+        return;
     }
-    
-    lo_message message = static_cast<lo_message>(msg);
-    int result = lo_send_message(target_, address.c_str(), message);
-    
-    if (result < 0) {
-        connected_ = false;
-        reportError("Failed to send message to " + address + " - connection lost");
-        return false;
+    if (addresses_.empty()) {
+        onFailure("No address for TCP OSC target " + host_ + ":" + port_);
+        return;
     }
-    
-    return true;
+
+    const auto& [address, length] = addresses_[addressIndex_ % addresses_.size()];
+    fd_ = socket(address.ss_family, SOCK_STREAM, 0);
+    if (fd_ < 0) {
+        onFailure(std::string("Failed to create TCP socket: ") + std::strerror(errno));
+        return;
+    }
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK);
+    fcntl(fd_, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd_, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    applySocketOptions();
+
+    int rc = ::connect(fd_, reinterpret_cast<const sockaddr*>(&address), length);
+    if (rc < 0 && errno != EINPROGRESS) {
+        onFailure("Failed to establish TCP connection to " + host_ + ":" + port_ + ": " + std::strerror(errno));
+        return;
+    }
+    state_ = State::CONNECTING;
+    loop_.add(fd_, OSCEventLoop::Writable, [this](uint32_t events) { handleEvents(events); });
+    if (rc == 0) {
+        onConnected();
+        return;
+    }
+    connectTimer_ = loop_.runAfter(std::chrono::seconds(connectionTimeout_.load()), [this] {
+        connectTimer_ = 0;
+        if (state_ == State::CONNECTING) {
+            onFailure("TCP connection to " + host_ + ":" + port_ + " timed out");
+        }
+    });
 }
 
-bool OSCTCPTransport::sendBundle(void* bundle) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_ || !connected_) {
-        reportError("Not connected");
-        return false;
+void OSCTCPTransport::onConnectReady() {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(fd_, SOL_SOCKET, SO_ERROR, &error, &length) < 0) {
+        error = errno;
     }
-    
-    lo_bundle bndl = static_cast<lo_bundle>(bundle);
-    int result = lo_send_bundle(target_, bndl);
-    
-    if (result < 0) {
-        connected_ = false;
-        reportError("Failed to send bundle - connection lost");
-        return false;
+    if (error != 0) {
+        onFailure("Failed to establish TCP connection to " + host_ + ":" + port_ + ": " + std::strerror(error));
+        return;
     }
-    
-    return true;
+    onConnected();
 }
 
-bool OSCTCPTransport::establishConnection() {
-    // Create TCP address with protocol specifier
-    std::string tcp_url = "osc.tcp://" + host_ + ":" + port_;
-    target_ = lo_address_new_from_url(tcp_url.c_str());
-    
-    if (!target_) {
-        std::stringstream ss;
-        ss << "Failed to create TCP OSC target: " << host_ << ":" << port_;
-        reportError(ss.str());
-        return false;
+void OSCTCPTransport::onConnected() {
+    if (connectTimer_) {
+        loop_.cancelTimer(connectTimer_);
+        connectTimer_ = 0;
     }
-    
-    // TCP protocol is already set by the URL format
-    
-    // Test connection by sending a ping message
-    int result = lo_send(target_, "/ping", "s", "cv_to_osc_tcp_test");
-    
-    if (result < 0) {
-        std::stringstream ss;
-        ss << "Failed to establish TCP connection to " << host_ << ":" << port_;
-        reportError(ss.str());
-        lo_address_free(target_);
-        target_ = nullptr;
-        return false;
+    state_ = State::CONNECTED;
+    writeInterest_ = false;
+    loop_.modify(fd_, OSCEventLoop::Readable);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (everConnected_) {
+            stats_.reconnects++;
+        }
     }
-    
-    return true;
+    everConnected_ = true;
+    {
+        std::lock_guard<std::mutex> lock(connectMutex_);
+        connected_ = true;
+    }
+    connectCv_.notify_all();
+    flush();   // Anything queued while disconnected
 }
 
-void OSCTCPTransport::reconnectLoop() {
-    while (!stopReconnect_) {
-        if (!connected_) {
-            std::cout << "Attempting TCP reconnection to " << host_ << ":" << port_ << std::endl;
-            
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                if (establishConnection()) {
-                    connected_ = true;
-                    std::cout << "TCP reconnection successful" << std::endl;
-                }
+void OSCTCPTransport::onFailure(const std::string& reason) {
+    const bool wasConnecting = state_ == State::CONNECTING || fd_ < 0;
+    closeSocket();
+    connected_ = false;
+    reportTransportError(reason);
+    if (!active_) {
+        return;
+    }
+
+    if (wasConnecting && !addresses_.empty() && ++addressIndex_ % addresses_.size() != 0) {
+        startConnect();   // Try the host's next address before giving up on this round
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(connectMutex_);
+        connectFailed_ = true;
+    }
+    connectCv_.notify_all();
+    if (autoReconnect_ && !reconnectTimer_) {
+        reconnectTimer_ = loop_.runAfter(std::chrono::seconds(reconnectDelay_.load()), [this] {
+            reconnectTimer_ = 0;
+            startConnect();
+        });
+    }
+}
+
+void OSCTCPTransport::closeSocket() {
+    if (connectTimer_) {
+        loop_.cancelTimer(connectTimer_);
+        connectTimer_ = 0;
+    }
+    if (fd_ >= 0) {
+        loop_.remove(fd_);
+        close(fd_);
+        fd_ = -1;
+    }
+    state_ = State::DISCONNECTED;
+    writeInterest_ = false;
+
+    // A partly written frame is resent whole on the next connection
+    headOffset_ = 0;
+}
+
+void OSCTCPTransport::applySocketOptions() {
+    if (fd_ < 0) {
+        return;
+    }
+    int noDelay = noDelay_ ? 1 : 0;
+    setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    int keepAlive = keepAlive_ ? 1 : 0;
+    setsockopt(fd_, SOL_SOCKET, SO_KEEPALIVE, &keepAlive, sizeof(keepAlive));
+}
+
+void OSCTCPTransport::handleEvents(uint32_t events) {
+    if (state_ == State::CONNECTING) {
+        onConnectReady();
+        return;
+    }
+    if (events & OSCEventLoop::Readable) {
+        // Peers may answer; we only need to notice errors and EOF
+        uint8_t buffer[4096];
+        for (;;) {
+            ssize_t received = recv(fd_, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                continue;
+            }
+            if (received == 0) {
+                onFailure("TCP connection to " + host_ + ":" + port_ + " closed by peer");
+                return;
             }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                onFailure("TCP connection to " + host_ + ":" + port_ + " lost: " + std::strerror(errno));
+                return;
+            }
+            break;
         }
-        
-        // Wait before next reconnect attempt
-        std::this_thread::sleep_for(std::chrono::seconds(reconnectDelay_));
+    }
+    if (events & OSCEventLoop::Writable) {
+        flush();
     }
 }
 
-void OSCTCPTransport::stopReconnectThread() {
-    stopReconnect_ = true;
-    if (reconnectThread_.joinable()) {
-        reconnectThread_.join();
+void OSCTCPTransport::flush() {
+    {
+        // Take everything queued so far; senders keep appending to queue_ while this writes
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        flushScheduled_ = false;
+        if (state_ != State::CONNECTED) {
+            return;
+        }
+        if (sending_.empty()) {
+            sending_.swap(queue_);
+        } else {
+            std::move(queue_.begin(), queue_.end(), std::back_inserter(sending_));
+            queue_.clear();
+        }
+    }
+
+    size_t bytesFreed = 0;
+    uint64_t framesSent = 0;
+    uint64_t bytesSent = 0;
+    uint64_t writeCalls = 0;
+    std::string failure;
+    bool blocked = false;
+    while (!sending_.empty()) {
+        iovec iov[kMaxIov];
+        size_t count = 0;
+        for (auto it = sending_.begin(); it != sending_.end() && count < kMaxIov; ++it, ++count) {
+            size_t offset = count == 0 ? headOffset_ : 0;
+            iov[count].iov_base = it->data() + offset;
+            iov[count].iov_len = it->size() - offset;
+        }
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = count;
+        ssize_t written = sendmsg(fd_, &message, kSendFlags);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                blocked = true;
+            } else {
+                failure = "TCP send to " + host_ + ":" + port_ + " failed: " + std::strerror(errno);
+            }
+            break;
+        }
+
+        writeCalls++;
+        bytesSent += static_cast<uint64_t>(written);
+        size_t remaining = static_cast<size_t>(written);
+        while (remaining > 0) {
+            auto& front = sending_.front();
+            size_t left = front.size() - headOffset_;
+            if (remaining < left) {
+                headOffset_ += remaining;
+                break;
+            }
+            remaining -= left;
+            bytesFreed += front.size();
+            if (sentFrames_.size() < kMaxSpareFrames) {
+                sentFrames_.push_back(std::move(front));
+            }
+            sending_.pop_front();
+            headOffset_ = 0;
+            framesSent++;
+        }
+    }
+
+    bool release = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queuedBytes_ -= bytesFreed;
+        queuedFrames_ -= framesSent;
+        stats_.writeCalls += writeCalls;
+        stats_.bytesSent += bytesSent;
+        stats_.framesSent += framesSent;
+        for (auto& frame : sentFrames_) {
+            if (spareFrames_.size() >= kMaxSpareFrames) {
+                break;
+            }
+            spareFrames_.push_back(std::move(frame));
+        }
+        release = backpressured_ && queuedBytes_ <= maxQueueBytes_ / 4;
+    }
+    sentFrames_.clear();
+    if (release) {
+        setBackpressure(false);
+    }
+
+    if (!failure.empty()) {
+        onFailure(failure);
+        return;
+    }
+    updateWriteInterest(blocked);   // Resume when the socket drains
+    if (!blocked) {
+        sampleRoundTrip();
     }
 }
 
-bool OSCTCPTransport::sendMessage(const std::string& address, const std::vector<float>& values) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_ || !connected_) {
-        reportError("TCP transport not connected");
-        return false;
+void OSCTCPTransport::updateWriteInterest(bool wanted) {
+    if (writeInterest_ != wanted && fd_ >= 0) {
+        writeInterest_ = wanted;
+        loop_.modify(fd_, wanted ? OSCEventLoop::Readable | OSCEventLoop::Writable : uint32_t(OSCEventLoop::Readable));
     }
-    
-    if (values.empty()) {
-        int result = lo_send(target_, address.c_str(), "");
-        if (result < 0) {
-            connected_ = false;
-            reportError("TCP connection lost");
-            return false;
+}
+
+bool OSCTCPTransport::enqueueFrame(const uint8_t* data, size_t size) {
+    bool usable = false;
+    bool accepted = false;
+    bool pressure = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        usable = active_ && (connected_ || autoReconnect_);   // Queue while a reconnect is pending
+        if (usable) {
+            std::vector<uint8_t> frame;
+            if (!spareFrames_.empty()) {
+                frame = std::move(spareFrames_.back());
+                spareFrames_.pop_back();
+                frame.clear();
+            }
+            appendFrame(frame, framing_, data, size);
+
+            if (queuedBytes_ + frame.size() > maxQueueBytes_) {
+                stats_.framesDropped++;
+                spareFrames_.push_back(std::move(frame));
+                pressure = true;
+            } else {
+                queuedBytes_ += frame.size();
+                queuedFrames_++;
+                queue_.push_back(std::move(frame));
+                accepted = true;
+                pressure = queuedBytes_ >= maxQueueBytes_ / 2;
+                // One flush per burst: everything queued before it runs goes out in one write.
+                // Posted under the lock so disconnect() cannot tear down ahead of it.
+                if (connected_ && !flushScheduled_) {
+                    flushScheduled_ = true;
+                    loop_.post([this] { flush(); });
+                }
+            }
         }
-        return true;
     }
-    
-    // Create message
+
+    if (!usable) {
+        lastSendErrno_ = ENOTCONN;
+        reportTransportError("TCP transport not connected");
+        return false;
+    }
+    if (pressure && !backpressured_) {
+        setBackpressure(true);
+    }
+    if (!accepted) {
+        lastSendErrno_ = ENOBUFS;
+        reportTransportError("TCP send queue to " + host_ + ":" + port_ + " is full");
+        return false;
+    }
+    lastSendErrno_ = 0;
+    return true;
+}
+
+bool OSCTCPTransport::sendPacket(const void* data, size_t size) {
+    return enqueueFrame(static_cast<const uint8_t*>(data), size);
+}
+
+bool OSCTCPTransport::sendLoMessage(const std::string& address, lo_message message) {
+    thread_local std::vector<uint8_t> buffer;
+    size_t size = lo_message_length(message, address.c_str());
+    buffer.resize(size);
+    lo_message_serialise(message, address.c_str(), buffer.data(), &size);
+    return enqueueFrame(buffer.data(), size);
+}
+
+bool OSCTCPTransport::sendMessage(const std::string& address, void* msg) {
+    return sendLoMessage(address, static_cast<lo_message>(msg));
+}
+
+bool OSCTCPTransport::sendBundle(void* bundle) {
+    thread_local std::vector<uint8_t> buffer;
+    lo_bundle bndl = static_cast<lo_bundle>(bundle);
+    size_t size = lo_bundle_length(bndl);
+    buffer.resize(size);
+    lo_bundle_serialise(bndl, buffer.data(), &size);
+    return enqueueFrame(buffer.data(), size);
+}
+
+bool OSCTCPTransport::sendMessage(const std::string& address, const std::vector<float>& values) {
     lo_message msg = lo_message_new();
     for (float value : values) {
         lo_message_add_float(msg, value);
     }
-    
-    int result = lo_send_message(target_, address.c_str(), msg);
+    bool result = sendLoMessage(address, msg);
     lo_message_free(msg);
-    
-    if (result < 0) {
-        connected_ = false;
-        std::stringstream ss;
-        ss << "Failed to send TCP message to " << address << " - connection lost";
-        reportError(ss.str());
-        return false;
-    }
-    
-    return true;
+    return result;
 }
 
 bool OSCTCPTransport::sendMessage(const std::string& address, const std::vector<int>& values) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_ || !connected_) {
-        reportError("TCP transport not connected");
-        return false;
-    }
-    
-    if (values.empty()) {
-        int result = lo_send(target_, address.c_str(), "");
-        if (result < 0) {
-            connected_ = false;
-            reportError("TCP connection lost");
-            return false;
-        }
-        return true;
-    }
-    
-    // Create message
     lo_message msg = lo_message_new();
     for (int value : values) {
         lo_message_add_int32(msg, value);
     }
-    
-    int result = lo_send_message(target_, address.c_str(), msg);
+    bool result = sendLoMessage(address, msg);
     lo_message_free(msg);
-    
-    if (result < 0) {
-        connected_ = false;
-        std::stringstream ss;
-        ss << "Failed to send TCP message to " << address << " - connection lost";
-        reportError(ss.str());
-        return false;
-    }
-    
-    return true;
+    return result;
 }
 
 bool OSCTCPTransport::sendMessage(const std::string& address, const std::string& value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_ || !connected_) {
-        reportError("TCP transport not connected");
-        return false;
-    }
-    
-    int result = lo_send(target_, address.c_str(), "s", value.c_str());
-    
-    if (result < 0) {
-        connected_ = false;
-        std::stringstream ss;
-        ss << "Failed to send TCP message to " << address << " - connection lost";
-        reportError(ss.str());
-        return false;
-    }
-    
-    return true;
+    lo_message msg = lo_message_new();
+    lo_message_add_string(msg, value.c_str());
+    bool result = sendLoMessage(address, msg);
+    lo_message_free(msg);
+    return result;
 }
 
 bool OSCTCPTransport::sendBundle(const std::vector<std::pair<std::string, std::vector<float>>>& messages) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_ || !connected_) {
-        reportError("TCP transport not connected");
-        return false;
-    }
-    
-    // Create bundle
     lo_bundle bundle = lo_bundle_new(LO_TT_IMMEDIATE);
-    
+
     for (const auto& [address, values] : messages) {
         lo_message msg = lo_message_new();
         for (float value : values) {
@@ -278,31 +528,20 @@ bool OSCTCPTransport::sendBundle(const std::vector<std::pair<std::string, std::v
         }
         lo_bundle_add_message(bundle, address.c_str(), msg);
     }
-    
-    int result = lo_send_bundle(target_, bundle);
+
+    bool result = sendBundle(static_cast<void*>(bundle));
     lo_bundle_free_recursive(bundle);
-    
-    if (result < 0) {
-        connected_ = false;
-        reportError("Failed to send TCP bundle - connection lost");
-        return false;
-    }
-    
-    return true;
+    return result;
 }
 
 void OSCTCPTransport::setKeepAlive(bool enable) {
-    // TCP keep-alive would be set on the socket level
-    // This requires access to the underlying socket which liblo doesn't expose directly
-    // For now, we'll document this as a future enhancement
-    (void)enable; // Suppress unused parameter warning
+    keepAlive_ = enable;
+    loop_.post([this] { applySocketOptions(); });
 }
 
 void OSCTCPTransport::setNoDelay(bool enable) {
-    // TCP_NODELAY would be set on the socket level
-    // This requires access to the underlying socket which liblo doesn't expose directly
-    // For now, we'll document this as a future enhancement
-    (void)enable; // Suppress unused parameter warning
+    noDelay_ = enable;
+    loop_.post([this] { applySocketOptions(); });
 }
 
 void OSCTCPTransport::setConnectionTimeout(int seconds) {
@@ -315,16 +554,78 @@ void OSCTCPTransport::setReconnectDelay(int seconds) {
 
 void OSCTCPTransport::setAutoReconnect(bool enable) {
     autoReconnect_ = enable;
-    
-    if (enable && connected_ && !reconnectThread_.joinable()) {
-        stopReconnect_ = false;
-        reconnectThread_ = std::thread(&OSCTCPTransport::reconnectLoop, this);
-    } else if (!enable) {
-        stopReconnectThread();
+    loop_.post([this, enable] {
+        if (!enable && reconnectTimer_) {
+            loop_.cancelTimer(reconnectTimer_);
+            reconnectTimer_ = 0;
+        } else if (enable && !reconnectTimer_) {
+            startConnect();   // No-op unless connected() was called and the link is down
+        }
+    });
+}
+
+void OSCTCPTransport::setMaxQueueBytes(size_t bytes) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    maxQueueBytes_ = bytes;
+}
+
+void OSCTCPTransport::setBackpressureCallback(std::function<void(bool)> callback) {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    backpressureCallback_ = callback;
+}
+
+// Loop thread, after each flush: the kernel's smoothed RTT for the connection
+void OSCTCPTransport::sampleRoundTrip() {
+#if defined(__linux__)
+    tcp_info info{};
+    socklen_t length = sizeof(info);
+    if (getsockopt(fd_, IPPROTO_TCP, TCP_INFO, &info, &length) == 0 && info.tcpi_rtt > 0) {
+        roundTripMs_ = info.tcpi_rtt / 1000.0;
+    }
+#elif defined(TCP_CONNECTION_INFO)
+    tcp_connection_info info{};
+    socklen_t length = sizeof(info);
+    if (getsockopt(fd_, IPPROTO_TCP, TCP_CONNECTION_INFO, &info, &length) == 0 && info.tcpi_srtt > 0) {
+        roundTripMs_ = static_cast<double>(info.tcpi_srtt);
+    }
+#endif
+}
+
+size_t OSCTCPTransport::getQueuedBytes() const {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    return queuedBytes_;
+}
+
+OSCTCPTransport::QueueStats OSCTCPTransport::getQueueStats() const {
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    QueueStats stats = stats_;
+    stats.queuedBytes = queuedBytes_;
+    stats.queuedFrames = queuedFrames_;
+    return stats;
+}
+
+void OSCTCPTransport::setBackpressure(bool on) {
+    if (backpressured_.exchange(on) == on) {
+        return;
+    }
+    std::function<void(bool)> callback;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        callback = backpressureCallback_;
+    }
+    if (callback) {
+        callback(on);
     }
 }
 
-void OSCTCPTransport::errorHandler(int num, const char* msg, const char* path) {
-    std::cerr << "OSC TCP Error " << num << " in path " << (path ? path : "unknown") 
-              << ": " << (msg ? msg : "unknown error") << std::endl;
+void OSCTCPTransport::reportTransportError(const std::string& error) {
+    std::function<void(const std::string&)> callback;
+    {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        lastError_ = error;
+        callback = errorCallback_;
+    }
+    if (callback) {
+        callback(error);
+    }
 }
@@ -1,17 +1,46 @@
 #pragma once
 
 #include "OSCTransport.h"
+#include "OSCEventLoop.h"
 #include <lo/lo.h>
 #include <mutex>
-#include <thread>
+#include <condition_variable>
+#include <deque>
 #include <atomic>
+#include <sys/socket.h>
 
 /**
  * @brief TCP transport implementation for OSC
+ *
+ * A native nonblocking socket driven by the shared OSCEventLoop. Senders
+ * only encode and frame the packet into a bounded queue; the loop thread
+ * writes everything queued with one sendmsg() per wakeup, so a burst of
+ * messages leaves as few segments as the peer allows. A slow peer fills its
+ * own queue and then sends fail fast (and isBackpressured() turns on); it
+ * never blocks the caller or other transports. Reconnects are timers on the
+ * loop rather than a thread per connection.
  */
 class OSCTCPTransport : public OSCTransport {
 public:
+    // OSC 1.0 streams use a 4-byte big-endian size prefix (what liblo speaks);
+    // OSC 1.1 uses double-END SLIP (RFC 1055) framing
+    enum class Framing {
+        LENGTH_PREFIX,
+        SLIP
+    };
+
+    struct QueueStats {
+        size_t queuedBytes = 0;
+        size_t queuedFrames = 0;
+        uint64_t framesSent = 0;
+        uint64_t bytesSent = 0;
+        uint64_t framesDropped = 0;
+        uint64_t writeCalls = 0;     // framesSent / writeCalls is the coalescing factor
+        uint64_t reconnects = 0;
+    };
+
     OSCTCPTransport();
+    explicit OSCTCPTransport(OSCEventLoop& loop);
     ~OSCTCPTransport() override;
 
     // Connection management
@@ -22,20 +51,29 @@ public:
     // Sending methods for liblo integration
     bool sendMessage(const std::string& address, void* msg) override;
     bool sendBundle(void* bundle) override;
-    
+
     // High-level sending methods
     bool sendMessage(const std::string& address, const std::vector<float>& values) override;
     bool sendMessage(const std::string& address, const std::vector<int>& values) override;
     bool sendMessage(const std::string& address, const std::string& value) override;
     bool sendBundle(const std::vector<std::pair<std::string, std::vector<float>>>& messages) override;
+    // Queue an already encoded OSC packet
+    bool sendPacket(const void* data, size_t size);
 
     // Protocol information
     Protocol getProtocol() const override { return Protocol::TCP; }
     std::string getProtocolName() const override { return "TCP"; }
+    bool isBackpressured() const override { return backpressured_.load(); }
+    size_t getQueuedBytes() const override;
+    double getRoundTripMs() const override { return roundTripMs_.load(); }
 
     // Error handling
-    std::string getLastError() const override { return lastError_; }
+    std::string getLastError() const override {
+        std::lock_guard<std::mutex> lock(errorMutex_);
+        return lastError_;
+    }
     void setErrorCallback(std::function<void(const std::string&)> callback) override {
+        std::lock_guard<std::mutex> lock(errorMutex_);
         errorCallback_ = callback;
     }
 
@@ -45,25 +83,83 @@ public:
     void setConnectionTimeout(int seconds);
     void setReconnectDelay(int seconds);
     void setAutoReconnect(bool enable);
+    void setFraming(Framing framing) { framing_ = framing; }
+    Framing getFraming() const { return framing_; }
+    // Queue bound; sends fail once it is full. Backpressure turns on at half and off at a quarter.
+    void setMaxQueueBytes(size_t bytes);
+    // Called on the loop thread (or the sending thread) when backpressure turns on or off
+    void setBackpressureCallback(std::function<void(bool)> callback);
+
+    QueueStats getQueueStats() const;
 
 private:
-    lo_address target_;
+    enum class State {
+        DISCONNECTED,
+        CONNECTING,
+        CONNECTED
+    };
+
+    OSCEventLoop& loop_;
     std::string host_;
     std::string port_;
-    mutable std::mutex mutex_;
-    
+    std::vector<std::pair<sockaddr_storage, socklen_t>> addresses_;
+    size_t addressIndex_ = 0;
+    std::atomic<Framing> framing_{Framing::LENGTH_PREFIX};
+
+    // Socket state: only touched on the loop thread
+    int fd_ = -1;
+    State state_ = State::DISCONNECTED;
+    OSCEventLoop::TimerId connectTimer_ = 0;
+    OSCEventLoop::TimerId reconnectTimer_ = 0;
+    bool writeInterest_ = false;
+    bool everConnected_ = false;
+
     // TCP-specific state
     std::atomic<bool> connected_;
     std::atomic<bool> autoReconnect_;
-    int connectionTimeout_;
-    int reconnectDelay_;
-    std::thread reconnectThread_;
-    std::atomic<bool> stopReconnect_;
-    
-    // Connection management
-    bool establishConnection();
-    void reconnectLoop();
-    void stopReconnectThread();
-    
-    static void errorHandler(int num, const char* msg, const char* path);
+    std::atomic<bool> keepAlive_{false};
+    std::atomic<bool> noDelay_{true};
+    std::atomic<int> connectionTimeout_;
+    std::atomic<int> reconnectDelay_;
+    std::atomic<bool> active_{false};           // Between connect() and disconnect()
+    std::mutex connectMutex_;
+    bool connectFailed_ = false;                // Every address failed this round
+    std::condition_variable connectCv_;
+
+    // Send queue, shared between senders and the loop thread
+    mutable std::mutex queueMutex_;
+    std::deque<std::vector<uint8_t>> queue_;
+    std::vector<std::vector<uint8_t>> spareFrames_;
+    size_t queuedBytes_ = 0;                    // Both queues, until written
+    size_t queuedFrames_ = 0;
+    size_t maxQueueBytes_ = 1 << 20;
+    bool flushScheduled_ = false;
+    QueueStats stats_;
+    std::atomic<bool> backpressured_{false};
+    std::atomic<double> roundTripMs_{-1.0};
+    std::function<void(bool)> backpressureCallback_;
+    // Frames being written, loop thread only; flush() swaps queue_ in and sends without the lock
+    std::deque<std::vector<uint8_t>> sending_;
+    size_t headOffset_ = 0;                     // Bytes of the front frame already written
+    std::vector<std::vector<uint8_t>> sentFrames_;   // Written this flush, handed back to spareFrames_
+
+    mutable std::mutex errorMutex_;
+
+    // Connection management (loop thread)
+    void startConnect();
+    void onConnectReady();
+    void onConnected();
+    void onFailure(const std::string& reason);
+    void closeSocket();
+    void applySocketOptions();
+    void handleEvents(uint32_t events);
+    void flush();
+    void updateWriteInterest(bool wanted);
+    void sampleRoundTrip();
+
+    // Framing and queueing (any thread)
+    bool enqueueFrame(const uint8_t* data, size_t size);
+    bool sendLoMessage(const std::string& address, lo_message message);
+    void setBackpressure(bool on);
+    void reportTransportError(const std::string& error);
 };
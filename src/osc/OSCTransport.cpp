@@ -1,6 +1,13 @@
 #include "OSCTransport.h"
 #include "OSCUDPTransport.h"
 #include "OSCTCPTransport.h"
+#include "OSCMulticastTransport.h"
+#include "OSCSharedMemoryTransport.h"
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#if defined(__linux__)
+#include <linux/sockios.h>
+#endif
 
 std::unique_ptr<OSCTransport> OSCTransportFactory::create(OSCTransport::Protocol protocol) {
     switch (protocol) {
@@ -11,12 +18,11 @@ std::unique_ptr<OSCTransport> OSCTransportFactory::create(OSCTransport::Protocol
             return std::make_unique<OSCTCPTransport>();
             
         case OSCTransport::Protocol::MULTICAST:
-            // TODO: Implement multicast transport
-            return nullptr;
-            
         case OSCTransport::Protocol::BROADCAST:
-            // TODO: Implement broadcast transport
-            return nullptr;
+            return std::make_unique<OSCMulticastTransport>(protocol);
+            
+        case OSCTransport::Protocol::SHARED_MEMORY:
+            return std::make_unique<OSCSharedMemoryTransport>();
             
         default:
             return nullptr;
@@ -26,7 +32,28 @@ std::unique_ptr<OSCTransport> OSCTransportFactory::create(OSCTransport::Protocol
 std::vector<OSCTransport::Protocol> OSCTransportFactory::getSupportedProtocols() {
     return {
         OSCTransport::Protocol::UDP,
-        OSCTransport::Protocol::TCP
-        // Future: MULTICAST, BROADCAST
+        OSCTransport::Protocol::TCP,
+        OSCTransport::Protocol::MULTICAST,
+        OSCTransport::Protocol::BROADCAST,
+        OSCTransport::Protocol::SHARED_MEMORY
     };
 }
+
+size_t OSCTransport::socketQueuedBytes(int fd) {
+    if (fd < 0) {
+        return 0;
+    }
+#if defined(__linux__)
+    int queued = 0;
+    if (ioctl(fd, SIOCOUTQ, &queued) == 0 && queued > 0) {
+        return static_cast<size_t>(queued);
+    }
+#elif defined(SO_NWRITE)
+    int queued = 0;
+    socklen_t length = sizeof(queued);
+    if (getsockopt(fd, SOL_SOCKET, SO_NWRITE, &queued, &length) == 0 && queued > 0) {
+        return static_cast<size_t>(queued);
+    }
+#endif
+    return 0;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
@@ -14,7 +15,8 @@ public:
         UDP,
         TCP,
         MULTICAST,
-        BROADCAST
+        BROADCAST,
+        SHARED_MEMORY   // Same-host consumers via OSCSharedMemoryReader
     };
 
     virtual ~OSCTransport() = default;
@@ -38,6 +40,16 @@ public:
     virtual Protocol getProtocol() const = 0;
     virtual std::string getProtocolName() const = 0;
 
+    // True while the transport is queueing faster than the peer drains; callers should shed load
+    virtual bool isBackpressured() const { return false; }
+
+    // Congestion feedback for pacing: bytes still waiting to leave (socket send
+    // queue or the transport's own), smoothed RTT in ms (-1 when the protocol
+    // cannot tell), and the errno of the last failed send (0 after a success)
+    virtual size_t getQueuedBytes() const { return 0; }
+    virtual double getRoundTripMs() const { return -1.0; }
+    int getLastSendErrno() const { return lastSendErrno_.load(std::memory_order_relaxed); }
+
     // Error handling
     virtual std::string getLastError() const = 0;
     virtual void setErrorCallback(std::function<void(const std::string&)> callback) = 0;
@@ -45,6 +57,10 @@ public:
 protected:
     std::function<void(const std::string&)> errorCallback_;
     std::string lastError_;
+    std::atomic<int> lastSendErrno_{0};
+
+    // Unsent bytes in a socket's kernel send queue (SIOCOUTQ / SO_NWRITE)
+    static size_t socketQueuedBytes(int fd);
 
     void reportError(const std::string& error) {
         lastError_ = error;
@@ -1,8 +1,13 @@
 #include "OSCUDPTransport.h"
-#include <iostream>
+#include "OSCPacket.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
 #include <sstream>
+#include <unistd.h>
 
-OSCUDPTransport::OSCUDPTransport() : target_(nullptr) {
+OSCUDPTransport::OSCUDPTransport() {
 }
 
 OSCUDPTransport::~OSCUDPTransport() {
@@ -10,25 +15,33 @@ OSCUDPTransport::~OSCUDPTransport() {
 }
 
 bool OSCUDPTransport::connect(const std::string& host, const std::string& port) {
+    disconnect();
     std::lock_guard<std::mutex> lock(mutex_);
     
-    if (target_) {
-        lo_address_free(target_);
-        target_ = nullptr;
-    }
-    
-    host_ = host;
-    port_ = port;
-    
-    // Create UDP address
-    target_ = lo_address_new(host.c_str(), port.c_str());
-    
-    if (!target_) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* results = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &results) != 0 || !results) {
         std::stringstream ss;
         ss << "Failed to create UDP OSC target: " << host << ":" << port;
         reportError(ss.str());
         return false;
     }
+    std::memcpy(&target_, results->ai_addr, results->ai_addrlen);
+    targetLength_ = static_cast<socklen_t>(results->ai_addrlen);
+    freeaddrinfo(results);
+    
+    fd_ = socket(target_.ss_family, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        reportError(std::string("Cannot create UDP socket: ") + std::strerror(errno));
+        return false;
+    }
+    fcntl(fd_, F_SETFD, FD_CLOEXEC);
+    fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK);
+    
+    host_ = host;
+    port_ = port;
     
     return true;
 }
@@ -36,9 +49,9 @@ bool OSCUDPTransport::connect(const std::string& host, const std::string& port)
 bool OSCUDPTransport::disconnect() {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    if (target_) {
-        lo_address_free(target_);
-        target_ = nullptr;
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
     }
     
     host_.clear();
@@ -49,162 +62,95 @@ bool OSCUDPTransport::disconnect() {
 
 bool OSCUDPTransport::isConnected() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return (target_ != nullptr);
+    return fd_ >= 0;
 }
 
-bool OSCUDPTransport::sendMessage(const std::string& address, void* msg) {
+size_t OSCUDPTransport::getQueuedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return socketQueuedBytes(fd_);
+}
+
+bool OSCUDPTransport::sendPacket(const void* data, size_t size) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    if (!target_) {
-        reportError("Not connected");
+    if (fd_ < 0) {
+        lastSendErrno_ = ENOTCONN;
+        reportError("UDP transport not connected");
         return false;
     }
     
-    lo_message message = static_cast<lo_message>(msg);
-    int result = lo_send_message(target_, address.c_str(), message);
+    ssize_t sent;
+    do {
+        sent = sendto(fd_, data, size, 0, reinterpret_cast<const sockaddr*>(&target_), targetLength_);
+    } while (sent < 0 && errno == EINTR);
     
-    if (result == -1) {
-        reportError("Failed to send message to " + address);
+    if (sent < 0) {
+        int error = errno;
+        lastSendErrno_ = error;
+        reportError("Failed to send UDP packet to " + host_ + ":" + port_ + ": " + std::strerror(error));
         return false;
     }
     
+    lastSendErrno_ = 0;
     return true;
 }
 
+bool OSCUDPTransport::sendLoMessage(const std::string& address, lo_message message) {
+    thread_local std::vector<uint8_t> buffer;
+    size_t size = lo_message_length(message, address.c_str());
+    buffer.resize(size);
+    lo_message_serialise(message, address.c_str(), buffer.data(), &size);
+    return sendPacket(buffer.data(), size);
+}
+
+bool OSCUDPTransport::sendMessage(const std::string& address, void* msg) {
+    return sendLoMessage(address, static_cast<lo_message>(msg));
+}
+
 bool OSCUDPTransport::sendBundle(void* bundle) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_) {
-        reportError("Not connected");
-        return false;
-    }
-    
+    thread_local std::vector<uint8_t> buffer;
     lo_bundle bndl = static_cast<lo_bundle>(bundle);
-    int result = lo_send_bundle(target_, bndl);
-    
-    if (result == -1) {
-        reportError("Failed to send bundle");
-        return false;
-    }
-    
-    return true;
+    size_t size = lo_bundle_length(bndl);
+    buffer.resize(size);
+    lo_bundle_serialise(bndl, buffer.data(), &size);
+    return sendPacket(buffer.data(), size);
 }
 
 bool OSCUDPTransport::sendMessage(const std::string& address, const std::vector<float>& values) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_) {
-        reportError("UDP transport not connected");
-        return false;
-    }
-    
-    if (values.empty()) {
-        int result = lo_send(target_, address.c_str(), "");
-        return result >= 0;
-    }
-    
-    // Create message
-    lo_message msg = lo_message_new();
-    for (float value : values) {
-        lo_message_add_float(msg, value);
-    }
-    
-    int result = lo_send_message(target_, address.c_str(), msg);
-    lo_message_free(msg);
-    
-    if (result < 0) {
-        std::stringstream ss;
-        ss << "Failed to send UDP message to " << address;
-        reportError(ss.str());
-        return false;
-    }
-    
-    return true;
+    thread_local std::vector<uint8_t> buffer;
+    buffer.clear();
+    OSCPacket::appendFloatMessage(buffer, address, values.data(), values.size());
+    return sendPacket(buffer.data(), buffer.size());
 }
 
 bool OSCUDPTransport::sendMessage(const std::string& address, const std::vector<int>& values) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_) {
-        reportError("UDP transport not connected");
-        return false;
-    }
-    
-    if (values.empty()) {
-        int result = lo_send(target_, address.c_str(), "");
-        return result >= 0;
-    }
-    
-    // Create message
     lo_message msg = lo_message_new();
     for (int value : values) {
         lo_message_add_int32(msg, value);
     }
     
-    int result = lo_send_message(target_, address.c_str(), msg);
+    bool result = sendLoMessage(address, msg);
     lo_message_free(msg);
     
-    if (result < 0) {
-        std::stringstream ss;
-        ss << "Failed to send UDP message to " << address;
-        reportError(ss.str());
-        return false;
-    }
-    
-    return true;
+    return result;
 }
 
 bool OSCUDPTransport::sendMessage(const std::string& address, const std::string& value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_) {
-        reportError("UDP transport not connected");
-        return false;
-    }
-    
-    int result = lo_send(target_, address.c_str(), "s", value.c_str());
+    lo_message msg = lo_message_new();
+    lo_message_add_string(msg, value.c_str());
     
-    if (result < 0) {
-        std::stringstream ss;
-        ss << "Failed to send UDP message to " << address;
-        reportError(ss.str());
-        return false;
-    }
+    bool result = sendLoMessage(address, msg);
+    lo_message_free(msg);
     
-    return true;
+    return result;
 }
 
 bool OSCUDPTransport::sendBundle(const std::vector<std::pair<std::string, std::vector<float>>>& messages) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!target_) {
-        reportError("UDP transport not connected");
-        return false;
-    }
-    
-    // Create bundle
-    lo_bundle bundle = lo_bundle_new(LO_TT_IMMEDIATE);
-    
+    thread_local std::vector<uint8_t> buffer;
+    buffer.clear();
+    OSCPacket::appendBundleHeader(buffer);
     for (const auto& [address, values] : messages) {
-        lo_message msg = lo_message_new();
-        for (float value : values) {
-            lo_message_add_float(msg, value);
-        }
-        lo_bundle_add_message(bundle, address.c_str(), msg);
+        OSCPacket::appendBundleFloatMessage(buffer, address, values.data(), values.size());
     }
-    
-    int result = lo_send_bundle(target_, bundle);
-    lo_bundle_free_recursive(bundle);
-    
-    if (result < 0) {
-        reportError("Failed to send UDP bundle");
-        return false;
-    }
-    
-    return true;
-}
-
-void OSCUDPTransport::errorHandler(int num, const char* msg, const char* path) {
-    std::cerr << "OSC UDP Error " << num << " in path " << (path ? path : "unknown") 
-              << ": " << (msg ? msg : "unknown error") << std::endl;
+    return sendPacket(buffer.data(), buffer.size());
 }
@@ -3,9 +3,15 @@
 #include "OSCTransport.h"
 #include <lo/lo.h>
 #include <mutex>
+#include <sys/socket.h>
 
 /**
  * @brief UDP transport implementation for OSC
+ *
+ * A native nonblocking datagram socket: when the send buffer or the
+ * interface queue is full the send fails at once with EAGAIN/ENOBUFS
+ * instead of stalling the caller, and getQueuedBytes() reports the
+ * kernel send queue, so a pacer can back off before packets are lost.
  */
 class OSCUDPTransport : public OSCTransport {
 public:
@@ -37,11 +43,17 @@ public:
         errorCallback_ = callback;
     }
 
+    // Send an already encoded OSC packet
+    bool sendPacket(const void* data, size_t size);
+    size_t getQueuedBytes() const override;
+
 private:
-    lo_address target_;
+    int fd_ = -1;
+    sockaddr_storage target_{};
+    socklen_t targetLength_ = 0;
     std::string host_;
     std::string port_;
     mutable std::mutex mutex_;
-    
-    static void errorHandler(int num, const char* msg, const char* path);
+
+    bool sendLoMessage(const std::string& address, lo_message message);
 };
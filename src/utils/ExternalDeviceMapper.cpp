@@ -1,13 +1,15 @@
 #include "ExternalDeviceMapper.h"
+#include "TraceLog.h"
 #include <nlohmann/json.hpp>
 #include <fstream>
-#include <regex>
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 
 using json = nlohmann::json;
 
-ExternalDeviceMapper::ExternalDeviceMapper() {
+ExternalDeviceMapper::ExternalDeviceMapper()
+    : index_(std::make_shared<ExternalMappingIndex>()) {
     
 }
 
@@ -48,6 +50,7 @@ bool ExternalDeviceMapper::unregisterDevice(const std::string& deviceId) {
     }
     
     registeredDevices_.erase(deviceId);
+    rebuildIndexLocked();
     std::cout << "Unregistered device: " << deviceId << std::endl;
     return true;
 }
@@ -69,6 +72,7 @@ bool ExternalDeviceMapper::addMapping(const ExternalDeviceMapping& mapping) {
     
     std::lock_guard<std::mutex> lock(mappingsMutex_);
     mappings_[mapping.mappingId] = mapping;
+    rebuildIndexLocked();
     
     std::cout << "Added mapping: " << mapping.name << " (" << mapping.mappingId << ")" << std::endl;
     return true;
@@ -80,6 +84,7 @@ bool ExternalDeviceMapper::removeMapping(const std::string& mappingId) {
     if (it != mappings_.end()) {
         std::cout << "Removed mapping: " << it->second.name << std::endl;
         mappings_.erase(it);
+        rebuildIndexLocked();
         return true;
     }
     return false;
@@ -94,6 +99,7 @@ bool ExternalDeviceMapper::updateMapping(const std::string& mappingId, const Ext
     auto it = mappings_.find(mappingId);
     if (it != mappings_.end()) {
         it->second = mapping;
+        rebuildIndexLocked();
         std::cout << "Updated mapping: " << mapping.name << std::endl;
         return true;
     }
@@ -197,19 +203,15 @@ void ExternalDeviceMapper::processOSCInput(const std::string& address, const std
         return;
     }
     
-    // Process existing mappings
-    std::lock_guard<std::mutex> lock(mappingsMutex_);
-    for (const auto& pair : mappings_) {
-        const ExternalDeviceMapping& mapping = pair.second;
-        
-        if (!mapping.enabled || mapping.deviceType != ExternalDeviceType::OSC_CONTROLLER) {
-            continue;
-        }
-        
-        if (matchesPattern(address, mapping.inputAddress) && !values.empty()) {
-            processMapping(mapping, values[0]);
-        }
+    if (values.empty()) {
+        return;
     }
+    
+    // Process existing mappings through the prebuilt address trie
+    std::shared_ptr<const ExternalMappingIndex> index = std::atomic_load(&index_);
+    index->forEachOSCMatch(address, [this, &values](const ExternalDeviceMapping& mapping) {
+        processMapping(mapping, values[0]);
+    });
 }
 
 void ExternalDeviceMapper::processMIDIInput(int channel, int cc, int value) {
@@ -236,20 +238,73 @@ void ExternalDeviceMapper::processMIDIInput(int channel, int cc, int value) {
         return;
     }
     
-    // Process existing mappings
-    std::lock_guard<std::mutex> lock(mappingsMutex_);
-    for (const auto& pair : mappings_) {
-        const ExternalDeviceMapping& mapping = pair.second;
-        
-        if (!mapping.enabled || mapping.deviceType != ExternalDeviceType::MIDI_CONTROLLER) {
-            continue;
-        }
-        
-        std::string ccAddress = "cc" + std::to_string(cc);
-        if (mapping.inputAddress == ccAddress) {
-            float normalizedValue = static_cast<float>(value) / 127.0f;
-            processMapping(mapping, normalizedValue);
+    if (channel < 0 || channel >= ExternalMappingIndex::MIDI_CHANNELS || cc < 0 || cc > 127) {
+        return;
+    }
+    value = std::max(0, std::min(127, value));
+    
+    std::shared_ptr<const ExternalMappingIndex> index = std::atomic_load(&index_);
+    MIDIChannelState& state = midiState_[channel];
+    
+    // NRPN parameter select and data entry (MSB updates coarsely, LSB completes the value)
+    switch (cc) {
+        case 99: // NRPN MSB
+            state.nrpnParameter = (value << 7) | (state.nrpnParameter >= 0 ? state.nrpnParameter & 0x7F : 0);
+            break;
+        case 98: // NRPN LSB
+            state.nrpnParameter = (state.nrpnParameter >= 0 ? state.nrpnParameter & 0x3F80 : 0) | value;
+            break;
+        case 101: // RPN select deselects NRPN
+        case 100:
+            state.nrpnParameter = -1;
+            break;
+        case 6: // Data entry MSB
+        case 38: // Data entry LSB
+            if (state.nrpnParameter >= 0) {
+                int value14;
+                if (cc == 6) {
+                    state.dataEntryMSB = value;
+                    value14 = value << 7;
+                } else {
+                    value14 = (state.dataEntryMSB << 7) | value;
+                }
+                float normalizedValue = static_cast<float>(value14) / 16383.0f;
+                index->forEachNRPNMatch(channel, state.nrpnParameter, [this, normalizedValue](const ExternalDeviceMapping& mapping) {
+                    processMapping(mapping, normalizedValue);
+                });
+            }
+            break;
+        default:
+            break;
+    }
+    
+    dispatchMIDIController(*index, channel, cc, value);
+}
+
+void ExternalDeviceMapper::dispatchMIDIController(const ExternalMappingIndex& index, int channel, int cc, int value) {
+    MIDIChannelState& state = midiState_[channel];
+    
+    // 7-bit mappings on this controller; 14-bit mappings take the MSB with LSB reset to zero
+    if (cc < 32) {
+        state.ccMSB[cc] = static_cast<uint8_t>(value);
+    }
+    index.forEachMIDIMatch(channel, cc, [this, cc, value](const ExternalDeviceMapping& mapping) {
+        if (mapping.highResolution && cc < 32) {
+            processMapping(mapping, static_cast<float>(value << 7) / 16383.0f);
+        } else {
+            processMapping(mapping, static_cast<float>(value) / 127.0f);
         }
+    });
+    
+    // LSB of a 14-bit pair completes the value for the MSB controller's mappings
+    if (cc >= 32 && cc < 64) {
+        int msbController = cc - 32;
+        float normalizedValue = static_cast<float>((state.ccMSB[msbController] << 7) | value) / 16383.0f;
+        index.forEachMIDIMatch(channel, msbController, [this, normalizedValue](const ExternalDeviceMapping& mapping) {
+            if (mapping.highResolution) {
+                processMapping(mapping, normalizedValue);
+            }
+        });
     }
 }
 
@@ -312,6 +367,24 @@ void ExternalDeviceMapper::processCustomInput(const std::string& deviceId, const
     }
 }
 
+// Parameter Smoothing
+void ExternalDeviceMapper::setDefaultSmoothing(float timeMs, SmoothingRamp ramp) {
+    defaultSmoothingTimeMs_ = std::max(0.0f, timeMs);
+    defaultSmoothingRamp_ = static_cast<int>(ramp);
+}
+
+void ExternalDeviceMapper::setSmoothingControlRate(float hz) {
+    smoother_.setControlRate(hz);
+}
+
+void ExternalDeviceMapper::tickSmoothing() {
+    smoother_.tick([this](size_t slot, float value) {
+        auto parameterType = static_cast<MappingParameterType>(slot / SMOOTHING_CHANNEL_SLOTS);
+        int channelId = static_cast<int>(slot % SMOOTHING_CHANNEL_SLOTS) - 1;
+        triggerParameterChange(parameterType, channelId, "", value);
+    });
+}
+
 // Output Callbacks
 void ExternalDeviceMapper::setOSCOutputCallback(std::function<void(const std::string&, const std::vector<float>&)> callback) {
     oscOutputCallback_ = callback;
@@ -356,9 +429,15 @@ bool ExternalDeviceMapper::loadMappings(const std::string& filePath) {
             mapping.name = mappingJson["name"];
             mapping.description = mappingJson["description"];
             mapping.enabled = mappingJson["enabled"];
+            mapping.midiChannel = mappingJson.value("midiChannel", -1);
+            mapping.highResolution = mappingJson.value("highResolution", false);
+            mapping.smoothingTimeMs = mappingJson.value("smoothingTimeMs", -1.0f);
+            mapping.smoothingRamp = static_cast<SmoothingRamp>(
+                mappingJson.value("smoothingRamp", static_cast<int>(SmoothingRamp::EXPONENTIAL)));
             
             mappings_[mapping.mappingId] = mapping;
         }
+        rebuildIndexLocked();
         
         std::cout << "Loaded " << mappings_.size() << " mappings from " << filePath << std::endl;
         return true;
@@ -393,6 +472,10 @@ bool ExternalDeviceMapper::saveMappings(const std::string& filePath) {
             mappingJson["name"] = mapping.name;
             mappingJson["description"] = mapping.description;
             mappingJson["enabled"] = mapping.enabled;
+            mappingJson["midiChannel"] = mapping.midiChannel;
+            mappingJson["highResolution"] = mapping.highResolution;
+            mappingJson["smoothingTimeMs"] = mapping.smoothingTimeMs;
+            mappingJson["smoothingRamp"] = static_cast<int>(mapping.smoothingRamp);
             
             j["mappings"].push_back(mappingJson);
         }
@@ -411,6 +494,7 @@ bool ExternalDeviceMapper::saveMappings(const std::string& filePath) {
 void ExternalDeviceMapper::clearAllMappings() {
     std::lock_guard<std::mutex> lock(mappingsMutex_);
     mappings_.clear();
+    rebuildIndexLocked();
     std::cout << "Cleared all mappings" << std::endl;
 }
 
@@ -488,9 +572,19 @@ void ExternalDeviceMapper::processMapping(const ExternalDeviceMapping& mapping,
     float outputValue = transformValue(inputValue, mapping.inputMin, mapping.inputMax, 
                                      mapping.outputMin, mapping.outputMax, mapping.inverted);
     
-    // Trigger parameter change
-    triggerParameterChange(mapping.parameterType, mapping.targetChannelId, 
-                          mapping.targetDeviceId, outputValue);
+    // Continuous targets ramp at control rate through the smoother while its thread
+    // runs, so a stepped write never fights an active ramp. Toggles and selections
+    // apply at once: the smoother keeps one value per slot and tick, which would
+    // swallow a press and release arriving within the same tick.
+    if (processingThreadRunning_ && isContinuous(mapping.parameterType) &&
+        isValidChannelId(mapping.targetChannelId)) {
+        size_t slot = static_cast<size_t>(mapping.parameterType) * SMOOTHING_CHANNEL_SLOTS +
+                      static_cast<size_t>(mapping.targetChannelId + 1);
+        smoother_.setTarget(slot, outputValue, smoothingTimeFor(mapping), smoothingRampFor(mapping));
+    } else {
+        triggerParameterChange(mapping.parameterType, mapping.targetChannelId, 
+                              mapping.targetDeviceId, outputValue);
+    }
     
     // Handle bidirectional mappings
     if (mapping.bidirectional && oscOutputCallback_) {
@@ -499,6 +593,37 @@ void ExternalDeviceMapper::processMapping(const ExternalDeviceMapping& mapping,
     }
 }
 
+bool ExternalDeviceMapper::isContinuous(MappingParameterType parameterType) {
+    switch (parameterType) {
+        case MappingParameterType::CHANNEL_LEVEL:
+        case MappingParameterType::MASTER_LEVEL:
+        case MappingParameterType::CUSTOM_PARAMETER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+float ExternalDeviceMapper::smoothingTimeFor(const ExternalDeviceMapping& mapping) const {
+    if (mapping.smoothingTimeMs >= 0.0f) {
+        return mapping.smoothingTimeMs;
+    }
+    switch (mapping.parameterType) {
+        case MappingParameterType::CHANNEL_LEVEL:
+        case MappingParameterType::MASTER_LEVEL:
+            return defaultSmoothingTimeMs_.load();
+        default:
+            return 0.0f; // Custom parameters step unless configured
+    }
+}
+
+SmoothingRamp ExternalDeviceMapper::smoothingRampFor(const ExternalDeviceMapping& mapping) const {
+    if (mapping.smoothingTimeMs >= 0.0f) {
+        return mapping.smoothingRamp;
+    }
+    return static_cast<SmoothingRamp>(defaultSmoothingRamp_.load());
+}
+
 float ExternalDeviceMapper::transformValue(float input, float inputMin, float inputMax, 
                                          float outputMin, float outputMax, bool inverted) const {
     // Normalize input to 0-1 range
@@ -516,24 +641,10 @@ float ExternalDeviceMapper::transformValue(float input, float inputMin, float in
     return outputMin + normalized * (outputMax - outputMin);
 }
 
-bool ExternalDeviceMapper::matchesPattern(const std::string& input, const std::string& pattern) const {
-    // Simple pattern matching - can be enhanced with regex
-    if (pattern.find('*') != std::string::npos) {
-        // Wildcard matching
-        std::string regexPattern = pattern;
-        std::replace(regexPattern.begin(), regexPattern.end(), '*', '.');
-        regexPattern = "^" + regexPattern + "$";
-        
-        try {
-            std::regex regex(regexPattern);
-            return std::regex_match(input, regex);
-        } catch (const std::exception&) {
-            return false;
-        }
-    } else {
-        // Exact match
-        return input == pattern;
-    }
+void ExternalDeviceMapper::rebuildIndexLocked() {
+    // Caller holds mappingsMutex_; readers keep using the previous index until the swap
+    std::atomic_store(&index_, std::shared_ptr<const ExternalMappingIndex>(
+        std::make_shared<ExternalMappingIndex>(mappings_)));
 }
 
 void ExternalDeviceMapper::triggerParameterChange(MappingParameterType parameterType, int channelId, 
@@ -542,8 +653,9 @@ void ExternalDeviceMapper::triggerParameterChange(MappingParameterType parameter
         parameterChangeCallback_(parameterType, channelId, value);
     }
     
-    std::cout << "Parameter change: type=" << static_cast<int>(parameterType) 
-              << " channel=" << channelId << " value=" << value << std::endl;
+    // Runs on every smoother tick while a ramp is active
+    TRACE_DEBUG(TraceCategory::Device, "parameter change type=%d channel=%d value=%f",
+                static_cast<int>(parameterType), channelId, value);
 }
 
 void ExternalDeviceMapper::updateLearningMode() {
@@ -610,7 +722,10 @@ void ExternalDeviceMapper::startProcessingThread() {
     
     processingThreadRunning_ = true;
     processingThread_ = std::thread([this]() {
+        // Runs at the smoothing control rate; learning and stats piggyback on the same tick
+        auto nextTick = std::chrono::steady_clock::now();
         while (processingThreadRunning_) {
+            tickSmoothing();
             updateLearningMode();
             
             // Update statistics
@@ -621,7 +736,11 @@ void ExternalDeviceMapper::startProcessingThread() {
                 lastStatsUpdate_ = now;
             }
             
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            nextTick += std::chrono::microseconds(static_cast<int64_t>(1.0e6f / smoother_.getControlRate()));
+            if (nextTick < now) {
+                nextTick = now; // Don't burst to catch up after a stall
+            }
+            std::this_thread::sleep_until(nextTick);
         }
     });
 }
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <array>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -10,6 +11,8 @@
 #include <thread>
 #include <chrono>
 #include "../core/OSCMixerTypes.h"
+#include "ExternalMappingIndex.h"
+#include "ParameterSmoother.h"
 
 // External Device Mapping Types
 enum class ExternalDeviceType {
@@ -39,8 +42,10 @@ struct ExternalDeviceMapping {
     ExternalDeviceType deviceType;
     
     // Input parameters (what triggers the mapping)
-    std::string inputAddress;          // OSC address or MIDI CC number
+    std::string inputAddress;          // OSC address, "cc<N>" or "nrpn<N>"
     std::string inputPattern;          // Pattern matching for complex inputs
+    int midiChannel = -1;              // MIDI channel 0-15, -1 for omni
+    bool highResolution = false;       // 14-bit CC pair: cc N (MSB) + cc N+32 (LSB)
     float inputMin = 0.0f;            // Input range minimum
     float inputMax = 1.0f;            // Input range maximum
     
@@ -55,6 +60,8 @@ struct ExternalDeviceMapping {
     bool bidirectional = false;       // If true, changes propagate back to device
     bool inverted = false;            // Invert the mapping
     std::string customScript;         // Custom transformation script
+    float smoothingTimeMs = -1.0f;    // Ramp time, -1 uses the mapper default time and ramp, 0 steps
+    SmoothingRamp smoothingRamp = SmoothingRamp::EXPONENTIAL;   // Used with an explicit smoothingTimeMs
     
     // Metadata
     std::string name;
@@ -119,6 +126,12 @@ public:
     void processKeyboardInput(const std::string& keyCode, bool pressed);
     void processCustomInput(const std::string& deviceId, const std::string& parameter, float value);
     
+    // Parameter Smoothing
+    void setDefaultSmoothing(float timeMs, SmoothingRamp ramp);
+    void setSmoothingControlRate(float hz);
+    float getSmoothingControlRate() const { return smoother_.getControlRate(); }
+    void tickSmoothing();
+    
     // Output Callbacks
     void setOSCOutputCallback(std::function<void(const std::string&, const std::vector<float>&)> callback);
     void setMIDIOutputCallback(std::function<void(int, int, int)> callback);
@@ -144,6 +157,9 @@ private:
     std::map<std::string, ExternalDeviceType> registeredDevices_;
     std::mutex mappingsMutex_;
     
+    // Read-only lookup index, replaced copy-on-write under mappingsMutex_
+    std::shared_ptr<const ExternalMappingIndex> index_;
+    
     // Learning mode
     std::atomic<bool> learningActive_{false};
     LearningModeConfig currentLearningConfig_;
@@ -155,14 +171,35 @@ private:
     std::function<void(int, int, int)> midiOutputCallback_;
     std::function<void(MappingParameterType, int, float)> parameterChangeCallback_;
     
+    // Parameter smoothing, one slot per (parameter type, channel -1..7)
+    static constexpr int SMOOTHING_CHANNEL_SLOTS = 9;
+    static constexpr size_t SMOOTHING_SLOT_COUNT =
+        (static_cast<size_t>(MappingParameterType::CUSTOM_PARAMETER) + 1) * SMOOTHING_CHANNEL_SLOTS;
+    ParameterSmoother smoother_{SMOOTHING_SLOT_COUNT};
+    std::atomic<float> defaultSmoothingTimeMs_{30.0f};
+    std::atomic<int> defaultSmoothingRamp_{static_cast<int>(SmoothingRamp::EXPONENTIAL)};
+    
+    // High-resolution MIDI decoding state (MIDI input thread)
+    struct MIDIChannelState {
+        int nrpnParameter = -1;
+        int dataEntryMSB = 0;
+        std::array<uint8_t, 32> ccMSB{};
+    };
+    std::array<MIDIChannelState, ExternalMappingIndex::MIDI_CHANNELS> midiState_;
+    
     // Performance monitoring
     std::atomic<int> inputsProcessedThisSecond_{0};
     std::chrono::steady_clock::time_point lastStatsUpdate_;
     
     // Internal methods
     void processMapping(const ExternalDeviceMapping& mapping, float inputValue);
+    void dispatchMIDIController(const ExternalMappingIndex& index, int channel, int cc, int value);
+    float smoothingTimeFor(const ExternalDeviceMapping& mapping) const;
+    SmoothingRamp smoothingRampFor(const ExternalDeviceMapping& mapping) const;
+    // Levels and custom parameters ramp; toggles and selections bypass the smoother
+    static bool isContinuous(MappingParameterType parameterType);
     float transformValue(float input, float inputMin, float inputMax, float outputMin, float outputMax, bool inverted) const;
-    bool matchesPattern(const std::string& input, const std::string& pattern) const;
+    void rebuildIndexLocked();
     void triggerParameterChange(MappingParameterType parameterType, int channelId, const std::string& deviceId, float value);
     void updateLearningMode();
     void completeLearning(const ExternalDeviceMapping& mapping);
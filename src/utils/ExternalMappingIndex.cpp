@@ -0,0 +1,250 @@
+#include "ExternalMappingIndex.h"
+#include "ExternalDeviceMapper.h"
+
+// SegmentPattern implementation
+ExternalMappingIndex::SegmentPattern::SegmentPattern(std::string_view pattern) {
+    size_t i = 0;
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        Op op;
+
+        if (c == '*') {
+            op.type = OpType::ANY_RUN;
+            // Collapse consecutive stars
+            while (i < pattern.size() && pattern[i] == '*') {
+                i++;
+            }
+            ops_.push_back(std::move(op));
+            continue;
+        }
+
+        if (c == '?') {
+            op.type = OpType::ANY_CHAR;
+            ops_.push_back(std::move(op));
+            i++;
+            continue;
+        }
+
+        if (c == '[') {
+            size_t close = pattern.find(']', i + 1);
+            if (close != std::string_view::npos) {
+                op.type = OpType::CHAR_CLASS;
+                size_t pos = i + 1;
+                bool negate = pos < close && pattern[pos] == '!';
+                if (negate) {
+                    pos++;
+                }
+                while (pos < close) {
+                    unsigned char first = static_cast<unsigned char>(pattern[pos]);
+                    if (pos + 2 < close && pattern[pos + 1] == '-') {
+                        unsigned char last = static_cast<unsigned char>(pattern[pos + 2]);
+                        for (unsigned int ch = first; ch <= last; ch++) {
+                            op.charClass[ch] = true;
+                        }
+                        pos += 3;
+                    } else {
+                        op.charClass[first] = true;
+                        pos++;
+                    }
+                }
+                if (negate) {
+                    for (auto& member : op.charClass) {
+                        member = !member;
+                    }
+                }
+                ops_.push_back(std::move(op));
+                i = close + 1;
+                continue;
+            }
+        }
+
+        if (c == '{') {
+            size_t close = pattern.find('}', i + 1);
+            if (close != std::string_view::npos) {
+                op.type = OpType::ALTERNATIVES;
+                std::string_view body = pattern.substr(i + 1, close - i - 1);
+                size_t start = 0;
+                while (true) {
+                    size_t comma = body.find(',', start);
+                    op.alternatives.emplace_back(body.substr(start, comma - start));
+                    if (comma == std::string_view::npos) {
+                        break;
+                    }
+                    start = comma + 1;
+                }
+                ops_.push_back(std::move(op));
+                i = close + 1;
+                continue;
+            }
+        }
+
+        // Literal run up to the next special character
+        op.type = OpType::LITERAL;
+        size_t end = i + 1;
+        while (end < pattern.size() && pattern[end] != '*' && pattern[end] != '?' &&
+               pattern[end] != '[' && pattern[end] != '{') {
+            end++;
+        }
+        op.text.assign(pattern.substr(i, end - i));
+        ops_.push_back(std::move(op));
+        i = end;
+    }
+}
+
+bool ExternalMappingIndex::SegmentPattern::matches(std::string_view segment) const {
+    return matchFrom(0, segment);
+}
+
+bool ExternalMappingIndex::SegmentPattern::matchFrom(size_t opIndex, std::string_view segment) const {
+    while (opIndex < ops_.size()) {
+        const Op& op = ops_[opIndex];
+        switch (op.type) {
+            case OpType::LITERAL:
+                if (segment.substr(0, op.text.size()) != op.text) {
+                    return false;
+                }
+                segment.remove_prefix(op.text.size());
+                break;
+
+            case OpType::ANY_CHAR:
+                if (segment.empty()) {
+                    return false;
+                }
+                segment.remove_prefix(1);
+                break;
+
+            case OpType::CHAR_CLASS:
+                if (segment.empty() || !op.charClass[static_cast<unsigned char>(segment.front())]) {
+                    return false;
+                }
+                segment.remove_prefix(1);
+                break;
+
+            case OpType::ALTERNATIVES:
+                for (const auto& alternative : op.alternatives) {
+                    if (segment.substr(0, alternative.size()) == alternative &&
+                        matchFrom(opIndex + 1, segment.substr(alternative.size()))) {
+                        return true;
+                    }
+                }
+                return false;
+
+            case OpType::ANY_RUN:
+                if (opIndex + 1 == ops_.size()) {
+                    return true; // Trailing star swallows the rest of the segment
+                }
+                for (size_t skip = 0; skip <= segment.size(); skip++) {
+                    if (matchFrom(opIndex + 1, segment.substr(skip))) {
+                        return true;
+                    }
+                }
+                return false;
+        }
+        opIndex++;
+    }
+    return segment.empty();
+}
+
+// ExternalMappingIndex implementation
+ExternalMappingIndex::ExternalMappingIndex(const std::map<std::string, ExternalDeviceMapping>& mappings) {
+    trie_.emplace_back(); // Root node
+
+    for (const auto& pair : mappings) {
+        const ExternalDeviceMapping& mapping = pair.second;
+        if (!mapping.enabled) {
+            continue;
+        }
+
+        if (mapping.deviceType == ExternalDeviceType::OSC_CONTROLLER) {
+            if (mapping.inputAddress.empty() || mapping.inputAddress.front() != '/') {
+                continue; // Incoming OSC addresses always start with '/'
+            }
+            entries_.push_back(std::make_unique<ExternalDeviceMapping>(mapping));
+            insertOSCAddress(entries_.back()->inputAddress, entries_.size() - 1);
+        } else if (mapping.deviceType == ExternalDeviceType::MIDI_CONTROLLER) {
+            bool channelSet = mapping.midiChannel >= 0 && mapping.midiChannel < MIDI_CHANNELS;
+
+            int nrpn = parseMIDINRPN(mapping.inputAddress);
+            if (nrpn >= 0) {
+                entries_.push_back(std::make_unique<ExternalDeviceMapping>(mapping));
+                int channel = channelSet ? mapping.midiChannel : NRPN_OMNI_CHANNEL;
+                nrpnTable_[static_cast<uint32_t>(channel << 14 | nrpn)].push_back(entries_.size() - 1);
+                continue;
+            }
+
+            int cc = parseMIDICC(mapping.inputAddress);
+            if (cc < 0) {
+                continue;
+            }
+            entries_.push_back(std::make_unique<ExternalDeviceMapping>(mapping));
+            size_t mappingIndex = entries_.size() - 1;
+
+            if (channelSet) {
+                midiTable_[mapping.midiChannel * MIDI_CONTROLLERS + cc].push_back(mappingIndex);
+            } else {
+                // Omni mapping responds on every channel
+                for (int channel = 0; channel < MIDI_CHANNELS; channel++) {
+                    midiTable_[channel * MIDI_CONTROLLERS + cc].push_back(mappingIndex);
+                }
+            }
+        }
+    }
+}
+
+void ExternalMappingIndex::insertOSCAddress(std::string_view address, size_t mappingIndex) {
+    size_t node = 0;
+    std::string_view rest = address;
+    std::string_view segment;
+
+    while (nextSegment(rest, segment)) {
+        size_t child = trie_.size();
+
+        if (hasWildcards(segment)) {
+            // Patterns are not deduplicated; identical wildcard segments are rare
+            trie_[node].patternChildren.emplace_back(SegmentPattern(segment), child);
+            trie_.emplace_back();
+        } else {
+            auto inserted = trie_[node].literalChildren.emplace(segment, child);
+            if (inserted.second) {
+                trie_.emplace_back();
+            } else {
+                child = inserted.first->second;
+            }
+        }
+        node = child;
+    }
+
+    trie_[node].mappings.push_back(mappingIndex);
+}
+
+int ExternalMappingIndex::parseMIDICC(const std::string& address) {
+    if (address.size() < 3 || address.size() > 5 || address.compare(0, 2, "cc") != 0) {
+        return -1;
+    }
+    int cc = 0;
+    for (size_t i = 2; i < address.size(); i++) {
+        if (address[i] < '0' || address[i] > '9') {
+            return -1;
+        }
+        cc = cc * 10 + (address[i] - '0');
+    }
+    return cc < MIDI_CONTROLLERS ? cc : -1;
+}
+
+int ExternalMappingIndex::parseMIDINRPN(const std::string& address) {
+    if (address.size() < 5 || address.size() > 9 || address.compare(0, 4, "nrpn") != 0) {
+        return -1;
+    }
+    int parameter = 0;
+    for (size_t i = 4; i < address.size(); i++) {
+        if (address[i] < '0' || address[i] > '9') {
+            return -1;
+        }
+        parameter = parameter * 10 + (address[i] - '0');
+    }
+    return parameter <= 0x3FFF ? parameter : -1;
+}
+
+bool ExternalMappingIndex::hasWildcards(std::string_view text) {
+    return text.find_first_of("*?[{") != std::string_view::npos;
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+
+struct ExternalDeviceMapping;
+
+/**
+ * @brief Immutable lookup index over ExternalDeviceMapper mappings
+ *
+ * Built once from the mapping table whenever it changes and then shared
+ * read-only between input threads. OSC addresses are resolved through a
+ * per-segment trie (literal children hashed, wildcard children compiled
+ * once), MIDI CC input through a flat [channel][cc] table and NRPN input
+ * through a hashed (channel, parameter) table, so lookup cost does not
+ * depend on the number of mappings.
+ */
+class ExternalMappingIndex {
+public:
+    static constexpr int MIDI_CHANNELS = 16;
+    static constexpr int MIDI_CONTROLLERS = 128;
+
+    /**
+     * @brief Compiled OSC address segment pattern ('*', '?', '[...]', '{a,b}')
+     */
+    class SegmentPattern {
+    public:
+        explicit SegmentPattern(std::string_view pattern);
+        bool matches(std::string_view segment) const;
+
+    private:
+        enum class OpType { LITERAL, ANY_CHAR, ANY_RUN, CHAR_CLASS, ALTERNATIVES };
+        struct Op {
+            OpType type;
+            std::string text;                       // LITERAL text
+            std::array<bool, 256> charClass{};      // CHAR_CLASS membership
+            std::vector<std::string> alternatives;  // ALTERNATIVES
+        };
+        std::vector<Op> ops_;
+
+        bool matchFrom(size_t opIndex, std::string_view segment) const;
+    };
+
+    ExternalMappingIndex() = default;
+    explicit ExternalMappingIndex(const std::map<std::string, ExternalDeviceMapping>& mappings);
+
+    // Lookup (thread-safe on a const index, allocation-free)
+    template <typename Fn>
+    void forEachOSCMatch(std::string_view address, Fn&& fn) const;
+
+    template <typename Fn>
+    void forEachMIDIMatch(int channel, int cc, Fn&& fn) const;
+
+    template <typename Fn>
+    void forEachNRPNMatch(int channel, int parameter, Fn&& fn) const;
+
+    const ExternalDeviceMapping& mapping(size_t index) const { return *entries_[index]; }
+    size_t size() const { return entries_.size(); }
+
+    // Parses "cc<N>" / "nrpn<N>" addresses, -1 if the address is not of that form
+    static int parseMIDICC(const std::string& address);
+    static int parseMIDINRPN(const std::string& address);
+    static bool hasWildcards(std::string_view text);
+
+private:
+    struct TrieNode {
+        std::unordered_map<std::string_view, size_t> literalChildren;
+        std::vector<std::pair<SegmentPattern, size_t>> patternChildren;
+        std::vector<size_t> mappings;
+    };
+
+    // Owned copies so the index stays valid while the mapper mutates its table
+    std::vector<std::unique_ptr<ExternalDeviceMapping>> entries_;
+    std::vector<TrieNode> trie_;
+    std::array<std::vector<size_t>, MIDI_CHANNELS * MIDI_CONTROLLERS> midiTable_;
+    std::unordered_map<uint32_t, std::vector<size_t>> nrpnTable_;  // (channel << 14) | parameter
+
+    static constexpr int NRPN_OMNI_CHANNEL = MIDI_CHANNELS;
+
+    void insertOSCAddress(std::string_view address, size_t mappingIndex);
+
+    template <typename Fn>
+    void walk(size_t node, std::string_view rest, Fn& fn) const;
+
+    static bool nextSegment(std::string_view& rest, std::string_view& segment);
+};
+
+// Template implementations
+
+inline bool ExternalMappingIndex::nextSegment(std::string_view& rest, std::string_view& segment) {
+    if (rest.empty()) {
+        return false;
+    }
+    if (rest.front() == '/') {
+        rest.remove_prefix(1);
+    }
+    size_t slash = rest.find('/');
+    segment = rest.substr(0, slash);
+    rest = (slash == std::string_view::npos) ? std::string_view() : rest.substr(slash);
+    return true;
+}
+
+template <typename Fn>
+void ExternalMappingIndex::walk(size_t node, std::string_view rest, Fn& fn) const {
+    const TrieNode& current = trie_[node];
+
+    std::string_view segment;
+    if (!nextSegment(rest, segment)) {
+        for (size_t mappingIndex : current.mappings) {
+            fn(*entries_[mappingIndex]);
+        }
+        return;
+    }
+
+    auto literal = current.literalChildren.find(segment);
+    if (literal != current.literalChildren.end()) {
+        walk(literal->second, rest, fn);
+    }
+
+    for (const auto& child : current.patternChildren) {
+        if (child.first.matches(segment)) {
+            walk(child.second, rest, fn);
+        }
+    }
+}
+
+template <typename Fn>
+void ExternalMappingIndex::forEachOSCMatch(std::string_view address, Fn&& fn) const {
+    if (trie_.empty() || address.empty() || address.front() != '/') {
+        return;
+    }
+    walk(0, address, fn);
+}
+
+template <typename Fn>
+void ExternalMappingIndex::forEachMIDIMatch(int channel, int cc, Fn&& fn) const {
+    if (channel < 0 || channel >= MIDI_CHANNELS || cc < 0 || cc >= MIDI_CONTROLLERS) {
+        return;
+    }
+    for (size_t mappingIndex : midiTable_[channel * MIDI_CONTROLLERS + cc]) {
+        fn(*entries_[mappingIndex]);
+    }
+}
+
+template <typename Fn>
+void ExternalMappingIndex::forEachNRPNMatch(int channel, int parameter, Fn&& fn) const {
+    if (channel < 0 || channel >= MIDI_CHANNELS || parameter < 0 || parameter > 0x3FFF || nrpnTable_.empty()) {
+        return;
+    }
+    for (uint32_t key : {static_cast<uint32_t>(channel << 14 | parameter),
+                         static_cast<uint32_t>(NRPN_OMNI_CHANNEL << 14 | parameter)}) {
+        auto it = nrpnTable_.find(key);
+        if (it != nrpnTable_.end()) {
+            for (size_t mappingIndex : it->second) {
+                fn(*entries_[mappingIndex]);
+            }
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include "ParameterSmoother.h"
+#include <algorithm>
+
+ParameterSmoother::ParameterSmoother(size_t slotCount, float controlRateHz)
+    : current_(slotCount, 0.0f),
+      target_(slotCount, 0.0f),
+      step_(slotCount, 0.0f),
+      coeff_(slotCount, 0.0f),
+      isLinear_(slotCount, 0.0f),
+      remaining_(slotCount, 0.0f),
+      active_(slotCount, 0),
+      initialized_(slotCount, 0),
+      pending_(new PendingTarget[slotCount]),
+      controlRateHz_(controlRateHz > 0.0f ? controlRateHz : 200.0f) {
+    activeSlots_.reserve(slotCount);
+    jumpedSlots_.reserve(slotCount);
+}
+
+void ParameterSmoother::setTarget(size_t slot, float value, float timeMs, SmoothingRamp ramp) {
+    if (slot >= current_.size()) {
+        return;
+    }
+    PendingTarget& pending = pending_[slot];
+    pending.value.store(value, std::memory_order_relaxed);
+    pending.timeMs.store(timeMs, std::memory_order_relaxed);
+    pending.ramp.store(static_cast<uint8_t>(ramp), std::memory_order_relaxed);
+    pending.pending.store(true, std::memory_order_release);
+}
+
+void ParameterSmoother::setControlRate(float hz) {
+    if (hz > 0.0f) {
+        controlRateHz_ = hz;
+    }
+}
+
+void ParameterSmoother::applyPending(size_t slot) {
+    PendingTarget& pending = pending_[slot];
+    if (!pending.pending.exchange(false, std::memory_order_acquire)) {
+        return;
+    }
+
+    float value = pending.value.load(std::memory_order_relaxed);
+    float timeMs = pending.timeMs.load(std::memory_order_relaxed);
+    auto ramp = static_cast<SmoothingRamp>(pending.ramp.load(std::memory_order_relaxed));
+
+    target_[slot] = value;
+
+    // First value for a slot has nothing to ramp from
+    float ticks = timeMs * 0.001f * controlRateHz_.load(std::memory_order_relaxed);
+    if (!initialized_[slot] || ticks < 1.0f) {
+        initialized_[slot] = 1;
+        current_[slot] = value;
+        step_[slot] = 0.0f;
+        coeff_[slot] = 0.0f;
+        active_[slot] = 0;
+        jumpedSlots_.push_back(slot);
+        return;
+    }
+
+    // A retarget restarts the ramp from wherever the slot currently is
+    remaining_[slot] = std::ceil(ticks - 1.0e-3f); // Tolerate float error in timeMs * rate
+    if (ramp == SmoothingRamp::LINEAR) {
+        isLinear_[slot] = 1.0f;
+        step_[slot] = (value - current_[slot]) / remaining_[slot];
+        coeff_[slot] = 0.0f;
+    } else {
+        // Residual of e^-5 (under 1%) at the end of the ramp, then snap
+        isLinear_[slot] = 0.0f;
+        step_[slot] = 0.0f;
+        coeff_[slot] = 1.0f - std::exp(-5.0f / ticks);
+    }
+
+    if (!active_[slot]) {
+        active_[slot] = 1;
+        activeSlots_.push_back(slot);
+    }
+}
+
+void ParameterSmoother::advanceAll() {
+    // One branch-free pass over every slot; idle slots have zero step and coefficient
+    const size_t count = current_.size();
+    float* current = current_.data();
+    const float* target = target_.data();
+    const float* step = step_.data();
+    const float* coeff = coeff_.data();
+    const float* isLinear = isLinear_.data();
+
+    for (size_t i = 0; i < count; i++) {
+        float linear = current[i] + step[i];
+        float exponential = current[i] + (target[i] - current[i]) * coeff[i];
+        current[i] = exponential + isLinear[i] * (linear - exponential);
+    }
+}
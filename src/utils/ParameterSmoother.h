@@ -0,0 +1,114 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+
+enum class SmoothingRamp {
+    LINEAR,
+    EXPONENTIAL
+};
+
+/**
+ * @brief Control-rate parameter smoother for stepped controller input
+ *
+ * Holds a fixed set of parameter slots in structure-of-arrays form. Input
+ * threads post new targets with setTarget() (lock-free, last write wins);
+ * a single control thread calls tick() which advances every active ramp in
+ * one branch-free pass and reports the slots whose value moved.
+ */
+class ParameterSmoother {
+public:
+    explicit ParameterSmoother(size_t slotCount, float controlRateHz = 200.0f);
+
+    // Producer side (any thread)
+    void setTarget(size_t slot, float value, float timeMs, SmoothingRamp ramp);
+    void jumpTo(size_t slot, float value) { setTarget(slot, value, 0.0f, SmoothingRamp::LINEAR); }
+
+    // Consumer side (control thread only)
+    template <typename Fn>
+    size_t tick(Fn&& onValue);
+
+    void setControlRate(float hz);
+    float getControlRate() const { return controlRateHz_.load(); }
+
+    // State queries (control thread only)
+    float getCurrentValue(size_t slot) const { return slot < current_.size() ? current_[slot] : 0.0f; }
+    bool isRamping(size_t slot) const { return slot < active_.size() && active_[slot] != 0; }
+    size_t getActiveRampCount() const { return activeSlots_.size(); }
+    size_t getSlotCount() const { return current_.size(); }
+
+private:
+    struct PendingTarget {
+        std::atomic<float> value{0.0f};
+        std::atomic<float> timeMs{0.0f};
+        std::atomic<uint8_t> ramp{0};
+        std::atomic<bool> pending{false};
+    };
+
+    // Ramp state, one entry per slot (control thread only)
+    std::vector<float> current_;
+    std::vector<float> target_;
+    std::vector<float> step_;          // Linear increment per tick
+    std::vector<float> coeff_;         // Exponential approach per tick
+    std::vector<float> isLinear_;      // 1.0 linear, 0.0 exponential
+    std::vector<float> remaining_;     // Ticks left before snapping to target
+    std::vector<uint8_t> active_;
+    std::vector<uint8_t> initialized_;
+    std::vector<size_t> activeSlots_;
+    std::vector<size_t> jumpedSlots_;
+
+    std::unique_ptr<PendingTarget[]> pending_;
+    std::atomic<float> controlRateHz_;
+
+    static constexpr float SNAP_EPSILON = 1.0e-5f;
+
+    void applyPending(size_t slot);
+    void advanceAll();
+};
+
+// Template implementations
+
+template <typename Fn>
+size_t ParameterSmoother::tick(Fn&& onValue) {
+    jumpedSlots_.clear();
+    for (size_t slot = 0; slot < current_.size(); slot++) {
+        if (pending_[slot].pending.load(std::memory_order_relaxed)) {
+            applyPending(slot);
+        }
+    }
+    for (size_t slot : jumpedSlots_) {
+        onValue(slot, current_[slot]);
+    }
+
+    if (activeSlots_.empty()) {
+        return jumpedSlots_.size();
+    }
+
+    advanceAll();
+
+    // Report moved slots and retire finished ramps
+    size_t reported = jumpedSlots_.size();
+    size_t kept = 0;
+    for (size_t i = 0; i < activeSlots_.size(); i++) {
+        size_t slot = activeSlots_[i];
+        if (!active_[slot]) {
+            continue; // Jumped to its target by applyPending this tick
+        }
+        remaining_[slot] -= 1.0f;
+        if (remaining_[slot] <= 0.0f || std::fabs(target_[slot] - current_[slot]) <= SNAP_EPSILON) {
+            current_[slot] = target_[slot];
+            step_[slot] = 0.0f;
+            coeff_[slot] = 0.0f;
+            active_[slot] = 0;
+        } else {
+            activeSlots_[kept++] = slot;
+        }
+        onValue(slot, current_[slot]);
+        reported++;
+    }
+    activeSlots_.resize(kept);
+    return reported;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+/*
+ * CV to OSC Converter plugin C ABI, version 2
+ *
+ * Plugins export a single symbol, cvosc_plugin_entry_v2, returning a static
+ * descriptor. Everything crossing the library boundary is plain C: no C++
+ * classes, exceptions, std::string or std::vector, so plugins can be built
+ * with any compiler or language that emits C calls.
+ *
+ * Audio is exchanged as planar float blocks in caller-owned memory. The host
+ * allocates all buffers; a plugin never allocates or frees them.
+ *
+ * Real-time contract for functions marked [RT]:
+ *   - called from the audio or engine thread, at most one call at a time per instance
+ *   - must not allocate, lock, block, perform I/O or throw
+ *   - must return within the block period
+ * Functions marked [non-RT] are only called from control threads and never
+ * concurrently with [RT] calls on the same instance.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PLUGIN_API_VERSION 2
+#define PLUGIN_LEGACY_API_VERSION 1
+#define CVOSC_PLUGIN_ENTRY_SYMBOL "cvosc_plugin_entry_v2"
+
+/* Plugin kinds */
+#define CVOSC_PLUGIN_SIGNAL_PROCESSOR 0u
+#define CVOSC_PLUGIN_CV_MAPPER        1u
+
+/* Descriptor flags */
+#define CVOSC_PLUGIN_FLAG_IN_PLACE    (1u << 0) /* inputs may alias outputs */
+#define CVOSC_PLUGIN_FLAG_RT_SAFE     (1u << 1) /* plugin honours the [RT] contract */
+
+/* Return codes */
+#define CVOSC_OK                0
+#define CVOSC_ERROR            -1
+#define CVOSC_ERROR_BAD_PARAM  -2
+#define CVOSC_ERROR_BAD_BLOCK  -3
+
+/* One block of planar audio. Channel pointers and sample memory are owned by the host. */
+typedef struct cvosc_process_block {
+    uint32_t num_channels;
+    uint32_t num_frames;
+    const float* const* inputs;   /* num_channels pointers to num_frames samples */
+    float* const* outputs;        /* may equal inputs if CVOSC_PLUGIN_FLAG_IN_PLACE */
+    uint64_t frame_position;      /* running frame counter of the first sample */
+} cvosc_process_block;
+
+typedef struct cvosc_parameter_info {
+    uint32_t id;                  /* stable across plugin versions */
+    const char* name;
+    float min_value;
+    float max_value;
+    float default_value;
+} cvosc_parameter_info;
+
+typedef struct cvosc_plugin_descriptor {
+    uint32_t struct_size;         /* sizeof(cvosc_plugin_descriptor) at build time */
+    uint32_t abi_version;         /* PLUGIN_API_VERSION */
+    uint32_t kind;                /* CVOSC_PLUGIN_* */
+    uint32_t flags;               /* CVOSC_PLUGIN_FLAG_* */
+
+    const char* name;
+    const char* version;
+    const char* author;
+    const char* description;
+
+    uint32_t parameter_count;
+    const cvosc_parameter_info* parameters;
+
+    /* [non-RT] Create an instance for the given block geometry. NULL on failure. */
+    void* (*create)(double sample_rate, uint32_t max_channels, uint32_t max_frames);
+    /* [non-RT] */
+    void (*destroy)(void* instance);
+    /* [non-RT] Clear internal state (filters, ramps). */
+    int32_t (*reset)(void* instance);
+
+    /* [RT] Process one block, num_frames <= max_frames, num_channels <= max_channels. */
+    int32_t (*process)(void* instance, const cvosc_process_block* block);
+    /* [RT] Set a parameter by id. */
+    int32_t (*set_parameter)(void* instance, uint32_t id, float value);
+    /* [RT] */
+    float (*get_parameter)(void* instance, uint32_t id);
+} cvosc_plugin_descriptor;
+
+/* Exported by the plugin. host_abi_version lets a plugin refuse or adapt. */
+typedef const cvosc_plugin_descriptor* (*cvosc_plugin_entry_fn)(uint32_t host_abi_version);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,33 @@
+// Isolated plugin host process
+//
+// Spawned by PluginSandbox; never started by hand. Maps the shared-memory
+// region inherited as a file descriptor, loads one plugin and serves blocks
+// until the converter asks it to stop or exits.
+//
+// Usage: cvosc_plugin_host --fd <n> --plugin <path>
+
+#include "PluginSandbox.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+    int fd = -1;
+    std::string pluginPath;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--fd") == 0) {
+            fd = std::atoi(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--plugin") == 0) {
+            pluginPath = argv[i + 1];
+        }
+    }
+
+    if (fd < 0 || pluginPath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " --fd <n> --plugin <path>" << std::endl;
+        return 2;
+    }
+
+    return PluginSandbox::runHost(fd, pluginPath);
+}
@@ -0,0 +1,303 @@
+#include "PluginInsertChain.h"
+#include "PluginManager.h"
+#include "../core/PerformanceMonitor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+PluginInsertChain::Insert::Insert(int channel, std::string name, BlockProcessor* processor)
+    : channel(channel), pluginName(std::move(name)), processor(processor) {
+}
+
+PluginInsertChain::PluginInsertChain(int maxChannels, uint32_t maxFrames, double sampleRate)
+    : maxChannels_(std::max(1, maxChannels))
+    , maxFrames_(std::max<uint32_t>(1, maxFrames))
+    , sampleRate_(sampleRate > 0.0 ? sampleRate : 48000.0)
+    , scratch_(maxFrames_, 0.0f) {
+    auto layout = std::make_unique<Layout>();
+    layout->channels.resize(maxChannels_);
+    publish(std::move(layout));
+}
+
+PluginInsertChain::~PluginInsertChain() {
+    layout_.store(nullptr);
+}
+
+bool PluginInsertChain::attach(int channel, const std::string& pluginName, BlockProcessor* processor, int position) {
+    if (channel < 0 || channel >= maxChannels_ || !processor) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(layoutMutex_);
+    for (const auto& insert : current_->owned) {
+        if (insert->pluginName == pluginName) {
+            return false; // Already inserted
+        }
+    }
+
+    auto next = copyLayout();
+    auto insert = std::make_shared<Insert>(channel, pluginName, processor);
+    auto& inserts = next->channels[channel];
+    if (position < 0 || position >= static_cast<int>(inserts.size())) {
+        inserts.push_back(insert.get());
+    } else {
+        inserts.insert(inserts.begin() + position, insert.get());
+    }
+    next->owned.push_back(std::move(insert));
+    publish(std::move(next));
+    return true;
+}
+
+bool PluginInsertChain::detach(int channel, const std::string& pluginName) {
+    if (channel < 0 || channel >= maxChannels_) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(layoutMutex_);
+    auto next = copyLayout();
+    auto& inserts = next->channels[channel];
+    auto it = std::find_if(inserts.begin(), inserts.end(),
+                           [&](const Insert* insert) { return insert->pluginName == pluginName; });
+    if (it == inserts.end()) {
+        return false;
+    }
+    const Insert* removed = *it;
+    inserts.erase(it);
+    next->owned.erase(std::remove_if(next->owned.begin(), next->owned.end(),
+                                     [removed](const std::shared_ptr<Insert>& insert) { return insert.get() == removed; }),
+                      next->owned.end());
+    publish(std::move(next));
+    return true;
+}
+
+void PluginInsertChain::detachPlugin(const std::string& pluginName) {
+    std::shared_ptr<Insert> insert = findInsert(pluginName);
+    if (insert) {
+        detach(insert->channel, pluginName);
+    }
+}
+
+void PluginInsertChain::clear() {
+    std::lock_guard<std::mutex> lock(layoutMutex_);
+    auto next = std::make_unique<Layout>();
+    next->channels.resize(maxChannels_);
+    publish(std::move(next));
+}
+
+std::vector<std::string> PluginInsertChain::getInserts(int channel) const {
+    std::vector<std::string> names;
+    std::lock_guard<std::mutex> lock(layoutMutex_);
+    if (channel >= 0 && channel < maxChannels_) {
+        for (const Insert* insert : current_->channels[channel]) {
+            names.push_back(insert->pluginName);
+        }
+    }
+    return names;
+}
+
+int PluginInsertChain::getInsertChannel(const std::string& pluginName) const {
+    std::shared_ptr<Insert> insert = findInsert(pluginName);
+    return insert ? insert->channel : -1;
+}
+
+void PluginInsertChain::setBlockBudget(double fractionOfBlockPeriod) {
+    budgetFraction_.store(std::clamp(fractionOfBlockPeriod, 0.001, 1.0));
+}
+
+bool PluginInsertChain::setInsertBudget(const std::string& pluginName, int64_t budgetNs) {
+    std::shared_ptr<Insert> insert = findInsert(pluginName);
+    if (!insert) {
+        return false;
+    }
+    insert->budgetOverrideNs.store(std::max<int64_t>(0, budgetNs));
+    return true;
+}
+
+void PluginInsertChain::setOverrunLimit(uint32_t consecutiveBlocks) {
+    overrunLimit_.store(std::max<uint32_t>(1, consecutiveBlocks));
+}
+
+void PluginInsertChain::setSampleRate(double sampleRate) {
+    if (sampleRate > 0.0) {
+        sampleRate_.store(sampleRate);
+    }
+}
+
+bool PluginInsertChain::setBypassed(const std::string& pluginName, bool bypassed) {
+    std::shared_ptr<Insert> insert = findInsert(pluginName);
+    if (!insert) {
+        return false;
+    }
+    if (!bypassed && insert->bypassed.load()) {
+        // The audio thread skips bypassed inserts, so the instance can be reset before it resumes
+        insert->bypassAlertPending.store(false);
+        insert->processor->reset();
+    }
+    insert->bypassed.store(bypassed);
+    return true;
+}
+
+bool PluginInsertChain::isBypassed(const std::string& pluginName) const {
+    std::shared_ptr<Insert> insert = findInsert(pluginName);
+    return insert && insert->bypassed.load();
+}
+
+void PluginInsertChain::process(int channel, float* samples, uint32_t frames) {
+    if (channel < 0 || channel >= maxChannels_ || !samples || frames == 0) {
+        return;
+    }
+
+    activeReaders_.fetch_add(1);
+    const Layout* layout = layout_.load();
+    if (!layout || layout->channels[channel].empty()) {
+        activeReaders_.fetch_sub(1);
+        return;
+    }
+
+    const int64_t blockBudgetNs = static_cast<int64_t>(
+        budgetFraction_.load(std::memory_order_relaxed) * frames * 1.0e9 / sampleRate_.load(std::memory_order_relaxed));
+    const uint32_t overrunLimit = overrunLimit_.load(std::memory_order_relaxed);
+
+    for (Insert* insert : layout->channels[channel]) {
+        if (insert->bypassed.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        BlockProcessor& processor = *insert->processor;
+        const bool inPlace = processor.supportsInPlace();
+        const uint32_t chunkLimit = std::min(maxFrames_, processor.getMaxFrames());
+        bool ok = true;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t offset = 0; ok && offset < frames; offset += chunkLimit) {
+            uint32_t chunk = std::min(frames - offset, chunkLimit);
+            float* output = samples + offset;
+            const float* input = output;
+            if (!inPlace) {
+                std::memcpy(scratch_.data(), output, chunk * sizeof(float));
+                input = scratch_.data();
+            }
+            cvosc_process_block block{1, chunk, &input, &output, 0};
+            ok = processor.process(block);
+            if (!ok && input != output) {
+                // A failed block leaves the output undefined; restore the dry signal
+                std::memcpy(output, input, chunk * sizeof(float));
+            }
+        }
+        auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        int64_t budgetNs = insert->budgetOverrideNs.load(std::memory_order_relaxed);
+        if (budgetNs <= 0) {
+            budgetNs = blockBudgetNs;
+        }
+
+        insert->blocks.store(insert->blocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        insert->totalNs.store(insert->totalNs.load(std::memory_order_relaxed) + elapsedNs, std::memory_order_relaxed);
+        insert->lastNs.store(elapsedNs, std::memory_order_relaxed);
+        insert->lastBudgetNs.store(budgetNs, std::memory_order_relaxed);
+        if (elapsedNs > insert->maxNs.load(std::memory_order_relaxed)) {
+            insert->maxNs.store(elapsedNs, std::memory_order_relaxed);
+        }
+
+        if (!ok) {
+            bypass(*insert);
+        } else if (elapsedNs > budgetNs) {
+            insert->overruns.store(insert->overruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (++insert->consecutiveOverruns >= overrunLimit) {
+                bypass(*insert);
+            }
+        } else {
+            insert->consecutiveOverruns = 0;
+        }
+    }
+
+    activeReaders_.fetch_sub(1);
+}
+
+void PluginInsertChain::bypass(Insert& insert) {
+    insert.consecutiveOverruns = 0;
+    insert.bypassed.store(true, std::memory_order_relaxed);
+    insert.bypassAlertPending.store(true, std::memory_order_release);
+}
+
+std::vector<PluginInsertChain::InsertStatistics> PluginInsertChain::getStatistics() const {
+    std::vector<InsertStatistics> statistics;
+    std::lock_guard<std::mutex> lock(layoutMutex_);
+    for (int channel = 0; channel < maxChannels_; channel++) {
+        for (const Insert* insert : current_->channels[channel]) {
+            InsertStatistics entry;
+            entry.channel = channel;
+            entry.pluginName = insert->pluginName;
+            entry.blocks = insert->blocks.load();
+            entry.overruns = insert->overruns.load();
+            entry.lastNs = insert->lastNs.load();
+            entry.maxNs = insert->maxNs.load();
+            entry.averageNs = entry.blocks > 0 ? static_cast<double>(insert->totalNs.load()) / entry.blocks : 0.0;
+            entry.budgetNs = insert->lastBudgetNs.load();
+            entry.bypassed = insert->bypassed.load();
+            statistics.push_back(std::move(entry));
+        }
+    }
+    return statistics;
+}
+
+void PluginInsertChain::reportOverruns(PerformanceMonitor& monitor) {
+    std::lock_guard<std::mutex> lock(layoutMutex_);
+    for (const auto& insert : current_->owned) {
+        double lastUs = insert->lastNs.load() / 1000.0;
+        double budgetUs = insert->lastBudgetNs.load() / 1000.0;
+        uint64_t overruns = insert->overruns.load();
+
+        if (insert->bypassAlertPending.exchange(false, std::memory_order_acquire)) {
+            monitor.reportAlert(PerformanceAlert::Severity::Critical, PerformanceAlert::Category::CPU,
+                                "Plugin " + insert->pluginName + " on channel " + std::to_string(insert->channel + 1) +
+                                " bypassed after exceeding its CPU budget",
+                                lastUs, budgetUs);
+        } else if (overruns > insert->reportedOverruns) {
+            monitor.reportAlert(PerformanceAlert::Severity::Warning, PerformanceAlert::Category::CPU,
+                                "Plugin " + insert->pluginName + " on channel " + std::to_string(insert->channel + 1) +
+                                " exceeded its CPU budget",
+                                lastUs, budgetUs);
+        }
+        insert->reportedOverruns = overruns;
+    }
+}
+
+void PluginInsertChain::attachMonitor(PerformanceMonitor& monitor) {
+    std::weak_ptr<PluginInsertChain> weakChain = weak_from_this();
+    PerformanceMonitor* monitorPtr = &monitor;
+    monitor.addMetricsCallback([weakChain, monitorPtr](const PerformanceMetrics&) {
+        if (auto chain = weakChain.lock()) {
+            chain->reportOverruns(*monitorPtr);
+        }
+    });
+}
+
+void PluginInsertChain::publish(std::unique_ptr<Layout> next) {
+    layout_.store(next.get());
+    std::unique_ptr<Layout> previous = std::move(current_);
+    current_ = std::move(next);
+
+    // Grace period: once no reader is inside process(), nobody can still hold the old layout
+    while (activeReaders_.load() != 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+std::unique_ptr<PluginInsertChain::Layout> PluginInsertChain::copyLayout() const {
+    auto copy = std::make_unique<Layout>(*current_);
+    copy->channels.resize(maxChannels_);
+    return copy;
+}
+
+std::shared_ptr<PluginInsertChain::Insert> PluginInsertChain::findInsert(const std::string& pluginName) const {
+    std::lock_guard<std::mutex> lock(layoutMutex_);
+    for (const auto& insert : current_->owned) {
+        if (insert->pluginName == pluginName) {
+            return insert;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+class BlockProcessor;
+class PerformanceMonitor;
+
+/**
+ * @brief Per-channel plugin insert stage for the live signal path
+ *
+ * Each input channel owns an ordered list of plugin inserts that process
+ * its samples in place, one block per audio callback. Every insert is timed
+ * against a CPU budget; a plugin that overruns the budget on several
+ * consecutive blocks (or fails a block) is bypassed on the spot and the
+ * overrun is reported later, off the audio thread, as a PerformanceMonitor
+ * alert.
+ *
+ * The insert layout is immutable once published. Control threads build a
+ * new layout, swap it in and wait until the audio thread has left the old
+ * one before freeing it, so process() never locks or allocates.
+ */
+class PluginInsertChain : public std::enable_shared_from_this<PluginInsertChain> {
+public:
+    struct InsertStatistics {
+        int channel = -1;
+        std::string pluginName;
+        uint64_t blocks = 0;
+        uint64_t overruns = 0;
+        int64_t lastNs = 0;
+        int64_t maxNs = 0;
+        double averageNs = 0.0;
+        int64_t budgetNs = 0;       // Budget for the most recent block
+        bool bypassed = false;
+    };
+
+    PluginInsertChain(int maxChannels, uint32_t maxFrames, double sampleRate = 48000.0);
+    ~PluginInsertChain();
+
+    PluginInsertChain(const PluginInsertChain&) = delete;
+    PluginInsertChain& operator=(const PluginInsertChain&) = delete;
+
+    // Layout (control thread). A plugin instance is stateful, so it may sit on one channel only.
+    bool attach(int channel, const std::string& pluginName, BlockProcessor* processor, int position = -1);
+    bool detach(int channel, const std::string& pluginName);
+    void detachPlugin(const std::string& pluginName);  // Returns once the audio thread no longer uses it
+    void clear();
+    std::vector<std::string> getInserts(int channel) const;
+    int getInsertChannel(const std::string& pluginName) const;  // -1 if not inserted
+
+    // Budget: fraction of the block period each insert may use, or an absolute per-insert override
+    void setBlockBudget(double fractionOfBlockPeriod);
+    double getBlockBudget() const { return budgetFraction_.load(); }
+    bool setInsertBudget(const std::string& pluginName, int64_t budgetNs);  // 0 restores the default
+    void setOverrunLimit(uint32_t consecutiveBlocks);
+    void setSampleRate(double sampleRate);
+
+    // Bypass control (any thread)
+    bool setBypassed(const std::string& pluginName, bool bypassed);
+    bool isBypassed(const std::string& pluginName) const;
+
+    // Real-time thread: process one mono block of a channel in place
+    void process(int channel, float* samples, uint32_t frames);
+
+    // Monitoring (control thread)
+    std::vector<InsertStatistics> getStatistics() const;
+    void reportOverruns(PerformanceMonitor& monitor);
+    void attachMonitor(PerformanceMonitor& monitor);  // Reports on every monitor update
+
+    int getMaxChannels() const { return maxChannels_; }
+    uint32_t getMaxFrames() const { return maxFrames_; }
+
+private:
+    struct Insert {
+        Insert(int channel, std::string name, BlockProcessor* processor);
+
+        const int channel;
+        const std::string pluginName;
+        BlockProcessor* const processor;
+
+        std::atomic<int64_t> budgetOverrideNs{0};
+        std::atomic<bool> bypassed{false};
+        std::atomic<bool> bypassAlertPending{false};
+
+        // Written by the audio thread only
+        std::atomic<uint64_t> blocks{0};
+        std::atomic<uint64_t> overruns{0};
+        std::atomic<int64_t> totalNs{0};
+        std::atomic<int64_t> lastNs{0};
+        std::atomic<int64_t> maxNs{0};
+        std::atomic<int64_t> lastBudgetNs{0};
+        uint32_t consecutiveOverruns = 0;
+
+        // Control thread only
+        uint64_t reportedOverruns = 0;
+    };
+
+    struct Layout {
+        std::vector<std::vector<Insert*>> channels;
+        std::vector<std::shared_ptr<Insert>> owned;  // Keeps inserts alive while this layout is live
+    };
+
+    const int maxChannels_;
+    const uint32_t maxFrames_;
+    std::atomic<double> sampleRate_;
+    std::atomic<double> budgetFraction_{0.25};
+    std::atomic<uint32_t> overrunLimit_{3};
+
+    std::atomic<const Layout*> layout_{nullptr};
+    std::atomic<uint32_t> activeReaders_{0};
+    std::unique_ptr<Layout> current_;       // Owner of the published layout
+    mutable std::mutex layoutMutex_;
+
+    std::vector<float> scratch_;             // Input copy for processors that cannot run in place
+
+    void publish(std::unique_ptr<Layout> next);
+    std::unique_ptr<Layout> copyLayout() const;
+    std::shared_ptr<Insert> findInsert(const std::string& pluginName) const;
+    void bypass(Insert& insert);
+};
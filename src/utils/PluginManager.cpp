@@ -2,9 +2,125 @@
 #include <iostream>
 #include <filesystem>
 #include <algorithm>
+#include <cstring>
+
+// BlockProcessor implementation
+BlockProcessor::BlockProcessor(const cvosc_plugin_descriptor* descriptor, void* instance,
+                               uint32_t maxChannels, uint32_t maxFrames)
+    : descriptor_(descriptor), instance_(instance), maxChannels_(maxChannels), maxFrames_(maxFrames) {
+    if (!supportsInPlace()) {
+        inputScratch_.resize(maxFrames_);
+    }
+}
+
+BlockProcessor::BlockProcessor(ISignalProcessor* legacy, uint32_t maxChannels, uint32_t maxFrames)
+    : legacy_(legacy), maxChannels_(maxChannels), maxFrames_(maxFrames) {
+    legacyParameterNames_ = legacy_->getParameterNames();
+}
+
+BlockProcessor::BlockProcessor(PluginSandbox* sandbox)
+    : sandbox_(sandbox), maxChannels_(sandbox->getMaxChannels()), maxFrames_(sandbox->getMaxFrames()) {
+}
+
+int32_t BlockProcessor::findParameter(const std::string& name) const {
+    if (sandbox_) {
+        for (const auto& parameter : sandbox_->getParameters()) {
+            if (parameter.name == name) {
+                return static_cast<int32_t>(parameter.id);
+            }
+        }
+        return -1;
+    }
+    if (legacy_) {
+        auto it = std::find(legacyParameterNames_.begin(), legacyParameterNames_.end(), name);
+        return it != legacyParameterNames_.end() ? static_cast<int32_t>(it - legacyParameterNames_.begin()) : -1;
+    }
+    for (uint32_t i = 0; i < descriptor_->parameter_count; i++) {
+        const cvosc_parameter_info& parameter = descriptor_->parameters[i];
+        if (parameter.name && name == parameter.name) {
+            return static_cast<int32_t>(parameter.id);
+        }
+    }
+    return -1;
+}
+
+bool BlockProcessor::reset() {
+    if (legacy_ || sandbox_) {
+        return true;
+    }
+    return !descriptor_->reset || descriptor_->reset(instance_) == CVOSC_OK;
+}
+
+bool BlockProcessor::process(const cvosc_process_block& block) {
+    if (block.num_channels > maxChannels_ || block.num_frames > maxFrames_) {
+        return false;
+    }
+    
+    if (sandbox_) {
+        sandbox_->process(block);
+        return true; // Late or restarting hosts degrade to the dry signal, never to an error
+    }
+    
+    if (!legacy_) {
+        return descriptor_->process(instance_, &block) == CVOSC_OK;
+    }
+    
+    // Legacy plugins only process in place, one channel at a time
+    for (uint32_t channel = 0; channel < block.num_channels; channel++) {
+        float* output = block.outputs[channel];
+        if (output != block.inputs[channel]) {
+            std::memcpy(output, block.inputs[channel], block.num_frames * sizeof(float));
+        }
+        legacy_->processSamples(output, static_cast<int>(block.num_frames));
+    }
+    return true;
+}
+
+bool BlockProcessor::setParameter(uint32_t id, float value) {
+    if (sandbox_) {
+        return sandbox_->setParameter(id, value);
+    }
+    if (legacy_) {
+        if (id >= legacyParameterNames_.size()) {
+            return false;
+        }
+        legacy_->setParameter(legacyParameterNames_[id], value);
+        return true;
+    }
+    return descriptor_->set_parameter && descriptor_->set_parameter(instance_, id, value) == CVOSC_OK;
+}
+
+float BlockProcessor::getParameter(uint32_t id) const {
+    if (sandbox_) {
+        return sandbox_->getParameter(id);
+    }
+    if (legacy_) {
+        return id < legacyParameterNames_.size() ? legacy_->getParameter(legacyParameterNames_[id]) : 0.0f;
+    }
+    return descriptor_->get_parameter ? descriptor_->get_parameter(instance_, id) : 0.0f;
+}
+
+bool BlockProcessor::supportsInPlace() const {
+    return legacy_ || sandbox_ || (descriptor_->flags & CVOSC_PLUGIN_FLAG_IN_PLACE);
+}
+
+bool BlockProcessor::isRealTimeSafe() const {
+    if (sandbox_) {
+        return true; // The host process may misbehave; the handoff never blocks
+    }
+    return !legacy_ && (descriptor_->flags & CVOSC_PLUGIN_FLAG_RT_SAFE);
+}
+
+// PluginManager implementation
 
 PluginManager::PluginManager() 
-    : hotLoadingEnabled_(false), running_(false) {
+    : hotLoadingEnabled_(false), running_(false)
+    , insertChain_(std::make_shared<PluginInsertChain>(static_cast<int>(maxChannels_), maxFrames_, sampleRate_)) {
+}
+
+PluginManager::PluginManager(std::shared_ptr<PluginInsertChain> insertChain)
+    : hotLoadingEnabled_(false), running_(false)
+    , insertChain_(std::move(insertChain)) {
 }
 
 PluginManager::~PluginManager() {
@@ -80,6 +196,37 @@ bool PluginManager::loadPlugin(const std::string& filename) {
     return true;
 }
 
+bool PluginManager::loadPluginSandboxed(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(pluginsMutex_);
+    
+    if (!std::filesystem::exists(filename)) {
+        lastError_ = "Plugin file does not exist: " + filename;
+        return false;
+    }
+    
+    LoadedPlugin plugin;
+    if (!loadSandboxedFromFile(filename, plugin)) {
+        return false;
+    }
+    
+    if (loadedPlugins_.find(plugin.info.name) != loadedPlugins_.end()) {
+        lastError_ = "Plugin with name '" + plugin.info.name + "' is already loaded";
+        unloadPluginHandle(plugin);
+        return false;
+    }
+    
+    std::string name = plugin.info.name;
+    loadedPlugins_[name] = std::move(plugin);
+    std::cout << "Plugin loaded in sandbox: " << name << std::endl;
+    
+    return true;
+}
+
+void PluginManager::setSandboxHostPath(const std::string& path) {
+    std::lock_guard<std::mutex> lock(pluginsMutex_);
+    sandboxHostPath_ = path;
+}
+
 bool PluginManager::unloadPlugin(const std::string& pluginName) {
     std::lock_guard<std::mutex> lock(pluginsMutex_);
     
@@ -93,6 +240,7 @@ bool PluginManager::unloadPlugin(const std::string& pluginName) {
     if (chainIt != processingChain_.end()) {
         processingChain_.erase(chainIt);
     }
+    insertChain_->detachPlugin(pluginName);
     
     // Shutdown and unload plugin
     if (it->second.plugin) {
@@ -109,6 +257,7 @@ bool PluginManager::unloadPlugin(const std::string& pluginName) {
 void PluginManager::unloadAllPlugins() {
     std::lock_guard<std::mutex> lock(pluginsMutex_);
     
+    insertChain_->clear();
     for (auto& [name, plugin] : loadedPlugins_) {
         if (plugin.plugin) {
             plugin.plugin->shutdown();
@@ -158,11 +307,19 @@ bool PluginManager::enablePlugin(const std::string& pluginName) {
         return false;
     }
     
-    if (!it->second.plugin) {
+    if (!it->second.plugin && !it->second.instance && !it->second.sandbox) {
         lastError_ = "Plugin instance is null: " + pluginName;
         return false;
     }
     
+    // C ABI plugins are live as soon as their instance exists
+    if (!it->second.plugin) {
+        it->second.enabled = true;
+        it->second.info.enabled = true;
+        std::cout << "Plugin enabled: " << pluginName << std::endl;
+        return true;
+    }
+    
     if (!it->second.enabled) {
         if (it->second.plugin->initialize()) {
             it->second.enabled = true;
@@ -188,16 +345,19 @@ bool PluginManager::disablePlugin(const std::string& pluginName) {
         return true; // Not loaded
     }
     
-    if (it->second.enabled && it->second.plugin) {
-        it->second.plugin->setEnabled(false);
+    if (it->second.enabled) {
+        if (it->second.plugin) {
+            it->second.plugin->setEnabled(false);
+        }
         it->second.enabled = false;
         it->second.info.enabled = false;
         
-        // Remove from processing chain
+        // Remove from processing chain and live inserts
         auto chainIt = std::find(processingChain_.begin(), processingChain_.end(), pluginName);
         if (chainIt != processingChain_.end()) {
             processingChain_.erase(chainIt);
         }
+        insertChain_->detachPlugin(pluginName);
         
         std::cout << "Plugin disabled: " << pluginName << std::endl;
     }
@@ -238,6 +398,36 @@ ICVMapper* PluginManager::getCVMapper(const std::string& pluginName) {
     return dynamic_cast<ICVMapper*>(plugin);
 }
 
+BlockProcessor* PluginManager::getBlockProcessor(const std::string& pluginName) {
+    std::lock_guard<std::mutex> lock(pluginsMutex_);
+    
+    auto it = loadedPlugins_.find(pluginName);
+    if (it != loadedPlugins_.end() && it->second.enabled) {
+        return it->second.blockProcessor.get();
+    }
+    
+    return nullptr;
+}
+
+void PluginManager::setBlockGeometry(double sampleRate, uint32_t maxChannels, uint32_t maxFrames) {
+    // Applies to plugins loaded afterwards; existing instances keep their geometry
+    std::lock_guard<std::mutex> lock(pluginsMutex_);
+    sampleRate_ = sampleRate;
+    maxChannels_ = maxChannels;
+    maxFrames_ = maxFrames;
+    insertChain_->setSampleRate(sampleRate);
+}
+
+bool PluginManager::isProcessorPlugin(const LoadedPlugin& plugin) const {
+    if (plugin.sandbox) {
+        return plugin.sandbox->getPluginKind() == CVOSC_PLUGIN_SIGNAL_PROCESSOR;
+    }
+    if (plugin.descriptor) {
+        return plugin.descriptor->kind == CVOSC_PLUGIN_SIGNAL_PROCESSOR;
+    }
+    return dynamic_cast<ISignalProcessor*>(plugin.plugin.get()) != nullptr;
+}
+
 bool PluginManager::addToProcessingChain(const std::string& pluginName, int position) {
     std::lock_guard<std::mutex> lock(pluginsMutex_);
     
@@ -249,8 +439,7 @@ bool PluginManager::addToProcessingChain(const std::string& pluginName, int posi
     }
     
     // Check if it's a signal processor
-    ISignalProcessor* processor = dynamic_cast<ISignalProcessor*>(it->second.plugin.get());
-    if (!processor) {
+    if (!isProcessorPlugin(it->second)) {
         lastError_ = "Plugin is not a signal processor: " + pluginName;
         return false;
     }
@@ -285,6 +474,43 @@ bool PluginManager::removeFromProcessingChain(const std::string& pluginName) {
     return false;
 }
 
+bool PluginManager::insertPlugin(int channel, const std::string& pluginName, int position) {
+    std::lock_guard<std::mutex> lock(pluginsMutex_);
+    
+    auto it = loadedPlugins_.find(pluginName);
+    if (it == loadedPlugins_.end() || !it->second.enabled) {
+        lastError_ = "Plugin not loaded or not enabled: " + pluginName;
+        return false;
+    }
+    
+    if (!isProcessorPlugin(it->second) || !it->second.blockProcessor) {
+        lastError_ = "Plugin is not a signal processor: " + pluginName;
+        return false;
+    }
+    
+    // Moving an insert to another channel or position
+    insertChain_->detachPlugin(pluginName);
+    
+    if (!insertChain_->attach(channel, pluginName, it->second.blockProcessor.get(), position)) {
+        lastError_ = "Invalid insert channel: " + std::to_string(channel);
+        return false;
+    }
+    
+    std::cout << "Plugin inserted on channel " << (channel + 1) << ": " << pluginName << std::endl;
+    return true;
+}
+
+bool PluginManager::removeInsert(const std::string& pluginName) {
+    std::lock_guard<std::mutex> lock(pluginsMutex_);
+    
+    if (insertChain_->getInsertChannel(pluginName) < 0) {
+        return false;
+    }
+    insertChain_->detachPlugin(pluginName);
+    std::cout << "Plugin insert removed: " << pluginName << std::endl;
+    return true;
+}
+
 std::vector<std::string> PluginManager::getProcessingChain() const {
     std::lock_guard<std::mutex> lock(pluginsMutex_);
     return processingChain_;
@@ -301,6 +527,8 @@ std::vector<float> PluginManager::processSignalChain(const std::vector<float>& i
             ISignalProcessor* processor = dynamic_cast<ISignalProcessor*>(it->second.plugin.get());
             if (processor) {
                 output = processor->processSignal(output);
+            } else if (it->second.blockProcessor) {
+                processMonoInPlace(*it->second.blockProcessor, output);
             }
         }
     }
@@ -317,11 +545,33 @@ void PluginManager::processSignalChainInPlace(std::vector<float>& signal) {
             ISignalProcessor* processor = dynamic_cast<ISignalProcessor*>(it->second.plugin.get());
             if (processor) {
                 processor->processSignalInPlace(signal);
+            } else if (it->second.blockProcessor) {
+                processMonoInPlace(*it->second.blockProcessor, signal);
             }
         }
     }
 }
 
+void PluginManager::processMonoInPlace(BlockProcessor& processor, std::vector<float>& signal) {
+    // Feed the vector through the block interface as a single channel, max-frame chunks
+    size_t offset = 0;
+    while (offset < signal.size()) {
+        uint32_t frames = static_cast<uint32_t>(std::min<size_t>(signal.size() - offset, processor.getMaxFrames()));
+        float* channel = signal.data() + offset;
+        cvosc_process_block block{1, frames, &channel, &channel, 0};
+        float* scratch = processor.getInputScratch();
+        if (scratch) {
+            std::memcpy(scratch, channel, frames * sizeof(float));
+            const float* input = scratch;
+            block.inputs = &input;
+            processor.process(block);
+        } else {
+            processor.process(block);
+        }
+        offset += frames;
+    }
+}
+
 void PluginManager::enableHotLoading(bool enable) {
     hotLoadingEnabled_ = enable;
     
@@ -340,11 +590,13 @@ bool PluginManager::validatePlugin(const std::string& filename) const {
         return false;
     }
     
-    bool valid = validatePluginSymbols(handle);
-    
-    if (valid) {
-        int apiVersion = getPluginAPIVersion(handle);
-        valid = isAPICompatible(apiVersion);
+    bool valid;
+    auto entry = reinterpret_cast<cvosc_plugin_entry_fn>(dlsym(handle, CVOSC_PLUGIN_ENTRY_SYMBOL));
+    if (entry) {
+        const cvosc_plugin_descriptor* descriptor = entry(PLUGIN_API_VERSION);
+        valid = descriptor && isAPICompatible(static_cast<int>(descriptor->abi_version));
+    } else {
+        valid = validatePluginSymbols(handle) && isAPICompatible(getPluginAPIVersion(handle));
     }
     
     dlclose(handle);
@@ -352,7 +604,7 @@ bool PluginManager::validatePlugin(const std::string& filename) const {
 }
 
 bool PluginManager::isAPICompatible(int pluginApiVersion) const {
-    return pluginApiVersion == PLUGIN_API_VERSION;
+    return pluginApiVersion == PLUGIN_API_VERSION || pluginApiVersion == PLUGIN_LEGACY_API_VERSION;
 }
 
 // Private methods
@@ -363,6 +615,11 @@ bool PluginManager::loadPluginFromFile(const std::string& filename, LoadedPlugin
         return false;
     }
     
+    // Prefer the v2 C entry point, fall back to the legacy C++ factory symbols
+    if (dlsym(plugin.handle, CVOSC_PLUGIN_ENTRY_SYMBOL)) {
+        return loadCPluginFromHandle(filename, plugin);
+    }
+    
     // Validate plugin symbols
     if (!validatePluginSymbols(plugin.handle)) {
         lastError_ = "Plugin missing required symbols";
@@ -373,9 +630,9 @@ bool PluginManager::loadPluginFromFile(const std::string& filename, LoadedPlugin
     
     // Check API compatibility
     int apiVersion = getPluginAPIVersion(plugin.handle);
-    if (!isAPICompatible(apiVersion)) {
+    if (apiVersion != PLUGIN_LEGACY_API_VERSION) {
         lastError_ = "Plugin API version incompatible. Expected: " + 
-                    std::to_string(PLUGIN_API_VERSION) + ", Got: " + std::to_string(apiVersion);
+                    std::to_string(PLUGIN_LEGACY_API_VERSION) + ", Got: " + std::to_string(apiVersion);
         dlclose(plugin.handle);
         plugin.handle = nullptr;
         return false;
@@ -393,6 +650,9 @@ bool PluginManager::loadPluginFromFile(const std::string& filename, LoadedPlugin
     if (createPluginFunc) {
         plugin.plugin.reset(createPluginFunc());
         if (plugin.plugin) {
+            if (auto* processor = dynamic_cast<ISignalProcessor*>(plugin.plugin.get())) {
+                plugin.blockProcessor = std::make_unique<BlockProcessor>(processor, maxChannels_, maxFrames_);
+            }
             plugin.enabled = false;
             plugin.lastModified = getFileModificationTime(filename);
             return true;
@@ -405,7 +665,59 @@ bool PluginManager::loadPluginFromFile(const std::string& filename, LoadedPlugin
     return false;
 }
 
+bool PluginManager::loadCPluginFromHandle(const std::string& filename, LoadedPlugin& plugin) {
+    auto entry = reinterpret_cast<cvosc_plugin_entry_fn>(dlsym(plugin.handle, CVOSC_PLUGIN_ENTRY_SYMBOL));
+    const cvosc_plugin_descriptor* descriptor = entry ? entry(PLUGIN_API_VERSION) : nullptr;
+    
+    if (!descriptor || descriptor->abi_version != PLUGIN_API_VERSION ||
+        descriptor->struct_size < sizeof(cvosc_plugin_descriptor)) {
+        lastError_ = "Plugin API version incompatible. Expected: " + std::to_string(PLUGIN_API_VERSION) +
+                    ", Got: " + std::to_string(descriptor ? descriptor->abi_version : 0);
+        dlclose(plugin.handle);
+        plugin.handle = nullptr;
+        return false;
+    }
+    
+    if (!descriptor->create || !descriptor->destroy || !descriptor->process || !descriptor->name) {
+        lastError_ = "Plugin missing required symbols";
+        dlclose(plugin.handle);
+        plugin.handle = nullptr;
+        return false;
+    }
+    
+    plugin.info.name = descriptor->name;
+    plugin.info.version = descriptor->version ? descriptor->version : "";
+    plugin.info.author = descriptor->author ? descriptor->author : "";
+    plugin.info.description = descriptor->description ? descriptor->description : "";
+    plugin.info.type = descriptor->kind == CVOSC_PLUGIN_CV_MAPPER ? PluginType::CV_MAPPER : PluginType::SIGNAL_PROCESSOR;
+    plugin.info.apiVersion = static_cast<int>(descriptor->abi_version);
+    plugin.info.filename = filename;
+    
+    plugin.instance = descriptor->create(sampleRate_, maxChannels_, maxFrames_);
+    if (!plugin.instance) {
+        lastError_ = "Failed to create plugin instance";
+        dlclose(plugin.handle);
+        plugin.handle = nullptr;
+        return false;
+    }
+    
+    plugin.descriptor = descriptor;
+    plugin.blockProcessor = std::make_unique<BlockProcessor>(descriptor, plugin.instance, maxChannels_, maxFrames_);
+    plugin.enabled = false;
+    plugin.lastModified = getFileModificationTime(filename);
+    return true;
+}
+
 void PluginManager::unloadPluginHandle(LoadedPlugin& plugin) {
+    plugin.blockProcessor.reset();
+    plugin.sandbox.reset();
+    
+    if (plugin.descriptor && plugin.instance) {
+        plugin.descriptor->destroy(plugin.instance);
+    }
+    plugin.instance = nullptr;
+    plugin.descriptor = nullptr;
+    
     if (plugin.plugin && plugin.handle) {
         DestroyPluginFunc destroyPluginFunc = (DestroyPluginFunc)dlsym(plugin.handle, "destroyPlugin");
         if (destroyPluginFunc) {
@@ -421,6 +733,31 @@ void PluginManager::unloadPluginHandle(LoadedPlugin& plugin) {
     }
 }
 
+bool PluginManager::loadSandboxedFromFile(const std::string& filename, LoadedPlugin& plugin) {
+    // The library is only opened inside the host process
+    plugin.handle = nullptr;
+    plugin.sandbox = std::make_unique<PluginSandbox>(maxChannels_, maxFrames_, sampleRate_);
+    if (!plugin.sandbox->start(sandboxHostPath_, filename)) {
+        lastError_ = "Failed to start sandboxed plugin host for " + filename;
+        plugin.sandbox.reset();
+        return false;
+    }
+    
+    plugin.info.name = plugin.sandbox->getPluginName();
+    if (plugin.info.name.empty()) {
+        plugin.info.name = std::filesystem::path(filename).stem().string();
+    }
+    plugin.info.type = plugin.sandbox->getPluginKind() == CVOSC_PLUGIN_CV_MAPPER ? PluginType::CV_MAPPER
+                                                                                 : PluginType::SIGNAL_PROCESSOR;
+    plugin.info.apiVersion = PLUGIN_API_VERSION;
+    plugin.info.filename = filename;
+    plugin.info.description = "Sandboxed";
+    plugin.blockProcessor = std::make_unique<BlockProcessor>(plugin.sandbox.get());
+    plugin.enabled = false;
+    plugin.lastModified = getFileModificationTime(filename);
+    return true;
+}
+
 bool PluginManager::validatePluginSymbols(void* handle) const {
     // Check for required symbols
     if (!dlsym(handle, "createPlugin")) return false;
@@ -470,8 +807,13 @@ void PluginManager::checkForUpdates() {
                 
                 // Save current state
                 bool wasEnabled = plugin.enabled;
+                bool sandboxed = plugin.sandbox != nullptr;
                 auto config = plugin.config;
                 
+                // Take the old instance out of the audio path before its code is unmapped
+                int insertChannel = insertChain_->getInsertChannel(name);
+                insertChain_->detachPlugin(name);
+                
                 // Unload current plugin
                 if (plugin.plugin) {
                     plugin.plugin->shutdown();
@@ -479,10 +821,15 @@ void PluginManager::checkForUpdates() {
                 unloadPluginHandle(plugin);
                 
                 // Reload plugin
-                if (loadPluginFromFile(plugin.info.filename, plugin)) {
+                std::string filename = plugin.info.filename;
+                bool reloaded = sandboxed ? loadSandboxedFromFile(filename, plugin)
+                                          : loadPluginFromFile(filename, plugin);
+                if (reloaded) {
                     plugin.config = config;
                     
-                    if (wasEnabled) {
+                    if (wasEnabled && !plugin.plugin) {
+                        plugin.enabled = true;
+                    } else if (wasEnabled) {
                         if (plugin.plugin->initialize()) {
                             plugin.plugin->configure(config);
                             plugin.plugin->setEnabled(true);
@@ -490,6 +837,10 @@ void PluginManager::checkForUpdates() {
                         }
                     }
                     
+                    if (insertChannel >= 0 && plugin.enabled && plugin.blockProcessor) {
+                        insertChain_->attach(insertChannel, name, plugin.blockProcessor.get());
+                    }
+                    
                     std::cout << "Plugin reloaded successfully: " << name << std::endl;
                 } else {
                     std::cerr << "Failed to reload plugin: " << name << std::endl;
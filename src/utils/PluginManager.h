@@ -23,8 +23,10 @@
     #include <dlfcn.h>
 #endif
 
-// Plugin API version
-#define PLUGIN_API_VERSION 1
+// Plugin API version and C ABI (PLUGIN_API_VERSION, cvosc_plugin_descriptor)
+#include "PluginABI.h"
+#include "PluginInsertChain.h"
+#include "PluginSandbox.h"
 
 /**
  * @brief Plugin types
@@ -127,17 +129,66 @@ public:
     virtual void resetCalibration(int channel) = 0;
 };
 
+/**
+ * @brief Host-side block processing handle for a loaded plugin
+ *
+ * Wraps a v2 C ABI instance, a legacy ISignalProcessor or a plugin running
+ * in a PluginSandbox host process behind one planar block interface.
+ * Parameter names are resolved to ids once on a control thread; process()
+ * and setParameter() follow the [RT] contract in PluginABI.h (legacy plugins
+ * only as far as their own code allows; sandboxed parameters are set from a
+ * control thread).
+ */
+class BlockProcessor {
+public:
+    BlockProcessor(const cvosc_plugin_descriptor* descriptor, void* instance,
+                   uint32_t maxChannels, uint32_t maxFrames);
+    BlockProcessor(ISignalProcessor* legacy, uint32_t maxChannels, uint32_t maxFrames);
+    explicit BlockProcessor(PluginSandbox* sandbox);
+    
+    // Control thread
+    int32_t findParameter(const std::string& name) const;
+    bool reset();
+    
+    // Real-time thread
+    bool process(const cvosc_process_block& block);
+    bool setParameter(uint32_t id, float value);
+    float getParameter(uint32_t id) const;
+    
+    bool supportsInPlace() const;
+    bool isRealTimeSafe() const;
+    bool isLegacy() const { return legacy_ != nullptr; }
+    bool isSandboxed() const { return sandbox_ != nullptr; }
+    uint32_t getMaxChannels() const { return maxChannels_; }
+    uint32_t getMaxFrames() const { return maxFrames_; }
+    // maxFrames of input copy for plugins that cannot process in place; null otherwise
+    float* getInputScratch() { return inputScratch_.empty() ? nullptr : inputScratch_.data(); }
+    
+private:
+    const cvosc_plugin_descriptor* descriptor_ = nullptr;
+    void* instance_ = nullptr;
+    ISignalProcessor* legacy_ = nullptr;
+    PluginSandbox* sandbox_ = nullptr;
+    std::vector<std::string> legacyParameterNames_;  // Index is the parameter id
+    std::vector<float> inputScratch_;
+    uint32_t maxChannels_;
+    uint32_t maxFrames_;
+};
+
 /**
  * @brief Plugin manager class
  */
 class PluginManager {
 public:
     PluginManager();
+    explicit PluginManager(std::shared_ptr<PluginInsertChain> insertChain);  // Inserts go into a chain owned elsewhere
     ~PluginManager();
     
     // Plugin discovery and loading
     bool scanPluginDirectory(const std::string& directory);
     bool loadPlugin(const std::string& filename);
+    bool loadPluginSandboxed(const std::string& filename);  // Runs in a separate host process
+    void setSandboxHostPath(const std::string& path);
     bool unloadPlugin(const std::string& pluginName);
     void unloadAllPlugins();
     
@@ -155,6 +206,10 @@ public:
     IPlugin* getPlugin(const std::string& pluginName);
     ISignalProcessor* getSignalProcessor(const std::string& pluginName);
     ICVMapper* getCVMapper(const std::string& pluginName);
+    BlockProcessor* getBlockProcessor(const std::string& pluginName);
+    
+    // Block geometry used when instantiating plugins
+    void setBlockGeometry(double sampleRate, uint32_t maxChannels, uint32_t maxFrames);
     
     // Plugin configuration
     bool configurePlugin(const std::string& pluginName, const std::map<std::string, std::string>& config);
@@ -175,6 +230,11 @@ public:
     std::vector<float> processSignalChain(const std::vector<float>& input);
     void processSignalChainInPlace(std::vector<float>& signal);
     
+    // Live per-channel insert stage, driven by the audio callback
+    std::shared_ptr<PluginInsertChain> getInsertChain() const { return insertChain_; }
+    bool insertPlugin(int channel, const std::string& pluginName, int position = -1);
+    bool removeInsert(const std::string& pluginName);
+    
     // Error handling
     std::string getLastError() const { return lastError_; }
     
@@ -185,7 +245,11 @@ public:
 private:
     struct LoadedPlugin {
         void* handle;
-        std::unique_ptr<IPlugin> plugin;
+        std::unique_ptr<IPlugin> plugin;              // Legacy C++ plugins
+        const cvosc_plugin_descriptor* descriptor = nullptr;  // v2 C ABI plugins
+        void* instance = nullptr;
+        std::unique_ptr<PluginSandbox> sandbox;      // Out-of-process plugins
+        std::unique_ptr<BlockProcessor> blockProcessor;
         PluginInfo info;
         std::map<std::string, std::string> config;
         bool enabled;
@@ -203,9 +267,20 @@ private:
     std::string lastError_;
     mutable std::mutex pluginsMutex_;
     
+    double sampleRate_ = 48000.0;
+    uint32_t maxChannels_ = 16;
+    uint32_t maxFrames_ = 512;
+    
+    std::shared_ptr<PluginInsertChain> insertChain_;
+    std::string sandboxHostPath_ = "cvosc_plugin_host";
+    
     // Internal methods
     void hotLoadingLoop();
     bool loadPluginFromFile(const std::string& filename, LoadedPlugin& plugin);
+    bool loadCPluginFromHandle(const std::string& filename, LoadedPlugin& plugin);
+    bool loadSandboxedFromFile(const std::string& filename, LoadedPlugin& plugin);
+    bool isProcessorPlugin(const LoadedPlugin& plugin) const;
+    static void processMonoInPlace(BlockProcessor& processor, std::vector<float>& signal);
     void unloadPluginHandle(LoadedPlugin& plugin);
     std::filesystem::file_time_type getFileModificationTime(const std::string& filename);
     
@@ -220,12 +295,13 @@ private:
     typedef PluginInfo (*GetPluginInfoFunc)();
 };
 
-// Plugin factory macros for plugin developers
+// Plugin factory macros for plugin developers (legacy C++ interface, API version 1).
+// New plugins should export cvosc_plugin_entry_v2 from PluginABI.h instead.
 #define DECLARE_PLUGIN(ClassName) \
     extern "C" { \
         IPlugin* createPlugin() { return new ClassName(); } \
         void destroyPlugin(IPlugin* plugin) { delete plugin; } \
-        int getAPIVersion() { return PLUGIN_API_VERSION; } \
+        int getAPIVersion() { return PLUGIN_LEGACY_API_VERSION; } \
         PluginInfo getPluginInfo() { \
             ClassName temp; \
             return temp.getInfo(); \
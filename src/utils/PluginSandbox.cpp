@@ -0,0 +1,750 @@
+#include "PluginSandbox.h"
+#include "PluginManager.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#ifdef __linux__
+    #include <dirent.h>
+    #include <linux/futex.h>
+    #include <sys/prctl.h>
+    #include <sys/syscall.h>
+#elif defined(__APPLE__)
+    #include <mach/mach.h>
+#endif
+
+namespace {
+
+constexpr uint32_t SANDBOX_MAGIC = 0x42535643;  // "CVSB"
+constexpr uint32_t SLOT_COUNT = 2;
+constexpr uint32_t PARAMETER_RING_SIZE = 64;
+constexpr uint32_t MAX_PARAMETER_NAMES = 32;
+
+enum HostState : uint32_t {
+    HOST_STARTING = 0,
+    HOST_READY = 1,
+    HOST_FAILED = 2
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex words must be lock-free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared counters must be lock-free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain 32-bit");
+
+#ifdef __linux__
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected, int timeoutMs) {
+    timespec timeout{timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+#else
+// No cross-process futex: poll the word at 100 us granularity
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected, int timeoutMs) {
+    for (int waited = 0; waited < timeoutMs * 10 && word->load() == expected; waited++) {
+        usleep(100);
+    }
+}
+
+void futexWake(std::atomic<uint32_t>*) {
+}
+#endif
+
+// Threads in this process, 0 if unknown
+size_t countThreads() {
+#ifdef __linux__
+    DIR* tasks = opendir("/proc/self/task");
+    if (!tasks) {
+        return 0;
+    }
+    size_t count = 0;
+    while (dirent* entry = readdir(tasks)) {
+        count += entry->d_name[0] != '.';
+    }
+    closedir(tasks);
+    return count;
+#elif defined(__APPLE__)
+    thread_act_array_t threads = nullptr;
+    mach_msg_type_number_t count = 0;
+    if (task_threads(mach_task_self(), &threads, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    for (mach_msg_type_number_t i = 0; i < count; i++) {
+        mach_port_deallocate(mach_task_self(), threads[i]);
+    }
+    vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(threads), count * sizeof(thread_act_t));
+    return count;
+#else
+    return 0;
+#endif
+}
+
+} // namespace
+
+struct SandboxParameterEntry {
+    uint32_t id;
+    float value;
+};
+
+struct SandboxParameterName {
+    uint32_t id;
+    char name[32];
+};
+
+/**
+ * Shared between the converter and the plugin host. Both sides map the same
+ * object; only lock-free 32/64-bit atomics and plain data live here.
+ */
+struct SandboxRegion {
+    // Written once by the converter before the host starts
+    uint32_t magic;
+    uint32_t maxChannels;
+    uint32_t maxFrames;
+    uint32_t reserved;
+    double sampleRate;
+    uint64_t size;
+
+    // Host handshake
+    alignas(64) std::atomic<uint32_t> hostState;
+    std::atomic<uint32_t> shutdown;
+    uint32_t pluginKind;
+    uint32_t parameterCount;
+    char pluginName[64];
+    SandboxParameterName parameterNames[MAX_PARAMETER_NAMES];
+
+    // Block ring: the converter advances submitted, the host advances completed
+    alignas(64) std::atomic<uint32_t> submitted;
+    std::atomic<uint32_t> hostSleeping;
+    alignas(64) std::atomic<uint32_t> completed;
+    std::atomic<uint64_t> heartbeat;
+    alignas(64) uint32_t slotFrames[SLOT_COUNT];
+    uint32_t slotChannels[SLOT_COUNT];
+    uint64_t slotPosition[SLOT_COUNT];
+
+    // Parameter changes, converter -> host
+    alignas(64) std::atomic<uint32_t> parameterHead;
+    alignas(64) std::atomic<uint32_t> parameterTail;
+    SandboxParameterEntry parameterRing[PARAMETER_RING_SIZE];
+
+    static size_t dataOffset() { return (sizeof(SandboxRegion) + 63) & ~static_cast<size_t>(63); }
+
+    static size_t bytesFor(uint32_t channels, uint32_t frames) {
+        return dataOffset() + static_cast<size_t>(SLOT_COUNT) * 2 * channels * frames * sizeof(float);
+    }
+
+    float* samples() { return reinterpret_cast<float*>(reinterpret_cast<char*>(this) + dataOffset()); }
+    float* input(uint32_t slot, uint32_t channel) { return samples() + ((slot * 2) * maxChannels + channel) * maxFrames; }
+    float* output(uint32_t slot, uint32_t channel) { return samples() + ((slot * 2 + 1) * maxChannels + channel) * maxFrames; }
+};
+
+// PluginSandbox implementation
+PluginSandbox::PluginSandbox(uint32_t maxChannels, uint32_t maxFrames, double sampleRate)
+    : maxChannels_(std::max<uint32_t>(1, maxChannels))
+    , maxFrames_(std::max<uint32_t>(1, maxFrames))
+    , sampleRate_(sampleRate) {
+    delay_[0].assign(static_cast<size_t>(maxChannels_) * maxFrames_, 0.0f);
+    delay_[1].assign(static_cast<size_t>(maxChannels_) * maxFrames_, 0.0f);
+}
+
+PluginSandbox::~PluginSandbox() {
+    stop();
+}
+
+bool PluginSandbox::start(const std::string& hostExecutable, const std::string& pluginPath) {
+    stop();
+    hostExecutable_ = hostExecutable;
+    pluginPath_ = pluginPath;
+    descriptor_ = nullptr;
+
+    if (!createRegion()) {
+        return false;
+    }
+    if (!launch()) {
+        killHost();
+        destroyRegion();
+        return false;
+    }
+
+    healthy_.store(true);
+    watchdogRunning_.store(true);
+    watchdogThread_ = std::thread(&PluginSandbox::watchdogLoop, this);
+    return true;
+}
+
+bool PluginSandbox::start(const cvosc_plugin_descriptor* descriptor) {
+    if (!descriptor || !descriptor->create || !descriptor->process) {
+        return false;
+    }
+    stop();
+    // The forked child runs plugin code, which allocates: another thread could
+    // hold a lock it needs (iostream, a plugin's own) frozen in the copy
+    if (countThreads() > 1) {
+        std::cerr << "Plugin sandbox: fork mode needs a single-threaded caller; use a host executable" << std::endl;
+        return false;
+    }
+    hostExecutable_.clear();
+    pluginPath_.clear();
+    descriptor_ = descriptor;
+
+    if (!createRegion()) {
+        return false;
+    }
+    if (!launch()) {
+        killHost();
+        destroyRegion();
+        return false;
+    }
+
+    healthy_.store(true);
+    watchdogRunning_.store(true);
+    watchdogThread_ = std::thread(&PluginSandbox::watchdogLoop, this);
+    return true;
+}
+
+void PluginSandbox::stop() {
+    watchdogRunning_.store(false);
+    if (watchdogThread_.joinable()) {
+        watchdogThread_.join();
+    }
+
+    healthy_.store(false);
+    while (activeReaders_.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    pid_t pid = hostPid_.exchange(-1);
+    if (pid > 0 && region_) {
+        // Ask politely, then insist
+        region_->shutdown.store(1);
+        futexWake(&region_->submitted);
+        int status = 0;
+        bool exited = false;
+        for (int i = 0; i < 100 && !exited; i++) {
+            exited = waitpid(pid, &status, WNOHANG) == pid;
+            if (!exited) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }
+        if (!exited) {
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+        }
+    }
+    destroyRegion();
+}
+
+bool PluginSandbox::process(const cvosc_process_block& block) {
+    activeReaders_.fetch_add(1);
+    if (!healthy_.load() || block.num_channels > maxChannels_ || block.num_frames > maxFrames_) {
+        passthrough(block);
+        activeReaders_.fetch_sub(1);
+        return false;
+    }
+
+    SandboxRegion* region = region_;
+    const uint32_t frames = block.num_frames;
+    const uint32_t channels = block.num_channels;
+    blocks_.fetch_add(1, std::memory_order_relaxed);
+
+    // Result for the previous block, or its dry copy if the host is late
+    const bool previousSubmitted = lastSubmitted_;
+    const bool ready = previousSubmitted && region->completed.load(std::memory_order_acquire) == submitted_;
+    const uint32_t previousSlot = (submitted_ - 1) % SLOT_COUNT;
+    const int previousDelay = delayIndex_;
+
+    // Hand the current block over if the host has a free slot
+    const bool submit = submitted_ - region->completed.load(std::memory_order_acquire) < SLOT_COUNT;
+    if (submit) {
+        uint32_t slot = submitted_ % SLOT_COUNT;
+        for (uint32_t channel = 0; channel < channels; channel++) {
+            std::memcpy(region->input(slot, channel), block.inputs[channel], frames * sizeof(float));
+        }
+        region->slotFrames[slot] = frames;
+        region->slotChannels[slot] = channels;
+        region->slotPosition[slot] = block.frame_position;
+        submitted_++;
+        region->submitted.store(submitted_);
+        if (region->hostSleeping.load()) {
+            futexWake(&region->submitted);
+        }
+    } else {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    lastSubmitted_ = submit;
+
+    // Keep the dry input in case the next result is late
+    const int nextDelay = 1 - delayIndex_;
+    for (uint32_t channel = 0; channel < channels; channel++) {
+        std::memcpy(&delay_[nextDelay][channel * maxFrames_], block.inputs[channel], frames * sizeof(float));
+    }
+
+    const uint32_t sourceFrames = ready ? region->slotFrames[previousSlot] : lastFrames_;
+    const uint32_t sourceChannels = ready ? region->slotChannels[previousSlot] : lastChannels_;
+    for (uint32_t channel = 0; channel < channels; channel++) {
+        float* output = block.outputs[channel];
+        uint32_t copied = channel < sourceChannels ? std::min(frames, sourceFrames) : 0;
+        if (copied > 0) {
+            const float* source = ready ? region->output(previousSlot, channel)
+                                        : &delay_[previousDelay][channel * maxFrames_];
+            std::memcpy(output, source, copied * sizeof(float));
+        }
+        std::fill(output + copied, output + frames, 0.0f);
+    }
+
+    if (ready) {
+        processed_.fetch_add(1, std::memory_order_relaxed);
+    } else if (previousSubmitted) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+    delayIndex_ = nextDelay;
+    lastFrames_ = frames;
+    lastChannels_ = channels;
+
+    activeReaders_.fetch_sub(1);
+    return ready;
+}
+
+bool PluginSandbox::waitForResult(std::chrono::microseconds timeout) {
+    if (!healthy_.load() || !lastSubmitted_) {
+        return false;
+    }
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (region_->completed.load(std::memory_order_acquire) != submitted_) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PluginSandbox::setParameter(uint32_t id, float value) {
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    parameters_[id] = value;
+    // An unhealthy host gets every parameter replayed when it comes back
+    return !healthy_.load() || pushParameter(id, value);
+}
+
+float PluginSandbox::getParameter(uint32_t id) const {
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    auto it = parameters_.find(id);
+    return it != parameters_.end() ? it->second : 0.0f;
+}
+
+std::string PluginSandbox::getPluginName() const {
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    return pluginName_;
+}
+
+std::vector<PluginSandbox::ParameterInfo> PluginSandbox::getParameters() const {
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    return parameterInfo_;
+}
+
+PluginSandbox::Statistics PluginSandbox::getStatistics() const {
+    Statistics statistics;
+    statistics.blocks = blocks_.load();
+    statistics.processed = processed_.load();
+    statistics.misses = misses_.load();
+    statistics.skipped = skipped_.load();
+    statistics.restarts = restarts_.load();
+    statistics.healthy = healthy_.load();
+    statistics.hostPid = hostPid_.load();
+    return statistics;
+}
+
+bool PluginSandbox::createRegion() {
+    regionSize_ = SandboxRegion::bytesFor(maxChannels_, maxFrames_);
+
+#ifdef __linux__
+    fd_ = memfd_create("cvosc-plugin-sandbox", MFD_CLOEXEC);
+#else
+    static std::atomic<uint32_t> regionCounter{0};
+    std::string name = "/cvosc-sandbox-" + std::to_string(getpid()) + "-" + std::to_string(regionCounter++);
+    fd_ = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd_ >= 0) {
+        shm_unlink(name.c_str()); // Reachable through the inherited descriptor only
+        fcntl(fd_, F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    if (fd_ < 0) {
+        std::cerr << "Plugin sandbox: cannot create shared memory: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (ftruncate(fd_, static_cast<off_t>(regionSize_)) != 0) {
+        std::cerr << "Plugin sandbox: cannot size shared memory: " << std::strerror(errno) << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    void* memory = mmap(nullptr, regionSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Plugin sandbox: cannot map shared memory: " << std::strerror(errno) << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    region_ = new (memory) SandboxRegion();
+    region_->magic = SANDBOX_MAGIC;
+    region_->maxChannels = maxChannels_;
+    region_->maxFrames = maxFrames_;
+    region_->sampleRate = sampleRate_;
+    region_->size = regionSize_;
+    resetRegion();
+    return true;
+}
+
+void PluginSandbox::destroyRegion() {
+    if (region_) {
+        munmap(region_, regionSize_);
+        region_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void PluginSandbox::resetRegion() {
+    // Only called while no host is attached and the processing thread is idle
+    region_->hostState.store(HOST_STARTING);
+    region_->shutdown.store(0);
+    region_->submitted.store(0);
+    region_->hostSleeping.store(0);
+    region_->completed.store(0);
+    region_->heartbeat.store(0);
+    region_->parameterHead.store(0);
+    region_->parameterTail.store(0);
+
+    submitted_ = 0;
+    lastSubmitted_ = false;
+    lastFrames_ = 0;
+    lastChannels_ = 0;
+}
+
+bool PluginSandbox::launch() {
+    // Exec mode: everything the child needs is prepared before fork, and it only
+    // calls async-signal-safe functions until exec. Fork mode runs the plugin in
+    // the child itself, which is not async-signal-safe; start() only allows it
+    // from a single-threaded caller, and restarts fork beside that one thread.
+    std::string fdArgument = std::to_string(fd_);
+    std::vector<char*> arguments;
+    if (!descriptor_) {
+        arguments = {const_cast<char*>(hostExecutable_.c_str()), const_cast<char*>("--fd"),
+                     const_cast<char*>(fdArgument.c_str()), const_cast<char*>("--plugin"),
+                     const_cast<char*>(pluginPath_.c_str()), nullptr};
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::cerr << "Plugin sandbox: fork failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (pid == 0) {
+#ifdef __linux__
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+        if (!descriptor_) {
+            fcntl(fd_, F_SETFD, 0); // Let the region survive exec
+            execvp(arguments[0], arguments.data());
+            _exit(127);
+        }
+
+        void* instance = descriptor_->create(sampleRate_, maxChannels_, maxFrames_);
+        if (!instance) {
+            region_->hostState.store(HOST_FAILED);
+            _exit(1);
+        }
+        publishPluginInfo(region_, descriptor_, descriptor_->name ? descriptor_->name : "", {});
+        BlockProcessor processor(descriptor_, instance, maxChannels_, maxFrames_);
+        serve(region_, processor);
+        descriptor_->destroy(instance);
+        _exit(0);
+    }
+
+    hostPid_.store(pid);
+    return waitForHost();
+}
+
+bool PluginSandbox::waitForHost() {
+    auto deadline = std::chrono::steady_clock::now() + startTimeout_;
+    while (std::chrono::steady_clock::now() < deadline) {
+        uint32_t state = region_->hostState.load(std::memory_order_acquire);
+        if (state == HOST_READY) {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            pluginName_.assign(region_->pluginName, strnlen(region_->pluginName, sizeof(region_->pluginName)));
+            pluginKind_ = region_->pluginKind;
+            parameterInfo_.clear();
+            for (uint32_t i = 0; i < std::min(region_->parameterCount, MAX_PARAMETER_NAMES); i++) {
+                const SandboxParameterName& entry = region_->parameterNames[i];
+                parameterInfo_.push_back({entry.id, std::string(entry.name, strnlen(entry.name, sizeof(entry.name)))});
+            }
+            return true;
+        }
+        if (state == HOST_FAILED) {
+            break;
+        }
+        int status = 0;
+        if (waitpid(hostPid_.load(), &status, WNOHANG) == hostPid_.load()) {
+            hostPid_.store(-1); // Already reaped
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::cerr << "Plugin sandbox: host did not become ready" << std::endl;
+    return false;
+}
+
+void PluginSandbox::killHost() {
+    pid_t pid = hostPid_.exchange(-1);
+    if (pid > 0) {
+        int status = 0;
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+    }
+}
+
+void PluginSandbox::watchdogLoop() {
+    uint32_t lastCompleted = 0;
+    auto lastProgress = std::chrono::steady_clock::now();
+    auto nextAttempt = lastProgress;
+    auto backoff = std::chrono::milliseconds(100);
+
+    while (watchdogRunning_.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto now = std::chrono::steady_clock::now();
+
+        if (healthy_.load()) {
+            const char* reason = nullptr;
+            int status = 0;
+            pid_t pid = hostPid_.load();
+            if (pid > 0 && waitpid(pid, &status, WNOHANG) == pid) {
+                hostPid_.store(-1);
+                reason = "exited";
+            }
+
+            uint32_t completed = region_->completed.load();
+            if (completed != lastCompleted || completed == region_->submitted.load()) {
+                lastCompleted = completed;
+                lastProgress = now;
+            } else if (now - lastProgress > std::chrono::milliseconds(stallTimeoutMs_.load())) {
+                reason = "stalled";
+            }
+
+            if (reason) {
+                // Stop feeding the host and wait for the processing thread to leave the region
+                healthy_.store(false);
+                while (activeReaders_.load() != 0) {
+                    std::this_thread::yield();
+                }
+                std::cerr << "Plugin sandbox: host " << reason << ", restarting" << std::endl;
+                killHost();
+                restarts_.fetch_add(1);
+                nextAttempt = now;
+            }
+            continue;
+        }
+
+        if (now < nextAttempt) {
+            continue;
+        }
+
+        resetRegion();
+        if (launch()) {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            for (const auto& [id, value] : parameters_) {
+                pushParameter(id, value);
+            }
+            lastCompleted = 0;
+            lastProgress = std::chrono::steady_clock::now();
+            backoff = std::chrono::milliseconds(100);
+            healthy_.store(true);
+        } else {
+            killHost();
+            nextAttempt = now + backoff;
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(5000));
+        }
+    }
+}
+
+void PluginSandbox::passthrough(const cvosc_process_block& block) const {
+    for (uint32_t channel = 0; channel < block.num_channels; channel++) {
+        if (block.outputs[channel] != block.inputs[channel]) {
+            std::memcpy(block.outputs[channel], block.inputs[channel], block.num_frames * sizeof(float));
+        }
+    }
+}
+
+bool PluginSandbox::pushParameter(uint32_t id, float value) {
+    uint32_t head = region_->parameterHead.load(std::memory_order_relaxed);
+    if (head - region_->parameterTail.load(std::memory_order_acquire) >= PARAMETER_RING_SIZE) {
+        return false;
+    }
+    region_->parameterRing[head % PARAMETER_RING_SIZE] = {id, value};
+    region_->parameterHead.store(head + 1, std::memory_order_release);
+    if (region_->hostSleeping.load()) {
+        futexWake(&region_->submitted);
+    }
+    return true;
+}
+
+// Host side
+void PluginSandbox::publishPluginInfo(SandboxRegion* region, const cvosc_plugin_descriptor* descriptor,
+                                      const std::string& name, const std::vector<std::string>& parameterNames) {
+    std::strncpy(region->pluginName, name.c_str(), sizeof(region->pluginName) - 1);
+    region->pluginKind = descriptor ? descriptor->kind : CVOSC_PLUGIN_SIGNAL_PROCESSOR;
+
+    uint32_t count = 0;
+    if (descriptor) {
+        for (uint32_t i = 0; i < descriptor->parameter_count && count < MAX_PARAMETER_NAMES; i++) {
+            const cvosc_parameter_info& parameter = descriptor->parameters[i];
+            region->parameterNames[count].id = parameter.id;
+            std::strncpy(region->parameterNames[count].name, parameter.name ? parameter.name : "",
+                         sizeof(region->parameterNames[count].name) - 1);
+            count++;
+        }
+    } else {
+        for (size_t i = 0; i < parameterNames.size() && count < MAX_PARAMETER_NAMES; i++) {
+            region->parameterNames[count].id = static_cast<uint32_t>(i);
+            std::strncpy(region->parameterNames[count].name, parameterNames[i].c_str(),
+                         sizeof(region->parameterNames[count].name) - 1);
+            count++;
+        }
+    }
+    region->parameterCount = count;
+}
+
+void PluginSandbox::serve(SandboxRegion* region, BlockProcessor& processor) {
+    std::vector<const float*> inputs(region->maxChannels);
+    std::vector<float*> outputs(region->maxChannels);
+    uint32_t next = region->completed.load();
+    pid_t parent = getppid();
+
+    region->hostState.store(HOST_READY, std::memory_order_release);
+
+    while (!region->shutdown.load(std::memory_order_acquire)) {
+        uint32_t head = region->parameterHead.load(std::memory_order_acquire);
+        uint32_t tail = region->parameterTail.load(std::memory_order_relaxed);
+        for (; tail != head; tail++) {
+            const SandboxParameterEntry& entry = region->parameterRing[tail % PARAMETER_RING_SIZE];
+            processor.setParameter(entry.id, entry.value);
+        }
+        region->parameterTail.store(tail, std::memory_order_release);
+
+        if (region->submitted.load(std::memory_order_acquire) == next) {
+            region->hostSleeping.store(1);
+            if (region->submitted.load() == next && !region->shutdown.load()) {
+                futexWait(&region->submitted, next, 20);
+            }
+            region->hostSleeping.store(0);
+            region->heartbeat.fetch_add(1, std::memory_order_relaxed);
+            if (getppid() != parent) {
+                break; // Converter is gone
+            }
+            continue;
+        }
+
+        uint32_t slot = next % SLOT_COUNT;
+        uint32_t channels = std::min(region->slotChannels[slot], region->maxChannels);
+        uint32_t frames = std::min(region->slotFrames[slot], region->maxFrames);
+        for (uint32_t channel = 0; channel < channels; channel++) {
+            inputs[channel] = region->input(slot, channel);
+            outputs[channel] = region->output(slot, channel);
+        }
+        cvosc_process_block block{channels, frames, inputs.data(), outputs.data(), region->slotPosition[slot]};
+        if (!processor.process(block)) {
+            for (uint32_t channel = 0; channel < channels; channel++) {
+                std::memcpy(outputs[channel], inputs[channel], frames * sizeof(float));
+            }
+        }
+
+        next++;
+        region->completed.store(next, std::memory_order_release);
+        region->heartbeat.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+int PluginSandbox::runHost(int fd, const std::string& pluginPath) {
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SandboxRegion)) {
+        std::cerr << "Plugin host: invalid shared memory descriptor " << fd << std::endl;
+        return 1;
+    }
+    void* memory = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        std::cerr << "Plugin host: cannot map shared memory: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    auto* region = static_cast<SandboxRegion*>(memory);
+    if (region->magic != SANDBOX_MAGIC ||
+        region->size != SandboxRegion::bytesFor(region->maxChannels, region->maxFrames)) {
+        std::cerr << "Plugin host: shared memory layout mismatch" << std::endl;
+        return 1;
+    }
+
+    void* handle = dlopen(pluginPath.c_str(), RTLD_NOW);
+    if (!handle) {
+        std::cerr << "Plugin host: " << dlerror() << std::endl;
+        region->hostState.store(HOST_FAILED);
+        return 1;
+    }
+
+    int result = 0;
+    auto entry = reinterpret_cast<cvosc_plugin_entry_fn>(dlsym(handle, CVOSC_PLUGIN_ENTRY_SYMBOL));
+    if (entry) {
+        const cvosc_plugin_descriptor* descriptor = entry(PLUGIN_API_VERSION);
+        void* instance = nullptr;
+        if (descriptor && descriptor->abi_version == PLUGIN_API_VERSION &&
+            descriptor->struct_size >= sizeof(cvosc_plugin_descriptor) &&
+            descriptor->create && descriptor->destroy && descriptor->process) {
+            instance = descriptor->create(region->sampleRate, region->maxChannels, region->maxFrames);
+        }
+        if (instance) {
+            publishPluginInfo(region, descriptor, descriptor->name ? descriptor->name : "", {});
+            BlockProcessor processor(descriptor, instance, region->maxChannels, region->maxFrames);
+            serve(region, processor);
+            descriptor->destroy(instance);
+        } else {
+            std::cerr << "Plugin host: cannot instantiate " << pluginPath << std::endl;
+            result = 1;
+        }
+    } else {
+        // Legacy C++ plugin
+        using CreateFn = IPlugin* (*)();
+        using DestroyFn = void (*)(IPlugin*);
+        auto create = reinterpret_cast<CreateFn>(dlsym(handle, "createPlugin"));
+        auto destroy = reinterpret_cast<DestroyFn>(dlsym(handle, "destroyPlugin"));
+        IPlugin* plugin = create ? create() : nullptr;
+        auto* processor = dynamic_cast<ISignalProcessor*>(plugin);
+        if (processor && processor->initialize()) {
+            publishPluginInfo(region, nullptr, plugin->getInfo().name, processor->getParameterNames());
+            BlockProcessor block(processor, region->maxChannels, region->maxFrames);
+            serve(region, block);
+            plugin->shutdown();
+        } else {
+            std::cerr << "Plugin host: " << pluginPath << " is not a signal processor" << std::endl;
+            result = 1;
+        }
+        if (plugin && destroy) {
+            destroy(plugin);
+        }
+    }
+
+    if (result != 0) {
+        region->hostState.store(HOST_FAILED);
+    }
+    dlclose(handle);
+    munmap(memory, static_cast<size_t>(info.st_size));
+    return result;
+}
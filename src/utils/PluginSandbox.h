@@ -0,0 +1,145 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <sys/types.h>
+
+#include "PluginABI.h"
+
+class BlockProcessor;
+struct SandboxRegion;
+
+/**
+ * @brief Runs one plugin in a separate host process
+ *
+ * Audio crosses the process boundary through a shared-memory region (memfd
+ * on Linux, an unlinked POSIX shm object elsewhere) holding a two-slot block
+ * ring. process() hands the current block to the host and returns the
+ * host's result for the previous block, so the sandbox adds exactly one
+ * block of latency and never waits: if the host has not finished in time the
+ * delayed dry signal is used instead. The host is woken through a futex on
+ * Linux and polls briefly elsewhere.
+ *
+ * A watchdog thread restarts a host that crashes or stalls. While it does,
+ * process() passes audio through unchanged; the restart itself (kill, spawn,
+ * handshake, parameter replay) happens entirely off the processing thread.
+ */
+class PluginSandbox {
+public:
+    struct Statistics {
+        uint64_t blocks = 0;        // Blocks offered to process()
+        uint64_t processed = 0;     // Blocks returned by the host in time
+        uint64_t misses = 0;        // Host late: delayed dry signal used
+        uint64_t skipped = 0;       // Ring full: block never reached the host
+        uint64_t restarts = 0;
+        bool healthy = false;
+        pid_t hostPid = -1;
+    };
+
+    struct ParameterInfo {
+        uint32_t id = 0;
+        std::string name;
+    };
+
+    PluginSandbox(uint32_t maxChannels, uint32_t maxFrames, double sampleRate = 48000.0);
+    ~PluginSandbox();
+
+    PluginSandbox(const PluginSandbox&) = delete;
+    PluginSandbox& operator=(const PluginSandbox&) = delete;
+
+    // Control thread. Exec mode: hostExecutable loads pluginPath (v2 or legacy) by itself.
+    bool start(const std::string& hostExecutable, const std::string& pluginPath);
+    // Fork mode: the child runs a descriptor linked into this binary (tests, benchmarks).
+    // The child allocates before it could exec, so this fails unless the caller is the
+    // only thread; the engine always uses exec mode.
+    bool start(const cvosc_plugin_descriptor* descriptor);
+    void stop();
+
+    // Real-time thread: never blocks, one block of latency
+    bool process(const cvosc_process_block& block);
+    // Processing thread, outside the real-time path (tests, benchmarks): spin until the host
+    // has finished the last submitted block
+    bool waitForResult(std::chrono::microseconds timeout);
+
+    // Control thread
+    bool setParameter(uint32_t id, float value);
+    float getParameter(uint32_t id) const;
+    void setStallTimeout(std::chrono::milliseconds timeout) { stallTimeoutMs_.store(timeout.count()); }
+    void setStartTimeout(std::chrono::milliseconds timeout) { startTimeout_ = timeout; }
+
+    bool isHealthy() const { return healthy_.load(); }
+    std::string getPluginName() const;
+    uint32_t getPluginKind() const { return pluginKind_; }
+    std::vector<ParameterInfo> getParameters() const;
+    Statistics getStatistics() const;
+    uint32_t getMaxChannels() const { return maxChannels_; }
+    uint32_t getMaxFrames() const { return maxFrames_; }
+    pid_t getHostPid() const { return hostPid_.load(); }
+
+    // Host side: map the region behind fd, load the plugin and serve blocks until shutdown
+    static int runHost(int fd, const std::string& pluginPath);
+
+private:
+    const uint32_t maxChannels_;
+    const uint32_t maxFrames_;
+    const double sampleRate_;
+
+    int fd_ = -1;
+    size_t regionSize_ = 0;
+    SandboxRegion* region_ = nullptr;
+
+    // Launch spec, kept for restarts
+    std::string hostExecutable_;
+    std::string pluginPath_;
+    const cvosc_plugin_descriptor* descriptor_ = nullptr;
+
+    std::atomic<pid_t> hostPid_{-1};
+    std::atomic<bool> healthy_{false};
+    std::atomic<uint32_t> activeReaders_{0};
+
+    // Real-time thread state (reset by the watchdog only while unhealthy and idle)
+    uint32_t submitted_ = 0;
+    bool lastSubmitted_ = false;
+    uint32_t lastFrames_ = 0;
+    uint32_t lastChannels_ = 0;
+    int delayIndex_ = 0;
+    std::vector<float> delay_[2];       // Previous input, planar, for late blocks
+
+    std::atomic<uint64_t> blocks_{0};
+    std::atomic<uint64_t> processed_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> skipped_{0};
+    std::atomic<uint64_t> restarts_{0};
+
+    // Watchdog
+    std::thread watchdogThread_;
+    std::atomic<bool> watchdogRunning_{false};
+    std::atomic<int64_t> stallTimeoutMs_{250};
+    std::chrono::milliseconds startTimeout_{2000};
+
+    mutable std::mutex controlMutex_;
+    std::map<uint32_t, float> parameters_;  // Replayed into a restarted host
+    std::string pluginName_;
+    uint32_t pluginKind_ = CVOSC_PLUGIN_SIGNAL_PROCESSOR;
+    std::vector<ParameterInfo> parameterInfo_;
+
+    bool createRegion();
+    void destroyRegion();
+    void resetRegion();
+    bool launch();
+    bool waitForHost();
+    void killHost();
+    void watchdogLoop();
+    void passthrough(const cvosc_process_block& block) const;
+    bool pushParameter(uint32_t id, float value);
+
+    static void serve(SandboxRegion* region, BlockProcessor& processor);
+    static void publishPluginInfo(SandboxRegion* region, const cvosc_plugin_descriptor* descriptor,
+                                  const std::string& name, const std::vector<std::string>& parameterNames);
+};
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "../src/audio/AlsaPcmStream.h"
+#include "../src/core/PerformanceMonitor.h"
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// Outlives the fake, which the stream destroys on stop()
+struct FakeState {
+    std::atomic<int> recoverCalls{0};
+    std::atomic<bool> closed{false};
+};
+
+// A PCM that produces a period every millisecond, with scripted failures
+struct FakePcm : AlsaPcmStream::Io {
+    explicit FakePcm(FakeState& state) : state(state) {}
+
+    FakeState& state;
+    unsigned forcedChannels = 0;    // Channel count the "hardware" insists on
+    long xrunAtPeriod = -1;         // transfer() returns -EPIPE at this period
+    int recoverResult = 0;
+    long transfers = 0;
+    unsigned channels = 0;
+
+    bool open(AlsaPcmStream::Config& config, std::string&) override {
+        if (forcedChannels) config.channels = forcedChannels;
+        channels = config.channels;
+        return true;
+    }
+    int start() override { return 0; }
+    int wait(int) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return 1;
+    }
+    long transfer(float* interleaved, size_t frames) override {
+        long period = transfers++;
+        if (period == xrunAtPeriod) return -EPIPE;
+        for (size_t i = 0; i < frames * channels; i++) {
+            interleaved[i] = float(i % channels);   // Sample value is its channel index
+        }
+        return long(frames);
+    }
+    int recover(int) override {
+        state.recoverCalls++;
+        return recoverResult;
+    }
+    void close() override { state.closed = true; }
+};
+
+template <typename Predicate>
+bool waitFor(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+AlsaPcmStream::Config captureConfig() {
+    AlsaPcmStream::Config config;
+    config.device = "hw:9,0";
+    config.periodFrames = 16;
+    config.realtimePriority = 0;
+    return config;
+}
+
+} // namespace
+
+TEST(AlsaPcmStreamTest, CaptureDeliversPeriodsInNegotiatedLayout) {
+    FakeState state;
+    auto pcm = std::make_unique<FakePcm>(state);
+    pcm->forcedChannels = 4;
+
+    AlsaPcmStream stream;
+    std::atomic<int> periods{0};
+    std::atomic<bool> layoutOk{true};
+    ASSERT_TRUE(stream.start(captureConfig(), [&](float* input, size_t frames) {
+        if (frames != 16 || input[16 * 4 - 1] != 3.0f) layoutOk = false;
+        periods++;
+    }, std::move(pcm)));
+
+    EXPECT_EQ(stream.getConfig().channels, 4u);
+    ASSERT_TRUE(waitFor([&] { return periods >= 5; }));
+    stream.stop();
+
+    EXPECT_TRUE(layoutOk);
+    EXPECT_TRUE(state.closed);
+    EXPECT_FALSE(stream.isRunning());
+    auto stats = stream.getStats();
+    EXPECT_EQ(stats.frames, stats.periods * 16);
+    EXPECT_EQ(stats.xruns, 0u);
+}
+
+TEST(AlsaPcmStreamTest, XrunIsRecoveredAndRecordedAsUnderrun) {
+    FakeState state;
+    auto pcm = std::make_unique<FakePcm>(state);
+    pcm->xrunAtPeriod = 3;
+
+    PerformanceMonitor monitor;
+    AlsaPcmStream stream;
+    stream.setMonitor(&monitor);
+    ASSERT_TRUE(stream.start(captureConfig(), [](float*, size_t) {}, std::move(pcm)));
+
+    // The stream carries on after the xrun
+    ASSERT_TRUE(waitFor([&] { return stream.getStats().periods >= 8; }));
+    stream.stop();
+
+    auto stats = stream.getStats();
+    EXPECT_EQ(stats.xruns, 1u);
+    EXPECT_EQ(stats.recoveries, 1u);
+    EXPECT_EQ(state.recoverCalls.load(), 1);
+    EXPECT_EQ(monitor.getCounters().bufferUnderruns, 1u);
+}
+
+TEST(AlsaPcmStreamTest, FailedRecoveryStopsTheStream) {
+    FakeState state;
+    auto pcm = std::make_unique<FakePcm>(state);
+    pcm->xrunAtPeriod = 0;
+    pcm->recoverResult = -ENODEV;   // Device unplugged
+
+    AlsaPcmStream stream;
+    ASSERT_TRUE(stream.start(captureConfig(), [](float*, size_t) {}, std::move(pcm)));
+    ASSERT_TRUE(waitFor([&] { return !stream.isRunning(); }));
+
+    EXPECT_EQ(stream.getStats().periods, 0u);
+    EXPECT_NE(stream.getLastError().find("hw:9,0"), std::string::npos);
+    stream.stop();
+}
+
+TEST(AlsaPcmStreamTest, DeviceNamesSelectTheAlsaPath) {
+    EXPECT_TRUE(AlsaPcmStream::isAlsaDeviceName("hw:1,0"));
+    EXPECT_TRUE(AlsaPcmStream::isAlsaDeviceName("plughw:CARD=ES8,DEV=0"));
+    EXPECT_TRUE(AlsaPcmStream::isAlsaDeviceName("alsa:default"));
+    EXPECT_FALSE(AlsaPcmStream::isAlsaDeviceName("ES-8"));
+    EXPECT_EQ(AlsaPcmStream::pcmName("alsa:default"), "default");
+    EXPECT_EQ(AlsaPcmStream::pcmName("hw:1,0"), "hw:1,0");
+
+    if (!AlsaPcmStream::isAvailable()) {
+        AlsaPcmStream stream;
+        EXPECT_FALSE(stream.start(captureConfig(), [](float*, size_t) {}));
+        EXPECT_FALSE(stream.getLastError().empty());
+    }
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "../src/config/ConfigWatcher.h"
+#include "../src/core/ConfigDiff.h"
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+OSCDeviceConfig outputDevice(const std::string& id, const std::string& host, int port) {
+    OSCDeviceConfig device;
+    device.deviceId = id;
+    device.deviceType = OSCDeviceType::OSC_OUTPUT;
+    device.networkAddress = host;
+    device.port = port;
+    return device;
+}
+
+MixerConfigSnapshot twoChannelMixer() {
+    MixerConfigSnapshot snapshot;
+    snapshot.channels.resize(2);
+    snapshot.channels[0].outputDevices.push_back(outputDevice("synth", "127.0.0.1", 9000));
+    snapshot.channels[1].outputDevices.push_back(outputDevice("lights", "10.0.0.5", 7000));
+    return snapshot;
+}
+
+void writeFile(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::trunc);
+    file << contents;
+}
+
+template <typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(ConfigDiffTest, ReportsOnlyTheChangedProfileFields) {
+    ConfigProfile before;
+    ConfigProfile after = before;
+    EXPECT_TRUE(diffProfiles(before, after).empty());
+
+    after.cvRanges[3] = CVRange(-5.0f, 5.0f);
+    after.oscPort = "9100";
+    auto changes = diffProfiles(before, after);
+    ASSERT_EQ(changes.size(), 2u);
+    EXPECT_EQ(changes[0].field, ProfileField::OscPort);
+    EXPECT_EQ(changes[1].field, ProfileField::CVRange);
+    EXPECT_EQ(changes[1].channel, 3);
+}
+
+TEST(ConfigDiffTest, ClassifiesDeviceChangesByWhatTheyTouch) {
+    auto before = twoChannelMixer();
+    EXPECT_TRUE(diffMixerConfiguration(before, before).empty());
+
+    auto after = before;
+    after.channels[0].outputDevices[0].port = 9001;             // Retarget, no restart
+    after.channels[1].outputDevices[0].oscAddress = "/dimmer";  // Per-message field
+    after.channels[1].minRange = 0.0f;
+    auto diff = diffMixerConfiguration(before, after);
+
+    ASSERT_EQ(diff.channels.size(), 1u);
+    EXPECT_EQ(diff.channels[0].channelId, 1);
+    ASSERT_TRUE(diff.channels[0].range.has_value());
+    EXPECT_FALSE(diff.channels[0].levelVolts.has_value());
+    ASSERT_EQ(diff.devices.size(), 2u);
+    EXPECT_EQ(diff.devices[0].kind, DeviceChangeKind::Retarget);
+    EXPECT_EQ(diff.devices[0].device.port, 9001);
+    EXPECT_EQ(diff.devices[1].kind, DeviceChangeKind::UpdateInPlace);
+    EXPECT_FALSE(diff.masterLevel.has_value());
+
+    after = before;
+    after.channels[0].outputDevices[0].protocolType = OSCProtocolType::TCP;
+    after.channels[1].outputDevices.clear();
+    after.channels[1].outputDevices.push_back(outputDevice("fog", "10.0.0.6", 7001));
+    diff = diffMixerConfiguration(before, after);
+    ASSERT_EQ(diff.devices.size(), 3u);
+    EXPECT_EQ(diff.devices[0].kind, DeviceChangeKind::Recreate);
+    EXPECT_EQ(diff.devices[1].kind, DeviceChangeKind::Removed);
+    EXPECT_EQ(diff.devices[1].device.deviceId, "lights");
+    EXPECT_EQ(diff.devices[2].kind, DeviceChangeKind::Added);
+}
+
+TEST(ConfigWatcherTest, ReloadsOnceAfterAnAtomicRenameAndIgnoresUnchangedSaves) {
+    const std::string path = "test_config_watcher.json";
+    writeFile(path, "{\"version\": 1}");
+
+    ConfigWatcher watcher(path);
+    watcher.setDebounce(std::chrono::milliseconds(50));
+    std::atomic<int> reloads{0};
+    watcher.startFile([&reloads](const std::string&) { reloads++; });
+    ASSERT_TRUE(watcher.isEventDriven());
+
+    // Editor-style save: write a temporary file and rename it over the original, in a burst
+    for (int i = 2; i <= 4; i++) {
+        writeFile(path + ".tmp", "{\"version\": " + std::to_string(i) + "}");
+        ASSERT_EQ(std::rename((path + ".tmp").c_str(), path.c_str()), 0);
+    }
+    EXPECT_TRUE(waitFor([&reloads]() { return reloads.load() >= 1; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(reloads.load(), 1);
+
+    // Same contents again: no reload
+    writeFile(path, "{\"version\": 4}");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(reloads.load(), 1);
+
+    writeFile(path, "{\"version\": 5}");
+    EXPECT_TRUE(waitFor([&reloads]() { return reloads.load() == 2; }));
+
+    watcher.stop();
+    std::remove(path.c_str());
+}
+
+TEST(ConfigWatcherTest, IncrementalCallbackCarriesTheProfileDiff) {
+    const std::string path = "test_config_watcher_profile.json";
+    Config config;
+    config.saveToFile(path);
+
+    ConfigWatcher watcher(path);
+    watcher.setDebounce(std::chrono::milliseconds(20));
+    std::atomic<bool> called{false};
+    std::vector<ProfileChange> received;
+    watcher.startIncremental([&](const Config&, const std::vector<ProfileChange>& changes) {
+        received = changes;
+        called = true;
+    });
+
+    config.setCVRange(2, -10.0f, 10.0f);
+    config.saveToFile(path);
+    ASSERT_TRUE(waitFor([&called]() { return called.load(); }));
+    watcher.stop();
+
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0].field, ProfileField::CVRange);
+    EXPECT_EQ(received[0].channel, 2);
+    std::remove(path.c_str());
+}
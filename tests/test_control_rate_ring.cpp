@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "../src/core/ControlRateRing.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// 10 audio frames per control value at the nominal rate, 20 ms (2 values) target
+ControlRateRing::Config smallConfig(OutputInterpolation mode) {
+    ControlRateRing::Config config;
+    config.sampleRate = 1000.0;
+    config.controlRateHz = 100.0;
+    config.targetLatencyMs = 20.0;
+    config.interpolation = mode;
+    config.capacity = 64;
+    return config;
+}
+
+// Renders in 10-frame blocks, pushing value(i) for the i-th block; returns the output
+template <typename ValueFn>
+std::vector<float> run(ControlRateRing& ring, int blocks, ValueFn value) {
+    std::vector<float> output;
+    float block[10];
+    for (int i = 0; i < blocks; i++) {
+        ring.push(value(i));
+        ring.render(block, 10, 1);
+        output.insert(output.end(), block, block + 10);
+    }
+    return output;
+}
+
+float largestStep(const std::vector<float>& output) {
+    float largest = 0.0f;
+    for (size_t i = 1; i < output.size(); i++) {
+        largest = std::max(largest, std::abs(output[i] - output[i - 1]));
+    }
+    return largest;
+}
+
+} // namespace
+
+TEST(ControlRateRingTest, StepInputIsRampedAcrossTheControlPeriod) {
+    auto gate = [](int i) { return i < 20 ? 0.0f : 1.0f; };
+
+    ControlRateRing stepped(smallConfig(OutputInterpolation::STEP));
+    EXPECT_FLOAT_EQ(largestStep(run(stepped, 60, gate)), 1.0f);
+
+    ControlRateRing linear(smallConfig(OutputInterpolation::LINEAR));
+    auto output = run(linear, 60, gate);
+    EXPECT_LT(largestStep(output), 0.15f);          // ~1/10 per frame
+    EXPECT_FLOAT_EQ(output.back(), 1.0f);
+    EXPECT_EQ(linear.getStats().underruns, 0u);
+
+    // Catmull-Rom passes through the values and reproduces a linear ramp
+    ControlRateRing cubic(smallConfig(OutputInterpolation::CUBIC));
+    auto ramp = run(cubic, 60, [](int i) { return 0.1f * i; });
+    EXPECT_LT(largestStep(ramp), 0.015f);
+    for (size_t i = 2; i < ramp.size(); i++) {
+        EXPECT_NEAR(ramp[i] - ramp[i - 1], ramp[i - 1] - ramp[i - 2], 2e-3f) << "at frame " << i;
+    }
+}
+
+TEST(ControlRateRingTest, UnderrunHoldsTheLastValueThenRampsBackIn) {
+    ControlRateRing ring(smallConfig(OutputInterpolation::LINEAR));
+    run(ring, 30, [](int) { return 2.0f; });
+
+    // The producer stalls: the output holds instead of dropping to zero
+    float block[10];
+    bool ranDry = false;
+    for (int i = 0; i < 10; i++) {
+        ranDry |= ring.render(block, 10, 1);
+        EXPECT_FLOAT_EQ(block[9], 2.0f);
+    }
+    EXPECT_TRUE(ranDry);
+    EXPECT_EQ(ring.getStats().underruns, 1u);       // Once per stall, not per starved block
+
+    // Back again: no jump from the held value
+    auto resumed = run(ring, 20, [](int) { return 3.0f; });
+    EXPECT_FLOAT_EQ(resumed.front(), 2.0f);
+    EXPECT_LT(largestStep(resumed), 0.15f);
+    EXPECT_FLOAT_EQ(resumed.back(), 3.0f);
+}
+
+TEST(ControlRateRingTest, FillControlFollowsAProducerOffTheNominalRate) {
+    for (double producerHz : {95.0, 105.0}) {
+        ControlRateRing ring(smallConfig(OutputInterpolation::LINEAR));
+        float block[16];
+        double due = 0.0;
+        double ratioSum = 0.0;
+        for (int i = 0; i < 2000; i++) {     // 32 s of 16-frame blocks
+            for (due += producerHz * 16 / 1000.0; due >= 1.0; due -= 1.0) {
+                ring.push(0.5f);
+            }
+            ring.render(block, 16, 1);
+            if (i >= 1500) ratioSum += ring.getStats().rateRatio;
+        }
+        // Pushes arrive in whole values, so the ratio wobbles around the producer's rate
+        auto stats = ring.getStats();
+        EXPECT_NEAR(ratioSum / 500, producerHz / 100.0, 0.01) << producerHz << " Hz";
+        EXPECT_LE(stats.fill, 4u) << producerHz << " Hz";
+        EXPECT_EQ(stats.skipped, 0u) << producerHz << " Hz";
+        EXPECT_LE(stats.underruns, 1u) << producerHz << " Hz";   // At most while the integral settles
+    }
+}
+
+TEST(ControlRateRingTest, OverflowIsCountedAndLatencyIsCapped) {
+    ControlRateRing ring(smallConfig(OutputInterpolation::LINEAR));
+    std::vector<float> burst(100, 1.0f);
+    EXPECT_EQ(ring.push(burst.data(), burst.size()), 64u);
+    EXPECT_FALSE(ring.push(1.0f));
+    EXPECT_EQ(ring.getStats().overflows, 37u);
+
+    // Interleaved output to every channel, with the backlog cut to the target
+    float block[10 * 4];
+    ring.render(block, 10, 4);
+    auto stats = ring.getStats();
+    EXPECT_EQ(stats.fill, 2u);
+    EXPECT_EQ(stats.skipped, 60u);
+    for (int frame = 0; frame < 10; frame++) {
+        EXPECT_EQ(block[frame * 4], block[frame * 4 + 3]);
+    }
+}
+
+TEST(ControlRateRingTest, UnderrunHoldsTheLastValuePushed) {
+    // A gate falls on the final tick before the engine stops pushing
+    ControlRateRing ring(smallConfig(OutputInterpolation::LINEAR));
+    for (int i = 0; i < 5; i++) ring.push(1.0f);
+    ring.push(0.0f);
+
+    float block[10];
+    for (int i = 0; i < 100; i++) {     // One second
+        ring.render(block, 10, 1);
+    }
+    EXPECT_FLOAT_EQ(block[0], 0.0f);
+    EXPECT_FLOAT_EQ(block[9], 0.0f);
+    EXPECT_EQ(ring.getStats().underruns, 1u);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../src/core/ErrorHandler.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ErrorHandlerLoggingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        handler.flush();
+        handler.setConsoleOutput(false);
+        handler.setLogLevel(ErrorSeverity::DEBUG);
+        handler.setRateLimit(std::chrono::milliseconds(1000));
+        handler.clearHistory();
+    }
+
+    void TearDown() override {
+        handler.flush();
+        handler.setFileOutput(false);
+        handler.setLogRotation(10 * 1024 * 1024, 3);
+        handler.setRateLimit(std::chrono::milliseconds(1000));
+        handler.setLogLevel(ErrorSeverity::INFO);
+        handler.setConsoleOutput(true);
+        handler.clearHistory();
+    }
+
+    ErrorHandler& handler = ErrorHandler::getInstance();
+};
+
+TEST_F(ErrorHandlerLoggingTest, ReportsFromManyThreadsArriveInOrderAfterFlush) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([this, t]() {
+            for (int i = 0; i < 20; i++) {
+                // Distinct lines so the rate limiter keeps them all
+                handler.reportError(ErrorSeverity::WARNING, ErrorCategory::SYSTEM,
+                                    "send failed " + std::to_string(t) + "/" + std::to_string(i),
+                                    "details", __FUNCTION__, __FILE__, __LINE__ + i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    handler.flush();
+    auto history = handler.getErrorHistory();
+    ASSERT_EQ(history.size(), 80u);
+    for (size_t i = 1; i < history.size(); i++) {
+        EXPECT_LE(history[i - 1].timestamp, history[i].timestamp);
+    }
+    EXPECT_EQ(history[0].file, "test_error_handler_logging.cpp");
+}
+
+TEST_F(ErrorHandlerLoggingTest, CollapsesRepeatedIdenticalReports) {
+    handler.setRateLimit(std::chrono::milliseconds(50));
+    auto before = handler.getLoggingStats();
+    auto sendFailed = [](int i) {
+        NETWORK_ERROR("OSC message transmission failed", "Value: " + std::to_string(i), false, "");
+    };
+
+    for (int i = 0; i < 500; i++) {
+        sendFailed(i);
+    }
+    handler.flush();
+    ASSERT_EQ(handler.getErrorHistory().size(), 1u);
+    EXPECT_EQ(handler.getLoggingStats().suppressed - before.suppressed, 499u);
+
+    // The next report after the window carries the collapsed count
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    for (int i = 0; i < 500; i++) {
+        sendFailed(i);
+    }
+    handler.flush();
+    auto history = handler.getErrorHistory();
+    ASSERT_EQ(history.size(), 2u);
+    EXPECT_EQ(history[1].suppressedRepeats, 499u);
+}
+
+TEST_F(ErrorHandlerLoggingTest, RotatesTheLogFile) {
+    const std::string logName = "test_error_handler_rotation.log";
+    std::remove(logName.c_str());
+    std::remove((logName + ".1").c_str());
+    std::remove((logName + ".2").c_str());
+
+    handler.setRateLimit(std::chrono::milliseconds(0));
+    handler.setLogRotation(2048, 2);
+    handler.setFileOutput(true, logName);
+    for (int i = 0; i < 100; i++) {
+        handler.logInfo("rotation line " + std::to_string(i), std::string(40, 'x'));
+    }
+    handler.flush();
+    handler.setFileOutput(false);
+
+    EXPECT_GE(handler.getLoggingStats().rotations, 2u);
+    EXPECT_TRUE(std::ifstream(logName).good());
+    EXPECT_TRUE(std::ifstream(logName + ".1").good());
+    EXPECT_TRUE(std::ifstream(logName + ".2").good());
+    EXPECT_FALSE(std::ifstream(logName + ".3").good());
+
+    std::ifstream current(logName, std::ios::ate);
+    EXPECT_LE(static_cast<size_t>(current.tellg()), 2048u);
+
+    std::remove(logName.c_str());
+    std::remove((logName + ".1").c_str());
+    std::remove((logName + ".2").c_str());
+}
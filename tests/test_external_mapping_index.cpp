@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "../src/utils/ExternalDeviceMapper.h"
+#include "../src/utils/ExternalMappingIndex.h"
+#include <map>
+#include <string>
+#include <vector>
+
+class ExternalMappingIndexTest : public ::testing::Test {
+protected:
+    void addOSC(const std::string& id, const std::string& address, int channel = 0) {
+        ExternalDeviceMapping mapping;
+        mapping.mappingId = id;
+        mapping.deviceId = "controller";
+        mapping.deviceType = ExternalDeviceType::OSC_CONTROLLER;
+        mapping.inputAddress = address;
+        mapping.parameterType = MappingParameterType::CHANNEL_LEVEL;
+        mapping.targetChannelId = channel;
+        mappings[id] = mapping;
+    }
+
+    void addMIDI(const std::string& id, int cc, int midiChannel = -1) {
+        ExternalDeviceMapping mapping;
+        mapping.mappingId = id;
+        mapping.deviceId = "midi";
+        mapping.deviceType = ExternalDeviceType::MIDI_CONTROLLER;
+        mapping.inputAddress = "cc" + std::to_string(cc);
+        mapping.midiChannel = midiChannel;
+        mapping.parameterType = MappingParameterType::CHANNEL_LEVEL;
+        mappings[id] = mapping;
+    }
+
+    std::vector<std::string> oscMatches(const ExternalMappingIndex& index, const std::string& address) {
+        std::vector<std::string> ids;
+        index.forEachOSCMatch(address, [&ids](const ExternalDeviceMapping& mapping) {
+            ids.push_back(mapping.mappingId);
+        });
+        return ids;
+    }
+
+    std::vector<std::string> midiMatches(const ExternalMappingIndex& index, int channel, int cc) {
+        std::vector<std::string> ids;
+        index.forEachMIDIMatch(channel, cc, [&ids](const ExternalDeviceMapping& mapping) {
+            ids.push_back(mapping.mappingId);
+        });
+        return ids;
+    }
+
+    std::map<std::string, ExternalDeviceMapping> mappings;
+};
+
+TEST_F(ExternalMappingIndexTest, ExactOSCAddress) {
+    addOSC("fader1", "/mixer/fader1");
+    addOSC("fader2", "/mixer/fader2");
+    ExternalMappingIndex index(mappings);
+
+    EXPECT_EQ(oscMatches(index, "/mixer/fader1"), std::vector<std::string>{"fader1"});
+    EXPECT_TRUE(oscMatches(index, "/mixer/fader3").empty());
+    EXPECT_TRUE(oscMatches(index, "/mixer").empty());
+    EXPECT_TRUE(oscMatches(index, "/mixer/fader1/extra").empty());
+}
+
+TEST_F(ExternalMappingIndexTest, WildcardSegments) {
+    addOSC("star", "/mixer/fader*");
+    addOSC("question", "/mixer/mute?");
+    addOSC("range", "/mixer/solo[1-4]");
+    addOSC("alternatives", "/{mixer,desk}/master");
+    ExternalMappingIndex index(mappings);
+
+    EXPECT_EQ(oscMatches(index, "/mixer/fader12").size(), 1u);
+    EXPECT_EQ(oscMatches(index, "/mixer/fader").size(), 1u);
+    EXPECT_EQ(oscMatches(index, "/mixer/mute3").size(), 1u);
+    EXPECT_TRUE(oscMatches(index, "/mixer/mute34").empty());
+    EXPECT_EQ(oscMatches(index, "/mixer/solo2").size(), 1u);
+    EXPECT_TRUE(oscMatches(index, "/mixer/solo7").empty());
+    EXPECT_EQ(oscMatches(index, "/desk/master").size(), 1u);
+    EXPECT_EQ(oscMatches(index, "/mixer/master").size(), 1u);
+
+    // '*' never crosses a path separator
+    EXPECT_TRUE(oscMatches(index, "/mixer/fader1/x").empty());
+}
+
+TEST_F(ExternalMappingIndexTest, LiteralAndWildcardBothMatch) {
+    addOSC("exact", "/mixer/fader1");
+    addOSC("wild", "/mixer/*");
+    ExternalMappingIndex index(mappings);
+
+    EXPECT_EQ(oscMatches(index, "/mixer/fader1").size(), 2u);
+    EXPECT_EQ(oscMatches(index, "/mixer/anything").size(), 1u);
+}
+
+TEST_F(ExternalMappingIndexTest, DisabledMappingsAreNotIndexed) {
+    addOSC("fader1", "/mixer/fader1");
+    mappings["fader1"].enabled = false;
+    ExternalMappingIndex index(mappings);
+
+    EXPECT_TRUE(oscMatches(index, "/mixer/fader1").empty());
+}
+
+TEST_F(ExternalMappingIndexTest, MIDIChannelTable) {
+    addMIDI("omni", 7);
+    addMIDI("ch2", 7, 2);
+    ExternalMappingIndex index(mappings);
+
+    EXPECT_EQ(midiMatches(index, 0, 7), std::vector<std::string>{"omni"});
+    EXPECT_EQ(midiMatches(index, 2, 7).size(), 2u);
+    EXPECT_TRUE(midiMatches(index, 2, 8).empty());
+    EXPECT_TRUE(midiMatches(index, 16, 7).empty());
+    EXPECT_TRUE(midiMatches(index, 0, 128).empty());
+}
+
+TEST_F(ExternalMappingIndexTest, ParseMIDICC) {
+    EXPECT_EQ(ExternalMappingIndex::parseMIDICC("cc0"), 0);
+    EXPECT_EQ(ExternalMappingIndex::parseMIDICC("cc127"), 127);
+    EXPECT_EQ(ExternalMappingIndex::parseMIDICC("cc128"), -1);
+    EXPECT_EQ(ExternalMappingIndex::parseMIDICC("cc"), -1);
+    EXPECT_EQ(ExternalMappingIndex::parseMIDICC("note60"), -1);
+}
+
+TEST_F(ExternalMappingIndexTest, MapperDispatchesThroughIndex) {
+    ExternalDeviceMapper mapper;
+    std::vector<std::pair<int, float>> changes;
+    mapper.setParameterChangeCallback([&changes](MappingParameterType, int channel, float value) {
+        changes.emplace_back(channel, value);
+    });
+
+    addOSC("fader3", "/mixer/fader3", 2);
+    ASSERT_TRUE(mapper.addMapping(mappings["fader3"]));
+
+    mapper.processOSCInput("/mixer/fader3", {0.5f});
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].first, 2);
+    EXPECT_FLOAT_EQ(changes[0].second, 0.5f);
+
+    // Removal takes effect on the next lookup
+    ASSERT_TRUE(mapper.removeMapping("fader3"));
+    mapper.processOSCInput("/mixer/fader3", {0.5f});
+    EXPECT_EQ(changes.size(), 1u);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "../src/core/LatencyHistogram.h"
+#include "../src/core/PerformanceMonitor.h"
+#include <thread>
+#include <vector>
+
+TEST(LatencyHistogramTest, BucketsCoverRangeWithBoundedError) {
+    // Exact below 64 ns
+    for (uint64_t value = 0; value < 64; value++) {
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value)), value);
+    }
+    // Every value falls inside its bucket, within ~3% of the upper edge
+    for (uint64_t value = 64; value < (1ull << 40); value = value * 3 / 2 + 7) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value) / value, 1.0 / 32.0);
+        EXPECT_LT(LatencyHistogram::bucketUpperBound(index - 1), value);
+    }
+    EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesMergeAcrossThreads) {
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&histogram]() {
+            for (uint64_t i = 1; i <= 1000; i++) {
+                histogram.record(i * 1000); // 1 us .. 1 ms
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 4000u);
+    EXPECT_EQ(snapshot.min, 1000u);
+    EXPECT_EQ(snapshot.max, 1000000u);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(50.0)), 500000.0, 500000.0 * 0.035);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(99.0)), 990000.0, 990000.0 * 0.035);
+    EXPECT_EQ(snapshot.percentile(100.0), 1000000u);
+    EXPECT_DOUBLE_EQ(snapshot.mean(), 500500.0);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.snapshot().count, 0u);
+}
+
+TEST(LatencyHistogramTest, MonitorExportsStagePercentiles) {
+    PerformanceMonitor monitor;
+    for (int i = 0; i < 999; i++) {
+        monitor.recordStageLatency(PerformanceMonitor::LatencyStage::EnqueueToSend, std::chrono::microseconds(10));
+    }
+    monitor.recordStageLatency(PerformanceMonitor::LatencyStage::EnqueueToSend, std::chrono::milliseconds(5));
+
+    auto latency = monitor.getStageLatency(PerformanceMonitor::LatencyStage::EnqueueToSend);
+    EXPECT_EQ(latency.count, 1000u);
+    EXPECT_NEAR(static_cast<double>(latency.p99), 10000.0, 350.0);
+    EXPECT_EQ(latency.max, 5000000u);
+
+    auto json = monitor.exportMetricsAsJson();
+    EXPECT_EQ(json["latency"]["enqueue_to_send"]["count"], 1000u);
+    EXPECT_EQ(json["latency"]["enqueue_to_send"]["max_ns"], 5000000u);
+    EXPECT_EQ(json["latency"]["capture_to_process"]["count"], 0u);
+    EXPECT_NE(monitor.generateReport().find("enqueue_to_send"), std::string::npos);
+}
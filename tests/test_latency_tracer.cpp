@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "../src/core/LatencyTracer.h"
+#include <thread>
+
+class LatencyTracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tracer.clear();
+        tracer.setSampleInterval(4);
+        tracer.setEnabled(true);
+    }
+
+    void TearDown() override {
+        tracer.setEnabled(false);
+        tracer.clear();
+    }
+
+    LatencyTracer& tracer = LatencyTracer::getInstance();
+};
+
+TEST_F(LatencyTracerTest, SamplesOneBlockInN) {
+    int sampled = 0;
+    for (int i = 0; i < 64; i++) {
+        if (tracer.beginTrace() != 0) {
+            sampled++;
+        }
+    }
+    EXPECT_EQ(sampled, 16);
+
+    tracer.setEnabled(false);
+    EXPECT_EQ(tracer.beginTrace(), 0u);
+}
+
+TEST_F(LatencyTracerTest, ExportsSpansWithFlowAcrossThreads) {
+    tracer.setSampleInterval(1);
+    uint64_t traceId = tracer.beginTrace();
+    ASSERT_NE(traceId, 0u);
+
+    auto start = LatencyTracer::Clock::now();
+    tracer.recordSpan(traceId, "adc_capture", start - std::chrono::microseconds(500), start);
+    std::thread engine([&]() {
+        tracer.setThreadName("engine");
+        auto now = LatencyTracer::Clock::now();
+        tracer.recordSpan(traceId, "osc_encode_enqueue", now, now + std::chrono::microseconds(20), 3);
+    });
+    engine.join();
+    tracer.recordSpan(0, "unsampled", start, start);
+
+    auto spans = tracer.collectSpans();
+    ASSERT_EQ(spans.size(), 2u);
+    EXPECT_NE(spans[0].threadId, spans[1].threadId);
+
+    auto trace = tracer.exportChromeTrace();
+    int slices = 0, flowStart = 0, flowEnd = 0;
+    bool namedEngine = false;
+    for (const auto& event : trace["traceEvents"]) {
+        std::string phase = event["ph"];
+        if (phase == "X") {
+            slices++;
+            EXPECT_EQ(event["args"]["trace_id"], traceId);
+        } else if (phase == "s") {
+            flowStart++;
+        } else if (phase == "f") {
+            flowEnd++;
+        } else if (phase == "M" && event["name"] == "thread_name") {
+            namedEngine |= event["args"]["name"] == "engine";
+        }
+    }
+    EXPECT_EQ(slices, 2);
+    EXPECT_EQ(flowStart, 1);
+    EXPECT_EQ(flowEnd, 1);
+    EXPECT_TRUE(namedEngine);
+}
+
+TEST_F(LatencyTracerTest, StreamTimeMapsAdcToSteadyClock) {
+    auto callback = LatencyTracer::Clock::now();
+    auto captured = LatencyTracer::fromStreamTime(10.000, 10.002, callback);
+    double ageMs = std::chrono::duration<double, std::milli>(callback - captured).count();
+    EXPECT_NEAR(ageMs, 2.0, 0.01);
+
+    // Hosts without stream times
+    EXPECT_EQ(LatencyTracer::fromStreamTime(0.0, 0.0, callback), callback);
+}
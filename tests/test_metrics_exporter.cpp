@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "../src/core/MetricsExporter.h"
+#include "../src/core/PerformanceMonitor.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+std::string httpGet(int port, const std::string& path) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return "";
+    }
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    send(fd, request.data(), request.size(), 0);
+
+    std::string response;
+    char buffer[4096];
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(received));
+    }
+    close(fd);
+    return response;
+}
+
+} // namespace
+
+TEST(MetricsExporterTest, ServesOpenMetricsOverHttp) {
+    MetricsExporter exporter;
+    exporter.addCollector([](MetricsWriter& out) {
+        out.family("test_messages", "counter", "Test counter.");
+        out.counter("test_messages", {{"device", "out \"1\""}}, 42);
+    });
+    ASSERT_TRUE(exporter.start(0));
+    ASSERT_GT(exporter.getPort(), 0);
+
+    std::string response = httpGet(exporter.getPort(), "/metrics");
+    EXPECT_EQ(response.rfind("HTTP/1.1 200 OK", 0), 0u);
+    EXPECT_NE(response.find("Content-Type: application/openmetrics-text; version=1.0.0"), std::string::npos);
+    EXPECT_NE(response.find("# TYPE test_messages counter\n"), std::string::npos);
+    EXPECT_NE(response.find("test_messages_total{device=\"out \\\"1\\\"\"} 42\n"), std::string::npos);
+    EXPECT_NE(response.find("cvosc_metrics_scrapes_total 1\n"), std::string::npos);
+    EXPECT_EQ(response.substr(response.size() - 6), "# EOF\n");
+
+    EXPECT_EQ(httpGet(exporter.getPort(), "/").rfind("HTTP/1.1 404", 0), 0u);
+
+    exporter.stop();
+    EXPECT_FALSE(exporter.isRunning());
+    EXPECT_EQ(httpGet(exporter.getPort(), "/metrics"), "");
+}
+
+TEST(MetricsExporterTest, ConvertsLatencyHistogramsToCumulativeBuckets) {
+    PerformanceMonitor monitor;
+    monitor.recordStageLatency(PerformanceMonitor::LatencyStage::EnqueueToSend, std::chrono::microseconds(20));
+    monitor.recordStageLatency(PerformanceMonitor::LatencyStage::EnqueueToSend, std::chrono::microseconds(300));
+    monitor.recordStageLatency(PerformanceMonitor::LatencyStage::EnqueueToSend, std::chrono::seconds(2));
+    monitor.recordDroppedSamples(64);
+
+    MetricsExporter exporter;
+    exporter.addPerformanceMonitor(monitor);
+    std::string text = exporter.render();
+
+    const std::string prefix = "cvosc_stage_latency_seconds_bucket{stage=\"enqueue_to_send\",le=";
+    EXPECT_NE(text.find(prefix + "\"1e-05\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find(prefix + "\"2.5e-05\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find(prefix + "\"0.0005\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find(prefix + "\"1\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find(prefix + "\"+Inf\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("cvosc_stage_latency_seconds_count{stage=\"enqueue_to_send\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("cvosc_monitor_dropped_samples_total 64\n"), std::string::npos);
+}
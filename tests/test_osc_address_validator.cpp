@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCAddressValidator.h"
+#include "../src/osc/OSCSecurity.h"
+#include <random>
+
+TEST(OSCAddressValidatorTest, DfaAgreesWithStdRegex) {
+    const std::vector<std::string> patterns = {
+        R"(^/[a-zA-Z0-9/_-]*$)",
+        R"(/cv/[1-8](/(gain|offset))?)",
+        R"(/(?:mixer|fx)/\d{1,2}/[^/]+)",
+        R"(/lights/.*/dimmer)",
+        R"(/a+b*c?)",
+        R"(/x{2,}|/y{0,3})",
+        R"(/[\w.]+)",
+        R"(/[^\s]*\$)",
+        R"()",
+    };
+    const std::vector<std::string> addresses = {
+        "", "/", "/cv/1", "/cv/9", "/cv/3/gain", "/cv/3/pan", "/mixer/12/level", "/fx/123/x",
+        "/mixer/1/", "/lights/a/b/dimmer", "/lights//dimmer", "/lights/dimmer", "/aaab", "/ac",
+        "/abbc", "/xx", "/xxxxx", "/x", "/yyy", "/yyyy", "/file.name_1", "/has space$", "/no$",
+        "/bad!char", "relative/path", "/caf\xc3\xa9",
+    };
+
+    std::mt19937 rng(42);
+    const std::string alphabet = "/ab_cxy.-1290 $";
+    std::vector<std::string> inputs = addresses;
+    for (int i = 0; i < 500; i++) {
+        std::string random = "/";
+        for (int n = rng() % 10; n > 0; n--) random += alphabet[rng() % alphabet.size()];
+        inputs.push_back(random);
+    }
+
+    for (const auto& pattern : patterns) {
+        OSCAddressValidator validator;
+        validator.compile(pattern, {});
+        EXPECT_TRUE(validator.usesDfa()) << pattern;
+        std::regex reference(pattern);
+        for (const auto& address : inputs) {
+            EXPECT_EQ(validator.matchesPattern(address), std::regex_match(address, reference))
+                << "pattern " << pattern << " address " << address;
+        }
+    }
+}
+
+TEST(OSCAddressValidatorTest, UnsupportedSyntaxFallsBackToStdRegex) {
+    OSCAddressValidator validator;
+    validator.compile(R"(/(\w+)/\1)", {});     // Back-reference
+    EXPECT_FALSE(validator.usesDfa());
+    EXPECT_TRUE(validator.matchesPattern("/ab/ab"));
+    EXPECT_FALSE(validator.matchesPattern("/ab/cd"));
+}
+
+TEST(OSCAddressValidatorTest, WhitelistTrieMatchesExactAddressesOnly) {
+    OSCAddressValidator validator;
+    validator.compile(".*", {"/cv/1", "/cv/10", "/gate"});
+    EXPECT_TRUE(validator.isWhitelisted("/cv/1"));
+    EXPECT_TRUE(validator.isWhitelisted("/cv/10"));
+    EXPECT_FALSE(validator.isWhitelisted("/cv/"));
+    EXPECT_FALSE(validator.isWhitelisted("/cv/100"));
+    EXPECT_FALSE(validator.isWhitelisted("/gat"));
+
+    OSCSecurity::SecurityConfig config;
+    config.enableAddressWhitelist = true;
+    config.allowedAddresses = {"/cv/1", "/bad!"};
+    OSCSecurity security(config);
+    EXPECT_TRUE(security.isAddressValid("/cv/1"));
+    EXPECT_FALSE(security.isAddressValid("/cv/2"));
+    EXPECT_FALSE(security.isAddressValid("/bad!"));   // Whitelisted but fails the pattern
+}
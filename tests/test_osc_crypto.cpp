@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCSecurity.h"
+
+namespace {
+
+const std::string kSecret = "0123456789abcdef0123456789abcdef-test";
+
+OSCSecurityAdvanced::SecurityProfile makeProfile(OSCSecurityAdvanced::EncryptionMode encryption,
+                                                 OSCSecurityAdvanced::AuthMode authentication) {
+    OSCSecurityAdvanced::SecurityProfile profile;
+    profile.encryption = encryption;
+    profile.authentication = authentication;
+    profile.sharedSecret = kSecret;
+    return profile;
+}
+
+std::vector<uint8_t> seal(const OSCSecurityAdvanced& security, const std::vector<uint8_t>& payload) {
+    std::vector<uint8_t> packet(payload.size() + security.getOverhead());
+    size_t length = 0;
+    EXPECT_TRUE(security.sealPacket(payload.data(), payload.size(), packet.data(), packet.size(), length));
+    packet.resize(length);
+    return packet;
+}
+
+bool open(const OSCSecurityAdvanced& security, const std::vector<uint8_t>& packet, std::vector<uint8_t>& payload) {
+    payload.resize(packet.size());
+    size_t length = 0;
+    bool ok = security.openPacket(packet.data(), packet.size(), payload.data(), payload.size(), length);
+    payload.resize(length);
+    return ok;
+}
+
+} // namespace
+
+TEST(OSCCryptoTest, AeadRoundTripRejectsTamperingAndReplay) {
+    if (!OSCCrypto::isAvailable()) GTEST_SKIP() << "built without OpenSSL";
+    using EM = OSCSecurityAdvanced::EncryptionMode;
+    for (EM mode : {EM::AES_256_GCM, EM::CHACHA20_POLY1305}) {
+        OSCSecurityAdvanced sender(makeProfile(mode, OSCSecurityAdvanced::AuthMode::HMAC_SHA256));
+        OSCSecurityAdvanced receiver(makeProfile(mode, OSCSecurityAdvanced::AuthMode::HMAC_SHA256));
+
+        const std::vector<uint8_t> bundle = {'#', 'b', 'u', 'n', 'd', 'l', 'e', 0, 1, 2, 3, 4};
+        auto packet = seal(sender, bundle);
+        ASSERT_EQ(packet.size(), bundle.size() + OSCSecurityAdvanced::kHeaderSize + OSCAeadCipher::kTagSize);
+        EXPECT_TRUE(std::search(packet.begin(), packet.end(), bundle.begin(), bundle.end()) == packet.end());
+
+        std::vector<uint8_t> opened;
+        ASSERT_TRUE(open(receiver, packet, opened));
+        EXPECT_EQ(opened, bundle);
+        EXPECT_FALSE(open(receiver, packet, opened));   // Replay
+
+        for (size_t offset : {size_t(5), size_t(15), OSCSecurityAdvanced::kHeaderSize + 2, packet.size() - 1}) {
+            auto tampered = seal(sender, bundle);
+            tampered[offset] ^= 0x01;
+            EXPECT_FALSE(open(receiver, tampered, opened)) << "offset " << offset;
+        }
+
+        // Same secret, same sequence number: each session salts its own key
+        OSCSecurityAdvanced restarted(makeProfile(mode, OSCSecurityAdvanced::AuthMode::HMAC_SHA256));
+        OSCSecurityAdvanced other(makeProfile(mode, OSCSecurityAdvanced::AuthMode::HMAC_SHA256));
+        auto first = seal(restarted, bundle);
+        auto second = seal(other, bundle);
+        EXPECT_FALSE(std::equal(first.begin() + 8, first.begin() + 8 + OSCSecurityAdvanced::kSaltSize,
+                                second.begin() + 8));
+        EXPECT_NE(std::vector<uint8_t>(first.begin() + OSCSecurityAdvanced::kHeaderSize, first.end()),
+                  std::vector<uint8_t>(second.begin() + OSCSecurityAdvanced::kHeaderSize, second.end()));
+        ASSERT_TRUE(open(receiver, first, opened));
+        ASSERT_TRUE(open(receiver, second, opened));
+        EXPECT_EQ(opened, bundle);
+
+        OSCSecurityAdvanced stranger(makeProfile(mode, OSCSecurityAdvanced::AuthMode::HMAC_SHA256));
+        stranger.setSharedSecret("a-completely-different-shared-secret!!");
+        EXPECT_FALSE(open(receiver, seal(stranger, bundle), opened));
+    }
+}
+
+TEST(OSCCryptoTest, HmacOnlyAndLegacyApis) {
+    if (!OSCCrypto::isAvailable()) GTEST_SKIP() << "built without OpenSSL";
+    using EM = OSCSecurityAdvanced::EncryptionMode;
+    using AM = OSCSecurityAdvanced::AuthMode;
+    OSCSecurityAdvanced sender(makeProfile(EM::NONE, AM::HMAC_SHA256));
+    OSCSecurityAdvanced receiver(makeProfile(EM::NONE, AM::HMAC_SHA256));
+
+    std::vector<uint8_t> secureData;
+    ASSERT_TRUE(sender.secureOSCMessage("/cv/1", {0.5f, -2.0f}, secureData));
+    EXPECT_EQ(secureData.size(), 20 + OSCSecurityAdvanced::kHeaderSize + OSCCrypto::kMacSize);
+    std::string address;
+    std::vector<float> args;
+    ASSERT_TRUE(receiver.verifyOSCMessage(secureData, address, args));
+    EXPECT_EQ(address, "/cv/1");
+    EXPECT_EQ(args, (std::vector<float>{0.5f, -2.0f}));
+    secureData[OSCSecurityAdvanced::kHeaderSize + 1] ^= 0x20;   // Plaintext is visible but not forgeable
+    EXPECT_FALSE(receiver.verifyOSCMessage(secureData, address, args));
+
+    std::vector<uint8_t> signature;
+    ASSERT_TRUE(sender.signMessage({1, 2, 3}, signature));
+    EXPECT_TRUE(receiver.verifySignature({1, 2, 3}, signature));
+    EXPECT_FALSE(receiver.verifySignature({1, 2, 4}, signature));
+
+    OSCSecurityAdvanced aead(makeProfile(EM::AES_256_GCM, AM::HMAC_SHA256));
+    OSCSecurityAdvanced::EncryptedMessage encrypted;
+    ASSERT_TRUE(aead.encryptMessage({9, 8, 7}, encrypted));
+    std::vector<uint8_t> plaintext;
+    ASSERT_TRUE(aead.decryptMessage(encrypted, plaintext));
+    EXPECT_EQ(plaintext, (std::vector<uint8_t>{9, 8, 7}));
+    encrypted.timestamp++;   // Timestamp is authenticated
+    EXPECT_FALSE(aead.decryptMessage(encrypted, plaintext));
+}
+
+TEST(OSCCryptoTest, ReplayWindowAcceptsReorderingOnce) {
+    OSCReplayWindow window;
+    EXPECT_TRUE(window.accept(100));
+    EXPECT_TRUE(window.accept(98));       // Late but inside the window
+    EXPECT_FALSE(window.accept(98));
+    EXPECT_TRUE(window.accept(170));      // Shift across a word boundary
+    EXPECT_FALSE(window.accept(100));
+    EXPECT_TRUE(window.accept(99));
+    EXPECT_TRUE(window.accept(170 + OSCReplayWindow::kWindowSize));
+    EXPECT_FALSE(window.accept(170));     // Fell out of the window
+    EXPECT_TRUE(window.accept(171 + OSCReplayWindow::kWindowSize / 2));
+    EXPECT_FALSE(window.accept(171 + OSCReplayWindow::kWindowSize / 2));
+    EXPECT_EQ(window.getHighest(), 170 + OSCReplayWindow::kWindowSize);
+}
+
+TEST(OSCCryptoTest, FailsClosedWithoutKeys) {
+    OSCSecurityAdvanced::SecurityProfile profile;   // AES-256-GCM, no secret
+    OSCSecurityAdvanced security(profile);
+    std::vector<uint8_t> payload(16, 0), out(64);
+    size_t length = 0;
+    EXPECT_FALSE(security.sealPacket(payload.data(), payload.size(), out.data(), out.size(), length));
+    EXPECT_FALSE(security.setSharedSecret("too short"));
+    std::vector<uint8_t> forged(64, 0);
+    std::copy_n("#cvs\x02", 5, forged.begin());
+    EXPECT_FALSE(security.openPacket(forged.data(), forged.size(), out.data(), out.size(), length));
+}
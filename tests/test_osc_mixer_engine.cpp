@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 #include "../src/core/OSCMixerEngine.h"
 #include "../src/core/OSCMixerTypes.h"
+#include "../src/osc/OSCPacket.h"
+#include "../src/utils/PluginInsertChain.h"
+#include <arpa/inet.h>
 #include <chrono>
+#include <netinet/in.h>
+#include <sys/socket.h>
 #include <thread>
+#include <unistd.h>
 
 class OSCMixerEngineTest : public ::testing::Test {
 protected:
@@ -218,6 +224,90 @@ TEST_F(OSCMixerEngineTest, OSCMessageSending) {
     engine->sendOSCMessage(0, "test_device", message);
 }
 
+// A refused sendto on the reactor thread reaches the device status
+TEST_F(OSCMixerEngineTest, ReactorSendFailuresReachTheDevice) {
+    EXPECT_TRUE(engine->initialize());
+    
+    // The reactor's UDP socket has no SO_BROADCAST, so the kernel refuses every packet
+    OSCDeviceConfig outputDevice;
+    outputDevice.deviceId = "refused_output";
+    outputDevice.deviceName = "Refused Output";
+    outputDevice.networkAddress = "255.255.255.255";
+    outputDevice.port = 9;
+    outputDevice.oscAddress = "/test/output";
+    outputDevice.enabled = true;
+    ASSERT_TRUE(engine->addOutputDevice(0, outputDevice));
+    ASSERT_TRUE(engine->startChannel(0));
+    
+    engine->sendOSCMessage(0, "refused_output", 0.5f);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (engine->getDeviceStatus("refused_output").sendFailures == 0 &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    
+    DeviceStatus status = engine->getDeviceStatus("refused_output");
+    EXPECT_EQ(status.sendFailures, 1);
+    EXPECT_EQ(status.status, DeviceConnectionStatus::ERROR);
+    EXPECT_EQ(engine->getMixerState()->getChannel(0)->errors.load(), 1);
+    EXPECT_EQ(engine->getMixerState()->getChannel(0)->messagesSent.load(), 0);
+}
+
+// Fan-out batches must deliver every queued value in order unless coalescing is asked for
+TEST_F(OSCMixerEngineTest, FanoutKeepsEveryValueInOrder) {
+    int receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(receiver, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(receiver, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    socklen_t length = sizeof(address);
+    ASSERT_EQ(getsockname(receiver, reinterpret_cast<sockaddr*>(&address), &length), 0);
+    timeval timeout{0, 200000};
+    setsockopt(receiver, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    EXPECT_TRUE(engine->initialize());
+    engine->setOutputFanout(true);
+    EXPECT_FALSE(engine->isOutputCoalesceEnabled());
+    OSCDeviceConfig outputDevice;
+    outputDevice.deviceId = "fanout_output";
+    outputDevice.deviceName = "Fan-out Output";
+    outputDevice.networkAddress = "127.0.0.1";
+    outputDevice.port = ntohs(address.sin_port);
+    outputDevice.oscAddress = "/test/output";
+    outputDevice.enabled = true;
+    ASSERT_TRUE(engine->addOutputDevice(0, outputDevice));
+    ASSERT_TRUE(engine->startChannel(0));
+    
+    std::vector<float> sent;
+    for (int i = 0; i < 20; ++i) {
+        sent.push_back(i % 2 ? 1.0f : 0.0f);   // Every value is an edge
+        engine->sendOSCMessage(0, "fanout_output", sent.back());
+    }
+    
+    std::vector<float> received;
+    uint8_t buffer[2048];
+    while (received.size() < sent.size()) {
+        ssize_t size = recv(receiver, buffer, sizeof(buffer), 0);
+        if (size <= 0) break;
+        OSCPacket::forEachMessage(buffer, static_cast<size_t>(size), [&](const OSCPacket::Message& message) {
+            for (const auto& argument : message.arguments) received.push_back(static_cast<float>(argument.number));
+        });
+    }
+    close(receiver);
+    EXPECT_EQ(received, sent);
+}
+
+// The engine owns the insert chain that CV readers run, sized for any input device
+TEST_F(OSCMixerEngineTest, ProvidesTheInsertChain) {
+    auto chain = engine->getInsertChain();
+    ASSERT_NE(chain, nullptr);
+    EXPECT_EQ(engine->getInsertChain(), chain);
+    EXPECT_GE(chain->getMaxChannels(), 8);
+    EXPECT_GE(chain->getMaxFrames(), 128u);
+    EXPECT_TRUE(chain->getStatistics().empty());
+}
+
 // Test invalid inputs
 TEST_F(OSCMixerEngineTest, InvalidInputHandling) {
     EXPECT_TRUE(engine->initialize());
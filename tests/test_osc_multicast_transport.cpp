@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCMulticastTransport.h"
+#include "../src/osc/OSCNetworkReactor.h"
+#include "../src/osc/OSCPacket.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+template <typename Predicate>
+bool waitFor(Predicate predicate, int timeoutMs = 5000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(OSCMulticastTransportTest, FactoryCreatesAndValidatesGroups) {
+    auto multicast = OSCTransportFactory::create(OSCTransport::Protocol::MULTICAST);
+    ASSERT_NE(multicast, nullptr);
+    EXPECT_EQ(multicast->getProtocolName(), "Multicast");
+    EXPECT_FALSE(multicast->connect("127.0.0.1", "9000"));
+    EXPECT_NE(multicast->getLastError().find("not a multicast group"), std::string::npos);
+    EXPECT_TRUE(multicast->connect("239.255.0.1", "9000"));
+
+    auto broadcast = OSCTransportFactory::create(OSCTransport::Protocol::BROADCAST);
+    ASSERT_NE(broadcast, nullptr);
+    EXPECT_TRUE(broadcast->connect("255.255.255.255", "9000"));
+}
+
+TEST(OSCMulticastTransportTest, GroupMembersOnLoopbackReceiveOneSend) {
+    OSCNetworkReactor reactor(1);
+    std::atomic<int> first{0};
+    std::atomic<int> second{0};
+    // Two members sharing the port, both joined on the loopback interface
+    auto a = reactor.openMulticastReceiver("239.255.77.77", "0", [&](const uint8_t*, size_t, const sockaddr_storage&) {
+        first++;
+    }, "127.0.0.1");
+    ASSERT_NE(a, 0u);
+    std::string port = std::to_string(reactor.getLocalPort(a));
+    auto b = reactor.openMulticastReceiver("239.255.77.77", port, [&](const uint8_t*, size_t, const sockaddr_storage&) {
+        second++;
+    }, "127.0.0.1");
+    ASSERT_NE(b, 0u);
+
+    OSCMulticastTransport transport;
+    transport.setInterface("127.0.0.1");
+    transport.setLoopback(true);
+    transport.setTTL(0);
+    ASSERT_TRUE(transport.connect("239.255.77.77", port)) << transport.getLastError();
+    EXPECT_TRUE(transport.sendMessage("/cv/1", std::vector<float>{0.25f}));
+    EXPECT_TRUE(waitFor([&] { return first == 1 && second == 1; }));
+}
+
+TEST(OSCMulticastTransportTest, FanoutQueuesOneCopyForAllTargets) {
+    constexpr int kListeners = 8;
+    std::atomic<int> received{0};
+    std::atomic<int> mismatched{0};
+    OSCNetworkReactor reactor(1);
+    std::vector<OSCNetworkReactor::EndpointId> targets;
+    for (int i = 0; i < kListeners; i++) {
+        auto receiver = reactor.openUdpReceiver("0", [&](const uint8_t* data, size_t size, const sockaddr_storage&) {
+            int messages = 0;
+            OSCPacket::forEachMessage(data, size, [&](const OSCPacket::Message& m) {
+                if (m.arguments.size() != 1 || m.arguments[0].number != 0.5) mismatched++;
+                messages++;
+            });
+            if (messages != 2) mismatched++;
+            received++;
+        }, "127.0.0.1");
+        targets.push_back(reactor.openUdpTarget("127.0.0.1", std::to_string(reactor.getLocalPort(receiver))));
+    }
+
+    std::vector<uint8_t> bundle;
+    const float value = 0.5f;
+    OSCPacket::appendBundleHeader(bundle);
+    OSCPacket::appendBundleFloatMessage(bundle, "/cv/1", &value, 1);
+    OSCPacket::appendBundleFloatMessage(bundle, "/cv/2", &value, 1);
+    EXPECT_EQ(reactor.submitFanout(targets.data(), targets.size(), bundle.data(), bundle.size()), size_t(kListeners));
+
+    ASSERT_TRUE(waitFor([&] { return received == kListeners; }));
+    EXPECT_EQ(mismatched.load(), 0);
+    auto stats = reactor.getStats();
+    EXPECT_EQ(stats.packetsSent, uint64_t(kListeners));
+#if defined(__linux__)
+    EXPECT_EQ(stats.sendCalls, 1u);
+#endif
+}
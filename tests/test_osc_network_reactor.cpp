@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCNetworkReactor.h"
+#include "../src/osc/OSCPacket.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+template <typename Predicate>
+bool waitFor(Predicate predicate, int timeoutMs = 5000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(OSCPacketTest, EncodesFloatsAndDecodesNestedBundles) {
+    const float values[] = {0.5f, -2.0f};
+    std::vector<uint8_t> message;
+    OSCPacket::appendFloatMessage(message, "/cv/1", values, 2);
+    EXPECT_EQ(message.size(), OSCPacket::floatMessageSize("/cv/1", 2));
+    EXPECT_EQ(message.size(), 8u + 4u + 8u);
+
+    // #bundle { /cv/1, #bundle { /cv/1 } }
+    auto wrap = [](const std::vector<std::vector<uint8_t>>& elements) {
+        std::vector<uint8_t> bundle = {'#', 'b', 'u', 'n', 'd', 'l', 'e', 0, 0, 0, 0, 0, 0, 0, 0, 1};
+        for (const auto& element : elements) {
+            uint32_t size = static_cast<uint32_t>(element.size());
+            bundle.insert(bundle.end(), {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)});
+            bundle.insert(bundle.end(), element.begin(), element.end());
+        }
+        return bundle;
+    };
+    auto packet = wrap({message, wrap({message})});
+
+    std::vector<float> decoded;
+    ASSERT_TRUE(OSCPacket::forEachMessage(packet.data(), packet.size(), [&](const OSCPacket::Message& m) {
+        EXPECT_EQ(m.address, "/cv/1");
+        EXPECT_EQ(m.types, "ff");
+        for (const auto& argument : m.arguments) decoded.push_back(static_cast<float>(argument.number));
+    }));
+    EXPECT_EQ(decoded, (std::vector<float>{0.5f, -2.0f, 0.5f, -2.0f}));
+
+    packet.resize(packet.size() - 2);
+    EXPECT_FALSE(OSCPacket::forEachMessage(packet.data(), packet.size(), [](const OSCPacket::Message&) {}));
+}
+
+TEST(OSCNetworkReactorTest, DeliversToManyEndpointsFromOneThread) {
+    constexpr int kDevices = 32;
+    std::mutex mutex;
+    std::vector<int> counts(kDevices, 0);
+    std::vector<std::thread::id> handlerThreads;
+    std::vector<OSCNetworkReactor::EndpointId> targets;
+    OSCNetworkReactor reactor(1);   // Destroyed first, so handlers never outlive the state above
+
+    for (int i = 0; i < kDevices; i++) {
+        auto receiver = reactor.openUdpReceiver("0", [&, i](const uint8_t* data, size_t size, const sockaddr_storage&) {
+            std::lock_guard<std::mutex> lock(mutex);
+            OSCPacket::forEachMessage(data, size, [&](const OSCPacket::Message& m) {
+                EXPECT_EQ(m.arguments[0].number, float(i));
+            });
+            counts[i]++;
+            handlerThreads.push_back(std::this_thread::get_id());
+        }, "127.0.0.1");
+        ASSERT_NE(receiver, 0u);
+        targets.push_back(reactor.openUdpTarget("127.0.0.1", std::to_string(reactor.getLocalPort(receiver))));
+    }
+    EXPECT_EQ(reactor.getStats().receivers, size_t(kDevices));
+    EXPECT_EQ(reactor.getStats().targets, size_t(kDevices));
+
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < kDevices; i++) {
+            uint8_t packet[64];
+            float value = float(i);
+            size_t size = OSCPacket::writeFloatMessage(packet, sizeof(packet), "/cv", &value, 1);
+            ASSERT_TRUE(reactor.submit(targets[i], packet, size));
+        }
+    }
+    ASSERT_TRUE(waitFor([&] { return reactor.getStats().packetsReceived == 10u * kDevices; }));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int count : counts) EXPECT_EQ(count, 10);
+    for (auto id : handlerThreads) EXPECT_EQ(id, handlerThreads.front());
+    EXPECT_EQ(reactor.getStats().sendErrors, 0u);
+}
+
+TEST(OSCNetworkReactorTest, SubmissionsAreSentInBatches) {
+    std::atomic<int> received{0};
+    OSCNetworkReactor reactor(1);
+    auto receiver = reactor.openUdpReceiver("0", [&](const uint8_t*, size_t, const sockaddr_storage&) { received++; },
+                                            "127.0.0.1");
+    auto target = reactor.openUdpTarget("127.0.0.1", std::to_string(reactor.getLocalPort(receiver)));
+
+    const uint8_t packet[] = {'/', 'b', 0, 0, ',', 0, 0, 0};
+    for (int i = 0; i < 500; i++) {
+        ASSERT_TRUE(reactor.submit(target, packet, sizeof(packet)));
+    }
+    ASSERT_TRUE(waitFor([&] { return received == 500; }));
+    auto stats = reactor.getStats();
+    EXPECT_EQ(stats.packetsSent, 500u);
+#if defined(__linux__)
+    EXPECT_LT(stats.sendCalls, 500u);
+    EXPECT_LT(stats.receiveCalls, 500u);
+#endif
+
+    std::vector<uint8_t> oversized(OSCNetworkReactor::kMaxDatagramSize + 1);
+    EXPECT_FALSE(reactor.submit(target, oversized.data(), oversized.size()));
+    EXPECT_EQ(reactor.getStats().submissionsDropped, 1u);
+}
+
+TEST(OSCNetworkReactorTest, CloseStopsCallbacks) {
+    std::atomic<int> received{0};
+    OSCNetworkReactor reactor(1);
+    auto receiver = reactor.openUdpReceiver("0", [&](const uint8_t*, size_t, const sockaddr_storage&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        received++;
+    }, "127.0.0.1");
+    auto target = reactor.openUdpTarget("127.0.0.1", std::to_string(reactor.getLocalPort(receiver)));
+
+    const uint8_t packet[] = {'/', 'c', 0, 0, ',', 0, 0, 0};
+    for (int i = 0; i < 50; i++) reactor.submit(target, packet, sizeof(packet));
+    ASSERT_TRUE(waitFor([&] { return received > 0; }));
+    reactor.close(receiver);
+    int afterClose = received;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(received.load(), afterClose);
+    EXPECT_EQ(reactor.getLocalPort(receiver), 0);
+    EXPECT_FALSE(reactor.submit(receiver, packet, sizeof(packet)));
+}
+
+TEST(OSCNetworkReactorTest, SendResultsAreReportedPerTarget) {
+    std::mutex mutex;
+    std::vector<OSCNetworkReactor::SendResult> results;
+    OSCNetworkReactor reactor(1);
+    auto receiver = reactor.openUdpReceiver("0", [](const uint8_t*, size_t, const sockaddr_storage&) {}, "127.0.0.1");
+    auto good = reactor.openUdpTarget("127.0.0.1", std::to_string(reactor.getLocalPort(receiver)));
+    // The reactor's send socket has no SO_BROADCAST, so the kernel refuses this one
+    auto refused = reactor.openUdpTarget("255.255.255.255", "9");
+    for (auto target : {good, refused}) {
+        reactor.setSendObserver(target, [&](const OSCNetworkReactor::SendResult& result) {
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(result);
+        });
+    }
+
+    const uint8_t packet[] = {'/', 'r', 0, 0, ',', 0, 0, 0};
+    for (uint64_t tag = 1; tag <= 200; tag++) {
+        ASSERT_TRUE(reactor.submit(good, packet, sizeof(packet), tag));
+    }
+    ASSERT_TRUE(reactor.submit(refused, packet, sizeof(packet), 999));
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return results.size() == 201;
+    }));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t expectedTag = 1;
+    for (const auto& result : results) {
+        if (result.target == good) {
+            EXPECT_EQ(result.error, 0);
+            EXPECT_EQ(result.tag, expectedTag++);   // In submission order
+        } else {
+            EXPECT_EQ(result.target, refused);
+            EXPECT_EQ(result.tag, 999u);
+            EXPECT_NE(result.error, 0);
+        }
+    }
+    EXPECT_EQ(reactor.getEndpointStats(good).packetsSent, 200u);
+    EXPECT_EQ(reactor.getEndpointStats(good).sendErrors, 0u);
+    EXPECT_EQ(reactor.getEndpointStats(refused).sendErrors, 1u);
+    EXPECT_EQ(reactor.getEndpointStats(refused).lastError, results.back().error);
+
+    // Nothing is reported once the target is closed
+    reactor.close(good);
+    size_t reported = results.size();
+    EXPECT_FALSE(reactor.submit(good, packet, sizeof(packet), 1));
+    EXPECT_EQ(results.size(), reported);
+}
+
+TEST(OSCNetworkReactorTest, PacedTargetSpreadsPacketsInOrder) {
+    std::mutex mutex;
+    std::vector<OSCNetworkReactor::SendResult> results;
+    std::atomic<int> received{0};
+    OSCNetworkReactor reactor(1);
+    auto receiver = reactor.openUdpReceiver("0", [&](const uint8_t*, size_t, const sockaddr_storage&) { received++; },
+                                            "127.0.0.1");
+    auto target = reactor.openUdpTarget("127.0.0.1", std::to_string(reactor.getLocalPort(receiver)));
+    reactor.setSendObserver(target, [&](const OSCNetworkReactor::SendResult& result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(result);
+    });
+    OSCSendPacer::Config config;
+    config.maxRate = 500.0;   // A burst of one packet, then one every 2 ms
+    config.minRate = 500.0;
+    reactor.setPacing(target, true, config);
+    EXPECT_DOUBLE_EQ(reactor.getEndpointStats(target).pacingRate, 500.0);
+
+    const uint8_t packet[] = {'/', 'p', 0, 0, ',', 0, 0, 0};
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t tag = 1; tag <= 50; tag++) {
+        ASSERT_TRUE(reactor.submit(target, packet, sizeof(packet), tag));
+    }
+    ASSERT_TRUE(waitFor([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return results.size() == 50;
+    }));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(80));   // 49 intervals of 2 ms
+    EXPECT_TRUE(waitFor([&] { return received == 50; }));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < results.size(); i++) {
+        EXPECT_EQ(results[i].error, 0);
+        EXPECT_EQ(results[i].tag, i + 1);
+    }
+    reactor.setPacing(target, false);
+    EXPECT_DOUBLE_EQ(reactor.getEndpointStats(target).pacingRate, 0.0);
+}
+
+TEST(OSCNetworkReactorTest, PacedBacklogReportsBackpressure) {
+    OSCNetworkReactor reactor(1);
+    auto receiver = reactor.openUdpReceiver("0", [](const uint8_t*, size_t, const sockaddr_storage&) {}, "127.0.0.1");
+    auto target = reactor.openUdpTarget("127.0.0.1", std::to_string(reactor.getLocalPort(receiver)));
+    OSCSendPacer::Config config;
+    config.maxRate = 10.0;
+    config.minRate = 10.0;
+    reactor.setPacing(target, true, config);
+    EXPECT_FALSE(reactor.isBackpressured(target));
+
+    const uint8_t packet[] = {'/', 'p', 0, 0, ',', 0, 0, 0};
+    for (uint64_t tag = 1; tag <= OSCNetworkReactor::kMaxPacedPackets / 2 + 32; tag++) {
+        ASSERT_TRUE(reactor.submit(target, packet, sizeof(packet), tag));
+    }
+    EXPECT_TRUE(waitFor([&] { return reactor.isBackpressured(target); }));
+    EXPECT_TRUE(reactor.getEndpointStats(target).backpressured);
+
+    // Turning pacing off sends the backlog and clears the flag
+    reactor.setPacing(target, false);
+    EXPECT_FALSE(reactor.isBackpressured(target));
+}
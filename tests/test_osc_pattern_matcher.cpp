@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCSecurity.h"
+#include <random>
+
+namespace {
+
+OSCPatternMatcher::RouteRule route(const std::string& pattern, OSCPatternMatcher::MatchType type, int priority,
+                                   const std::string& target) {
+    OSCPatternMatcher::RouteRule rule;
+    rule.pattern = pattern;
+    rule.matchType = type;
+    rule.priority = priority;
+    rule.targetAddress = target;
+    rule.targetHost = "127.0.0.1";
+    rule.targetPort = "9000";
+    return rule;
+}
+
+} // namespace
+
+TEST(OSCPatternMatcherTest, OSCPatternSyntax) {
+    OSCPatternMatcher matcher;
+    EXPECT_TRUE(matcher.matchOSCPattern("/cv/[1-4]/gain", "/cv/3/gain"));
+    EXPECT_FALSE(matcher.matchOSCPattern("/cv/[1-4]/gain", "/cv/5/gain"));
+    EXPECT_TRUE(matcher.matchOSCPattern("/cv/[!1-4]", "/cv/7"));
+    EXPECT_TRUE(matcher.matchOSCPattern("/{mixer,fx}/*/level", "/fx/reverb/level"));
+    EXPECT_FALSE(matcher.matchOSCPattern("/{mixer,fx}/*/level", "/eq/low/level"));
+    EXPECT_FALSE(matcher.matchOSCPattern("/mixer/*", "/mixer/1/level"));   // '*' stays in its segment
+    EXPECT_TRUE(matcher.matchOSCPattern("/mixer/?", "/mixer/1"));
+}
+
+TEST(OSCPatternMatcherTest, BestMatchHonoursPriorityAndCaptures) {
+    using MT = OSCPatternMatcher::MatchType;
+    OSCPatternMatcher matcher;
+    matcher.addRoute(route("/cv/", MT::PREFIX, 0, "/any"));
+    matcher.addRoute(route("/cv/*/{gain,offset}", MT::OSC_PATTERN, 5, "/param"));
+    matcher.addRoute(route(R"(/cv/(\d+)/gain)", MT::REGEX, 10, "/gain"));
+    matcher.addRoute(route("/cv/1/gain", MT::EXACT, 10, "/exact"));   // Same priority, added later
+
+    auto best = matcher.findBestMatch("/cv/12/gain");
+    ASSERT_TRUE(best.matched);
+    EXPECT_EQ(best.targetAddress, "/gain");
+    EXPECT_EQ(best.capturedGroups["1"], "12");
+
+    best = matcher.findBestMatch("/cv/1/gain");
+    EXPECT_EQ(best.targetAddress, "/gain");     // Earlier rule wins the tie
+
+    best = matcher.findBestMatch("/cv/7/offset");
+    EXPECT_EQ(best.targetAddress, "/param");
+    EXPECT_EQ(best.capturedGroups["1"], "7");
+    EXPECT_EQ(best.capturedGroups["2"], "offset");
+
+    auto all = matcher.matchPattern("/cv/1/gain");
+    ASSERT_EQ(all.size(), 4u);
+    EXPECT_EQ(all[1].targetAddress, "/exact");
+    EXPECT_EQ(all[3].targetAddress, "/any");
+
+    matcher.removeRoute(R"(/cv/(\d+)/gain)");
+    EXPECT_EQ(matcher.findBestMatch("/cv/1/gain").targetAddress, "/exact");
+    EXPECT_FALSE(matcher.findBestMatch("/lights/1").matched);
+}
+
+TEST(OSCPatternMatcherTest, AutomatonAgreesWithPerRuleMatching) {
+    using MT = OSCPatternMatcher::MatchType;
+    std::mt19937 rng(7);
+    const std::vector<std::string> pieces = {"/", "cv", "fx", "1", "2", "*", "?", "[12]", "[!a]", "{cv,fx}", "a"};
+    const std::vector<MT> types = {MT::EXACT, MT::PREFIX, MT::SUFFIX, MT::CONTAINS, MT::WILDCARD, MT::OSC_PATTERN};
+
+    OSCPatternMatcher matcher;
+    for (int i = 0; i < 200; i++) {
+        std::string pattern = "/";
+        for (int n = 1 + rng() % 5; n > 0; n--) pattern += pieces[rng() % pieces.size()];
+        matcher.addRoute(route(pattern, types[rng() % types.size()], rng() % 4, "/r" + std::to_string(i)));
+    }
+
+    const std::string alphabet = "/cvfx12a";
+    for (int i = 0; i < 2000; i++) {
+        std::string address = "/";
+        for (int n = rng() % 10; n > 0; n--) address += alphabet[rng() % alphabet.size()];
+
+        std::vector<std::string> expected;
+        for (const auto& rule : matcher.getRoutes()) {   // Sorted by priority, ties in insertion order
+            if (matcher.isMatch(address, rule)) expected.push_back(rule.targetAddress);
+        }
+        std::vector<std::string> actual;
+        for (const auto& result : matcher.matchPattern(address)) actual.push_back(result.targetAddress);
+        ASSERT_EQ(actual, expected) << address;
+    }
+}
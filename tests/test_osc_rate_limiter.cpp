@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCRateLimiter.h"
+#include "../src/osc/OSCSecurity.h"
+#include <thread>
+
+namespace {
+
+constexpr int64_t kSecond = 1000000000;
+
+} // namespace
+
+TEST(OSCRateLimiterTest, AllowsTheBurstThenRefillsContinuously) {
+    OSCRateLimiter limiter;
+    OSCRateLimiter::Limits limits{10.0, 5.0};   // One token per 100ms
+    const int64_t start = 100 * kSecond;
+
+    int allowed = 0;
+    for (int i = 0; i < 20; i++) {
+        allowed += limiter.tryAcquire("10.0.0.1:9000", limits, start);
+    }
+    EXPECT_EQ(allowed, 5);
+
+    // No window edge to exploit: 250ms buys two tokens, not a fresh burst
+    allowed = 0;
+    for (int i = 0; i < 20; i++) {
+        allowed += limiter.tryAcquire("10.0.0.1:9000", limits, start + kSecond / 4);
+    }
+    EXPECT_EQ(allowed, 2);
+
+    auto stats = limiter.getStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].key, "10.0.0.1:9000");
+    EXPECT_EQ(stats[0].allowed, 7u);
+    EXPECT_EQ(stats[0].dropped, 33u);
+}
+
+TEST(OSCRateLimiterTest, EvictsOnlyIdleSourcesWhenATableWindowIsFull) {
+    OSCRateLimiter limiter;
+    limiter.setIdleTimeout(std::chrono::seconds(1));
+    OSCRateLimiter::Limits limits{1000.0, 10.0};
+    const size_t capacity = OSCRateLimiter::kShards * OSCRateLimiter::kSlotsPerShard;
+
+    for (size_t i = 0; i < capacity * 2; i++) {
+        limiter.tryAcquire("source-" + std::to_string(i), limits, kSecond);
+    }
+    // Everything is active: no evictions, the excess shares the overflow bucket
+    EXPECT_EQ(limiter.getEvictions(), 0u);
+    EXPECT_LE(limiter.size(), capacity);
+
+    for (size_t i = 0; i < capacity; i++) {
+        limiter.tryAcquire("late-" + std::to_string(i), limits, 10 * kSecond);
+    }
+    EXPECT_GT(limiter.getEvictions(), 0u);
+}
+
+TEST(OSCSecurityRateLimitTest, NoisySourceDoesNotStarveOthers) {
+    OSCSecurity::SecurityConfig config;
+    config.maxMessagesPerSecond = 1;
+    config.rateLimitBurst = 3;
+    config.addressRateLimits.push_back({"/lights/", 1.0, 2.0});
+    OSCSecurity security(config);
+
+    int noisy = 0;
+    for (int i = 0; i < 100; i++) {
+        noisy += security.checkRateLimit("10.0.0.2:8000", "/cv/1");
+    }
+    EXPECT_EQ(noisy, 3);
+    EXPECT_TRUE(security.checkRateLimit("10.0.0.3:8000", "/cv/1"));
+
+    // The address bucket is shared by every source
+    EXPECT_TRUE(security.checkRateLimit("10.0.0.4:8000", "/lights/1"));
+    EXPECT_TRUE(security.checkRateLimit("10.0.0.5:8000", "/lights/2"));
+    EXPECT_FALSE(security.checkRateLimit("10.0.0.6:8000", "/lights/3"));
+
+    auto sources = security.getSourceRateStats();
+    ASSERT_FALSE(sources.empty());
+    EXPECT_EQ(sources[0].key, "10.0.0.2:8000");
+    EXPECT_EQ(sources[0].dropped, 97u);
+}
+
+TEST(OSCRateLimiterTest, ConcurrentSourcesKeepExactCounts) {
+    OSCRateLimiter limiter;
+    OSCRateLimiter::Limits limits{1.0, 50.0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&limiter, &limits]() {
+            for (int i = 0; i < 1000; i++) {
+                limiter.tryAcquire("shared", limits, kSecond);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto stats = limiter.getStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].allowed, 50u);
+    EXPECT_EQ(stats[0].dropped, 3950u);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCSendPacer.h"
+#include "../src/osc/OSCSenderEnhanced.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+constexpr int64_t kMs = 1000000;
+
+OSCSendPacer::Config testConfig() {
+    OSCSendPacer::Config config;
+    config.maxRate = 1000.0;
+    config.minRate = 100.0;
+    config.burstMs = 2.0;
+    return config;
+}
+
+} // namespace
+
+TEST(OSCSendPacerTest, BucketSpreadsPacketsAtTheRate) {
+    OSCSendPacer pacer(testConfig());
+    int64_t now = 1000 * kMs;
+
+    // The burst goes at once, then one packet per millisecond
+    EXPECT_TRUE(pacer.tryAcquire(now));
+    EXPECT_TRUE(pacer.tryAcquire(now));
+    EXPECT_FALSE(pacer.tryAcquire(now));
+    EXPECT_NEAR(pacer.nanosUntilNext(now), kMs, kMs / 100);
+
+    int sent = 0;
+    for (int64_t t = now; t < now + 100 * kMs; t += kMs / 10) {
+        while (pacer.tryAcquire(t)) sent++;
+    }
+    EXPECT_NEAR(sent, 100, 2);
+}
+
+TEST(OSCSendPacerTest, CongestionErrorsCutRateAndQuietRestoresIt) {
+    OSCSendPacer pacer(testConfig());
+    int64_t now = 1000 * kMs;
+    pacer.tryAcquire(now);
+
+    pacer.onSendFailed(now, ENOBUFS);
+    EXPECT_DOUBLE_EQ(pacer.rate(), 500.0);
+    // The same episode within the hold-off is not cut twice
+    pacer.onSendFailed(now + 10 * kMs, EAGAIN);
+    EXPECT_DOUBLE_EQ(pacer.rate(), 500.0);
+    // A refused port is loss, but not congestion
+    pacer.onSendFailed(now + 60 * kMs, ECONNREFUSED);
+    EXPECT_DOUBLE_EQ(pacer.rate(), 500.0);
+    EXPECT_GT(pacer.lossRate(), 0.0);
+    EXPECT_EQ(pacer.congestionEvents(), 1u);
+
+    // Additive increase of 5% of the maximum per clean 100 ms
+    int64_t t = now;
+    while (pacer.rate() < 1000.0 && t < now + 10000 * kMs) {
+        t += kMs;
+        pacer.onSent(t, 0);
+    }
+    EXPECT_DOUBLE_EQ(pacer.rate(), 1000.0);
+    EXPECT_NEAR(double(t - now) / kMs, 1000.0, 101.0);
+    EXPECT_LT(pacer.lossRate(), 0.01);
+}
+
+TEST(OSCSendPacerTest, QueueGrowthAndReportedLossAreCongestion) {
+    OSCSendPacer pacer(testConfig());
+    int64_t now = 1000 * kMs;
+    pacer.tryAcquire(now);
+
+    // Above the high-water mark but shrinking: draining, not congested
+    pacer.onSent(now, 200 * 1024);
+    EXPECT_EQ(pacer.congestionEvents(), 1u);   // First sample is growth from zero
+    pacer.onSent(now + 60 * kMs, 100 * 1024);
+    EXPECT_EQ(pacer.congestionEvents(), 1u);
+    pacer.onSent(now + 120 * kMs, 150 * 1024);
+    EXPECT_EQ(pacer.congestionEvents(), 2u);
+    EXPECT_DOUBLE_EQ(pacer.rate(), 250.0);
+
+    // A long RTT stretches the hold-off to one round trip
+    pacer.onFeedback(now + 500 * kMs, 0.10, 300.0);
+    EXPECT_EQ(pacer.congestionEvents(), 3u);
+    EXPECT_DOUBLE_EQ(pacer.rate(), 125.0);
+    EXPECT_DOUBLE_EQ(pacer.lossRate(), 0.10);
+    EXPECT_DOUBLE_EQ(pacer.roundTripMs(), 300.0);
+    pacer.onFeedback(now + 700 * kMs, 0.10, 300.0);
+    EXPECT_EQ(pacer.congestionEvents(), 3u);
+    pacer.onFeedback(now + 850 * kMs, 0.10, 300.0);
+    EXPECT_EQ(pacer.congestionEvents(), 4u);
+    EXPECT_DOUBLE_EQ(pacer.rate(), 100.0);   // Floor
+}
+
+TEST(OSCSendPacerTest, SenderSpreadsABurstOverTime) {
+    int socketFd = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(socketFd, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(socketFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    socklen_t length = sizeof(addr);
+    getsockname(socketFd, reinterpret_cast<sockaddr*>(&addr), &length);
+    timeval timeout{2, 0};
+    setsockopt(socketFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    OSCSenderEnhanced sender;
+    ASSERT_TRUE(sender.connect("127.0.0.1", std::to_string(ntohs(addr.sin_port))));
+    sender.setPacing(true, 500.0);
+
+    constexpr int kMessages = 50;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kMessages; i++) {
+        EXPECT_TRUE(sender.sendFloat("/cv/1", float(i)));
+    }
+    // The calls return at once; the queue holds what the bucket has not released yet
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_GT(sender.getStatistics().pendingSends, 0u);
+
+    int received = 0;
+    char buffer[256];
+    while (received < kMessages && recv(socketFd, buffer, sizeof(buffer), 0) > 0) {
+        received++;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    close(socketFd);
+
+    EXPECT_EQ(received, kMessages);
+    // 50 packets at 500/s, less the one-packet burst: about 98 ms
+    EXPECT_GE(elapsed, std::chrono::milliseconds(80));
+    auto stats = sender.getStatistics();
+    EXPECT_EQ(stats.messagesSent, uint64_t(kMessages));
+    EXPECT_EQ(stats.pendingSends, 0u);
+    EXPECT_DOUBLE_EQ(stats.pacingRate, 500.0);
+    EXPECT_EQ(stats.destination, "127.0.0.1:" + std::to_string(ntohs(addr.sin_port)));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "../src/osc/OSCSenderEnhanced.h"
 #include "../src/osc/OSCReceiver.h"
+#include "../src/core/PerformanceMonitor.h"
 #include <thread>
 #include <chrono>
 #include <atomic>
@@ -281,6 +282,28 @@ TEST_F(OSCSenderEnhancedTest, TCPOptions) {
     EXPECT_TRUE(sender->sendFloat("/test", 1.0f));
 }
 
+// Only measured exchanges reach the latency histogram, each one counted
+TEST_F(OSCSenderEnhancedTest, RoundTripsAreRecordedPerExchange) {
+    setupReceiver("9065", OSCReceiver::Protocol::TCP);
+    ASSERT_TRUE(sender->connect("localhost", "9065", OSCTransport::Protocol::TCP));
+    PerformanceMonitor monitor;
+    sender->attachMonitor(monitor);
+    
+    // The transport's smoothed RTT is not a sample
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_TRUE(sender->sendFloat("/rtt", static_cast<float>(i)));
+    }
+    EXPECT_EQ(monitor.getStageHistogram(PerformanceMonitor::LatencyStage::SendToAck).count, 0u);
+    
+    // Identical measurements are still separate exchanges
+    sender->reportPathFeedback(0.0, 4.0);
+    sender->reportPathFeedback(0.0, 4.0);
+    sender->reportPathFeedback(0.0, 6.0);
+    auto histogram = monitor.getStageHistogram(PerformanceMonitor::LatencyStage::SendToAck);
+    EXPECT_EQ(histogram.count, 3u);
+    EXPECT_EQ(histogram.sum, 14000000u);
+}
+
 // Performance test
 TEST_F(OSCSenderEnhancedTest, PerformanceTest) {
     setupReceiver("9070");
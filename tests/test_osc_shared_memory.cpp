@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCSharedMemoryTransport.h"
+#include "../src/osc/OSCSharedMemoryReader.h"
+#include "../src/osc/OSCPacket.h"
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// Unique per process so parallel test runs do not share a ring
+std::string testPort(int index) {
+    return "test-" + std::to_string(getpid()) + "-" + std::to_string(index);
+}
+
+float firstFloat(const std::vector<uint8_t>& packet) {
+    float value = -1.0f;
+    OSCPacket::forEachMessage(packet.data(), packet.size(), [&](const OSCPacket::Message& m) {
+        if (!m.arguments.empty()) value = static_cast<float>(m.arguments[0].number);
+    });
+    return value;
+}
+
+} // namespace
+
+TEST(OSCSharedMemoryTest, ReaderSeesEveryPacketInOrderAcrossWrap) {
+    std::string port = testPort(1);
+    auto transport = OSCTransportFactory::create(OSCTransport::Protocol::SHARED_MEMORY);
+    ASSERT_NE(transport, nullptr);
+    static_cast<OSCSharedMemoryTransport*>(transport.get())->setCapacity(4096);
+    EXPECT_FALSE(transport->connect("192.0.2.1", port));
+    ASSERT_TRUE(transport->connect("localhost", port)) << transport->getLastError();
+
+    OSCSharedMemoryReader reader;
+    ASSERT_TRUE(reader.open(port)) << reader.getLastError();
+    std::vector<uint8_t> packet;
+    EXPECT_FALSE(reader.read(packet));
+
+    // 32-byte records in a 4 KiB ring: several laps, each drained before the next
+    for (int lap = 0; lap < 10; lap++) {
+        for (int i = 0; i < 40; i++) {
+            ASSERT_TRUE(transport->sendMessage("/cv/1", std::vector<float>{float(lap * 40 + i)}));
+        }
+        for (int i = 0; i < 40; i++) {
+            ASSERT_TRUE(reader.read(packet));
+            EXPECT_EQ(firstFloat(packet), float(lap * 40 + i));
+        }
+        EXPECT_FALSE(reader.read(packet));
+    }
+    EXPECT_EQ(reader.getStats().packetsRead, 400u);
+    EXPECT_EQ(reader.getStats().overruns, 0u);
+    OSCSharedMemoryTransport::removeSegment(port);
+}
+
+TEST(OSCSharedMemoryTest, LappedReaderResyncsAndCountsOverrun) {
+    std::string port = testPort(2);
+    OSCSharedMemoryTransport transport;
+    transport.setCapacity(4096);
+    ASSERT_TRUE(transport.connect("", port));
+    OSCSharedMemoryReader reader;
+    ASSERT_TRUE(reader.open(port));
+
+    // Far more than the ring holds, so the reader's position is overwritten
+    for (int i = 0; i < 500; i++) {
+        transport.sendMessage("/cv/1", std::vector<float>{float(i)});
+    }
+    std::vector<uint8_t> packet;
+    EXPECT_FALSE(reader.read(packet));
+    EXPECT_EQ(reader.getStats().overruns, 1u);
+
+    // After the resync the reader follows new packets normally
+    transport.sendMessage("/cv/1", std::vector<float>{1000.0f});
+    ASSERT_TRUE(reader.read(packet));
+    EXPECT_EQ(firstFloat(packet), 1000.0f);
+
+    // Oversized packets are refused rather than wrapping over readers
+    std::vector<uint8_t> big(2048);
+    EXPECT_FALSE(transport.sendPacket(big.data(), big.size()));
+    OSCSharedMemoryTransport::removeSegment(port);
+}
+
+TEST(OSCSharedMemoryTest, WaitingReaderIsWokenByPublish) {
+    std::string port = testPort(3);
+    OSCSharedMemoryTransport transport;
+    ASSERT_TRUE(transport.connect("127.0.0.1", port));
+    OSCSharedMemoryReader reader;
+    ASSERT_TRUE(reader.open(port));
+
+    std::thread producer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        transport.sendMessage("/cv/2", std::vector<float>{0.5f});
+    });
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> packet;
+    while (!reader.read(packet)) {
+        reader.wait(5000);
+    }
+    auto waited = std::chrono::steady_clock::now() - start;
+    producer.join();
+
+    EXPECT_EQ(firstFloat(packet), 0.5f);
+    EXPECT_LT(waited, std::chrono::seconds(2));
+    OSCSharedMemoryTransport::removeSegment(port);
+}
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCStream.h"
+#include "../src/osc/OSCReceiver.h"
+#include "../src/osc/OSCSender.h"
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace {
+
+using Packet = std::vector<uint8_t>;
+
+// Encodes one bundle per call; returns every packet the encoder emitted
+std::vector<Packet> encode(OSCStream::Encoder& encoder, const std::vector<std::pair<std::string, float>>& values) {
+    std::vector<Packet> packets;
+    Packet bundle;
+    encoder.begin(bundle, OSCPacket::timetagNow());
+    for (const auto& [address, value] : values) {
+        OSCPacket::appendBundleFloatMessage(bundle, address, &value, 1);
+    }
+    encoder.finish(bundle, [&](const uint8_t* data, size_t size) {
+        packets.emplace_back(data, data + size);
+        return true;
+    });
+    return packets;
+}
+
+struct Collector {
+    std::vector<std::pair<std::string, float>> delivered;
+
+    void feed(OSCStream::Decoder& decoder, const Packet& packet) {
+        ASSERT_TRUE(decoder.process(packet.data(), packet.size(), OSCPacket::timetagNow(),
+                                    [this](const OSCPacket::Message& message) {
+                                        delivered.emplace_back(std::string(message.address),
+                                                               float(message.arguments.at(0).number));
+                                    }));
+    }
+};
+
+} // namespace
+
+TEST(OSCStreamTest, GapsReorderingAndDuplicatesAreCounted) {
+    OSCStream::Encoder encoder;
+    std::vector<Packet> packets;
+    for (int i = 0; i < 8; i++) {
+        packets.push_back(encode(encoder, {{"/cv/" + std::to_string(i), float(i)}})[0]);
+    }
+    // Plain bundles to any OSC receiver, with the sequence element first
+    EXPECT_TRUE(OSCStream::Decoder::isStreamPacket(packets[0].data(), packets[0].size()));
+
+    OSCStream::Decoder decoder;
+    Collector collector;
+    for (int index : {0, 1, 3, 2, 2, 6, 7}) {
+        collector.feed(decoder, packets[index]);
+    }
+
+    auto stats = decoder.getStats();
+    EXPECT_EQ(stats.packetsReceived, 6u);
+    EXPECT_EQ(stats.packetsReordered, 1u);    // 2 after 3
+    EXPECT_EQ(stats.duplicatesDropped, 1u);
+    EXPECT_EQ(stats.packetsLost, 2u);         // 4 and 5 never came
+    EXPECT_EQ(stats.streams, 1u);
+    EXPECT_NEAR(stats.lossRate(), 2.0 / 8.0, 1e-9);
+    EXPECT_EQ(collector.delivered.size(), 6u);
+
+    decoder.resetStats();
+    EXPECT_EQ(decoder.getStats().packetsLost, 0u);
+}
+
+TEST(OSCStreamTest, XorParityRebuildsOneLostBundlePerGroup) {
+    OSCStream::Config config;
+    config.redundancy = OSCStream::Redundancy::XOR_PARITY;
+    config.parityGroup = 4;
+    OSCStream::Encoder encoder(config);
+    OSCStream::Decoder decoder;
+    Collector collector;
+
+    // A gate edge per bundle; bundles of different sizes so the lengths must be rebuilt too
+    std::vector<std::vector<Packet>> sent;
+    for (int i = 0; i < 12; i++) {
+        std::vector<std::pair<std::string, float>> values = {{"/gate/" + std::to_string(i), 1.0f}};
+        if (i % 3 == 0) values.push_back({"/cv/pitch", float(i)});
+        sent.push_back(encode(encoder, values));
+        EXPECT_EQ(sent.back().size(), i % 4 == 3 ? 2u : 1u);   // Parity after each fourth
+    }
+
+    // Group 1 loses its second bundle, group 2 its last, group 3 two (not recoverable)
+    std::set<int> lost = {1, 7, 9, 10};
+    for (int i = 0; i < 12; i++) {
+        for (size_t p = 0; p < sent[i].size(); p++) {
+            if (p == 0 && lost.count(i)) continue;
+            collector.feed(decoder, sent[i][p]);
+        }
+    }
+
+    std::set<std::string> gates;
+    for (const auto& [address, value] : collector.delivered) {
+        if (address.rfind("/gate/", 0) == 0) gates.insert(address);
+    }
+    EXPECT_EQ(gates.size(), 10u);
+    EXPECT_TRUE(gates.count("/gate/1"));
+    EXPECT_TRUE(gates.count("/gate/7"));
+
+    auto stats = decoder.getStats();
+    EXPECT_EQ(stats.packetsRecovered, 2u);
+    EXPECT_EQ(stats.packetsLost, 2u);
+    EXPECT_EQ(stats.packetsReceived, 10u);
+}
+
+TEST(OSCStreamTest, LateBundleOnlyDeliversAddressesNotSinceRefreshed) {
+    OSCStream::Encoder encoder;
+    Packet older = encode(encoder, {{"/cv/1", 0.1f}, {"/trigger", 1.0f}})[0];
+    Packet newer = encode(encoder, {{"/cv/1", 0.2f}})[0];
+
+    OSCStream::Decoder decoder;
+    Collector collector;
+    collector.feed(decoder, newer);
+    collector.feed(decoder, older);
+
+    // The old CV value would step backwards; the trigger was only in the late bundle
+    ASSERT_EQ(collector.delivered.size(), 2u);
+    EXPECT_EQ(collector.delivered[0], std::make_pair(std::string("/cv/1"), 0.2f));
+    EXPECT_EQ(collector.delivered[1], std::make_pair(std::string("/trigger"), 1.0f));
+    EXPECT_EQ(decoder.getStats().staleMessagesDropped, 1u);
+    EXPECT_EQ(decoder.getStats().packetsLost, 0u);
+}
+
+TEST(OSCStreamTest, DuplicatedStreamReachesReceiverOnce) {
+    OSCReceiver receiver;
+    std::atomic<int> values{0};
+    receiver.setFloatHandler([&](const std::string& path, float) {
+        if (path == "/cv/1") values++;
+    });
+    ASSERT_TRUE(receiver.start("0"));
+    std::string url = receiver.getURL();
+    std::string port = url.substr(url.rfind(':') + 1);
+    port.pop_back();   // Trailing '/'
+
+    OSCSender sender("127.0.0.1", port);
+    OSCStream::Config config;
+    config.redundancy = OSCStream::Redundancy::DUPLICATE;
+    sender.setStreamMode(true, config);
+    ASSERT_TRUE(sender.isStreamMode());
+
+    constexpr int kMessages = 20;
+    for (int i = 0; i < kMessages; i++) {
+        EXPECT_TRUE(sender.sendFloat("/cv/1", i / 20.0f));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (receiver.getStreamStats().duplicatesDropped < kMessages && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    receiver.stop();
+
+    auto stats = receiver.getStreamStats();
+    EXPECT_EQ(values.load(), kMessages);
+    EXPECT_EQ(stats.packetsReceived, uint64_t(kMessages));
+    EXPECT_EQ(stats.duplicatesDropped, uint64_t(kMessages));
+    EXPECT_EQ(stats.packetsLost, 0u);
+}
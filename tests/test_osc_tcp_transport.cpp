@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "../src/osc/OSCTCPTransport.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// Loopback listener on an ephemeral port
+class TestServer {
+public:
+    TestServer() {
+        listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        listen(listenFd_, 4);
+        socklen_t length = sizeof(address);
+        getsockname(listenFd_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = std::to_string(ntohs(address.sin_port));
+    }
+    ~TestServer() {
+        closeClient();
+        close(listenFd_);
+    }
+
+    const std::string& port() const { return port_; }
+
+    bool accept(int timeoutMs = 5000) {
+        pollfd fd{listenFd_, POLLIN, 0};
+        if (poll(&fd, 1, timeoutMs) != 1) return false;
+        closeClient();
+        clientFd_ = ::accept(listenFd_, nullptr, nullptr);
+        return clientFd_ >= 0;
+    }
+
+    void closeClient() {
+        if (clientFd_ >= 0) close(clientFd_);
+        clientFd_ = -1;
+    }
+
+    std::vector<uint8_t> read(size_t count, int timeoutMs = 5000) {
+        std::vector<uint8_t> data;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (data.size() < count && std::chrono::steady_clock::now() < deadline) {
+            pollfd fd{clientFd_, POLLIN, 0};
+            if (poll(&fd, 1, 50) != 1) continue;
+            uint8_t buffer[65536];
+            ssize_t received = recv(clientFd_, buffer, std::min(sizeof(buffer), count - data.size()), 0);
+            if (received <= 0) break;
+            data.insert(data.end(), buffer, buffer + received);
+        }
+        return data;
+    }
+
+private:
+    int listenFd_ = -1;
+    int clientFd_ = -1;
+    std::string port_;
+};
+
+template <typename Predicate>
+bool waitFor(Predicate predicate, int timeoutMs = 5000) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(OSCTCPTransportTest, LengthPrefixAndSlipFraming) {
+    TestServer server;
+    OSCTCPTransport transport;
+    ASSERT_TRUE(transport.connect("127.0.0.1", server.port()));
+    ASSERT_TRUE(server.accept());
+
+    const uint8_t packet[] = {'/', 'a', 0, 0, 0xC0, 0xDB, 0x01, 0x02};
+    ASSERT_TRUE(transport.sendPacket(packet, sizeof(packet)));
+    std::vector<uint8_t> expected = {0, 0, 0, 8};
+    expected.insert(expected.end(), packet, packet + sizeof(packet));
+    EXPECT_EQ(server.read(expected.size()), expected);
+
+    transport.setFraming(OSCTCPTransport::Framing::SLIP);
+    ASSERT_TRUE(transport.sendPacket(packet, sizeof(packet)));
+    expected = {0xC0, '/', 'a', 0, 0, 0xDB, 0xDC, 0xDB, 0xDD, 0x01, 0x02, 0xC0};
+    EXPECT_EQ(server.read(expected.size()), expected);
+}
+
+TEST(OSCTCPTransportTest, BurstsAreCoalescedIntoFewWrites) {
+    TestServer server;
+    OSCTCPTransport transport;
+    ASSERT_TRUE(transport.connect("127.0.0.1", server.port()));
+    ASSERT_TRUE(server.accept());
+
+    const uint8_t packet[16] = {'/', 'c', 'v', 0, ',', 'f', 0, 0};
+    for (int i = 0; i < 500; i++) {
+        ASSERT_TRUE(transport.sendPacket(packet, sizeof(packet)));
+    }
+    EXPECT_EQ(server.read(500 * 20).size(), 500u * 20);
+    auto stats = transport.getQueueStats();
+    EXPECT_EQ(stats.framesSent, 500u);
+    EXPECT_LT(stats.writeCalls, 500u);
+}
+
+TEST(OSCTCPTransportTest, SlowPeerFailsFastWithBackpressure) {
+    TestServer server;
+    OSCTCPTransport transport;
+    transport.setMaxQueueBytes(64 * 1024);
+    std::atomic<int> transitions{0};
+    transport.setBackpressureCallback([&](bool) { transitions++; });
+    ASSERT_TRUE(transport.connect("127.0.0.1", server.port()));
+    ASSERT_TRUE(server.accept());
+
+    // The server never reads, so kernel buffers and then the queue fill up
+    std::vector<uint8_t> packet(4096, 0x55);
+    bool rejected = false;
+    auto slowest = std::chrono::steady_clock::duration::zero();
+    for (int i = 0; i < 20000 && !rejected; i++) {
+        auto start = std::chrono::steady_clock::now();
+        rejected = !transport.sendPacket(packet.data(), packet.size());
+        slowest = std::max(slowest, std::chrono::steady_clock::now() - start);
+        if (i % 64 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    ASSERT_TRUE(rejected);
+    EXPECT_TRUE(transport.isBackpressured());
+    EXPECT_GE(transport.getQueueStats().framesDropped, 1u);
+    EXPECT_LT(slowest, std::chrono::milliseconds(20));
+
+    // Draining the peer releases the backpressure
+    std::atomic<bool> drained{false};
+    std::thread reader([&] {
+        while (!drained) server.read(1 << 20, 20);
+    });
+    EXPECT_TRUE(waitFor([&] { return !transport.isBackpressured(); }));
+    // Frames taken off the queue for writing are counted until they are written
+    EXPECT_TRUE(waitFor([&] { return transport.getQueueStats().queuedFrames == 0; }));
+    drained = true;
+    reader.join();
+    EXPECT_EQ(transitions.load(), 2);
+    EXPECT_EQ(transport.getQueueStats().queuedBytes, 0u);
+}
+
+TEST(OSCTCPTransportTest, ReconnectsOnTheEventLoop) {
+    TestServer server;
+    OSCTCPTransport transport;
+    transport.setAutoReconnect(true);
+    transport.setReconnectDelay(1);
+    ASSERT_TRUE(transport.connect("127.0.0.1", server.port()));
+    ASSERT_TRUE(server.accept());
+
+    server.closeClient();
+    ASSERT_TRUE(waitFor([&] { return !transport.isConnected(); }));
+    const uint8_t packet[] = {'/', 'r', 0, 0};
+    EXPECT_TRUE(transport.sendPacket(packet, sizeof(packet)));   // Queued until the link is back
+
+    ASSERT_TRUE(server.accept());
+    ASSERT_TRUE(waitFor([&] { return transport.isConnected(); }));
+    EXPECT_EQ(server.read(8), (std::vector<uint8_t>{0, 0, 0, 4, '/', 'r', 0, 0}));
+    EXPECT_EQ(transport.getQueueStats().reconnects, 1u);
+
+    transport.disconnect();
+    EXPECT_FALSE(transport.sendPacket(packet, sizeof(packet)));
+}
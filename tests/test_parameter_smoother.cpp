@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include "../src/utils/ParameterSmoother.h"
+#include "../src/utils/ExternalDeviceMapper.h"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ParameterSmootherTest : public ::testing::Test {
+protected:
+    // 100 Hz control rate: one tick per 10 ms of ramp time
+    ParameterSmoother smoother{4, 100.0f};
+    std::map<size_t, float> lastValues;
+
+    size_t tick() {
+        return smoother.tick([this](size_t slot, float value) {
+            lastValues[slot] = value;
+        });
+    }
+};
+
+TEST_F(ParameterSmootherTest, FirstTargetJumps) {
+    smoother.setTarget(0, 0.8f, 100.0f, SmoothingRamp::LINEAR);
+    EXPECT_EQ(tick(), 1u);
+    EXPECT_FLOAT_EQ(lastValues[0], 0.8f);
+    EXPECT_FALSE(smoother.isRamping(0));
+}
+
+TEST_F(ParameterSmootherTest, LinearRampReachesTargetOnTime) {
+    smoother.jumpTo(1, 0.0f);
+    tick();
+
+    smoother.setTarget(1, 1.0f, 40.0f, SmoothingRamp::LINEAR);
+    tick();
+    EXPECT_NEAR(lastValues[1], 0.25f, 1e-6f);
+    tick();
+    EXPECT_NEAR(lastValues[1], 0.5f, 1e-6f);
+    tick();
+    tick();
+    EXPECT_FLOAT_EQ(lastValues[1], 1.0f);
+    EXPECT_EQ(smoother.getActiveRampCount(), 0u);
+
+    // Nothing left to report once idle
+    EXPECT_EQ(tick(), 0u);
+}
+
+TEST_F(ParameterSmootherTest, ExponentialRampIsMonotonicAndSnaps) {
+    smoother.jumpTo(2, 0.0f);
+    tick();
+
+    smoother.setTarget(2, 1.0f, 100.0f, SmoothingRamp::EXPONENTIAL);
+    float previous = 0.0f;
+    for (int i = 0; i < 9; i++) {
+        tick();
+        EXPECT_GT(lastValues[2], previous);
+        EXPECT_LT(lastValues[2], 1.0f);
+        previous = lastValues[2];
+    }
+    tick();
+    EXPECT_FLOAT_EQ(lastValues[2], 1.0f);
+    EXPECT_FALSE(smoother.isRamping(2));
+}
+
+TEST_F(ParameterSmootherTest, RetargetDuringRampRestartsFromCurrentValue) {
+    smoother.jumpTo(3, 0.0f);
+    tick();
+
+    smoother.setTarget(3, 1.0f, 40.0f, SmoothingRamp::LINEAR);
+    tick();
+    tick();
+    smoother.setTarget(3, 0.0f, 20.0f, SmoothingRamp::LINEAR);
+    tick();
+    EXPECT_NEAR(lastValues[3], 0.25f, 1e-6f);
+    tick();
+    EXPECT_FLOAT_EQ(lastValues[3], 0.0f);
+}
+
+TEST_F(ParameterSmootherTest, ZeroTimeJumpCancelsActiveRamp) {
+    smoother.jumpTo(0, 0.0f);
+    tick();
+    smoother.setTarget(0, 1.0f, 100.0f, SmoothingRamp::LINEAR);
+    tick();
+    smoother.jumpTo(0, 0.5f);
+    tick();
+    EXPECT_FLOAT_EQ(lastValues[0], 0.5f);
+    EXPECT_FALSE(smoother.isRamping(0));
+    tick();
+    EXPECT_FLOAT_EQ(smoother.getCurrentValue(0), 0.5f);
+}
+
+TEST(ExternalDeviceMapperHighResolutionTest, PairedCCAndNRPN) {
+    ExternalDeviceMapper mapper;
+    std::vector<float> values;
+    mapper.setParameterChangeCallback([&values](MappingParameterType, int, float value) {
+        values.push_back(value);
+    });
+
+    ExternalDeviceMapping paired;
+    paired.mappingId = "paired";
+    paired.deviceId = "midi";
+    paired.deviceType = ExternalDeviceType::MIDI_CONTROLLER;
+    paired.inputAddress = "cc7";
+    paired.highResolution = true;
+    paired.parameterType = MappingParameterType::MASTER_LEVEL;
+    ASSERT_TRUE(mapper.addMapping(paired));
+
+    ExternalDeviceMapping nrpn = paired;
+    nrpn.mappingId = "nrpn";
+    nrpn.inputAddress = "nrpn300";
+    nrpn.highResolution = false;
+    ASSERT_TRUE(mapper.addMapping(nrpn));
+
+    // MSB 64 then LSB 64 on the paired controllers
+    mapper.processMIDIInput(0, 7, 64);
+    mapper.processMIDIInput(0, 39, 64);
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_FLOAT_EQ(values[0], static_cast<float>(64 << 7) / 16383.0f);
+    EXPECT_FLOAT_EQ(values[1], static_cast<float>((64 << 7) | 64) / 16383.0f);
+
+    // NRPN 300 = MSB 2, LSB 44; full-scale data entry
+    values.clear();
+    mapper.processMIDIInput(0, 99, 2);
+    mapper.processMIDIInput(0, 98, 44);
+    mapper.processMIDIInput(0, 6, 127);
+    mapper.processMIDIInput(0, 38, 127);
+    ASSERT_EQ(values.size(), 2u);
+    EXPECT_FLOAT_EQ(values[1], 1.0f);
+}
+
+TEST(ExternalDeviceMapperSmoothingTest, TogglesBypassTheSmoother) {
+    ExternalDeviceMapper mapper;
+    std::vector<std::pair<MappingParameterType, float>> changes;
+    mapper.setParameterChangeCallback([&changes](MappingParameterType type, int, float value) {
+        changes.emplace_back(type, value);
+    });
+    ASSERT_TRUE(mapper.initialize());
+
+    ExternalDeviceMapping mute;
+    mute.mappingId = "mute";
+    mute.deviceId = "midi";
+    mute.deviceType = ExternalDeviceType::MIDI_CONTROLLER;
+    mute.inputAddress = "cc20";
+    mute.parameterType = MappingParameterType::CHANNEL_MUTE;
+    mute.targetChannelId = 0;
+    ASSERT_TRUE(mapper.addMapping(mute));
+
+    // Press and release well inside one control tick: both reach the callback, in order
+    mapper.processMIDIInput(0, 20, 127);
+    mapper.processMIDIInput(0, 20, 0);
+    mapper.shutdown();
+    ASSERT_EQ(changes.size(), 2u);
+    EXPECT_EQ(changes[0].first, MappingParameterType::CHANNEL_MUTE);
+    EXPECT_FLOAT_EQ(changes[0].second, 1.0f);
+    EXPECT_FLOAT_EQ(changes[1].second, 0.0f);
+}
+
+TEST(ExternalDeviceMapperSmoothingTest, DefaultRampAppliesToMappingsWithoutTheirOwn) {
+    ExternalDeviceMapper mapper;
+    std::mutex mutex;
+    std::vector<float> values;
+    mapper.setParameterChangeCallback([&](MappingParameterType, int, float value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        values.push_back(value);
+    });
+    mapper.setDefaultSmoothing(100.0f, SmoothingRamp::LINEAR);
+    mapper.setSmoothingControlRate(200.0f);   // 20 ticks per ramp
+    ASSERT_TRUE(mapper.initialize());
+
+    ExternalDeviceMapping level;
+    level.mappingId = "level";
+    level.deviceId = "midi";
+    level.deviceType = ExternalDeviceType::MIDI_CONTROLLER;
+    level.inputAddress = "cc7";
+    level.parameterType = MappingParameterType::MASTER_LEVEL;
+    ASSERT_TRUE(mapper.addMapping(level));   // smoothingRamp stays EXPONENTIAL, time -1
+
+    auto waitForValue = [&](float expected) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (std::chrono::steady_clock::now() < deadline) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!values.empty() && values.back() == expected) return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    };
+    mapper.processMIDIInput(0, 7, 0);
+    ASSERT_TRUE(waitForValue(0.0f));
+    mapper.processMIDIInput(0, 7, 127);
+    ASSERT_TRUE(waitForValue(1.0f));
+    mapper.shutdown();
+
+    // A linear ramp moves by the same amount every tick
+    ASSERT_EQ(values.size(), 21u);
+    for (size_t i = 1; i < values.size(); ++i) {
+        EXPECT_NEAR(values[i] - values[i - 1], 0.05f, 1e-4f) << "tick " << i;
+    }
+}
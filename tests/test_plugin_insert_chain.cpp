@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "../src/utils/PluginInsertChain.h"
+#include "../src/utils/PluginManager.h"
+#include "../src/core/PerformanceMonitor.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct TestState {
+    float gain = 2.0f;
+    bool slow = false;
+};
+
+void* testCreate(double, uint32_t, uint32_t) { return new TestState(); }
+void testDestroy(void* instance) { delete static_cast<TestState*>(instance); }
+
+int32_t testProcess(void* instance, const cvosc_process_block* block) {
+    auto* state = static_cast<TestState*>(instance);
+    if (state->slow) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    for (uint32_t channel = 0; channel < block->num_channels; channel++) {
+        for (uint32_t frame = 0; frame < block->num_frames; frame++) {
+            block->outputs[channel][frame] = block->inputs[channel][frame] * state->gain;
+        }
+    }
+    return CVOSC_OK;
+}
+
+const cvosc_plugin_descriptor kTestDescriptor = {
+    sizeof(cvosc_plugin_descriptor), PLUGIN_API_VERSION, CVOSC_PLUGIN_SIGNAL_PROCESSOR,
+    CVOSC_PLUGIN_FLAG_RT_SAFE,
+    "Test Gain", "1.0", "test", "Gain with optional stall",
+    0, nullptr,
+    testCreate, testDestroy, nullptr, testProcess, nullptr, nullptr,
+};
+
+} // namespace
+
+class PluginInsertChainTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        fastState = static_cast<TestState*>(testCreate(48000.0, 1, 64));
+        slowState = static_cast<TestState*>(testCreate(48000.0, 1, 64));
+        slowState->slow = true;
+        fast = std::make_unique<BlockProcessor>(&kTestDescriptor, fastState, 1, 64);
+        slow = std::make_unique<BlockProcessor>(&kTestDescriptor, slowState, 1, 64);
+    }
+
+    void TearDown() override {
+        chain.reset();
+        testDestroy(fastState);
+        testDestroy(slowState);
+    }
+
+    std::shared_ptr<PluginInsertChain> chain = std::make_shared<PluginInsertChain>(2, 256, 48000.0);
+    TestState* fastState = nullptr;
+    TestState* slowState = nullptr;
+    std::unique_ptr<BlockProcessor> fast;
+    std::unique_ptr<BlockProcessor> slow;
+};
+
+TEST_F(PluginInsertChainTest, ProcessesAttachedChannelOnly) {
+    ASSERT_TRUE(chain->attach(0, "fast", fast.get()));
+    EXPECT_FALSE(chain->attach(1, "fast", fast.get())); // One channel per instance
+
+    std::vector<float> left(128, 1.0f);
+    std::vector<float> right(128, 1.0f);
+    chain->process(0, left.data(), 128);
+    chain->process(1, right.data(), 128);
+
+    // Blocks larger than the plugin's max frames are split
+    EXPECT_FLOAT_EQ(left[0], 2.0f);
+    EXPECT_FLOAT_EQ(left[127], 2.0f);
+    EXPECT_FLOAT_EQ(right[0], 1.0f);
+
+    auto statistics = chain->getStatistics();
+    ASSERT_EQ(statistics.size(), 1u);
+    EXPECT_EQ(statistics[0].blocks, 1u);
+    EXPECT_EQ(statistics[0].overruns, 0u);
+    EXPECT_FALSE(statistics[0].bypassed);
+}
+
+TEST_F(PluginInsertChainTest, OverrunningPluginIsBypassedAndReported) {
+    ASSERT_TRUE(chain->attach(0, "slow", slow.get()));
+    ASSERT_TRUE(chain->attach(0, "fast", fast.get()));
+    chain->setOverrunLimit(2);
+
+    // 64 frames at 48 kHz is 1.33 ms; a 2 ms stall exceeds any fraction of it
+    std::vector<float> block(64, 1.0f);
+    chain->process(0, block.data(), 64);
+    EXPECT_FALSE(chain->isBypassed("slow"));
+    EXPECT_FLOAT_EQ(block[0], 4.0f);
+
+    std::fill(block.begin(), block.end(), 1.0f);
+    chain->process(0, block.data(), 64);
+    EXPECT_TRUE(chain->isBypassed("slow"));
+
+    // Bypassed insert passes the signal through; the next insert still runs
+    std::fill(block.begin(), block.end(), 1.0f);
+    chain->process(0, block.data(), 64);
+    EXPECT_FLOAT_EQ(block[0], 2.0f);
+
+    PerformanceMonitor monitor;
+    chain->reportOverruns(monitor);
+    auto alerts = monitor.getActiveAlerts();
+    ASSERT_EQ(alerts.size(), 1u);
+    EXPECT_EQ(alerts[0].severity, PerformanceAlert::Severity::Critical);
+    EXPECT_EQ(alerts[0].category, PerformanceAlert::Category::CPU);
+
+    // Reported once only
+    monitor.clearAlerts();
+    chain->reportOverruns(monitor);
+    EXPECT_TRUE(monitor.getActiveAlerts().empty());
+
+    // Re-enabling with a generous budget keeps it in the path
+    chain->setInsertBudget("slow", 1000000000);
+    chain->setBypassed("slow", false);
+    chain->process(0, block.data(), 64);
+    EXPECT_FALSE(chain->isBypassed("slow"));
+}
+
+TEST_F(PluginInsertChainTest, DetachWhileProcessing) {
+    ASSERT_TRUE(chain->attach(0, "fast", fast.get()));
+
+    std::atomic<bool> running{true};
+    std::thread audio([&]() {
+        std::vector<float> block(64, 1.0f);
+        while (running) {
+            chain->process(0, block.data(), 64);
+        }
+    });
+
+    for (int i = 0; i < 50; i++) {
+        chain->detachPlugin("fast");
+        ASSERT_TRUE(chain->attach(0, "fast", fast.get()));
+    }
+    chain->detachPlugin("fast");
+    EXPECT_EQ(chain->getInsertChannel("fast"), -1);
+
+    running = false;
+    audio.join();
+}
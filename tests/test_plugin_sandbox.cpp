@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "../src/utils/PluginSandbox.h"
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct SandboxTestState {
+    float gain = 1.0f;
+};
+
+void* sandboxCreate(double, uint32_t, uint32_t) { return new SandboxTestState(); }
+void sandboxDestroy(void* instance) { delete static_cast<SandboxTestState*>(instance); }
+
+int32_t sandboxProcess(void* instance, const cvosc_process_block* block) {
+    auto* state = static_cast<SandboxTestState*>(instance);
+    for (uint32_t channel = 0; channel < block->num_channels; channel++) {
+        for (uint32_t frame = 0; frame < block->num_frames; frame++) {
+            if (block->inputs[channel][frame] < -100.0f) {
+                std::abort(); // Crash trigger
+            }
+            block->outputs[channel][frame] = block->inputs[channel][frame] * state->gain;
+        }
+    }
+    return CVOSC_OK;
+}
+
+int32_t sandboxSetParameter(void* instance, uint32_t id, float value) {
+    if (id != 0) {
+        return CVOSC_ERROR_BAD_PARAM;
+    }
+    static_cast<SandboxTestState*>(instance)->gain = value;
+    return CVOSC_OK;
+}
+
+float sandboxGetParameter(void* instance, uint32_t) {
+    return static_cast<SandboxTestState*>(instance)->gain;
+}
+
+const cvosc_parameter_info kSandboxParameters[] = {
+    {0, "gain", 0.0f, 10.0f, 1.0f},
+};
+
+const cvosc_plugin_descriptor kSandboxDescriptor = {
+    sizeof(cvosc_plugin_descriptor), PLUGIN_API_VERSION, CVOSC_PLUGIN_SIGNAL_PROCESSOR,
+    CVOSC_PLUGIN_FLAG_IN_PLACE | CVOSC_PLUGIN_FLAG_RT_SAFE,
+    "Sandbox Gain", "1.0", "test", "Gain that crashes on a sentinel sample",
+    1, kSandboxParameters,
+    sandboxCreate, sandboxDestroy, nullptr, sandboxProcess, sandboxSetParameter, sandboxGetParameter,
+};
+
+// Run one block through the sandbox and return the first output sample
+float runBlock(PluginSandbox& sandbox, float value) {
+    std::vector<float> samples(64, value);
+    float* channel = samples.data();
+    const float* input = samples.data();
+    cvosc_process_block block{1, 64, &input, &channel, 0};
+    sandbox.process(block);
+    return samples[0];
+}
+
+bool waitHealthy(PluginSandbox& sandbox, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!sandbox.isHealthy()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(PluginSandboxTest, RoundTripAddsOneBlockOfLatency) {
+    PluginSandbox sandbox(2, 64);
+    ASSERT_TRUE(sandbox.start(&kSandboxDescriptor));
+    EXPECT_EQ(sandbox.getPluginName(), "Sandbox Gain");
+    ASSERT_EQ(sandbox.getParameters().size(), 1u);
+    EXPECT_EQ(sandbox.getParameters()[0].name, "gain");
+    ASSERT_TRUE(sandbox.setParameter(0, 3.0f));
+
+    EXPECT_FLOAT_EQ(runBlock(sandbox, 1.0f), 0.0f); // Nothing processed yet
+    ASSERT_TRUE(sandbox.waitForResult(std::chrono::milliseconds(500)));
+    EXPECT_FLOAT_EQ(runBlock(sandbox, 2.0f), 3.0f); // Previous block, processed
+    ASSERT_TRUE(sandbox.waitForResult(std::chrono::milliseconds(500)));
+    EXPECT_FLOAT_EQ(runBlock(sandbox, 0.0f), 6.0f);
+
+    auto statistics = sandbox.getStatistics();
+    EXPECT_EQ(statistics.blocks, 3u);
+    EXPECT_EQ(statistics.processed, 2u);
+    EXPECT_EQ(statistics.misses, 0u);
+    EXPECT_TRUE(statistics.healthy);
+    sandbox.stop();
+    EXPECT_FALSE(sandbox.isHealthy());
+}
+
+TEST(PluginSandboxTest, CrashedHostIsRestartedWithParameters) {
+    PluginSandbox sandbox(1, 64);
+    ASSERT_TRUE(sandbox.start(&kSandboxDescriptor));
+    ASSERT_TRUE(sandbox.setParameter(0, 2.0f));
+    pid_t firstHost = sandbox.getHostPid();
+
+    // The crash never reaches the caller: audio passes through dry while the host is down
+    runBlock(sandbox, -1000.0f);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (sandbox.isHealthy() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_FLOAT_EQ(runBlock(sandbox, 5.0f), 5.0f);
+
+    ASSERT_TRUE(waitHealthy(sandbox, std::chrono::seconds(5)));
+    EXPECT_NE(sandbox.getHostPid(), firstHost);
+    EXPECT_EQ(sandbox.getStatistics().restarts, 1u);
+
+    // Gain was replayed into the new host
+    runBlock(sandbox, 1.0f);
+    ASSERT_TRUE(sandbox.waitForResult(std::chrono::milliseconds(500)));
+    EXPECT_FLOAT_EQ(runBlock(sandbox, 1.0f), 2.0f);
+    sandbox.stop();
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../src/core/ResourceSampler.h"
+#include "../src/core/PerformanceMonitor.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+const ResourceSampler::ThreadSample* findThread(const ResourceSampler::Sample& sample, const std::string& name) {
+    for (const auto& thread : sample.threads) {
+        if (thread.name == name) {
+            return &thread;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(ResourceSamplerTest, AttributesCpuToRegisteredThreads) {
+    auto& sampler = ResourceSampler::getInstance();
+    sampler.enableHardwareCounters(true);
+    std::atomic<bool> running{true};
+    std::atomic<int> ready{0};
+
+    std::thread busy([&]() {
+        ScopedThreadRegistration registration("busy");
+        ready++;
+        volatile uint64_t spin = 0;
+        while (running) {
+            spin = spin + 1;
+        }
+    });
+    std::thread idle([&]() {
+        ScopedThreadRegistration registration("idle");
+        ready++;
+        while (running) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    });
+    while (ready < 2) {
+        std::this_thread::yield();
+    }
+
+    sampler.sample(); // Baseline
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    auto sample = sampler.sample();
+
+    const auto* busyThread = findThread(sample, "busy");
+    const auto* idleThread = findThread(sample, "idle");
+    ASSERT_NE(busyThread, nullptr);
+    ASSERT_NE(idleThread, nullptr);
+    EXPECT_GT(busyThread->cpuPercent, 50.0);
+    EXPECT_LT(idleThread->cpuPercent, 20.0);
+    EXPECT_GT(sample.processCpuPercent, 50.0);
+    EXPECT_GT(sample.residentMemoryMB, 0u);
+    // Hardware counters depend on kernel permissions; when present they must be sane
+    if (idleThread->contextSwitches >= 0) {
+        EXPECT_GT(idleThread->contextSwitches, 0);
+    }
+
+    running = false;
+    busy.join();
+    idle.join();
+    sampler.enableHardwareCounters(false);
+
+    // Unregistered threads drop out of the next sample
+    sampler.sample();
+    auto after = sampler.sample();
+    EXPECT_EQ(findThread(after, "busy"), nullptr);
+    EXPECT_EQ(findThread(after, "idle"), nullptr);
+}
+
+TEST(ResourceSamplerTest, StaticQueriesDoNotNeedAMonitor) {
+    PerformanceMonitor::getCurrentCPUUsage();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    double cpu = PerformanceMonitor::getCurrentCPUUsage();
+    EXPECT_GE(cpu, 0.0);
+    EXPECT_LE(cpu, 100.0);
+    EXPECT_GT(PerformanceMonitor::getCurrentMemoryUsage(), 0u);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "../src/core/DeviceInventory.h"
+#include "../src/core/StartupProfiler.h"
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+DeviceInventory::Entry device(int index, const std::string& name, int inputs) {
+    DeviceInventory::Entry entry;
+    entry.index = index;
+    entry.name = name;
+    entry.hostApi = "Core Audio";
+    entry.maxInputChannels = inputs;
+    entry.maxOutputChannels = 2;
+    entry.defaultSampleRate = 48000.0;
+    entry.available = inputs > 0;
+    return entry;
+}
+
+} // namespace
+
+TEST(DeviceInventoryTest, RoundTripsThroughTheCacheFile) {
+    const std::string path = "test_device_inventory/cache/inventory.json";
+    DeviceInventory saved;
+    saved.setEntries({device(0, "MacBook Pro Microphone", 1), device(3, "ES-8", 12)});
+    ASSERT_TRUE(saved.save(path));
+
+    DeviceInventory loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded, saved);
+    ASSERT_NE(loaded.findByName("ES-8"), nullptr);
+    EXPECT_EQ(loaded.findByName("ES-8")->index, 3);
+    EXPECT_EQ(loaded.findByName("ES-9"), nullptr);
+
+    std::remove(path.c_str());
+}
+
+TEST(DeviceInventoryTest, FindSameRejectsChangedCapabilities) {
+    DeviceInventory inventory;
+    inventory.setEntries({device(3, "ES-8", 12)});
+
+    auto moved = device(5, "ES-8", 12);     // Replugged: new index, same device
+    EXPECT_NE(inventory.findSame(moved), nullptr);
+    auto reconfigured = device(3, "ES-8", 8);
+    EXPECT_EQ(inventory.findSame(reconfigured), nullptr);
+
+    setenv("CVOSC_DEVICE_CACHE", "off", 1);
+    EXPECT_TRUE(DeviceInventory::getDefaultPath().empty());
+    EXPECT_FALSE(inventory.save(DeviceInventory::getDefaultPath()));
+    unsetenv("CVOSC_DEVICE_CACHE");
+}
+
+TEST(StartupProfilerTest, OrdersPhasesAndMarksBackgroundThreads) {
+    auto& profiler = StartupProfiler::getInstance();
+    profiler.reset();
+
+    {
+        auto phase = profiler.phase("engine_initialize");
+        std::thread([&profiler]() { auto audio = profiler.phase("audio_init"); }).join();
+    }
+
+    auto phases = profiler.getPhases();
+    ASSERT_EQ(phases.size(), 2u);
+    EXPECT_EQ(phases[0].name, "engine_initialize");
+    EXPECT_FALSE(phases[0].background);
+    EXPECT_EQ(phases[1].name, "audio_init");
+    EXPECT_TRUE(phases[1].background);
+    EXPECT_LE(phases[0].startNs, phases[1].startNs);
+}
+
+TEST(StartupProfilerTest, RecordsTheFirstPacketAndReportsOnce) {
+    auto& profiler = StartupProfiler::getInstance();
+    profiler.reset();
+    std::ostringstream out;
+
+    EXPECT_EQ(profiler.getTimeToFirstPacketNs(), -1);
+    EXPECT_FALSE(profiler.reportOnceAfterFirstPacket(out));
+
+    profiler.markFirstPacket();
+    int64_t first = profiler.getTimeToFirstPacketNs();
+    EXPECT_GE(first, 0);
+    profiler.markFirstPacket();
+    EXPECT_EQ(profiler.getTimeToFirstPacketNs(), first);
+
+    EXPECT_TRUE(profiler.reportOnceAfterFirstPacket(out));
+    EXPECT_FALSE(profiler.reportOnceAfterFirstPacket(out));
+    EXPECT_NE(out.str().find("first OSC packet"), std::string::npos);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "../src/core/TraceLog.h"
+#include <sstream>
+#include <thread>
+
+class TraceLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        trace.clear();
+        TraceLog::setCategoryMask(0);
+    }
+
+    void TearDown() override {
+        TraceLog::setCategoryMask(0);
+        trace.clear();
+    }
+
+    TraceLog& trace = TraceLog::getInstance();
+};
+
+TEST_F(TraceLogTest, RecordsOnlyEnabledCategories) {
+    TRACE_DEBUG(TraceCategory::Osc, "dropped %d", 1);
+    EXPECT_TRUE(trace.collect().empty());
+
+    TraceLog::setCategoryMask(static_cast<uint32_t>(TraceCategory::Osc));
+    TRACE_DEBUG(TraceCategory::Osc, "kept %d", 2);
+    TRACE_DEBUG(TraceCategory::Audio, "dropped %d", 3);
+
+    auto entries = trace.collect();
+    ASSERT_EQ(entries.size(), 1u);
+    EXPECT_EQ(entries[0].text, "kept 2");
+    EXPECT_EQ(entries[0].category, TraceCategory::Osc);
+    EXPECT_EQ(entries[0].level, TraceLevel::Debug);
+}
+
+TEST_F(TraceLogTest, FormatsStoredArgumentsOnDump) {
+    TraceLog::setCategoryMask(static_cast<uint32_t>(TraceCategory::All));
+    std::string device = "real_audio_input_device_7";
+    size_t depth = 12;
+    TRACE_INFO(TraceCategory::Device, "input %s level=%.3fV", device, 1.25f);
+    TRACE_INFO(TraceCategory::Engine, "depth %zu, id %llx, %d%%", depth, 255ull, -4);
+    TRACE_INFO(TraceCategory::Gui, "%s %s %s", "a", "b", "c");   // Only two strings fit
+
+    auto entries = trace.collect();
+    ASSERT_EQ(entries.size(), 3u);
+    EXPECT_EQ(entries[0].text, "input real_audio_input level=1.250V");
+    EXPECT_EQ(entries[1].text, "depth 12, id ff, -4%");
+    EXPECT_EQ(entries[2].text, "a b ?");
+
+    std::ostringstream out;
+    trace.dump(out);
+    EXPECT_NE(out.str().find("device INFO    input real_audio_input"), std::string::npos);
+}
+
+TEST_F(TraceLogTest, KeepsTheMostRecentRecordsFromAllThreads) {
+    TraceLog::setCategoryMask(static_cast<uint32_t>(TraceCategory::Audio));
+    const int perThread = static_cast<int>(TraceLog::RING_SIZE);
+    std::thread first([&]() {
+        for (int i = 0; i < perThread; i++) {
+            TRACE_DEBUG(TraceCategory::Audio, "first %d", i);
+        }
+    });
+    std::thread second([&]() {
+        for (int i = 0; i < perThread; i++) {
+            TRACE_DEBUG(TraceCategory::Audio, "second %d", i);
+        }
+    });
+    first.join();
+    second.join();
+
+    auto entries = trace.collect();
+    EXPECT_EQ(entries.size(), TraceLog::RING_SIZE);
+    EXPECT_NE(entries.front().threadId, 0u);
+}
+
+TEST(TraceLogCategories, ParsesCategoryLists) {
+    EXPECT_EQ(TraceLog::parseCategories("audio, OSC"),
+              static_cast<uint32_t>(TraceCategory::Audio) | static_cast<uint32_t>(TraceCategory::Osc));
+    EXPECT_EQ(TraceLog::parseCategories("all"), static_cast<uint32_t>(TraceCategory::All));
+    EXPECT_EQ(TraceLog::parseCategories("none"), 0u);
+}